@@ -20,8 +20,11 @@
 #include "framework/pin_names.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
+#include <algorithm>
+#include <cstring>
 #include <optional>
 #include <string>
+#include <string_view>
 
 // Functional states
 #ifndef OFF
@@ -46,17 +49,48 @@
 
 struct Result
 {
+    /**
+     * @brief Message text kept inline (cut to MESSAGE_SIZE - 1 chars), so building,
+     *        returning or copying a Result never touches the heap.
+     */
+    class Message
+    {
+        public:
+
+            static constexpr size_t MESSAGE_SIZE = 96;
+
+            Message(std::string_view text)
+            {
+                const size_t length = std::min(text.size(), MESSAGE_SIZE - 1);
+                std::memcpy(_text, text.data(), length);
+                _text[length] = '\0';
+            }
+
+            Message(const char* text) : Message(std::string_view(text)) {}
+
+            const char* c_str() const { return _text; }
+            operator std::string_view() const { return _text; }
+
+        private:
+
+            char _text[MESSAGE_SIZE];
+    };
+
     bool success;
-    std::optional<std::string> responseMessage;
+    std::optional<Message> responseMessage;
 
-    static Result Success(const std::optional<std::string>& message = std::nullopt)
+    static Result Success(std::optional<std::string_view> message = std::nullopt)
     {
-        return { true, message };
+        if (!message.has_value())
+        {
+            return { true, std::nullopt };
+        }
+        return { true, Message(*message) };
     }
 
-    static Result Error(const std::string& message)
+    static Result Error(std::string_view message)
     {
-        return { false, message };
+        return { false, Message(message) };
     }
 };
 
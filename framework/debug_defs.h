@@ -11,9 +11,20 @@
 #include <cstring>
 #include <cstdio>
 #include "esp_log.h"
+#include "framework/os/deferred_log.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 
+// 1: CORE_* logs go through the deferred ring (framework/os/deferred_log.h), 0: straight to ESP_LOGx
+#ifndef CORE_LOG_DEFERRED
+    #define CORE_LOG_DEFERRED 1
+#endif
+
+// Most verbose level compiled in; define before the first include to change it for one file
+#ifndef CORE_LOG_LEVEL
+    #define CORE_LOG_LEVEL ESP_LOG_INFO
+#endif
+
 #define CORE_TAG (strrchr("/" __FILE__, '/') + 1)
 
 static inline const char* get_current_task_name()
@@ -28,6 +39,32 @@ static inline const char* get_current_task_name()
     }
 }
 
+#if CORE_LOG_DEFERRED
+
+#define CORE_LOG(level, format, ...)                                                                                    \
+    do                                                                                                                  \
+    {                                                                                                                   \
+        if constexpr ((level) <= CORE_LOG_LEVEL)                                                                        \
+        {                                                                                                               \
+            static DeferredLog::Site _coreLogSite(DeferredLog::Detail::FileName(__FILE__), format, (level));            \
+            if (DeferredLog::IsEnabled(_coreLogSite))                                                                   \
+            {                                                                                                           \
+                DeferredLog::Write(_coreLogSite, ##__VA_ARGS__);                                                        \
+            }                                                                                                           \
+            if (false)                                                                                                  \
+            {                                                                                                           \
+                DeferredLog::Detail::CheckFormat(format, ##__VA_ARGS__);                                                \
+            }                                                                                                           \
+        }                                                                                                               \
+    }                                                                                                                   \
+    while (0)
+
+#define CORE_INFO(format, ...)      CORE_LOG(ESP_LOG_INFO, format, ##__VA_ARGS__)
+#define CORE_WARNING(format, ...)   CORE_LOG(ESP_LOG_WARN, format, ##__VA_ARGS__)
+#define CORE_ERROR(format, ...)     CORE_LOG(ESP_LOG_ERROR, format, ##__VA_ARGS__)
+
+#else
+
 #define CORE_INFO(format, ...) \
     ESP_LOGI(CORE_TAG, "[%s] " format, get_current_task_name(), ##__VA_ARGS__)
 
@@ -37,6 +74,8 @@ static inline const char* get_current_task_name()
 #define CORE_ERROR(format, ...) \
     ESP_LOGE(CORE_TAG, "[%s] " format, get_current_task_name(), ##__VA_ARGS__)
 
+#endif // CORE_LOG_DEFERRED
+
 // Asserts macros for runtime checks
 #define ASSERT(cond)                assert(cond)
 #define ASSERT_FAIL()               assert(false)
@@ -44,6 +83,7 @@ static inline const char* get_current_task_name()
                                     {                                                                                                   \
                                         if (!(cond))                                                                                    \
                                         {                                                                                               \
+                                            DeferredLog::Flush();                                                                       \
                                             printf("ASSERT FAILED: %s | File: %s, Line: %d\n", msg, __FILE__, __LINE__);                \
                                             assert(cond);                                                                               \
                                         }                                                                                               \
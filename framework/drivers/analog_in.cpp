@@ -60,7 +60,7 @@ float AnalogIn::ReadVoltage(const int samples) const
     int raw = 0;
     int sumRaw = 0;
     int count = 0;
-    for (size_t i = 0; i < samples; i++)
+    for (int i = 0; i < samples; i++)
     {
         if (adc_oneshot_read(_handle, _channel, &raw) == ESP_OK) 
         {
@@ -89,8 +89,8 @@ bool AnalogIn::IsValid() const
     return _valid;
 }
 
-//----private------------------------------------------------------------------
-bool AnalogIn::PinToAdcChannel(PinName pin, adc_channel_t& out) const
+//-----------------------------------------------------------------------------
+bool AnalogIn::PinToAdcChannel(PinName pin, adc_channel_t& out)
 {
     switch (pin) 
     {
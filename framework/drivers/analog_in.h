@@ -36,15 +36,15 @@ class AnalogIn
          */
         bool IsValid() const;
 
-    private:
-
         /**
          * @brief Convert pin name to ADC1 channel.
          * @param pin PinName to convert.
          * @param out Output channel.
          * @return true if conversion was successful, false otherwise.
          */
-        bool PinToAdcChannel(PinName pin, adc_channel_t& out) const;
+        static bool PinToAdcChannel(PinName pin, adc_channel_t& out);
+
+    private:
 
         static adc_oneshot_unit_handle_t _handle;
         adc_channel_t _channel{};
@@ -13,6 +13,7 @@ i2c_master_bus_handle_t I2C::_busHandles[I2C_NUM_MAX] = {nullptr};
 //-----------------------------------------------------------------------------
 I2C::I2C(PinName sda, PinName scl, uint8_t addr7bit, i2c_port_num_t port, uint32_t freqHz)
     : _port(port)
+    , _address(addr7bit)
     , _valid(false)
 {
     _mutex = xSemaphoreCreateMutex();
@@ -144,6 +145,25 @@ bool I2C::WriteRead(const uint8_t* txBuffer
     return false;
 }
 
+//-----------------------------------------------------------------------------
+bool I2C::Probe()
+{
+    if (!_valid || _mutex == NULL)
+    {
+        return false;
+    }
+
+    if (xSemaphoreTake(_mutex, portMAX_DELAY) == pdTRUE)
+    {
+        esp_err_t err = i2c_master_probe(_busHandles[_port], _address, 100);
+        xSemaphoreGive(_mutex);
+
+        return (err == ESP_OK);
+    }
+
+    return false;
+}
+
 //-----------------------------------------------------------------------------
 bool I2C::IsValid() const
 {
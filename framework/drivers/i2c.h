@@ -65,6 +65,12 @@ class I2C
                     , size_t rxLen
         );
 
+        /**
+         * @brief Address-only transfer, e.g. to poll a device that does not answer while busy.
+         * @return true if the device ACKs its address.
+         */
+        bool Probe();
+
         /**
          * @brief Check if I2C initialized correctly.
          */
@@ -73,6 +79,7 @@ class I2C
     private:
 
         i2c_port_num_t _port;
+        uint8_t _address;
         i2c_master_dev_handle_t _dev{};
         bool _valid;
         
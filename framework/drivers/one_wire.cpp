@@ -1,6 +1,8 @@
 /*!****************************************************************************
  * @file    OneWire.cpp
- * @brief   Implementation of OneWire class for ESP32 GPIO pins.
+ * @brief   Implementation of OneWire class for ESP32 GPIO pins: the ROM
+ *          commands and search shared by both backends, then the bit-banged
+ *          backend.
  * @author  Quattrone Martin
  * @date    Aug 2025
  ******************************************************************************/
@@ -8,6 +10,137 @@
 #include "framework/drivers/one_wire.h"
 #include "framework/common_defs.h"
 
+//-----------------------------------------------------------------------------
+bool OneWire::Select(const Rom& rom)
+{
+    if (!Reset())
+    {
+        return false;
+    }
+
+    WriteByte(CMD_MATCH_ROM);
+    for (uint8_t value : rom)
+    {
+        WriteByte(value);
+    }
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+bool OneWire::SkipRom()
+{
+    if (!Reset())
+    {
+        return false;
+    }
+
+    WriteByte(CMD_SKIP_ROM);
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+void OneWire::ResetSearch()
+{
+    _searchRom = {};
+    _lastDiscrepancy = 0;
+    _searchDone = false;
+}
+
+//-----------------------------------------------------------------------------
+bool OneWire::Search(Rom& rom, SearchMode mode)
+{
+    if (_searchDone || !Reset())
+    {
+        return false;
+    }
+
+    WriteByte((mode == SearchMode::ALARM) ? CMD_ALARM_SEARCH : CMD_SEARCH_ROM);
+
+    uint8_t lastZero = 0;
+    for (uint8_t bitNumber = 1; bitNumber <= 64; ++bitNumber)
+    {
+        uint8_t& romByte = _searchRom[(bitNumber - 1) / 8];
+        const uint8_t romMask = static_cast<uint8_t>(1U << ((bitNumber - 1) % 8));
+
+        // Every device still in the search sends its bit, then the complement (wired-AND)
+        const int bit = ReadBit();
+        const int complement = ReadBit();
+
+        int direction;
+        if (bit && complement)
+        {
+            // Nobody answered: no device at all (or in alarm), or they dropped out
+            ResetSearch();
+            return false;
+        }
+        else if (bit != complement)
+        {
+            direction = bit;
+        }
+        else
+        {
+            // Devices disagree: follow the previous path up to the last fork, then take the 1 branch
+            if (bitNumber < _lastDiscrepancy)
+            {
+                direction = (romByte & romMask) ? 1 : 0;
+            }
+            else
+            {
+                direction = (bitNumber == _lastDiscrepancy) ? 1 : 0;
+            }
+
+            if (direction == 0)
+            {
+                lastZero = bitNumber;
+            }
+        }
+
+        romByte = static_cast<uint8_t>(direction ? (romByte | romMask) : (romByte & ~romMask));
+
+        // Devices whose bit differs leave the search until the next reset
+        WriteBit(direction);
+    }
+
+    _lastDiscrepancy = lastZero;
+    _searchDone = (lastZero == 0);
+
+    if (Crc8(_searchRom.data(), _searchRom.size() - 1) != _searchRom.back())
+    {
+        ResetSearch();
+        return false;
+    }
+
+    rom = _searchRom;
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+uint8_t OneWire::Crc8(const uint8_t* data, size_t length)
+{
+    uint8_t crc = 0;
+
+    for (size_t i = 0; i < length; i++)
+    {
+        uint8_t inbyte = data[i];
+        for (uint8_t j = 0; j < 8; j++)
+        {
+            uint8_t mix = (crc ^ inbyte) & 0x01;
+            crc >>= 1;
+            if (mix)
+            {
+                crc ^= 0x8C;
+            }
+            inbyte >>= 1;
+        }
+    }
+
+    return crc;
+}
+
+#if !ONE_WIRE_USE_RMT
+
+// Bit-banged backend (see one_wire_rmt.cpp for the RMT one)
+
 //-----------------------------------------------------------------------------
 OneWire::OneWire(PinName pin)
     : _pin(static_cast<gpio_num_t>(pin))
@@ -109,4 +242,6 @@ void OneWire::DriveLow()
 void OneWire::Release()
 {
     gpio_set_level(_pin, ON);
-}
\ No newline at end of file
+}
+
+#endif // !ONE_WIRE_USE_RMT
@@ -1,6 +1,12 @@
 /*!****************************************************************************
  * @file    OneWire.h
  * @brief   1-Wire communication driver for ESP32 GPIO pins.
+ *          Two backends behind the same interface, chosen at build time:
+ *          ONE_WIRE_USE_RMT=1 times the slots with the RMT peripheral (TX and
+ *          RX channels looped back on the pin) and blocks the calling task
+ *          while a frame is on the wire; ONE_WIRE_USE_RMT=0 bit-bangs the
+ *          GPIO inside a critical section per slot, masking interrupts on
+ *          that core for up to 800 us.
  * @author  Quattrone martin
  * @date    Aug 2025
  ******************************************************************************/
@@ -10,11 +16,34 @@
 #include "driver/gpio.h"
 #include "framework/pin_names.h"
 #include "freertos/FreeRTOS.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// 1: RMT peripheral (framework/drivers/one_wire_rmt.cpp), 0: bit-banged GPIO (framework/drivers/one_wire.cpp)
+#ifndef ONE_WIRE_USE_RMT
+    #define ONE_WIRE_USE_RMT 1
+#endif
+
+#if ONE_WIRE_USE_RMT
+    #include "driver/rmt_rx.h"
+    #include "driver/rmt_tx.h"
+    #include "freertos/queue.h"
+#endif
 
 class OneWire
 {
     public:
 
+        //! Family code, 48-bit serial number and CRC, as sent on the bus
+        using Rom = std::array<uint8_t, 8>;
+
+        enum class SearchMode : uint8_t
+        {
+            ALL,                //!< SEARCH ROM: every device on the bus
+            ALARM,              //!< ALARM SEARCH: only devices with their alarm flag set
+        };
+
         /**
          * @brief Construct a OneWire instance.
          * @param pin GPIO pin used for 1-Wire bus.
@@ -51,11 +80,84 @@ class OneWire
          */
         uint8_t ReadByte();
 
+        /**
+         * @brief Address one device: reset, MATCH ROM and its ROM. Follow with a function command.
+         * @return true if a device answered the reset.
+         */
+        bool Select(const Rom& rom);
+
+        /**
+         * @brief Address every device at once: reset and SKIP ROM.
+         * @return true if a device answered the reset.
+         */
+        bool SkipRom();
+
+        /**
+         * @brief Restart the enumeration of Search() from the first device.
+         */
+        void ResetSearch();
+
+        /**
+         * @brief Find the next device on the bus (Maxim AN187 binary tree search).
+         *        Devices come in ascending ROM order, least significant bit first.
+         * @param rom Filled with the ROM of the device found.
+         * @param mode Every device, or only the ones in alarm.
+         * @return true if a device was found, false once every device was returned
+         *         (ResetSearch() starts over) or on a bus error.
+         */
+        bool Search(Rom& rom, SearchMode mode = SearchMode::ALL);
+
+        /**
+         * @brief Dallas/Maxim CRC-8 (x^8 + x^5 + x^4 + 1) of ROMs and scratchpads.
+         */
+        static uint8_t Crc8(const uint8_t* data, size_t length);
+
     private:
 
+        static constexpr uint8_t CMD_SEARCH_ROM = 0xF0;
+        static constexpr uint8_t CMD_ALARM_SEARCH = 0xEC;
+        static constexpr uint8_t CMD_MATCH_ROM = 0x55;
+        static constexpr uint8_t CMD_SKIP_ROM = 0xCC;
+
+        Rom _searchRom = {};
+        uint8_t _lastDiscrepancy = 0;           //!< Bit (1-64) where the last search took the 0 branch
+        bool _searchDone = false;
+
+#if ONE_WIRE_USE_RMT
+
+        static constexpr uint32_t RESOLUTION_HZ = 1000000;     //!< 1 tick = 1 us
+        static constexpr size_t RX_SYMBOLS = 64;               //!< One RMT memory block
+        static constexpr uint32_t FRAME_TIMEOUT_MS = 10;       //!< Longest frame (reset) is ~1.2 ms
+
+        /**
+         * @brief Transmits symbols and waits for the line capture of the same frame.
+         * @return size_t Symbols received, 0 on timeout.
+         */
+        size_t Exchange(const rmt_symbol_word_t* symbols, size_t count, uint32_t idleNs);
+
+        /**
+         * @brief Transmits symbols without capturing the line.
+         */
+        void Transmit(rmt_encoder_handle_t encoder, const void* payload, size_t bytes);
+
+        static bool OnReceiveDone(rmt_channel_handle_t channel, const rmt_rx_done_event_data_t* event, void* context);
+
+        gpio_num_t _pin;
+        rmt_channel_handle_t _txChannel = nullptr;
+        rmt_channel_handle_t _rxChannel = nullptr;
+        rmt_encoder_handle_t _bytesEncoder = nullptr;
+        rmt_encoder_handle_t _copyEncoder = nullptr;
+        QueueHandle_t _receiveDone = nullptr;                   //!< rmt_rx_done_event_data_t from the RX ISR
+        rmt_symbol_word_t _rxSymbols[RX_SYMBOLS] = {};
+        bool _valid = false;
+
+#else
+
         void DriveLow();
         void Release();
 
         portMUX_TYPE _mux = portMUX_INITIALIZER_UNLOCKED;
         gpio_num_t _pin;
+
+#endif
 };
@@ -0,0 +1,228 @@
+/*!****************************************************************************
+ * @file    one_wire_rmt.cpp
+ * @brief   Implementation of OneWire class on the RMT peripheral.
+ *          The TX channel drives the pin open-drain and loops it back to an
+ *          RX channel on the same pin, which captures the whole frame (the
+ *          master pulses and the device answers) as low/high durations.
+ *          Slot timing is done by the peripheral, so no interrupt is masked
+ *          and the calling task sleeps while the frame is on the wire.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#include "framework/drivers/one_wire.h"
+
+#if ONE_WIRE_USE_RMT
+
+#include "framework/common_defs.h"
+
+namespace {
+
+// Slot timings in microseconds, same as the bit-banged backend
+static constexpr uint32_t RESET_LOW_US = 480;
+static constexpr uint32_t RESET_RELEASE_US = 480;
+static constexpr uint32_t WRITE_1_LOW_US = 6;
+static constexpr uint32_t WRITE_1_RELEASE_US = 64;
+static constexpr uint32_t WRITE_0_LOW_US = 60;
+static constexpr uint32_t WRITE_0_RELEASE_US = 10;
+static constexpr uint32_t READ_LOW_US = 2;
+static constexpr uint32_t READ_RELEASE_US = 58;
+
+static constexpr uint32_t PRESENCE_LOW_MIN_US = 60;     //!< Devices answer a reset with 60-240 us low
+static constexpr uint32_t READ_SAMPLE_US = 15;          //!< A device sending 0 holds the line past this
+
+static constexpr uint32_t GLITCH_NS = 1000;
+static constexpr uint32_t RESET_IDLE_NS = 300000;       //!< Longer than the gap before the presence pulse
+static constexpr uint32_t SLOT_IDLE_NS = 100000;        //!< Longer than the recovery between two slots
+
+static constexpr size_t BITS_PER_BYTE = 8;
+
+//-----------------------------------------------------------------------------
+constexpr rmt_symbol_word_t LowThenRelease(uint32_t lowUs, uint32_t releaseUs)
+{
+    // duration0 / level0 = 0 / duration1 / level1 = 1
+    return rmt_symbol_word_t{ .val = (lowUs & 0x7FFFU) | ((releaseUs & 0x7FFFU) << 16) | (1U << 31) };
+}
+
+static constexpr rmt_symbol_word_t RESET_SYMBOL = LowThenRelease(RESET_LOW_US, RESET_RELEASE_US);
+static constexpr rmt_symbol_word_t WRITE_1_SYMBOL = LowThenRelease(WRITE_1_LOW_US, WRITE_1_RELEASE_US);
+static constexpr rmt_symbol_word_t WRITE_0_SYMBOL = LowThenRelease(WRITE_0_LOW_US, WRITE_0_RELEASE_US);
+static constexpr rmt_symbol_word_t READ_SYMBOLS[BITS_PER_BYTE] = {
+    LowThenRelease(READ_LOW_US, READ_RELEASE_US), LowThenRelease(READ_LOW_US, READ_RELEASE_US),
+    LowThenRelease(READ_LOW_US, READ_RELEASE_US), LowThenRelease(READ_LOW_US, READ_RELEASE_US),
+    LowThenRelease(READ_LOW_US, READ_RELEASE_US), LowThenRelease(READ_LOW_US, READ_RELEASE_US),
+    LowThenRelease(READ_LOW_US, READ_RELEASE_US), LowThenRelease(READ_LOW_US, READ_RELEASE_US),
+};
+
+} // namespace
+
+//-----------------------------------------------------------------------------
+OneWire::OneWire(PinName pin)
+    : _pin(static_cast<gpio_num_t>(pin))
+{
+    _receiveDone = xQueueCreate(1, sizeof(rmt_rx_done_event_data_t));
+    if (_receiveDone == nullptr)
+    {
+        CORE_ERROR("Failed to create 1-Wire queue!");
+        return;
+    }
+
+    // RX first: the TX channel created next on the same pin loops its output back to it
+    rmt_rx_channel_config_t rxConfig =
+    {
+        .gpio_num = _pin,
+        .clk_src = RMT_CLK_SRC_DEFAULT,
+        .resolution_hz = RESOLUTION_HZ,
+        .mem_block_symbols = RX_SYMBOLS,
+    };
+
+    rmt_tx_channel_config_t txConfig =
+    {
+        .gpio_num = _pin,
+        .clk_src = RMT_CLK_SRC_DEFAULT,
+        .resolution_hz = RESOLUTION_HZ,
+        .mem_block_symbols = RX_SYMBOLS,
+        .trans_queue_depth = 4,
+    };
+    txConfig.flags.io_loop_back = 1;
+    txConfig.flags.io_od_mode = 1;
+
+    const rmt_bytes_encoder_config_t bytesConfig =
+    {
+        .bit0 = WRITE_0_SYMBOL,
+        .bit1 = WRITE_1_SYMBOL,
+        .flags = { .msb_first = 0 }
+    };
+    const rmt_copy_encoder_config_t copyConfig = {};
+    const rmt_rx_event_callbacks_t callbacks = { .on_recv_done = OnReceiveDone };
+
+    if (rmt_new_rx_channel(&rxConfig, &_rxChannel) != ESP_OK
+     || rmt_new_tx_channel(&txConfig, &_txChannel) != ESP_OK
+     || rmt_new_bytes_encoder(&bytesConfig, &_bytesEncoder) != ESP_OK
+     || rmt_new_copy_encoder(&copyConfig, &_copyEncoder) != ESP_OK
+     || rmt_rx_register_event_callbacks(_rxChannel, &callbacks, this) != ESP_OK
+     || rmt_enable(_rxChannel) != ESP_OK
+     || rmt_enable(_txChannel) != ESP_OK)
+    {
+        CORE_ERROR("Failed to set up RMT 1-Wire bus on GPIO %d", _pin);
+        return;
+    }
+
+    _valid = true;
+}
+
+//-----------------------------------------------------------------------------
+bool OneWire::Reset()
+{
+    const size_t count = Exchange(&RESET_SYMBOL, 1, RESET_IDLE_NS);
+
+    // Our reset pulse, then the presence pulse of at least one device
+    return (count >= 2)
+        && (_rxSymbols[1].level0 == 0)
+        && (_rxSymbols[1].duration0 >= PRESENCE_LOW_MIN_US);
+}
+
+//-----------------------------------------------------------------------------
+void OneWire::WriteBit(int bit)
+{
+    Transmit(_copyEncoder, bit ? &WRITE_1_SYMBOL : &WRITE_0_SYMBOL, sizeof(rmt_symbol_word_t));
+}
+
+//-----------------------------------------------------------------------------
+int OneWire::ReadBit()
+{
+    const size_t count = Exchange(READ_SYMBOLS, 1, SLOT_IDLE_NS);
+
+    // Nothing captured reads as the idle (released) line
+    return (count == 0 || _rxSymbols[0].duration0 < READ_SAMPLE_US) ? 1 : 0;
+}
+
+//-----------------------------------------------------------------------------
+void OneWire::WriteByte(uint8_t data)
+{
+    Transmit(_bytesEncoder, &data, sizeof(data));
+}
+
+//-----------------------------------------------------------------------------
+uint8_t OneWire::ReadByte()
+{
+    const size_t count = Exchange(READ_SYMBOLS, BITS_PER_BYTE, SLOT_IDLE_NS);
+
+    // Every read slot starts with our low pulse, so symbol i is slot i (LSB first)
+    uint8_t value = 0;
+    for (size_t i = 0; i < BITS_PER_BYTE; i++)
+    {
+        if (i >= count || _rxSymbols[i].duration0 < READ_SAMPLE_US)
+        {
+            value |= (1U << i);
+        }
+    }
+    return value;
+}
+
+//----private------------------------------------------------------------------
+size_t OneWire::Exchange(const rmt_symbol_word_t* symbols, size_t count, uint32_t idleNs)
+{
+    if (!_valid)
+    {
+        return 0;
+    }
+
+    const rmt_receive_config_t receiveConfig =
+    {
+        .signal_range_min_ns = GLITCH_NS,
+        .signal_range_max_ns = idleNs,
+    };
+
+    // Arm the capture before driving the line, or the first edge is lost
+    xQueueReset(_receiveDone);
+    if (rmt_receive(_rxChannel, _rxSymbols, sizeof(_rxSymbols), &receiveConfig) != ESP_OK)
+    {
+        CORE_ERROR("1-Wire receive failed");
+        return 0;
+    }
+
+    Transmit(_copyEncoder, symbols, count * sizeof(rmt_symbol_word_t));
+
+    rmt_rx_done_event_data_t event = {};
+    if (xQueueReceive(_receiveDone, &event, pdMS_TO_TICKS(FRAME_TIMEOUT_MS)) != pdTRUE)
+    {
+        // Cancel the pending receive so the next frame can arm it again
+        rmt_disable(_rxChannel);
+        rmt_enable(_rxChannel);
+
+        CORE_ERROR("1-Wire frame timed out");
+        return 0;
+    }
+
+    return event.num_symbols;
+}
+
+//----private------------------------------------------------------------------
+void OneWire::Transmit(rmt_encoder_handle_t encoder, const void* payload, size_t bytes)
+{
+    if (!_valid)
+    {
+        return;
+    }
+
+    rmt_transmit_config_t transmitConfig = {};
+    transmitConfig.flags.eot_level = 1;
+
+    if (rmt_transmit(_txChannel, encoder, payload, bytes, &transmitConfig) != ESP_OK
+     || rmt_tx_wait_all_done(_txChannel, FRAME_TIMEOUT_MS) != ESP_OK)
+    {
+        CORE_ERROR("1-Wire transmit failed");
+    }
+}
+
+//----private------------------------------------------------------------------
+bool OneWire::OnReceiveDone(rmt_channel_handle_t /*channel*/, const rmt_rx_done_event_data_t* event, void* context)
+{
+    // RX ISR: hand the capture over to the task waiting in Exchange()
+    BaseType_t taskWoken = pdFALSE;
+    xQueueSendFromISR(static_cast<OneWire*>(context)->_receiveDone, event, &taskWoken);
+    return (taskWoken == pdTRUE);
+}
+
+#endif // ONE_WIRE_USE_RMT
@@ -0,0 +1,48 @@
+/*!****************************************************************************
+ * @file    ema.h
+ * @brief   Exponential moving average: y += alpha * (x - y), O(1) per sample.
+ *          The first sample initializes the output instead of ramping from 0.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#pragma once
+
+namespace Dsp {
+
+/**
+ * @brief First-order low-pass filter.
+ * @tparam T Sample type (floating point).
+ */
+template <typename T>
+class Ema
+{
+    public:
+
+        using ValueType = T;
+
+        /**
+         * @param alpha Weight of the new sample, 0..1 (about 2 / (N + 1) to match an N-sample mean).
+         */
+        explicit Ema(T alpha = T(0.2))
+            : _alpha(alpha)
+        {
+        }
+
+        T Process(T sample)
+        {
+            _value = _primed ? (_value + _alpha * (sample - _value)) : sample;
+            _primed = true;
+            return _value;
+        }
+
+        void Reset() { _primed = false; }
+
+    private:
+
+        T _alpha;
+        T _value = T(0);
+        bool _primed = false;
+};
+
+} // namespace Dsp
@@ -0,0 +1,81 @@
+/*!****************************************************************************
+ * @file    filter_chain.h
+ * @brief   Filter stages composed at compile time. Each sample runs through
+ *          the stages in order; the stages live inline in the chain, so a
+ *          chain is a fixed-size value with no allocation or virtual calls.
+ *          A stage is any type with ValueType, Process(ValueType) and Reset()
+ *          (see moving_average.h, median_filter.h, hampel_filter.h, ema.h,
+ *          kalman_filter.h).
+ *
+ *          Example:
+ *              Dsp::FilterChain<Dsp::HampelFilter<float, 5>,
+ *                               Dsp::MovingAverage<float, 12>> filter;
+ *              const float smoothed = filter.Process(sample);
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace Dsp {
+
+/**
+ * @brief Stages applied in order to every sample.
+ * @tparam Stages Filter stages sharing the same ValueType.
+ */
+template <typename... Stages>
+class FilterChain
+{
+    static_assert(sizeof...(Stages) >= 1, "FilterChain needs at least one stage");
+
+    public:
+
+        using ValueType = typename std::tuple_element_t<0, std::tuple<Stages...>>::ValueType;
+
+        static_assert((std::is_same_v<typename Stages::ValueType, ValueType> && ...), "Stages must share the sample type");
+
+        FilterChain() = default;
+
+        /**
+         * @brief Chain of stages built with their own parameters.
+         */
+        explicit FilterChain(Stages... stages)
+            : _stages(std::move(stages)...)
+        {
+        }
+
+        /**
+         * @brief Run a sample through every stage.
+         * @return ValueType Output of the last stage.
+         */
+        ValueType Process(ValueType sample)
+        {
+            std::apply([&sample](auto&... stage) { ((sample = stage.Process(sample)), ...); }, _stages);
+            return sample;
+        }
+
+        void Reset()
+        {
+            std::apply([](auto&... stage) { (stage.Reset(), ...); }, _stages);
+        }
+
+        /**
+         * @brief Access a stage, e.g. to read its statistics.
+         */
+        template <size_t Index>
+        auto& GetStage() { return std::get<Index>(_stages); }
+
+        template <size_t Index>
+        const auto& GetStage() const { return std::get<Index>(_stages); }
+
+    private:
+
+        std::tuple<Stages...> _stages;
+};
+
+} // namespace Dsp
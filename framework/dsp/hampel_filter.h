@@ -0,0 +1,84 @@
+/*!****************************************************************************
+ * @file    hampel_filter.h
+ * @brief   Hampel outlier rejection over the last N samples: a sample farther
+ *          than k scaled MADs (median absolute deviations) from the window
+ *          median is replaced by the median, any other sample goes through
+ *          unchanged. The window keeps the raw samples, so a real step is
+ *          followed once it holds the majority of the window.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#pragma once
+
+#include "framework/dsp/median_filter.h"
+#include <cstddef>
+
+namespace Dsp {
+
+/**
+ * @brief Causal Hampel filter.
+ * @tparam T Sample type (floating point).
+ * @tparam N Window length, including the new sample.
+ */
+template <typename T, size_t N>
+class HampelFilter
+{
+    static_assert(N >= 3, "HampelFilter needs a window of at least three samples");
+
+    public:
+
+        using ValueType = T;
+
+        /**
+         * @param threshold Rejection distance in scaled MADs (3 is the usual choice).
+         */
+        explicit HampelFilter(T threshold = T(3))
+            : _threshold(threshold)
+        {
+        }
+
+        /**
+         * @brief Add a sample.
+         * @return T The sample, or the window median if the sample is an outlier.
+         */
+        T Process(T sample)
+        {
+            _window.Push(sample);
+
+            // Nothing to compare against yet
+            if (_window.GetCount() < MIN_SAMPLES)
+            {
+                return sample;
+            }
+
+            const T median = _window.Median();
+            const T mad = _window.MedianAbsoluteDeviation(median);
+            const T distance = (sample > median) ? (sample - median) : (median - sample);
+
+            if (distance > _threshold * MAD_TO_SIGMA * mad)
+            {
+                ++_rejectedCount;
+                return median;
+            }
+
+            return sample;
+        }
+
+        void Reset() { _window.Reset(); }
+
+        size_t GetRejectedCount() const { return _rejectedCount; }
+
+    private:
+
+        static constexpr size_t MIN_SAMPLES = 3;
+        static constexpr T MAD_TO_SIGMA = T(1.4826);       //!< MAD of a normal distribution is 0.6745 sigma
+
+        // ---------------------------------------------
+
+        SortedWindow<T, N> _window;
+        T _threshold;
+        size_t _rejectedCount = 0;
+};
+
+} // namespace Dsp
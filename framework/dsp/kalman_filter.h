@@ -0,0 +1,69 @@
+/*!****************************************************************************
+ * @file    kalman_filter.h
+ * @brief   Scalar Kalman filter for a slowly drifting value (random walk
+ *          model), O(1) per sample. Unlike a fixed EMA the gain starts high
+ *          and settles to the ratio of the process and measurement noises.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#pragma once
+
+namespace Dsp {
+
+/**
+ * @brief 1-D Kalman filter.
+ * @tparam T Sample type (floating point).
+ */
+template <typename T>
+class KalmanFilter
+{
+    public:
+
+        using ValueType = T;
+
+        /**
+         * @param processNoise     Variance the true value drifts by between two samples.
+         * @param measurementNoise Variance of a single measurement.
+         */
+        explicit KalmanFilter(T processNoise = T(1e-3), T measurementNoise = T(1e-1))
+            : _processNoise(processNoise)
+            , _measurementNoise(measurementNoise)
+        {
+        }
+
+        T Process(T measurement)
+        {
+            if (!_primed)
+            {
+                _estimate = measurement;
+                _errorVariance = _measurementNoise;
+                _primed = true;
+                return _estimate;
+            }
+
+            // Predict: the value may have drifted
+            _errorVariance += _processNoise;
+
+            // Update with the measurement
+            const T gain = _errorVariance / (_errorVariance + _measurementNoise);
+            _estimate += gain * (measurement - _estimate);
+            _errorVariance *= (T(1) - gain);
+
+            return _estimate;
+        }
+
+        void Reset() { _primed = false; }
+
+        T GetErrorVariance() const { return _errorVariance; }
+
+    private:
+
+        T _processNoise;
+        T _measurementNoise;
+        T _estimate = T(0);
+        T _errorVariance = T(0);
+        bool _primed = false;
+};
+
+} // namespace Dsp
@@ -0,0 +1,173 @@
+/*!****************************************************************************
+ * @file    median_filter.h
+ * @brief   Running median over the last N samples. The window is kept both in
+ *          arrival order (to know which sample leaves) and sorted: a new
+ *          sample costs two binary searches and one shift of at most N
+ *          elements, and the median is read in O(1).
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+
+namespace Dsp {
+
+/**
+ * @brief Last N samples in arrival order and in sorted order.
+ * @tparam T Sample type (totally ordered).
+ * @tparam N Window length.
+ */
+template <typename T, size_t N>
+class SortedWindow
+{
+    static_assert(N >= 1, "SortedWindow needs a window of at least one sample");
+
+    public:
+
+        void Push(T sample)
+        {
+            if (_count == N)
+            {
+                // Take out the oldest sample: the run of equal values only needs one of them gone
+                const T oldest = _arrival[_next];
+                const auto position = std::lower_bound(_sorted.begin(), _sorted.begin() + _count, oldest);
+                std::copy(position + 1, _sorted.begin() + _count, position);
+                --_count;
+            }
+
+            const auto position = std::upper_bound(_sorted.begin(), _sorted.begin() + _count, sample);
+            std::copy_backward(position, _sorted.begin() + _count, _sorted.begin() + _count + 1);
+            *position = sample;
+            ++_count;
+
+            _arrival[_next] = sample;
+            _next = (_next + 1) % N;
+        }
+
+        void Reset()
+        {
+            _count = 0;
+            _next = 0;
+        }
+
+        size_t GetCount() const { return _count; }
+
+        /**
+         * @brief i-th smallest sample in the window, i < GetCount().
+         */
+        const T& operator[](size_t i) const { return _sorted[i]; }
+
+        /**
+         * @brief Median of the window (mean of the two middle samples for an even count).
+         */
+        T Median() const
+        {
+            const size_t half = _count / 2;
+            return ((_count % 2) != 0) ? _sorted[half] : static_cast<T>((_sorted[half - 1] + _sorted[half]) / 2);
+        }
+
+        /**
+         * @brief Median absolute deviation from the given center (normally Median()).
+         *        Deviations below and above the center are two sorted sequences,
+         *        so their k-th smallest is found by binary search in O(log N).
+         */
+        T MedianAbsoluteDeviation(T center) const
+        {
+            const size_t half = _count / 2;
+            return ((_count % 2) != 0) ? KthDeviation(center, half)
+                                       : static_cast<T>((KthDeviation(center, half - 1) + KthDeviation(center, half)) / 2);
+        }
+
+    private:
+
+        /**
+         * @brief k-th smallest (from 0) of |x - center| over the window.
+         */
+        T KthDeviation(T center, size_t k) const
+        {
+            // below: center - _sorted[split - 1 - i], ascending in i
+            // above: _sorted[split + i] - center, ascending in i
+            const size_t split = static_cast<size_t>(std::lower_bound(_sorted.begin(), _sorted.begin() + _count, center) - _sorted.begin());
+            const size_t belowCount = split;
+            const size_t aboveCount = _count - split;
+
+            auto below = [&](size_t i) { return static_cast<T>(center - _sorted[split - 1 - i]); };
+            auto above = [&](size_t i) { return static_cast<T>(_sorted[split + i] - center); };
+
+            // Take i elements from 'below' and k + 1 - i from 'above' so that both prefixes
+            // together are the k + 1 smallest deviations
+            size_t low = (k + 1 > aboveCount) ? (k + 1 - aboveCount) : 0;
+            size_t high = std::min(k + 1, belowCount);
+
+            while (low < high)
+            {
+                const size_t i = (low + high) / 2;
+                const size_t j = k + 1 - i;
+
+                // Too few from 'below' while its next one is smaller than the last one taken from 'above'
+                if (j > 0 && i < belowCount && below(i) < above(j - 1))
+                {
+                    low = i + 1;
+                }
+                else
+                {
+                    high = i;
+                }
+            }
+
+            const size_t i = low;
+            const size_t j = k + 1 - i;
+
+            if (i == 0)
+            {
+                return above(j - 1);
+            }
+            if (j == 0)
+            {
+                return below(i - 1);
+            }
+            return std::max(below(i - 1), above(j - 1));
+        }
+
+        // ---------------------------------------------
+
+        std::array<T, N> _arrival{};
+        std::array<T, N> _sorted{};
+        size_t _count = 0;
+        size_t _next = 0;
+};
+
+/**
+ * @brief Running median filter.
+ * @tparam T Sample type.
+ * @tparam N Window length (odd lengths give a true sample as output).
+ */
+template <typename T, size_t N>
+class MedianFilter
+{
+    public:
+
+        using ValueType = T;
+
+        /**
+         * @brief Add a sample.
+         * @return T Median of the samples in the window.
+         */
+        T Process(T sample)
+        {
+            _window.Push(sample);
+            return _window.Median();
+        }
+
+        void Reset() { _window.Reset(); }
+
+    private:
+
+        SortedWindow<T, N> _window;
+};
+
+} // namespace Dsp
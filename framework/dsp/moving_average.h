@@ -0,0 +1,98 @@
+/*!****************************************************************************
+ * @file    moving_average.h
+ * @brief   Moving average over the last N samples, kept as a running sum on a
+ *          fixed array: O(1) per sample. Floating-point sums are recomputed
+ *          from the window once per wrap so rounding errors cannot pile up,
+ *          which keeps the cost amortized O(1).
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace Dsp {
+
+/**
+ * @brief Running-sum moving average.
+ * @tparam T Sample type (arithmetic).
+ * @tparam N Window length.
+ */
+template <typename T, size_t N>
+class MovingAverage
+{
+    static_assert(std::is_arithmetic_v<T>, "MovingAverage needs an arithmetic sample type");
+    static_assert(N >= 1, "MovingAverage needs a window of at least one sample");
+
+    public:
+
+        using ValueType = T;
+
+        /**
+         * @brief Add a sample.
+         * @return T Mean of the samples in the window (fewer than N until it fills up).
+         */
+        T Process(T sample)
+        {
+            if (_count == N)
+            {
+                _sum -= _window[_next];
+            }
+            else
+            {
+                ++_count;
+            }
+
+            _window[_next] = sample;
+            _sum += sample;
+
+            if (++_next == N)
+            {
+                _next = 0;
+
+                if constexpr (std::is_floating_point_v<T>)
+                {
+                    Resync();
+                }
+            }
+
+            return static_cast<T>(_sum / static_cast<Accumulator>(_count));
+        }
+
+        void Reset()
+        {
+            _sum = 0;
+            _count = 0;
+            _next = 0;
+        }
+
+        size_t GetCount() const { return _count; }
+
+    private:
+
+        //! Integer sums are exact in 64 bits
+        using Accumulator = std::conditional_t<std::is_floating_point_v<T>, T, int64_t>;
+
+        void Resync()
+        {
+            Accumulator sum = 0;
+            for (size_t i = 0; i < _count; ++i)
+            {
+                sum += _window[i];
+            }
+            _sum = sum;
+        }
+
+        // ---------------------------------------------
+
+        std::array<T, N> _window{};
+        Accumulator _sum = 0;
+        size_t _count = 0;
+        size_t _next = 0;
+};
+
+} // namespace Dsp
@@ -0,0 +1,190 @@
+/*!****************************************************************************
+ * @file    rolling_trend.h
+ * @brief   Statistics of the last N samples, O(1) per sample: mean and
+ *          variance by a windowed Welford update (the oldest sample leaves
+ *          as the new one enters), slope by least squares with the running
+ *          sums of a sliding linear regression, and the z-score of each new
+ *          sample against the window before it. Samples are taken to be
+ *          evenly spaced, so the slope is per sample.
+ *
+ *          The sums are rebuilt from the window once per wrap, around the
+ *          mean of the moment, so floating-point errors cannot pile up and
+ *          the sums stay small whatever the level of the signal.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+
+namespace Dsp {
+
+/**
+ * @brief Rolling mean / variance / slope and z-score detector.
+ * @tparam T Sample type (floating point).
+ * @tparam N Window length.
+ */
+template <typename T, size_t N>
+class RollingTrend
+{
+    static_assert(std::is_floating_point_v<T>, "RollingTrend needs a floating-point sample type");
+    static_assert(N >= 2, "RollingTrend needs a window of at least two samples");
+
+    public:
+
+        using ValueType = T;
+
+        /**
+         * @param minStdDev Floor of the standard deviation the z-score divides by, so that
+         *                  a flat signal (or a quantized one) does not turn its first
+         *                  step into a huge score. About the resolution of the sensor.
+         */
+        explicit RollingTrend(T minStdDev = T(0))
+            : _minStdDev(minStdDev)
+        {
+        }
+
+        /**
+         * @brief Add a sample.
+         * @return T Z-score of the sample against the samples already in the window
+         *         (0 until there are two of them).
+         */
+        T Process(T sample)
+        {
+            T zScore = T(0);
+            if (_count >= 2)
+            {
+                zScore = (sample - GetMean()) / std::max(GetStdDev(), _minStdDev);
+            }
+
+            if (_count == 0)
+            {
+                _offset = sample;
+            }
+
+            const T y = sample - _offset;
+
+            if (_count == N)
+            {
+                const T oldY = _window[_next] - _offset;
+
+                // The oldest sample (x = 0) leaves, the others move one x down and the new one
+                // enters at x = N - 1
+                _sumXY += T(N - 1) * y - (_sumY - oldY);
+                _sumY += y - oldY;
+
+                const T delta = y - oldY;
+                const T mean = _meanY + delta / T(N);
+                _m2 = std::max(T(0), _m2 + delta * ((y - mean) + (oldY - _meanY)));
+                _meanY = mean;
+            }
+            else
+            {
+                _sumXY += T(_count) * y;
+                _sumY += y;
+
+                ++_count;
+                const T delta = y - _meanY;
+                _meanY += delta / T(_count);
+                _m2 += delta * (y - _meanY);
+            }
+
+            _window[_next] = sample;
+
+            if (++_next == N)
+            {
+                _next = 0;
+                Resync();
+            }
+
+            return zScore;
+        }
+
+        void Reset()
+        {
+            _count = 0;
+            _next = 0;
+            _offset = T(0);
+            _meanY = T(0);
+            _m2 = T(0);
+            _sumY = T(0);
+            _sumXY = T(0);
+        }
+
+        size_t GetCount() const { return _count; }
+        bool IsFull() const { return _count == N; }
+
+        T GetMean() const { return _offset + _meanY; }
+
+        //! Sample variance (0 below two samples)
+        T GetVariance() const { return (_count < 2) ? T(0) : (_m2 / T(_count - 1)); }
+
+        T GetStdDev() const { return std::sqrt(GetVariance()); }
+
+        //! Least-squares slope per sample (0 below two samples)
+        T GetSlope() const
+        {
+            if (_count < 2)
+            {
+                return T(0);
+            }
+
+            // sum((x - meanX) * y) / sum((x - meanX)^2), with x = 0 .. n - 1
+            const T n = T(_count);
+            const T meanX = (n - T(1)) / T(2);
+            return (_sumXY - meanX * _sumY) / (n * (n * n - T(1)) / T(12));
+        }
+
+    private:
+
+        //! Only called on a wrap: the window is full and its oldest sample is at index 0
+        void Resync()
+        {
+            _offset = GetMean();
+
+            T sum = T(0);
+            T sumXY = T(0);
+            for (size_t i = 0; i < N; ++i)
+            {
+                const T y = _window[i] - _offset;
+                sum += y;
+                sumXY += T(i) * y;
+            }
+
+            const T meanY = sum / T(N);
+
+            T m2 = T(0);
+            for (size_t i = 0; i < N; ++i)
+            {
+                const T d = (_window[i] - _offset) - meanY;
+                m2 += d * d;
+            }
+
+            _meanY = meanY;
+            _sumY = sum;
+            _sumXY = sumXY;
+            _m2 = m2;
+        }
+
+        // ---------------------------------------------
+
+        std::array<T, N> _window{};
+        size_t _count = 0;
+        size_t _next = 0;
+        T _minStdDev;
+
+        //! All the sums are kept on the samples minus this (the first sample, then the mean at the last wrap)
+        T _offset = T(0);
+
+        T _meanY = T(0);
+        T _m2 = T(0);                   //!< Sum of squared deviations from the mean
+        T _sumY = T(0);
+        T _sumXY = T(0);                //!< x: position in the window, oldest at 0
+};
+
+} // namespace Dsp
@@ -0,0 +1,195 @@
+/*!****************************************************************************
+ * @file    arena.cpp
+ * @brief   Implementation of Arena and ArenaScope.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#include "framework/memory/arena.h"
+
+#include "framework/common_defs.h"
+#include "freertos/FreeRTOS.h"
+#include <algorithm>
+#include <new>
+
+namespace Memory {
+
+namespace {
+
+//! Innermost scope of each task
+thread_local ArenaScope* s_currentScope = nullptr;
+
+//! Every live arena, so a pointer can be traced back to its arena from any task
+Arena* s_arenas = nullptr;
+portMUX_TYPE s_arenasLock = portMUX_INITIALIZER_UNLOCKED;
+
+} // namespace
+
+//-----------------------------------------------------------------------------
+Arena::Arena(const char* name, void* buffer, size_t capacity)
+    : _name(name)
+    , _buffer(static_cast<uint8_t*>(buffer))
+    , _capacity(capacity)
+    , _used(0)
+    , _peak(0)
+    , _heapFallbacks(0)
+    , _strayFrees(0)
+{
+    portENTER_CRITICAL(&s_arenasLock);
+    _next = s_arenas;
+    s_arenas = this;
+    portEXIT_CRITICAL(&s_arenasLock);
+}
+
+//-----------------------------------------------------------------------------
+Arena::~Arena()
+{
+    portENTER_CRITICAL(&s_arenasLock);
+    for (Arena** link = &s_arenas; *link != nullptr; link = &(*link)->_next)
+    {
+        if (*link == this)
+        {
+            *link = _next;
+            break;
+        }
+    }
+    portEXIT_CRITICAL(&s_arenasLock);
+}
+
+//-----------------------------------------------------------------------------
+void* Arena::Allocate(size_t size, size_t alignment)
+{
+    const uintptr_t base = reinterpret_cast<uintptr_t>(_buffer);
+    const uintptr_t aligned = (base + _used + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1);
+    const size_t offset = aligned - base;
+
+    if (offset + size > _capacity)
+    {
+        return nullptr;
+    }
+
+    _used = offset + size;
+    _peak = std::max(_peak, _used);
+
+    return _buffer + offset;
+}
+
+//-----------------------------------------------------------------------------
+bool Arena::Owns(const void* ptr) const
+{
+    const uint8_t* p = static_cast<const uint8_t*>(ptr);
+    return p >= _buffer && p < _buffer + _capacity;
+}
+
+//-----------------------------------------------------------------------------
+void Arena::Rewind(size_t mark)
+{
+    _used = std::min(mark, _used);
+}
+
+//-----------------------------------------------------------------------------
+auto Arena::GetStats() const -> Stats
+{
+    Stats stats;
+    stats.capacity = _capacity;
+    stats.used = _used;
+    stats.peak = _peak;
+    stats.heapFallbacks = _heapFallbacks;
+    stats.strayFrees = _strayFrees;
+    return stats;
+}
+
+//----private------------------------------------------------------------------
+Arena* Arena::FindOwner(const void* ptr)
+{
+    portENTER_CRITICAL(&s_arenasLock);
+
+    Arena* owner = s_arenas;
+    while (owner != nullptr && !owner->Owns(ptr))
+    {
+        owner = owner->_next;
+    }
+
+    if (owner != nullptr)
+    {
+        ++owner->_strayFrees;
+    }
+
+    portEXIT_CRITICAL(&s_arenasLock);
+    return owner;
+}
+
+//-----------------------------------------------------------------------------
+ArenaScope::ArenaScope(Arena& arena)
+    : _arena(arena)
+    , _previous(s_currentScope)
+    , _mark(arena.GetMark())
+    , _heapFallbacksAtEntry(arena._heapFallbacks)
+{
+    s_currentScope = this;
+}
+
+//-----------------------------------------------------------------------------
+ArenaScope::~ArenaScope()
+{
+    const uint32_t fallbacks = _arena._heapFallbacks - _heapFallbacksAtEntry;
+    if (fallbacks > 0)
+    {
+        CORE_WARNING("Arena '%s' exhausted: %u allocations went to the heap (peak %u of %u bytes)",
+                     _arena._name,
+                     static_cast<unsigned>(fallbacks),
+                     static_cast<unsigned>(_arena._peak),
+                     static_cast<unsigned>(_arena._capacity));
+    }
+
+    _arena.Rewind(_mark);
+    s_currentScope = _previous;
+}
+
+//-----------------------------------------------------------------------------
+void* ArenaScope::Allocate(size_t size, size_t alignment)
+{
+    if (s_currentScope != nullptr)
+    {
+        Arena& arena = s_currentScope->_arena;
+
+        void* ptr = arena.Allocate(size, alignment);
+        if (ptr != nullptr)
+        {
+            return ptr;
+        }
+
+        ++arena._heapFallbacks;
+    }
+
+    return ::operator new(size);
+}
+
+//-----------------------------------------------------------------------------
+void ArenaScope::Deallocate(void* ptr)
+{
+    for (const ArenaScope* scope = s_currentScope; scope != nullptr; scope = scope->_previous)
+    {
+        if (scope->_arena.Owns(ptr))
+        {
+            return;
+        }
+    }
+
+    // Freeing an arena block through the heap allocator would corrupt it
+    if (const Arena* owner = Arena::FindOwner(ptr))
+    {
+        CORE_ERROR("Block of arena '%s' freed outside its scope, ignored", owner->_name);
+        return;
+    }
+
+    ::operator delete(ptr);
+}
+
+//-----------------------------------------------------------------------------
+Arena* ArenaScope::GetCurrent()
+{
+    return (s_currentScope != nullptr) ? &s_currentScope->_arena : nullptr;
+}
+
+} // namespace Memory
@@ -0,0 +1,195 @@
+/*!****************************************************************************
+ * @file    arena.h
+ * @brief   Bump allocator over a static buffer, reset at the end of each
+ *          request. ArenaScope binds an arena to the calling task so that
+ *          ArenaAllocator (and containers using it, e.g. ArenaJson) take
+ *          their memory from it instead of the general heap.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace Memory {
+
+/**
+ * @brief Linear allocator over a caller-provided buffer. Individual frees are
+ *        no-ops; memory is reclaimed all at once with Rewind()/Reset().
+ */
+class Arena
+{
+    public:
+
+        struct Stats
+        {
+            size_t capacity = 0;            //!< Size of the buffer
+            size_t used = 0;                //!< Bytes currently handed out
+            size_t peak = 0;                //!< Highest 'used' ever seen
+            uint32_t heapFallbacks = 0;     //!< Allocations that did not fit and went to the heap
+            uint32_t strayFrees = 0;        //!< Blocks freed after their scope closed or from another task (ignored)
+        };
+
+        /**
+         * @brief Construct an arena over a buffer.
+         * @param name Name for debug purposes.
+         * @param buffer Backing memory, must outlive the arena.
+         * @param capacity Size of the buffer in bytes.
+         */
+        Arena(const char* name, void* buffer, size_t capacity);
+        ~Arena();
+
+        Arena(const Arena&) = delete;
+        Arena& operator=(const Arena&) = delete;
+
+        /**
+         * @brief Carve a block out of the arena.
+         * @return void* Block, nullptr if it does not fit.
+         */
+        void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+        /**
+         * @brief Checks if a pointer lies inside the arena buffer.
+         */
+        bool Owns(const void* ptr) const;
+
+        /**
+         * @brief Current fill level, to be passed back to Rewind().
+         */
+        size_t GetMark() const { return _used; }
+
+        /**
+         * @brief Release everything allocated after the given mark.
+         */
+        void Rewind(size_t mark);
+
+        /**
+         * @brief Release everything.
+         */
+        void Reset() { Rewind(0); }
+
+        const char* GetName() const { return _name; }
+
+        Stats GetStats() const;
+
+    private:
+
+        friend class ArenaScope;
+
+        /**
+         * @brief Arena whose buffer holds the pointer, among every arena alive.
+         *        The free is counted as stray on it.
+         */
+        static Arena* FindOwner(const void* ptr);
+
+        const char* _name;
+        uint8_t* _buffer;
+        size_t _capacity;
+        size_t _used;
+        size_t _peak;
+        uint32_t _heapFallbacks;
+        uint32_t _strayFrees;
+        Arena* _next;                       //!< Registry of live arenas, see FindOwner()
+};
+
+/**
+ * @brief Arena that owns its buffer.
+ * @tparam Capacity Size of the buffer in bytes.
+ */
+template <size_t Capacity>
+class StaticArena : public Arena
+{
+    public:
+
+        explicit StaticArena(const char* name)
+            : Arena(name, _storage, Capacity)
+        {}
+
+    private:
+
+        alignas(std::max_align_t) uint8_t _storage[Capacity];
+};
+
+/**
+ * @brief Binds an arena to the calling task for the lifetime of the scope.
+ *        Scopes nest; on destruction the arena is rewound to where it was
+ *        when the scope was opened. Objects allocated inside a scope must not
+ *        outlive it.
+ */
+class ArenaScope
+{
+    public:
+
+        explicit ArenaScope(Arena& arena);
+        ~ArenaScope();
+
+        ArenaScope(const ArenaScope&) = delete;
+        ArenaScope& operator=(const ArenaScope&) = delete;
+
+        /**
+         * @brief Allocate from the innermost scope of the calling task, or from
+         *        the heap when there is none or the arena is exhausted.
+         */
+        static void* Allocate(size_t size, size_t alignment);
+
+        /**
+         * @brief Release a block obtained with Allocate(). Arena blocks are left
+         *        in place until their scope closes; heap blocks are freed. An arena
+         *        block freed outside its scope (after it closed, or from another task)
+         *        is never handed to the heap: it is counted in Stats::strayFrees.
+         */
+        static void Deallocate(void* ptr);
+
+        /**
+         * @brief Innermost arena of the calling task, nullptr outside any scope.
+         */
+        static Arena* GetCurrent();
+
+    private:
+
+        Arena& _arena;
+        ArenaScope* _previous;
+        size_t _mark;
+        uint32_t _heapFallbacksAtEntry;
+};
+
+/**
+ * @brief Stateless std allocator routed through ArenaScope. Instances always
+ *        compare equal: the owner of a block is found from its address.
+ */
+template <typename T>
+class ArenaAllocator
+{
+    public:
+
+        using value_type = T;
+        using is_always_equal = std::true_type;
+
+        ArenaAllocator() noexcept = default;
+
+        template <typename U>
+        ArenaAllocator(const ArenaAllocator<U>&) noexcept {}
+
+        T* allocate(size_t count)
+        {
+            return static_cast<T*>(ArenaScope::Allocate(count * sizeof(T), alignof(T)));
+        }
+
+        void deallocate(T* ptr, size_t)
+        {
+            ArenaScope::Deallocate(ptr);
+        }
+
+        template <typename U>
+        bool operator==(const ArenaAllocator<U>&) const noexcept { return true; }
+
+        template <typename U>
+        bool operator!=(const ArenaAllocator<U>&) const noexcept { return false; }
+};
+
+using ArenaString = std::basic_string<char, std::char_traits<char>, ArenaAllocator<char>>;
+
+} // namespace Memory
@@ -0,0 +1,429 @@
+/*!****************************************************************************
+ * @file    arena_json.cpp
+ * @brief   Recursive descent JSON reader building an ArenaJson (RFC 8259)
+ *          and the serializer entry point writing into an ArenaString.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#include "framework/memory/arena_json.h"
+
+#include <charconv>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+
+namespace Memory {
+
+namespace {
+
+class Reader
+{
+    public:
+
+        explicit Reader(std::string_view text)
+            : _text(text)
+            , _pos(0)
+        {}
+
+        bool ReadDocument(ArenaJson& document)
+        {
+            if (!ReadValue(document, 0))
+            {
+                return false;
+            }
+
+            SkipWhitespace();
+            return _pos == _text.size();
+        }
+
+    private:
+
+        //-----------------------------------------------------------------------------
+        bool ReadValue(ArenaJson& value, size_t depth)
+        {
+            SkipWhitespace();
+            if (AtEnd())
+            {
+                return false;
+            }
+
+            switch (_text[_pos])
+            {
+                case '{': return ReadObject(value, depth + 1);
+                case '[': return ReadArray(value, depth + 1);
+                case '"':
+                {
+                    ArenaString string;
+                    if (!ReadString(string))
+                    {
+                        return false;
+                    }
+                    value = std::move(string);
+                    return true;
+                }
+                case 't': value = true;    return ReadLiteral("true");
+                case 'f': value = false;   return ReadLiteral("false");
+                case 'n': value = nullptr; return ReadLiteral("null");
+                default:  return ReadNumber(value);
+            }
+        }
+
+        //-----------------------------------------------------------------------------
+        bool ReadObject(ArenaJson& value, size_t depth)
+        {
+            if (depth > MAX_JSON_DEPTH)
+            {
+                return false;
+            }
+
+            ++_pos;
+            value = ArenaJson::object();
+            auto& members = value.get_ref<ArenaJson::object_t&>();
+
+            SkipWhitespace();
+            if (Consume('}'))
+            {
+                return true;
+            }
+
+            do
+            {
+                SkipWhitespace();
+                ArenaString key;
+                if (AtEnd() || _text[_pos] != '"' || !ReadString(key))
+                {
+                    return false;
+                }
+
+                SkipWhitespace();
+                if (!Consume(':'))
+                {
+                    return false;
+                }
+
+                // A repeated key keeps the last value, as nlohmann does
+                if (!ReadValue(members[std::move(key)], depth))
+                {
+                    return false;
+                }
+
+                SkipWhitespace();
+            } while (Consume(','));
+
+            return Consume('}');
+        }
+
+        //-----------------------------------------------------------------------------
+        bool ReadArray(ArenaJson& value, size_t depth)
+        {
+            if (depth > MAX_JSON_DEPTH)
+            {
+                return false;
+            }
+
+            ++_pos;
+            value = ArenaJson::array();
+            auto& items = value.get_ref<ArenaJson::array_t&>();
+
+            SkipWhitespace();
+            if (Consume(']'))
+            {
+                return true;
+            }
+
+            do
+            {
+                items.emplace_back();
+                if (!ReadValue(items.back(), depth))
+                {
+                    return false;
+                }
+
+                SkipWhitespace();
+            } while (Consume(','));
+
+            return Consume(']');
+        }
+
+        //-----------------------------------------------------------------------------
+        bool ReadString(ArenaString& string)
+        {
+            ++_pos;
+
+            while (!AtEnd())
+            {
+                const char c = _text[_pos++];
+
+                if (c == '"')
+                {
+                    return true;
+                }
+
+                if (static_cast<unsigned char>(c) < 0x20)
+                {
+                    return false;
+                }
+
+                if (c != '\\')
+                {
+                    string.push_back(c);
+                    continue;
+                }
+
+                if (AtEnd())
+                {
+                    return false;
+                }
+
+                switch (_text[_pos++])
+                {
+                    case '"':  string.push_back('"');  break;
+                    case '\\': string.push_back('\\'); break;
+                    case '/':  string.push_back('/');  break;
+                    case 'b':  string.push_back('\b'); break;
+                    case 'f':  string.push_back('\f'); break;
+                    case 'n':  string.push_back('\n'); break;
+                    case 'r':  string.push_back('\r'); break;
+                    case 't':  string.push_back('\t'); break;
+                    case 'u':
+                    {
+                        if (!ReadCodePoint(string))
+                        {
+                            return false;
+                        }
+                    }
+                    break;
+                    default:   return false;
+                }
+            }
+
+            return false;
+        }
+
+        //-----------------------------------------------------------------------------
+        // \uXXXX, with a surrogate pair for code points above the BMP, to UTF-8
+        bool ReadCodePoint(ArenaString& string)
+        {
+            uint32_t codePoint = 0;
+            if (!ReadHex4(codePoint))
+            {
+                return false;
+            }
+
+            if (codePoint >= 0xD800 && codePoint <= 0xDBFF)
+            {
+                uint32_t low = 0;
+                if (!Consume('\\') || !Consume('u') || !ReadHex4(low) || low < 0xDC00 || low > 0xDFFF)
+                {
+                    return false;
+                }
+                codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+            }
+            else if (codePoint >= 0xDC00 && codePoint <= 0xDFFF)
+            {
+                return false;
+            }
+
+            if (codePoint < 0x80)
+            {
+                string.push_back(static_cast<char>(codePoint));
+            }
+            else if (codePoint < 0x800)
+            {
+                string.push_back(static_cast<char>(0xC0 | (codePoint >> 6)));
+                string.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+            }
+            else if (codePoint < 0x10000)
+            {
+                string.push_back(static_cast<char>(0xE0 | (codePoint >> 12)));
+                string.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+                string.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+            }
+            else
+            {
+                string.push_back(static_cast<char>(0xF0 | (codePoint >> 18)));
+                string.push_back(static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F)));
+                string.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+                string.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+            }
+            return true;
+        }
+
+        //-----------------------------------------------------------------------------
+        bool ReadHex4(uint32_t& value)
+        {
+            if (_text.size() - _pos < 4)
+            {
+                return false;
+            }
+
+            const char* first = _text.data() + _pos;
+            const auto [end, error] = std::from_chars(first, first + 4, value, 16);
+            if (error != std::errc() || end != first + 4)
+            {
+                return false;
+            }
+
+            _pos += 4;
+            return true;
+        }
+
+        //-----------------------------------------------------------------------------
+        // Integers as int64 (negative) or uint64 like nlohmann; with a fraction,
+        // an exponent or out of range, as double
+        bool ReadNumber(ArenaJson& value)
+        {
+            const size_t start = _pos;
+            bool integer = true;
+
+            Consume('-');
+            if (Consume('0'))
+            {
+                // No leading zeros
+            }
+            else if (!SkipDigits())
+            {
+                return false;
+            }
+
+            if (Consume('.'))
+            {
+                integer = false;
+                if (!SkipDigits())
+                {
+                    return false;
+                }
+            }
+
+            if (!AtEnd() && (_text[_pos] == 'e' || _text[_pos] == 'E'))
+            {
+                ++_pos;
+                integer = false;
+                if (!Consume('+'))
+                {
+                    Consume('-');
+                }
+                if (!SkipDigits())
+                {
+                    return false;
+                }
+            }
+
+            const char* first = _text.data() + start;
+            const char* last = _text.data() + _pos;
+
+            if (integer)
+            {
+                if (*first == '-')
+                {
+                    int64_t number = 0;
+                    if (std::from_chars(first, last, number).ec == std::errc())
+                    {
+                        value = number;
+                        return true;
+                    }
+                }
+                else
+                {
+                    uint64_t number = 0;
+                    if (std::from_chars(first, last, number).ec == std::errc())
+                    {
+                        value = number;
+                        return true;
+                    }
+                }
+            }
+
+            // strtod needs a terminator the view does not have
+            char buffer[64];
+            const size_t length = static_cast<size_t>(last - first);
+            if (length >= sizeof(buffer))
+            {
+                return false;
+            }
+            std::memcpy(buffer, first, length);
+            buffer[length] = '\0';
+
+            value = std::strtod(buffer, nullptr);
+            return true;
+        }
+
+        //-----------------------------------------------------------------------------
+        bool ReadLiteral(const char* literal)
+        {
+            const size_t length = std::strlen(literal);
+            if (_text.compare(_pos, length, literal) != 0)
+            {
+                return false;
+            }
+
+            _pos += length;
+            return true;
+        }
+
+        //-----------------------------------------------------------------------------
+        bool SkipDigits()
+        {
+            const size_t start = _pos;
+            while (!AtEnd() && _text[_pos] >= '0' && _text[_pos] <= '9')
+            {
+                ++_pos;
+            }
+            return _pos > start;
+        }
+
+        //-----------------------------------------------------------------------------
+        void SkipWhitespace()
+        {
+            while (!AtEnd() && (_text[_pos] == ' ' || _text[_pos] == '\t' || _text[_pos] == '\n' || _text[_pos] == '\r'))
+            {
+                ++_pos;
+            }
+        }
+
+        //-----------------------------------------------------------------------------
+        bool Consume(char c)
+        {
+            if (!AtEnd() && _text[_pos] == c)
+            {
+                ++_pos;
+                return true;
+            }
+            return false;
+        }
+
+        bool AtEnd() const { return _pos >= _text.size(); }
+
+        std::string_view _text;
+        size_t _pos;
+};
+
+} // namespace
+
+//-----------------------------------------------------------------------------
+ArenaJson ParseArenaJson(std::string_view text)
+{
+    ArenaJson document;
+
+    Reader reader(text);
+    if (!reader.ReadDocument(document))
+    {
+        return ArenaJson(ArenaJson::value_t::discarded);
+    }
+
+    return document;
+}
+
+//-----------------------------------------------------------------------------
+ArenaString DumpArenaJson(const ArenaJson& json)
+{
+    using Adapter = nlohmann::detail::output_string_adapter<char, ArenaString>;
+
+    ArenaString result;
+    nlohmann::detail::serializer<ArenaJson> serializer(std::allocate_shared<Adapter>(ArenaAllocator<Adapter>(), result), ' ');
+    serializer.dump(json, false, false, 0);
+    return result;
+}
+
+} // namespace Memory
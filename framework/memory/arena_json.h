@@ -0,0 +1,90 @@
+/*!****************************************************************************
+ * @file    arena_json.h
+ * @brief   nlohmann::json flavour whose strings, objects and arrays are
+ *          allocated through ArenaAllocator. Inside an ArenaScope a whole DOM
+ *          (parse, build, dump) stays off the general heap.
+ *          StaticVector converts to and from a JSON array like std::vector.
+ *          ParseArenaJson() and DumpArenaJson() replace parse() and dump(),
+ *          whose own buffers use std::allocator.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#pragma once
+
+#include "framework/memory/arena.h"
+#include "framework/memory/static_vector.h"
+#include "lib/nlohmann_json/json.hpp"
+#include <cstdint>
+#include <cstdlib>
+#include <map>
+#include <string_view>
+#include <vector>
+
+namespace Memory {
+
+using ArenaJson = nlohmann::basic_json<
+    std::map,
+    std::vector,
+    ArenaString,
+    bool,
+    std::int64_t,
+    std::uint64_t,
+    double,
+    ArenaAllocator
+>;
+
+/**
+ * @brief Parse a JSON document like ArenaJson::parse(text, nullptr, false), but
+ *        with the lexer and the nesting stack on the task stack: inside an
+ *        ArenaScope nothing but the arena is touched.
+ * @param text  Document, not necessarily NUL-terminated.
+ * @return ArenaJson The document; a discarded value (is_discarded()) on a syntax
+ *         error or nesting deeper than MAX_JSON_DEPTH.
+ */
+ArenaJson ParseArenaJson(std::string_view text);
+
+/**
+ * @brief Serialize like json.dump(), but the output adapter nlohmann shares with
+ *        the serializer is allocated in the arena as well.
+ */
+ArenaString DumpArenaJson(const ArenaJson& json);
+
+static constexpr size_t MAX_JSON_DEPTH = 16;
+
+} // namespace Memory
+
+//! Arrays longer than the capacity are rejected like a type mismatch would be
+//! (out_of_range 408, std::abort() without exceptions): check size() first
+template <typename T, size_t N>
+struct nlohmann::adl_serializer<Memory::StaticVector<T, N>>
+{
+    template <typename BasicJsonType>
+    static void to_json(BasicJsonType& j, const Memory::StaticVector<T, N>& value)
+    {
+        j = BasicJsonType::array();
+        for (const T& item : value)
+        {
+            j.push_back(item);
+        }
+    }
+
+    template <typename BasicJsonType>
+    static void from_json(const BasicJsonType& j, Memory::StaticVector<T, N>& value)
+    {
+        if (j.size() > N)
+        {
+#if defined(__cpp_exceptions)
+            throw nlohmann::detail::out_of_range::create(408, "array does not fit a StaticVector", &j);
+#else
+            std::abort();
+#endif
+        }
+
+        value.clear();
+        for (const auto& item : j)
+        {
+            value.push_back(item.template get<T>());
+        }
+    }
+};
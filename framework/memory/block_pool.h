@@ -0,0 +1,160 @@
+/*!****************************************************************************
+ * @file    block_pool.h
+ * @brief   Fixed-size block pool over a static buffer. Blocks are handed out
+ *          and returned in O(1) through an index free list, so scratch
+ *          buffers of a known size never touch the general heap.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#pragma once
+
+#include "freertos/FreeRTOS.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace Memory {
+
+/**
+ * @brief Pool of BlockCount blocks of BlockSize bytes. Safe from any task.
+ */
+template <size_t BlockSize, size_t BlockCount>
+class BlockPool
+{
+    static_assert(BlockCount > 0 && BlockCount < UINT16_MAX, "Invalid block count");
+
+    public:
+
+        struct Stats
+        {
+            size_t inUse = 0;               //!< Blocks currently handed out
+            size_t peakInUse = 0;           //!< Highest 'inUse' ever seen
+            uint32_t failures = 0;          //!< Acquire() calls that found the pool empty
+        };
+
+        /**
+         * @brief RAII handle: the block returns to the pool when the handle dies.
+         */
+        class Block
+        {
+            public:
+
+                Block() = default;
+                Block(BlockPool* pool, uint8_t* data) : _pool(pool), _data(data) {}
+                ~Block() { Release(); }
+
+                Block(Block&& other) noexcept : _pool(other._pool), _data(other._data)
+                {
+                    other._pool = nullptr;
+                    other._data = nullptr;
+                }
+
+                Block& operator=(Block&& other) noexcept
+                {
+                    if (this != &other)
+                    {
+                        Release();
+                        _pool = other._pool;
+                        _data = other._data;
+                        other._pool = nullptr;
+                        other._data = nullptr;
+                    }
+                    return *this;
+                }
+
+                Block(const Block&) = delete;
+                Block& operator=(const Block&) = delete;
+
+                uint8_t* Data() const { return _data; }
+                static constexpr size_t Size() { return BlockSize; }
+                explicit operator bool() const { return _data != nullptr; }
+
+            private:
+
+                void Release()
+                {
+                    if (_pool != nullptr)
+                    {
+                        _pool->Free(_data);
+                        _pool = nullptr;
+                        _data = nullptr;
+                    }
+                }
+
+                BlockPool* _pool = nullptr;
+                uint8_t* _data = nullptr;
+        };
+
+        BlockPool()
+        {
+            for (size_t i = 0; i < BlockCount; ++i)
+            {
+                _next[i] = static_cast<uint16_t>(i + 1);
+            }
+        }
+
+        BlockPool(const BlockPool&) = delete;
+        BlockPool& operator=(const BlockPool&) = delete;
+
+        /**
+         * @brief Take a block from the pool.
+         * @return Block Handle, empty if the pool is exhausted.
+         */
+        Block Acquire()
+        {
+            portENTER_CRITICAL(&_lock);
+
+            if (_freeHead == END)
+            {
+                ++_stats.failures;
+                portEXIT_CRITICAL(&_lock);
+                return Block();
+            }
+
+            const uint16_t index = _freeHead;
+            _freeHead = _next[index];
+
+            ++_stats.inUse;
+            if (_stats.inUse > _stats.peakInUse)
+            {
+                _stats.peakInUse = _stats.inUse;
+            }
+
+            portEXIT_CRITICAL(&_lock);
+
+            return Block(this, _storage[index]);
+        }
+
+        Stats GetStats() const
+        {
+            portENTER_CRITICAL(&_lock);
+            const Stats stats = _stats;
+            portEXIT_CRITICAL(&_lock);
+            return stats;
+        }
+
+    private:
+
+        void Free(uint8_t* data)
+        {
+            const uint16_t index = static_cast<uint16_t>((data - _storage[0]) / BlockSize);
+
+            portENTER_CRITICAL(&_lock);
+            _next[index] = _freeHead;
+            _freeHead = index;
+            --_stats.inUse;
+            portEXIT_CRITICAL(&_lock);
+        }
+
+        static constexpr uint16_t END = static_cast<uint16_t>(BlockCount);
+
+        // ---------------------------------------------
+
+        alignas(std::max_align_t) uint8_t _storage[BlockCount][BlockSize];
+        uint16_t _next[BlockCount];
+        uint16_t _freeHead = 0;
+        Stats _stats;
+        mutable portMUX_TYPE _lock = portMUX_INITIALIZER_UNLOCKED;
+};
+
+} // namespace Memory
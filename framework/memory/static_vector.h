@@ -0,0 +1,127 @@
+/*!****************************************************************************
+ * @file    static_vector.h
+ * @brief   Vector of at most N elements stored inline (no heap): copies are
+ *          a memcpy-sized assignment, so a config value can be copied or
+ *          decoded on any task without touching the allocator. Keeps the
+ *          std::vector names so range-for, <algorithm> and nlohmann::json
+ *          work on it unchanged.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <initializer_list>
+#include <span>
+#include <type_traits>
+
+namespace Memory {
+
+/**
+ * @brief Fixed-capacity vector.
+ * @tparam T Element type (default constructible and copy assignable).
+ * @tparam N Capacity.
+ */
+template <typename T, size_t N>
+class StaticVector
+{
+    static_assert(std::is_default_constructible_v<T> && std::is_copy_assignable_v<T>, "StaticVector needs a default constructible, copyable type");
+
+    public:
+
+        using value_type = T;
+        using size_type = size_t;
+        using reference = T&;
+        using const_reference = const T&;
+        using iterator = T*;
+        using const_iterator = const T*;
+
+        static constexpr size_t CAPACITY = N;
+
+        StaticVector() = default;
+
+        StaticVector(std::initializer_list<T> items)
+        {
+            assign(items.begin(), items.end());
+        }
+
+        /**
+         * @brief Append an element.
+         * @return true if appended, false if the vector is full.
+         */
+        bool push_back(const T& item)
+        {
+            if (_size == N)
+            {
+                return false;
+            }
+
+            _items[_size++] = item;
+            return true;
+        }
+
+        /**
+         * @brief Replace the contents with [first, last), truncated to the capacity.
+         * @return true if every element fit.
+         */
+        template <typename InputIt>
+        bool assign(InputIt first, InputIt last)
+        {
+            _size = 0;
+            for (; first != last; ++first)
+            {
+                if (!push_back(*first))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        //! Remove [first, last), keeping the order of the rest
+        iterator erase(const_iterator first, const_iterator last)
+        {
+            iterator to = begin() + (first - begin());
+            const iterator end = std::copy(begin() + (last - begin()), this->end(), to);
+            _size = static_cast<size_t>(end - begin());
+            return to;
+        }
+
+        void clear() { _size = 0; }
+        void reserve(size_t) {}                     //!< Storage is inline; kept for std::vector parity
+
+        size_t size() const { return _size; }
+        static constexpr size_t capacity() { return N; }
+        static constexpr size_t max_size() { return N; }
+        bool empty() const { return _size == 0; }
+        bool full() const { return _size == N; }
+
+        T& operator[](size_t index) { return _items[index]; }
+        const T& operator[](size_t index) const { return _items[index]; }
+
+        T* data() { return _items.data(); }
+        const T* data() const { return _items.data(); }
+
+        iterator begin() { return _items.data(); }
+        iterator end() { return _items.data() + _size; }
+        const_iterator begin() const { return _items.data(); }
+        const_iterator end() const { return _items.data() + _size; }
+
+        std::span<const T> Span() const { return { _items.data(), _size }; }
+
+        //! Only the elements in use are compared
+        bool operator==(const StaticVector& other) const
+        {
+            return std::equal(begin(), end(), other.begin(), other.end());
+        }
+
+    private:
+
+        std::array<T, N> _items{};
+        size_t _size = 0;
+};
+
+} // namespace Memory
@@ -0,0 +1,283 @@
+/*!****************************************************************************
+ * @file    async_worker_pool.cpp
+ * @brief   Implementation of AsyncWorkerPool class.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#include "framework/os/async_worker_pool.h"
+
+#include "esp_timer.h"
+#include <algorithm>
+#include <cstdio>
+
+//-----------------------------------------------------------------------------
+AsyncWorkerPool::AsyncWorkerPool(const Config& config)
+    : _config(config)
+    , _slots(config.queueDepth)
+    , _mutex(nullptr)
+    , _jobsAvailable(nullptr)
+    , _nextId(INVALID_JOB + 1)
+    , _nextSequence(0)
+    , _queued(0)
+    , _active(0)
+    , _started(false)
+{
+    _config.workerCount = std::clamp<uint8_t>(_config.workerCount, 1, MAX_WORKERS);
+
+    for (auto& context : _running)
+    {
+        context._pool = this;
+    }
+}
+
+//-----------------------------------------------------------------------------
+bool AsyncWorkerPool::Start()
+{
+    if (_started)
+    {
+        CORE_WARNING("[%s] Pool already started.", _config.name);
+        return true;
+    }
+
+    _mutex = xSemaphoreCreateMutex();
+    _jobsAvailable = xSemaphoreCreateCounting(_config.queueDepth, 0);
+
+    if (_mutex == nullptr || _jobsAvailable == nullptr)
+    {
+        CORE_ERROR("[%s] Failed to create pool semaphores.", _config.name);
+        return false;
+    }
+
+    for (uint8_t i = 0; i < _config.workerCount; ++i)
+    {
+        char taskName[configMAX_TASK_NAME_LEN];
+        snprintf(taskName, sizeof(taskName), "%s_%u", _config.name, i);
+
+        BaseType_t res = xTaskCreatePinnedToCore(
+            StaticEntryStub,
+            taskName,
+            _config.stackSize,
+            &_running[i],
+            _config.priority,
+            nullptr,
+            _config.coreId
+        );
+
+        if (res != pdPASS)
+        {
+            CORE_ERROR("[%s] Failed to create worker %u: Out of memory?", _config.name, i);
+            return false;
+        }
+    }
+
+    _started = true;
+    CORE_INFO("[%s] Pool started with %u workers, queue depth %u.", _config.name, _config.workerCount, _config.queueDepth);
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+auto AsyncWorkerPool::Submit(Job job, Priority priority, CompletionCallback onDone) -> JobId
+{
+    if (!_started || !job)
+    {
+        CORE_ERROR("[%s] Cannot submit: pool not started or empty job.", _config.name);
+        return INVALID_JOB;
+    }
+
+    xSemaphoreTake(_mutex, portMAX_DELAY);
+
+    auto it = std::find_if(_slots.begin(), _slots.end(), [](const Slot& slot) { return !slot.used; });
+    if (it == _slots.end())
+    {
+        ++_stats.rejected;
+        xSemaphoreGive(_mutex);
+        CORE_WARNING("[%s] Queue full, job rejected.", _config.name);
+        return INVALID_JOB;
+    }
+
+    const JobId id = _nextId++;
+    if (_nextId == INVALID_JOB)
+    {
+        _nextId = INVALID_JOB + 1;
+    }
+
+    it->job = std::move(job);
+    it->onDone = std::move(onDone);
+    it->id = id;
+    it->priority = priority;
+    it->sequence = _nextSequence++;
+    it->submittedUs = esp_timer_get_time();
+    it->used = true;
+
+    ++_queued;
+    ++_stats.submitted;
+    _stats.maxQueued = std::max(_stats.maxQueued, _queued);
+
+    xSemaphoreGive(_mutex);
+    xSemaphoreGive(_jobsAvailable);
+
+    return id;
+}
+
+//-----------------------------------------------------------------------------
+bool AsyncWorkerPool::Cancel(JobId id)
+{
+    if (!_started || id == INVALID_JOB)
+    {
+        return false;
+    }
+
+    CompletionCallback onDone;
+
+    xSemaphoreTake(_mutex, portMAX_DELAY);
+
+    for (auto& slot : _slots)
+    {
+        if (slot.used && slot.id == id)
+        {
+            onDone = std::move(slot.onDone);
+            slot.job = nullptr;
+            slot.onDone = nullptr;
+            slot.used = false;
+
+            --_queued;
+            ++_stats.cancelled;
+            xSemaphoreGive(_mutex);
+
+            // The surplus count left in _jobsAvailable only wakes a worker that finds nothing to do
+            if (onDone)
+            {
+                onDone(id, JobStatus::CANCELLED);
+            }
+            return true;
+        }
+    }
+
+    for (uint8_t i = 0; i < _config.workerCount; ++i)
+    {
+        if (_running[i]._id == id)
+        {
+            _running[i]._cancelRequested = true;
+            xSemaphoreGive(_mutex);
+            return true;
+        }
+    }
+
+    xSemaphoreGive(_mutex);
+    return false;
+}
+
+//-----------------------------------------------------------------------------
+size_t AsyncWorkerPool::GetPendingCount() const
+{
+    if (!_started)
+    {
+        return 0;
+    }
+
+    xSemaphoreTake(_mutex, portMAX_DELAY);
+    const size_t pending = _queued + _active;
+    xSemaphoreGive(_mutex);
+
+    return pending;
+}
+
+//-----------------------------------------------------------------------------
+auto AsyncWorkerPool::GetStats() const -> Stats
+{
+    if (!_started)
+    {
+        return _stats;
+    }
+
+    xSemaphoreTake(_mutex, portMAX_DELAY);
+    const Stats stats = _stats;
+    xSemaphoreGive(_mutex);
+
+    return stats;
+}
+
+//----private------------------------------------------------------------------
+void AsyncWorkerPool::StaticEntryStub(void* arg)
+{
+    JobContext* context = static_cast<JobContext*>(arg);
+    context->_pool->WorkerLoop(*context);
+}
+
+//----private------------------------------------------------------------------
+void AsyncWorkerPool::WorkerLoop(JobContext& context)
+{
+    while (true)
+    {
+        xSemaphoreTake(_jobsAvailable, portMAX_DELAY);
+
+        xSemaphoreTake(_mutex, portMAX_DELAY);
+
+        const int index = PickNextLocked();
+        if (index < 0)
+        {
+            // Job was cancelled while queued
+            xSemaphoreGive(_mutex);
+            continue;
+        }
+
+        Slot& slot = _slots[index];
+        Job job = std::move(slot.job);
+        CompletionCallback onDone = std::move(slot.onDone);
+        const JobId id = slot.id;
+        const uint64_t latencyUs = esp_timer_get_time() - slot.submittedUs;
+
+        slot.job = nullptr;
+        slot.onDone = nullptr;
+        slot.used = false;
+
+        context._id = id;
+        context._cancelRequested = false;
+
+        --_queued;
+        ++_active;
+        _stats.totalDispatchLatencyUs += latencyUs;
+        _stats.maxDispatchLatencyUs = std::max(_stats.maxDispatchLatencyUs, latencyUs);
+
+        xSemaphoreGive(_mutex);
+
+        job(context);
+
+        xSemaphoreTake(_mutex, portMAX_DELAY);
+        context._id = INVALID_JOB;
+        --_active;
+        ++_stats.completed;
+        xSemaphoreGive(_mutex);
+
+        if (onDone)
+        {
+            onDone(id, JobStatus::COMPLETED);
+        }
+    }
+}
+
+//----private------------------------------------------------------------------
+int AsyncWorkerPool::PickNextLocked() const
+{
+    int best = -1;
+
+    for (size_t i = 0; i < _slots.size(); ++i)
+    {
+        const Slot& slot = _slots[i];
+        if (!slot.used)
+        {
+            continue;
+        }
+
+        if (best < 0
+            || slot.priority > _slots[best].priority
+            || (slot.priority == _slots[best].priority
+                && static_cast<int32_t>(slot.sequence - _slots[best].sequence) < 0))
+        {
+            best = static_cast<int>(i);
+        }
+    }
+
+    return best;
+}
@@ -0,0 +1,179 @@
+/*!****************************************************************************
+ * @file    async_worker_pool.h
+ * @brief   Pool of long-lived FreeRTOS tasks serving a bounded job queue.
+ *          Unlike AsyncWorker, no task is created or deleted per job: jobs
+ *          are copied into preallocated slots and picked by priority, FIFO
+ *          within the same priority.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#pragma once
+
+#include "framework/common_defs.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+class AsyncWorkerPool
+{
+    public:
+
+        using JobId = uint32_t;
+
+        static constexpr JobId INVALID_JOB = 0;
+        static constexpr size_t MAX_WORKERS = 4;
+
+        enum class Priority : uint8_t
+        {
+            BACKGROUND = 0,
+            NORMAL,
+            URGENT,
+        };
+
+        enum class JobStatus : uint8_t
+        {
+            COMPLETED,      //!< The job ran to the end (it may have honoured a cancel request)
+            CANCELLED,      //!< The job was removed from the queue before it started
+        };
+
+        /**
+         * @brief Handed to a running job so it can poll for cooperative cancellation.
+         */
+        class JobContext
+        {
+            public:
+
+                JobId GetId() const { return _id; }
+                bool IsCancelRequested() const { return _cancelRequested.load(); }
+
+            private:
+
+                friend class AsyncWorkerPool;
+
+                AsyncWorkerPool* _pool = nullptr;
+                JobId _id = INVALID_JOB;
+                std::atomic<bool> _cancelRequested{false};
+        };
+
+        using Job = std::function<void(const JobContext&)>;
+        using CompletionCallback = std::function<void(JobId, JobStatus)>;
+
+        struct Config
+        {
+            const char* name = "worker";            //!< Task name prefix for debug purposes
+            uint8_t workerCount = 1;                //!< Number of tasks (1..MAX_WORKERS)
+            uint8_t queueDepth = 4;                 //!< Jobs that can wait for a worker
+            uint32_t stackSize = 2048;              //!< Stack size in words, per task
+            UBaseType_t priority = 5;               //!< FreeRTOS priority of the tasks
+            BaseType_t coreId = tskNO_AFFINITY;     //!< Core to pin the tasks to
+        };
+
+        struct Stats
+        {
+            uint32_t submitted = 0;                 //!< Jobs accepted in the queue
+            uint32_t rejected = 0;                  //!< Jobs refused because the queue was full
+            uint32_t completed = 0;                 //!< Jobs that ran to the end
+            uint32_t cancelled = 0;                 //!< Jobs removed before starting
+            uint64_t maxDispatchLatencyUs = 0;      //!< Longest submit-to-start delay
+            uint64_t totalDispatchLatencyUs = 0;    //!< Sum of submit-to-start delays (avg = total / started)
+            uint8_t maxQueued = 0;                  //!< Highest number of jobs waiting at once
+        };
+
+        /**
+         * @brief Configures the pool and allocates the job slots. Does not start the tasks yet.
+         * @param config Pool configuration.
+         */
+        explicit AsyncWorkerPool(const Config& config);
+
+        AsyncWorkerPool(const AsyncWorkerPool&) = delete;
+        AsyncWorkerPool& operator=(const AsyncWorkerPool&) = delete;
+
+        /**
+         * @brief Creates the worker tasks. The pool must outlive them (own it from a singleton).
+         * @return true if every task was created.
+         */
+        bool Start();
+
+        /**
+         * @brief Queues a job. Never blocks.
+         * @param job Work to execute on a worker task.
+         * @param priority Higher priorities are dispatched first.
+         * @param onDone Optional callback, runs on the worker (or on the caller of Cancel()).
+         * @return JobId Identifier of the job, INVALID_JOB if the queue is full or the pool is not started.
+         */
+        JobId Submit(Job job, Priority priority = Priority::NORMAL, CompletionCallback onDone = nullptr);
+
+        /**
+         * @brief Cancels a job. A queued job is dropped; a running job is asked to stop
+         *        through JobContext::IsCancelRequested().
+         * @param id Job to cancel.
+         * @return true if the job was queued or running.
+         */
+        bool Cancel(JobId id);
+
+        /**
+         * @brief Number of jobs waiting plus jobs running.
+         */
+        size_t GetPendingCount() const;
+
+        /**
+         * @brief Checks if no job is waiting or running.
+         */
+        bool IsIdle() const { return GetPendingCount() == 0; }
+
+        /**
+         * @brief Snapshot of the pool counters.
+         */
+        Stats GetStats() const;
+
+    private:
+
+        struct Slot
+        {
+            Job job;
+            CompletionCallback onDone;
+            JobId id = INVALID_JOB;
+            Priority priority = Priority::NORMAL;
+            uint32_t sequence = 0;
+            uint64_t submittedUs = 0;
+            bool used = false;
+        };
+
+        /**
+         * @brief The static C-compatible function that FreeRTOS calls for every worker.
+         */
+        static void StaticEntryStub(void* arg);
+
+        /**
+         * @brief Body of every worker task: waits for a job, runs it, reports completion.
+         */
+        void WorkerLoop(JobContext& context);
+
+        /**
+         * @brief Finds the queued slot with the highest priority, oldest first. Mutex must be held.
+         * @return int Slot index, -1 if the queue is empty.
+         */
+        int PickNextLocked() const;
+
+        // ---------------------------------------------
+
+        Config _config;
+        std::vector<Slot> _slots;
+        JobContext _running[MAX_WORKERS];
+
+        SemaphoreHandle_t _mutex;
+        SemaphoreHandle_t _jobsAvailable;
+
+        JobId _nextId;
+        uint32_t _nextSequence;
+        uint8_t _queued;
+        uint8_t _active;
+        bool _started;
+        Stats _stats;
+};
@@ -0,0 +1,46 @@
+/*!****************************************************************************
+ * @file    clock.h
+ * @brief   Time source and wait primitive used by the cooperative Scheduler.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+
+class IClock
+{
+    public:
+
+        //! Deadline value meaning "no deadline, wait for a wake-up only"
+        static constexpr uint64_t NO_DEADLINE = UINT64_MAX;
+
+        /**
+         * @brief Virtual destructor.
+         */
+        virtual ~IClock() = default;
+
+        /**
+         * @brief Get the current time.
+         * @return Monotonic time in microseconds.
+         */
+        virtual uint64_t NowUs() const = 0;
+
+        /**
+         * @brief Block the calling task until deadlineUs is reached or Wake() is called.
+         * @param deadlineUs Absolute deadline in microseconds (NO_DEADLINE to wait forever).
+         * @return true if woken early by Wake(), false if the deadline was reached.
+         */
+        virtual bool WaitUntil(uint64_t deadlineUs) = 0;
+
+        /**
+         * @brief Wake the task blocked in WaitUntil(). Safe to call from any task.
+         */
+        virtual void Wake() = 0;
+
+        /**
+         * @brief Wake the task blocked in WaitUntil() from an interrupt handler.
+         */
+        virtual void WakeFromIsr() = 0;
+};
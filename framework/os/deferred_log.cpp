@@ -0,0 +1,721 @@
+/*!****************************************************************************
+ * @file    deferred_log.cpp
+ * @brief   Ring buffer, drain task and printf-compatible rendering of the
+ *          deferred log records.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#include "framework/os/deferred_log.h"
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+//! Reference symbol: its runtime address lets decode_log.py relocate string addresses
+extern "C" const char core_log_anchor[] = "core_log_anchor";
+
+namespace DeferredLog {
+
+namespace Detail {
+
+std::atomic<uint32_t> g_levelGeneration{1};
+
+} // namespace Detail
+
+namespace {
+
+using Detail::Arg;
+
+static_assert(BUFFER_SIZE % 4 == 0, "Ring size must be a multiple of 4");
+
+static constexpr uint16_t WRAP_MARKER = 0xFFFF;
+static constexpr uint16_t PENDING = 0x8000;             //!< Length flag: the writer is still encoding the record
+static constexpr uint16_t NULL_STRING = 0xFFFF;
+static constexpr size_t LENGTH_SIZE = sizeof(uint16_t);
+static constexpr size_t TASK_NAME_SIZE = 16;
+static constexpr size_t LINE_SIZE = MAX_STRING_LENGTH + 256;
+
+//! Fixed part of a record, after its length
+struct __attribute__((packed)) RecordHeader
+{
+    uint8_t level;
+    uint8_t argCount;
+    uint16_t reserved;
+    uint32_t timestampMs;
+    uint64_t tag;
+    uint64_t format;
+    char task[TASK_NAME_SIZE];
+};
+
+static constexpr size_t MAX_RECORD_SIZE = sizeof(RecordHeader) + MAX_ARGUMENTS * (1 + 8) + MAX_STRING_LENGTH;
+static_assert(LENGTH_SIZE + MAX_RECORD_SIZE < PENDING, "Record lengths must leave the PENDING bit free");
+
+alignas(4) uint8_t s_buffer[BUFFER_SIZE];
+size_t s_head = 0;                      //!< Next write offset
+size_t s_tail = 0;                      //!< Next read offset
+size_t s_used = 0;                      //!< Bytes between tail and head, including wrap padding
+portMUX_TYPE s_lock = portMUX_INITIALIZER_UNLOCKED;
+
+Stats s_stats;
+uint32_t s_reportedDrops = 0;
+std::atomic<OutputMode> s_mode{OutputMode::TEXT};
+
+TaskHandle_t s_drainTask = nullptr;
+SemaphoreHandle_t s_drainMutex = nullptr;
+
+uint8_t s_record[MAX_RECORD_SIZE];      //!< Record being rendered (guarded by s_drainMutex)
+char s_line[LINE_SIZE];
+
+//-----------------------------------------------------------------------------
+size_t AlignUp(size_t size)
+{
+    return (size + 3) & ~static_cast<size_t>(3);
+}
+
+//-----------------------------------------------------------------------------
+//! Length word of the record at 'offset' (records start 4-byte aligned)
+std::atomic_ref<uint16_t> LengthAt(size_t offset)
+{
+    return std::atomic_ref<uint16_t>(*reinterpret_cast<uint16_t*>(&s_buffer[offset]));
+}
+
+//-----------------------------------------------------------------------------
+const char* CurrentTaskName()
+{
+    return (xTaskGetSchedulerState() == taskSCHEDULER_RUNNING) ? pcTaskGetName(NULL) : "boot";
+}
+
+//-----------------------------------------------------------------------------
+//! Bytes copied for each string argument, sharing MAX_STRING_LENGTH across the record
+void MeasureStrings(const Arg* args, size_t count, uint32_t boundedStrings, uint16_t* lengths)
+{
+    size_t budget = MAX_STRING_LENGTH;
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        lengths[i] = 0;
+
+        if (args[i].type != Detail::ARG_STRING || args[i].s == nullptr)
+        {
+            continue;
+        }
+
+        size_t maxLength = budget;
+
+        // "%.*s": the precision argument bounds the read (the string may not be terminated)
+        if (i > 0 && (boundedStrings & (1u << i)) != 0 && args[i - 1].i >= 0)
+        {
+            maxLength = std::min(maxLength, static_cast<size_t>(args[i - 1].i));
+        }
+
+        lengths[i] = static_cast<uint16_t>(strnlen(args[i].s, maxLength));
+        budget -= lengths[i];
+    }
+}
+
+//-----------------------------------------------------------------------------
+size_t ArgSize(const Arg& arg, uint16_t stringLength)
+{
+    switch (arg.type)
+    {
+        case Detail::ARG_INT32:
+        case Detail::ARG_UINT32:
+            return 1 + 4;
+
+        case Detail::ARG_STRING:
+            return 1 + 2 + stringLength;
+
+        default:
+            return 1 + 8;
+    }
+}
+
+//-----------------------------------------------------------------------------
+uint8_t* Put(uint8_t* dst, const void* src, size_t size)
+{
+    memcpy(dst, src, size);
+    return dst + size;
+}
+
+//-----------------------------------------------------------------------------
+//! Scan a format once for "%.*s" conversions
+uint32_t FindBoundedStrings(const char* format)
+{
+    uint32_t mask = 0;
+    size_t argIndex = 0;
+
+    for (const char* p = format; *p != '\0' && argIndex < 32; ++p)
+    {
+        if (*p != '%')
+        {
+            continue;
+        }
+
+        ++p;
+        if (*p == '%')
+        {
+            continue;
+        }
+
+        bool starPrecision = false;
+        while (*p != '\0' && strchr("-+ #0123456789.*hlLzjt", *p) != nullptr)
+        {
+            if (*p == '*')
+            {
+                starPrecision = (p > format && p[-1] == '.');
+                ++argIndex;
+            }
+            ++p;
+        }
+
+        if (*p == 's' && starPrecision)
+        {
+            mask |= (1u << argIndex);
+        }
+
+        if (*p == '\0')
+        {
+            break;
+        }
+
+        ++argIndex;
+    }
+
+    return mask;
+}
+
+//-----------------------------------------------------------------------------
+//! Copy the oldest record to s_record. Caller holds s_drainMutex.
+//! Returns 0 when the ring is empty or its oldest record is still being encoded.
+size_t PopRecord()
+{
+    portENTER_CRITICAL(&s_lock);
+
+    if (s_used == 0)
+    {
+        portEXIT_CRITICAL(&s_lock);
+        return 0;
+    }
+
+    uint16_t length = LengthAt(s_tail).load(std::memory_order_acquire);
+
+    if (length == WRAP_MARKER)
+    {
+        s_used -= BUFFER_SIZE - s_tail;
+        s_tail = 0;
+        length = LengthAt(s_tail).load(std::memory_order_acquire);
+    }
+
+    const size_t offset = s_tail;
+
+    portEXIT_CRITICAL(&s_lock);
+
+    if ((length & PENDING) != 0)
+    {
+        return 0;
+    }
+
+    // Writers only fill free space: the record stays put until the tail moves past it
+    memcpy(s_record, &s_buffer[offset + LENGTH_SIZE], length - LENGTH_SIZE);
+
+    portENTER_CRITICAL(&s_lock);
+    const size_t footprint = AlignUp(length);
+    s_tail = (s_tail + footprint) % BUFFER_SIZE;
+    s_used -= footprint;
+    portEXIT_CRITICAL(&s_lock);
+
+    return length - LENGTH_SIZE;
+}
+
+//-----------------------------------------------------------------------------
+template <typename T>
+T Read(const uint8_t*& src)
+{
+    T value;
+    memcpy(&value, src, sizeof(T));
+    src += sizeof(T);
+    return value;
+}
+
+//-----------------------------------------------------------------------------
+//! Decoded argument for rendering
+struct Value
+{
+    uint8_t type = Detail::ARG_INT32;
+    int64_t i = 0;
+    uint64_t u = 0;
+    double d = 0.0;
+    const char* s = nullptr;
+    uint16_t length = 0;
+};
+
+//-----------------------------------------------------------------------------
+size_t DecodeArgs(const uint8_t* src, const uint8_t* end, size_t count, Value* values)
+{
+    size_t decoded = 0;
+
+    while (decoded < count && src < end)
+    {
+        Value& value = values[decoded];
+        value.type = *src++;
+
+        switch (value.type)
+        {
+            case Detail::ARG_INT32:     value.i = Read<int32_t>(src); value.u = static_cast<uint64_t>(value.i); break;
+            case Detail::ARG_UINT32:    value.u = Read<uint32_t>(src); value.i = static_cast<int64_t>(value.u); break;
+            case Detail::ARG_INT64:     value.i = Read<int64_t>(src); value.u = static_cast<uint64_t>(value.i); break;
+            case Detail::ARG_UINT64:
+            case Detail::ARG_POINTER:   value.u = Read<uint64_t>(src); value.i = static_cast<int64_t>(value.u); break;
+            case Detail::ARG_DOUBLE:    value.d = Read<double>(src); break;
+            case Detail::ARG_STRING:
+                value.length = Read<uint16_t>(src);
+                value.s = reinterpret_cast<const char*>(src);
+                src += (value.length == NULL_STRING) ? 0 : value.length;
+                break;
+            default:
+                return decoded;
+        }
+
+        ++decoded;
+    }
+
+    return decoded;
+}
+
+//-----------------------------------------------------------------------------
+//! Integer argument narrowed the way printf would read it for the given length modifier
+int64_t NarrowSigned(int64_t value, const char* length)
+{
+    if (strcmp(length, "hh") == 0)  return static_cast<signed char>(value);
+    if (strcmp(length, "h") == 0)   return static_cast<short>(value);
+    if (strcmp(length, "l") == 0)   return static_cast<long>(value);
+    if (strcmp(length, "ll") == 0 || strcmp(length, "j") == 0) return value;
+    if (strcmp(length, "z") == 0 || strcmp(length, "t") == 0) return static_cast<ptrdiff_t>(value);
+    return static_cast<int>(value);
+}
+
+//-----------------------------------------------------------------------------
+uint64_t NarrowUnsigned(uint64_t value, const char* length)
+{
+    if (strcmp(length, "hh") == 0)  return static_cast<unsigned char>(value);
+    if (strcmp(length, "h") == 0)   return static_cast<unsigned short>(value);
+    if (strcmp(length, "l") == 0)   return static_cast<unsigned long>(value);
+    if (strcmp(length, "ll") == 0 || strcmp(length, "j") == 0) return value;
+    if (strcmp(length, "z") == 0 || strcmp(length, "t") == 0) return static_cast<size_t>(value);
+    return static_cast<unsigned int>(value);
+}
+
+//-----------------------------------------------------------------------------
+//! printf of one format against decoded arguments, one conversion at a time
+size_t Render(const char* format, const Value* values, size_t count, char* out, size_t size)
+{
+    size_t pos = 0;
+    size_t argIndex = 0;
+
+    auto append = [&](int written) {
+        if (written > 0)
+        {
+            pos = std::min(pos + static_cast<size_t>(written), size - 1);
+        }
+    };
+
+    for (const char* p = format; *p != '\0' && pos < size - 1; ++p)
+    {
+        if (*p != '%')
+        {
+            out[pos++] = *p;
+            continue;
+        }
+
+        if (p[1] == '%')
+        {
+            out[pos++] = '%';
+            ++p;
+            continue;
+        }
+
+        // Rebuild the conversion with '*' resolved and a 64-bit length modifier
+        char spec[32] = "%";
+        size_t specLength = 1;
+        const char* q = p + 1;
+
+        while (*q != '\0' && strchr("-+ #0123456789.*", *q) != nullptr && specLength < 20)
+        {
+            if (*q == '*')
+            {
+                const int starValue = (argIndex < count) ? static_cast<int>(values[argIndex++].i) : 0;
+                specLength += snprintf(&spec[specLength], sizeof(spec) - specLength, "%d", starValue);
+            }
+            else
+            {
+                spec[specLength++] = *q;
+            }
+            ++q;
+        }
+
+        char length[3] = {};
+        size_t lengthSize = 0;
+        while (*q != '\0' && strchr("hlLzjt", *q) != nullptr && lengthSize < 2)
+        {
+            length[lengthSize++] = *q++;
+        }
+
+        const char conversion = *q;
+        if (conversion == '\0' || argIndex >= count)
+        {
+            // Malformed format or missing argument: print it as written
+            append(snprintf(&out[pos], size - pos, "%.*s", static_cast<int>(q - p + (conversion != '\0')), p));
+            p = (conversion == '\0') ? q - 1 : q;
+            continue;
+        }
+
+        const Value& value = values[argIndex++];
+        p = q;
+
+        switch (conversion)
+        {
+            case 'd':
+            case 'i':
+                memcpy(&spec[specLength], "ll", 2);
+                spec[specLength + 2] = conversion;
+                append(snprintf(&out[pos], size - pos, spec, static_cast<long long>(NarrowSigned(value.i, length))));
+                break;
+
+            case 'u':
+            case 'o':
+            case 'x':
+            case 'X':
+                memcpy(&spec[specLength], "ll", 2);
+                spec[specLength + 2] = conversion;
+                append(snprintf(&out[pos], size - pos, spec, static_cast<unsigned long long>(NarrowUnsigned(value.u, length))));
+                break;
+
+            case 'c':
+                spec[specLength] = 'c';
+                append(snprintf(&out[pos], size - pos, spec, static_cast<int>(value.i)));
+                break;
+
+            case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+                spec[specLength] = conversion;
+                append(snprintf(&out[pos], size - pos, spec, value.d));
+                break;
+
+            case 's':
+                if (value.type != Detail::ARG_STRING || value.length == NULL_STRING)
+                {
+                    append(snprintf(&out[pos], size - pos, "(null)"));
+                }
+                else
+                {
+                    // The captured bytes are not terminated: the precision always
+                    // bounds them. A "%.*s" string was cut when captured, a literal
+                    // precision still applies ('*' was resolved into the spec above)
+                    int precision = static_cast<int>(value.length);
+                    char* dot = strchr(spec, '.');
+                    if (dot != nullptr)
+                    {
+                        const int limit = atoi(dot + 1);
+                        if (limit >= 0)
+                        {
+                            precision = std::min(precision, limit);
+                        }
+                        specLength = static_cast<size_t>(dot - spec);
+                    }
+                    memcpy(&spec[specLength], ".*s", 4);
+                    append(snprintf(&out[pos], size - pos, spec, precision, value.s));
+                }
+                break;
+
+            case 'p':
+                append(snprintf(&out[pos], size - pos, "0x%llx", static_cast<unsigned long long>(value.u)));
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    out[pos] = '\0';
+    return pos;
+}
+
+//-----------------------------------------------------------------------------
+char LevelLetter(uint8_t level)
+{
+    switch (level)
+    {
+        case ESP_LOG_ERROR:     return 'E';
+        case ESP_LOG_WARN:      return 'W';
+        case ESP_LOG_INFO:      return 'I';
+        case ESP_LOG_DEBUG:     return 'D';
+        default:                return 'V';
+    }
+}
+
+//-----------------------------------------------------------------------------
+void EmitText(size_t recordSize)
+{
+    RecordHeader header;
+    memcpy(&header, s_record, sizeof(header));
+    header.task[TASK_NAME_SIZE - 1] = '\0';
+
+    Value values[MAX_ARGUMENTS];
+    const size_t count = DecodeArgs(s_record + sizeof(header), s_record + recordSize, header.argCount, values);
+
+    const char* tag = reinterpret_cast<const char*>(static_cast<uintptr_t>(header.tag));
+    const char* format = reinterpret_cast<const char*>(static_cast<uintptr_t>(header.format));
+
+    int prefix = snprintf(s_line, LINE_SIZE, "%c (%lu) %s: [%s] ",
+                          LevelLetter(header.level), static_cast<unsigned long>(header.timestampMs), tag, header.task);
+    prefix = std::max(0, std::min(prefix, static_cast<int>(LINE_SIZE) - 2));
+
+    size_t length = static_cast<size_t>(prefix) + Render(format, values, count, &s_line[prefix], LINE_SIZE - prefix - 1);
+    s_line[length++] = '\n';
+
+    fwrite(s_line, 1, length, stdout);
+}
+
+//-----------------------------------------------------------------------------
+void EmitBinary(size_t recordSize)
+{
+    static const char HEX[] = "0123456789abcdef";
+
+    fputs("LOGB ", stdout);
+    for (size_t i = 0; i < recordSize; ++i)
+    {
+        putchar(HEX[s_record[i] >> 4]);
+        putchar(HEX[s_record[i] & 0x0F]);
+    }
+    putchar('\n');
+}
+
+//-----------------------------------------------------------------------------
+void DrainPending()
+{
+    if (s_drainMutex != nullptr)
+    {
+        xSemaphoreTake(s_drainMutex, portMAX_DELAY);
+    }
+
+    const OutputMode mode = s_mode.load();
+    bool wroteAny = false;
+
+    size_t recordSize;
+    while ((recordSize = PopRecord()) > 0)
+    {
+        if (mode == OutputMode::BINARY)
+        {
+            if (!wroteAny)
+            {
+                printf("LOGB_BASE %llx\n", static_cast<unsigned long long>(reinterpret_cast<uintptr_t>(core_log_anchor)));
+            }
+            EmitBinary(recordSize);
+        }
+        else
+        {
+            EmitText(recordSize);
+        }
+        wroteAny = true;
+    }
+
+    portENTER_CRITICAL(&s_lock);
+    const uint32_t dropped = s_stats.dropped;
+    portEXIT_CRITICAL(&s_lock);
+
+    if (dropped != s_reportedDrops)
+    {
+        printf("W (%lu) deferred_log: %u log messages dropped (ring full)\n",
+               static_cast<unsigned long>(esp_log_timestamp()), static_cast<unsigned>(dropped - s_reportedDrops));
+        s_reportedDrops = dropped;
+        wroteAny = true;
+    }
+
+    if (wroteAny)
+    {
+        fflush(stdout);
+    }
+
+    if (s_drainMutex != nullptr)
+    {
+        xSemaphoreGive(s_drainMutex);
+    }
+}
+
+//-----------------------------------------------------------------------------
+void DrainTask(void* /*arg*/)
+{
+    while (true)
+    {
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(DRAIN_PERIOD_MS));
+        DrainPending();
+    }
+}
+
+} // namespace
+
+namespace Detail {
+
+//-----------------------------------------------------------------------------
+void RefreshSite(Site& site, uint32_t generation)
+{
+    site.boundedStrings.store(FindBoundedStrings(site.format), std::memory_order_relaxed);
+    site.enabled.store(site.level <= esp_log_level_get(site.tag), std::memory_order_relaxed);
+    site.generation.store(generation, std::memory_order_release);
+}
+
+//-----------------------------------------------------------------------------
+void WriteRecord(Site& site, const Arg* args, size_t count)
+{
+    uint16_t stringLengths[MAX_ARGUMENTS];
+    MeasureStrings(args, count, site.boundedStrings.load(std::memory_order_relaxed), stringLengths);
+
+    size_t length = LENGTH_SIZE + sizeof(RecordHeader);
+    for (size_t i = 0; i < count; ++i)
+    {
+        length += ArgSize(args[i], stringLengths[i]);
+    }
+
+    RecordHeader header;
+    header.level = static_cast<uint8_t>(site.level);
+    header.argCount = static_cast<uint8_t>(count);
+    header.reserved = 0;
+    header.timestampMs = esp_log_timestamp();
+    header.tag = reinterpret_cast<uintptr_t>(site.tag);
+    header.format = reinterpret_cast<uintptr_t>(site.format);
+    memset(header.task, 0, sizeof(header.task));
+    strncpy(header.task, CurrentTaskName(), TASK_NAME_SIZE - 1);
+
+    const size_t footprint = AlignUp(length);
+    const uint16_t length16 = static_cast<uint16_t>(length);
+
+    // Only the space is reserved under the lock. The record is encoded after
+    // it and published by clearing PENDING; the drain stops at it until then
+    portENTER_CRITICAL(&s_lock);
+
+    // A record never wraps: skip the end of the buffer when it does not fit
+    const size_t tailRoom = BUFFER_SIZE - s_head;
+    const size_t padding = (footprint > tailRoom) ? tailRoom : 0;
+
+    if (s_used + padding + footprint > BUFFER_SIZE)
+    {
+        ++s_stats.dropped;
+        portEXIT_CRITICAL(&s_lock);
+        return;
+    }
+
+    if (padding > 0)
+    {
+        LengthAt(s_head).store(WRAP_MARKER, std::memory_order_relaxed);
+        s_head = 0;
+        s_used += padding;
+    }
+
+    const size_t offset = s_head;
+    LengthAt(offset).store(length16 | PENDING, std::memory_order_relaxed);
+
+    s_head = (s_head + footprint) % BUFFER_SIZE;
+    s_used += footprint;
+    ++s_stats.written;
+    s_stats.peakUsed = std::max(s_stats.peakUsed, s_used);
+    const bool wakeDrain = (s_used > BUFFER_SIZE / 2);
+
+    portEXIT_CRITICAL(&s_lock);
+
+    uint8_t* dst = &s_buffer[offset + LENGTH_SIZE];
+    dst = Put(dst, &header, sizeof(header));
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        const Arg& arg = args[i];
+        *dst++ = arg.type;
+
+        switch (arg.type)
+        {
+            case ARG_INT32:
+            {
+                const int32_t value = static_cast<int32_t>(arg.i);
+                dst = Put(dst, &value, 4);
+                break;
+            }
+            case ARG_UINT32:
+            {
+                const uint32_t value = static_cast<uint32_t>(arg.u);
+                dst = Put(dst, &value, 4);
+                break;
+            }
+            case ARG_POINTER:
+            {
+                const uint64_t value = reinterpret_cast<uintptr_t>(arg.p);
+                dst = Put(dst, &value, 8);
+                break;
+            }
+            case ARG_STRING:
+            {
+                const uint16_t encoded = (arg.s == nullptr) ? NULL_STRING : stringLengths[i];
+                dst = Put(dst, &encoded, 2);
+                dst = Put(dst, arg.s, stringLengths[i]);
+                break;
+            }
+            default:
+                dst = Put(dst, &arg.u, 8);
+                break;
+        }
+    }
+
+    LengthAt(offset).store(length16, std::memory_order_release);
+
+    if (wakeDrain && s_drainTask != nullptr)
+    {
+        xTaskNotifyGive(s_drainTask);
+    }
+}
+
+} // namespace Detail
+
+//-----------------------------------------------------------------------------
+void Start()
+{
+    if (s_drainTask != nullptr)
+    {
+        return;
+    }
+
+    s_drainMutex = xSemaphoreCreateMutex();
+    xTaskCreate(DrainTask, "log", DRAIN_TASK_STACK_SIZE, nullptr, tskIDLE_PRIORITY + 1, &s_drainTask);
+}
+
+//-----------------------------------------------------------------------------
+void Flush()
+{
+    DrainPending();
+}
+
+//-----------------------------------------------------------------------------
+void SetLevel(const char* tag, esp_log_level_t level)
+{
+    esp_log_level_set(tag, level);
+    Detail::g_levelGeneration.fetch_add(1, std::memory_order_release);
+}
+
+//-----------------------------------------------------------------------------
+void SetOutputMode(OutputMode mode)
+{
+    s_mode.store(mode);
+}
+
+//-----------------------------------------------------------------------------
+Stats GetStats()
+{
+    portENTER_CRITICAL(&s_lock);
+    const Stats stats = s_stats;
+    portEXIT_CRITICAL(&s_lock);
+    return stats;
+}
+
+} // namespace DeferredLog
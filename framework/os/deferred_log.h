@@ -0,0 +1,208 @@
+/*!****************************************************************************
+ * @file    deferred_log.h
+ * @brief   Deferred logging backend behind CORE_INFO/WARNING/ERROR.
+ *          A call copies its arguments in binary form into a ring buffer:
+ *          one record per call with level, timestamp, task name, the tag and
+ *          format string addresses, then each argument tagged with its type.
+ *          Strings are copied (up to MAX_STRING_LENGTH). Only reserving the
+ *          space takes the ring's critical section: the record is encoded
+ *          after it and then published, and the drain copies it out unlocked
+ *          (a record still being encoded holds back the ones after it until
+ *          its writer is done). A low-priority task
+ *          later renders the records as text on stdout (the UART). It can
+ *          also emit them raw as "LOGB <hex>" lines for
+ *          scripts/decode_log.py, which rebuilds the text from the ELF.
+ *
+ *          Filtering happens twice. CORE_LOG_LEVEL removes calls at compile
+ *          time (define it before the first include to change it per file).
+ *          At runtime each call site caches esp_log_level_get(tag), so a
+ *          filtered call costs one load and one compare.
+ *          DeferredLog::SetLevel() changes a tag and invalidates the caches.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#pragma once
+
+#include "esp_log.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace DeferredLog {
+
+static constexpr size_t BUFFER_SIZE = 8192;             //!< Ring size, multiple of 4
+static constexpr size_t MAX_STRING_LENGTH = 1024;       //!< String bytes kept per record, the rest is truncated
+static constexpr size_t MAX_ARGUMENTS = 16;
+static constexpr uint32_t DRAIN_PERIOD_MS = 50;
+static constexpr uint32_t DRAIN_TASK_STACK_SIZE = 4096;
+
+/**
+ * @brief How the drain task writes records.
+ */
+enum class OutputMode : uint8_t
+{
+    TEXT,           //!< Rendered like ESP_LOGx
+    BINARY          //!< "LOGB <hex>" records, decoded on the host
+};
+
+/**
+ * @brief One log statement. Constant-initialised, so it costs nothing until first use.
+ */
+struct Site
+{
+    constexpr Site(const char* tagName, const char* formatString, esp_log_level_t logLevel)
+        : tag(tagName), format(formatString), level(logLevel) {}
+
+    const char* tag;
+    const char* format;
+    esp_log_level_t level;
+    std::atomic<uint32_t> generation{0};        //!< Level generation 'enabled' was computed for
+    std::atomic<bool> enabled{false};
+    std::atomic<uint32_t> boundedStrings{0};    //!< Bit i: argument i is a "%.*s" string (length in argument i-1)
+};
+
+struct Stats
+{
+    uint32_t written = 0;           //!< Records stored
+    uint32_t dropped = 0;           //!< Records lost because the ring was full
+    size_t peakUsed = 0;            //!< Highest ring occupancy in bytes
+};
+
+namespace Detail {
+
+enum ArgType : uint8_t
+{
+    ARG_INT32,
+    ARG_UINT32,
+    ARG_INT64,
+    ARG_UINT64,
+    ARG_DOUBLE,
+    ARG_POINTER,
+    ARG_STRING,
+};
+
+struct Arg
+{
+    ArgType type;
+    union
+    {
+        int64_t i;
+        uint64_t u;
+        double d;
+        const void* p;
+        const char* s;
+    };
+};
+
+extern std::atomic<uint32_t> g_levelGeneration;
+
+void RefreshSite(Site& site, uint32_t generation);
+void WriteRecord(Site& site, const Arg* args, size_t count);
+
+//-----------------------------------------------------------------------------
+template <typename T>
+Arg MakeArg(T value)
+{
+    Arg arg;
+
+    if constexpr (std::is_same_v<T, const char*> || std::is_same_v<T, char*>)
+    {
+        arg.type = ARG_STRING;
+        arg.s = value;
+    }
+    else if constexpr (std::is_pointer_v<T> || std::is_null_pointer_v<T>)
+    {
+        arg.type = ARG_POINTER;
+        arg.p = value;
+    }
+    else if constexpr (std::is_enum_v<T>)
+    {
+        return MakeArg(static_cast<std::underlying_type_t<T>>(value));
+    }
+    else if constexpr (std::is_floating_point_v<T>)
+    {
+        arg.type = ARG_DOUBLE;
+        arg.d = static_cast<double>(value);
+    }
+    else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>)
+    {
+        arg.type = (sizeof(T) <= sizeof(int32_t)) ? ARG_INT32 : ARG_INT64;
+        arg.i = value;
+    }
+    else
+    {
+        static_assert(std::is_integral_v<T>, "Unsupported log argument type");
+        arg.type = (sizeof(T) <= sizeof(uint32_t)) ? ARG_UINT32 : ARG_UINT64;
+        arg.u = value;
+    }
+
+    return arg;
+}
+
+//! Never called: lets the compiler check the arguments against the format
+static inline void CheckFormat(const char* /*format*/, ...) __attribute__((format(printf, 1, 2)));
+static inline void CheckFormat(const char* /*format*/, ...) {}
+
+//-----------------------------------------------------------------------------
+constexpr const char* FileName(const char* path)
+{
+    const char* name = path;
+    for (const char* p = path; *p != '\0'; ++p)
+    {
+        if (*p == '/' || *p == '\\')
+        {
+            name = p + 1;
+        }
+    }
+    return name;
+}
+
+} // namespace Detail
+
+/**
+ * @brief True if the site passes the runtime level of its tag.
+ */
+inline bool IsEnabled(Site& site)
+{
+    const uint32_t generation = Detail::g_levelGeneration.load(std::memory_order_relaxed);
+    if (site.generation.load(std::memory_order_acquire) != generation)
+    {
+        Detail::RefreshSite(site, generation);
+    }
+    return site.enabled.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Store one record. Arguments follow printf rules; strings are copied.
+ */
+template <typename... Args>
+void Write(Site& site, Args... args)
+{
+    static_assert(sizeof...(Args) <= MAX_ARGUMENTS, "Too many log arguments");
+
+    const Detail::Arg list[sizeof...(Args) + 1] = { Detail::MakeArg(args)..., Detail::MakeArg(0) };
+    Detail::WriteRecord(site, list, sizeof...(Args));
+}
+
+/**
+ * @brief Start the drain task. Records written before are kept and printed then.
+ */
+void Start();
+
+/**
+ * @brief Print every pending record from the calling task (asserts, shutdown).
+ */
+void Flush();
+
+/**
+ * @brief Change the runtime level of a tag ("*" for all) and invalidate the site caches.
+ */
+void SetLevel(const char* tag, esp_log_level_t level);
+
+void SetOutputMode(OutputMode mode);
+
+Stats GetStats();
+
+} // namespace DeferredLog
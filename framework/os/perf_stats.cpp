@@ -0,0 +1,189 @@
+/*!****************************************************************************
+ * @file    perf_stats.cpp
+ * @brief   Implementation of the latency histograms and the module registry.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#include "framework/os/perf_stats.h"
+
+#include "framework/common_defs.h"
+#include "freertos/FreeRTOS.h"
+#include <algorithm>
+#include <cstring>
+
+namespace Perf {
+
+namespace {
+
+ModuleStats s_modules[MAX_MODULES];
+std::atomic<size_t> s_moduleCount{0};
+portMUX_TYPE s_registryLock = portMUX_INITIALIZER_UNLOCKED;
+
+//-----------------------------------------------------------------------------
+size_t BucketOf(uint32_t durationUs)
+{
+    size_t width = 0;
+    while (durationUs != 0)
+    {
+        ++width;
+        durationUs >>= 1;
+    }
+    return std::min(width, LatencyHistogram::BUCKET_COUNT - 1);
+}
+
+} // namespace
+
+//-----------------------------------------------------------------------------
+void LatencyHistogram::Record(uint32_t durationUs)
+{
+    _buckets[BucketOf(durationUs)].fetch_add(1, std::memory_order_relaxed);
+    _count.fetch_add(1, std::memory_order_relaxed);
+    _totalUs.fetch_add(durationUs, std::memory_order_relaxed);
+
+    if (durationUs > _maxUs.load(std::memory_order_relaxed))
+    {
+        _maxUs.store(durationUs, std::memory_order_relaxed);
+    }
+}
+
+//-----------------------------------------------------------------------------
+void LatencyHistogram::Reset()
+{
+    for (auto& bucket : _buckets)
+    {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    _count.store(0, std::memory_order_relaxed);
+    _maxUs.store(0, std::memory_order_relaxed);
+    _totalUs.store(0, std::memory_order_relaxed);
+}
+
+//-----------------------------------------------------------------------------
+uint32_t LatencyHistogram::GetMean() const
+{
+    const uint32_t count = GetCount();
+    return (count == 0) ? 0 : static_cast<uint32_t>(_totalUs.load(std::memory_order_relaxed) / count);
+}
+
+//-----------------------------------------------------------------------------
+uint32_t LatencyHistogram::GetPercentile(uint32_t percentile) const
+{
+    uint32_t total = 0;
+    for (const auto& bucket : _buckets)
+    {
+        total += bucket.load(std::memory_order_relaxed);
+    }
+
+    if (total == 0)
+    {
+        return 0;
+    }
+
+    // Rank of the sample, rounded up so p99 of few samples lands on the slowest one
+    const uint64_t rank = (static_cast<uint64_t>(total) * std::min<uint32_t>(percentile, 100) + 99) / 100;
+
+    uint64_t seen = 0;
+    for (size_t i = 0; i < BUCKET_COUNT; ++i)
+    {
+        seen += _buckets[i].load(std::memory_order_relaxed);
+        if (seen >= rank && seen > 0)
+        {
+            const uint32_t upperBound = (i == 0) ? 0 : static_cast<uint32_t>((1ULL << i) - 1);
+            return std::min(upperBound, GetMax());
+        }
+    }
+
+    return GetMax();
+}
+
+//-----------------------------------------------------------------------------
+void ModuleStats::Init(const char* name, uint32_t budgetUs)
+{
+    _name = name;
+    _budgetUs = budgetUs;
+}
+
+//-----------------------------------------------------------------------------
+void ModuleStats::Record(uint64_t durationUs)
+{
+    const uint32_t clampedUs = static_cast<uint32_t>(std::min<uint64_t>(durationUs, UINT32_MAX));
+
+    _histogram.Record(clampedUs);
+
+    if (_budgetUs != 0 && clampedUs > _budgetUs)
+    {
+        _overruns.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+//-----------------------------------------------------------------------------
+void ModuleStats::Reset()
+{
+    _histogram.Reset();
+    _overruns.store(0, std::memory_order_relaxed);
+}
+
+//-----------------------------------------------------------------------------
+auto ModuleStats::GetSummary() const -> Summary
+{
+    Summary summary;
+    summary.name = _name;
+    summary.count = _histogram.GetCount();
+    summary.p50Us = _histogram.GetPercentile(50);
+    summary.p99Us = _histogram.GetPercentile(99);
+    summary.maxUs = _histogram.GetMax();
+    summary.meanUs = _histogram.GetMean();
+    summary.budgetUs = _budgetUs;
+    summary.overruns = _overruns.load(std::memory_order_relaxed);
+    return summary;
+}
+
+//-----------------------------------------------------------------------------
+ModuleStats* Register(const char* name, uint32_t budgetUs)
+{
+    ModuleStats* stats = nullptr;
+
+    portENTER_CRITICAL(&s_registryLock);
+
+    const size_t count = s_moduleCount.load(std::memory_order_relaxed);
+    if (count < MAX_MODULES)
+    {
+        stats = &s_modules[count];
+        stats->Init(name, budgetUs);
+        s_moduleCount.store(count + 1, std::memory_order_release);
+    }
+
+    portEXIT_CRITICAL(&s_registryLock);
+
+    if (stats == nullptr)
+    {
+        CORE_WARNING("Perf: registry full, '%s' is not measured", name);
+    }
+
+    return stats;
+}
+
+//-----------------------------------------------------------------------------
+void ForEach(const std::function<void(const ModuleStats::Summary&)>& callback)
+{
+    const size_t count = s_moduleCount.load(std::memory_order_acquire);
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        callback(s_modules[i].GetSummary());
+    }
+}
+
+//-----------------------------------------------------------------------------
+void ResetAll()
+{
+    const size_t count = s_moduleCount.load(std::memory_order_acquire);
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        s_modules[i].Reset();
+    }
+}
+
+} // namespace Perf
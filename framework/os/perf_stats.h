@@ -0,0 +1,103 @@
+/*!****************************************************************************
+ * @file    perf_stats.h
+ * @brief   Per-module update latency statistics. Each module owns a
+ *          log2-bucketed histogram fed by Module/Manager::Update; p50/p99 are
+ *          read back at bucket resolution (within 2x), max and count exactly.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+namespace Perf {
+
+/**
+ * @brief Histogram of durations in microseconds. Bucket i holds values whose
+ *        bit width is i, i.e. [2^(i-1), 2^i). One writer, any number of readers.
+ */
+class LatencyHistogram
+{
+    public:
+
+        static constexpr size_t BUCKET_COUNT = 24;      //!< Last bucket also holds everything above ~8 s
+
+        void Record(uint32_t durationUs);
+        void Reset();
+
+        uint32_t GetCount() const { return _count.load(std::memory_order_relaxed); }
+        uint32_t GetMax() const { return _maxUs.load(std::memory_order_relaxed); }
+        uint32_t GetMean() const;
+
+        /**
+         * @brief Upper bound of the bucket holding the given percentile, capped at the max.
+         * @param percentile 0..100
+         */
+        uint32_t GetPercentile(uint32_t percentile) const;
+
+    private:
+
+        std::atomic<uint32_t> _buckets[BUCKET_COUNT] = {};
+        std::atomic<uint32_t> _count{0};
+        std::atomic<uint32_t> _maxUs{0};
+        std::atomic<uint64_t> _totalUs{0};
+};
+
+/**
+ * @brief Latency statistics of one module against its budget.
+ */
+class ModuleStats
+{
+    public:
+
+        struct Summary
+        {
+            const char* name = nullptr;
+            uint32_t count = 0;
+            uint32_t p50Us = 0;
+            uint32_t p99Us = 0;
+            uint32_t maxUs = 0;
+            uint32_t meanUs = 0;
+            uint32_t budgetUs = 0;          //!< 0 = no budget
+            uint32_t overruns = 0;          //!< Updates that took longer than the budget
+        };
+
+        void Init(const char* name, uint32_t budgetUs);
+        void Record(uint64_t durationUs);
+        void Reset();
+
+        Summary GetSummary() const;
+
+    private:
+
+        const char* _name = nullptr;
+        uint32_t _budgetUs = 0;
+        std::atomic<uint32_t> _overruns{0};
+        LatencyHistogram _histogram;
+};
+
+static constexpr size_t MAX_MODULES = 24;
+
+/**
+ * @brief Get the statistics slot of a module, creating it on first use.
+ * @param name Module name (must outlive the registry).
+ * @param budgetUs Update budget, 0 for none.
+ * @return ModuleStats* Slot, nullptr if the registry is full.
+ */
+ModuleStats* Register(const char* name, uint32_t budgetUs);
+
+/**
+ * @brief Visit every registered module in registration order.
+ */
+void ForEach(const std::function<void(const ModuleStats::Summary&)>& callback);
+
+/**
+ * @brief Clear every histogram and overrun counter.
+ */
+void ResetAll();
+
+} // namespace Perf
@@ -0,0 +1,209 @@
+/*!****************************************************************************
+ * @file    ring_buffer.h
+ * @brief   Fixed-capacity lock-free ring buffers for handing data between
+ *          tasks (or from an ISR to a task) without sharing mutable state.
+ *          SpscRingBuffer: one producer, one consumer, wait-free.
+ *          MpscRingBuffer: many producers, one consumer, lock-free.
+ *          Pushing from an ISR is safe as long as T is trivially copyable
+ *          (no allocation happens inside the buffer itself).
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+namespace RingBuffer {
+
+//! Producer and consumer indices live on separate lines so they don't bounce between cores
+inline constexpr size_t CACHE_LINE_SIZE = 64;
+
+} // namespace RingBuffer
+
+/**
+ * @brief Single-producer single-consumer ring buffer.
+ * @tparam T Element type (default constructible and move assignable).
+ * @tparam Capacity Number of elements, must be a power of two.
+ */
+template <typename T, size_t Capacity>
+class SpscRingBuffer
+{
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+    public:
+
+        SpscRingBuffer() = default;
+        SpscRingBuffer(const SpscRingBuffer&) = delete;
+        SpscRingBuffer& operator=(const SpscRingBuffer&) = delete;
+
+        /**
+         * @brief Push an element. Producer side only.
+         * @return true if pushed, false if the buffer is full.
+         */
+        bool TryPush(T item)
+        {
+            const size_t head = _head.load(std::memory_order_relaxed);
+            if (head - _tail.load(std::memory_order_acquire) == Capacity)
+            {
+                return false;
+            }
+
+            _items[head & MASK] = std::move(item);
+            _head.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * @brief Pop the oldest element. Consumer side only.
+         * @return true if an element was popped, false if the buffer is empty.
+         */
+        bool TryPop(T& item)
+        {
+            const size_t tail = _tail.load(std::memory_order_relaxed);
+            if (tail == _head.load(std::memory_order_acquire))
+            {
+                return false;
+            }
+
+            item = std::move(_items[tail & MASK]);
+            _tail.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * @brief Number of elements currently stored (approximate while producers are active).
+         */
+        size_t Size() const
+        {
+            return _head.load(std::memory_order_acquire) - _tail.load(std::memory_order_acquire);
+        }
+
+        bool IsEmpty() const { return Size() == 0; }
+
+        static constexpr size_t GetCapacity() { return Capacity; }
+
+    private:
+
+        static constexpr size_t MASK = Capacity - 1;
+
+        // ---------------------------------------------
+
+        alignas(RingBuffer::CACHE_LINE_SIZE) std::atomic<size_t> _head{0};     //!< Written by the producer
+        alignas(RingBuffer::CACHE_LINE_SIZE) std::atomic<size_t> _tail{0};     //!< Written by the consumer
+        alignas(RingBuffer::CACHE_LINE_SIZE) std::array<T, Capacity> _items{};
+};
+
+/**
+ * @brief Multi-producer single-consumer ring buffer.
+ *        Each cell carries a sequence number: producers claim a cell with a CAS
+ *        on the head index, then publish it by bumping the cell sequence. A
+ *        producer preempted between both steps only delays the consumer; it
+ *        never blocks other producers.
+ * @tparam T Element type (default constructible and move assignable).
+ * @tparam Capacity Number of elements, must be a power of two.
+ */
+template <typename T, size_t Capacity>
+class MpscRingBuffer
+{
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+    public:
+
+        MpscRingBuffer()
+        {
+            for (size_t i = 0; i < Capacity; ++i)
+            {
+                _cells[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        MpscRingBuffer(const MpscRingBuffer&) = delete;
+        MpscRingBuffer& operator=(const MpscRingBuffer&) = delete;
+
+        /**
+         * @brief Push an element. Safe from any number of tasks.
+         * @return true if pushed, false if the buffer is full.
+         */
+        bool TryPush(T item)
+        {
+            size_t head = _head.load(std::memory_order_relaxed);
+
+            while (true)
+            {
+                Cell& cell = _cells[head & MASK];
+                const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+                const intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(head);
+
+                if (diff == 0)
+                {
+                    if (_head.compare_exchange_weak(head, head + 1, std::memory_order_relaxed))
+                    {
+                        cell.item = std::move(item);
+                        cell.sequence.store(head + 1, std::memory_order_release);
+                        return true;
+                    }
+                }
+                else if (diff < 0)
+                {
+                    return false;
+                }
+                else
+                {
+                    head = _head.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        /**
+         * @brief Pop the oldest published element. Consumer side only.
+         * @return true if an element was popped, false if none is ready.
+         */
+        bool TryPop(T& item)
+        {
+            const size_t tail = _tail.load(std::memory_order_relaxed);
+            Cell& cell = _cells[tail & MASK];
+
+            if (cell.sequence.load(std::memory_order_acquire) != tail + 1)
+            {
+                return false;
+            }
+
+            item = std::move(cell.item);
+            cell.sequence.store(tail + Capacity, std::memory_order_release);
+            _tail.store(tail + 1, std::memory_order_relaxed);
+            return true;
+        }
+
+        /**
+         * @brief Number of claimed cells (approximate while producers are active).
+         */
+        size_t Size() const
+        {
+            return _head.load(std::memory_order_acquire) - _tail.load(std::memory_order_acquire);
+        }
+
+        bool IsEmpty() const { return Size() == 0; }
+
+        static constexpr size_t GetCapacity() { return Capacity; }
+
+    private:
+
+        struct Cell
+        {
+            std::atomic<size_t> sequence;
+            T item{};
+        };
+
+        static constexpr size_t MASK = Capacity - 1;
+
+        // ---------------------------------------------
+
+        alignas(RingBuffer::CACHE_LINE_SIZE) std::atomic<size_t> _head{0};     //!< Claimed by producers
+        alignas(RingBuffer::CACHE_LINE_SIZE) std::atomic<size_t> _tail{0};     //!< Written by the consumer
+        alignas(RingBuffer::CACHE_LINE_SIZE) std::array<Cell, Capacity> _cells;
+};
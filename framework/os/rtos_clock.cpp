@@ -0,0 +1,66 @@
+/*!****************************************************************************
+ * @file    rtos_clock.cpp
+ * @brief   Implementation of RtosClock.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#include "framework/os/rtos_clock.h"
+
+#include "esp_timer.h"
+
+//-----------------------------------------------------------------------------
+uint64_t RtosClock::NowUs() const
+{
+    return esp_timer_get_time();
+}
+
+//-----------------------------------------------------------------------------
+bool RtosClock::WaitUntil(uint64_t deadlineUs)
+{
+    _waiter = xTaskGetCurrentTaskHandle();
+
+    TickType_t ticks = portMAX_DELAY;
+
+    if (deadlineUs != NO_DEADLINE)
+    {
+        const uint64_t now = NowUs();
+        if (deadlineUs <= now)
+        {
+            // Consume a pending wake-up without blocking
+            return (ulTaskNotifyTake(pdTRUE, 0) > 0);
+        }
+
+        // Round up so we never wake before the deadline
+        const uint64_t remainingMs = ((deadlineUs - now) + 999) / 1000;
+        ticks = pdMS_TO_TICKS(remainingMs);
+        if (ticks == 0)
+        {
+            ticks = 1;
+        }
+    }
+
+    return (ulTaskNotifyTake(pdTRUE, ticks) > 0);
+}
+
+//-----------------------------------------------------------------------------
+void RtosClock::Wake()
+{
+    TaskHandle_t waiter = _waiter.load();
+    if (waiter != nullptr)
+    {
+        xTaskNotifyGive(waiter);
+    }
+}
+
+//-----------------------------------------------------------------------------
+void RtosClock::WakeFromIsr()
+{
+    TaskHandle_t waiter = _waiter.load();
+    if (waiter != nullptr)
+    {
+        BaseType_t higherPriorityTaskWoken = pdFALSE;
+        vTaskNotifyGiveFromISR(waiter, &higherPriorityTaskWoken);
+        portYIELD_FROM_ISR(higherPriorityTaskWoken);
+    }
+}
@@ -0,0 +1,48 @@
+/*!****************************************************************************
+ * @file    rtos_clock.h
+ * @brief   IClock implementation backed by esp_timer and FreeRTOS task notifications.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#pragma once
+
+#include "framework/os/clock.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include <atomic>
+
+class RtosClock : public IClock
+{
+    public:
+
+        RtosClock() = default;
+
+        RtosClock(const RtosClock&) = delete;
+        RtosClock& operator=(const RtosClock&) = delete;
+
+        /**
+         * @brief Current esp_timer time in microseconds.
+         */
+        uint64_t NowUs() const override;
+
+        /**
+         * @brief Block on the calling task's notification value until the deadline.
+         *        The first task calling this becomes the one woken by Wake().
+         */
+        bool WaitUntil(uint64_t deadlineUs) override;
+
+        /**
+         * @brief Give a notification to the waiting task.
+         */
+        void Wake() override;
+
+        /**
+         * @brief Give a notification to the waiting task from an ISR.
+         */
+        void WakeFromIsr() override;
+
+    private:
+
+        std::atomic<TaskHandle_t> _waiter{nullptr};
+};
@@ -0,0 +1,227 @@
+/*!****************************************************************************
+ * @file    scheduler.cpp
+ * @brief   Implementation of the event-driven cooperative scheduler.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#include "framework/os/scheduler.h"
+
+#include "framework/common_defs.h"
+#include <algorithm>
+
+//-----------------------------------------------------------------------------
+Scheduler::Scheduler(IClock& clock)
+    : _clock(clock)
+    , _taskCount(0)
+{
+}
+
+//-----------------------------------------------------------------------------
+Scheduler::TaskId Scheduler::Register(const char* name, const Schedule& schedule, TaskCallback callback)
+{
+    if (_taskCount >= MAX_TASKS || !callback)
+    {
+        CORE_ERROR("Cannot register task %s", (name != nullptr) ? name : "?");
+        return INVALID_TASK;
+    }
+
+    Task& task = _tasks[_taskCount];
+    task.name = name;
+    task.schedule = schedule;
+    task.callback = std::move(callback);
+    task.nextReleaseUs = _clock.NowUs();
+    task.pending = WAKE_NONE;
+    task.stats = TaskStats{};
+
+    CORE_INFO("Task %s registered (period %lu ms, deadline %lu ms, wake 0x%02X)",
+              name,
+              static_cast<unsigned long>(schedule.periodMs),
+              static_cast<unsigned long>(schedule.deadlineMs),
+              schedule.wakeSources);
+
+    return static_cast<TaskId>(_taskCount++);
+}
+
+//-----------------------------------------------------------------------------
+void Scheduler::Notify(TaskId id, WakeSource source)
+{
+    if (id < 0 || static_cast<size_t>(id) >= _taskCount)
+    {
+        return;
+    }
+
+    _tasks[id].pending.fetch_or(source);
+    _clock.Wake();
+}
+
+//-----------------------------------------------------------------------------
+void Scheduler::NotifyFromIsr(TaskId id, WakeSource source)
+{
+    if (id < 0 || static_cast<size_t>(id) >= _taskCount)
+    {
+        return;
+    }
+
+    _tasks[id].pending.fetch_or(source);
+    _clock.WakeFromIsr();
+}
+
+//-----------------------------------------------------------------------------
+void Scheduler::RunOnce()
+{
+    // Bound the work done per call so a task re-notifying itself cannot starve the wait
+    const size_t maxRuns = _taskCount * 2;
+
+    for (size_t runs = 0; runs < maxRuns; ++runs)
+    {
+        uint64_t releaseUs = 0;
+        Task* task = _PickNextReady(_clock.NowUs(), releaseUs);
+        if (task == nullptr)
+        {
+            _clock.WaitUntil(_NextTimerReleaseUs());
+            return;
+        }
+
+        _Run(*task, releaseUs);
+    }
+}
+
+//-----------------------------------------------------------------------------
+const Scheduler::TaskStats* Scheduler::GetStats(TaskId id) const
+{
+    if (id < 0 || static_cast<size_t>(id) >= _taskCount)
+    {
+        return nullptr;
+    }
+
+    return &_tasks[id].stats;
+}
+
+//-----------------------------------------------------------------------------
+const char* Scheduler::GetName(TaskId id) const
+{
+    if (id < 0 || static_cast<size_t>(id) >= _taskCount)
+    {
+        return nullptr;
+    }
+
+    return _tasks[id].name;
+}
+
+//----private------------------------------------------------------------------
+Scheduler::Task* Scheduler::_PickNextReady(uint64_t nowUs, uint64_t& releaseUs)
+{
+    Task* selected = nullptr;
+    uint64_t selectedDeadlineUs = IClock::NO_DEADLINE;
+
+    for (size_t i = 0; i < _taskCount; ++i)
+    {
+        Task& task = _tasks[i];
+        const uint8_t sources = task.schedule.wakeSources;
+
+        uint64_t taskReleaseUs = IClock::NO_DEADLINE;
+
+        if ((task.pending.load() & sources) != 0)
+        {
+            // Event releases happen "now" from the scheduler's point of view
+            taskReleaseUs = nowUs;
+        }
+
+        if ((sources & WAKE_TIMER) != 0 && task.schedule.periodMs > 0 && task.nextReleaseUs <= nowUs)
+        {
+            taskReleaseUs = std::min(taskReleaseUs, task.nextReleaseUs);
+        }
+
+        if (taskReleaseUs == IClock::NO_DEADLINE)
+        {
+            continue;
+        }
+
+        const uint64_t deadlineUs = taskReleaseUs + _RelativeDeadlineUs(task);
+        if (selected == nullptr || deadlineUs < selectedDeadlineUs)
+        {
+            selected = &task;
+            selectedDeadlineUs = deadlineUs;
+            releaseUs = taskReleaseUs;
+        }
+    }
+
+    return selected;
+}
+
+//-----------------------------------------------------------------------------
+void Scheduler::_Run(Task& task, uint64_t releaseUs)
+{
+    // Clear before running so notifications raised during the callback are kept
+    task.pending.exchange(WAKE_NONE);
+
+    const uint64_t startUs = _clock.NowUs();
+    task.callback();
+    const uint64_t endUs = _clock.NowUs();
+
+    TaskStats& stats = task.stats;
+    stats.runs++;
+    stats.lastRunUs = endUs - startUs;
+    stats.maxRunUs = std::max(stats.maxRunUs, stats.lastRunUs);
+    stats.maxReleaseLatencyUs = std::max(stats.maxReleaseLatencyUs, startUs - releaseUs);
+
+    if (endUs > releaseUs + _RelativeDeadlineUs(task))
+    {
+        stats.deadlineMisses++;
+        CORE_WARNING("Task %s missed its deadline (%llu us after release)",
+                     task.name,
+                     static_cast<unsigned long long>(endUs - releaseUs));
+    }
+
+    if ((task.schedule.wakeSources & WAKE_TIMER) != 0 && task.schedule.periodMs > 0)
+    {
+        const uint64_t periodUs = static_cast<uint64_t>(task.schedule.periodMs) * 1000ULL;
+
+        if (releaseUs < task.nextReleaseUs)
+        {
+            // Released by an event ahead of the timer: restart the period from now
+            task.nextReleaseUs = startUs + periodUs;
+        }
+        else
+        {
+            // Keep the release grid, but skip releases already missed instead of bursting
+            task.nextReleaseUs += periodUs;
+            if (task.nextReleaseUs <= endUs)
+            {
+                task.nextReleaseUs = endUs + periodUs;
+            }
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+uint64_t Scheduler::_NextTimerReleaseUs() const
+{
+    uint64_t nextUs = IClock::NO_DEADLINE;
+
+    for (size_t i = 0; i < _taskCount; ++i)
+    {
+        const Task& task = _tasks[i];
+        if ((task.schedule.wakeSources & WAKE_TIMER) != 0 && task.schedule.periodMs > 0)
+        {
+            nextUs = std::min(nextUs, task.nextReleaseUs);
+        }
+    }
+
+    return nextUs;
+}
+
+//-----------------------------------------------------------------------------
+uint64_t Scheduler::_RelativeDeadlineUs(const Task& task)
+{
+    const uint32_t deadlineMs = (task.schedule.deadlineMs > 0) ? task.schedule.deadlineMs : task.schedule.periodMs;
+
+    if (deadlineMs == 0)
+    {
+        // Event-only task without explicit deadline: never considered late
+        return IClock::NO_DEADLINE / 2;
+    }
+
+    return static_cast<uint64_t>(deadlineMs) * 1000ULL;
+}
@@ -0,0 +1,161 @@
+/*!****************************************************************************
+ * @file    scheduler.h
+ * @brief   Event-driven cooperative scheduler.
+ *          Each registered task declares a period, a relative deadline and
+ *          the wake sources it reacts to. RunOnce() executes every ready task
+ *          in earliest-deadline-first order and then blocks on the clock until
+ *          the next release or an explicit notification.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#pragma once
+
+#include "framework/os/clock.h"
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+class Scheduler
+{
+    public:
+
+        using TaskId = int;
+        using TaskCallback = std::function<void()>;
+
+        static constexpr TaskId INVALID_TASK = -1;
+        static constexpr size_t MAX_TASKS = 16;
+
+        /**
+         * @brief Events that make a task ready to run. Can be OR-ed together.
+         */
+        enum WakeSource : uint8_t
+        {
+            WAKE_NONE           = 0x00,
+            WAKE_TIMER          = 0x01,     //!< Released every periodMs
+            WAKE_QUEUE          = 0x02,     //!< Released when a producer posts to the task's queue
+            WAKE_NOTIFICATION   = 0x04,     //!< Released by an explicit Notify()
+        };
+
+        /**
+         * @brief Timing requirements of a task.
+         */
+        struct Schedule
+        {
+            uint32_t periodMs = 0;                  //!< Release period (only with WAKE_TIMER, 0 = none)
+            uint32_t deadlineMs = 0;                //!< Relative deadline after release (0 = same as period)
+            uint8_t wakeSources = WAKE_NONE;        //!< Bitmask of WakeSource
+        };
+
+        /**
+         * @brief Runtime counters of a task.
+         */
+        struct TaskStats
+        {
+            uint32_t runs = 0;                      //!< Number of executions
+            uint32_t deadlineMisses = 0;            //!< Executions finished after their deadline
+            uint64_t lastRunUs = 0;                 //!< Duration of the last execution
+            uint64_t maxRunUs = 0;                  //!< Longest execution seen
+            uint64_t maxReleaseLatencyUs = 0;       //!< Longest delay between release and start
+        };
+
+        /**
+         * @brief Construct a scheduler.
+         * @param clock Time source used for releases and for blocking.
+         */
+        explicit Scheduler(IClock& clock);
+
+        Scheduler(const Scheduler&) = delete;
+        Scheduler& operator=(const Scheduler&) = delete;
+
+        /**
+         * @brief Register a task. Must be called before RunOnce() starts being called.
+         *        Timer-driven tasks get their first release immediately.
+         * @param name Name for debug purposes (must outlive the scheduler).
+         * @param schedule Timing requirements.
+         * @param callback Work to execute on each release.
+         * @return TaskId Identifier of the task, INVALID_TASK if the table is full.
+         */
+        TaskId Register(const char* name, const Schedule& schedule, TaskCallback callback);
+
+        /**
+         * @brief Release a task from another task. The task only runs if it
+         *        listens to the given wake source.
+         * @param id Task identifier.
+         * @param source Wake source raised (WAKE_NOTIFICATION or WAKE_QUEUE).
+         */
+        void Notify(TaskId id, WakeSource source = WAKE_NOTIFICATION);
+
+        /**
+         * @brief Same as Notify() but safe to call from an interrupt handler.
+         */
+        void NotifyFromIsr(TaskId id, WakeSource source = WAKE_NOTIFICATION);
+
+        /**
+         * @brief Run every ready task in earliest-deadline-first order, then block
+         *        until the next timer release or notification.
+         */
+        void RunOnce();
+
+        /**
+         * @brief Get the counters of a task.
+         * @param id Task identifier.
+         * @return const TaskStats* Counters, nullptr if the id is invalid.
+         */
+        const TaskStats* GetStats(TaskId id) const;
+
+        /**
+         * @brief Get the name of a task.
+         * @param id Task identifier.
+         * @return const char* Task name, nullptr if the id is invalid.
+         */
+        const char* GetName(TaskId id) const;
+
+        /**
+         * @brief Get the number of registered tasks.
+         */
+        size_t GetTaskCount() const { return _taskCount; }
+
+    private:
+
+        struct Task
+        {
+            const char* name = nullptr;
+            Schedule schedule;
+            TaskCallback callback;
+            uint64_t nextReleaseUs = 0;             //!< Next timer release
+            std::atomic<uint8_t> pending{WAKE_NONE};
+            TaskStats stats;
+        };
+
+        /**
+         * @brief Pick the ready task with the earliest absolute deadline.
+         * @param nowUs Current time.
+         * @param releaseUs Output: release time of the selected task.
+         * @return Task* Selected task, nullptr if none is ready.
+         */
+        Task* _PickNextReady(uint64_t nowUs, uint64_t& releaseUs);
+
+        /**
+         * @brief Execute a task and update its counters and next release.
+         */
+        void _Run(Task& task, uint64_t releaseUs);
+
+        /**
+         * @brief Earliest upcoming timer release among all tasks.
+         */
+        uint64_t _NextTimerReleaseUs() const;
+
+        /**
+         * @brief Deadline of a task in microseconds.
+         */
+        static uint64_t _RelativeDeadlineUs(const Task& task);
+
+        // ---------------------------------------------
+
+        IClock& _clock;
+        std::array<Task, MAX_TASKS> _tasks;
+        size_t _taskCount;
+};
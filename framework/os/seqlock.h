@@ -0,0 +1,144 @@
+/*!****************************************************************************
+ * @file    seqlock.h
+ * @brief   Sequence lock publishing a small trivially copyable value to any
+ *          number of readers. Writers are serialized by a spinlock and bump
+ *          the sequence to odd while they copy, then to the next even value.
+ *          Readers never block the writer: they copy the value and retry if
+ *          the sequence was odd or changed meanwhile.
+ *          The value is stored as relaxed atomic words, so a torn copy is
+ *          never undefined behaviour, only discarded.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#pragma once
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+/**
+ * @brief Single value published with a sequence counter.
+ * @tparam T Trivially copyable value type.
+ */
+template <typename T>
+class Seqlock
+{
+    static_assert(std::is_trivially_copyable_v<T>, "Seqlock value must be trivially copyable");
+
+    public:
+
+        Seqlock() { StoreWords(); }
+        Seqlock(const Seqlock&) = delete;
+        Seqlock& operator=(const Seqlock&) = delete;
+
+        /**
+         * @brief Copy the latest published value. Lock-free, any task or core.
+         * @return uint32_t Generation of the copied value (number of publications, 0 = default value).
+         */
+        uint32_t Read(T& value) const
+        {
+            uint32_t words[WORD_COUNT];
+            uint32_t sequence = 0;
+
+            for (uint32_t attempt = 0; ; ++attempt)
+            {
+                sequence = _sequence.load(std::memory_order_acquire);
+
+                if ((sequence & 1U) == 0)
+                {
+                    for (size_t i = 0; i < WORD_COUNT; ++i)
+                    {
+                        words[i] = _words[i].load(std::memory_order_relaxed);
+                    }
+
+                    std::atomic_thread_fence(std::memory_order_acquire);
+
+                    if (_sequence.load(std::memory_order_relaxed) == sequence)
+                    {
+                        break;
+                    }
+                }
+
+                // The writer is inside a critical section on the other core,
+                // or was preempted (host): let it finish
+                if (attempt >= SPINS_BEFORE_YIELD)
+                {
+                    taskYIELD();
+                }
+            }
+
+            std::memcpy(&value, words, sizeof(T));
+            return sequence / 2;
+        }
+
+        T Read() const
+        {
+            T value;
+            Read(value);
+            return value;
+        }
+
+        /**
+         * @brief Publish a new value.
+         */
+        void Write(const T& value)
+        {
+            Update([&value](T& current) { current = value; });
+        }
+
+        /**
+         * @brief Modify part of the value and publish the result. The callback
+         *        runs inside a critical section: no blocking, logging or I/O.
+         */
+        template <typename Fn>
+        void Update(Fn&& update)
+        {
+            portENTER_CRITICAL(&_writerLock);
+            update(_current);
+            Publish();
+            portEXIT_CRITICAL(&_writerLock);
+        }
+
+        uint32_t GetGeneration() const { return _sequence.load(std::memory_order_acquire) / 2; }
+
+    private:
+
+        static constexpr size_t WORD_COUNT = (sizeof(T) + sizeof(uint32_t) - 1) / sizeof(uint32_t);
+        static constexpr uint32_t SPINS_BEFORE_YIELD = 16;
+
+        //! Writer lock held
+        void Publish()
+        {
+            const uint32_t sequence = _sequence.load(std::memory_order_relaxed);
+            _sequence.store(sequence + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+
+            StoreWords();
+
+            _sequence.store(sequence + 2, std::memory_order_release);
+        }
+
+        //! Copy _current into the published words
+        void StoreWords()
+        {
+            uint32_t words[WORD_COUNT] = {};
+            std::memcpy(words, &_current, sizeof(T));
+
+            for (size_t i = 0; i < WORD_COUNT; ++i)
+            {
+                _words[i].store(words[i], std::memory_order_relaxed);
+            }
+        }
+
+        // ---------------------------------------------
+
+        std::atomic<uint32_t> _sequence{0};
+        std::atomic<uint32_t> _words[WORD_COUNT] = {};
+        T _current{};                                       //!< Writer copy, only touched under _writerLock
+        portMUX_TYPE _writerLock = portMUX_INITIALIZER_UNLOCKED;
+};
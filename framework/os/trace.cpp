@@ -0,0 +1,140 @@
+/*!****************************************************************************
+ * @file    trace.cpp
+ * @brief   Implementation of the per-core trace rings.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#include "framework/os/trace.h"
+
+#include "esp_timer.h"
+#include "freertos/task.h"
+#include <atomic>
+#include <cstring>
+
+namespace Trace {
+
+namespace {
+
+using EventRing = MpscRingBuffer<Event, EVENTS_PER_CORE>;
+
+EventRing s_rings[portNUM_PROCESSORS];
+std::atomic<bool> s_enabled{true};
+std::atomic<uint32_t> s_dropped{0};
+
+//-----------------------------------------------------------------------------
+void Record(const char* name, char phase)
+{
+    if (!s_enabled.load(std::memory_order_relaxed))
+    {
+        return;
+    }
+
+    Event event;
+    event.timestampUs = esp_timer_get_time();
+    event.name = name;
+    event.core = static_cast<uint8_t>(xPortGetCoreID());
+    event.phase = phase;
+
+    const char* task = (xTaskGetSchedulerState() == taskSCHEDULER_RUNNING) ? pcTaskGetName(NULL) : "boot";
+    strncpy(event.task, task, TASK_NAME_LENGTH - 1);
+
+    if (!s_rings[event.core % portNUM_PROCESSORS].TryPush(event))
+    {
+        s_dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+} // namespace
+
+//-----------------------------------------------------------------------------
+void SetEnabled(bool enabled)
+{
+    s_enabled.store(enabled);
+}
+
+//-----------------------------------------------------------------------------
+bool IsEnabled()
+{
+    return s_enabled.load();
+}
+
+//-----------------------------------------------------------------------------
+void Begin(const char* name)
+{
+    Record(name, 'B');
+}
+
+//-----------------------------------------------------------------------------
+void End(const char* name)
+{
+    Record(name, 'E');
+}
+
+//-----------------------------------------------------------------------------
+size_t Drain(size_t maxEvents, const EventCallback& callback)
+{
+    size_t count = 0;
+
+    for (auto& ring : s_rings)
+    {
+        Event event;
+        while (count < maxEvents && ring.TryPop(event))
+        {
+            callback(event);
+            ++count;
+        }
+    }
+
+    return count;
+}
+
+//-----------------------------------------------------------------------------
+size_t GetPendingCount()
+{
+    size_t pending = 0;
+
+    for (const auto& ring : s_rings)
+    {
+        pending += ring.Size();
+    }
+
+    return pending;
+}
+
+//-----------------------------------------------------------------------------
+uint32_t GetDroppedCount()
+{
+    return s_dropped.load();
+}
+
+//-----------------------------------------------------------------------------
+void FormatEvent(const Event& event, char* buffer, size_t size)
+{
+    snprintf(buffer, size, "TRACE\t%llu\t%c\t%u\t%s\t%s\n",
+             static_cast<unsigned long long>(event.timestampUs),
+             event.phase,
+             static_cast<unsigned>(event.core),
+             event.task,
+             event.name);
+}
+
+//-----------------------------------------------------------------------------
+size_t Dump(FILE* stream)
+{
+    char line[96];
+
+    const size_t count = Drain(SIZE_MAX, [stream, &line](const Event& event)
+        {
+            FormatEvent(event, line, sizeof(line));
+            fputs(line, stream);
+        }
+    );
+
+    fprintf(stream, "TRACE_DROPPED\t%u\n", static_cast<unsigned>(GetDroppedCount()));
+    fflush(stream);
+
+    return count;
+}
+
+} // namespace Trace
@@ -0,0 +1,110 @@
+/*!****************************************************************************
+ * @file    trace.h
+ * @brief   Scoped begin/end tracing of hot paths. Each event records the
+ *          esp_timer timestamp, task name and core, and goes into a per-core
+ *          lock-free ring. Drain the rings with Trace::Dump() (UART) or the
+ *          getTrace RPC and convert them with scripts/trace_to_chrome.py.
+ *
+ *          CORE_TRACE_SCOPE("name") traces the enclosing block. The name must
+ *          outlive the trace buffer (string literals, module names).
+ *          Build with CORE_TRACE_ENABLED=0 to compile every scope out.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#pragma once
+
+#include "framework/os/ring_buffer.h"
+#include "freertos/FreeRTOS.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+
+#ifndef CORE_TRACE_ENABLED
+    #define CORE_TRACE_ENABLED 1
+#endif
+
+namespace Trace {
+
+static constexpr size_t EVENTS_PER_CORE = 128;      //!< Must be a power of two
+static constexpr size_t TASK_NAME_LENGTH = 12;
+
+struct Event
+{
+    uint64_t timestampUs = 0;
+    const char* name = nullptr;
+    char task[TASK_NAME_LENGTH] = {};
+    uint8_t core = 0;
+    char phase = 'B';                               //!< 'B' begin, 'E' end (Chrome trace phases)
+};
+
+using EventCallback = std::function<void(const Event&)>;
+
+/**
+ * @brief Enable or disable recording (enabled at boot).
+ */
+void SetEnabled(bool enabled);
+
+bool IsEnabled();
+
+/**
+ * @brief Record the begin/end of a section. Task context only.
+ */
+void Begin(const char* name);
+void End(const char* name);
+
+/**
+ * @brief Pop up to maxEvents recorded events, oldest first within each core.
+ * @return size_t Number of events passed to the callback.
+ */
+size_t Drain(size_t maxEvents, const EventCallback& callback);
+
+/**
+ * @brief Events still buffered on all cores.
+ */
+size_t GetPendingCount();
+
+/**
+ * @brief Events lost because a ring was full, since boot.
+ */
+uint32_t GetDroppedCount();
+
+/**
+ * @brief Write one line per event: "TRACE <us> <B|E> <core> <task> <name>", tab separated.
+ */
+void FormatEvent(const Event& event, char* buffer, size_t size);
+
+/**
+ * @brief Drain every buffered event to a stream (stdout is the UART on target).
+ * @return size_t Number of events written.
+ */
+size_t Dump(FILE* stream);
+
+/**
+ * @brief Traces the lifetime of the enclosing block.
+ */
+class Scope
+{
+    public:
+
+        explicit Scope(const char* name) : _name(name) { Begin(_name); }
+        ~Scope() { End(_name); }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+
+        const char* _name;
+};
+
+} // namespace Trace
+
+#if CORE_TRACE_ENABLED
+    #define CORE_TRACE_CONCAT_INNER(a, b)   a##b
+    #define CORE_TRACE_CONCAT(a, b)         CORE_TRACE_CONCAT_INNER(a, b)
+    #define CORE_TRACE_SCOPE(name)          Trace::Scope CORE_TRACE_CONCAT(_traceScope, __LINE__)(name)
+#else
+    #define CORE_TRACE_SCOPE(name)          do {} while (0)
+#endif
@@ -0,0 +1,72 @@
+/*!****************************************************************************
+ * @file    virtual_clock.h
+ * @brief   Deterministic IClock stand-in for Linux host builds.
+ *          Time only moves when a wait reaches its deadline or when the
+ *          owner advances it explicitly, so schedules replay identically.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#pragma once
+
+#include "framework/os/clock.h"
+#include <atomic>
+
+class VirtualClock : public IClock
+{
+    public:
+
+        /**
+         * @brief Construct a virtual clock.
+         * @param startUs Initial time in microseconds.
+         */
+        explicit VirtualClock(uint64_t startUs = 0) : _nowUs(startUs) {}
+
+        VirtualClock(const VirtualClock&) = delete;
+        VirtualClock& operator=(const VirtualClock&) = delete;
+
+        /**
+         * @brief Current virtual time in microseconds.
+         */
+        uint64_t NowUs() const override { return _nowUs.load(); }
+
+        /**
+         * @brief Jump straight to the deadline unless a wake-up is pending.
+         *        Waiting forever with nothing pending leaves time untouched.
+         */
+        bool WaitUntil(uint64_t deadlineUs) override
+        {
+            if (_wakePending.exchange(false))
+            {
+                return true;
+            }
+
+            if (deadlineUs != NO_DEADLINE && deadlineUs > _nowUs.load())
+            {
+                _nowUs = deadlineUs;
+            }
+
+            return false;
+        }
+
+        /**
+         * @brief Mark a wake-up as pending for the next WaitUntil().
+         */
+        void Wake() override { _wakePending = true; }
+
+        /**
+         * @brief Same as Wake(); there are no interrupts on the host.
+         */
+        void WakeFromIsr() override { _wakePending = true; }
+
+        /**
+         * @brief Move time forward.
+         * @param deltaUs Microseconds to add to the current time.
+         */
+        void Advance(uint64_t deltaUs) { _nowUs += deltaUs; }
+
+    private:
+
+        std::atomic<uint64_t> _nowUs;
+        std::atomic<bool> _wakePending{false};
+};
@@ -0,0 +1,82 @@
+/*!****************************************************************************
+ * @file    bit_ring.h
+ * @brief   Fixed-size ring of bits addressed by absolute bit positions.
+ *          Positions only grow; position % capacity is the place in the
+ *          buffer, so the owner decides what is still valid. Fields are
+ *          written MSB first and may straddle bytes and the buffer end.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace TimeSeries {
+
+/**
+ * @brief Bit-addressed ring buffer.
+ * @tparam Bytes Capacity in bytes.
+ */
+template <size_t Bytes>
+class BitRing
+{
+    static_assert(Bytes >= 1, "BitRing needs at least one byte");
+
+    public:
+
+        static constexpr uint64_t CAPACITY_BITS = static_cast<uint64_t>(Bytes) * 8;
+
+        /**
+         * @brief Write the low 'bits' bits of value at an absolute position.
+         * @param bits 1-32.
+         */
+        void Write(uint64_t position, uint32_t value, unsigned bits)
+        {
+            while (bits > 0)
+            {
+                const uint64_t offset = position % CAPACITY_BITS;
+                const unsigned bitInByte = static_cast<unsigned>(offset % 8);
+                const unsigned chunk = (bits < 8 - bitInByte) ? bits : (8 - bitInByte);
+
+                // Top 'chunk' bits of what is left, placed after the bits already used in the byte
+                const uint8_t field = static_cast<uint8_t>((value >> (bits - chunk)) & ((1U << chunk) - 1));
+                const unsigned shift = 8 - bitInByte - chunk;
+                uint8_t& byte = _bytes[offset / 8];
+                byte = static_cast<uint8_t>((byte & ~(((1U << chunk) - 1) << shift)) | (field << shift));
+
+                position += chunk;
+                bits -= chunk;
+            }
+        }
+
+        /**
+         * @brief Read 'bits' bits (1-32) at an absolute position.
+         */
+        uint32_t Read(uint64_t position, unsigned bits) const
+        {
+            uint32_t value = 0;
+
+            while (bits > 0)
+            {
+                const uint64_t offset = position % CAPACITY_BITS;
+                const unsigned bitInByte = static_cast<unsigned>(offset % 8);
+                const unsigned chunk = (bits < 8 - bitInByte) ? bits : (8 - bitInByte);
+                const unsigned shift = 8 - bitInByte - chunk;
+
+                value = (value << chunk) | ((_bytes[offset / 8] >> shift) & ((1U << chunk) - 1));
+
+                position += chunk;
+                bits -= chunk;
+            }
+
+            return value;
+        }
+
+    private:
+
+        uint8_t _bytes[Bytes] = {};
+};
+
+} // namespace TimeSeries
@@ -0,0 +1,553 @@
+/*!****************************************************************************
+ * @file    time_series_store.h
+ * @brief   Fixed-memory store for records of several integer series sampled
+ *          together (one timestamp, one value per series).
+ *
+ *          Raw tier: every record, bit-packed in a BitRing. Records are
+ *          grouped in blocks of SAMPLES_PER_BLOCK; a block starts with the
+ *          full timestamp and values, then every record stores the change
+ *          of the timestamp step and the delta of each value with a prefix
+ *          code (see EncodeDelta). A steady sample rate and a constant value
+ *          cost one bit each. When the ring is full the oldest block is
+ *          dropped, so the raw tier holds as much recent history as fits.
+ *
+ *          Downsampled tiers: min/max/avg per series and the record count
+ *          per minute and per hour, in fixed rings of buckets.
+ *
+ *          Appends are O(1) (a bounded number of bits and one update per
+ *          tier). Timestamps are seconds and must not go backwards.
+ *          No allocation and no platform dependency: the whole store runs
+ *          unchanged on the host.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#pragma once
+
+#include "framework/timeseries/bit_ring.h"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace TimeSeries {
+
+enum class Tier : uint8_t
+{
+    MINUTE,
+    HOUR,
+    _size
+};
+
+//! Bucket values are stored in 16 bits: the series units must keep them in range
+struct Bucket
+{
+    int16_t min;
+    int16_t max;
+    int16_t avg;
+};
+
+template <size_t Series>
+struct BucketRow
+{
+    uint32_t start;                     //!< Timestamp of the start of the period
+    uint16_t count;                     //!< Records in the period
+    Bucket series[Series];
+};
+
+/**
+ * @brief Raw ring plus minute and hour tiers.
+ * @tparam Series Values per record.
+ * @tparam RawBytes Size of the raw ring.
+ * @tparam MinuteBuckets Minutes kept in the minute tier.
+ * @tparam HourBuckets Hours kept in the hour tier.
+ */
+template <size_t Series, size_t RawBytes, size_t MinuteBuckets, size_t HourBuckets>
+class TimeSeriesStore
+{
+    public:
+
+        using Values = std::array<int32_t, Series>;
+        using Row = BucketRow<Series>;
+
+        static constexpr size_t SAMPLES_PER_BLOCK = 128;
+
+        /**
+         * @brief Append a record. O(1).
+         * @return bool False if the timestamp is older than the last record (nothing stored).
+         */
+        bool Append(uint32_t timestamp, const Values& values)
+        {
+            if (_rawCount > 0 && timestamp < _lastTimestamp)
+            {
+                return false;
+            }
+
+            if (_blockCount == 0 || Newest().count == SAMPLES_PER_BLOCK)
+            {
+                StartBlock(timestamp, values);
+            }
+            else
+            {
+                AppendToBlock(timestamp, values);
+            }
+
+            _lastTimestamp = timestamp;
+            _lastValues = values;
+            ++_rawCount;
+
+            for (size_t tier = 0; tier < TIER_COUNT; ++tier)
+            {
+                Accumulate(tier, timestamp, values);
+            }
+
+            return true;
+        }
+
+        void Clear()
+        {
+            _writePosition = 0;
+            _blockHead = 0;
+            _blockCount = 0;
+            _rawCount = 0;
+
+            for (TierState& tier : _tiers)
+            {
+                tier.head = 0;
+                tier.count = 0;
+                tier.open.count = 0;
+            }
+        }
+
+        /**
+         * @brief Visit the raw records with from <= timestamp <= to, oldest first.
+         *        Seeks to the block holding 'from' by binary search on the block
+         *        start times, so only that block is decoded ahead of the range.
+         * @param fn Called as fn(uint32_t timestamp, const Values& values).
+         * @return size_t Records visited.
+         */
+        template <typename Fn>
+        size_t ForEachRaw(uint32_t from, uint32_t to, Fn&& fn) const
+        {
+            size_t visited = 0;
+
+            // Last block starting before 'from' (the first one when none does)
+            size_t low = 0;
+            size_t high = _blockCount;
+            while (high - low > 1)
+            {
+                const size_t middle = low + (high - low) / 2;
+                if (BlockAt(middle).firstTimestamp < from)
+                {
+                    low = middle;
+                }
+                else
+                {
+                    high = middle;
+                }
+            }
+
+            for (size_t b = low; b < _blockCount && BlockAt(b).firstTimestamp <= to; ++b)
+            {
+                const BlockInfo& block = BlockAt(b);
+                uint64_t position = block.startBit;
+
+                uint32_t timestamp = _raw.Read(position, 32);
+                position += 32;
+                Values values{};
+                for (size_t s = 0; s < Series; ++s)
+                {
+                    values[s] = static_cast<int32_t>(_raw.Read(position, 32));
+                    position += 32;
+                }
+
+                uint32_t step = 0;
+                for (size_t i = 0; i < block.count; ++i)
+                {
+                    if (i > 0)
+                    {
+                        int64_t change = 0;
+                        if (DecodeDelta(position, change))
+                        {
+                            step = static_cast<uint32_t>(step + change);
+                            timestamp += step;
+                        }
+                        else
+                        {
+                            step = static_cast<uint32_t>(change) - timestamp;
+                            timestamp = static_cast<uint32_t>(change);
+                        }
+
+                        for (size_t s = 0; s < Series; ++s)
+                        {
+                            int64_t delta = 0;
+                            values[s] = DecodeDelta(position, delta) ? static_cast<int32_t>(values[s] + delta)
+                                                                     : static_cast<int32_t>(delta);
+                        }
+                    }
+
+                    if (timestamp > to)
+                    {
+                        return visited;
+                    }
+
+                    if (timestamp >= from)
+                    {
+                        fn(timestamp, values);
+                        ++visited;
+                    }
+                }
+            }
+
+            return visited;
+        }
+
+        /**
+         * @brief Visit the buckets of a tier whose period ends after 'from' and starts
+         *        at or before 'to', oldest first. The period still open comes last,
+         *        with what it holds so far. Seeks to 'from' by binary search.
+         * @param fn Called as fn(const Row& row).
+         * @return size_t Buckets visited.
+         */
+        template <typename Fn>
+        size_t ForEachBucket(Tier tier, uint32_t from, uint32_t to, Fn&& fn) const
+        {
+            const TierState& state = _tiers[static_cast<size_t>(tier)];
+            const uint32_t period = TIER_PERIOD_S[static_cast<size_t>(tier)];
+            size_t visited = 0;
+
+            // First row whose period ends after 'from'
+            size_t low = 0;
+            size_t high = state.count;
+            while (low < high)
+            {
+                const size_t middle = low + (high - low) / 2;
+                if (static_cast<uint64_t>(RowAt(tier, middle).start) + period > from)
+                {
+                    high = middle;
+                }
+                else
+                {
+                    low = middle + 1;
+                }
+            }
+
+            for (size_t i = low; i < state.count; ++i)
+            {
+                const Row& row = RowAt(tier, i);
+                if (row.start > to)
+                {
+                    return visited;
+                }
+                fn(row);
+                ++visited;
+            }
+
+            if (state.open.count > 0 && static_cast<uint64_t>(state.openStart) + period > from && state.openStart <= to)
+            {
+                fn(CloseRow(state));
+                ++visited;
+            }
+
+            return visited;
+        }
+
+        size_t GetRawCount() const
+        {
+            size_t count = 0;
+            for (size_t b = 0; b < _blockCount; ++b)
+            {
+                count += BlockAt(b).count;
+            }
+            return count;
+        }
+
+        //! Oldest timestamp still in the raw tier (0 when empty)
+        uint32_t GetOldestRawTimestamp() const { return (_blockCount > 0) ? BlockAt(0).firstTimestamp : 0; }
+
+        //! Bits the raw tier currently uses
+        uint64_t GetRawBitsUsed() const { return (_blockCount > 0) ? (_writePosition - BlockAt(0).startBit) : 0; }
+
+        size_t GetBucketCount(Tier tier) const { return _tiers[static_cast<size_t>(tier)].count; }
+
+        static constexpr uint32_t GetTierPeriod(Tier tier) { return TIER_PERIOD_S[static_cast<size_t>(tier)]; }
+
+        //! Start of the oldest bucket of a tier, the open one included (0 when empty)
+        uint32_t GetOldestBucketStart(Tier tier) const
+        {
+            const TierState& state = _tiers[static_cast<size_t>(tier)];
+            if (state.count > 0)
+            {
+                return RowAt(tier, 0).start;
+            }
+            return (state.open.count > 0) ? state.openStart : 0;
+        }
+
+    private:
+
+        static constexpr size_t TIER_COUNT = static_cast<size_t>(Tier::_size);
+        static constexpr uint32_t TIER_PERIOD_S[TIER_COUNT] = { 60, 3600 };
+
+        static constexpr unsigned HEADER_BITS = 32 * (1 + Series);
+        static constexpr unsigned MAX_CODE_BITS = 4 + 32;
+        static constexpr unsigned MAX_RECORD_BITS = MAX_CODE_BITS * (1 + Series);
+        static constexpr uint64_t MAX_BLOCK_BITS = HEADER_BITS + static_cast<uint64_t>(SAMPLES_PER_BLOCK - 1) * MAX_RECORD_BITS;
+        static constexpr uint64_t MIN_BLOCK_BITS = HEADER_BITS + (SAMPLES_PER_BLOCK - 1) * (1 + Series);
+
+        // Room for the block being written plus a full one, whatever the data
+        static_assert(BitRing<RawBytes>::CAPACITY_BITS >= 2 * MAX_BLOCK_BITS, "Raw tier too small for two worst-case blocks");
+
+        //! Enough entries for a ring full of the smallest possible blocks
+        static constexpr size_t MAX_BLOCKS = static_cast<size_t>(BitRing<RawBytes>::CAPACITY_BITS / MIN_BLOCK_BITS) + 2;
+
+        struct BlockInfo
+        {
+            uint64_t startBit;
+            uint32_t firstTimestamp;
+            uint16_t count;
+        };
+
+        struct OpenBucket
+        {
+            uint32_t count = 0;
+            int32_t min[Series];
+            int32_t max[Series];
+            int64_t sum[Series];
+        };
+
+        struct TierState
+        {
+            size_t head = 0;
+            size_t count = 0;
+            uint32_t openStart = 0;
+            OpenBucket open;
+        };
+
+        static constexpr size_t TierCapacity(size_t tier) { return (tier == 0) ? MinuteBuckets : HourBuckets; }
+        static constexpr size_t TierOffset(size_t tier) { return (tier == 0) ? 0 : MinuteBuckets; }
+
+        //-----------------------------------------------------------------------------
+        const BlockInfo& BlockAt(size_t index) const { return _blocks[(_blockHead + index) % MAX_BLOCKS]; }
+        BlockInfo& Newest() { return _blocks[(_blockHead + _blockCount - 1) % MAX_BLOCKS]; }
+
+        //! Closed row of a tier by age, 0 the oldest
+        const Row& RowAt(Tier tier, size_t index) const
+        {
+            const TierState& state = _tiers[static_cast<size_t>(tier)];
+            const size_t capacity = TierCapacity(static_cast<size_t>(tier));
+            return _rows[TierOffset(static_cast<size_t>(tier)) + (state.head + capacity - state.count + index) % capacity];
+        }
+
+        //-----------------------------------------------------------------------------
+        void StartBlock(uint32_t timestamp, const Values& values)
+        {
+            if (_blockCount == MAX_BLOCKS)
+            {
+                DropOldestBlock();
+            }
+            MakeRoom(HEADER_BITS + MAX_RECORD_BITS);
+
+            _blocks[(_blockHead + _blockCount) % MAX_BLOCKS] = BlockInfo{ _writePosition, timestamp, 1 };
+            ++_blockCount;
+
+            WriteBits(timestamp, 32);
+            for (size_t s = 0; s < Series; ++s)
+            {
+                WriteBits(static_cast<uint32_t>(values[s]), 32);
+            }
+
+            _lastStep = 0;
+        }
+
+        //-----------------------------------------------------------------------------
+        void AppendToBlock(uint32_t timestamp, const Values& values)
+        {
+            MakeRoom(MAX_RECORD_BITS);
+
+            // Delta of delta: a steady rate costs one bit
+            const uint32_t step = timestamp - _lastTimestamp;
+            EncodeDelta(static_cast<int64_t>(step) - static_cast<int64_t>(_lastStep), timestamp);
+            _lastStep = step;
+
+            for (size_t s = 0; s < Series; ++s)
+            {
+                EncodeDelta(static_cast<int64_t>(values[s]) - _lastValues[s], static_cast<uint32_t>(values[s]));
+            }
+
+            ++Newest().count;
+        }
+
+        /**
+         * @brief Prefix code of a delta, by zigzag magnitude:
+         *        0 -> '0', 1-16 -> '10'+4, up to 272 -> '110'+8, up to 65808 -> '1110'+16,
+         *        anything else -> '1111' + the absolute 32-bit value.
+         */
+        void EncodeDelta(int64_t delta, uint32_t absolute)
+        {
+            const uint64_t zigzag = (delta >= 0) ? (static_cast<uint64_t>(delta) << 1) : ((static_cast<uint64_t>(-(delta + 1)) << 1) | 1);
+
+            if (zigzag == 0)
+            {
+                WriteBits(0b0, 1);
+            }
+            else if (zigzag <= SMALL_LIMIT)
+            {
+                WriteBits(0b10, 2);
+                WriteBits(static_cast<uint32_t>(zigzag - 1), 4);
+            }
+            else if (zigzag <= MEDIUM_LIMIT)
+            {
+                WriteBits(0b110, 3);
+                WriteBits(static_cast<uint32_t>(zigzag - SMALL_LIMIT - 1), 8);
+            }
+            else if (zigzag <= LARGE_LIMIT)
+            {
+                WriteBits(0b1110, 4);
+                WriteBits(static_cast<uint32_t>(zigzag - MEDIUM_LIMIT - 1), 16);
+            }
+            else
+            {
+                WriteBits(0b1111, 4);
+                WriteBits(absolute, 32);
+            }
+        }
+
+        /**
+         * @brief Decode one EncodeDelta() code.
+         * @return bool True for a delta, false for an absolute value (returned in 'value').
+         */
+        bool DecodeDelta(uint64_t& position, int64_t& value) const
+        {
+            unsigned ones = 0;
+            while (ones < 4 && _raw.Read(position, 1) == 1)
+            {
+                ++ones;
+                ++position;
+            }
+            if (ones < 4)
+            {
+                ++position;     // terminating 0
+            }
+
+            uint64_t zigzag = 0;
+            switch (ones)
+            {
+                case 0: zigzag = 0; break;
+                case 1: zigzag = _raw.Read(position, 4) + 1;                    position += 4;  break;
+                case 2: zigzag = _raw.Read(position, 8) + SMALL_LIMIT + 1;      position += 8;  break;
+                case 3: zigzag = _raw.Read(position, 16) + MEDIUM_LIMIT + 1;    position += 16; break;
+                default:
+                    value = static_cast<int32_t>(_raw.Read(position, 32));
+                    position += 32;
+                    return false;
+            }
+
+            value = ((zigzag & 1) == 0) ? static_cast<int64_t>(zigzag >> 1) : -static_cast<int64_t>(zigzag >> 1) - 1;
+            return true;
+        }
+
+        //-----------------------------------------------------------------------------
+        void WriteBits(uint32_t value, unsigned bits)
+        {
+            _raw.Write(_writePosition, value, bits);
+            _writePosition += bits;
+        }
+
+        //! Drop old blocks until 'bits' more fit without overwriting one still listed
+        void MakeRoom(uint64_t bits)
+        {
+            while (_blockCount > 1 && (_writePosition + bits - BlockAt(0).startBit) > BitRing<RawBytes>::CAPACITY_BITS)
+            {
+                DropOldestBlock();
+            }
+        }
+
+        void DropOldestBlock()
+        {
+            _rawCount -= BlockAt(0).count;
+            _blockHead = (_blockHead + 1) % MAX_BLOCKS;
+            --_blockCount;
+        }
+
+        //-----------------------------------------------------------------------------
+        void Accumulate(size_t tier, uint32_t timestamp, const Values& values)
+        {
+            TierState& state = _tiers[tier];
+            const uint32_t period = TIER_PERIOD_S[tier];
+            const uint32_t start = timestamp - (timestamp % period);
+
+            if (state.open.count > 0 && start != state.openStart)
+            {
+                const size_t capacity = TierCapacity(tier);
+                _rows[TierOffset(tier) + state.head] = CloseRow(state);
+                state.head = (state.head + 1) % capacity;
+                state.count = std::min(state.count + 1, capacity);
+                state.open.count = 0;
+            }
+
+            OpenBucket& open = state.open;
+            if (open.count == 0)
+            {
+                state.openStart = start;
+                for (size_t s = 0; s < Series; ++s)
+                {
+                    open.min[s] = values[s];
+                    open.max[s] = values[s];
+                    open.sum[s] = 0;
+                }
+            }
+
+            for (size_t s = 0; s < Series; ++s)
+            {
+                open.min[s] = std::min(open.min[s], values[s]);
+                open.max[s] = std::max(open.max[s], values[s]);
+                open.sum[s] += values[s];
+            }
+            ++open.count;
+        }
+
+        static Row CloseRow(const TierState& state)
+        {
+            Row row{};
+            row.start = state.openStart;
+            row.count = static_cast<uint16_t>(std::min<uint32_t>(state.open.count, std::numeric_limits<uint16_t>::max()));
+
+            for (size_t s = 0; s < Series; ++s)
+            {
+                row.series[s].min = Clamp16(state.open.min[s]);
+                row.series[s].max = Clamp16(state.open.max[s]);
+                row.series[s].avg = Clamp16(state.open.sum[s] / static_cast<int64_t>(state.open.count));
+            }
+
+            return row;
+        }
+
+        static int16_t Clamp16(int64_t value)
+        {
+            return static_cast<int16_t>(std::clamp<int64_t>(value, std::numeric_limits<int16_t>::min(), std::numeric_limits<int16_t>::max()));
+        }
+
+        // ---------------------------------------------
+
+        static constexpr uint64_t SMALL_LIMIT = 16;
+        static constexpr uint64_t MEDIUM_LIMIT = SMALL_LIMIT + 256;
+        static constexpr uint64_t LARGE_LIMIT = MEDIUM_LIMIT + 65536;
+
+        BitRing<RawBytes> _raw;
+        uint64_t _writePosition = 0;
+
+        BlockInfo _blocks[MAX_BLOCKS] = {};
+        size_t _blockHead = 0;
+        size_t _blockCount = 0;
+        size_t _rawCount = 0;
+
+        uint32_t _lastTimestamp = 0;
+        uint32_t _lastStep = 0;
+        Values _lastValues{};
+
+        TierState _tiers[TIER_COUNT];
+        Row _rows[MinuteBuckets + HourBuckets];
+};
+
+} // namespace TimeSeries
@@ -0,0 +1,125 @@
+/*!****************************************************************************
+ * @file    adc_sampler_bench.cpp
+ * @brief   AdcSampler on the host continuous ADC with the TDS and battery
+ *          channels: CPU time of the sampling task per second of sampling,
+ *          overflows, and the cost of a ReadVoltage() against the 64 oneshot
+ *          conversions TdsSensor used to make on every update. The host cannot
+ *          show the conversion time those block for on the target.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#include "bench/host_bench.h"
+
+#include "framework/drivers/analog_in.h"
+#include "host_bus.h"
+#include "include/config.h"
+#include "src/services/adc_sampler.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <dirent.h>
+#include <string>
+#include <thread>
+
+namespace {
+
+using Services::AdcSampler;
+
+static constexpr int SAMPLING_S = 10;
+static constexpr int ONESHOT_SAMPLES = 64;
+
+//-----------------------------------------------------------------------------
+//! Time on the CPU of the thread named 'name' (/proc/self/task/TID/schedstat), 0 if none
+uint64_t ThreadCpuNs(const char* name)
+{
+    uint64_t cpuNs = 0;
+    DIR* tasks = opendir("/proc/self/task");
+    if (tasks == nullptr)
+    {
+        return 0;
+    }
+
+    while (const dirent* entry = readdir(tasks))
+    {
+        const std::string dir = std::string("/proc/self/task/") + entry->d_name;
+
+        char comm[32] = {};
+        if (FILE* file = std::fopen((dir + "/comm").c_str(), "r"))
+        {
+            if (std::fgets(comm, sizeof(comm), file) == nullptr)
+            {
+                comm[0] = '\0';
+            }
+            std::fclose(file);
+        }
+        comm[std::strcspn(comm, "\n")] = '\0';
+
+        if (std::strcmp(comm, name) != 0)
+        {
+            continue;
+        }
+
+        if (FILE* file = std::fopen((dir + "/schedstat").c_str(), "r"))
+        {
+            unsigned long long ns = 0;
+            if (std::fscanf(file, "%llu", &ns) == 1)
+            {
+                cpuNs = ns;
+            }
+            std::fclose(file);
+        }
+    }
+
+    closedir(tasks);
+    return cpuNs;
+}
+
+} // namespace
+
+//-----------------------------------------------------------------------------
+int main()
+{
+    adc_channel_t tdsChannel = ADC_CHANNEL_0;
+    adc_channel_t batteryChannel = ADC_CHANNEL_0;
+    AnalogIn::PinToAdcChannel(Config::TDS_SENSOR_ADC_PIN, tdsChannel);
+    AnalogIn::PinToAdcChannel(Config::BATTERY_ADC_PIN, batteryChannel);
+    HostBus::SetAdcVoltage(tdsChannel, 0.45f);
+    HostBus::SetAdcVoltage(batteryChannel, 1.95f);
+
+    // Before the sampler owns the ADC: the blocking read TdsSensor made
+    double oneshotNs = 0.0;
+    {
+        AnalogIn tdsPin(Config::TDS_SENSOR_ADC_PIN);
+        oneshotNs = HostBench::NsPerCall(2000, [&tdsPin]() { HostBench::Keep(tdsPin.ReadVoltage(ONESHOT_SAMPLES)); });
+    }
+
+    AdcSampler* sampler = AdcSampler::GetInstance();
+    double readNs = 0.0;
+    uint64_t taskCpuNs = 0;
+    {
+        HostBench::QuietStdout quiet;
+
+        sampler->Init();
+        const AdcSampler::ChannelId tds = sampler->AddChannel(Config::TDS_SENSOR_ADC_PIN);
+        sampler->AddChannel(Config::BATTERY_ADC_PIN);
+
+        const uint64_t cpuAtStartNs = ThreadCpuNs("AdcSampler");
+        std::this_thread::sleep_for(std::chrono::seconds(SAMPLING_S));
+        taskCpuNs = ThreadCpuNs("AdcSampler") - cpuAtStartNs;
+
+        readNs = HostBench::NsPerCall(1000000, [sampler, tds]() { HostBench::Keep(sampler->ReadVoltage(tds)); });
+    }
+
+    std::printf("AdcSampler, 2 channels at %u Hz, %d s of sampling\n", static_cast<unsigned>(Config::ADC_SAMPLE_RATE_HZ), SAMPLING_S);
+    std::printf("  %-36s %.2f ms (%.3f%%)\n", "sampling task CPU per second",
+                static_cast<double>(taskCpuNs) / 1e6 / SAMPLING_S, static_cast<double>(taskCpuNs) / 1e7 / SAMPLING_S);
+    std::printf("  %-36s %u\n", "overflows", static_cast<unsigned>(sampler->GetOverflowCount()));
+    std::printf("  %-36s %.1f ns\n", "ReadVoltage()", readNs);
+    std::printf("  %-36s %.1f ns of host CPU\n", "64 oneshot conversions (AnalogIn)", oneshotNs);
+
+    // The sampling task never returns; leave without running static destructors under it
+    std::fflush(stdout);
+    std::_Exit(0);
+}
@@ -0,0 +1,164 @@
+/*!****************************************************************************
+ * @file    config_record_bench.cpp
+ * @brief   EEPROM cost of config changes on the simulated AT24C32: saving
+ *          through StorageService (binary record) against writing the whole
+ *          JSON document, as the config was saved before, for the same
+ *          config. Both go through the same EepromMemory driver; the times
+ *          include the write cycle of the last page, and for the first
+ *          record save the boot that makes it (EEPROM scan included).
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#include "bench/host_bench.h"
+
+#include "host/sim/eeprom_sim.h"
+#include "host_bus.h"
+#include "include/config.h"
+#include "src/services/memory/eeprom_memory.h"
+#include "src/services/memory/memory_config_data.h"
+#include "src/services/storage_service.h"
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <iterator>
+#include <string>
+
+namespace {
+
+using HostSim::At24c32;
+using Services::FeeddingScheduleList;
+using Services::FieldId;
+using Services::MemoryConfigData;
+using Services::StorageService;
+
+struct Cost
+{
+    uint32_t pages = 0;
+    uint32_t bytes = 0;
+    double ms = 0.0;
+};
+
+//-----------------------------------------------------------------------------
+MemoryConfigData Loaded()
+{
+    StorageService* storage = StorageService::GetInstance();
+    MemoryConfigData config;
+    #define X(type, id, name, key, def) config.name = storage->Get<type>(FieldId::id);
+    CONFIG_FIELDS
+    #undef X
+    return config;
+}
+
+//-----------------------------------------------------------------------------
+//! Page writes, bytes and time of 'write' on 'eeprom', until its last write cycle is over
+Cost Measure(At24c32& eeprom, const std::function<void()>& write)
+{
+    HostBus::AttachI2cDevice(I2C_NUM_0, Config::EEPROM_I2C_ADDRESS, &eeprom);
+
+    const uint32_t pages = eeprom.GetPageWrites();
+    const uint32_t bytes = eeprom.GetBytesWritten();
+    const uint64_t startNs = HostBench::NowNs();
+
+    write();
+    Services::EepromMemory::GetInstance()->WaitForWriteCompletion();
+
+    Cost cost;
+    cost.ms = static_cast<double>(HostBench::NowNs() - startNs) / 1e6;
+    cost.pages = eeprom.GetPageWrites() - pages;
+    cost.bytes = eeprom.GetBytesWritten() - bytes;
+    return cost;
+}
+
+//-----------------------------------------------------------------------------
+//! The same config as one JSON document with its terminator, at the start of the EEPROM
+Cost MeasureJson(At24c32& eeprom, const MemoryConfigData& config)
+{
+    return Measure(eeprom, [&config]()
+        {
+            const auto json = config.Serialize();
+            Services::EepromMemory::GetInstance()->WriteBytes(0, reinterpret_cast<const uint8_t*>(json.c_str()), json.size() + 1);
+        }
+    );
+}
+
+//-----------------------------------------------------------------------------
+void Report(const char* change, const Cost& json, const Cost& record)
+{
+    std::printf("  %-22s %3u pages %4u B %6.1f ms   %3u pages %4u B %6.1f ms\n", change,
+                static_cast<unsigned>(json.pages), static_cast<unsigned>(json.bytes), json.ms,
+                static_cast<unsigned>(record.pages), static_cast<unsigned>(record.bytes), record.ms);
+}
+
+} // namespace
+
+//-----------------------------------------------------------------------------
+int main()
+{
+    static At24c32 recordEeprom;
+    static At24c32 jsonEeprom;
+    StorageService* storage = StorageService::GetInstance();
+
+    struct Change
+    {
+        const char* name;
+        std::function<void()> apply;
+    };
+
+    const Change changes[] = {
+        { "temp min limit", [storage]() { storage->Set<float>(FieldId::TEMP_MIN, 21.5f); } },
+        { "add schedule entry", [storage]() { storage->SaveFeedingScheduleInStorage(8 * 60 + 30, 0, 2, true); } },
+        { "wifi credentials", [storage]()
+            {
+                Services::ConfigTransaction transaction;
+                storage->Set<std::string>(FieldId::WIFI_SSID, std::string("aquarium-network"));
+                storage->Set<std::string>(FieldId::WIFI_PASSWORD, std::string("a long enough passphrase"));
+            }
+        },
+        { "trend sensitivity", [storage]()
+            {
+                Services::ConfigTransaction transaction;
+                storage->Set<bool>(FieldId::TREND_ENABLED, true);
+                storage->Set<float>(FieldId::TEMP_RATE_LIMIT, 1.5f);
+                storage->Set<int>(FieldId::TDS_RATE_LIMIT, 80);
+                storage->Set<float>(FieldId::SPIKE_Z_SCORE, 4.0f);
+            }
+        },
+    };
+
+    Cost firstJson;
+    Cost firstRecord;
+    Cost json[std::size(changes)];
+    Cost record[std::size(changes)];
+    {
+        HostBench::QuietStdout quiet;
+
+        // A blank device: the defaults are saved at boot
+        firstRecord = Measure(recordEeprom, [storage]()
+            {
+                Services::EepromMemory::GetInstance()->Init();
+                storage->Init();
+            }
+        );
+        firstJson = MeasureJson(jsonEeprom, Loaded());
+
+        for (size_t i = 0; i < std::size(changes); ++i)
+        {
+            record[i] = Measure(recordEeprom, changes[i].apply);
+            json[i] = MeasureJson(jsonEeprom, Loaded());
+        }
+    }
+
+    std::printf("AT24C32, %u-byte pages, %llu ms write cycle\n", static_cast<unsigned>(At24c32::PAGE_SIZE),
+                static_cast<unsigned long long>(At24c32::WRITE_CYCLE_US / 1000));
+    std::printf("  %-22s %-26s   %s\n", "change", "JSON document", "StorageService record");
+    Report("first save (boot)", firstJson, firstRecord);
+    for (size_t i = 0; i < std::size(changes); ++i)
+    {
+        Report(changes[i].name, json[i], record[i]);
+    }
+
+    // The flush task, if write-behind is on, never returns
+    std::fflush(stdout);
+    std::_Exit(0);
+}
@@ -0,0 +1,109 @@
+/*!****************************************************************************
+ * @file    deferred_log_bench.cpp
+ * @brief   Cost in the caller of one log statement: ESP_LOGI formatting and
+ *          writing synchronously, a DeferredLog record, and a call filtered
+ *          out by the runtime level. Short messages and a 1 KB string. The
+ *          rendered output goes to /dev/null; the ring is drained between
+ *          batches, outside the timed part.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#include "bench/host_bench.h"
+
+#include "esp_log.h"
+#include "framework/os/deferred_log.h"
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <string>
+
+namespace {
+
+static constexpr const char* TAG = "bench";
+static constexpr const char* QUIET_TAG = "bench_quiet";
+static constexpr int CALLS = 20000;
+static constexpr uint32_t UART_BAUD = 115200;
+
+//-----------------------------------------------------------------------------
+//! Time per record, writing 'batch' records at a time into a drained ring
+template <typename Function>
+double DeferredNsPerCall(int batch, Function&& write)
+{
+    std::array<double, HostBench::ROUNDS> rounds{};
+    for (double& round : rounds)
+    {
+        uint64_t writingNs = 0;
+        for (int done = 0; done < CALLS; done += batch)
+        {
+            DeferredLog::Flush();
+
+            const uint64_t startNs = HostBench::NowNs();
+            for (int i = 0; i < batch; ++i)
+            {
+                write(i);
+            }
+            writingNs += HostBench::NowNs() - startNs;
+        }
+        round = static_cast<double>(writingNs) / CALLS;
+    }
+
+    std::sort(rounds.begin(), rounds.end());
+    return rounds[HostBench::ROUNDS / 2];
+}
+
+} // namespace
+
+//-----------------------------------------------------------------------------
+int main()
+{
+    const std::string payload(DeferredLog::MAX_STRING_LENGTH - 1, 'x');
+    static DeferredLog::Site shortSite(TAG, "reading %d: %.2f C [%s]", ESP_LOG_INFO);
+    static DeferredLog::Site longSite(TAG, "payload %s", ESP_LOG_INFO);
+    static DeferredLog::Site quietSite(QUIET_TAG, "reading %d: %.2f C [%s]", ESP_LOG_INFO);
+
+    esp_log_level_set(TAG, ESP_LOG_INFO);
+    DeferredLog::SetLevel(QUIET_TAG, ESP_LOG_WARN);
+
+    double logShort = 0.0;
+    double logLong = 0.0;
+    double deferredShort = 0.0;
+    double deferredLong = 0.0;
+    double filtered = 0.0;
+    {
+        HostBench::QuietStdout quiet;
+
+        logShort = HostBench::NsPerCall(CALLS, []() { ESP_LOGI(TAG, "reading %d: %.2f C [%s]", 7, 25.5, "main"); });
+        logLong = HostBench::NsPerCall(CALLS, [&payload]() { ESP_LOGI(TAG, "payload %s", payload.c_str()); });
+
+        // A batch fits the ring: nothing is dropped while timing
+        deferredShort = DeferredNsPerCall(64, [](int i) { DeferredLog::Write(shortSite, i, 25.5, "main"); });
+        deferredLong = DeferredNsPerCall(4, [&payload](int) { DeferredLog::Write(longSite, payload.c_str()); });
+
+        filtered = HostBench::NsPerCall(CALLS, []()
+            {
+                if (DeferredLog::IsEnabled(quietSite))
+                {
+                    DeferredLog::Write(quietSite, 7, 25.5, "main");
+                }
+            }
+        );
+
+        DeferredLog::Flush();
+    }
+
+    const DeferredLog::Stats stats = DeferredLog::GetStats();
+
+    std::printf("ns per call in the caller, output to /dev/null (median of %zu rounds)\n", HostBench::ROUNDS);
+    std::printf("  %-28s %8.1f\n", "ESP_LOGI short", logShort);
+    std::printf("  %-28s %8.1f\n", "ESP_LOGI 1 KB string", logLong);
+    std::printf("  %-28s %8.1f\n", "deferred short", deferredShort);
+    std::printf("  %-28s %8.1f\n", "deferred 1 KB string", deferredLong);
+    std::printf("  %-28s %8.1f\n", "filtered by level", filtered);
+    std::printf("records written %u, dropped %u, ring peak %zu of %zu bytes\n",
+                static_cast<unsigned>(stats.written), static_cast<unsigned>(stats.dropped), stats.peakUsed, DeferredLog::BUFFER_SIZE);
+    std::printf("a synchronous 1 KB line on a %u baud UART: %.0f ms (10 bits per byte)\n",
+                static_cast<unsigned>(UART_BAUD), (DeferredLog::MAX_STRING_LENGTH * 10.0 * 1000.0) / UART_BAUD);
+
+    return 0;
+}
@@ -0,0 +1,110 @@
+/*!****************************************************************************
+ * @file    dsp_filter_bench.cpp
+ * @brief   Cost per sample of each DSP stage, of the Hampel(5) + MovingAverage(12)
+ *          chain the temperature and TDS readings run, and of the 12-entry
+ *          buffer re-summed on every sample that the chain replaced.
+ *          Input: a noisy DS18B20 raw reading with an occasional spike.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#include "bench/host_bench.h"
+
+#include "framework/dsp/ema.h"
+#include "framework/dsp/filter_chain.h"
+#include "framework/dsp/hampel_filter.h"
+#include "framework/dsp/kalman_filter.h"
+#include "framework/dsp/median_filter.h"
+#include "framework/dsp/moving_average.h"
+#include <cstdio>
+#include <random>
+#include <vector>
+
+namespace {
+
+static constexpr size_t SAMPLES = 1 << 16;
+static constexpr size_t PASSES = 16;
+
+//-----------------------------------------------------------------------------
+//! The average the sensors kept before the filter chain: a ring re-summed on every sample
+class ResummedAverage
+{
+    public:
+
+        float Process(float sample)
+        {
+            _samples[_next] = sample;
+            _next = (_next + 1) % COUNT;
+            _count += (_count < COUNT) ? 1 : 0;
+
+            float sum = 0.0f;
+            for (size_t i = 0; i < _count; ++i)
+            {
+                sum += _samples[i];
+            }
+            return sum / static_cast<float>(_count);
+        }
+
+    private:
+
+        static constexpr size_t COUNT = 12;
+
+        float _samples[COUNT] = {};
+        size_t _next = 0;
+        size_t _count = 0;
+};
+
+//-----------------------------------------------------------------------------
+std::vector<float> MakeInput()
+{
+    std::mt19937 random(2026);
+    std::normal_distribution<float> noise(0.0f, 1.5f);
+    std::uniform_int_distribution<int> spike(0, 199);
+
+    // 25 C in 1/16 C steps, plus the odd 85 C power-on reading
+    std::vector<float> input(SAMPLES);
+    for (float& sample : input)
+    {
+        sample = (spike(random) == 0) ? 85.0f * 16.0f : 400.0f + noise(random);
+    }
+    return input;
+}
+
+//-----------------------------------------------------------------------------
+template <typename Filter>
+void Report(const char* name, const std::vector<float>& input, Filter filter = Filter{})
+{
+    const double ns = HostBench::NsPerCall(PASSES, [&filter, &input]()
+        {
+            float last = 0.0f;
+            for (const float sample : input)
+            {
+                last = filter.Process(sample);
+            }
+            HostBench::Keep(last);
+        }
+    ) / SAMPLES;
+
+    std::printf("  %-28s %7.1f\n", name, ns);
+}
+
+} // namespace
+
+//-----------------------------------------------------------------------------
+int main()
+{
+    const std::vector<float> input = MakeInput();
+
+    std::printf("ns per sample, %zu samples (median of %zu rounds)\n", SAMPLES, HostBench::ROUNDS);
+    Report<Dsp::MovingAverage<float, 12>>("moving average(12)", input);
+    Report<Dsp::MedianFilter<float, 5>>("median(5)", input);
+    Report<Dsp::MedianFilter<float, 31>>("median(31)", input);
+    Report<Dsp::HampelFilter<float, 5>>("hampel(5)", input);
+    Report<Dsp::HampelFilter<float, 31>>("hampel(31)", input);
+    Report<Dsp::Ema<float>>("ema", input);
+    Report<Dsp::KalmanFilter<float>>("kalman", input);
+    Report<Dsp::FilterChain<Dsp::HampelFilter<float, 5>, Dsp::MovingAverage<float, 12>>>("hampel(5) + average(12)", input);
+    Report<ResummedAverage>("previous 12-entry re-sum", input);
+
+    return 0;
+}
@@ -0,0 +1,190 @@
+/*!****************************************************************************
+ * @file    eeprom_bench.cpp
+ * @brief   StorageService on the simulated AT24C32 (per-byte wire time, 5 ms
+ *          write cycle) with a journal of 40 records: the boot (EepromMemory
+ *          and StorageService Init, in a fresh process each time) and three
+ *          kinds of save, each until its last write cycle is over. For
+ *          comparison, the fixed 10 ms per page the driver used to sleep is
+ *          given for the pages each save writes.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#include "bench/host_bench.h"
+
+#include "host/sim/eeprom_sim.h"
+#include "host_bus.h"
+#include "include/config.h"
+#include "src/services/memory/eeprom_memory.h"
+#include "src/services/storage_service.h"
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace {
+
+using HostSim::At24c32;
+using Services::FieldId;
+using Services::StorageService;
+
+static constexpr int JOURNAL_RECORDS = 40;
+static constexpr int RUNS = 20;
+static constexpr double FIXED_WAIT_MS = 10.0;               //!< What the driver used to sleep after every page
+
+char s_eepromPath[] = "/tmp/eeprom_bench_XXXXXX";
+
+//-----------------------------------------------------------------------------
+//! 'body' in a child process on the EEPROM image, as after a power cycle; returns what 'body' returns
+uint64_t PowerCycle(const std::function<uint64_t(At24c32&)>& body)
+{
+    int result[2];
+    if (pipe(result) != 0)
+    {
+        std::exit(1);
+    }
+    std::fflush(stdout);
+
+    const pid_t pid = fork();
+    if (pid == 0)
+    {
+        close(result[0]);
+        At24c32* eeprom = nullptr;
+        {
+            HostBench::QuietStdout quiet;
+            static At24c32 image(s_eepromPath);
+            eeprom = &image;
+        }
+        HostBus::AttachI2cDevice(I2C_NUM_0, Config::EEPROM_I2C_ADDRESS, eeprom);
+
+        const uint64_t value = body(*eeprom);
+        const ssize_t written = write(result[1], &value, sizeof(value));
+
+        std::fflush(stdout);
+        std::_Exit((written == sizeof(value)) ? 0 : 1);
+    }
+
+    close(result[1]);
+    uint64_t value = 0;
+    if (read(result[0], &value, sizeof(value)) != sizeof(value))
+    {
+        value = 0;
+    }
+    close(result[0]);
+
+    int status = 0;
+    waitpid(pid, &status, 0);
+    return value;
+}
+
+//-----------------------------------------------------------------------------
+void Boot()
+{
+    HostBench::QuietStdout quiet;
+    Services::EepromMemory::GetInstance()->Init();
+    StorageService::GetInstance()->Init();
+}
+
+//-----------------------------------------------------------------------------
+//! Average time and pages of 'save' over RUNS, until the last write cycle is over
+void ReportSave(At24c32& eeprom, const char* name, const std::function<void(int)>& save)
+{
+    const uint32_t pages = eeprom.GetPageWrites();
+    uint64_t totalNs = 0;
+
+    for (int run = 0; run < RUNS; ++run)
+    {
+        HostBench::QuietStdout quiet;
+        const uint64_t startNs = HostBench::NowNs();
+        save(run);
+        Services::EepromMemory::GetInstance()->WaitForWriteCompletion();
+        totalNs += HostBench::NowNs() - startNs;
+    }
+
+    const double pagesPerSave = static_cast<double>(eeprom.GetPageWrites() - pages) / RUNS;
+    std::printf("  %-24s %7.1f ms %5.1f pages   fixed waits alone %5.0f ms\n", name,
+                static_cast<double>(totalNs) / 1e6 / RUNS, pagesPerSave, pagesPerSave * FIXED_WAIT_MS);
+}
+
+} // namespace
+
+//-----------------------------------------------------------------------------
+int main()
+{
+    const int fd = mkstemp(s_eepromPath);
+    if (fd < 0)
+    {
+        return 1;
+    }
+    close(fd);
+    std::remove(s_eepromPath);
+
+    // A journal of JOURNAL_RECORDS saves
+    PowerCycle([](At24c32&) -> uint64_t
+        {
+            Boot();
+            HostBench::QuietStdout quiet;
+            for (int i = 0; i < JOURNAL_RECORDS; ++i)
+            {
+                StorageService::GetInstance()->Set<float>(FieldId::TEMP_MAX, 25.0f + 0.1f * static_cast<float>(i));
+            }
+            Services::EepromMemory::GetInstance()->WaitForWriteCompletion();
+            return 0;
+        }
+    );
+
+    std::printf("AT24C32 at %u kHz, journal of %d records, average of %d runs\n",
+                static_cast<unsigned>(Config::EEPROM_I2C_FREQ_HZ / 1000), JOURNAL_RECORDS, RUNS);
+
+    uint64_t bootNs = 0;
+    for (int run = 0; run < RUNS; ++run)
+    {
+        bootNs += PowerCycle([](At24c32&) -> uint64_t
+            {
+                const uint64_t startNs = HostBench::NowNs();
+                Boot();
+                return HostBench::NowNs() - startNs;
+            }
+        );
+    }
+    const uint64_t bootBytes = PowerCycle([](At24c32& eeprom) -> uint64_t
+        {
+            Boot();
+            return eeprom.GetBytesRead();
+        }
+    );
+    std::printf("  %-24s %7.1f ms %5llu bytes read\n", "boot", static_cast<double>(bootNs) / 1e6 / RUNS,
+                static_cast<unsigned long long>(bootBytes));
+
+    PowerCycle([](At24c32& eeprom) -> uint64_t
+        {
+            Boot();
+            StorageService* storage = StorageService::GetInstance();
+
+            ReportSave(eeprom, "save temp min limit", [storage](int run)
+                {
+                    storage->Set<float>(FieldId::TEMP_MIN, 20.0f + 0.1f * static_cast<float>(run));
+                }
+            );
+            ReportSave(eeprom, "save four temp fields", [storage](int run)
+                {
+                    Services::ConfigTransaction transaction;
+                    storage->Set<float>(FieldId::TEMP_MIN, 19.0f + 0.1f * static_cast<float>(run));
+                    storage->Set<bool>(FieldId::TEMP_MIN_ENABLED, (run % 2) == 0);
+                    storage->Set<float>(FieldId::TEMP_MAX, 27.0f + 0.1f * static_cast<float>(run));
+                    storage->Set<bool>(FieldId::TEMP_MAX_ENALED, (run % 2) != 0);
+                }
+            );
+            ReportSave(eeprom, "save schedule change", [storage](int run)
+                {
+                    storage->SaveFeedingScheduleInStorage(8 * 60 + run, run % 4, 1 + run % 3, true);
+                }
+            );
+            return 0;
+        }
+    );
+
+    std::remove(s_eepromPath);
+    return 0;
+}
@@ -0,0 +1,157 @@
+/*!****************************************************************************
+ * @file    history_query_bench.cpp
+ * @brief   getHistory queries over 12 days of history: a reading every 2 s
+ *          into ReadingHistory and a minute sample into the flash HistoryLog
+ *          (compacted by its task as it fills), then a 24 h window queried at
+ *          several ages and resolutions, chunk by chunk as the RPC streams it.
+ *          Also a single ForEach scan of a flash window, for comparison.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#include "bench/host_bench.h"
+
+#include "include/config.h"
+#include "src/services/history_log.h"
+#include "src/services/history_query.h"
+#include "src/services/reading_history.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <string>
+#include <thread>
+
+//-----------------------------------------------------------------------------
+// The history stamps records with time(): the bench sets the wall clock
+
+static time_t s_now = 0;
+
+extern "C" time_t time(time_t* out)
+{
+    if (out != nullptr)
+    {
+        *out = s_now;
+    }
+    return s_now;
+}
+
+namespace {
+
+using Services::HistoryLog;
+using Services::HistoryQuery;
+using Services::ReadingHistory;
+
+static constexpr uint32_t START = 1767225600;       // 2026-01-01 00:00:00
+static constexpr uint32_t PERIOD_S = 2;             // WATER_MONITOR_PERIOD_MS
+static constexpr uint32_t DAY_S = 24 * 3600;
+static constexpr uint32_t DAYS = 12;
+static constexpr uint32_t END = START + DAYS * DAY_S;
+static constexpr size_t CHUNK = Config::HISTORY_RPC_CHUNK_POINTS;
+
+//-----------------------------------------------------------------------------
+// As the water monitor does: every reading to RAM, one a minute to flash. The
+// log task is given the time to write its pages, so that none are dropped
+void RecordDays()
+{
+    for (uint32_t t = START; t < END; t += PERIOD_S)
+    {
+        s_now = t;
+        const float temperature = 25.0f + static_cast<float>((t / 60) % 240) * 0.005f;
+        const int tds = 200 + static_cast<int>((t / 3600) % 24);
+        const ReadingHistory::Values values = ReadingHistory::ToValues(temperature, tds, 4.0f);
+        ReadingHistory::GetInstance()->Record(values);
+        HistoryLog::GetInstance()->RecordSample(values);
+
+        if (t % 60 == 0)
+        {
+            // Erases and compactions come with the hourly records
+            std::this_thread::sleep_for(std::chrono::milliseconds((t % 3600 == 0) ? 50 : 1));
+        }
+    }
+    s_now = END;
+}
+
+//-----------------------------------------------------------------------------
+std::string PlanOf(const HistoryQuery& query)
+{
+    std::string plan;
+    for (size_t i = 0; i < query.GetPieceCount(); ++i)
+    {
+        plan += (i == 0) ? "" : " + ";
+        plan += HistoryQuery::GetSourceName(query.GetPiece(i).source);
+    }
+    return plan;
+}
+
+//-----------------------------------------------------------------------------
+void Query(const char* name, uint32_t daysAgo, uint32_t resolution)
+{
+    const uint32_t to = END - 1 - daysAgo * DAY_S;
+    const uint32_t from = to - DAY_S + 1;
+
+    size_t points = 0;
+    size_t chunks = 0;
+    std::string plan;
+    const double ns = HostBench::NsPerCall(3, [&]()
+        {
+            HistoryQuery query(HistoryQuery::Series::TEMPERATURE, from, to, resolution);
+            HistoryQuery::Point buffer[CHUNK];
+
+            points = 0;
+            chunks = 0;
+            size_t count = 0;
+            while ((count = query.Next(buffer, CHUNK)) > 0)
+            {
+                points += count;
+                ++chunks;
+            }
+            plan = PlanOf(query);
+        }
+    );
+
+    std::printf("  %-26s %9.3f ms %6zu points %4zu chunks  %s\n", name, ns / 1e6, points, chunks, plan.c_str());
+}
+
+} // namespace
+
+//-----------------------------------------------------------------------------
+int main()
+{
+    {
+        HostBench::QuietStdout quiet;
+
+        ReadingHistory::GetInstance()->Init();
+        HistoryLog::GetInstance()->Init();
+        RecordDays();
+        HistoryLog::GetInstance()->Flush();
+        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    }
+
+    const HistoryLog::Stats stats = HistoryLog::GetInstance()->GetStats();
+    std::printf("%u days recorded: %u flash pages written, %u segments erased, %u compactions, %u records dropped\n",
+                static_cast<unsigned>(DAYS), static_cast<unsigned>(stats.pagesWritten), static_cast<unsigned>(stats.segmentsErased),
+                static_cast<unsigned>(stats.compactions), static_cast<unsigned>(stats.droppedRecords));
+
+    std::printf("24 h temperature window, query and aggregation (median of %zu rounds)\n", HostBench::ROUNDS);
+    Query("ending now, res 60", 0, 60);
+    Query("ending now, res 3600", 0, 3600);
+    Query("ending now, res 1", 0, 1);
+    Query("6 days ago, res 60", 6, 60);
+    Query("8 days ago, res 3600", 8, 3600);
+
+    // The flash samples of the 6-days-ago window, in one pass
+    const uint32_t to = END - 1 - 6 * DAY_S;
+    size_t records = 0;
+    const double scanNs = HostBench::NsPerCall(3, [&records, to]()
+        {
+            records = HistoryLog::GetInstance()->ForEach(HistoryLog::RecordType::SAMPLE, to - DAY_S + 1, to,
+                                                         [](const HistoryLog::Record& record) { HostBench::Keep(record.timestamp); });
+        }
+    );
+    std::printf("  %-26s %9.3f ms %6zu records\n", "ForEach, same flash window", scanNs / 1e6, records);
+
+    // The log's writer task never returns; leave without running static destructors under it
+    std::fflush(stdout);
+    std::_Exit(0);
+}
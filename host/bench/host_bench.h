@@ -0,0 +1,89 @@
+/*!****************************************************************************
+ * @file    host_bench.h
+ * @brief   Timing helpers for the host benchmarks (host/bench/NAME_bench.cpp):
+ *          each bench is its own executable, built with the tests but not run
+ *          by ctest, that prints its measurements. Numbers are only meaningful
+ *          from an optimized build (-DCMAKE_BUILD_TYPE=RelWithDebInfo).
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <unistd.h>
+
+namespace HostBench {
+
+static constexpr size_t ROUNDS = 7;
+
+//! Keeps the compiler from dropping a result nobody reads
+template <typename T>
+inline void Keep(const T& value)
+{
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+inline uint64_t NowNs()
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+//-----------------------------------------------------------------------------
+//! Median over ROUNDS of the time per call of 'calls' back-to-back calls
+template <typename Function>
+double NsPerCall(uint64_t calls, Function&& function)
+{
+    std::array<double, ROUNDS> rounds{};
+    for (double& round : rounds)
+    {
+        const uint64_t startNs = NowNs();
+        for (uint64_t i = 0; i < calls; ++i)
+        {
+            function();
+        }
+        round = static_cast<double>(NowNs() - startNs) / static_cast<double>(calls);
+    }
+
+    std::sort(rounds.begin(), rounds.end());
+    return rounds[ROUNDS / 2];
+}
+
+//-----------------------------------------------------------------------------
+//! Sends stdout to /dev/null for the lifetime of the scope (what the code under test prints)
+class QuietStdout
+{
+    public:
+
+        QuietStdout()
+        {
+            std::fflush(stdout);
+            _saved = dup(STDOUT_FILENO);
+            if (FILE* null = std::fopen("/dev/null", "w"))
+            {
+                dup2(fileno(null), STDOUT_FILENO);
+                std::fclose(null);
+            }
+        }
+
+        ~QuietStdout()
+        {
+            std::fflush(stdout);
+            dup2(_saved, STDOUT_FILENO);
+            close(_saved);
+        }
+
+        QuietStdout(const QuietStdout&) = delete;
+        QuietStdout& operator=(const QuietStdout&) = delete;
+
+    private:
+
+        int _saved = -1;
+};
+
+} // namespace HostBench
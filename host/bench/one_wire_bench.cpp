@@ -0,0 +1,78 @@
+/*!****************************************************************************
+ * @file    one_wire_bench.cpp
+ * @brief   Scratchpad reads (reset, SKIP ROM, READ SCRATCHPAD, 9 bytes)
+ *          against the simulated DS18B20 on whichever 1-Wire backend the host
+ *          was built with (RMT by default, -DHOST_ONE_WIRE_RMT=OFF for the
+ *          bit-banged one): reads with a valid CRC, the critical sections
+ *          each read takes and the wall time per read.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#include "bench/host_bench.h"
+
+#include "framework/drivers/one_wire.h"
+#include "host/sim/one_wire_sim.h"
+#include "host_bus.h"
+#include <cstdint>
+#include <cstdio>
+
+namespace {
+
+static constexpr PinName BUS_PIN = PinName::P26;
+static constexpr uint32_t READS = 200;
+static constexpr uint8_t CMD_READ_SCRATCH = 0xBE;
+
+//-----------------------------------------------------------------------------
+bool ReadScratchpad(OneWire& bus)
+{
+    if (!bus.SkipRom())
+    {
+        return false;
+    }
+
+    uint8_t scratchpad[9] = {};
+    bus.WriteByte(CMD_READ_SCRATCH);
+    for (uint8_t& value : scratchpad)
+    {
+        value = bus.ReadByte();
+    }
+    return OneWire::Crc8(scratchpad, 8) == scratchpad[8];
+}
+
+} // namespace
+
+//-----------------------------------------------------------------------------
+int main()
+{
+    HostSim::OneWireBus wire;
+    HostSim::Ds18b20 probe(0x0000A1B2C3D4ULL);
+    wire.AddDevice(&probe);
+    HostBus::AttachGpioDevice(static_cast<gpio_num_t>(BUS_PIN), &wire);
+
+    OneWire bus(BUS_PIN);
+
+    uint32_t good = 0;
+    HostBus::SetCriticalTiming(true);
+    HostBus::TakeCriticalStats();
+
+    const uint64_t startNs = HostBench::NowNs();
+    for (uint32_t i = 0; i < READS; ++i)
+    {
+        good += ReadScratchpad(bus) ? 1 : 0;
+    }
+    const uint64_t elapsedNs = HostBench::NowNs() - startNs;
+
+    const HostBus::CriticalStats critical = HostBus::TakeCriticalStats();
+    HostBus::SetCriticalTiming(false);
+
+    std::printf("1-Wire backend: %s, %u scratchpad reads\n", (ONE_WIRE_USE_RMT != 0) ? "RMT" : "bit-bang", static_cast<unsigned>(READS));
+    std::printf("  %-28s %u/%u\n", "reads with a valid CRC", static_cast<unsigned>(good), static_cast<unsigned>(READS));
+    std::printf("  %-28s %.1f\n", "critical sections per read", static_cast<double>(critical.sections) / READS);
+    std::printf("  %-28s %llu us\n", "longest critical section", static_cast<unsigned long long>(critical.longestUs));
+    std::printf("  %-28s %llu us\n", "critical time per read", static_cast<unsigned long long>(critical.totalUs / READS));
+    std::printf("  %-28s %llu us\n", "wall time per read", static_cast<unsigned long long>(elapsedNs / 1000 / READS));
+
+    HostBus::AttachGpioDevice(static_cast<gpio_num_t>(BUS_PIN), nullptr);
+    return 0;
+}
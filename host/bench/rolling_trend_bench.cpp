@@ -0,0 +1,113 @@
+/*!****************************************************************************
+ * @file    rolling_trend_bench.cpp
+ * @brief   Cost per sample of the WaterMonitor trend window
+ *          (RollingTrend<float, TREND_WINDOW_SAMPLES>: Process() then
+ *          GetSlope()) against recomputing mean, variance and slope over the
+ *          same window on every sample. The accuracy and the warning times
+ *          are printed by host/tests/rolling_trend_test.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#include "bench/host_bench.h"
+
+#include "framework/dsp/rolling_trend.h"
+#include "include/config.h"
+#include <cstdio>
+#include <random>
+#include <vector>
+
+namespace {
+
+static constexpr size_t WINDOW = Config::TREND_WINDOW_SAMPLES;
+static constexpr size_t SAMPLES = 20000;
+
+//-----------------------------------------------------------------------------
+//! Mean, variance and slope of the last WINDOW samples, from scratch
+class RecomputedTrend
+{
+    public:
+
+        float Process(float sample)
+        {
+            _samples[_next] = sample;
+            _next = (_next + 1) % WINDOW;
+            _count += (_count < WINDOW) ? 1 : 0;
+
+            const size_t oldest = (_count < WINDOW) ? 0 : _next;
+            const float n = static_cast<float>(_count);
+
+            float mean = 0.0f;
+            for (size_t i = 0; i < _count; ++i)
+            {
+                mean += _samples[(oldest + i) % WINDOW];
+            }
+            mean /= n;
+
+            const float meanX = (n - 1.0f) / 2.0f;
+            float variance = 0.0f;
+            float sxy = 0.0f;
+            float sxx = 0.0f;
+            for (size_t i = 0; i < _count; ++i)
+            {
+                const float deviation = _samples[(oldest + i) % WINDOW] - mean;
+                const float x = static_cast<float>(i) - meanX;
+                variance += deviation * deviation;
+                sxy += x * deviation;
+                sxx += x * x;
+            }
+
+            _variance = (_count < 2) ? 0.0f : variance / (n - 1.0f);
+            _slope = (sxx > 0.0f) ? sxy / sxx : 0.0f;
+            return mean;
+        }
+
+        float GetSlope() const { return _slope; }
+
+    private:
+
+        float _samples[WINDOW] = {};
+        size_t _next = 0;
+        size_t _count = 0;
+        float _variance = 0.0f;
+        float _slope = 0.0f;
+};
+
+//-----------------------------------------------------------------------------
+template <typename Trend>
+double NsPerSample(const std::vector<float>& input)
+{
+    return HostBench::NsPerCall(1, [&input]()
+        {
+            Trend trend;
+            float last = 0.0f;
+            for (const float sample : input)
+            {
+                trend.Process(sample);
+                last = trend.GetSlope();
+            }
+            HostBench::Keep(last);
+        }
+    ) / SAMPLES;
+}
+
+} // namespace
+
+//-----------------------------------------------------------------------------
+int main()
+{
+    // A noisy reading around 1000, as the TDS channel reads
+    std::mt19937 random(2026);
+    std::normal_distribution<float> noise(0.0f, 2.0f);
+    std::vector<float> input(SAMPLES);
+    for (float& sample : input)
+    {
+        sample = 1000.0f + noise(random);
+    }
+
+    std::printf("ns per sample, window %zu, %zu samples (median of %zu rounds)\n", WINDOW, SAMPLES, HostBench::ROUNDS);
+    std::printf("  %-36s %8.1f\n", "RollingTrend Process + GetSlope", NsPerSample<Dsp::RollingTrend<float, WINDOW>>(input));
+    std::printf("  %-36s %8.1f\n", "window recomputed on every sample", NsPerSample<RecomputedTrend>(input));
+
+    return 0;
+}
@@ -0,0 +1,118 @@
+/*!****************************************************************************
+ * @file    system_snapshot_bench.cpp
+ * @brief   What a UI refresh costs to read the device state on the full
+ *          firmware: the proxy fan-out UserInterface::OnUpdate used to make
+ *          (RTC over the simulated I2C bus, power mode and battery level,
+ *          feeder status, readings, limits, link states), the same fan-out
+ *          without the RTC, power and feeder calls, and one GetSnapshot(),
+ *          alone and while a writer publishes in a tight loop.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#include "bench/host_bench.h"
+
+#include "host/sim/board.h"
+#include "src/core/guardian_proxy.h"
+#include "src/core/smart_aquarium_guardian.h"
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+
+namespace {
+
+static constexpr int UPDATES = 20;
+
+//-----------------------------------------------------------------------------
+//! Everything but the bus and sensor I/O: the getters that only read RAM
+void ReadInMemory(Core::GuardianProxy* proxy)
+{
+    float minTemp = 0.0f;
+    float maxTemp = 0.0f;
+    int minTds = 0;
+    int maxTds = 0;
+    bool minEnabled = false;
+    bool maxEnabled = false;
+
+    HostBench::Keep(proxy->IsWifiConnected());
+    HostBench::Keep(proxy->IsMqttConnected());
+    HostBench::Keep(proxy->IsApPortalActive());
+    HostBench::Keep(proxy->GetTemperatureReading());
+    proxy->GetTemperatureLimits(minTemp, minEnabled, maxTemp, maxEnabled);
+    HostBench::Keep(proxy->IsTemperatureOutOfLimits());
+    HostBench::Keep(proxy->GetTdsReading());
+    proxy->GetTdsLimits(minTds, minEnabled, maxTds, maxEnabled);
+    HostBench::Keep(proxy->IsTdsOutOfLimits());
+    HostBench::Keep(minTemp + maxTemp + static_cast<float>(minTds + maxTds));
+}
+
+//-----------------------------------------------------------------------------
+void ReadAsUiDid(Core::GuardianProxy* proxy)
+{
+    Utils::DateTime now;
+    HostBench::Keep(proxy->GetDateTime(now));
+    ReadInMemory(proxy);
+    HostBench::Keep(proxy->GetFeederStatus().nextFeedDoses);
+    HostBench::Keep(proxy->GetCurrentMode());
+    HostBench::Keep(proxy->GetBatteryLevel());
+}
+
+} // namespace
+
+//-----------------------------------------------------------------------------
+int main()
+{
+    static HostSim::Board board(HostSim::Board::Options{});
+    board.Attach();
+
+    auto* guardian = SmartAquariumGuardian::GetInstance();
+    auto* proxy = Core::GuardianProxy::GetInstance();
+
+    double fanOutNs = 0.0;
+    double inMemoryNs = 0.0;
+    double snapshotNs = 0.0;
+    double contendedNs = 0.0;
+    uint64_t publications = 0;
+    {
+        HostBench::QuietStdout quiet;
+
+        // Every owner has published its section
+        guardian->Init();
+        for (int i = 0; i < UPDATES; ++i)
+        {
+            guardian->Update();
+        }
+
+        fanOutNs = HostBench::NsPerCall(200, [proxy]() { ReadAsUiDid(proxy); });
+        inMemoryNs = HostBench::NsPerCall(200000, [proxy]() { ReadInMemory(proxy); });
+        snapshotNs = HostBench::NsPerCall(200000, [proxy]() { HostBench::Keep(proxy->GetSnapshot().water.temperature); });
+
+        const Core::SystemSnapshot::Water water = proxy->GetSnapshot().water;
+        std::atomic<bool> writing{true};
+        std::thread writer([proxy, &water, &writing, &publications]()
+            {
+                while (writing.load(std::memory_order_relaxed))
+                {
+                    proxy->PublishWaterState(water);
+                    ++publications;
+                }
+            }
+        );
+        contendedNs = HostBench::NsPerCall(200000, [proxy]() { HostBench::Keep(proxy->GetSnapshot().water.temperature); });
+        writing = false;
+        writer.join();
+    }
+
+    std::printf("ns per read of the device state (median of %zu rounds)\n", HostBench::ROUNDS);
+    std::printf("  %-44s %10.0f\n", "proxy fan-out as UserInterface::OnUpdate did", fanOutNs);
+    std::printf("  %-44s %10.1f\n", "same fan-out without RTC/power/feeder calls", inMemoryNs);
+    std::printf("  %-44s %10.1f\n", "GetSnapshot()", snapshotNs);
+    std::printf("  %-44s %10.1f\n", "GetSnapshot() against a publishing writer", contendedNs);
+    std::printf("snapshot %zu bytes, %llu publications by the writer\n",
+                sizeof(Core::SystemSnapshot), static_cast<unsigned long long>(publications));
+
+    // Firmware tasks never return; leave without running static destructors under them
+    std::fflush(stdout);
+    std::_Exit(0);
+}
@@ -0,0 +1,183 @@
+/*!****************************************************************************
+ * @file    main.cpp
+ * @brief   Host entry point: wires the simulated board and runs the firmware
+ *          super-loop on Linux for a bounded amount of time.
+ *
+ *          Usage: guardian_host [--seconds N] [--eeprom FILE] [--eeprom-cut BYTES] [--flash FILE]
+ *                               [--temp C] [--probes N] [--tds-volts V] [--battery]
+ *                               [--tds-replay FILE] [--battery-replay FILE]
+ *                               [--rpc AT_S JSON]... [--trace FILE]
+ *                               [--binary-log]
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#include "framework/os/deferred_log.h"
+#include "framework/os/trace.h"
+#include "host/sim/board.h"
+#include "host_net.h"
+#include "host_time.h"
+#include "src/core/smart_aquarium_guardian.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+//! RPC request the broker sends to the device at a given time
+struct ScheduledRpc
+{
+    double atSeconds;
+    std::string payload;
+};
+
+//-----------------------------------------------------------------------------
+void PrintUsage(const char* program)
+{
+    std::printf("Usage: %s [--seconds N] [--eeprom FILE] [--eeprom-cut BYTES] [--flash FILE] [--temp C] [--probes N] [--tds-volts V] [--battery] [--tds-replay FILE] [--battery-replay FILE] [--rpc AT_S JSON]... [--trace FILE] [--binary-log]\n", program);
+}
+
+//-----------------------------------------------------------------------------
+void DrainTrace(FILE* stream)
+{
+    char line[96];
+
+    Trace::Drain(SIZE_MAX, [stream, &line](const Trace::Event& event)
+        {
+            Trace::FormatEvent(event, line, sizeof(line));
+            std::fputs(line, stream);
+        }
+    );
+}
+
+} // namespace
+
+//-----------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+    double runSeconds = 30.0;
+    HostSim::Board::Options options;
+    std::vector<ScheduledRpc> rpcs;
+    FILE* traceFile = nullptr;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const bool hasValue = (i + 1 < argc);
+
+        if (std::strcmp(argv[i], "--seconds") == 0 && hasValue)
+        {
+            runSeconds = std::atof(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--eeprom") == 0 && hasValue)
+        {
+            options.eepromFile = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--eeprom-cut") == 0 && hasValue)
+        {
+            options.eepromPowerCutBytes = std::atoll(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--flash") == 0 && hasValue)
+        {
+            options.flashFile = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--temp") == 0 && hasValue)
+        {
+            options.waterTemperatureC = static_cast<float>(std::atof(argv[++i]));
+        }
+        else if (std::strcmp(argv[i], "--probes") == 0 && hasValue)
+        {
+            options.probeCount = static_cast<size_t>(std::atoi(argv[++i]));
+        }
+        else if (std::strcmp(argv[i], "--tds-volts") == 0 && hasValue)
+        {
+            options.tdsVoltage = static_cast<float>(std::atof(argv[++i]));
+        }
+        else if (std::strcmp(argv[i], "--tds-replay") == 0 && hasValue)
+        {
+            options.tdsReplayFile = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--battery-replay") == 0 && hasValue)
+        {
+            options.batteryReplayFile = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--rpc") == 0 && i + 2 < argc)
+        {
+            const double atSeconds = std::atof(argv[++i]);
+            rpcs.push_back(ScheduledRpc{ atSeconds, argv[++i] });
+        }
+        else if (std::strcmp(argv[i], "--trace") == 0 && hasValue)
+        {
+            traceFile = std::fopen(argv[++i], "w");
+            if (traceFile == nullptr)
+            {
+                std::perror(argv[i]);
+                return EXIT_FAILURE;
+            }
+        }
+        else if (std::strcmp(argv[i], "--binary-log") == 0)
+        {
+            DeferredLog::SetOutputMode(DeferredLog::OutputMode::BINARY);
+        }
+        else if (std::strcmp(argv[i], "--battery") == 0)
+        {
+            options.usbPowered = false;
+        }
+        else
+        {
+            PrintUsage(argv[0]);
+            return (std::strcmp(argv[i], "--help") == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+    }
+
+    // Devices must be on the buses before the firmware drivers probe them
+    static HostSim::Board board(options);
+    board.Attach();
+
+    DeferredLog::Start();
+
+    SmartAquariumGuardian::GetInstance()->Init();
+
+    const uint64_t startUs = HostTime::NowUs();
+    const uint64_t endUs = startUs + static_cast<uint64_t>(runSeconds * 1000000.0);
+    size_t rpcCount = 0;
+
+    while (HostTime::NowUs() < endUs)
+    {
+        SmartAquariumGuardian::GetInstance()->Update();
+
+        for (auto& rpc : rpcs)
+        {
+            if (!rpc.payload.empty() && HostTime::NowUs() >= startUs + static_cast<uint64_t>(rpc.atSeconds * 1000000.0))
+            {
+                const std::string topic = "v1/devices/me/rpc/request/" + std::to_string(++rpcCount);
+                std::printf("RPC      %s <- %s (%zu receivers)\n", topic.c_str(), rpc.payload.c_str(),
+                            HostNet::BrokerPublish(topic, rpc.payload));
+                rpc.payload.clear();
+            }
+        }
+
+        // Keep the trace rings empty so the file covers the whole run
+        if (traceFile != nullptr)
+        {
+            DrainTrace(traceFile);
+        }
+    }
+
+    DeferredLog::Flush();
+    board.PrintSummary();
+
+    if (traceFile != nullptr)
+    {
+        DrainTrace(traceFile);
+        std::fprintf(traceFile, "TRACE_DROPPED\t%u\n", static_cast<unsigned>(Trace::GetDroppedCount()));
+        std::fclose(traceFile);
+    }
+
+    // Firmware tasks never return; leave without running static destructors under them
+    std::fflush(stdout);
+    std::_Exit(EXIT_SUCCESS);
+}
@@ -0,0 +1,381 @@
+/*!****************************************************************************
+ * @file    adc.cpp
+ * @brief   Host implementation of the ADC oneshot, continuous and calibration
+ *          drivers. Raw codes follow the 12 dB range (0..3.1 V) with a little
+ *          noise, or come from a capture replayed on the channel. Continuous
+ *          frames are produced on their own thread at the configured rate.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#include "esp_adc/adc_cali_scheme.h"
+#include "esp_adc/adc_continuous.h"
+#include "esp_adc/adc_oneshot.h"
+#include "host_bus.h"
+#include "host_time.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+struct adc_oneshot_unit_ctx_t
+{
+    adc_unit_t unit;
+};
+
+struct adc_cali_scheme_t
+{
+    adc_atten_t atten;
+};
+
+struct adc_continuous_ctx_t
+{
+    adc_continuous_handle_cfg_t config;
+    std::vector<adc_digi_pattern_config_t> pattern;
+    uint32_t sampleFreqHz = 0;
+    adc_continuous_evt_cbs_t callbacks = {};
+    void* userData = nullptr;
+
+    std::mutex mutex;
+    std::condition_variable readable;
+    std::deque<uint8_t> pool;               //!< Stands in for the driver ring buffer
+    std::atomic<bool> running{false};
+    std::thread producer;
+};
+
+namespace {
+
+static constexpr float FULL_SCALE_VOLTS = 3.1f;
+static constexpr int MAX_RAW = 4095;
+static constexpr int NOISE_CODES = 8;
+
+std::mutex s_mutex;
+std::array<float, ADC_CHANNEL_9 + 1> s_channelVolts = {};
+std::array<std::vector<uint16_t>, ADC_CHANNEL_9 + 1> s_replay;
+std::array<size_t, ADC_CHANNEL_9 + 1> s_replayPosition = {};
+uint32_t s_noiseState = 0x12345678;
+
+//-----------------------------------------------------------------------------
+int NextNoiseLocked()
+{
+    s_noiseState = (s_noiseState * 1664525U) + 1013904223U;
+    return static_cast<int>((s_noiseState >> 16) % (2 * NOISE_CODES + 1)) - NOISE_CODES;
+}
+
+//-----------------------------------------------------------------------------
+int ConvertLocked(adc_channel_t channel)
+{
+    const std::vector<uint16_t>& replay = s_replay[channel];
+    if (!replay.empty())
+    {
+        const uint16_t code = replay[s_replayPosition[channel]];
+        s_replayPosition[channel] = (s_replayPosition[channel] + 1) % replay.size();
+        return std::min<int>(code, MAX_RAW);
+    }
+
+    const int raw = static_cast<int>((s_channelVolts[channel] / FULL_SCALE_VOLTS) * MAX_RAW) + NextNoiseLocked();
+    return std::clamp(raw, 0, MAX_RAW);
+}
+
+//-----------------------------------------------------------------------------
+void ProduceFrames(adc_continuous_ctx_t* ctx)
+{
+    const size_t resultsPerFrame = ctx->config.conv_frame_size / sizeof(adc_digi_output_data_t);
+    const uint64_t frameUs = (resultsPerFrame * 1000000ULL) / ctx->sampleFreqHz;
+
+    std::vector<uint8_t> frame(resultsPerFrame * sizeof(adc_digi_output_data_t));
+    size_t patternIndex = 0;
+    uint64_t deadlineUs = HostTime::NowUs();
+
+    while (ctx->running.load())
+    {
+        // The DMA hands over a frame once all of its conversions are done
+        deadlineUs += frameUs;
+        HostTime::SleepUntilUs(deadlineUs);
+
+        {
+            std::lock_guard<std::mutex> guard(s_mutex);
+            for (size_t i = 0; i < resultsPerFrame; ++i)
+            {
+                const adc_digi_pattern_config_t& step = ctx->pattern[patternIndex];
+                patternIndex = (patternIndex + 1) % ctx->pattern.size();
+
+                adc_digi_output_data_t result = {};
+                result.type1.channel = step.channel;
+                result.type1.data = ConvertLocked(static_cast<adc_channel_t>(step.channel));
+                std::copy_n(reinterpret_cast<const uint8_t*>(&result), sizeof(result), &frame[i * sizeof(result)]);
+            }
+        }
+
+        bool overflow = false;
+        {
+            std::lock_guard<std::mutex> guard(ctx->mutex);
+            if (ctx->pool.size() + frame.size() > ctx->config.max_store_buf_size)
+            {
+                overflow = true;
+                if (ctx->config.flags.flush_pool)
+                {
+                    ctx->pool.clear();
+                }
+            }
+
+            if (ctx->pool.size() + frame.size() <= ctx->config.max_store_buf_size)
+            {
+                ctx->pool.insert(ctx->pool.end(), frame.begin(), frame.end());
+            }
+        }
+        ctx->readable.notify_all();
+
+        const adc_continuous_evt_data_t event = { frame.data(), static_cast<uint32_t>(frame.size()) };
+        if (overflow && ctx->callbacks.on_pool_ovf != nullptr)
+        {
+            ctx->callbacks.on_pool_ovf(ctx, &event, ctx->userData);
+        }
+        if (ctx->callbacks.on_conv_done != nullptr)
+        {
+            ctx->callbacks.on_conv_done(ctx, &event, ctx->userData);
+        }
+    }
+}
+
+} // namespace
+
+//-----------------------------------------------------------------------------
+esp_err_t adc_oneshot_new_unit(const adc_oneshot_unit_init_cfg_t* initConfig, adc_oneshot_unit_handle_t* retUnit)
+{
+    if (initConfig == nullptr || retUnit == nullptr)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    adc_oneshot_unit_ctx_t* unit = new adc_oneshot_unit_ctx_t();
+    unit->unit = initConfig->unit_id;
+    *retUnit = unit;
+    return ESP_OK;
+}
+
+//-----------------------------------------------------------------------------
+esp_err_t adc_oneshot_config_channel(adc_oneshot_unit_handle_t handle, adc_channel_t channel, const adc_oneshot_chan_cfg_t* config)
+{
+    if (handle == nullptr || config == nullptr || channel > ADC_CHANNEL_9)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    return ESP_OK;
+}
+
+//-----------------------------------------------------------------------------
+esp_err_t adc_oneshot_read(adc_oneshot_unit_handle_t handle, adc_channel_t channel, int* outRaw)
+{
+    if (handle == nullptr || outRaw == nullptr || channel > ADC_CHANNEL_9)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    std::lock_guard<std::mutex> guard(s_mutex);
+    *outRaw = ConvertLocked(channel);
+    return ESP_OK;
+}
+
+//-----------------------------------------------------------------------------
+esp_err_t adc_oneshot_del_unit(adc_oneshot_unit_handle_t handle)
+{
+    delete handle;
+    return ESP_OK;
+}
+
+//-----------------------------------------------------------------------------
+esp_err_t adc_continuous_new_handle(const adc_continuous_handle_cfg_t* handleConfig, adc_continuous_handle_t* retHandle)
+{
+    if (handleConfig == nullptr || retHandle == nullptr
+     || handleConfig->conv_frame_size == 0 || handleConfig->conv_frame_size % sizeof(adc_digi_output_data_t) != 0
+     || handleConfig->max_store_buf_size < handleConfig->conv_frame_size)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    adc_continuous_ctx_t* ctx = new adc_continuous_ctx_t();
+    ctx->config = *handleConfig;
+    *retHandle = ctx;
+    return ESP_OK;
+}
+
+//-----------------------------------------------------------------------------
+esp_err_t adc_continuous_config(adc_continuous_handle_t handle, const adc_continuous_config_t* config)
+{
+    if (handle == nullptr || config == nullptr || config->pattern_num == 0 || config->sample_freq_hz == 0
+     || config->conv_mode != ADC_CONV_SINGLE_UNIT_1 || config->format != ADC_DIGI_OUTPUT_FORMAT_TYPE1)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (handle->running.load())
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    for (uint32_t i = 0; i < config->pattern_num; ++i)
+    {
+        if (config->adc_pattern[i].channel > ADC_CHANNEL_9 || config->adc_pattern[i].unit != ADC_UNIT_1)
+        {
+            return ESP_ERR_INVALID_ARG;
+        }
+    }
+
+    handle->pattern.assign(config->adc_pattern, config->adc_pattern + config->pattern_num);
+    handle->sampleFreqHz = config->sample_freq_hz;
+    return ESP_OK;
+}
+
+//-----------------------------------------------------------------------------
+esp_err_t adc_continuous_register_event_callbacks(adc_continuous_handle_t handle, const adc_continuous_evt_cbs_t* callbacks, void* userData)
+{
+    if (handle == nullptr || callbacks == nullptr)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (handle->running.load())
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    handle->callbacks = *callbacks;
+    handle->userData = userData;
+    return ESP_OK;
+}
+
+//-----------------------------------------------------------------------------
+esp_err_t adc_continuous_start(adc_continuous_handle_t handle)
+{
+    if (handle == nullptr)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (handle->running.load() || handle->pattern.empty())
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    handle->running.store(true);
+    handle->producer = std::thread(ProduceFrames, handle);
+    return ESP_OK;
+}
+
+//-----------------------------------------------------------------------------
+esp_err_t adc_continuous_read(adc_continuous_handle_t handle, uint8_t* buffer, uint32_t lengthMax, uint32_t* outLength, uint32_t timeoutMs)
+{
+    if (handle == nullptr || buffer == nullptr || outLength == nullptr)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    std::unique_lock<std::mutex> lock(handle->mutex);
+    const uint64_t deadlineUs = HostTime::NowUs() + (static_cast<uint64_t>(timeoutMs) * 1000ULL);
+    if (!HostTime::WaitUntil(handle->readable, lock, deadlineUs, [handle] { return !handle->pool.empty(); }))
+    {
+        *outLength = 0;
+        return ESP_ERR_TIMEOUT;
+    }
+
+    const size_t length = std::min<size_t>(lengthMax, handle->pool.size());
+    std::copy_n(handle->pool.begin(), length, buffer);
+    handle->pool.erase(handle->pool.begin(), handle->pool.begin() + length);
+
+    *outLength = static_cast<uint32_t>(length);
+    return ESP_OK;
+}
+
+//-----------------------------------------------------------------------------
+esp_err_t adc_continuous_stop(adc_continuous_handle_t handle)
+{
+    if (handle == nullptr)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (!handle->running.exchange(false))
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    handle->producer.join();
+    return ESP_OK;
+}
+
+//-----------------------------------------------------------------------------
+esp_err_t adc_continuous_deinit(adc_continuous_handle_t handle)
+{
+    if (handle == nullptr)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (handle->running.load())
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    delete handle;
+    return ESP_OK;
+}
+
+//-----------------------------------------------------------------------------
+esp_err_t adc_cali_create_scheme_line_fitting(const adc_cali_line_fitting_config_t* config, adc_cali_handle_t* retHandle)
+{
+    if (config == nullptr || retHandle == nullptr)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    adc_cali_scheme_t* scheme = new adc_cali_scheme_t();
+    scheme->atten = config->atten;
+    *retHandle = scheme;
+    return ESP_OK;
+}
+
+//-----------------------------------------------------------------------------
+esp_err_t adc_cali_delete_scheme_line_fitting(adc_cali_handle_t handle)
+{
+    delete handle;
+    return ESP_OK;
+}
+
+//-----------------------------------------------------------------------------
+esp_err_t adc_cali_raw_to_voltage(adc_cali_handle_t handle, int raw, int* voltage)
+{
+    if (handle == nullptr || voltage == nullptr)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    *voltage = (raw * static_cast<int>(FULL_SCALE_VOLTS * 1000.0f)) / MAX_RAW;
+    return ESP_OK;
+}
+
+//----HostBus------------------------------------------------------------------
+namespace HostBus {
+
+//-----------------------------------------------------------------------------
+void SetAdcVoltage(adc_channel_t channel, float volts)
+{
+    std::lock_guard<std::mutex> guard(s_mutex);
+    s_channelVolts[channel] = volts;
+}
+
+//-----------------------------------------------------------------------------
+void SetAdcReplay(adc_channel_t channel, std::vector<uint16_t> codes)
+{
+    std::lock_guard<std::mutex> guard(s_mutex);
+    s_replay[channel] = std::move(codes);
+    s_replayPosition[channel] = 0;
+}
+
+} // namespace HostBus
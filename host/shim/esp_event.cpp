@@ -0,0 +1,211 @@
+/*!****************************************************************************
+ * @file    esp_event.cpp
+ * @brief   Host implementation of the default event loop. Events are copied
+ *          into a queue and dispatched from a "sys_evt" task like on target.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#include "esp_event.h"
+#include "freertos/task.h"
+#include "host_time.h"
+
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+namespace {
+
+struct Handler
+{
+    esp_event_base_t base;
+    int32_t id;
+    esp_event_handler_t handler;
+    void* arg;
+    bool removed;
+};
+
+struct Event
+{
+    esp_event_base_t base;
+    int32_t id;
+    std::vector<uint8_t> data;
+};
+
+static constexpr size_t QUEUE_LENGTH = 32;
+
+std::mutex s_mutex;
+std::condition_variable s_cv;
+std::deque<Event> s_events;
+std::vector<Handler*> s_handlers;
+bool s_loopCreated = false;
+
+//-----------------------------------------------------------------------------
+bool Matches(const Handler& handler, esp_event_base_t base, int32_t id)
+{
+    const bool baseMatches = (handler.base == ESP_EVENT_ANY_BASE) || (handler.base == base);
+    const bool idMatches = (handler.id == ESP_EVENT_ANY_ID) || (handler.id == id);
+    return !handler.removed && baseMatches && idMatches;
+}
+
+//-----------------------------------------------------------------------------
+void EventTask(void* /*arg*/)
+{
+    std::unique_lock<std::mutex> lock(s_mutex);
+
+    while (true)
+    {
+        s_cv.wait(lock, []() { return !s_events.empty(); });
+
+        Event event = std::move(s_events.front());
+        s_events.pop_front();
+
+        // Handlers may (un)register from inside a callback; work on a snapshot
+        std::vector<Handler> handlers;
+        for (const Handler* handler : s_handlers)
+        {
+            if (Matches(*handler, event.base, event.id))
+            {
+                handlers.push_back(*handler);
+            }
+        }
+
+        lock.unlock();
+        for (const Handler& handler : handlers)
+        {
+            handler.handler(handler.arg, event.base, event.id, event.data.empty() ? nullptr : event.data.data());
+        }
+        lock.lock();
+
+        s_cv.notify_all();
+    }
+}
+
+//-----------------------------------------------------------------------------
+esp_err_t Register(esp_event_base_t eventBase, int32_t eventId, esp_event_handler_t eventHandler, void* eventHandlerArg, Handler** out)
+{
+    if (eventHandler == nullptr)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    std::lock_guard<std::mutex> guard(s_mutex);
+    if (!s_loopCreated)
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    Handler* handler = new Handler{eventBase, eventId, eventHandler, eventHandlerArg, false};
+    s_handlers.push_back(handler);
+
+    if (out != nullptr)
+    {
+        *out = handler;
+    }
+
+    return ESP_OK;
+}
+
+} // namespace
+
+//-----------------------------------------------------------------------------
+esp_err_t esp_event_loop_create_default(void)
+{
+    std::lock_guard<std::mutex> guard(s_mutex);
+    if (s_loopCreated)
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    s_loopCreated = true;
+    xTaskCreatePinnedToCore(&EventTask, "sys_evt", 2304, nullptr, 20, nullptr, 0);
+    return ESP_OK;
+}
+
+//-----------------------------------------------------------------------------
+esp_err_t esp_event_loop_delete_default(void)
+{
+    // The dispatcher task lives for the whole process on the host
+    return ESP_OK;
+}
+
+//-----------------------------------------------------------------------------
+esp_err_t esp_event_handler_register(esp_event_base_t eventBase, int32_t eventId, esp_event_handler_t eventHandler, void* eventHandlerArg)
+{
+    return Register(eventBase, eventId, eventHandler, eventHandlerArg, nullptr);
+}
+
+//-----------------------------------------------------------------------------
+esp_err_t esp_event_handler_unregister(esp_event_base_t eventBase, int32_t eventId, esp_event_handler_t eventHandler)
+{
+    std::lock_guard<std::mutex> guard(s_mutex);
+    for (Handler* handler : s_handlers)
+    {
+        if (handler->base == eventBase && handler->id == eventId && handler->handler == eventHandler)
+        {
+            handler->removed = true;
+        }
+    }
+
+    return ESP_OK;
+}
+
+//-----------------------------------------------------------------------------
+esp_err_t esp_event_handler_instance_register(esp_event_base_t eventBase,
+                                              int32_t eventId,
+                                              esp_event_handler_t eventHandler,
+                                              void* eventHandlerArg,
+                                              esp_event_handler_instance_t* instance)
+{
+    Handler* handler = nullptr;
+    const esp_err_t err = Register(eventBase, eventId, eventHandler, eventHandlerArg, &handler);
+
+    if (err == ESP_OK && instance != nullptr)
+    {
+        *instance = handler;
+    }
+
+    return err;
+}
+
+//-----------------------------------------------------------------------------
+esp_err_t esp_event_handler_instance_unregister(esp_event_base_t /*eventBase*/, int32_t /*eventId*/, esp_event_handler_instance_t instance)
+{
+    if (instance == nullptr)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    std::lock_guard<std::mutex> guard(s_mutex);
+    static_cast<Handler*>(instance)->removed = true;
+    return ESP_OK;
+}
+
+//-----------------------------------------------------------------------------
+esp_err_t esp_event_post(esp_event_base_t eventBase, int32_t eventId, const void* eventData, size_t eventDataSize, TickType_t ticksToWait)
+{
+    std::unique_lock<std::mutex> lock(s_mutex);
+    if (!s_loopCreated)
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    const uint64_t deadline = (ticksToWait == portMAX_DELAY) ? UINT64_MAX
+                                                              : HostTime::NowUs() + (pdTICKS_TO_MS(ticksToWait) * 1000ULL);
+    if (!HostTime::WaitUntil(s_cv, lock, deadline, []() { return s_events.size() < QUEUE_LENGTH; }))
+    {
+        return ESP_ERR_TIMEOUT;
+    }
+
+    Event event{eventBase, eventId, {}};
+    if (eventData != nullptr && eventDataSize > 0)
+    {
+        const uint8_t* bytes = static_cast<const uint8_t*>(eventData);
+        event.data.assign(bytes, bytes + eventDataSize);
+    }
+
+    s_events.push_back(std::move(event));
+    s_cv.notify_all();
+    return ESP_OK;
+}
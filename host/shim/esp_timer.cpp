@@ -0,0 +1,448 @@
+/*!****************************************************************************
+ * @file    esp_timer.cpp
+ * @brief   Host implementation of the virtual clock, esp_timer, ROM delays,
+ *          logging and the small esp_system surface.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#include "esp_err.h"
+#include "esp_log.h"
+#include "esp_rom_sys.h"
+#include "esp_system.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "host_time.h"
+
+#include <atomic>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct esp_timer
+{
+    esp_timer_cb_t callback;
+    void* arg;
+    std::string name;
+    uint64_t expiryUs = 0;
+    uint64_t periodUs = 0;
+    bool active = false;
+};
+
+namespace {
+
+const auto s_startTime = std::chrono::steady_clock::now();
+std::atomic<uint64_t> s_offsetUs{0};
+std::atomic<uint64_t> s_romDelayTotalUs{0};
+
+//! Timed waits never see Advance() directly; they poll in slices (see host_time.h)
+std::mutex s_sleepMutex;
+std::condition_variable s_sleepCv;
+
+//! esp_timer service state
+std::mutex s_timerMutex;
+std::condition_variable s_timerCv;
+std::vector<esp_timer*> s_timers;
+bool s_timerTaskStarted = false;
+
+//-----------------------------------------------------------------------------
+uint64_t RealUs()
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - s_startTime).count());
+}
+
+//-----------------------------------------------------------------------------
+esp_timer* NextExpiringLocked()
+{
+    esp_timer* next = nullptr;
+    for (esp_timer* timer : s_timers)
+    {
+        if (timer->active && (next == nullptr || timer->expiryUs < next->expiryUs))
+        {
+            next = timer;
+        }
+    }
+    return next;
+}
+
+//-----------------------------------------------------------------------------
+void TimerTask(void* /*arg*/)
+{
+    std::unique_lock<std::mutex> lock(s_timerMutex);
+
+    while (true)
+    {
+        esp_timer* next = NextExpiringLocked();
+        if (next == nullptr)
+        {
+            s_timerCv.wait(lock);
+            continue;
+        }
+
+        const uint64_t expiryUs = next->expiryUs;
+        if (HostTime::WaitUntil(s_timerCv, lock, expiryUs, [next, expiryUs]() {
+                return !next->active || next->expiryUs != expiryUs || NextExpiringLocked() != next;
+            }))
+        {
+            // Re-armed, stopped or pre-empted by an earlier timer: pick again
+            continue;
+        }
+
+        esp_timer_cb_t callback = next->callback;
+        void* arg = next->arg;
+
+        if (next->periodUs > 0)
+        {
+            // Keep the period grid; skip events that could not be handled in time
+            next->expiryUs += next->periodUs;
+            const uint64_t now = HostTime::NowUs();
+            if (next->expiryUs <= now)
+            {
+                next->expiryUs = now + next->periodUs;
+            }
+        }
+        else
+        {
+            next->active = false;
+        }
+
+        lock.unlock();
+        callback(arg);
+        lock.lock();
+    }
+}
+
+//-----------------------------------------------------------------------------
+void EnsureTimerTaskLocked()
+{
+    if (!s_timerTaskStarted)
+    {
+        s_timerTaskStarted = true;
+        xTaskCreatePinnedToCore(&TimerTask, "esp_timer", 4096, nullptr, 22, nullptr, 0);
+    }
+}
+
+//-----------------------------------------------------------------------------
+esp_err_t Arm(esp_timer_handle_t timer, uint64_t timeoutUs, uint64_t periodUs)
+{
+    if (timer == nullptr)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(s_timerMutex);
+        if (timer->active)
+        {
+            return ESP_ERR_INVALID_STATE;
+        }
+
+        EnsureTimerTaskLocked();
+        timer->expiryUs = HostTime::NowUs() + timeoutUs;
+        timer->periodUs = periodUs;
+        timer->active = true;
+    }
+
+    s_timerCv.notify_all();
+    return ESP_OK;
+}
+
+//! Log levels
+std::mutex s_logMutex;
+std::map<std::string, esp_log_level_t, std::less<>> s_tagLevels;    //!< Transparent: a lookup by tag builds no string
+
+//-----------------------------------------------------------------------------
+esp_log_level_t DefaultLogLevel()
+{
+    static const esp_log_level_t level = []() {
+        const char* env = std::getenv("HOST_LOG_LEVEL");
+        if (env == nullptr)
+        {
+            return ESP_LOG_INFO;
+        }
+
+        switch (env[0])
+        {
+            case 'N': return ESP_LOG_NONE;
+            case 'E': return ESP_LOG_ERROR;
+            case 'W': return ESP_LOG_WARN;
+            case 'D': return ESP_LOG_DEBUG;
+            case 'V': return ESP_LOG_VERBOSE;
+            default:  return ESP_LOG_INFO;
+        }
+    }();
+
+    return level;
+}
+
+} // namespace
+
+//----HostTime-----------------------------------------------------------------
+namespace HostTime {
+
+//-----------------------------------------------------------------------------
+uint64_t NowUs()
+{
+    return RealUs() + s_offsetUs.load(std::memory_order_acquire);
+}
+
+//-----------------------------------------------------------------------------
+void Advance(uint64_t deltaUs)
+{
+    s_offsetUs.fetch_add(deltaUs, std::memory_order_acq_rel);
+    s_sleepCv.notify_all();
+    s_timerCv.notify_all();
+}
+
+//-----------------------------------------------------------------------------
+uint64_t RomDelayTotalUs()
+{
+    return s_romDelayTotalUs.load(std::memory_order_acquire);
+}
+
+//-----------------------------------------------------------------------------
+void AdvanceRomDelay(uint64_t deltaUs)
+{
+    s_romDelayTotalUs.fetch_add(deltaUs, std::memory_order_acq_rel);
+}
+
+//-----------------------------------------------------------------------------
+void SleepUntilUs(uint64_t deadlineUs)
+{
+    std::unique_lock<std::mutex> lock(s_sleepMutex);
+    WaitUntil(s_sleepCv, lock, deadlineUs, [deadlineUs]() { return NowUs() >= deadlineUs; });
+}
+
+} // namespace HostTime
+
+//----esp_timer----------------------------------------------------------------
+int64_t esp_timer_get_time(void)
+{
+    return static_cast<int64_t>(HostTime::NowUs());
+}
+
+//-----------------------------------------------------------------------------
+esp_err_t esp_timer_create(const esp_timer_create_args_t* createArgs, esp_timer_handle_t* outHandle)
+{
+    if (createArgs == nullptr || createArgs->callback == nullptr || outHandle == nullptr)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    esp_timer* timer = new esp_timer();
+    timer->callback = createArgs->callback;
+    timer->arg = createArgs->arg;
+    timer->name = (createArgs->name != nullptr) ? createArgs->name : "timer";
+
+    {
+        std::lock_guard<std::mutex> guard(s_timerMutex);
+        s_timers.push_back(timer);
+    }
+
+    *outHandle = timer;
+    return ESP_OK;
+}
+
+//-----------------------------------------------------------------------------
+esp_err_t esp_timer_start_once(esp_timer_handle_t timer, uint64_t timeoutUs)
+{
+    return Arm(timer, timeoutUs, 0);
+}
+
+//-----------------------------------------------------------------------------
+esp_err_t esp_timer_start_periodic(esp_timer_handle_t timer, uint64_t periodUs)
+{
+    return Arm(timer, periodUs, periodUs);
+}
+
+//-----------------------------------------------------------------------------
+esp_err_t esp_timer_restart(esp_timer_handle_t timer, uint64_t timeoutUs)
+{
+    if (timer == nullptr)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(s_timerMutex);
+        if (!timer->active)
+        {
+            return ESP_ERR_INVALID_STATE;
+        }
+
+        timer->expiryUs = HostTime::NowUs() + timeoutUs;
+        if (timer->periodUs > 0)
+        {
+            timer->periodUs = timeoutUs;
+        }
+    }
+
+    s_timerCv.notify_all();
+    return ESP_OK;
+}
+
+//-----------------------------------------------------------------------------
+esp_err_t esp_timer_stop(esp_timer_handle_t timer)
+{
+    if (timer == nullptr)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(s_timerMutex);
+        if (!timer->active)
+        {
+            return ESP_ERR_INVALID_STATE;
+        }
+        timer->active = false;
+    }
+
+    s_timerCv.notify_all();
+    return ESP_OK;
+}
+
+//-----------------------------------------------------------------------------
+esp_err_t esp_timer_delete(esp_timer_handle_t timer)
+{
+    if (timer == nullptr)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(s_timerMutex);
+        if (timer->active)
+        {
+            return ESP_ERR_INVALID_STATE;
+        }
+
+        for (auto it = s_timers.begin(); it != s_timers.end(); ++it)
+        {
+            if (*it == timer)
+            {
+                s_timers.erase(it);
+                break;
+            }
+        }
+    }
+
+    delete timer;
+    return ESP_OK;
+}
+
+//-----------------------------------------------------------------------------
+bool esp_timer_is_active(esp_timer_handle_t timer)
+{
+    std::lock_guard<std::mutex> guard(s_timerMutex);
+    return (timer != nullptr) && timer->active;
+}
+
+//----esp_rom-----------------------------------------------------------------
+void esp_rom_delay_us(uint32_t us)
+{
+    // Busy-wait on real time so bit-banged protocols keep their relative timing
+    const uint64_t end = RealUs() + us;
+    while (RealUs() < end)
+    {
+    }
+
+    s_romDelayTotalUs.fetch_add(us, std::memory_order_acq_rel);
+}
+
+//----esp_log------------------------------------------------------------------
+void esp_log_write(esp_log_level_t /*level*/, const char* /*tag*/, const char* format, ...)
+{
+    std::lock_guard<std::mutex> guard(s_logMutex);
+
+    va_list args;
+    va_start(args, format);
+    std::vprintf(format, args);
+    va_end(args);
+
+    std::fflush(stdout);
+}
+
+//-----------------------------------------------------------------------------
+void esp_log_level_set(const char* tag, esp_log_level_t level)
+{
+    std::lock_guard<std::mutex> guard(s_logMutex);
+    s_tagLevels[(tag != nullptr) ? tag : "*"] = level;
+}
+
+//-----------------------------------------------------------------------------
+esp_log_level_t esp_log_level_get(const char* tag)
+{
+    std::lock_guard<std::mutex> guard(s_logMutex);
+
+    auto it = s_tagLevels.find((tag != nullptr) ? tag : "*");
+    if (it != s_tagLevels.end())
+    {
+        return it->second;
+    }
+
+    it = s_tagLevels.find("*");
+    return (it != s_tagLevels.end()) ? it->second : DefaultLogLevel();
+}
+
+//-----------------------------------------------------------------------------
+uint32_t esp_log_timestamp(void)
+{
+    return static_cast<uint32_t>(HostTime::NowUs() / 1000ULL);
+}
+
+//----esp_err------------------------------------------------------------------
+const char* esp_err_to_name(esp_err_t code)
+{
+    switch (code)
+    {
+        case ESP_OK:                    return "ESP_OK";
+        case ESP_FAIL:                  return "ESP_FAIL";
+        case ESP_ERR_NO_MEM:            return "ESP_ERR_NO_MEM";
+        case ESP_ERR_INVALID_ARG:       return "ESP_ERR_INVALID_ARG";
+        case ESP_ERR_INVALID_STATE:     return "ESP_ERR_INVALID_STATE";
+        case ESP_ERR_INVALID_SIZE:      return "ESP_ERR_INVALID_SIZE";
+        case ESP_ERR_NOT_FOUND:         return "ESP_ERR_NOT_FOUND";
+        case ESP_ERR_NOT_SUPPORTED:     return "ESP_ERR_NOT_SUPPORTED";
+        case ESP_ERR_TIMEOUT:           return "ESP_ERR_TIMEOUT";
+        case ESP_ERR_INVALID_RESPONSE:  return "ESP_ERR_INVALID_RESPONSE";
+        case ESP_ERR_INVALID_CRC:       return "ESP_ERR_INVALID_CRC";
+        case ESP_ERR_NOT_FINISHED:      return "ESP_ERR_NOT_FINISHED";
+        default:                        return "UNKNOWN ERROR";
+    }
+}
+
+//-----------------------------------------------------------------------------
+void host_esp_error_check_failed(esp_err_t rc, const char* file, int line, const char* expression)
+{
+    std::fprintf(stderr, "ESP_ERROR_CHECK failed: esp_err_t 0x%x (%s) at %s:%d\nexpression: %s\n",
+                 rc, esp_err_to_name(rc), file, line, expression);
+    std::abort();
+}
+
+//----esp_system---------------------------------------------------------------
+void esp_restart(void)
+{
+    std::printf("esp_restart() called, exiting host process\n");
+    std::fflush(stdout);
+    std::_Exit(0);
+}
+
+//-----------------------------------------------------------------------------
+uint32_t esp_get_free_heap_size(void)
+{
+    return 200U * 1024U;
+}
+
+//-----------------------------------------------------------------------------
+uint32_t esp_get_minimum_free_heap_size(void)
+{
+    return 150U * 1024U;
+}
@@ -0,0 +1,741 @@
+/*!****************************************************************************
+ * @file    freertos.cpp
+ * @brief   pthread based implementation of the FreeRTOS stand-in.
+ *          Priorities and stack sizes are recorded but not enforced; core
+ *          affinity is only reported back through xPortGetCoreID().
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include "host_bus.h"
+#include "host_time.h"
+
+#include <pthread.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct HostTask
+{
+    std::string name;
+    TaskFunction_t code = nullptr;
+    void* parameters = nullptr;
+    UBaseType_t priority = 0;
+    BaseType_t coreId = 0;
+    uint32_t stackDepth = 0;
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    uint32_t notifyValue = 0;
+    bool notifyPending = false;
+};
+
+struct HostSemaphore
+{
+    enum class Kind { MUTEX, RECURSIVE_MUTEX, BINARY, COUNTING };
+
+    Kind kind;
+    UBaseType_t maxCount;
+    UBaseType_t count;
+    HostTask* owner = nullptr;
+    UBaseType_t depth = 0;
+
+    std::mutex mutex;
+    std::condition_variable cv;
+};
+
+struct HostQueue
+{
+    UBaseType_t length;
+    UBaseType_t itemSize;
+    std::vector<uint8_t> storage;
+    UBaseType_t head = 0;
+    UBaseType_t count = 0;
+
+    std::mutex mutex;
+    std::condition_variable notEmpty;
+    std::condition_variable notFull;
+};
+
+namespace {
+
+//! Every task ever created. Handles stay valid after vTaskDelete() like a
+//! reused TCB would, so late notifications do not touch freed memory.
+std::mutex s_registryMutex;
+std::vector<HostTask*> s_tasks;
+
+thread_local HostTask* t_currentTask = nullptr;
+
+//! Critical section nesting of the calling task and the timing of its outermost sections
+std::atomic<bool> s_criticalTiming{false};
+thread_local uint32_t t_criticalDepth = 0;
+thread_local uint64_t t_criticalEnteredNs = 0;
+thread_local HostBus::CriticalStats t_criticalStats{};
+
+uint64_t CriticalClockNs()
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+//-----------------------------------------------------------------------------
+HostTask* CurrentTask()
+{
+    if (t_currentTask == nullptr)
+    {
+        // Threads not created through xTaskCreate (main, std::thread) get a lazy TCB
+        HostTask* task = new HostTask();
+        task->name = "main";
+        task->priority = 1;
+
+        std::lock_guard<std::mutex> guard(s_registryMutex);
+        s_tasks.push_back(task);
+        t_currentTask = task;
+    }
+
+    return t_currentTask;
+}
+
+//-----------------------------------------------------------------------------
+uint64_t DeadlineFromTicks(TickType_t ticks)
+{
+    if (ticks == portMAX_DELAY)
+    {
+        return UINT64_MAX;
+    }
+
+    return HostTime::NowUs() + (static_cast<uint64_t>(pdTICKS_TO_MS(ticks)) * 1000ULL);
+}
+
+//-----------------------------------------------------------------------------
+template <typename Predicate>
+bool WaitTicks(std::condition_variable& cv, std::unique_lock<std::mutex>& lock, TickType_t ticks, Predicate pred)
+{
+    if (ticks == portMAX_DELAY)
+    {
+        cv.wait(lock, pred);
+        return true;
+    }
+
+    return HostTime::WaitUntil(cv, lock, DeadlineFromTicks(ticks), pred);
+}
+
+//-----------------------------------------------------------------------------
+void* TaskTrampoline(void* arg)
+{
+    HostTask* task = static_cast<HostTask*>(arg);
+    t_currentTask = task;
+
+    pthread_setname_np(pthread_self(), task->name.substr(0, 15).c_str());
+
+    task->code(task->parameters);
+
+    // Returning from a task function is a bug on FreeRTOS; on the host just end the thread
+    return nullptr;
+}
+
+//-----------------------------------------------------------------------------
+HostSemaphore* CreateSemaphore(HostSemaphore::Kind kind, UBaseType_t maxCount, UBaseType_t initialCount)
+{
+    HostSemaphore* semaphore = new HostSemaphore();
+    semaphore->kind = kind;
+    semaphore->maxCount = maxCount;
+    semaphore->count = initialCount;
+    return semaphore;
+}
+
+//-----------------------------------------------------------------------------
+BaseType_t QueueSend(QueueHandle_t queue, const void* item, TickType_t ticksToWait, bool toFront)
+{
+    if (queue == nullptr)
+    {
+        return pdFAIL;
+    }
+
+    std::unique_lock<std::mutex> lock(queue->mutex);
+    if (!WaitTicks(queue->notFull, lock, ticksToWait, [queue]() { return queue->count < queue->length; }))
+    {
+        return errQUEUE_FULL;
+    }
+
+    UBaseType_t slot;
+    if (toFront)
+    {
+        queue->head = (queue->head + queue->length - 1) % queue->length;
+        slot = queue->head;
+    }
+    else
+    {
+        slot = (queue->head + queue->count) % queue->length;
+    }
+
+    std::memcpy(&queue->storage[slot * queue->itemSize], item, queue->itemSize);
+    queue->count++;
+
+    lock.unlock();
+    queue->notEmpty.notify_one();
+    return pdPASS;
+}
+
+} // namespace
+
+//----tasks--------------------------------------------------------------------
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t taskCode,
+                                   const char* name,
+                                   uint32_t stackDepth,
+                                   void* parameters,
+                                   UBaseType_t priority,
+                                   TaskHandle_t* createdTask,
+                                   BaseType_t coreId)
+{
+    HostTask* task = new HostTask();
+    task->name = (name != nullptr) ? name : "task";
+    task->code = taskCode;
+    task->parameters = parameters;
+    task->priority = priority;
+    task->coreId = (coreId == tskNO_AFFINITY) ? 0 : coreId;
+    task->stackDepth = stackDepth;
+
+    {
+        std::lock_guard<std::mutex> guard(s_registryMutex);
+        s_tasks.push_back(task);
+    }
+
+    // Publish the handle before the task can run, as xTaskCreate does
+    if (createdTask != nullptr)
+    {
+        *createdTask = task;
+    }
+
+    pthread_t thread;
+    if (pthread_create(&thread, nullptr, &TaskTrampoline, task) != 0)
+    {
+        if (createdTask != nullptr)
+        {
+            *createdTask = nullptr;
+        }
+        return pdFAIL;
+    }
+
+    pthread_detach(thread);
+    return pdPASS;
+}
+
+//-----------------------------------------------------------------------------
+void vTaskDelete(TaskHandle_t task)
+{
+    if (task == nullptr || task == CurrentTask())
+    {
+        pthread_exit(nullptr);
+    }
+
+    // Deleting another task is not used by the firmware and cannot be done safely with pthreads
+    std::abort();
+}
+
+//-----------------------------------------------------------------------------
+void vTaskDelay(TickType_t ticks)
+{
+    if (ticks == 0)
+    {
+        std::this_thread::yield();
+        return;
+    }
+
+    HostTime::SleepUntilUs(DeadlineFromTicks(ticks));
+}
+
+//-----------------------------------------------------------------------------
+void taskYIELD(void)
+{
+    std::this_thread::yield();
+}
+
+//-----------------------------------------------------------------------------
+TickType_t xTaskGetTickCount(void)
+{
+    return static_cast<TickType_t>(HostTime::NowUs() / (1000ULL * portTICK_PERIOD_MS));
+}
+
+//-----------------------------------------------------------------------------
+TickType_t xTaskGetTickCountFromISR(void)
+{
+    return xTaskGetTickCount();
+}
+
+//-----------------------------------------------------------------------------
+TaskHandle_t xTaskGetCurrentTaskHandle(void)
+{
+    return CurrentTask();
+}
+
+//-----------------------------------------------------------------------------
+BaseType_t xTaskGetSchedulerState(void)
+{
+    return taskSCHEDULER_RUNNING;
+}
+
+//-----------------------------------------------------------------------------
+char* pcTaskGetName(TaskHandle_t task)
+{
+    HostTask* target = (task != nullptr) ? task : CurrentTask();
+    return const_cast<char*>(target->name.c_str());
+}
+
+//-----------------------------------------------------------------------------
+UBaseType_t uxTaskPriorityGet(TaskHandle_t task)
+{
+    HostTask* target = (task != nullptr) ? task : CurrentTask();
+    return target->priority;
+}
+
+//-----------------------------------------------------------------------------
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t task)
+{
+    // Host stacks are not instrumented; report the configured depth as untouched
+    HostTask* target = (task != nullptr) ? task : CurrentTask();
+    return target->stackDepth;
+}
+
+//----critical sections--------------------------------------------------------
+void vHostEnterCritical(portMUX_TYPE* mux)
+{
+    mux->lock.lock();
+
+    if (t_criticalDepth++ == 0 && s_criticalTiming.load(std::memory_order_relaxed))
+    {
+        t_criticalEnteredNs = CriticalClockNs();
+    }
+}
+
+//-----------------------------------------------------------------------------
+void vHostExitCritical(portMUX_TYPE* mux)
+{
+    if (--t_criticalDepth == 0 && t_criticalEnteredNs != 0)
+    {
+        const uint64_t heldUs = (CriticalClockNs() - t_criticalEnteredNs) / 1000;
+        t_criticalEnteredNs = 0;
+
+        ++t_criticalStats.sections;
+        t_criticalStats.longestUs = std::max(t_criticalStats.longestUs, heldUs);
+        t_criticalStats.totalUs += heldUs;
+    }
+
+    mux->lock.unlock();
+}
+
+namespace HostBus {
+
+//-----------------------------------------------------------------------------
+void SetCriticalTiming(bool enabled)
+{
+    s_criticalTiming = enabled;
+}
+
+//-----------------------------------------------------------------------------
+CriticalStats TakeCriticalStats()
+{
+    const CriticalStats stats = t_criticalStats;
+    t_criticalStats = CriticalStats{};
+    return stats;
+}
+
+} // namespace HostBus
+
+//-----------------------------------------------------------------------------
+BaseType_t xPortGetCoreID(void)
+{
+    return CurrentTask()->coreId;
+}
+
+//----notifications------------------------------------------------------------
+uint32_t ulTaskNotifyTake(BaseType_t clearCountOnExit, TickType_t ticksToWait)
+{
+    HostTask* task = CurrentTask();
+
+    std::unique_lock<std::mutex> lock(task->mutex);
+    WaitTicks(task->cv, lock, ticksToWait, [task]() { return task->notifyValue != 0; });
+
+    const uint32_t value = task->notifyValue;
+    if (value != 0)
+    {
+        task->notifyValue = (clearCountOnExit != pdFALSE) ? 0 : (value - 1);
+    }
+    task->notifyPending = false;
+
+    return value;
+}
+
+//-----------------------------------------------------------------------------
+BaseType_t xTaskNotifyGive(TaskHandle_t task)
+{
+    return xTaskNotify(task, 0, eIncrement);
+}
+
+//-----------------------------------------------------------------------------
+void vTaskNotifyGiveFromISR(TaskHandle_t task, BaseType_t* higherPriorityTaskWoken)
+{
+    xTaskNotify(task, 0, eIncrement);
+
+    if (higherPriorityTaskWoken != nullptr)
+    {
+        *higherPriorityTaskWoken = pdFALSE;
+    }
+}
+
+//-----------------------------------------------------------------------------
+BaseType_t xTaskNotify(TaskHandle_t task, uint32_t value, eNotifyAction action)
+{
+    if (task == nullptr)
+    {
+        return pdFAIL;
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(task->mutex);
+
+        switch (action)
+        {
+            case eSetBits:                  task->notifyValue |= value;     break;
+            case eIncrement:                task->notifyValue++;            break;
+            case eSetValueWithOverwrite:    task->notifyValue = value;      break;
+            case eSetValueWithoutOverwrite:
+            {
+                if (task->notifyPending)
+                {
+                    return pdFAIL;
+                }
+                task->notifyValue = value;
+            }
+            break;
+            case eNoAction:
+            default:
+                break;
+        }
+
+        task->notifyPending = true;
+    }
+
+    task->cv.notify_all();
+    return pdPASS;
+}
+
+//-----------------------------------------------------------------------------
+BaseType_t xTaskNotifyFromISR(TaskHandle_t task, uint32_t value, eNotifyAction action, BaseType_t* higherPriorityTaskWoken)
+{
+    if (higherPriorityTaskWoken != nullptr)
+    {
+        *higherPriorityTaskWoken = pdFALSE;
+    }
+
+    return xTaskNotify(task, value, action);
+}
+
+//-----------------------------------------------------------------------------
+BaseType_t xTaskNotifyWait(uint32_t bitsToClearOnEntry, uint32_t bitsToClearOnExit, uint32_t* notificationValue, TickType_t ticksToWait)
+{
+    HostTask* task = CurrentTask();
+
+    std::unique_lock<std::mutex> lock(task->mutex);
+    if (!task->notifyPending)
+    {
+        task->notifyValue &= ~bitsToClearOnEntry;
+    }
+
+    const bool received = WaitTicks(task->cv, lock, ticksToWait, [task]() { return task->notifyPending; });
+
+    if (notificationValue != nullptr)
+    {
+        *notificationValue = task->notifyValue;
+    }
+
+    if (received)
+    {
+        task->notifyValue &= ~bitsToClearOnExit;
+        task->notifyPending = false;
+    }
+
+    return received ? pdTRUE : pdFALSE;
+}
+
+//----semaphores---------------------------------------------------------------
+SemaphoreHandle_t xSemaphoreCreateMutex(void)
+{
+    return CreateSemaphore(HostSemaphore::Kind::MUTEX, 1, 1);
+}
+
+//-----------------------------------------------------------------------------
+SemaphoreHandle_t xSemaphoreCreateRecursiveMutex(void)
+{
+    return CreateSemaphore(HostSemaphore::Kind::RECURSIVE_MUTEX, 1, 1);
+}
+
+//-----------------------------------------------------------------------------
+SemaphoreHandle_t xSemaphoreCreateBinary(void)
+{
+    return CreateSemaphore(HostSemaphore::Kind::BINARY, 1, 0);
+}
+
+//-----------------------------------------------------------------------------
+SemaphoreHandle_t xSemaphoreCreateCounting(UBaseType_t maxCount, UBaseType_t initialCount)
+{
+    return CreateSemaphore(HostSemaphore::Kind::COUNTING, maxCount, initialCount);
+}
+
+//-----------------------------------------------------------------------------
+void vSemaphoreDelete(SemaphoreHandle_t semaphore)
+{
+    delete semaphore;
+}
+
+//-----------------------------------------------------------------------------
+BaseType_t xSemaphoreTake(SemaphoreHandle_t semaphore, TickType_t ticksToWait)
+{
+    if (semaphore == nullptr)
+    {
+        return pdFAIL;
+    }
+
+    std::unique_lock<std::mutex> lock(semaphore->mutex);
+    if (!WaitTicks(semaphore->cv, lock, ticksToWait, [semaphore]() { return semaphore->count > 0; }))
+    {
+        return pdFAIL;
+    }
+
+    semaphore->count--;
+    semaphore->owner = CurrentTask();
+    return pdPASS;
+}
+
+//-----------------------------------------------------------------------------
+BaseType_t xSemaphoreGive(SemaphoreHandle_t semaphore)
+{
+    if (semaphore == nullptr)
+    {
+        return pdFAIL;
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(semaphore->mutex);
+        if (semaphore->count >= semaphore->maxCount)
+        {
+            return pdFAIL;
+        }
+
+        semaphore->count++;
+        semaphore->owner = nullptr;
+    }
+
+    semaphore->cv.notify_one();
+    return pdPASS;
+}
+
+//-----------------------------------------------------------------------------
+BaseType_t xSemaphoreTakeRecursive(SemaphoreHandle_t semaphore, TickType_t ticksToWait)
+{
+    if (semaphore == nullptr)
+    {
+        return pdFAIL;
+    }
+
+    HostTask* self = CurrentTask();
+
+    std::unique_lock<std::mutex> lock(semaphore->mutex);
+    if (semaphore->owner == self && semaphore->depth > 0)
+    {
+        semaphore->depth++;
+        return pdPASS;
+    }
+
+    if (!WaitTicks(semaphore->cv, lock, ticksToWait, [semaphore]() { return semaphore->count > 0; }))
+    {
+        return pdFAIL;
+    }
+
+    semaphore->count--;
+    semaphore->owner = self;
+    semaphore->depth = 1;
+    return pdPASS;
+}
+
+//-----------------------------------------------------------------------------
+BaseType_t xSemaphoreGiveRecursive(SemaphoreHandle_t semaphore)
+{
+    if (semaphore == nullptr)
+    {
+        return pdFAIL;
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(semaphore->mutex);
+        if (semaphore->owner != CurrentTask() || semaphore->depth == 0)
+        {
+            return pdFAIL;
+        }
+
+        if (--semaphore->depth > 0)
+        {
+            return pdPASS;
+        }
+
+        semaphore->owner = nullptr;
+        semaphore->count++;
+    }
+
+    semaphore->cv.notify_one();
+    return pdPASS;
+}
+
+//-----------------------------------------------------------------------------
+BaseType_t xSemaphoreGiveFromISR(SemaphoreHandle_t semaphore, BaseType_t* higherPriorityTaskWoken)
+{
+    if (higherPriorityTaskWoken != nullptr)
+    {
+        *higherPriorityTaskWoken = pdFALSE;
+    }
+
+    return xSemaphoreGive(semaphore);
+}
+
+//-----------------------------------------------------------------------------
+BaseType_t xSemaphoreTakeFromISR(SemaphoreHandle_t semaphore, BaseType_t* higherPriorityTaskWoken)
+{
+    if (higherPriorityTaskWoken != nullptr)
+    {
+        *higherPriorityTaskWoken = pdFALSE;
+    }
+
+    return xSemaphoreTake(semaphore, 0);
+}
+
+//-----------------------------------------------------------------------------
+UBaseType_t uxSemaphoreGetCount(SemaphoreHandle_t semaphore)
+{
+    std::lock_guard<std::mutex> guard(semaphore->mutex);
+    return semaphore->count;
+}
+
+//----queues-------------------------------------------------------------------
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t itemSize)
+{
+    if (length == 0 || itemSize == 0)
+    {
+        return nullptr;
+    }
+
+    HostQueue* queue = new HostQueue();
+    queue->length = length;
+    queue->itemSize = itemSize;
+    queue->storage.resize(static_cast<size_t>(length) * itemSize);
+    return queue;
+}
+
+//-----------------------------------------------------------------------------
+void vQueueDelete(QueueHandle_t queue)
+{
+    delete queue;
+}
+
+//-----------------------------------------------------------------------------
+BaseType_t xQueueSendToBack(QueueHandle_t queue, const void* item, TickType_t ticksToWait)
+{
+    return QueueSend(queue, item, ticksToWait, false);
+}
+
+//-----------------------------------------------------------------------------
+BaseType_t xQueueSendToFront(QueueHandle_t queue, const void* item, TickType_t ticksToWait)
+{
+    return QueueSend(queue, item, ticksToWait, true);
+}
+
+//-----------------------------------------------------------------------------
+BaseType_t xQueueOverwrite(QueueHandle_t queue, const void* item)
+{
+    {
+        std::lock_guard<std::mutex> guard(queue->mutex);
+        queue->head = 0;
+        queue->count = 1;
+        std::memcpy(queue->storage.data(), item, queue->itemSize);
+    }
+
+    queue->notEmpty.notify_one();
+    return pdPASS;
+}
+
+//-----------------------------------------------------------------------------
+BaseType_t xQueueReceive(QueueHandle_t queue, void* buffer, TickType_t ticksToWait)
+{
+    if (queue == nullptr)
+    {
+        return pdFAIL;
+    }
+
+    std::unique_lock<std::mutex> lock(queue->mutex);
+    if (!WaitTicks(queue->notEmpty, lock, ticksToWait, [queue]() { return queue->count > 0; }))
+    {
+        return errQUEUE_EMPTY;
+    }
+
+    std::memcpy(buffer, &queue->storage[queue->head * queue->itemSize], queue->itemSize);
+    queue->head = (queue->head + 1) % queue->length;
+    queue->count--;
+
+    lock.unlock();
+    queue->notFull.notify_one();
+    return pdPASS;
+}
+
+//-----------------------------------------------------------------------------
+BaseType_t xQueuePeek(QueueHandle_t queue, void* buffer, TickType_t ticksToWait)
+{
+    if (queue == nullptr)
+    {
+        return pdFAIL;
+    }
+
+    std::unique_lock<std::mutex> lock(queue->mutex);
+    if (!WaitTicks(queue->notEmpty, lock, ticksToWait, [queue]() { return queue->count > 0; }))
+    {
+        return errQUEUE_EMPTY;
+    }
+
+    std::memcpy(buffer, &queue->storage[queue->head * queue->itemSize], queue->itemSize);
+    return pdPASS;
+}
+
+//-----------------------------------------------------------------------------
+BaseType_t xQueueReset(QueueHandle_t queue)
+{
+    {
+        std::lock_guard<std::mutex> guard(queue->mutex);
+        queue->head = 0;
+        queue->count = 0;
+    }
+
+    queue->notFull.notify_all();
+    return pdPASS;
+}
+
+//-----------------------------------------------------------------------------
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t queue)
+{
+    std::lock_guard<std::mutex> guard(queue->mutex);
+    return queue->count;
+}
+
+//-----------------------------------------------------------------------------
+UBaseType_t uxQueueSpacesAvailable(QueueHandle_t queue)
+{
+    std::lock_guard<std::mutex> guard(queue->mutex);
+    return queue->length - queue->count;
+}
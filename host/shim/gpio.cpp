@@ -0,0 +1,194 @@
+/*!****************************************************************************
+ * @file    gpio.cpp
+ * @brief   Host implementation of the GPIO driver. Pins keep their mode and
+ *          output level; reads are resolved against attached devices as an
+ *          open-drain wired-AND.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#include "driver/gpio.h"
+#include "host_bus.h"
+
+#include <array>
+#include <mutex>
+
+namespace {
+
+struct PinState
+{
+    gpio_mode_t mode = GPIO_MODE_DISABLE;
+    int outputLevel = 0;
+    int inputLevel = 0;
+    HostBus::IGpioDevice* device = nullptr;
+};
+
+std::mutex s_mutex;
+std::array<PinState, GPIO_NUM_MAX> s_pins;
+
+//-----------------------------------------------------------------------------
+bool IsValid(gpio_num_t gpio)
+{
+    return (gpio >= 0) && (gpio < GPIO_NUM_MAX);
+}
+
+//-----------------------------------------------------------------------------
+bool IsOpenDrain(gpio_mode_t mode)
+{
+    return (mode == GPIO_MODE_OUTPUT_OD) || (mode == GPIO_MODE_INPUT_OUTPUT_OD);
+}
+
+} // namespace
+
+//-----------------------------------------------------------------------------
+esp_err_t gpio_config(const gpio_config_t* config)
+{
+    if (config == nullptr)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    std::lock_guard<std::mutex> guard(s_mutex);
+    for (int pin = 0; pin < GPIO_NUM_MAX; ++pin)
+    {
+        if (config->pin_bit_mask & (1ULL << pin))
+        {
+            s_pins[pin].mode = config->mode;
+        }
+    }
+
+    return ESP_OK;
+}
+
+//-----------------------------------------------------------------------------
+esp_err_t gpio_reset_pin(gpio_num_t gpio)
+{
+    if (!IsValid(gpio))
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    std::lock_guard<std::mutex> guard(s_mutex);
+    s_pins[gpio].mode = GPIO_MODE_DISABLE;
+    s_pins[gpio].outputLevel = 0;
+    return ESP_OK;
+}
+
+//-----------------------------------------------------------------------------
+esp_err_t gpio_set_level(gpio_num_t gpio, uint32_t level)
+{
+    if (!IsValid(gpio))
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    HostBus::IGpioDevice* device;
+    {
+        std::lock_guard<std::mutex> guard(s_mutex);
+        s_pins[gpio].outputLevel = (level != 0) ? 1 : 0;
+        device = s_pins[gpio].device;
+    }
+
+    if (device != nullptr)
+    {
+        device->OnPinWrite(gpio, (level != 0) ? 1 : 0);
+    }
+
+    return ESP_OK;
+}
+
+//-----------------------------------------------------------------------------
+int gpio_get_level(gpio_num_t gpio)
+{
+    if (!IsValid(gpio))
+    {
+        return 0;
+    }
+
+    PinState pin;
+    {
+        std::lock_guard<std::mutex> guard(s_mutex);
+        pin = s_pins[gpio];
+    }
+
+    if (pin.device != nullptr)
+    {
+        const int deviceLevel = pin.device->OnPinRead(gpio);
+        if (IsOpenDrain(pin.mode))
+        {
+            return (pin.outputLevel != 0 && deviceLevel != 0) ? 1 : 0;
+        }
+        return deviceLevel;
+    }
+
+    if (pin.mode == GPIO_MODE_INPUT || pin.mode == GPIO_MODE_DISABLE)
+    {
+        return pin.inputLevel;
+    }
+
+    return pin.outputLevel;
+}
+
+//-----------------------------------------------------------------------------
+esp_err_t gpio_set_direction(gpio_num_t gpio, gpio_mode_t mode)
+{
+    if (!IsValid(gpio))
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    std::lock_guard<std::mutex> guard(s_mutex);
+    s_pins[gpio].mode = mode;
+    return ESP_OK;
+}
+
+//-----------------------------------------------------------------------------
+esp_err_t gpio_set_pull_mode(gpio_num_t gpio, gpio_pull_mode_t /*pull*/)
+{
+    return IsValid(gpio) ? ESP_OK : ESP_ERR_INVALID_ARG;
+}
+
+//-----------------------------------------------------------------------------
+esp_err_t gpio_install_isr_service(int /*intrAllocFlags*/)
+{
+    return ESP_OK;
+}
+
+//-----------------------------------------------------------------------------
+esp_err_t gpio_isr_handler_add(gpio_num_t gpio, gpio_isr_t /*isrHandler*/, void* /*args*/)
+{
+    // Edge interrupts are not simulated
+    return IsValid(gpio) ? ESP_OK : ESP_ERR_INVALID_ARG;
+}
+
+//-----------------------------------------------------------------------------
+esp_err_t gpio_isr_handler_remove(gpio_num_t gpio)
+{
+    return IsValid(gpio) ? ESP_OK : ESP_ERR_INVALID_ARG;
+}
+
+//----HostBus------------------------------------------------------------------
+namespace HostBus {
+
+//-----------------------------------------------------------------------------
+void AttachGpioDevice(gpio_num_t pin, IGpioDevice* device)
+{
+    std::lock_guard<std::mutex> guard(s_mutex);
+    s_pins[pin].device = device;
+}
+
+//-----------------------------------------------------------------------------
+void SetInputLevel(gpio_num_t pin, int level)
+{
+    std::lock_guard<std::mutex> guard(s_mutex);
+    s_pins[pin].inputLevel = (level != 0) ? 1 : 0;
+}
+
+//-----------------------------------------------------------------------------
+int GetOutputLevel(gpio_num_t pin)
+{
+    std::lock_guard<std::mutex> guard(s_mutex);
+    return s_pins[pin].outputLevel;
+}
+
+} // namespace HostBus
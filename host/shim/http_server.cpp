@@ -0,0 +1,209 @@
+/*!****************************************************************************
+ * @file    http_server.cpp
+ * @brief   Host implementation of esp_http_server. No socket is opened:
+ *          requests are injected through HostNet::HttpRequest() and run on
+ *          the caller's thread against the registered URI handlers.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#include "esp_http_server.h"
+#include "host_net.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Server
+{
+    std::vector<httpd_uri_t> handlers;
+    std::vector<std::string> uris;
+};
+
+//! Per-request state hung off httpd_req_t::aux
+struct RequestContext
+{
+    std::string body;
+    size_t bodyOffset = 0;
+    std::string response;
+    int status = 200;
+};
+
+std::mutex s_mutex;
+Server* s_server = nullptr;
+
+//-----------------------------------------------------------------------------
+RequestContext* Context(httpd_req_t* r)
+{
+    return static_cast<RequestContext*>(r->aux);
+}
+
+} // namespace
+
+//-----------------------------------------------------------------------------
+esp_err_t httpd_start(httpd_handle_t* handle, const httpd_config_t* config)
+{
+    if (handle == nullptr || config == nullptr)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    std::lock_guard<std::mutex> guard(s_mutex);
+    if (s_server != nullptr)
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    s_server = new Server();
+    s_server->handlers.reserve(config->max_uri_handlers);
+    *handle = s_server;
+    return ESP_OK;
+}
+
+//-----------------------------------------------------------------------------
+esp_err_t httpd_stop(httpd_handle_t handle)
+{
+    std::lock_guard<std::mutex> guard(s_mutex);
+    if (handle == nullptr || handle != s_server)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    delete s_server;
+    s_server = nullptr;
+    return ESP_OK;
+}
+
+//-----------------------------------------------------------------------------
+esp_err_t httpd_register_uri_handler(httpd_handle_t handle, const httpd_uri_t* uriHandler)
+{
+    if (handle == nullptr || uriHandler == nullptr)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    std::lock_guard<std::mutex> guard(s_mutex);
+    Server* server = static_cast<Server*>(handle);
+
+    // Keep our own copy of the URI string; the caller's may be a temporary
+    server->uris.emplace_back(uriHandler->uri);
+    server->handlers.push_back(*uriHandler);
+    return ESP_OK;
+}
+
+//-----------------------------------------------------------------------------
+int httpd_req_recv(httpd_req_t* r, char* buf, size_t bufLen)
+{
+    RequestContext* context = Context(r);
+    const size_t remaining = context->body.size() - context->bodyOffset;
+    const size_t count = (bufLen < remaining) ? bufLen : remaining;
+
+    std::memcpy(buf, context->body.data() + context->bodyOffset, count);
+    context->bodyOffset += count;
+    return static_cast<int>(count);
+}
+
+//-----------------------------------------------------------------------------
+esp_err_t httpd_resp_set_type(httpd_req_t* /*r*/, const char* /*type*/)
+{
+    return ESP_OK;
+}
+
+//-----------------------------------------------------------------------------
+esp_err_t httpd_resp_set_status(httpd_req_t* r, const char* status)
+{
+    Context(r)->status = std::atoi(status);
+    return ESP_OK;
+}
+
+//-----------------------------------------------------------------------------
+esp_err_t httpd_resp_set_hdr(httpd_req_t* /*r*/, const char* /*field*/, const char* /*value*/)
+{
+    return ESP_OK;
+}
+
+//-----------------------------------------------------------------------------
+esp_err_t httpd_resp_send(httpd_req_t* r, const char* buf, ssize_t bufLen)
+{
+    const size_t length = (bufLen == HTTPD_RESP_USE_STRLEN) ? std::strlen(buf) : static_cast<size_t>(bufLen);
+    Context(r)->response.assign(buf, length);
+    return ESP_OK;
+}
+
+//-----------------------------------------------------------------------------
+esp_err_t httpd_resp_sendstr(httpd_req_t* r, const char* str)
+{
+    return httpd_resp_send(r, str, HTTPD_RESP_USE_STRLEN);
+}
+
+//-----------------------------------------------------------------------------
+esp_err_t httpd_resp_send_404(httpd_req_t* r)
+{
+    Context(r)->status = 404;
+    return httpd_resp_sendstr(r, "Not Found");
+}
+
+//-----------------------------------------------------------------------------
+esp_err_t httpd_resp_send_500(httpd_req_t* r)
+{
+    Context(r)->status = 500;
+    return httpd_resp_sendstr(r, "Internal Server Error");
+}
+
+//----HostNet------------------------------------------------------------------
+namespace HostNet {
+
+//-----------------------------------------------------------------------------
+int HttpRequest(int method, const std::string& uri, const std::string& body, std::string& response)
+{
+    httpd_uri_t match = {};
+    {
+        std::lock_guard<std::mutex> guard(s_mutex);
+        if (s_server == nullptr)
+        {
+            return 503;
+        }
+
+        bool found = false;
+        for (size_t i = 0; i < s_server->handlers.size(); ++i)
+        {
+            if (s_server->handlers[i].method == method && s_server->uris[i] == uri)
+            {
+                match = s_server->handlers[i];
+                found = true;
+                break;
+            }
+        }
+
+        if (!found)
+        {
+            response = "Not Found";
+            return 404;
+        }
+    }
+
+    RequestContext context;
+    context.body = body;
+
+    httpd_req_t request = {};
+    request.handle = s_server;
+    request.method = method;
+    request.uri = uri.c_str();
+    request.content_len = body.size();
+    request.aux = &context;
+    request.user_ctx = match.user_ctx;
+
+    if (match.handler(&request) != ESP_OK && context.status == 200)
+    {
+        context.status = 500;
+    }
+
+    response = context.response;
+    return context.status;
+}
+
+} // namespace HostNet
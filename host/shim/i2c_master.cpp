@@ -0,0 +1,194 @@
+/*!****************************************************************************
+ * @file    i2c_master.cpp
+ * @brief   Host implementation of the I2C master driver. Transfers are
+ *          routed to the device model attached at the address and take the
+ *          time they would on the wire (9 clocks per byte plus addressing).
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#include "driver/i2c_master.h"
+#include "host_bus.h"
+#include "host_time.h"
+
+#include <map>
+#include <mutex>
+#include <utility>
+
+struct i2c_master_bus_t
+{
+    i2c_port_num_t port;
+    std::mutex mutex;
+};
+
+struct i2c_master_dev_t
+{
+    i2c_master_bus_t* bus;
+    uint16_t address;
+    uint32_t sclSpeedHz;
+};
+
+namespace {
+
+std::mutex s_devicesMutex;
+std::map<std::pair<int, uint16_t>, HostBus::II2cDevice*> s_devices;
+
+//-----------------------------------------------------------------------------
+HostBus::II2cDevice* FindDevice(int port, uint16_t address)
+{
+    std::lock_guard<std::mutex> guard(s_devicesMutex);
+    auto it = s_devices.find({port, address});
+    return (it != s_devices.end()) ? it->second : nullptr;
+}
+
+//-----------------------------------------------------------------------------
+void SpendWireTime(uint32_t sclSpeedHz, size_t bytes)
+{
+    const uint32_t speed = (sclSpeedHz > 0) ? sclSpeedHz : 100000;
+    const uint64_t bits = (bytes + 1) * 9ULL;
+    HostTime::SleepUntilUs(HostTime::NowUs() + ((bits * 1000000ULL) / speed));
+}
+
+} // namespace
+
+//-----------------------------------------------------------------------------
+esp_err_t i2c_new_master_bus(const i2c_master_bus_config_t* busConfig, i2c_master_bus_handle_t* retBusHandle)
+{
+    if (busConfig == nullptr || retBusHandle == nullptr || busConfig->i2c_port >= I2C_NUM_MAX)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    i2c_master_bus_t* bus = new i2c_master_bus_t();
+    bus->port = busConfig->i2c_port;
+    *retBusHandle = bus;
+    return ESP_OK;
+}
+
+//-----------------------------------------------------------------------------
+esp_err_t i2c_del_master_bus(i2c_master_bus_handle_t busHandle)
+{
+    delete busHandle;
+    return ESP_OK;
+}
+
+//-----------------------------------------------------------------------------
+esp_err_t i2c_master_bus_add_device(i2c_master_bus_handle_t busHandle, const i2c_device_config_t* devConfig, i2c_master_dev_handle_t* retHandle)
+{
+    if (busHandle == nullptr || devConfig == nullptr || retHandle == nullptr)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    i2c_master_dev_t* dev = new i2c_master_dev_t();
+    dev->bus = busHandle;
+    dev->address = devConfig->device_address;
+    dev->sclSpeedHz = devConfig->scl_speed_hz;
+    *retHandle = dev;
+    return ESP_OK;
+}
+
+//-----------------------------------------------------------------------------
+esp_err_t i2c_master_bus_rm_device(i2c_master_dev_handle_t handle)
+{
+    delete handle;
+    return ESP_OK;
+}
+
+//-----------------------------------------------------------------------------
+esp_err_t i2c_master_transmit(i2c_master_dev_handle_t dev, const uint8_t* writeBuffer, size_t writeSize, int /*xferTimeoutMs*/)
+{
+    if (dev == nullptr)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    std::lock_guard<std::mutex> guard(dev->bus->mutex);
+    SpendWireTime(dev->sclSpeedHz, writeSize);
+
+    HostBus::II2cDevice* device = FindDevice(dev->bus->port, dev->address);
+    if (device == nullptr || !device->OnWrite(writeBuffer, writeSize))
+    {
+        return ESP_FAIL;
+    }
+
+    return ESP_OK;
+}
+
+//-----------------------------------------------------------------------------
+esp_err_t i2c_master_receive(i2c_master_dev_handle_t dev, uint8_t* readBuffer, size_t readSize, int /*xferTimeoutMs*/)
+{
+    if (dev == nullptr)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    std::lock_guard<std::mutex> guard(dev->bus->mutex);
+    SpendWireTime(dev->sclSpeedHz, readSize);
+
+    HostBus::II2cDevice* device = FindDevice(dev->bus->port, dev->address);
+    if (device == nullptr || !device->OnRead(readBuffer, readSize))
+    {
+        return ESP_FAIL;
+    }
+
+    return ESP_OK;
+}
+
+//-----------------------------------------------------------------------------
+esp_err_t i2c_master_transmit_receive(i2c_master_dev_handle_t dev,
+                                      const uint8_t* writeBuffer,
+                                      size_t writeSize,
+                                      uint8_t* readBuffer,
+                                      size_t readSize,
+                                      int /*xferTimeoutMs*/)
+{
+    if (dev == nullptr)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    std::lock_guard<std::mutex> guard(dev->bus->mutex);
+    SpendWireTime(dev->sclSpeedHz, writeSize + readSize + 1);
+
+    HostBus::II2cDevice* device = FindDevice(dev->bus->port, dev->address);
+    if (device == nullptr || !device->OnWrite(writeBuffer, writeSize) || !device->OnRead(readBuffer, readSize))
+    {
+        return ESP_FAIL;
+    }
+
+    return ESP_OK;
+}
+
+//-----------------------------------------------------------------------------
+esp_err_t i2c_master_probe(i2c_master_bus_handle_t busHandle, uint16_t address, int /*xferTimeoutMs*/)
+{
+    if (busHandle == nullptr)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    std::lock_guard<std::mutex> guard(busHandle->mutex);
+    SpendWireTime(100000, 0);
+
+    // A zero-length write is an address-only probe: the device ACKs unless busy
+    HostBus::II2cDevice* device = FindDevice(busHandle->port, address);
+    if (device == nullptr || !device->OnWrite(nullptr, 0))
+    {
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    return ESP_OK;
+}
+
+//----HostBus------------------------------------------------------------------
+namespace HostBus {
+
+//-----------------------------------------------------------------------------
+void AttachI2cDevice(int port, uint16_t address, II2cDevice* device)
+{
+    std::lock_guard<std::mutex> guard(s_devicesMutex);
+    s_devices[{port, address}] = device;
+}
+
+} // namespace HostBus
@@ -0,0 +1,72 @@
+/*!****************************************************************************
+ * @file    i2c_master.h
+ * @brief   Host stand-in for the ESP-IDF 5 I2C master driver.
+ *          Transfers are routed to simulated devices (see host/sim/i2c_sim.h)
+ *          and take the wire time of the configured SCL speed.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#pragma once
+
+#include "driver/gpio.h"
+#include "esp_err.h"
+#include <stddef.h>
+#include <stdint.h>
+
+typedef int i2c_port_num_t;
+
+enum
+{
+    I2C_NUM_0 = 0,
+    I2C_NUM_1,
+    I2C_NUM_MAX,
+};
+
+typedef enum { I2C_CLK_SRC_DEFAULT = 0 } i2c_clock_source_t;
+typedef enum { I2C_ADDR_BIT_LEN_7 = 0, I2C_ADDR_BIT_LEN_10 = 1 } i2c_addr_bit_len_t;
+
+typedef struct i2c_master_bus_t* i2c_master_bus_handle_t;
+typedef struct i2c_master_dev_t* i2c_master_dev_handle_t;
+
+typedef struct
+{
+    i2c_port_num_t i2c_port;
+    gpio_num_t sda_io_num;
+    gpio_num_t scl_io_num;
+    i2c_clock_source_t clk_source;
+    uint8_t glitch_ignore_cnt;
+    int intr_priority;
+    size_t trans_queue_depth;
+    struct
+    {
+        uint32_t enable_internal_pullup : 1;
+        uint32_t allow_pd : 1;
+    } flags;
+} i2c_master_bus_config_t;
+
+typedef struct
+{
+    i2c_addr_bit_len_t dev_addr_length;
+    uint16_t device_address;
+    uint32_t scl_speed_hz;
+    uint32_t scl_wait_us;
+    struct
+    {
+        uint32_t disable_ack_check : 1;
+    } flags;
+} i2c_device_config_t;
+
+esp_err_t i2c_new_master_bus(const i2c_master_bus_config_t* busConfig, i2c_master_bus_handle_t* retBusHandle);
+esp_err_t i2c_del_master_bus(i2c_master_bus_handle_t busHandle);
+esp_err_t i2c_master_bus_add_device(i2c_master_bus_handle_t busHandle, const i2c_device_config_t* devConfig, i2c_master_dev_handle_t* retHandle);
+esp_err_t i2c_master_bus_rm_device(i2c_master_dev_handle_t handle);
+
+esp_err_t i2c_master_transmit(i2c_master_dev_handle_t dev, const uint8_t* writeBuffer, size_t writeSize, int xferTimeoutMs);
+esp_err_t i2c_master_receive(i2c_master_dev_handle_t dev, uint8_t* readBuffer, size_t readSize, int xferTimeoutMs);
+esp_err_t i2c_master_transmit_receive(i2c_master_dev_handle_t dev, const uint8_t* writeBuffer, size_t writeSize, uint8_t* readBuffer, size_t readSize, int xferTimeoutMs);
+
+/**
+ * @brief Address-only transfer. ESP_OK on ACK, ESP_ERR_NOT_FOUND on NACK.
+ */
+esp_err_t i2c_master_probe(i2c_master_bus_handle_t busHandle, uint16_t address, int xferTimeoutMs);
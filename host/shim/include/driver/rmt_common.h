@@ -0,0 +1,14 @@
+/*!****************************************************************************
+ * @file    rmt_common.h
+ * @brief   Host stand-in for the RMT calls shared by TX and RX channels.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#pragma once
+
+#include "driver/rmt_types.h"
+
+esp_err_t rmt_del_channel(rmt_channel_handle_t channel);
+esp_err_t rmt_enable(rmt_channel_handle_t channel);
+esp_err_t rmt_disable(rmt_channel_handle_t channel);
@@ -0,0 +1,47 @@
+/*!****************************************************************************
+ * @file    rmt_rx.h
+ * @brief   Host stand-in for the RMT receiver. A receive armed on the pin a
+ *          transmitter drives captures the resolved line level, device
+ *          pulses included (see host/shim/rmt.cpp).
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#pragma once
+
+#include "driver/rmt_common.h"
+
+typedef struct
+{
+    gpio_num_t gpio_num;
+    rmt_clock_source_t clk_src;
+    uint32_t resolution_hz;
+    size_t mem_block_symbols;
+    int intr_priority;
+    struct
+    {
+        uint32_t invert_in : 1;
+        uint32_t with_dma : 1;
+        uint32_t io_loop_back : 1;
+        uint32_t allow_pd : 1;
+    } flags;
+} rmt_rx_channel_config_t;
+
+typedef struct
+{
+    uint32_t signal_range_min_ns;
+    uint32_t signal_range_max_ns;
+    struct
+    {
+        uint32_t en_partial_rx : 1;
+    } flags;
+} rmt_receive_config_t;
+
+typedef struct
+{
+    rmt_rx_done_callback_t on_recv_done;
+} rmt_rx_event_callbacks_t;
+
+esp_err_t rmt_new_rx_channel(const rmt_rx_channel_config_t* config, rmt_channel_handle_t* retChannel);
+esp_err_t rmt_receive(rmt_channel_handle_t rxChannel, void* buffer, size_t bufferSize, const rmt_receive_config_t* config);
+esp_err_t rmt_rx_register_event_callbacks(rmt_channel_handle_t rxChannel, const rmt_rx_event_callbacks_t* cbs, void* userData);
@@ -0,0 +1,52 @@
+/*!****************************************************************************
+ * @file    rmt_types.h
+ * @brief   Host stand-in for the ESP-IDF 5 RMT driver types.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#pragma once
+
+#include "driver/gpio.h"
+#include "esp_err.h"
+#include <stddef.h>
+#include <stdint.h>
+
+typedef struct rmt_channel_t* rmt_channel_handle_t;
+typedef struct rmt_encoder_t rmt_encoder_t;
+typedef rmt_encoder_t* rmt_encoder_handle_t;
+
+typedef enum { RMT_CLK_SRC_DEFAULT = 0, RMT_CLK_SRC_APB = 0, RMT_CLK_SRC_REF_TICK = 1 } rmt_clock_source_t;
+
+/**
+ * @brief Two level/duration pairs, durations in channel ticks.
+ */
+typedef union
+{
+    struct
+    {
+        uint16_t duration0 : 15;
+        uint16_t level0 : 1;
+        uint16_t duration1 : 15;
+        uint16_t level1 : 1;
+    };
+    uint32_t val;
+} rmt_symbol_word_t;
+
+typedef struct
+{
+    rmt_symbol_word_t* received_symbols;
+    size_t num_symbols;
+    struct
+    {
+        uint32_t is_last : 1;
+    } flags;
+} rmt_rx_done_event_data_t;
+
+typedef struct
+{
+    size_t num_symbols;
+} rmt_tx_done_event_data_t;
+
+typedef bool (*rmt_rx_done_callback_t)(rmt_channel_handle_t rxChannel, const rmt_rx_done_event_data_t* edata, void* userCtx);
+typedef bool (*rmt_tx_done_callback_t)(rmt_channel_handle_t txChannel, const rmt_tx_done_event_data_t* edata, void* userCtx);
@@ -0,0 +1,20 @@
+/*!****************************************************************************
+ * @file    spi_master.h
+ * @brief   Host stand-in for the SPI master driver (types only; the display
+ *          driver is replaced on the host).
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#pragma once
+
+#include "driver/gpio.h"
+#include "esp_err.h"
+
+typedef enum
+{
+    SPI1_HOST = 0,
+    SPI2_HOST = 1,
+    SPI3_HOST = 2,
+    SPI_HOST_MAX,
+} spi_host_device_t;
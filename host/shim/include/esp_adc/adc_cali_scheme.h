@@ -0,0 +1,21 @@
+/*!****************************************************************************
+ * @file    adc_cali_scheme.h
+ * @brief   Host stand-in for the line-fitting calibration scheme.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#pragma once
+
+#include "esp_adc/adc_cali.h"
+
+typedef struct
+{
+    adc_unit_t unit_id;
+    adc_atten_t atten;
+    adc_bitwidth_t bitwidth;
+    uint32_t default_vref;
+} adc_cali_line_fitting_config_t;
+
+esp_err_t adc_cali_create_scheme_line_fitting(const adc_cali_line_fitting_config_t* config, adc_cali_handle_t* retHandle);
+esp_err_t adc_cali_delete_scheme_line_fitting(adc_cali_handle_t handle);
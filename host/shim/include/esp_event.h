@@ -0,0 +1,37 @@
+/*!****************************************************************************
+ * @file    esp_event.h
+ * @brief   Host stand-in for the default event loop. Posted events are
+ *          delivered on a dedicated "sys_evt" thread like on the target.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#pragma once
+
+#include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+#include <stddef.h>
+#include <stdint.h>
+
+typedef const char* esp_event_base_t;
+typedef void* esp_event_handler_instance_t;
+typedef void (*esp_event_handler_t)(void* eventHandlerArg, esp_event_base_t eventBase, int32_t eventId, void* eventData);
+
+#define ESP_EVENT_ANY_BASE              nullptr
+#define ESP_EVENT_ANY_ID                -1
+
+#define ESP_EVENT_DECLARE_BASE(id)      extern esp_event_base_t const id
+#define ESP_EVENT_DEFINE_BASE(id)       esp_event_base_t const id = #id
+
+esp_err_t esp_event_loop_create_default(void);
+esp_err_t esp_event_loop_delete_default(void);
+
+esp_err_t esp_event_handler_register(esp_event_base_t eventBase, int32_t eventId, esp_event_handler_t eventHandler, void* eventHandlerArg);
+esp_err_t esp_event_handler_unregister(esp_event_base_t eventBase, int32_t eventId, esp_event_handler_t eventHandler);
+esp_err_t esp_event_handler_instance_register(esp_event_base_t eventBase, int32_t eventId, esp_event_handler_t eventHandler, void* eventHandlerArg, esp_event_handler_instance_t* instance);
+esp_err_t esp_event_handler_instance_unregister(esp_event_base_t eventBase, int32_t eventId, esp_event_handler_instance_t instance);
+
+/**
+ * @brief Copy the event data and queue it for the event thread.
+ */
+esp_err_t esp_event_post(esp_event_base_t eventBase, int32_t eventId, const void* eventData, size_t eventDataSize, TickType_t ticksToWait);
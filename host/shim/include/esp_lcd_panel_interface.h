@@ -0,0 +1,10 @@
+/*!****************************************************************************
+ * @file    esp_lcd_panel_interface.h
+ * @brief   Host stand-in (types only; the display driver is replaced on the host).
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#pragma once
+
+#include "esp_lcd_types.h"
@@ -0,0 +1,14 @@
+/*!****************************************************************************
+ * @file    esp_lcd_types.h
+ * @brief   Host stand-in for the LCD panel handle types.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#pragma once
+
+#include "esp_err.h"
+
+typedef struct esp_lcd_panel_t* esp_lcd_panel_handle_t;
+typedef struct esp_lcd_panel_io_t* esp_lcd_panel_io_handle_t;
+typedef struct esp_lcd_touch_s* esp_lcd_touch_handle_t;
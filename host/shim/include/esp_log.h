@@ -0,0 +1,43 @@
+/*!****************************************************************************
+ * @file    esp_log.h
+ * @brief   Host stand-in for the ESP-IDF logging macros (printed to stdout).
+ *          HOST_LOG_LEVEL=E|W|I|D|V selects the default level at startup.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#pragma once
+
+#include <stdint.h>
+
+typedef enum
+{
+    ESP_LOG_NONE,
+    ESP_LOG_ERROR,
+    ESP_LOG_WARN,
+    ESP_LOG_INFO,
+    ESP_LOG_DEBUG,
+    ESP_LOG_VERBOSE
+} esp_log_level_t;
+
+void esp_log_write(esp_log_level_t level, const char* tag, const char* format, ...) __attribute__((format(printf, 3, 4)));
+void esp_log_level_set(const char* tag, esp_log_level_t level);
+esp_log_level_t esp_log_level_get(const char* tag);
+uint32_t esp_log_timestamp(void);
+
+#define HOST_LOG_LEVEL_LOCAL(level, letter, tag, format, ...)                                                          \
+    do                                                                                                                  \
+    {                                                                                                                   \
+        if (esp_log_level_get(tag) >= (level))                                                                          \
+        {                                                                                                               \
+            esp_log_write((level), (tag), letter " (%lu) %s: " format "\n",                                             \
+                          static_cast<unsigned long>(esp_log_timestamp()), (tag), ##__VA_ARGS__);                       \
+        }                                                                                                               \
+    }                                                                                                                   \
+    while (0)
+
+#define ESP_LOGE(tag, format, ...)  HOST_LOG_LEVEL_LOCAL(ESP_LOG_ERROR,   "E", tag, format, ##__VA_ARGS__)
+#define ESP_LOGW(tag, format, ...)  HOST_LOG_LEVEL_LOCAL(ESP_LOG_WARN,    "W", tag, format, ##__VA_ARGS__)
+#define ESP_LOGI(tag, format, ...)  HOST_LOG_LEVEL_LOCAL(ESP_LOG_INFO,    "I", tag, format, ##__VA_ARGS__)
+#define ESP_LOGD(tag, format, ...)  HOST_LOG_LEVEL_LOCAL(ESP_LOG_DEBUG,   "D", tag, format, ##__VA_ARGS__)
+#define ESP_LOGV(tag, format, ...)  HOST_LOG_LEVEL_LOCAL(ESP_LOG_VERBOSE, "V", tag, format, ##__VA_ARGS__)
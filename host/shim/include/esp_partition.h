@@ -0,0 +1,57 @@
+/*!****************************************************************************
+ * @file    esp_partition.h
+ * @brief   Host stand-in for the ESP-IDF partition API. The data partitions
+ *          of partitions.csv are emulated as NOR flash (see partition.cpp).
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#pragma once
+
+#include "esp_err.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef enum
+{
+    ESP_PARTITION_TYPE_APP = 0x00,
+    ESP_PARTITION_TYPE_DATA = 0x01,
+} esp_partition_type_t;
+
+typedef enum
+{
+    ESP_PARTITION_SUBTYPE_DATA_NVS = 0x02,
+    ESP_PARTITION_SUBTYPE_DATA_SPIFFS = 0x82,
+    ESP_PARTITION_SUBTYPE_ANY = 0xff,
+} esp_partition_subtype_t;
+
+typedef struct
+{
+    void* flash_chip;
+    esp_partition_type_t type;
+    esp_partition_subtype_t subtype;
+    uint32_t address;
+    uint32_t size;
+    uint32_t erase_size;
+    char label[17];
+    bool encrypted;
+    bool readonly;
+} esp_partition_t;
+
+/**
+ * @brief First partition matching type, subtype and label (nullptr label: any).
+ */
+const esp_partition_t* esp_partition_find_first(esp_partition_type_t type, esp_partition_subtype_t subtype, const char* label);
+
+esp_err_t esp_partition_read(const esp_partition_t* partition, size_t src_offset, void* dst, size_t size);
+
+/**
+ * @brief Programs bytes: bits can only go from 1 to 0, as on NOR flash.
+ */
+esp_err_t esp_partition_write(const esp_partition_t* partition, size_t dst_offset, const void* src, size_t size);
+
+/**
+ * @brief Erases whole sectors back to 0xFF. Offset and size must be sector aligned.
+ */
+esp_err_t esp_partition_erase_range(const esp_partition_t* partition, size_t offset, size_t size);
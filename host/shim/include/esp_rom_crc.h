@@ -0,0 +1,16 @@
+/*!****************************************************************************
+ * @file    esp_rom_crc.h
+ * @brief   Host stand-in for the ROM CRC helpers.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * @brief CRC-32 (IEEE 802.3, reflected), chained like the ROM version:
+ *        esp_rom_crc32_le(0, data, len) is the usual zlib CRC.
+ */
+uint32_t esp_rom_crc32_le(uint32_t crc, const uint8_t* buf, uint32_t len);
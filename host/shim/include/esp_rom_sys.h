@@ -0,0 +1,16 @@
+/*!****************************************************************************
+ * @file    esp_rom_sys.h
+ * @brief   Host stand-in for the ROM busy-wait helpers.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * @brief Busy-wait for the given microseconds. Also advances the bit-timing
+ *        timeline used by the simulated 1-Wire bus (see host_time.h).
+ */
+void esp_rom_delay_us(uint32_t us);
@@ -0,0 +1,35 @@
+/*!****************************************************************************
+ * @file    esp_sntp.h
+ * @brief   Host stand-in for SNTP. "Synchronisation" reports the host clock
+ *          shortly after esp_sntp_init() when the simulated network is up.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#pragma once
+
+#include <stdint.h>
+#include <sys/time.h>
+
+typedef void (*sntp_sync_time_cb_t)(struct timeval* tv);
+
+typedef enum
+{
+    SNTP_OPMODE_POLL = 0,
+    SNTP_OPMODE_LISTENONLY,
+} esp_sntp_operatingmode_t;
+
+typedef enum
+{
+    SNTP_SYNC_STATUS_RESET,
+    SNTP_SYNC_STATUS_COMPLETED,
+    SNTP_SYNC_STATUS_IN_PROGRESS,
+} sntp_sync_status_t;
+
+void esp_sntp_setoperatingmode(esp_sntp_operatingmode_t operatingMode);
+void esp_sntp_setservername(uint8_t idx, const char* server);
+void sntp_set_time_sync_notification_cb(sntp_sync_time_cb_t callback);
+void esp_sntp_init(void);
+void esp_sntp_stop(void);
+bool esp_sntp_enabled(void);
+sntp_sync_status_t sntp_get_sync_status(void);
@@ -0,0 +1,19 @@
+/*!****************************************************************************
+ * @file    esp_system.h
+ * @brief   Host stand-in for esp_system (restart and heap queries).
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#pragma once
+
+#include "esp_err.h"
+#include <stdint.h>
+
+/**
+ * @brief Terminates the host process (there is nothing to reboot into).
+ */
+[[noreturn]] void esp_restart(void);
+
+uint32_t esp_get_free_heap_size(void);
+uint32_t esp_get_minimum_free_heap_size(void);
@@ -0,0 +1,66 @@
+/*!****************************************************************************
+ * @file    FreeRTOS.h
+ * @brief   Host stand-in for the FreeRTOS base definitions.
+ *          Tasks are pthreads, ticks are milliseconds of the virtual esp_timer.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <mutex>
+
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+typedef uint32_t TickType_t;
+typedef uint32_t StackType_t;
+
+#define pdFALSE                     ((BaseType_t)0)
+#define pdTRUE                      ((BaseType_t)1)
+#define pdFAIL                      pdFALSE
+#define pdPASS                      pdTRUE
+#define errQUEUE_FULL               ((BaseType_t)0)
+#define errQUEUE_EMPTY              ((BaseType_t)0)
+
+#define configTICK_RATE_HZ          1000
+#define configMAX_PRIORITIES        25
+#define configMINIMAL_STACK_SIZE    768
+#define configMAX_TASK_NAME_LEN     16
+#define portMAX_DELAY               ((TickType_t)0xFFFFFFFFUL)
+#define portTICK_PERIOD_MS          ((TickType_t)(1000 / configTICK_RATE_HZ))
+#define pdMS_TO_TICKS(ms)           ((TickType_t)(((uint64_t)(ms) * configTICK_RATE_HZ) / 1000U))
+#define pdTICKS_TO_MS(ticks)        ((uint32_t)(((uint64_t)(ticks) * 1000U) / configTICK_RATE_HZ))
+#define portNUM_PROCESSORS          2
+#define tskNO_AFFINITY              ((BaseType_t)0x7FFFFFFF)
+
+//! Critical sections map to a recursive mutex; there are no interrupts to mask on the host
+struct portMUX_TYPE
+{
+    std::recursive_mutex lock;
+};
+
+/**
+ * @brief Lock the mux; the outermost section of a task is timed when
+ *        HostBus::SetCriticalTiming() is on (what interrupts would stay masked for).
+ */
+void vHostEnterCritical(portMUX_TYPE* mux);
+void vHostExitCritical(portMUX_TYPE* mux);
+
+#define portMUX_INITIALIZER_UNLOCKED    {}
+#define portENTER_CRITICAL(mux)         vHostEnterCritical(mux)
+#define portEXIT_CRITICAL(mux)          vHostExitCritical(mux)
+#define portENTER_CRITICAL_ISR(mux)     portENTER_CRITICAL(mux)
+#define portEXIT_CRITICAL_ISR(mux)      portEXIT_CRITICAL(mux)
+#define portENTER_CRITICAL_SAFE(mux)    portENTER_CRITICAL(mux)
+#define portEXIT_CRITICAL_SAFE(mux)     portEXIT_CRITICAL(mux)
+#define taskENTER_CRITICAL(mux)         portENTER_CRITICAL(mux)
+#define taskEXIT_CRITICAL(mux)          portEXIT_CRITICAL(mux)
+#define portYIELD_FROM_ISR(x)           ((void)(x))
+#define portYIELD()                     taskYIELD()
+
+/**
+ * @brief Core the calling task is "running" on (as set when the task was pinned).
+ */
+BaseType_t xPortGetCoreID(void);
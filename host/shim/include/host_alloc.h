@@ -0,0 +1,37 @@
+/*!****************************************************************************
+ * @file    host_alloc.h
+ * @brief   Marks the heap allocations made by the host stand-ins themselves
+ *          (e.g. the simulated broker copying a message), so a test counting
+ *          allocations with its own operator new only sees the firmware's.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#pragma once
+
+namespace HostAlloc {
+
+inline thread_local int t_shimDepth = 0;
+
+/**
+ * @brief Allocations of the calling thread belong to the shim while alive.
+ */
+class ShimScope
+{
+    public:
+        ShimScope() { ++t_shimDepth; }
+        ~ShimScope() { --t_shimDepth; }
+
+        ShimScope(const ShimScope&) = delete;
+        ShimScope& operator=(const ShimScope&) = delete;
+};
+
+/**
+ * @brief Whether the calling thread is inside a ShimScope.
+ */
+inline bool InShim()
+{
+    return t_shimDepth > 0;
+}
+
+} // namespace HostAlloc
@@ -0,0 +1,134 @@
+/*!****************************************************************************
+ * @file    host_bus.h
+ * @brief   Attachment points the host stand-ins expose to simulated devices.
+ *          The GPIO, I2C and ADC shims forward bus activity to whatever
+ *          device model is attached; see host/sim for the models.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#pragma once
+
+#include "driver/gpio.h"
+#include "hal/adc_types.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+namespace HostBus {
+
+/**
+ * @brief Device wired to a GPIO pin (open-drain buses such as 1-Wire).
+ */
+class IGpioDevice
+{
+    public:
+
+        virtual ~IGpioDevice() = default;
+
+        /**
+         * @brief The firmware changed the output level of the pin.
+         */
+        virtual void OnPinWrite(gpio_num_t pin, int level) = 0;
+
+        /**
+         * @brief The firmware samples the pin.
+         * @return int 0 when the device pulls the line low, 1 when it releases it.
+         */
+        virtual int OnPinRead(gpio_num_t pin) = 0;
+};
+
+/**
+ * @brief Device on an I2C bus. Returning false NACKs the transfer.
+ */
+class II2cDevice
+{
+    public:
+
+        virtual ~II2cDevice() = default;
+
+        virtual bool OnWrite(const uint8_t* data, size_t length) = 0;
+        virtual bool OnRead(uint8_t* data, size_t length) = 0;
+};
+
+/**
+ * @brief Attach a device to a pin, replacing any previous one (nullptr detaches).
+ */
+void AttachGpioDevice(gpio_num_t pin, IGpioDevice* device);
+
+/**
+ * @brief Level seen on an input pin with no attached device.
+ */
+void SetInputLevel(gpio_num_t pin, int level);
+
+/**
+ * @brief Last level written by the firmware to the pin.
+ */
+int GetOutputLevel(gpio_num_t pin);
+
+/**
+ * @brief Attach a device to an I2C port at the given 7-bit address.
+ */
+void AttachI2cDevice(int port, uint16_t address, II2cDevice* device);
+
+/**
+ * @brief Voltage presented to an ADC1 channel, before attenuation.
+ */
+void SetAdcVoltage(adc_channel_t channel, float volts);
+
+/**
+ * @brief Replay recorded raw codes (0-4095) on an ADC1 channel, in a loop,
+ *        instead of converting its voltage. An empty capture stops the replay.
+ */
+void SetAdcReplay(adc_channel_t channel, std::vector<uint16_t> codes);
+
+/**
+ * @brief Duty last applied to a LEDC channel (0 when never configured).
+ */
+uint32_t GetPwmDuty(int channel);
+
+/**
+ * @brief Keep the emulated flash partitions in a file, loaded now and
+ *        updated on every program and erase. Call before the firmware starts.
+ */
+void SetFlashFile(const char* path);
+
+/**
+ * @brief Cut the power after 'bytes' more bytes are programmed: the byte at the
+ *        cut is left half programmed (an erase started once the budget is spent
+ *        is left half done), and every later program or erase fails until
+ *        RestoreFlashPower().
+ */
+void SetFlashPowerCut(size_t bytes);
+void RestoreFlashPower();
+
+struct FlashStats
+{
+    uint32_t programCalls;
+    uint32_t bytesProgrammed;
+    uint32_t sectorErases;
+    uint32_t maxSectorErases;           //!< Most erases of any one sector
+};
+
+FlashStats GetFlashStats();
+
+/**
+ * @brief Time the critical sections of every task from now on (off by default:
+ *        reading the clock costs more than some of the sections).
+ */
+void SetCriticalTiming(bool enabled);
+
+struct CriticalStats
+{
+    uint32_t sections;                  //!< Outermost sections left
+    uint64_t longestUs;
+    uint64_t totalUs;
+};
+
+/**
+ * @brief Critical sections of the calling task while timing was on, then cleared.
+ */
+CriticalStats TakeCriticalStats();
+
+} // namespace HostBus
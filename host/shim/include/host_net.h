@@ -0,0 +1,56 @@
+/*!****************************************************************************
+ * @file    host_net.h
+ * @brief   Controls of the simulated network stack behind the WiFi, HTTP
+ *          server and MQTT stand-ins (access point, broker, HTTP client).
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#pragma once
+
+#include <stddef.h>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace HostNet {
+
+/**
+ * @brief Whether station connects succeed. Going unreachable while connected
+ *        posts WIFI_EVENT_STA_DISCONNECTED.
+ */
+void SetWifiReachable(bool reachable);
+
+/**
+ * @brief Whether the MQTT broker accepts connections.
+ */
+void SetBrokerReachable(bool reachable);
+
+/**
+ * @brief Publish a message from the broker side; delivered to every started
+ *        client whose subscription matches (MQTT '+' and '#' wildcards).
+ * @return size_t Number of clients the message was delivered to.
+ */
+size_t BrokerPublish(const std::string& topic, const std::string& payload);
+
+/**
+ * @brief Messages published by the firmware since the last call.
+ */
+std::vector<std::pair<std::string, std::string>> TakePublished();
+
+/**
+ * @brief Total number of messages published by the firmware.
+ */
+size_t GetPublishedCount();
+
+/**
+ * @brief Run a request through the registered httpd handlers.
+ * @param method HTTP_GET / HTTP_POST etc. (httpd_method_t value).
+ * @param uri Request path.
+ * @param body Request body (may be empty).
+ * @param response Filled with the response body.
+ * @return int HTTP status code; 404 when no handler matches.
+ */
+int HttpRequest(int method, const std::string& uri, const std::string& body, std::string& response);
+
+} // namespace HostNet
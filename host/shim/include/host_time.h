@@ -0,0 +1,72 @@
+/*!****************************************************************************
+ * @file    host_time.h
+ * @brief   Time base shared by the host stand-ins.
+ *          Virtual time is the process monotonic time plus an offset that
+ *          can be advanced to fast-forward timers and delays.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <stdint.h>
+#include <mutex>
+
+namespace HostTime {
+
+/**
+ * @brief Virtual monotonic time in microseconds since process start.
+ */
+uint64_t NowUs();
+
+/**
+ * @brief Jump virtual time forward and wake every timed wait so it re-evaluates.
+ * @param deltaUs Microseconds to add.
+ */
+void Advance(uint64_t deltaUs);
+
+/**
+ * @brief Total microseconds spent in esp_rom_delay_us() by all tasks.
+ *        Used as the bit-level timeline of simulated buses.
+ */
+uint64_t RomDelayTotalUs();
+
+/**
+ * @brief Move the bit-level timeline forward without spending the time.
+ *        Used by peripherals that time the bus in hardware (RMT).
+ */
+void AdvanceRomDelay(uint64_t deltaUs);
+
+/**
+ * @brief Sleep the calling thread until the virtual time reaches deadlineUs.
+ */
+void SleepUntilUs(uint64_t deadlineUs);
+
+/**
+ * @brief Wait on a condition variable until pred() holds or the virtual deadline passes.
+ *        Waits are sliced so an Advance() is noticed promptly.
+ * @return bool The value of pred() when returning.
+ */
+template <typename Predicate>
+bool WaitUntil(std::condition_variable& cv, std::unique_lock<std::mutex>& lock, uint64_t deadlineUs, Predicate pred)
+{
+    static constexpr uint64_t MAX_SLICE_US = 20000;
+
+    while (!pred())
+    {
+        const uint64_t now = NowUs();
+        if (now >= deadlineUs)
+        {
+            return pred();
+        }
+
+        const uint64_t slice = (deadlineUs - now < MAX_SLICE_US) ? (deadlineUs - now) : MAX_SLICE_US;
+        cv.wait_for(lock, std::chrono::microseconds(slice));
+    }
+
+    return true;
+}
+
+} // namespace HostTime
@@ -0,0 +1,31 @@
+/*!****************************************************************************
+ * @file    lvgl.h
+ * @brief   Host stand-in for the small part of LVGL visible outside the
+ *          display driver. Objects only keep text and visibility state.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#pragma once
+
+#include <stdint.h>
+#include <string>
+
+typedef struct _lv_obj_t
+{
+    const char* name;
+    std::string text;
+    bool hidden;
+    bool state1;
+} lv_obj_t;
+
+typedef struct _lv_timer_t lv_timer_t;
+typedef struct _lv_event_t lv_event_t;
+typedef struct _lv_display_t lv_display_t;
+
+/**
+ * @brief Make the given object the active screen.
+ */
+void lv_screen_load(lv_obj_t* screen);
+
+#define lv_disp_load_scr    lv_screen_load
@@ -0,0 +1,20 @@
+/*!****************************************************************************
+ * @file    ip4_addr.h
+ * @brief   Host stand-in for the lwIP IPv4 address helpers.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#pragma once
+
+#include <stdint.h>
+
+typedef struct
+{
+    uint32_t addr;
+} ip4_addr_t;
+
+//! Stored in network byte order like lwIP (little-endian host)
+#define IP4_ADDR(ipaddr, a, b, c, d)                                                    \
+    (ipaddr)->addr = ((uint32_t)((d) & 0xFF) << 24) | ((uint32_t)((c) & 0xFF) << 16) | \
+                     ((uint32_t)((b) & 0xFF) << 8)  |  (uint32_t)((a) & 0xFF)
@@ -0,0 +1,10 @@
+/*!****************************************************************************
+ * @file    ip_addr.h
+ * @brief   Host stand-in for the lwIP generic address header.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#pragma once
+
+#include "lwip/ip4_addr.h"
@@ -0,0 +1,44 @@
+/*!****************************************************************************
+ * @file    ui.h
+ * @brief   Host stand-in for the SquareLine generated UI. Declares the
+ *          widgets used by the managers; they are defined by the host display.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#pragma once
+
+#include "lvgl.h"
+
+#define HOST_UI_OBJECTS(X)      \
+    X(ui_Screen)                \
+    X(ui_SplashScreen)          \
+    X(ui_lblTime)               \
+    X(ui_imgBatteryFull)        \
+    X(ui_imgBatteryHigh)        \
+    X(ui_imgBatteryMedium)      \
+    X(ui_imgBatteryLow)         \
+    X(ui_imgBatteryCritical)    \
+    X(ui_imgWiFiOff)            \
+    X(ui_imgWifiOn)             \
+    X(ui_imgCloudOff)           \
+    X(ui_imgCloudOn)            \
+    X(ui_imgAPActive)           \
+    X(ui_lblTdsValue)           \
+    X(ui_lblTdsLimitMax)        \
+    X(ui_lblTdsLimitMin)        \
+    X(ui_panelTdsAlert)         \
+    X(ui_lblTempValue)          \
+    X(ui_lblTempLimitMax)       \
+    X(ui_lblTempLimitMin)       \
+    X(ui_panelTempAlert)        \
+    X(ui_panelFeeder)           \
+    X(ui_lblNextFeedTime)       \
+    X(ui_lblDosesPerDay)        \
+    X(ui_lblDosesLeft)
+
+#define HOST_UI_DECLARE(name)   extern lv_obj_t* name;
+HOST_UI_OBJECTS(HOST_UI_DECLARE)
+#undef HOST_UI_DECLARE
+
+void ui_init(void);
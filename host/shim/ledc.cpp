@@ -0,0 +1,168 @@
+/*!****************************************************************************
+ * @file    ledc.cpp
+ * @brief   Host implementation of the LEDC PWM driver. Duties are stored per
+ *          channel; blocking fades take their configured time.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#include "driver/ledc.h"
+#include "host_bus.h"
+#include "host_time.h"
+
+#include <array>
+#include <mutex>
+
+namespace {
+
+struct ChannelState
+{
+    bool configured = false;
+    uint32_t pendingDuty = 0;
+    uint32_t duty = 0;
+    int fadeTimeMs = 0;
+};
+
+std::mutex s_mutex;
+std::array<ChannelState, LEDC_CHANNEL_MAX> s_channels;
+
+//-----------------------------------------------------------------------------
+bool IsValid(ledc_channel_t channel)
+{
+    return (channel >= LEDC_CHANNEL_0) && (channel < LEDC_CHANNEL_MAX);
+}
+
+} // namespace
+
+//-----------------------------------------------------------------------------
+esp_err_t ledc_timer_config(const ledc_timer_config_t* timerConf)
+{
+    return (timerConf != nullptr && timerConf->freq_hz > 0) ? ESP_OK : ESP_ERR_INVALID_ARG;
+}
+
+//-----------------------------------------------------------------------------
+esp_err_t ledc_channel_config(const ledc_channel_config_t* ledcConf)
+{
+    if (ledcConf == nullptr || !IsValid(ledcConf->channel))
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    std::lock_guard<std::mutex> guard(s_mutex);
+    ChannelState& state = s_channels[ledcConf->channel];
+    state.configured = true;
+    state.duty = ledcConf->duty;
+    state.pendingDuty = ledcConf->duty;
+    return ESP_OK;
+}
+
+//-----------------------------------------------------------------------------
+esp_err_t ledc_fade_func_install(int /*intrAllocFlags*/)
+{
+    return ESP_OK;
+}
+
+//-----------------------------------------------------------------------------
+esp_err_t ledc_set_duty(ledc_mode_t /*speedMode*/, ledc_channel_t channel, uint32_t duty)
+{
+    if (!IsValid(channel))
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    std::lock_guard<std::mutex> guard(s_mutex);
+    s_channels[channel].pendingDuty = duty;
+    return ESP_OK;
+}
+
+//-----------------------------------------------------------------------------
+esp_err_t ledc_update_duty(ledc_mode_t /*speedMode*/, ledc_channel_t channel)
+{
+    if (!IsValid(channel))
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    std::lock_guard<std::mutex> guard(s_mutex);
+    s_channels[channel].duty = s_channels[channel].pendingDuty;
+    return ESP_OK;
+}
+
+//-----------------------------------------------------------------------------
+uint32_t ledc_get_duty(ledc_mode_t /*speedMode*/, ledc_channel_t channel)
+{
+    if (!IsValid(channel))
+    {
+        return 0;
+    }
+
+    std::lock_guard<std::mutex> guard(s_mutex);
+    return s_channels[channel].duty;
+}
+
+//-----------------------------------------------------------------------------
+esp_err_t ledc_set_fade_with_time(ledc_mode_t /*speedMode*/, ledc_channel_t channel, uint32_t targetDuty, int maxFadeTimeMs)
+{
+    if (!IsValid(channel))
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    std::lock_guard<std::mutex> guard(s_mutex);
+    s_channels[channel].pendingDuty = targetDuty;
+    s_channels[channel].fadeTimeMs = maxFadeTimeMs;
+    return ESP_OK;
+}
+
+//-----------------------------------------------------------------------------
+esp_err_t ledc_fade_start(ledc_mode_t /*speedMode*/, ledc_channel_t channel, ledc_fade_mode_t fadeMode)
+{
+    if (!IsValid(channel))
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    int fadeTimeMs;
+    {
+        std::lock_guard<std::mutex> guard(s_mutex);
+        fadeTimeMs = s_channels[channel].fadeTimeMs;
+    }
+
+    if (fadeMode == LEDC_FADE_WAIT_DONE && fadeTimeMs > 0)
+    {
+        HostTime::SleepUntilUs(HostTime::NowUs() + (static_cast<uint64_t>(fadeTimeMs) * 1000ULL));
+    }
+
+    return ledc_update_duty(LEDC_HIGH_SPEED_MODE, channel);
+}
+
+//-----------------------------------------------------------------------------
+esp_err_t ledc_stop(ledc_mode_t /*speedMode*/, ledc_channel_t channel, uint32_t /*idleLevel*/)
+{
+    if (!IsValid(channel))
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    std::lock_guard<std::mutex> guard(s_mutex);
+    s_channels[channel].duty = 0;
+    s_channels[channel].pendingDuty = 0;
+    return ESP_OK;
+}
+
+//----HostBus------------------------------------------------------------------
+namespace HostBus {
+
+//-----------------------------------------------------------------------------
+uint32_t GetPwmDuty(int channel)
+{
+    if (!IsValid(static_cast<ledc_channel_t>(channel)))
+    {
+        return 0;
+    }
+
+    std::lock_guard<std::mutex> guard(s_mutex);
+    return s_channels[channel].duty;
+}
+
+} // namespace HostBus
@@ -0,0 +1,414 @@
+/*!****************************************************************************
+ * @file    mqtt_client.cpp
+ * @brief   Host implementation of esp-mqtt against an in-process broker.
+ *          Each started client owns an "mqtt_task" that dispatches its
+ *          events, so handlers run off the caller's thread as on target.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#include "freertos/task.h"
+#include "host_alloc.h"
+#include "host_net.h"
+#include "host_time.h"
+#include "mqtt_client.h"
+
+#include <atomic>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <vector>
+
+struct esp_mqtt_client
+{
+    std::string uri;
+
+    esp_event_handler_t handler = nullptr;
+    void* handlerArg = nullptr;
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::deque<esp_mqtt_event_t> events;
+    std::deque<std::pair<std::string, std::string>> eventStorage;
+    std::vector<std::string> subscriptions;
+    bool running = false;
+    bool connected = false;
+    bool taskStarted = false;
+    int nextMsgId = 1;
+};
+
+namespace {
+
+static constexpr uint64_t CONNECT_TIME_US = 50000;
+
+std::mutex s_brokerMutex;
+std::vector<esp_mqtt_client*> s_clients;
+std::vector<std::pair<std::string, std::string>> s_published;
+size_t s_publishedTotal = 0;
+std::atomic<bool> s_brokerReachable{true};
+
+//-----------------------------------------------------------------------------
+bool TopicMatches(const std::string& filter, const std::string& topic)
+{
+    size_t f = 0;
+    size_t t = 0;
+
+    while (f < filter.size())
+    {
+        if (filter[f] == '#')
+        {
+            return true;
+        }
+
+        const size_t filterEnd = filter.find('/', f);
+        const size_t topicEnd = topic.find('/', t);
+        const std::string filterLevel = filter.substr(f, filterEnd - f);
+
+        if (t > topic.size())
+        {
+            return false;
+        }
+
+        const std::string topicLevel = topic.substr(t, topicEnd - t);
+        if (filterLevel != "+" && filterLevel != topicLevel)
+        {
+            return false;
+        }
+
+        if (filterEnd == std::string::npos)
+        {
+            return topicEnd == std::string::npos;
+        }
+        if (topicEnd == std::string::npos)
+        {
+            // "a/#" also matches "a"
+            return filter.compare(filterEnd + 1, std::string::npos, "#") == 0;
+        }
+
+        f = filterEnd + 1;
+        t = topicEnd + 1;
+    }
+
+    return t >= topic.size();
+}
+
+//-----------------------------------------------------------------------------
+void PushEventLocked(esp_mqtt_client* client, esp_mqtt_event_id_t id, int msgId, const std::string& topic = "", const std::string& data = "")
+{
+    client->eventStorage.emplace_back(topic, data);
+    auto& stored = client->eventStorage.back();
+
+    esp_mqtt_event_t event = {};
+    event.event_id = id;
+    event.client = client;
+    event.msg_id = msgId;
+    event.topic = stored.first.empty() ? nullptr : &stored.first[0];
+    event.topic_len = static_cast<int>(stored.first.size());
+    event.data = stored.second.empty() ? nullptr : &stored.second[0];
+    event.data_len = static_cast<int>(stored.second.size());
+    event.total_data_len = event.data_len;
+
+    client->events.push_back(event);
+    client->cv.notify_all();
+}
+
+//-----------------------------------------------------------------------------
+void ClientTask(void* arg)
+{
+    esp_mqtt_client* client = static_cast<esp_mqtt_client*>(arg);
+    const uint64_t connectAtUs = HostTime::NowUs() + CONNECT_TIME_US;
+
+    std::unique_lock<std::mutex> lock(client->mutex);
+    while (true)
+    {
+        if (client->running && !client->connected && HostTime::NowUs() >= connectAtUs)
+        {
+            if (s_brokerReachable.load())
+            {
+                client->connected = true;
+                PushEventLocked(client, MQTT_EVENT_CONNECTED, 0);
+            }
+        }
+
+        HostTime::WaitUntil(client->cv, lock, HostTime::NowUs() + CONNECT_TIME_US, [client]() { return !client->events.empty(); });
+
+        while (!client->events.empty())
+        {
+            esp_mqtt_event_t event = client->events.front();
+            client->events.pop_front();
+
+            esp_event_handler_t handler = client->handler;
+            void* handlerArg = client->handlerArg;
+
+            lock.unlock();
+            if (handler != nullptr)
+            {
+                handler(handlerArg, "MQTT_EVENTS", event.event_id, &event);
+            }
+            lock.lock();
+
+            if (!client->eventStorage.empty())
+            {
+                client->eventStorage.pop_front();
+            }
+        }
+    }
+}
+
+} // namespace
+
+//-----------------------------------------------------------------------------
+esp_mqtt_client_handle_t esp_mqtt_client_init(const esp_mqtt_client_config_t* config)
+{
+    if (config == nullptr)
+    {
+        return nullptr;
+    }
+
+    esp_mqtt_client* client = new esp_mqtt_client();
+    client->uri = (config->broker.address.uri != nullptr) ? config->broker.address.uri : "";
+    return client;
+}
+
+//-----------------------------------------------------------------------------
+esp_err_t esp_mqtt_client_register_event(esp_mqtt_client_handle_t client, esp_mqtt_event_id_t /*event*/, esp_event_handler_t eventHandler, void* eventHandlerArg)
+{
+    if (client == nullptr)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    std::lock_guard<std::mutex> guard(client->mutex);
+    client->handler = eventHandler;
+    client->handlerArg = eventHandlerArg;
+    return ESP_OK;
+}
+
+//-----------------------------------------------------------------------------
+esp_err_t esp_mqtt_client_start(esp_mqtt_client_handle_t client)
+{
+    if (client == nullptr)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(client->mutex);
+        if (client->running)
+        {
+            return ESP_FAIL;
+        }
+        client->running = true;
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(s_brokerMutex);
+        s_clients.push_back(client);
+    }
+
+    if (!client->taskStarted)
+    {
+        client->taskStarted = true;
+        xTaskCreatePinnedToCore(&ClientTask, "mqtt_task", 6144, client, 5, nullptr, tskNO_AFFINITY);
+    }
+
+    return ESP_OK;
+}
+
+//-----------------------------------------------------------------------------
+esp_err_t esp_mqtt_client_stop(esp_mqtt_client_handle_t client)
+{
+    if (client == nullptr)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(s_brokerMutex);
+        for (auto it = s_clients.begin(); it != s_clients.end(); ++it)
+        {
+            if (*it == client)
+            {
+                s_clients.erase(it);
+                break;
+            }
+        }
+    }
+
+    std::lock_guard<std::mutex> guard(client->mutex);
+    client->running = false;
+    client->connected = false;
+    client->subscriptions.clear();
+    return ESP_OK;
+}
+
+//-----------------------------------------------------------------------------
+esp_err_t esp_mqtt_client_destroy(esp_mqtt_client_handle_t client)
+{
+    if (client == nullptr)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    // The client task may still be parked on the handle; keep it alive and
+    // only detach the handler so no further callbacks reach the firmware
+    esp_mqtt_client_stop(client);
+
+    std::lock_guard<std::mutex> guard(client->mutex);
+    client->handler = nullptr;
+    client->events.clear();
+    client->eventStorage.clear();
+    return ESP_OK;
+}
+
+//-----------------------------------------------------------------------------
+int esp_mqtt_client_publish(esp_mqtt_client_handle_t client, const char* topic, const char* data, int len, int /*qos*/, int /*retain*/)
+{
+    if (client == nullptr || topic == nullptr)
+    {
+        return -1;
+    }
+
+    // The broker's copy is not the firmware's allocation
+    HostAlloc::ShimScope shimScope;
+
+    int msgId;
+    {
+        std::lock_guard<std::mutex> guard(client->mutex);
+        if (!client->connected)
+        {
+            return -1;
+        }
+        msgId = client->nextMsgId++;
+    }
+
+    const std::string payload = (data == nullptr) ? std::string() : std::string(data, (len > 0) ? len : std::strlen(data));
+
+    std::lock_guard<std::mutex> guard(s_brokerMutex);
+    s_published.emplace_back(topic, payload);
+    s_publishedTotal++;
+    return msgId;
+}
+
+//-----------------------------------------------------------------------------
+int esp_mqtt_client_enqueue(esp_mqtt_client_handle_t client, const char* topic, const char* data, int len, int qos, int retain, bool /*store*/)
+{
+    return esp_mqtt_client_publish(client, topic, data, len, qos, retain);
+}
+
+//-----------------------------------------------------------------------------
+int esp_mqtt_client_subscribe(esp_mqtt_client_handle_t client, const char* topic, int /*qos*/)
+{
+    if (client == nullptr || topic == nullptr)
+    {
+        return -1;
+    }
+
+    std::lock_guard<std::mutex> guard(client->mutex);
+    if (!client->connected)
+    {
+        return -1;
+    }
+
+    const int msgId = client->nextMsgId++;
+    client->subscriptions.emplace_back(topic);
+    PushEventLocked(client, MQTT_EVENT_SUBSCRIBED, msgId);
+    return msgId;
+}
+
+//-----------------------------------------------------------------------------
+int esp_mqtt_client_unsubscribe(esp_mqtt_client_handle_t client, const char* topic)
+{
+    if (client == nullptr || topic == nullptr)
+    {
+        return -1;
+    }
+
+    std::lock_guard<std::mutex> guard(client->mutex);
+    const int msgId = client->nextMsgId++;
+    for (auto it = client->subscriptions.begin(); it != client->subscriptions.end(); ++it)
+    {
+        if (*it == topic)
+        {
+            client->subscriptions.erase(it);
+            break;
+        }
+    }
+
+    PushEventLocked(client, MQTT_EVENT_UNSUBSCRIBED, msgId);
+    return msgId;
+}
+
+//----HostNet------------------------------------------------------------------
+namespace HostNet {
+
+//-----------------------------------------------------------------------------
+void SetBrokerReachable(bool reachable)
+{
+    s_brokerReachable = reachable;
+    if (reachable)
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> brokerGuard(s_brokerMutex);
+    for (esp_mqtt_client* client : s_clients)
+    {
+        std::lock_guard<std::mutex> guard(client->mutex);
+        if (client->connected)
+        {
+            client->connected = false;
+            client->subscriptions.clear();
+            PushEventLocked(client, MQTT_EVENT_DISCONNECTED, 0);
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+size_t BrokerPublish(const std::string& topic, const std::string& payload)
+{
+    HostAlloc::ShimScope shimScope;
+    size_t delivered = 0;
+
+    std::lock_guard<std::mutex> brokerGuard(s_brokerMutex);
+    for (esp_mqtt_client* client : s_clients)
+    {
+        std::lock_guard<std::mutex> guard(client->mutex);
+        if (!client->connected)
+        {
+            continue;
+        }
+
+        for (const std::string& filter : client->subscriptions)
+        {
+            if (TopicMatches(filter, topic))
+            {
+                PushEventLocked(client, MQTT_EVENT_DATA, 0, topic, payload);
+                delivered++;
+                break;
+            }
+        }
+    }
+
+    return delivered;
+}
+
+//-----------------------------------------------------------------------------
+std::vector<std::pair<std::string, std::string>> TakePublished()
+{
+    HostAlloc::ShimScope shimScope;
+    std::lock_guard<std::mutex> guard(s_brokerMutex);
+    std::vector<std::pair<std::string, std::string>> published;
+    published.swap(s_published);
+    return published;
+}
+
+//-----------------------------------------------------------------------------
+size_t GetPublishedCount()
+{
+    std::lock_guard<std::mutex> guard(s_brokerMutex);
+    return s_publishedTotal;
+}
+
+} // namespace HostNet
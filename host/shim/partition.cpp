@@ -0,0 +1,297 @@
+/*!****************************************************************************
+ * @file    partition.cpp
+ * @brief   Host implementation of the partition API over an emulated NOR
+ *          flash: erased bytes read 0xFF, programming only clears bits,
+ *          sectors are erased whole. Programs and erases take the typical
+ *          time of the ESP32 flash, can be persisted to a file and can be
+ *          cut short to test recovery from a power loss. Also holds the ROM
+ *          CRC the flash formats use.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#include "esp_partition.h"
+#include "esp_rom_crc.h"
+#include "host_bus.h"
+#include "host_time.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace {
+
+static constexpr uint32_t SECTOR_SIZE = 4096;
+static constexpr uint32_t PAGE_SIZE = 256;
+static constexpr uint64_t PAGE_PROGRAM_US = 700;
+static constexpr uint64_t SECTOR_ERASE_US = 45000;
+
+// Data partitions of partitions.csv that the firmware opens (nvs has its own stand-in)
+const esp_partition_t s_partitions[] =
+{
+    { nullptr, ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_DATA_SPIFFS, 0x1E0000, 0x20000, SECTOR_SIZE, "spiffs", false, false },
+};
+
+std::mutex s_mutex;
+std::vector<uint8_t> s_flash;                   //!< All partitions, back to back
+std::vector<uint32_t> s_eraseCounts;            //!< Per sector
+std::string s_file;
+bool s_powerCutArmed = false;
+size_t s_bytesUntilCut = 0;
+bool s_powerOff = false;
+HostBus::FlashStats s_stats = {};
+
+//-----------------------------------------------------------------------------
+size_t FlashOffset(const esp_partition_t* partition)
+{
+    size_t offset = 0;
+    for (const esp_partition_t& entry : s_partitions)
+    {
+        if (&entry == partition)
+        {
+            break;
+        }
+        offset += entry.size;
+    }
+    return offset;
+}
+
+//-----------------------------------------------------------------------------
+void EnsureFlash()
+{
+    if (!s_flash.empty())
+    {
+        return;
+    }
+
+    size_t total = 0;
+    for (const esp_partition_t& entry : s_partitions)
+    {
+        total += entry.size;
+    }
+    s_flash.assign(total, 0xFF);
+    s_eraseCounts.assign(total / SECTOR_SIZE, 0);
+}
+
+//-----------------------------------------------------------------------------
+void Persist(size_t offset, size_t size)
+{
+    if (s_file.empty())
+    {
+        return;
+    }
+
+    if (FILE* file = std::fopen(s_file.c_str(), "r+b"))
+    {
+        std::fseek(file, static_cast<long>(offset), SEEK_SET);
+        std::fwrite(&s_flash[offset], 1, size, file);
+        std::fclose(file);
+    }
+}
+
+//-----------------------------------------------------------------------------
+bool InRange(const esp_partition_t* partition, size_t offset, size_t size)
+{
+    return (partition != nullptr) && (offset <= partition->size) && (size <= partition->size - offset);
+}
+
+} // namespace
+
+//-----------------------------------------------------------------------------
+const esp_partition_t* esp_partition_find_first(esp_partition_type_t type, esp_partition_subtype_t subtype, const char* label)
+{
+    for (const esp_partition_t& entry : s_partitions)
+    {
+        if (entry.type == type
+         && (subtype == ESP_PARTITION_SUBTYPE_ANY || entry.subtype == subtype)
+         && (label == nullptr || std::strcmp(entry.label, label) == 0))
+        {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+//-----------------------------------------------------------------------------
+esp_err_t esp_partition_read(const esp_partition_t* partition, size_t src_offset, void* dst, size_t size)
+{
+    if (!InRange(partition, src_offset, size) || dst == nullptr)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    std::lock_guard<std::mutex> guard(s_mutex);
+    EnsureFlash();
+    std::memcpy(dst, &s_flash[FlashOffset(partition) + src_offset], size);
+    return ESP_OK;
+}
+
+//-----------------------------------------------------------------------------
+esp_err_t esp_partition_write(const esp_partition_t* partition, size_t dst_offset, const void* src, size_t size)
+{
+    if (!InRange(partition, dst_offset, size) || src == nullptr)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    esp_err_t result = ESP_OK;
+    {
+        std::lock_guard<std::mutex> guard(s_mutex);
+        EnsureFlash();
+
+        if (s_powerOff)
+        {
+            return ESP_FAIL;
+        }
+
+        const size_t base = FlashOffset(partition) + dst_offset;
+        const auto* bytes = static_cast<const uint8_t*>(src);
+        size_t programmed = size;
+
+        if (s_powerCutArmed && s_bytesUntilCut < size)
+        {
+            programmed = s_bytesUntilCut;
+            s_powerOff = true;
+            s_powerCutArmed = false;
+            result = ESP_FAIL;
+        }
+        else if (s_powerCutArmed)
+        {
+            s_bytesUntilCut -= size;
+        }
+
+        for (size_t i = 0; i < programmed; ++i)
+        {
+            s_flash[base + i] &= bytes[i];
+        }
+
+        // The byte being programmed when the power went: only some of its bits made it
+        if (programmed < size)
+        {
+            s_flash[base + programmed] &= (bytes[programmed] | 0x0F);
+        }
+
+        ++s_stats.programCalls;
+        s_stats.bytesProgrammed += static_cast<uint32_t>(programmed);
+        Persist(base, std::min(programmed + 1, size));
+    }
+
+    HostTime::SleepUntilUs(HostTime::NowUs() + ((size + PAGE_SIZE - 1) / PAGE_SIZE) * PAGE_PROGRAM_US);
+    return result;
+}
+
+//-----------------------------------------------------------------------------
+esp_err_t esp_partition_erase_range(const esp_partition_t* partition, size_t offset, size_t size)
+{
+    if (!InRange(partition, offset, size) || (offset % SECTOR_SIZE) != 0 || (size % SECTOR_SIZE) != 0)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    esp_err_t result = ESP_OK;
+    {
+        std::lock_guard<std::mutex> guard(s_mutex);
+        EnsureFlash();
+
+        if (s_powerOff)
+        {
+            return ESP_FAIL;
+        }
+
+        const size_t base = FlashOffset(partition) + offset;
+        size_t erased = size;
+
+        // An erase is all or nothing for the program budget: a cut armed now interrupts it halfway
+        if (s_powerCutArmed && s_bytesUntilCut == 0)
+        {
+            erased = SECTOR_SIZE / 2;
+            s_powerOff = true;
+            s_powerCutArmed = false;
+            result = ESP_FAIL;
+        }
+
+        std::fill_n(s_flash.begin() + base, erased, 0xFF);
+
+        for (size_t sector = base / SECTOR_SIZE; sector < (base + size) / SECTOR_SIZE; ++sector)
+        {
+            ++s_eraseCounts[sector];
+            ++s_stats.sectorErases;
+            s_stats.maxSectorErases = std::max(s_stats.maxSectorErases, s_eraseCounts[sector]);
+        }
+
+        Persist(base, erased);
+    }
+
+    HostTime::SleepUntilUs(HostTime::NowUs() + (size / SECTOR_SIZE) * SECTOR_ERASE_US);
+    return result;
+}
+
+//-----------------------------------------------------------------------------
+uint32_t esp_rom_crc32_le(uint32_t crc, const uint8_t* buf, uint32_t len)
+{
+    crc = ~crc;
+    for (uint32_t i = 0; i < len; ++i)
+    {
+        crc ^= buf[i];
+        for (int bit = 0; bit < 8; ++bit)
+        {
+            crc = (crc >> 1) ^ (0xEDB88320U & (0U - (crc & 1U)));
+        }
+    }
+    return ~crc;
+}
+
+namespace HostBus {
+
+//-----------------------------------------------------------------------------
+void SetFlashFile(const char* path)
+{
+    std::lock_guard<std::mutex> guard(s_mutex);
+    EnsureFlash();
+    s_file = path;
+
+    if (FILE* file = std::fopen(path, "rb"))
+    {
+        const size_t loaded = std::fread(s_flash.data(), 1, s_flash.size(), file);
+        std::fclose(file);
+        if (loaded == s_flash.size())
+        {
+            return;
+        }
+    }
+
+    // New (or short) image: start from the current content
+    if (FILE* file = std::fopen(path, "wb"))
+    {
+        std::fwrite(s_flash.data(), 1, s_flash.size(), file);
+        std::fclose(file);
+    }
+}
+
+//-----------------------------------------------------------------------------
+void SetFlashPowerCut(size_t bytes)
+{
+    std::lock_guard<std::mutex> guard(s_mutex);
+    s_powerCutArmed = true;
+    s_bytesUntilCut = bytes;
+}
+
+//-----------------------------------------------------------------------------
+void RestoreFlashPower()
+{
+    std::lock_guard<std::mutex> guard(s_mutex);
+    s_powerCutArmed = false;
+    s_powerOff = false;
+}
+
+//-----------------------------------------------------------------------------
+FlashStats GetFlashStats()
+{
+    std::lock_guard<std::mutex> guard(s_mutex);
+    return s_stats;
+}
+
+} // namespace HostBus
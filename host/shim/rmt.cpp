@@ -0,0 +1,446 @@
+/*!****************************************************************************
+ * @file    rmt.cpp
+ * @brief   Host implementation of the RMT driver. A transmission plays its
+ *          symbols on the GPIO shim one microsecond at a time, advancing the
+ *          bit-level timeline instead of busy-waiting, and samples the
+ *          resolved line after every step. When a receive is armed on the
+ *          same pin the samples are run-length encoded into its buffer and
+ *          the receive callback runs once the line stays idle for
+ *          signal_range_max_ns, as the loopback wiring does on the target.
+ *          The caller then sleeps for the time the frame takes on the wire.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#include "driver/rmt_rx.h"
+#include "driver/rmt_tx.h"
+#include "host_time.h"
+
+#include <algorithm>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+struct rmt_encoder_t
+{
+    bool copy = false;                      //!< Copy encoder: the payload already is symbols
+    rmt_symbol_word_t bit0{};
+    rmt_symbol_word_t bit1{};
+    bool msbFirst = false;
+};
+
+struct rmt_channel_t
+{
+    bool tx = false;
+    gpio_num_t gpio = GPIO_NUM_NC;
+    uint32_t resolutionHz = 1000000;
+    size_t memBlockSymbols = 0;
+    bool enabled = false;
+
+    // Receiver only
+    rmt_rx_done_callback_t onReceiveDone = nullptr;
+    void* userData = nullptr;
+    rmt_symbol_word_t* buffer = nullptr;
+    size_t bufferSymbols = 0;
+    rmt_receive_config_t receiveConfig{};
+    bool armed = false;
+};
+
+namespace {
+
+static constexpr uint64_t MAX_TAIL_US = 5000;      //!< Longest capture after the transmission ends
+
+std::mutex s_mutex;
+std::vector<rmt_channel_t*> s_channels;
+
+//-----------------------------------------------------------------------------
+rmt_channel_t* TakeArmedReceiver(gpio_num_t gpio)
+{
+    std::lock_guard<std::mutex> guard(s_mutex);
+    for (rmt_channel_t* channel : s_channels)
+    {
+        if (!channel->tx && channel->gpio == gpio && channel->armed && channel->enabled)
+        {
+            channel->armed = false;
+            return channel;
+        }
+    }
+    return nullptr;
+}
+
+//-----------------------------------------------------------------------------
+uint64_t TicksToUs(uint32_t ticks, uint32_t resolutionHz)
+{
+    return std::max<uint64_t>(1, (static_cast<uint64_t>(ticks) * 1000000ULL + resolutionHz / 2) / resolutionHz);
+}
+
+//-----------------------------------------------------------------------------
+uint32_t UsToTicks(uint64_t us, uint32_t resolutionHz)
+{
+    const uint64_t ticks = (us * resolutionHz) / 1000000ULL;
+    return static_cast<uint32_t>(std::min<uint64_t>(ticks, 0x7FFF));
+}
+
+//-----------------------------------------------------------------------------
+void Encode(const rmt_encoder_t* encoder, const void* payload, size_t payloadBytes, std::vector<rmt_symbol_word_t>& symbols)
+{
+    if (encoder->copy)
+    {
+        const auto* source = static_cast<const rmt_symbol_word_t*>(payload);
+        symbols.assign(source, source + (payloadBytes / sizeof(rmt_symbol_word_t)));
+        return;
+    }
+
+    const auto* bytes = static_cast<const uint8_t*>(payload);
+    for (size_t i = 0; i < payloadBytes; ++i)
+    {
+        for (int bit = 0; bit < 8; ++bit)
+        {
+            const int shift = encoder->msbFirst ? (7 - bit) : bit;
+            symbols.push_back(((bytes[i] >> shift) & 0x01) ? encoder->bit1 : encoder->bit0);
+        }
+    }
+}
+
+/**
+ * @brief Line levels sampled once per microsecond, kept as runs.
+ */
+class LineCapture
+{
+    public:
+
+        void Sample(int level)
+        {
+            if (level == _level)
+            {
+                ++_length;
+                return;
+            }
+
+            if (_level >= 0)
+            {
+                _runs.emplace_back(_level, _length);
+            }
+            _level = level;
+            _length = 1;
+        }
+
+        bool IsIdleFor(uint64_t us) const { return _level == 1 && _length >= us; }
+
+        /**
+         * @brief Packs the runs from the first falling edge into symbols; the
+         *        idle run that ended the frame becomes a zero duration.
+         */
+        size_t ToSymbols(uint32_t resolutionHz, uint64_t minUs, rmt_symbol_word_t* out, size_t capacity)
+        {
+            // A line still held low when the capture gave up is part of the frame
+            if (_level == 0)
+            {
+                _runs.emplace_back(_level, _length);
+            }
+
+            std::vector<std::pair<int, uint32_t>> runs;
+            for (const auto& run : _runs)
+            {
+                if (runs.empty() && run.first != 0)
+                {
+                    continue;
+                }
+
+                // Glitch filter: pulses shorter than signal_range_min_ns are ignored
+                if (run.second < minUs && !runs.empty())
+                {
+                    runs.back().second += UsToTicks(run.second, resolutionHz);
+                    continue;
+                }
+
+                if (!runs.empty() && runs.back().first == run.first)
+                {
+                    runs.back().second += UsToTicks(run.second, resolutionHz);
+                    continue;
+                }
+
+                runs.emplace_back(run.first, UsToTicks(run.second, resolutionHz));
+            }
+
+            size_t count = 0;
+            for (size_t i = 0; i < runs.size() && count < capacity; i += 2, ++count)
+            {
+                rmt_symbol_word_t& symbol = out[count];
+                symbol.val = 0;
+                symbol.level0 = runs[i].first;
+                symbol.duration0 = runs[i].second;
+                symbol.level1 = (i + 1 < runs.size()) ? runs[i + 1].first : 1;
+                symbol.duration1 = (i + 1 < runs.size()) ? runs[i + 1].second : 0;
+            }
+
+            return count;
+        }
+
+    private:
+
+        int _level = -1;
+        uint64_t _length = 0;
+        std::vector<std::pair<int, uint64_t>> _runs;
+};
+
+} // namespace
+
+//-----------------------------------------------------------------------------
+esp_err_t rmt_new_tx_channel(const rmt_tx_channel_config_t* config, rmt_channel_handle_t* retChannel)
+{
+    if (config == nullptr || retChannel == nullptr || config->resolution_hz == 0)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    auto* channel = new rmt_channel_t;
+    channel->tx = true;
+    channel->gpio = config->gpio_num;
+    channel->resolutionHz = config->resolution_hz;
+    channel->memBlockSymbols = config->mem_block_symbols;
+
+    gpio_set_direction(channel->gpio, config->flags.io_od_mode ? GPIO_MODE_INPUT_OUTPUT_OD : GPIO_MODE_INPUT_OUTPUT);
+    gpio_set_level(channel->gpio, 1);
+
+    std::lock_guard<std::mutex> guard(s_mutex);
+    s_channels.push_back(channel);
+    *retChannel = channel;
+    return ESP_OK;
+}
+
+//-----------------------------------------------------------------------------
+esp_err_t rmt_new_rx_channel(const rmt_rx_channel_config_t* config, rmt_channel_handle_t* retChannel)
+{
+    if (config == nullptr || retChannel == nullptr || config->resolution_hz == 0)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    auto* channel = new rmt_channel_t;
+    channel->gpio = config->gpio_num;
+    channel->resolutionHz = config->resolution_hz;
+    channel->memBlockSymbols = config->mem_block_symbols;
+
+    std::lock_guard<std::mutex> guard(s_mutex);
+    s_channels.push_back(channel);
+    *retChannel = channel;
+    return ESP_OK;
+}
+
+//-----------------------------------------------------------------------------
+esp_err_t rmt_del_channel(rmt_channel_handle_t channel)
+{
+    if (channel == nullptr)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(s_mutex);
+        s_channels.erase(std::remove(s_channels.begin(), s_channels.end(), channel), s_channels.end());
+    }
+
+    delete channel;
+    return ESP_OK;
+}
+
+//-----------------------------------------------------------------------------
+esp_err_t rmt_enable(rmt_channel_handle_t channel)
+{
+    if (channel == nullptr)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    std::lock_guard<std::mutex> guard(s_mutex);
+    channel->enabled = true;
+    return ESP_OK;
+}
+
+//-----------------------------------------------------------------------------
+esp_err_t rmt_disable(rmt_channel_handle_t channel)
+{
+    if (channel == nullptr)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    std::lock_guard<std::mutex> guard(s_mutex);
+    channel->enabled = false;
+    channel->armed = false;
+    return ESP_OK;
+}
+
+//-----------------------------------------------------------------------------
+esp_err_t rmt_new_bytes_encoder(const rmt_bytes_encoder_config_t* config, rmt_encoder_handle_t* retEncoder)
+{
+    if (config == nullptr || retEncoder == nullptr)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    auto* encoder = new rmt_encoder_t;
+    encoder->bit0 = config->bit0;
+    encoder->bit1 = config->bit1;
+    encoder->msbFirst = config->flags.msb_first;
+    *retEncoder = encoder;
+    return ESP_OK;
+}
+
+//-----------------------------------------------------------------------------
+esp_err_t rmt_new_copy_encoder(const rmt_copy_encoder_config_t* config, rmt_encoder_handle_t* retEncoder)
+{
+    if (config == nullptr || retEncoder == nullptr)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    auto* encoder = new rmt_encoder_t;
+    encoder->copy = true;
+    *retEncoder = encoder;
+    return ESP_OK;
+}
+
+//-----------------------------------------------------------------------------
+esp_err_t rmt_del_encoder(rmt_encoder_handle_t encoder)
+{
+    delete encoder;
+    return ESP_OK;
+}
+
+//-----------------------------------------------------------------------------
+esp_err_t rmt_encoder_reset(rmt_encoder_handle_t encoder)
+{
+    return (encoder != nullptr) ? ESP_OK : ESP_ERR_INVALID_ARG;
+}
+
+//-----------------------------------------------------------------------------
+esp_err_t rmt_receive(rmt_channel_handle_t rxChannel, void* buffer, size_t bufferSize, const rmt_receive_config_t* config)
+{
+    if (rxChannel == nullptr || rxChannel->tx || buffer == nullptr || config == nullptr)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    std::lock_guard<std::mutex> guard(s_mutex);
+    if (!rxChannel->enabled)
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    rxChannel->buffer = static_cast<rmt_symbol_word_t*>(buffer);
+    rxChannel->bufferSymbols = bufferSize / sizeof(rmt_symbol_word_t);
+    rxChannel->receiveConfig = *config;
+    rxChannel->armed = true;
+    return ESP_OK;
+}
+
+//-----------------------------------------------------------------------------
+esp_err_t rmt_rx_register_event_callbacks(rmt_channel_handle_t rxChannel, const rmt_rx_event_callbacks_t* cbs, void* userData)
+{
+    if (rxChannel == nullptr || rxChannel->tx || cbs == nullptr)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    std::lock_guard<std::mutex> guard(s_mutex);
+    rxChannel->onReceiveDone = cbs->on_recv_done;
+    rxChannel->userData = userData;
+    return ESP_OK;
+}
+
+//-----------------------------------------------------------------------------
+esp_err_t rmt_tx_register_event_callbacks(rmt_channel_handle_t txChannel, const rmt_tx_event_callbacks_t* cbs, void* /*userData*/)
+{
+    // Transmissions complete before rmt_transmit() returns; nothing to report
+    return (txChannel != nullptr && txChannel->tx && cbs != nullptr) ? ESP_OK : ESP_ERR_INVALID_ARG;
+}
+
+//-----------------------------------------------------------------------------
+esp_err_t rmt_transmit(rmt_channel_handle_t txChannel, rmt_encoder_handle_t encoder, const void* payload, size_t payloadBytes, const rmt_transmit_config_t* config)
+{
+    if (txChannel == nullptr || !txChannel->tx || encoder == nullptr || payload == nullptr || config == nullptr)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (!txChannel->enabled)
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    std::vector<rmt_symbol_word_t> symbols;
+    Encode(encoder, payload, payloadBytes, symbols);
+
+    rmt_channel_t* receiver = TakeArmedReceiver(txChannel->gpio);
+    LineCapture capture;
+    const uint64_t startUs = HostTime::NowUs();
+    uint64_t elapsedUs = 0;
+
+    auto step = [&]()
+    {
+        capture.Sample(gpio_get_level(txChannel->gpio));
+        HostTime::AdvanceRomDelay(1);
+        ++elapsedUs;
+    };
+
+    auto play = [&](int level, uint32_t ticks)
+    {
+        gpio_set_level(txChannel->gpio, level);
+        for (uint64_t us = TicksToUs(ticks, txChannel->resolutionHz); us > 0; --us)
+        {
+            step();
+        }
+    };
+
+    for (const rmt_symbol_word_t& symbol : symbols)
+    {
+        // A zero duration ends the frame, as on the hardware
+        if (symbol.duration0 == 0)
+        {
+            break;
+        }
+        play(symbol.level0, symbol.duration0);
+
+        if (symbol.duration1 == 0)
+        {
+            break;
+        }
+        play(symbol.level1, symbol.duration1);
+    }
+
+    gpio_set_level(txChannel->gpio, config->flags.eot_level);
+
+    if (receiver != nullptr)
+    {
+        // Keep sampling until devices release the line long enough to end the frame
+        const uint64_t idleUs = std::max<uint64_t>(1, receiver->receiveConfig.signal_range_max_ns / 1000);
+        for (uint64_t tailUs = 0; !capture.IsIdleFor(idleUs) && tailUs < MAX_TAIL_US; ++tailUs)
+        {
+            step();
+        }
+
+        rmt_rx_done_event_data_t event{};
+        event.received_symbols = receiver->buffer;
+        event.num_symbols = capture.ToSymbols(receiver->resolutionHz,
+                                              receiver->receiveConfig.signal_range_min_ns / 1000,
+                                              receiver->buffer,
+                                              receiver->bufferSymbols);
+        event.flags.is_last = 1;
+
+        if (receiver->onReceiveDone != nullptr)
+        {
+            receiver->onReceiveDone(receiver, &event, receiver->userData);
+        }
+    }
+
+    HostTime::SleepUntilUs(startUs + elapsedUs);
+    return ESP_OK;
+}
+
+//-----------------------------------------------------------------------------
+esp_err_t rmt_tx_wait_all_done(rmt_channel_handle_t txChannel, int /*timeoutMs*/)
+{
+    return (txChannel != nullptr && txChannel->tx) ? ESP_OK : ESP_ERR_INVALID_ARG;
+}
@@ -0,0 +1,464 @@
+/*!****************************************************************************
+ * @file    wifi.cpp
+ * @brief   Host implementation of the WiFi, netif, NVS and SNTP stand-ins.
+ *          The station "associates" with any SSID while the simulated access
+ *          point is reachable; events are posted to the default loop.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#include "esp_event.h"
+#include "esp_netif.h"
+#include "esp_sntp.h"
+#include "esp_timer.h"
+#include "esp_wifi.h"
+#include "host_net.h"
+#include "lwip/ip4_addr.h"
+#include "nvs_flash.h"
+
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <sys/time.h>
+
+ESP_EVENT_DEFINE_BASE(WIFI_EVENT);
+ESP_EVENT_DEFINE_BASE(IP_EVENT);
+
+struct esp_netif_obj
+{
+    bool isAp;
+    esp_netif_ip_info_t ipInfo;
+};
+
+namespace {
+
+static constexpr uint64_t ASSOCIATION_TIME_US = 150000;
+static constexpr uint64_t SNTP_SYNC_TIME_US = 200000;
+static constexpr int8_t SIMULATED_RSSI = -58;
+static constexpr const char* SIMULATED_NETWORKS[] = {"HomeNetwork", "Aquarium-Lab", "Neighbour-5G"};
+
+std::mutex s_mutex;
+bool s_initialized = false;
+bool s_started = false;
+wifi_mode_t s_mode = WIFI_MODE_NULL;
+wifi_config_t s_staConfig = {};
+esp_netif_t* s_staNetif = nullptr;
+std::atomic<bool> s_reachable{true};
+std::atomic<bool> s_associated{false};
+esp_timer_handle_t s_connectTimer = nullptr;
+
+sntp_sync_time_cb_t s_sntpCallback = nullptr;
+esp_timer_handle_t s_sntpTimer = nullptr;
+std::atomic<bool> s_sntpEnabled{false};
+std::atomic<sntp_sync_status_t> s_sntpStatus{SNTP_SYNC_STATUS_RESET};
+
+//-----------------------------------------------------------------------------
+void OnAssociationDone(void* /*arg*/)
+{
+    if (!s_reachable.load())
+    {
+        wifi_event_sta_disconnected_t disconnected = {201}; // WIFI_REASON_NO_AP_FOUND
+        esp_event_post(WIFI_EVENT, WIFI_EVENT_STA_DISCONNECTED, &disconnected, sizeof(disconnected), 0);
+        return;
+    }
+
+    s_associated = true;
+    esp_event_post(WIFI_EVENT, WIFI_EVENT_STA_CONNECTED, nullptr, 0, 0);
+
+    ip_event_got_ip_t gotIp = {};
+    gotIp.esp_netif = s_staNetif;
+    IP4_ADDR(&gotIp.ip_info.ip, 192, 168, 0, 77);
+    IP4_ADDR(&gotIp.ip_info.netmask, 255, 255, 255, 0);
+    IP4_ADDR(&gotIp.ip_info.gw, 192, 168, 0, 1);
+    gotIp.ip_changed = true;
+
+    if (s_staNetif != nullptr)
+    {
+        s_staNetif->ipInfo = gotIp.ip_info;
+    }
+
+    esp_event_post(IP_EVENT, IP_EVENT_STA_GOT_IP, &gotIp, sizeof(gotIp), 0);
+}
+
+//-----------------------------------------------------------------------------
+void OnSntpSync(void* /*arg*/)
+{
+    s_sntpStatus = SNTP_SYNC_STATUS_COMPLETED;
+
+    if (s_sntpCallback != nullptr)
+    {
+        struct timeval now;
+        gettimeofday(&now, nullptr);
+        s_sntpCallback(&now);
+    }
+}
+
+} // namespace
+
+//----netif--------------------------------------------------------------------
+esp_err_t esp_netif_init(void)
+{
+    return ESP_OK;
+}
+
+//-----------------------------------------------------------------------------
+esp_netif_t* esp_netif_create_default_wifi_sta(void)
+{
+    std::lock_guard<std::mutex> guard(s_mutex);
+    s_staNetif = new esp_netif_obj{false, {}};
+    return s_staNetif;
+}
+
+//-----------------------------------------------------------------------------
+esp_netif_t* esp_netif_create_default_wifi_ap(void)
+{
+    esp_netif_t* netif = new esp_netif_obj{true, {}};
+    IP4_ADDR(&netif->ipInfo.ip, 192, 168, 4, 1);
+    IP4_ADDR(&netif->ipInfo.netmask, 255, 255, 255, 0);
+    IP4_ADDR(&netif->ipInfo.gw, 192, 168, 4, 1);
+    return netif;
+}
+
+//-----------------------------------------------------------------------------
+void esp_netif_destroy(esp_netif_t* netif)
+{
+    std::lock_guard<std::mutex> guard(s_mutex);
+    if (netif == s_staNetif)
+    {
+        s_staNetif = nullptr;
+    }
+    delete netif;
+}
+
+//-----------------------------------------------------------------------------
+void esp_netif_destroy_default_wifi(void* netif)
+{
+    esp_netif_destroy(static_cast<esp_netif_t*>(netif));
+}
+
+//-----------------------------------------------------------------------------
+esp_err_t esp_netif_set_ip_info(esp_netif_t* netif, const esp_netif_ip_info_t* ipInfo)
+{
+    if (netif == nullptr || ipInfo == nullptr)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    netif->ipInfo = *ipInfo;
+    return ESP_OK;
+}
+
+//-----------------------------------------------------------------------------
+esp_err_t esp_netif_get_ip_info(esp_netif_t* netif, esp_netif_ip_info_t* ipInfo)
+{
+    if (netif == nullptr || ipInfo == nullptr)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    *ipInfo = netif->ipInfo;
+    return ESP_OK;
+}
+
+//-----------------------------------------------------------------------------
+esp_err_t esp_netif_dhcps_start(esp_netif_t* /*netif*/)
+{
+    return ESP_OK;
+}
+
+//-----------------------------------------------------------------------------
+esp_err_t esp_netif_dhcps_stop(esp_netif_t* /*netif*/)
+{
+    return ESP_OK;
+}
+
+//-----------------------------------------------------------------------------
+char* esp_ip4addr_ntoa(const esp_ip4_addr_t* addr, char* buf, int buflen)
+{
+    // lwIP stores addresses in network order: first octet in the lowest byte
+    const uint32_t ip = addr->addr;
+    std::snprintf(buf, buflen, "%u.%u.%u.%u", ip & 0xFF, (ip >> 8) & 0xFF, (ip >> 16) & 0xFF, (ip >> 24) & 0xFF);
+    return buf;
+}
+
+//----wifi---------------------------------------------------------------------
+esp_err_t esp_wifi_init(const wifi_init_config_t* config)
+{
+    if (config == nullptr)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    std::lock_guard<std::mutex> guard(s_mutex);
+    if (s_connectTimer == nullptr)
+    {
+        esp_timer_create_args_t args = {};
+        args.callback = &OnAssociationDone;
+        args.name = "wifi_assoc";
+        esp_timer_create(&args, &s_connectTimer);
+    }
+
+    s_initialized = true;
+    return ESP_OK;
+}
+
+//-----------------------------------------------------------------------------
+esp_err_t esp_wifi_deinit(void)
+{
+    std::lock_guard<std::mutex> guard(s_mutex);
+    s_initialized = false;
+    s_started = false;
+    return ESP_OK;
+}
+
+//-----------------------------------------------------------------------------
+esp_err_t esp_wifi_set_mode(wifi_mode_t mode)
+{
+    std::lock_guard<std::mutex> guard(s_mutex);
+    s_mode = mode;
+    return s_initialized ? ESP_OK : ESP_ERR_INVALID_STATE;
+}
+
+//-----------------------------------------------------------------------------
+esp_err_t esp_wifi_get_mode(wifi_mode_t* mode)
+{
+    std::lock_guard<std::mutex> guard(s_mutex);
+    *mode = s_mode;
+    return ESP_OK;
+}
+
+//-----------------------------------------------------------------------------
+esp_err_t esp_wifi_set_config(wifi_interface_t interface, wifi_config_t* conf)
+{
+    if (conf == nullptr)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    std::lock_guard<std::mutex> guard(s_mutex);
+    if (interface == WIFI_IF_STA)
+    {
+        s_staConfig = *conf;
+    }
+
+    return s_initialized ? ESP_OK : ESP_ERR_INVALID_STATE;
+}
+
+//-----------------------------------------------------------------------------
+esp_err_t esp_wifi_start(void)
+{
+    wifi_mode_t mode;
+    {
+        std::lock_guard<std::mutex> guard(s_mutex);
+        if (!s_initialized)
+        {
+            return ESP_ERR_INVALID_STATE;
+        }
+        s_started = true;
+        mode = s_mode;
+    }
+
+    if (mode == WIFI_MODE_STA || mode == WIFI_MODE_APSTA)
+    {
+        esp_event_post(WIFI_EVENT, WIFI_EVENT_STA_START, nullptr, 0, 0);
+    }
+    if (mode == WIFI_MODE_AP || mode == WIFI_MODE_APSTA)
+    {
+        esp_event_post(WIFI_EVENT, WIFI_EVENT_AP_START, nullptr, 0, 0);
+    }
+
+    return ESP_OK;
+}
+
+//-----------------------------------------------------------------------------
+esp_err_t esp_wifi_stop(void)
+{
+    {
+        std::lock_guard<std::mutex> guard(s_mutex);
+        s_started = false;
+    }
+
+    s_associated = false;
+    if (s_connectTimer != nullptr)
+    {
+        esp_timer_stop(s_connectTimer);
+    }
+
+    return ESP_OK;
+}
+
+//-----------------------------------------------------------------------------
+esp_err_t esp_wifi_connect(void)
+{
+    {
+        std::lock_guard<std::mutex> guard(s_mutex);
+        if (!s_started)
+        {
+            return ESP_ERR_INVALID_STATE;
+        }
+    }
+
+    esp_timer_stop(s_connectTimer);
+    esp_timer_start_once(s_connectTimer, ASSOCIATION_TIME_US);
+    return ESP_OK;
+}
+
+//-----------------------------------------------------------------------------
+esp_err_t esp_wifi_disconnect(void)
+{
+    s_associated = false;
+    if (s_connectTimer != nullptr)
+    {
+        esp_timer_stop(s_connectTimer);
+    }
+
+    return ESP_OK;
+}
+
+//-----------------------------------------------------------------------------
+esp_err_t esp_wifi_sta_get_rssi(int* rssi)
+{
+    if (!s_associated.load())
+    {
+        return ESP_FAIL;
+    }
+
+    *rssi = SIMULATED_RSSI;
+    return ESP_OK;
+}
+
+//-----------------------------------------------------------------------------
+esp_err_t esp_wifi_sta_get_ap_info(wifi_ap_record_t* apInfo)
+{
+    if (!s_associated.load())
+    {
+        return ESP_FAIL;
+    }
+
+    std::lock_guard<std::mutex> guard(s_mutex);
+    std::memset(apInfo, 0, sizeof(*apInfo));
+    std::memcpy(apInfo->ssid, s_staConfig.sta.ssid, sizeof(s_staConfig.sta.ssid));
+    apInfo->primary = 6;
+    apInfo->rssi = SIMULATED_RSSI;
+    apInfo->authmode = WIFI_AUTH_WPA2_PSK;
+    return ESP_OK;
+}
+
+//-----------------------------------------------------------------------------
+esp_err_t esp_wifi_scan_start(const void* /*config*/, bool /*block*/)
+{
+    esp_event_post(WIFI_EVENT, WIFI_EVENT_SCAN_DONE, nullptr, 0, 0);
+    return ESP_OK;
+}
+
+//-----------------------------------------------------------------------------
+esp_err_t esp_wifi_scan_get_ap_num(uint16_t* number)
+{
+    *number = sizeof(SIMULATED_NETWORKS) / sizeof(SIMULATED_NETWORKS[0]);
+    return ESP_OK;
+}
+
+//-----------------------------------------------------------------------------
+esp_err_t esp_wifi_scan_get_ap_records(uint16_t* number, wifi_ap_record_t* apRecords)
+{
+    const uint16_t available = sizeof(SIMULATED_NETWORKS) / sizeof(SIMULATED_NETWORKS[0]);
+    const uint16_t count = (*number < available) ? *number : available;
+
+    for (uint16_t i = 0; i < count; ++i)
+    {
+        std::memset(&apRecords[i], 0, sizeof(apRecords[i]));
+        std::strncpy(reinterpret_cast<char*>(apRecords[i].ssid), SIMULATED_NETWORKS[i], sizeof(apRecords[i].ssid) - 1);
+        apRecords[i].primary = static_cast<uint8_t>(1 + (5 * i));
+        apRecords[i].rssi = static_cast<int8_t>(SIMULATED_RSSI - (9 * i));
+        apRecords[i].authmode = WIFI_AUTH_WPA2_PSK;
+    }
+
+    *number = count;
+    return ESP_OK;
+}
+
+//----nvs----------------------------------------------------------------------
+esp_err_t nvs_flash_init(void)
+{
+    return ESP_OK;
+}
+
+//-----------------------------------------------------------------------------
+esp_err_t nvs_flash_erase(void)
+{
+    return ESP_OK;
+}
+
+//----sntp---------------------------------------------------------------------
+void esp_sntp_setoperatingmode(esp_sntp_operatingmode_t /*operatingMode*/)
+{
+}
+
+//-----------------------------------------------------------------------------
+void esp_sntp_setservername(uint8_t /*idx*/, const char* /*server*/)
+{
+}
+
+//-----------------------------------------------------------------------------
+void sntp_set_time_sync_notification_cb(sntp_sync_time_cb_t callback)
+{
+    s_sntpCallback = callback;
+}
+
+//-----------------------------------------------------------------------------
+void esp_sntp_init(void)
+{
+    // The host clock is already "synchronized"; report it after a short round trip
+    if (s_sntpTimer == nullptr)
+    {
+        esp_timer_create_args_t args = {};
+        args.callback = &OnSntpSync;
+        args.name = "sntp";
+        esp_timer_create(&args, &s_sntpTimer);
+    }
+
+    s_sntpEnabled = true;
+    s_sntpStatus = SNTP_SYNC_STATUS_IN_PROGRESS;
+    esp_timer_stop(s_sntpTimer);
+    esp_timer_start_once(s_sntpTimer, SNTP_SYNC_TIME_US);
+}
+
+//-----------------------------------------------------------------------------
+void esp_sntp_stop(void)
+{
+    s_sntpEnabled = false;
+    if (s_sntpTimer != nullptr)
+    {
+        esp_timer_stop(s_sntpTimer);
+    }
+}
+
+//-----------------------------------------------------------------------------
+bool esp_sntp_enabled(void)
+{
+    return s_sntpEnabled.load();
+}
+
+//-----------------------------------------------------------------------------
+sntp_sync_status_t sntp_get_sync_status(void)
+{
+    return s_sntpStatus.load();
+}
+
+//----HostNet------------------------------------------------------------------
+namespace HostNet {
+
+//-----------------------------------------------------------------------------
+void SetWifiReachable(bool reachable)
+{
+    s_reachable = reachable;
+
+    if (!reachable && s_associated.exchange(false))
+    {
+        wifi_event_sta_disconnected_t disconnected = {8}; // WIFI_REASON_ASSOC_LEAVE
+        esp_event_post(WIFI_EVENT, WIFI_EVENT_STA_DISCONNECTED, &disconnected, sizeof(disconnected), 0);
+    }
+}
+
+} // namespace HostNet
@@ -0,0 +1,143 @@
+/*!****************************************************************************
+ * @file    board.cpp
+ * @brief   Implementation of the simulated board wiring.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#include "host/sim/board.h"
+#include "driver/i2c_master.h"
+#include "host_bus.h"
+#include "host_net.h"
+#include "include/config.h"
+#include "ui/ui.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+
+namespace HostSim {
+
+namespace {
+
+// ADC1 channels behind the analog pins used by the firmware (see AnalogIn)
+static constexpr adc_channel_t TDS_ADC_CHANNEL = ADC_CHANNEL_6;         // GPIO34
+static constexpr adc_channel_t BATTERY_ADC_CHANNEL = ADC_CHANNEL_7;     // GPIO35
+
+//-----------------------------------------------------------------------------
+void ReplayCapture(adc_channel_t channel, const std::string& path)
+{
+    if (path.empty())
+    {
+        return;
+    }
+
+    // Whitespace-separated raw codes, replayed in a loop at the sampling rate
+    std::ifstream file(path);
+    std::vector<uint16_t> codes;
+    for (unsigned code = 0; file >> code; )
+    {
+        codes.push_back(static_cast<uint16_t>(code));
+    }
+
+    if (codes.empty())
+    {
+        std::fprintf(stderr, "No ADC codes in %s\n", path.c_str());
+        return;
+    }
+
+    HostBus::SetAdcReplay(channel, std::move(codes));
+}
+
+} // namespace
+
+//-----------------------------------------------------------------------------
+Board::Board(const Options& options)
+    : _options(options)
+    , _eeprom(options.eepromFile)
+{
+    for (size_t i = 0; i < std::max<size_t>(options.probeCount, 1); ++i)
+    {
+        _probes.push_back(std::make_unique<Ds18b20>(PROBE_SERIAL + i * PROBE_SERIAL_STEP));
+    }
+}
+
+//-----------------------------------------------------------------------------
+void Board::Attach()
+{
+    for (auto& probe : _probes)
+    {
+        _oneWireBus.AddDevice(probe.get());
+    }
+    HostBus::AttachGpioDevice(static_cast<gpio_num_t>(Config::TEMP_SENSOR_PIN), &_oneWireBus);
+
+    HostBus::AttachI2cDevice(I2C_NUM_0, Config::EEPROM_I2C_ADDRESS, &_eeprom);
+    if (_options.eepromPowerCutBytes >= 0)
+    {
+        _eeprom.CutPowerAfter(static_cast<uint32_t>(_options.eepromPowerCutBytes));
+    }
+    HostBus::AttachI2cDevice(I2C_NUM_0, Config::RTC_I2C_ADDRESS, &_rtc);
+
+    if (!_options.flashFile.empty())
+    {
+        HostBus::SetFlashFile(_options.flashFile.c_str());
+    }
+
+    HostBus::SetAdcVoltage(BATTERY_ADC_CHANNEL, _options.batteryVoltage);
+
+    SetWaterTemperature(_options.waterTemperatureC);
+    SetTdsVoltage(_options.tdsVoltage);
+    SetUsbPowered(_options.usbPowered);
+
+    ReplayCapture(TDS_ADC_CHANNEL, _options.tdsReplayFile);
+    ReplayCapture(BATTERY_ADC_CHANNEL, _options.batteryReplayFile);
+}
+
+//-----------------------------------------------------------------------------
+void Board::SetWaterTemperature(float celsius)
+{
+    for (size_t i = 0; i < _probes.size(); ++i)
+    {
+        _probes[i]->SetTemperature(celsius + i * PROBE_STEP_C);
+    }
+}
+
+//-----------------------------------------------------------------------------
+void Board::SetTdsVoltage(float volts)
+{
+    HostBus::SetAdcVoltage(TDS_ADC_CHANNEL, volts);
+}
+
+//-----------------------------------------------------------------------------
+void Board::SetUsbPowered(bool usbPowered)
+{
+    HostBus::SetInputLevel(static_cast<gpio_num_t>(Config::USB_DETECT_PIN), usbPowered ? 1 : 0);
+}
+
+//-----------------------------------------------------------------------------
+void Board::PrintSummary() const
+{
+    std::printf("\n---- host board summary ----\n");
+    std::printf("1-Wire   probes %zu, resets %u, conversions %u\n",
+                _probes.size(), _oneWireBus.GetResetCount(), _probes.front()->GetConversionCount());
+    std::printf("EEPROM   page writes %u (%u B, max %u per page), read %u B, busy NACKs %u\n",
+                _eeprom.GetPageWrites(), _eeprom.GetBytesWritten(), _eeprom.GetMaxPageWrites(),
+                _eeprom.GetBytesRead(), _eeprom.GetBusyNacks());
+    if (_eeprom.IsPowerCut())
+    {
+        std::printf("EEPROM   power cut after %u B\n", _eeprom.GetBytesWritten());
+    }
+    const HostBus::FlashStats flash = HostBus::GetFlashStats();
+    std::printf("Flash    programs %u (%u B), sector erases %u (max %u per sector)\n",
+                flash.programCalls, flash.bytesProgrammed, flash.sectorErases, flash.maxSectorErases);
+    std::printf("MQTT     published %zu\n", HostNet::GetPublishedCount());
+    std::printf("Servo    duty %u\n", HostBus::GetPwmDuty(0));
+    std::printf("UI       screen %s, time '%s', temp '%s', tds '%s'\n",
+                IsUiScreenActive(ui_Screen) ? "main" : "splash",
+                GetUiText(ui_lblTime).c_str(),
+                GetUiText(ui_lblTempValue).c_str(),
+                GetUiText(ui_lblTdsValue).c_str());
+    std::fflush(stdout);
+}
+
+} // namespace HostSim
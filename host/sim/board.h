@@ -0,0 +1,87 @@
+/*!****************************************************************************
+ * @file    board.h
+ * @brief   Simulated Smart Aquarium Guardian board: wires the device models
+ *          to the pins and buses declared in include/config.h.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#pragma once
+
+#include "host/sim/eeprom_sim.h"
+#include "host/sim/one_wire_sim.h"
+#include "host/sim/rtc_sim.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+struct _lv_obj_t;
+
+namespace HostSim {
+
+class Board
+{
+    public:
+
+        struct Options
+        {
+            float waterTemperatureC = 25.5f;
+            size_t probeCount = 1;          // DS18B20 on the 1-Wire bus, 1-16
+            float tdsVoltage = 0.45f;       // ~250 ppm at 25 C
+            float batteryVoltage = 1.95f;   // after the divider, ~3.9 V cell
+            bool usbPowered = true;
+            std::string eepromFile;         // empty: volatile EEPROM
+            int64_t eepromPowerCutBytes = -1;   // cut the EEPROM power after this many bytes written, -1: never
+            std::string flashFile;          // empty: volatile flash partitions
+            std::string tdsReplayFile;      // raw ADC codes replayed on the TDS channel
+            std::string batteryReplayFile;  // raw ADC codes replayed on the battery channel
+        };
+
+        explicit Board(const Options& options);
+
+        /**
+         * @brief Attaches every device model to the host buses.
+         *        Must run before the firmware constructs its drivers.
+         */
+        void Attach();
+
+        /**
+         * @brief Probe i reads celsius + i * PROBE_STEP_C, so every channel is told apart.
+         */
+        void SetWaterTemperature(float celsius);
+        void SetTdsVoltage(float volts);
+        void SetUsbPowered(bool usbPowered);
+
+        /**
+         * @brief Prints bus statistics and the state of the main UI labels.
+         */
+        void PrintSummary() const;
+
+        Ds18b20& GetTemperatureProbe(size_t index = 0) { return *_probes[index]; }
+        At24c32& GetEeprom() { return _eeprom; }
+
+    private:
+
+        static constexpr uint64_t PROBE_SERIAL = 0x0000A1B2C3D4ULL;
+        static constexpr uint64_t PROBE_SERIAL_STEP = 0x010203040506ULL;    //!< Spreads the serials over the search tree
+        static constexpr float PROBE_STEP_C = 0.5f;
+
+        Options _options;
+        OneWireBus _oneWireBus;
+        std::vector<std::unique_ptr<Ds18b20>> _probes;
+        At24c32 _eeprom;
+        Ds1307 _rtc;
+};
+
+/**
+ * @brief Text currently shown by a UI label (see graphic_display_sim.cpp).
+ */
+std::string GetUiText(const _lv_obj_t* object);
+
+/**
+ * @brief Whether the given screen is the one loaded on the display.
+ */
+bool IsUiScreenActive(const _lv_obj_t* screen);
+
+} // namespace HostSim
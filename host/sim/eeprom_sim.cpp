@@ -0,0 +1,172 @@
+/*!****************************************************************************
+ * @file    eeprom_sim.cpp
+ * @brief   Implementation of the simulated AT24C32 EEPROM.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#include "host/sim/eeprom_sim.h"
+#include "host_time.h"
+
+#include <algorithm>
+#include <cstdio>
+
+namespace HostSim {
+
+//-----------------------------------------------------------------------------
+At24c32::At24c32(const std::string& backingFile)
+    : _backingFile(backingFile)
+{
+    _memory.fill(0xFF);
+
+    if (_backingFile.empty())
+    {
+        return;
+    }
+
+    if (FILE* file = std::fopen(_backingFile.c_str(), "rb"))
+    {
+        const size_t read = std::fread(_memory.data(), 1, _memory.size(), file);
+        std::fclose(file);
+        std::printf("[sim] EEPROM loaded %zu bytes from %s\n", read, _backingFile.c_str());
+    }
+}
+
+//-----------------------------------------------------------------------------
+bool At24c32::OnWrite(const uint8_t* data, size_t length)
+{
+    std::lock_guard<std::mutex> guard(_mutex);
+
+    if (_powerCut)
+    {
+        return false;
+    }
+
+    // No ACK on the address byte while the internal write cycle runs
+    if (IsBusyLocked())
+    {
+        _busyNacks++;
+        return false;
+    }
+
+    if (length < 2)
+    {
+        // Address-only probe (ACK polling) or a truncated address
+        return true;
+    }
+
+    _addressPointer = static_cast<uint16_t>(((data[0] << 8) | data[1]) % SIZE_BYTES);
+    if (length == 2)
+    {
+        // Dummy write that only sets the address for a following read
+        return true;
+    }
+
+    const uint16_t pageBase = static_cast<uint16_t>(_addressPointer - (_addressPointer % PAGE_SIZE));
+    uint16_t offset = static_cast<uint16_t>(_addressPointer % PAGE_SIZE);
+
+    // Data beyond the end of the page rolls over to the start of the same page
+    for (size_t i = 2; i < length; ++i)
+    {
+        if (_bytesUntilCut == 0)
+        {
+            _memory[pageBase + offset] = static_cast<uint8_t>(~data[i]);
+            _powerCut = true;
+            _bytesUntilCut = -1;
+            _pageWrites++;
+            _writesPerPage[pageBase / PAGE_SIZE]++;
+            _bytesWritten += static_cast<uint32_t>(i - 2);
+            PersistLocked();
+            return false;
+        }
+        if (_bytesUntilCut > 0)
+        {
+            _bytesUntilCut--;
+        }
+
+        _memory[pageBase + offset] = data[i];
+        offset = static_cast<uint16_t>((offset + 1) % PAGE_SIZE);
+    }
+
+    _addressPointer = static_cast<uint16_t>(pageBase + offset);
+    _busyUntilUs = HostTime::NowUs() + WRITE_CYCLE_US;
+    _pageWrites++;
+    _writesPerPage[pageBase / PAGE_SIZE]++;
+    _bytesWritten += static_cast<uint32_t>(length - 2);
+
+    PersistLocked();
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+bool At24c32::OnRead(uint8_t* data, size_t length)
+{
+    std::lock_guard<std::mutex> guard(_mutex);
+
+    if (_powerCut)
+    {
+        return false;
+    }
+
+    if (IsBusyLocked())
+    {
+        _busyNacks++;
+        return false;
+    }
+
+    // Sequential reads roll over the whole array
+    for (size_t i = 0; i < length; ++i)
+    {
+        data[i] = _memory[_addressPointer];
+        _addressPointer = static_cast<uint16_t>((_addressPointer + 1) % SIZE_BYTES);
+    }
+
+    _bytesRead += static_cast<uint32_t>(length);
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+uint32_t At24c32::GetMaxPageWrites() const
+{
+    std::lock_guard<std::mutex> guard(_mutex);
+    return *std::max_element(_writesPerPage.begin(), _writesPerPage.end());
+}
+
+//-----------------------------------------------------------------------------
+void At24c32::CutPowerAfter(uint32_t bytes)
+{
+    std::lock_guard<std::mutex> guard(_mutex);
+    _bytesUntilCut = bytes;
+}
+
+//-----------------------------------------------------------------------------
+void At24c32::RestorePower()
+{
+    std::lock_guard<std::mutex> guard(_mutex);
+    _powerCut = false;
+    _bytesUntilCut = -1;
+    _busyUntilUs = 0;
+}
+
+//----private------------------------------------------------------------------
+bool At24c32::IsBusyLocked() const
+{
+    return HostTime::NowUs() < _busyUntilUs;
+}
+
+//----private------------------------------------------------------------------
+void At24c32::PersistLocked() const
+{
+    if (_backingFile.empty())
+    {
+        return;
+    }
+
+    if (FILE* file = std::fopen(_backingFile.c_str(), "wb"))
+    {
+        std::fwrite(_memory.data(), 1, _memory.size(), file);
+        std::fclose(file);
+    }
+}
+
+} // namespace HostSim
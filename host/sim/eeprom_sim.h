@@ -0,0 +1,84 @@
+/*!****************************************************************************
+ * @file    eeprom_sim.h
+ * @brief   AT24C32 I2C EEPROM model: 4 KiB, 32-byte pages that wrap inside
+ *          the page, and a write cycle during which the device NACKs.
+ *          Power can be cut at any written byte, to test what a brown-out
+ *          in the middle of a save leaves behind.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#pragma once
+
+#include "host_bus.h"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+namespace HostSim {
+
+class At24c32 : public HostBus::II2cDevice
+{
+    public:
+
+        static constexpr size_t SIZE_BYTES = 4096;
+        static constexpr size_t PAGE_SIZE = 32;
+        static constexpr uint64_t WRITE_CYCLE_US = 5000;
+
+        /**
+         * @brief Creates an erased (0xFF) device. With a backing file the
+         *        contents are loaded from it and written back after each cycle.
+         */
+        explicit At24c32(const std::string& backingFile = "");
+
+        //---------------------------------------------
+        // HostBus::II2cDevice
+
+        bool OnWrite(const uint8_t* data, size_t length) override;
+        bool OnRead(uint8_t* data, size_t length) override;
+
+        //---------------------------------------------
+        // Fault injection
+
+        /**
+         * @brief Cuts the power once 'bytes' more data bytes have been written (0: at the
+         *        next one). The byte at the cut is left half programmed (wrong), the rest of
+         *        that write is lost, and the device answers nothing until RestorePower().
+         */
+        void CutPowerAfter(uint32_t bytes);
+        void RestorePower();
+        bool IsPowerCut() const { return _powerCut; }
+
+        //---------------------------------------------
+        // Statistics
+
+        uint32_t GetPageWrites() const { return _pageWrites; }
+        uint32_t GetMaxPageWrites() const;          // Of the most worn page
+        uint32_t GetBytesWritten() const { return _bytesWritten; }
+        uint32_t GetBytesRead() const { return _bytesRead; }
+        uint32_t GetBusyNacks() const { return _busyNacks; }
+
+    private:
+
+        bool IsBusyLocked() const;
+        void PersistLocked() const;
+
+        mutable std::mutex _mutex;
+        std::array<uint8_t, SIZE_BYTES> _memory;
+        std::string _backingFile;
+        uint16_t _addressPointer = 0;
+        uint64_t _busyUntilUs = 0;
+        int64_t _bytesUntilCut = -1;        // -1: no cut armed
+        std::atomic<bool> _powerCut{false};
+
+        std::array<uint32_t, SIZE_BYTES / PAGE_SIZE> _writesPerPage{};
+        std::atomic<uint32_t> _pageWrites{0};
+        std::atomic<uint32_t> _bytesWritten{0};
+        std::atomic<uint32_t> _bytesRead{0};
+        std::atomic<uint32_t> _busyNacks{0};
+};
+
+} // namespace HostSim
@@ -0,0 +1,190 @@
+/*!****************************************************************************
+ * @file    graphic_display_sim.cpp
+ * @brief   Host replacement for src/drivers/graphic_display.cpp. There is no
+ *          panel or LVGL on the host: UI objects only record their text and
+ *          flags so the UserInterface manager runs unchanged.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#include "src/drivers/graphic_display.h"
+#include "host/sim/board.h"
+#include "include/config.h"
+#include "ui/ui.h"
+
+#include <mutex>
+
+//----ui objects---------------------------------------------------------------
+namespace {
+
+std::mutex s_uiMutex;
+lv_obj_t* s_activeScreen = nullptr;
+
+#define HOST_UI_STORAGE(name)   lv_obj_t name##_obj = {#name, "", false, false};
+HOST_UI_OBJECTS(HOST_UI_STORAGE)
+#undef HOST_UI_STORAGE
+
+} // namespace
+
+#define HOST_UI_DEFINE(name)    lv_obj_t* name = nullptr;
+HOST_UI_OBJECTS(HOST_UI_DEFINE)
+#undef HOST_UI_DEFINE
+
+//-----------------------------------------------------------------------------
+void ui_init(void)
+{
+#define HOST_UI_BIND(name)      name = &name##_obj;
+    HOST_UI_OBJECTS(HOST_UI_BIND)
+#undef HOST_UI_BIND
+}
+
+//-----------------------------------------------------------------------------
+void lv_screen_load(lv_obj_t* screen)
+{
+    std::lock_guard<std::mutex> guard(s_uiMutex);
+    s_activeScreen = screen;
+}
+
+namespace Drivers {
+
+//-----------------------------------------------------------------------------
+GraphicDisplay::UIElement::UIElement(lv_obj_t * lv_obj)
+    : _lv_obj(lv_obj)
+{
+}
+
+//-----------------------------------------------------------------------------
+GraphicDisplay::UIElement::~UIElement()
+{
+}
+
+//-----------------------------------------------------------------------------
+void GraphicDisplay::UIElement::SetText(const char* newText)
+{
+    if (_lv_obj == nullptr)
+        return;
+
+    std::lock_guard<std::mutex> guard(s_uiMutex);
+    _lv_obj->text = newText;
+}
+
+//-----------------------------------------------------------------------------
+void GraphicDisplay::UIElement::Hide()
+{
+    if (_lv_obj == nullptr)
+        return;
+
+    std::lock_guard<std::mutex> guard(s_uiMutex);
+    _lv_obj->hidden = true;
+}
+
+//-----------------------------------------------------------------------------
+void GraphicDisplay::UIElement::Show()
+{
+    if (_lv_obj == nullptr)
+        return;
+
+    std::lock_guard<std::mutex> guard(s_uiMutex);
+    _lv_obj->hidden = false;
+}
+
+//-----------------------------------------------------------------------------
+void GraphicDisplay::UIElement::SetState1()
+{
+    if (_lv_obj == nullptr)
+        return;
+
+    std::lock_guard<std::mutex> guard(s_uiMutex);
+    _lv_obj->state1 = true;
+}
+
+//-----------------------------------------------------------------------------
+void GraphicDisplay::UIElement::ClearState1()
+{
+    if (_lv_obj == nullptr)
+        return;
+
+    std::lock_guard<std::mutex> guard(s_uiMutex);
+    _lv_obj->state1 = false;
+}
+
+//----private------------------------------------------------------------------
+bool GraphicDisplay::OnInit()
+{
+    CORE_INFO("Host display: %dx%d, UI state kept in memory", DISP_H_RES, DISP_V_RES);
+
+    ui_init();
+    lv_disp_load_scr(ui_SplashScreen);
+
+    _valid = true;
+    return true;
+}
+
+//----private------------------------------------------------------------------
+void GraphicDisplay::OnUpdate()
+{
+}
+
+//-----------------------------------------------------------------------------
+void GraphicDisplay::SetOnDoubleClickAction(TouchCallback callback)
+{
+    _onDoubleClickAction = callback;
+}
+
+//-----------------------------------------------------------------------------
+void GraphicDisplay::SetOnLongPressAction(TouchCallback callback)
+{
+    _onLongPressAction = callback;
+}
+
+//-----------------------------------------------------------------------------
+void GraphicDisplay::SetBrightness(uint8_t brightness)
+{
+    brightness = (brightness > 100) ? 100 : brightness;
+    _bklPin.SetDuty(static_cast<float>(brightness) / 100.0f);
+}
+
+//----private------------------------------------------------------------------
+void GraphicDisplay::SetupTouchDetection()
+{
+}
+
+//----private------------------------------------------------------------------
+void GraphicDisplay::OnTouchEventCallback(lv_event_t* /*e*/)
+{
+}
+
+//----private------------------------------------------------------------------
+GraphicDisplay::GraphicDisplay()
+    : _misoPin(static_cast<int>(Config::DISP_MISO_PIN)),
+      _mosiPin(static_cast<int>(Config::DISP_MOSI_PIN)),
+      _clkPin(static_cast<int>(Config::DISP_CLK_PIN)),
+      _csPin(static_cast<int>(Config::DISP_CS_PIN)),
+      _dcPin(static_cast<int>(Config::DISP_DC_PIN)),
+      _rstPin(static_cast<int>(Config::DISP_RESET_PIN)),
+      _touchCsPin(static_cast<int>(Config::DISP_TOUCH_CS_PIN)),
+      _touchIrqPin(static_cast<int>(Config::DISP_TOUCH_IRQ_PIN)),
+      _bklPin(Config::DISP_BACKLIGHT_PIN, 1000, LEDC_HIGH_SPEED_MODE, LEDC_TIMER_10_BIT, LEDC_CHANNEL_1, LEDC_TIMER_1)
+{
+}
+
+} // namespace Drivers
+
+//----HostSim------------------------------------------------------------------
+namespace HostSim {
+
+//-----------------------------------------------------------------------------
+std::string GetUiText(const lv_obj_t* object)
+{
+    std::lock_guard<std::mutex> guard(s_uiMutex);
+    return (object != nullptr) ? object->text : std::string();
+}
+
+//-----------------------------------------------------------------------------
+bool IsUiScreenActive(const lv_obj_t* screen)
+{
+    std::lock_guard<std::mutex> guard(s_uiMutex);
+    return (screen != nullptr) && (s_activeScreen == screen);
+}
+
+} // namespace HostSim
@@ -0,0 +1,436 @@
+/*!****************************************************************************
+ * @file    one_wire_sim.cpp
+ * @brief   Implementation of the simulated 1-Wire bus and DS18B20 probe.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#include "host/sim/one_wire_sim.h"
+#include "host_time.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace HostSim {
+
+namespace {
+
+static constexpr uint8_t CMD_READ_ROM = 0x33;
+static constexpr uint8_t CMD_MATCH_ROM = 0x55;
+static constexpr uint8_t CMD_SKIP_ROM = 0xCC;
+static constexpr uint8_t CMD_SEARCH_ROM = 0xF0;
+static constexpr uint8_t CMD_ALARM_SEARCH = 0xEC;
+static constexpr uint8_t CMD_CONVERT_T = 0x44;
+static constexpr uint8_t CMD_WRITE_SCRATCH = 0x4E;
+static constexpr uint8_t CMD_READ_SCRATCH = 0xBE;
+static constexpr uint8_t CMD_COPY_SCRATCH = 0x48;
+static constexpr uint8_t CMD_RECALL_E2 = 0xB8;
+static constexpr uint8_t CMD_READ_POWER = 0xB4;
+
+static constexpr uint64_t SLOT_WRITE_ZERO_MIN_US = 15;
+static constexpr uint64_t SLOT_MAX_US = 120;
+
+//-----------------------------------------------------------------------------
+uint8_t Crc8(const uint8_t* data, size_t length)
+{
+    uint8_t crc = 0;
+    for (size_t i = 0; i < length; i++)
+    {
+        uint8_t inbyte = data[i];
+        for (uint8_t j = 0; j < 8; j++)
+        {
+            const uint8_t mix = (crc ^ inbyte) & 0x01;
+            crc >>= 1;
+            if (mix)
+            {
+                crc ^= 0x8C;
+            }
+            inbyte >>= 1;
+        }
+    }
+    return crc;
+}
+
+} // namespace
+
+//----Ds18b20------------------------------------------------------------------
+Ds18b20::Ds18b20(uint64_t serial)
+    : _temperature(25.0f)
+{
+    _rom[0] = FAMILY_CODE;
+    for (size_t i = 0; i < 6; ++i)
+    {
+        _rom[1 + i] = static_cast<uint8_t>(serial >> (8 * i));
+    }
+    _rom[7] = Crc8(_rom.data(), 7);
+
+    // Power-on scratchpad: 85 C, TH 75, TL 70, 12-bit resolution
+    _scratchpad = {0x50, 0x05, 0x4B, 0x46, 0x7F, 0xFF, 0x0C, 0x10, 0x00};
+    UpdateScratchpadCrc();
+}
+
+//-----------------------------------------------------------------------------
+void Ds18b20::SetTemperature(float celsius)
+{
+    _temperature = celsius;
+}
+
+//-----------------------------------------------------------------------------
+void Ds18b20::OnReset(uint64_t busUs)
+{
+    LatchConversionIfDone();
+
+    _state = State::ROM_COMMAND;
+    _shift = 0;
+    _bitCount = 0;
+    _received.clear();
+    _transmitBits.clear();
+    _holdLowUntilUs = 0;
+
+    _presenceFromUs = busUs + PRESENCE_DELAY_US;
+    _presenceToUs = _presenceFromUs + PRESENCE_LENGTH_US;
+}
+
+//-----------------------------------------------------------------------------
+void Ds18b20::OnSlot(uint64_t lowStartUs, uint64_t lowLengthUs, uint64_t /*busUs*/)
+{
+    if (_state == State::IDLE || lowLengthUs > SLOT_MAX_US)
+    {
+        return;
+    }
+
+    const bool shortSlot = (lowLengthUs < SLOT_WRITE_ZERO_MIN_US);
+
+    if (_state == State::SEARCH)
+    {
+        OnSearchSlot(shortSlot, lowStartUs);
+        return;
+    }
+
+    // Read slots: the master only pulses briefly and samples while we hold the line
+    if (_state == State::TRANSMIT && shortSlot)
+    {
+        if (!_transmitBits.empty())
+        {
+            const bool bit = _transmitBits.front();
+            _transmitBits.pop_front();
+            _holdLowUntilUs = bit ? 0 : (lowStartUs + READ_HOLD_US);
+        }
+        return;
+    }
+
+    if (_state == State::CONVERTING && shortSlot)
+    {
+        LatchConversionIfDone();
+        _holdLowUntilUs = _conversionPending ? (lowStartUs + READ_HOLD_US) : 0;
+        return;
+    }
+
+    // Write slots: short low is a 1, long low is a 0 (LSB first)
+    const uint8_t bit = shortSlot ? 1 : 0;
+    _shift = static_cast<uint8_t>((_shift >> 1) | (bit << 7));
+
+    if (++_bitCount == 8)
+    {
+        const uint8_t value = _shift;
+        _shift = 0;
+        _bitCount = 0;
+        OnByteReceived(value);
+    }
+}
+
+//-----------------------------------------------------------------------------
+bool Ds18b20::IsPullingLow(uint64_t busUs) const
+{
+    if (busUs >= _presenceFromUs && busUs < _presenceToUs)
+    {
+        return true;
+    }
+
+    return busUs < _holdLowUntilUs;
+}
+
+//----private------------------------------------------------------------------
+void Ds18b20::OnByteReceived(uint8_t value)
+{
+    switch (_state)
+    {
+        case State::ROM_COMMAND:
+        {
+            if (value == CMD_SKIP_ROM)
+            {
+                _state = State::FUNCTION_COMMAND;
+            }
+            else if (value == CMD_READ_ROM)
+            {
+                QueueTransmit(_rom.data(), _rom.size());
+            }
+            else if (value == CMD_MATCH_ROM)
+            {
+                _received.clear();
+                _state = State::MATCH_ROM;
+            }
+            else if (value == CMD_SEARCH_ROM || (value == CMD_ALARM_SEARCH && IsInAlarm()))
+            {
+                _searchBit = 0;
+                _searchSlot = SearchSlot::BIT;
+                _state = State::SEARCH;
+            }
+            else
+            {
+                _state = State::IDLE;
+            }
+        }
+        break;
+
+        case State::MATCH_ROM:
+        {
+            _received.push_back(value);
+            if (_received.size() == _rom.size())
+            {
+                const bool selected = std::equal(_rom.begin(), _rom.end(), _received.begin());
+                _state = selected ? State::FUNCTION_COMMAND : State::IDLE;
+            }
+        }
+        break;
+
+        case State::FUNCTION_COMMAND:
+        {
+            OnFunctionCommand(value);
+        }
+        break;
+
+        case State::WRITE_SCRATCHPAD:
+        {
+            _received.push_back(value);
+            if (_received.size() == 3)
+            {
+                // TH, TL and configuration; the unused resolution bits read back as 1
+                _scratchpad[2] = _received[0];
+                _scratchpad[3] = _received[1];
+                _scratchpad[4] = static_cast<uint8_t>((_received[2] & 0x60) | 0x1F);
+                UpdateScratchpadCrc();
+                _state = State::IDLE;
+            }
+        }
+        break;
+
+        default:
+        {
+            // Bytes written while transmitting or idle are ignored by the device
+        }
+        break;
+    }
+}
+
+//----private------------------------------------------------------------------
+void Ds18b20::OnSearchSlot(bool shortSlot, uint64_t lowStartUs)
+{
+    const bool romBit = ((_rom[_searchBit / 8] >> (_searchBit % 8)) & 0x01) != 0;
+
+    switch (_searchSlot)
+    {
+        case SearchSlot::BIT:
+        {
+            // Read slot: send the ROM bit, then its complement (0 = hold the line)
+            _holdLowUntilUs = romBit ? 0 : (lowStartUs + READ_HOLD_US);
+            _searchSlot = SearchSlot::COMPLEMENT;
+        }
+        break;
+
+        case SearchSlot::COMPLEMENT:
+        {
+            _holdLowUntilUs = romBit ? (lowStartUs + READ_HOLD_US) : 0;
+            _searchSlot = SearchSlot::DIRECTION;
+        }
+        break;
+
+        case SearchSlot::DIRECTION:
+        {
+            // Write slot: the master picks a branch; devices on the other one drop out
+            if (shortSlot != romBit)
+            {
+                _state = State::IDLE;
+                return;
+            }
+
+            _searchSlot = SearchSlot::BIT;
+            if (++_searchBit == 64)
+            {
+                // The device found is selected, as after MATCH ROM
+                _state = State::FUNCTION_COMMAND;
+            }
+        }
+        break;
+    }
+}
+
+//----private------------------------------------------------------------------
+bool Ds18b20::IsInAlarm() const
+{
+    // Whole degrees of the last conversion against TH and TL
+    const int16_t raw = static_cast<int16_t>((_scratchpad[1] << 8) | _scratchpad[0]);
+    const int8_t celsius = static_cast<int8_t>(raw >> 4);
+    return (celsius >= static_cast<int8_t>(_scratchpad[2])) || (celsius <= static_cast<int8_t>(_scratchpad[3]));
+}
+
+//----private------------------------------------------------------------------
+void Ds18b20::OnFunctionCommand(uint8_t command)
+{
+    switch (command)
+    {
+        case CMD_CONVERT_T:
+        {
+            _conversionPending = true;
+            _conversionDoneUs = HostTime::NowUs() + ConversionTimeUs();
+            _state = State::CONVERTING;
+        }
+        break;
+
+        case CMD_READ_SCRATCH:
+        {
+            LatchConversionIfDone();
+            QueueTransmit(_scratchpad.data(), _scratchpad.size());
+        }
+        break;
+
+        case CMD_WRITE_SCRATCH:
+        {
+            _received.clear();
+            _state = State::WRITE_SCRATCHPAD;
+        }
+        break;
+
+        case CMD_READ_POWER:
+        {
+            // Externally powered: read slots return 1
+            _transmitBits.assign(1, true);
+            _state = State::TRANSMIT;
+        }
+        break;
+
+        case CMD_COPY_SCRATCH:
+        case CMD_RECALL_E2:
+        default:
+        {
+            _state = State::IDLE;
+        }
+        break;
+    }
+}
+
+//----private------------------------------------------------------------------
+void Ds18b20::QueueTransmit(const uint8_t* data, size_t length)
+{
+    _transmitBits.clear();
+    for (size_t i = 0; i < length; ++i)
+    {
+        for (int bit = 0; bit < 8; ++bit)
+        {
+            _transmitBits.push_back(((data[i] >> bit) & 0x01) != 0);
+        }
+    }
+    _state = State::TRANSMIT;
+}
+
+//----private------------------------------------------------------------------
+void Ds18b20::LatchConversionIfDone()
+{
+    if (!_conversionPending || HostTime::NowUs() < _conversionDoneUs)
+    {
+        return;
+    }
+
+    // Lower resolutions leave the least significant bits undefined (zero here)
+    const int resolutionBits = 9 + ((_scratchpad[4] >> 5) & 0x03);
+    const int16_t mask = static_cast<int16_t>(~((1 << (12 - resolutionBits)) - 1));
+    const int16_t raw = static_cast<int16_t>(std::lround(_temperature.load() * 16.0f)) & mask;
+
+    _scratchpad[0] = static_cast<uint8_t>(raw & 0xFF);
+    _scratchpad[1] = static_cast<uint8_t>((raw >> 8) & 0xFF);
+    UpdateScratchpadCrc();
+
+    _conversionPending = false;
+    _conversions++;
+}
+
+//----private------------------------------------------------------------------
+void Ds18b20::UpdateScratchpadCrc()
+{
+    _scratchpad[8] = Crc8(_scratchpad.data(), 8);
+}
+
+//----private------------------------------------------------------------------
+uint32_t Ds18b20::ConversionTimeUs() const
+{
+    // 93.75 ms at 9 bits, doubling per extra bit up to 750 ms at 12 bits
+    const int resolutionBits = 9 + ((_scratchpad[4] >> 5) & 0x03);
+    return 93750U << (resolutionBits - 9);
+}
+
+//----OneWireBus---------------------------------------------------------------
+void OneWireBus::AddDevice(Ds18b20* device)
+{
+    std::lock_guard<std::mutex> guard(_mutex);
+    _devices.push_back(device);
+}
+
+//-----------------------------------------------------------------------------
+void OneWireBus::OnPinWrite(gpio_num_t /*pin*/, int level)
+{
+    std::lock_guard<std::mutex> guard(_mutex);
+    const uint64_t now = HostTime::RomDelayTotalUs();
+
+    if (level == 0)
+    {
+        if (!_low)
+        {
+            _low = true;
+            _lowStartUs = now;
+        }
+        return;
+    }
+
+    if (!_low)
+    {
+        return;
+    }
+
+    _low = false;
+    const uint64_t lowLength = now - _lowStartUs;
+
+    if (lowLength >= RESET_MIN_US)
+    {
+        _resets++;
+        for (Ds18b20* device : _devices)
+        {
+            device->OnReset(now);
+        }
+        return;
+    }
+
+    for (Ds18b20* device : _devices)
+    {
+        device->OnSlot(_lowStartUs, lowLength, now);
+    }
+}
+
+//-----------------------------------------------------------------------------
+int OneWireBus::OnPinRead(gpio_num_t /*pin*/)
+{
+    std::lock_guard<std::mutex> guard(_mutex);
+    const uint64_t now = HostTime::RomDelayTotalUs();
+
+    // Wired-AND: any device holding the line wins
+    for (Ds18b20* device : _devices)
+    {
+        if (device->IsPullingLow(now))
+        {
+            return 0;
+        }
+    }
+
+    return _low ? 0 : 1;
+}
+
+} // namespace HostSim
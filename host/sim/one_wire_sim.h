@@ -0,0 +1,135 @@
+/*!****************************************************************************
+ * @file    one_wire_sim.h
+ * @brief   Bit-level 1-Wire bus with DS18B20 temperature probes.
+ *          Slots are decoded from the length of the low pulses the firmware
+ *          drives, measured on the esp_rom_delay_us() timeline.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#pragma once
+
+#include "host_bus.h"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+namespace HostSim {
+
+class Ds18b20
+{
+    public:
+
+        using Rom = std::array<uint8_t, 8>;
+
+        /**
+         * @brief Creates a probe with the given 48-bit serial number.
+         */
+        explicit Ds18b20(uint64_t serial);
+
+        /**
+         * @brief Sets the water temperature the next conversion will latch.
+         */
+        void SetTemperature(float celsius);
+
+        const Rom& GetRom() const { return _rom; }
+        uint32_t GetConversionCount() const { return _conversions; }
+
+        //---------------------------------------------
+        // Bus side, called by OneWireBus with its mutex held
+
+        void OnReset(uint64_t busUs);
+        void OnSlot(uint64_t lowStartUs, uint64_t lowLengthUs, uint64_t busUs);
+        bool IsPullingLow(uint64_t busUs) const;
+
+    private:
+
+        enum class State
+        {
+            IDLE,
+            ROM_COMMAND,
+            MATCH_ROM,
+            FUNCTION_COMMAND,
+            WRITE_SCRATCHPAD,
+            TRANSMIT,
+            CONVERTING,
+            SEARCH,
+        };
+
+        //! Each ROM bit of a search takes three slots
+        enum class SearchSlot
+        {
+            BIT,
+            COMPLEMENT,
+            DIRECTION,
+        };
+
+        void OnByteReceived(uint8_t value);
+        void OnSearchSlot(bool shortSlot, uint64_t lowStartUs);
+        bool IsInAlarm() const;
+        void OnFunctionCommand(uint8_t command);
+        void QueueTransmit(const uint8_t* data, size_t length);
+        void LatchConversionIfDone();
+        void UpdateScratchpadCrc();
+        uint32_t ConversionTimeUs() const;
+
+        static constexpr uint8_t FAMILY_CODE = 0x28;
+        static constexpr uint64_t PRESENCE_DELAY_US = 15;
+        static constexpr uint64_t PRESENCE_LENGTH_US = 120;
+        static constexpr uint64_t READ_HOLD_US = 30;
+
+        Rom _rom;
+        std::array<uint8_t, 9> _scratchpad;
+        std::atomic<float> _temperature;
+
+        State _state = State::IDLE;
+        uint8_t _shift = 0;
+        uint8_t _bitCount = 0;
+        std::vector<uint8_t> _received;
+        std::deque<bool> _transmitBits;
+
+        uint8_t _searchBit = 0;
+        SearchSlot _searchSlot = SearchSlot::BIT;
+
+        uint64_t _presenceFromUs = 0;
+        uint64_t _presenceToUs = 0;
+        uint64_t _holdLowUntilUs = 0;
+
+        uint64_t _conversionDoneUs = 0;
+        bool _conversionPending = false;
+        std::atomic<uint32_t> _conversions{0};
+};
+
+class OneWireBus : public HostBus::IGpioDevice
+{
+    public:
+
+        /**
+         * @brief Adds a probe to the bus; the bus does not take ownership.
+         */
+        void AddDevice(Ds18b20* device);
+
+        //---------------------------------------------
+        // HostBus::IGpioDevice
+
+        void OnPinWrite(gpio_num_t pin, int level) override;
+        int OnPinRead(gpio_num_t pin) override;
+
+        uint32_t GetResetCount() const { return _resets; }
+
+    private:
+
+        static constexpr uint64_t RESET_MIN_US = 480;
+
+        std::mutex _mutex;
+        std::vector<Ds18b20*> _devices;
+        bool _low = false;
+        uint64_t _lowStartUs = 0;
+        std::atomic<uint32_t> _resets{0};
+};
+
+} // namespace HostSim
@@ -0,0 +1,115 @@
+/*!****************************************************************************
+ * @file    rtc_sim.cpp
+ * @brief   Implementation of the simulated DS1307 real-time clock.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#include "host/sim/rtc_sim.h"
+
+namespace HostSim {
+
+namespace {
+
+//-----------------------------------------------------------------------------
+uint8_t ToBcd(int value)
+{
+    return static_cast<uint8_t>(((value / 10) << 4) | (value % 10));
+}
+
+//-----------------------------------------------------------------------------
+int FromBcd(uint8_t value)
+{
+    return ((value >> 4) * 10) + (value & 0x0F);
+}
+
+} // namespace
+
+//-----------------------------------------------------------------------------
+bool Ds1307::OnWrite(const uint8_t* data, size_t length)
+{
+    std::lock_guard<std::mutex> guard(_mutex);
+
+    if (length == 0)
+    {
+        return true;
+    }
+
+    _pointer = static_cast<uint8_t>(data[0] % REGISTER_COUNT);
+    if (length == 1)
+    {
+        return true;
+    }
+
+    // Writes into the time registers re-base the clock against the host time
+    std::array<uint8_t, TIME_REGISTERS> time = SnapshotLocked();
+    bool timeWritten = false;
+
+    for (size_t i = 1; i < length; ++i)
+    {
+        if (_pointer < TIME_REGISTERS)
+        {
+            time[_pointer] = data[i];
+            timeWritten = true;
+        }
+        else
+        {
+            _ram[_pointer] = data[i];
+        }
+        _pointer = static_cast<uint8_t>((_pointer + 1) % REGISTER_COUNT);
+    }
+
+    if (timeWritten)
+    {
+        const time_t now = std::time(nullptr);
+        struct tm target;
+        localtime_r(&now, &target);
+
+        target.tm_sec = FromBcd(time[0] & 0x7F);
+        target.tm_min = FromBcd(time[1] & 0x7F);
+        target.tm_hour = FromBcd(time[2] & 0x3F);
+        target.tm_mday = FromBcd(time[4] & 0x3F);
+        target.tm_mon = FromBcd(time[5] & 0x1F) - 1;
+        target.tm_year = FromBcd(time[6]) + 100;
+        target.tm_isdst = -1;
+
+        _offsetSeconds = std::mktime(&target) - now;
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+bool Ds1307::OnRead(uint8_t* data, size_t length)
+{
+    std::lock_guard<std::mutex> guard(_mutex);
+
+    const std::array<uint8_t, TIME_REGISTERS> time = SnapshotLocked();
+    for (size_t i = 0; i < length; ++i)
+    {
+        data[i] = (_pointer < TIME_REGISTERS) ? time[_pointer] : _ram[_pointer];
+        _pointer = static_cast<uint8_t>((_pointer + 1) % REGISTER_COUNT);
+    }
+
+    return true;
+}
+
+//----private------------------------------------------------------------------
+std::array<uint8_t, Ds1307::TIME_REGISTERS> Ds1307::SnapshotLocked() const
+{
+    const time_t now = std::time(nullptr) + _offsetSeconds;
+    struct tm local;
+    localtime_r(&now, &local);
+
+    return {
+        ToBcd(local.tm_sec),
+        ToBcd(local.tm_min),
+        ToBcd(local.tm_hour),
+        static_cast<uint8_t>(local.tm_wday + 1),
+        ToBcd(local.tm_mday),
+        ToBcd(local.tm_mon + 1),
+        ToBcd(local.tm_year % 100),
+    };
+}
+
+} // namespace HostSim
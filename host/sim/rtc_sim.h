@@ -0,0 +1,43 @@
+/*!****************************************************************************
+ * @file    rtc_sim.h
+ * @brief   DS1307 real-time clock model. Time registers are BCD and follow
+ *          the host wall clock plus whatever offset the firmware last set.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#pragma once
+
+#include "host_bus.h"
+
+#include <array>
+#include <cstdint>
+#include <ctime>
+#include <mutex>
+
+namespace HostSim {
+
+class Ds1307 : public HostBus::II2cDevice
+{
+    public:
+
+        //---------------------------------------------
+        // HostBus::II2cDevice
+
+        bool OnWrite(const uint8_t* data, size_t length) override;
+        bool OnRead(uint8_t* data, size_t length) override;
+
+    private:
+
+        static constexpr size_t TIME_REGISTERS = 7;
+        static constexpr size_t REGISTER_COUNT = 64;
+
+        std::array<uint8_t, TIME_REGISTERS> SnapshotLocked() const;
+
+        std::mutex _mutex;
+        std::array<uint8_t, REGISTER_COUNT> _ram = {};
+        uint8_t _pointer = 0;
+        time_t _offsetSeconds = 0;
+};
+
+} // namespace HostSim
@@ -0,0 +1,135 @@
+/*!****************************************************************************
+ * @file    adc_sampler_test.cpp
+ * @brief   AdcSampler on the host continuous ADC: each registered channel
+ *          settles on its own voltage, follows a step within a few frames,
+ *          keeps the sub-code resolution of the oversampling on a replayed
+ *          capture, and the sampling task never falls behind.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#include "tests/host_test.h"
+
+#include "esp_adc/adc_cali_scheme.h"
+#include "framework/drivers/analog_in.h"
+#include "host_bus.h"
+#include "include/config.h"
+#include "src/services/adc_sampler.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <thread>
+
+namespace {
+
+using Services::AdcSampler;
+
+static constexpr float TOLERANCE_V = 0.01f;
+static constexpr float RESOLVED_V = 0.0001f;               //!< A tenth of a calibrated millivolt
+static constexpr int SETTLE_TIMEOUT_MS = 1000;
+
+//-----------------------------------------------------------------------------
+adc_channel_t AdcChannelOf(PinName pin)
+{
+    adc_channel_t channel = ADC_CHANNEL_0;
+    HOST_CHECK(AnalogIn::PinToAdcChannel(pin, channel));
+    return channel;
+}
+
+//-----------------------------------------------------------------------------
+//! Waits (real time, the frames are produced at the sample rate) until done() holds
+bool WaitFor(const std::function<bool()>& done)
+{
+    for (int ms = 0; ms < SETTLE_TIMEOUT_MS; ++ms)
+    {
+        if (done())
+        {
+            return true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return done();
+}
+
+bool IsNear(float actual, float expected)
+{
+    return std::fabs(actual - expected) < TOLERANCE_V;
+}
+
+//-----------------------------------------------------------------------------
+void TestChannels(AdcSampler* sampler, AdcSampler::ChannelId tds, AdcSampler::ChannelId battery)
+{
+    HOST_CHECK(tds != AdcSampler::INVALID_CHANNEL);
+    HOST_CHECK(battery != AdcSampler::INVALID_CHANNEL);
+    HOST_CHECK(tds != battery);
+
+    // Registering a pin again hands back its channel; ADC2 pins cannot be sampled
+    HOST_CHECK_EQ(sampler->AddChannel(Config::TDS_SENSOR_ADC_PIN), tds);
+    HOST_CHECK_EQ(sampler->AddChannel(PinName::P25), AdcSampler::INVALID_CHANNEL);
+    HOST_CHECK(!sampler->HasReading(AdcSampler::INVALID_CHANNEL));
+    HOST_CHECK(sampler->ReadVoltage(AdcSampler::INVALID_CHANNEL) == 0.0f);
+
+    HOST_CHECK(WaitFor([&]() { return sampler->HasReading(tds) && sampler->HasReading(battery); }));
+    HOST_CHECK(WaitFor([&]() { return IsNear(sampler->ReadVoltage(tds), 0.45f) && IsNear(sampler->ReadVoltage(battery), 1.95f); }));
+
+    // A step shows up within a few frames, on its channel only
+    HostBus::SetAdcVoltage(AdcChannelOf(Config::TDS_SENSOR_ADC_PIN), 1.20f);
+    HOST_CHECK(WaitFor([&]() { return IsNear(sampler->ReadVoltage(tds), 1.20f); }));
+    HOST_CHECK(IsNear(sampler->ReadVoltage(battery), 1.95f));
+
+    std::printf("adc_sampler: tds %.4f V, battery %.4f V\n", sampler->ReadVoltage(tds), sampler->ReadVoltage(battery));
+}
+
+//-----------------------------------------------------------------------------
+void TestOversampledResolution(AdcSampler* sampler, AdcSampler::ChannelId tds)
+{
+    static constexpr int LOW_CODE = 601;
+
+    // Two neighbouring codes a calibrated millivolt apart
+    const adc_cali_line_fitting_config_t caliConfig = { .unit_id = ADC_UNIT_1, .atten = ADC_ATTEN_DB_12, .bitwidth = ADC_BITWIDTH_DEFAULT };
+    adc_cali_handle_t cali = nullptr;
+    int lowMv = 0;
+    int highMv = 0;
+    HOST_CHECK(adc_cali_create_scheme_line_fitting(&caliConfig, &cali) == ESP_OK);
+    HOST_CHECK(adc_cali_raw_to_voltage(cali, LOW_CODE, &lowMv) == ESP_OK);
+    HOST_CHECK(adc_cali_raw_to_voltage(cali, LOW_CODE + 1, &highMv) == ESP_OK);
+    HOST_CHECK(highMv > lowMv);
+    adc_cali_delete_scheme_line_fitting(cali);
+
+    // Alternating codes average to half a code: only the oversampling resolves it
+    HostBus::SetAdcReplay(AdcChannelOf(Config::TDS_SENSOR_ADC_PIN), { LOW_CODE, LOW_CODE + 1 });
+
+    const float middle = (lowMv + highMv) / 2000.0f;
+    HOST_CHECK(WaitFor([&]() { return std::fabs(sampler->ReadVoltage(tds) - middle) < RESOLVED_V; }));
+
+    std::printf("adc_sampler: replayed %d/%d reads %.5f V (codes %d / %d mV)\n",
+                LOW_CODE, LOW_CODE + 1, sampler->ReadVoltage(tds), lowMv, highMv);
+    HostBus::SetAdcReplay(AdcChannelOf(Config::TDS_SENSOR_ADC_PIN), {});
+}
+
+} // namespace
+
+//-----------------------------------------------------------------------------
+int main()
+{
+    HostBus::SetAdcVoltage(AdcChannelOf(Config::TDS_SENSOR_ADC_PIN), 0.45f);
+    HostBus::SetAdcVoltage(AdcChannelOf(Config::BATTERY_ADC_PIN), 1.95f);
+
+    AdcSampler* sampler = AdcSampler::GetInstance();
+    HOST_CHECK(sampler->Init());
+
+    const AdcSampler::ChannelId tds = sampler->AddChannel(Config::TDS_SENSOR_ADC_PIN);
+    const AdcSampler::ChannelId battery = sampler->AddChannel(Config::BATTERY_ADC_PIN);
+
+    TestChannels(sampler, tds, battery);
+    TestOversampledResolution(sampler, tds);
+
+    HOST_CHECK_EQ(sampler->GetOverflowCount(), 0);
+
+    // The sampling task never returns; leave without running static destructors under it
+    const int status = HostTest::Finish("adc_sampler_test");
+    std::fflush(stdout);
+    std::_Exit(status);
+}
@@ -0,0 +1,154 @@
+/*!****************************************************************************
+ * @file    arena_json_test.cpp
+ * @brief   ArenaJson inside an ArenaScope: building, parsing, dumping and
+ *          tearing a nested DOM down must not touch the general heap. The
+ *          tear-down relies on the json.hpp patch in lib/nlohmann_json
+ *          (flattening stack with the json's allocator).
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#include "tests/host_test.h"
+
+#include "framework/memory/arena.h"
+#include "framework/memory/arena_json.h"
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <optional>
+#include <string>
+#include <string_view>
+
+//-----------------------------------------------------------------------------
+// Heap allocations of the test thread while counting is on
+
+static std::atomic<uint64_t> s_allocations{0};
+static thread_local bool t_counting = false;
+
+void* operator new(size_t size)
+{
+    if (t_counting)
+    {
+        s_allocations.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    if (void* block = std::malloc(size != 0 ? size : 1))
+    {
+        return block;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* block) noexcept { std::free(block); }
+void operator delete(void* block, size_t) noexcept { std::free(block); }
+
+namespace {
+
+using Memory::ArenaJson;
+
+static constexpr size_t ARENA_SIZE = 16 * 1024;
+static constexpr std::string_view DOCUMENT =
+    "{\"method\":\"syncDevice\",\"params\":{\"schedule\":[{\"hour\":8,\"minute\":30,\"doses\":2},"
+    "{\"hour\":20,\"minute\":0,\"doses\":1}],\"thresholds\":{\"temp\":[24.5,28.0],\"tds\":[150,400]},"
+    "\"name\":\"a device name long enough to leave the small string buffer\"}}";
+
+//! The same document as dump() writes it: keys sorted, one decimal kept on 28.0
+static constexpr std::string_view DUMPED =
+    "{\"method\":\"syncDevice\",\"params\":{\"name\":\"a device name long enough to leave the small string buffer\","
+    "\"schedule\":[{\"doses\":2,\"hour\":8,\"minute\":30},{\"doses\":1,\"hour\":20,\"minute\":0}],"
+    "\"thresholds\":{\"tds\":[150,400],\"temp\":[24.5,28.0]}}}";
+
+//-----------------------------------------------------------------------------
+template <typename Function>
+uint64_t CountAllocations(const char* name, Function&& function)
+{
+    s_allocations = 0;
+    t_counting = true;
+    function();
+    t_counting = false;
+
+    const uint64_t allocations = s_allocations.load();
+    std::printf("%-32s %llu allocation(s)\n", name, static_cast<unsigned long long>(allocations));
+    return allocations;
+}
+
+//-----------------------------------------------------------------------------
+void TestCountingSeesAllocations()
+{
+    const uint64_t allocations = CountAllocations("probe: std::string(64)", []()
+        {
+            std::string probe(64, 'x');
+            asm volatile("" : : "r"(probe.data()) : "memory");
+        }
+    );
+    HOST_CHECK_EQ(allocations, 1);
+}
+
+//-----------------------------------------------------------------------------
+void TestTearDown()
+{
+    Memory::StaticArena<ARENA_SIZE> arena("json");
+    Memory::ArenaScope scope(arena);
+
+    std::optional<ArenaJson> document;
+    HOST_CHECK_EQ(CountAllocations("build", [&document]()
+        {
+            document.emplace(ArenaJson::object());
+            ArenaJson& doc = *document;
+            doc["readings"] = ArenaJson::array();
+            for (int i = 0; i < 16; ++i)
+            {
+                doc["readings"].push_back({ { "t", 25.0 + i }, { "tds", 200 + i }, { "tags", { "a", "b", "c" } } });
+            }
+            doc["name"] = "a device name long enough to leave the small string buffer";
+        }
+    ), 0);
+
+    // Flattening the nested values takes a stack: it comes from the arena too
+    const size_t markBeforeTearDown = arena.GetMark();
+    HOST_CHECK_EQ(CountAllocations("tear down", [&document]() { document.reset(); }), 0);
+    HOST_CHECK(arena.GetMark() > markBeforeTearDown);
+
+    const Memory::Arena::Stats stats = arena.GetStats();
+    HOST_CHECK_EQ(stats.heapFallbacks, 0);
+    HOST_CHECK_EQ(stats.strayFrees, 0);
+}
+
+//-----------------------------------------------------------------------------
+void TestParseDumpRoundTrip()
+{
+    Memory::StaticArena<ARENA_SIZE> arena("json");
+
+    Memory::ArenaString dumped;
+    {
+        Memory::ArenaScope scope(arena);
+        HOST_CHECK_EQ(CountAllocations("parse, dump, tear down", [&dumped]()
+            {
+                const ArenaJson json = Memory::ParseArenaJson(DOCUMENT);
+                HOST_CHECK(!json.is_discarded());
+                HOST_CHECK_EQ(json["params"]["schedule"].size(), 2);
+                dumped = Memory::DumpArenaJson(json);
+                HOST_CHECK(std::string_view(dumped.data(), dumped.size()) == DUMPED);
+                dumped = Memory::ArenaString();
+            }
+        ), 0);
+    }
+
+    const Memory::Arena::Stats stats = arena.GetStats();
+    HOST_CHECK_EQ(stats.heapFallbacks, 0);
+    HOST_CHECK_EQ(stats.strayFrees, 0);
+    HOST_CHECK_EQ(stats.used, 0);
+}
+
+} // namespace
+
+//-----------------------------------------------------------------------------
+int main()
+{
+    TestCountingSeesAllocations();
+    TestTearDown();
+    TestParseDumpRoundTrip();
+
+    return HostTest::Finish("arena_json_test");
+}
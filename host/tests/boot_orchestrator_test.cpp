@@ -0,0 +1,242 @@
+/*!****************************************************************************
+ * @file    boot_orchestrator_test.cpp
+ * @brief   BootOrchestrator on a VirtualClock with a scripted supply: steps
+ *          start after their dependencies, steps whose inrush does not fit
+ *          the budget together wait for each other, a step with inrush is
+ *          released once the supply reads stable, no reading yet does not
+ *          count as stable, and an unsettled supply ends in the timeout.
+ *          The orchestrator is a singleton: each case boots in a child.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#include "tests/host_test.h"
+
+#include "framework/os/virtual_clock.h"
+#include "include/config.h"
+#include "src/core/base/module.h"
+#include "src/core/boot_orchestrator.h"
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <optional>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace {
+
+using Boot = Core::BootOrchestrator;
+
+static constexpr uint64_t POLL_US = Config::BOOT_SETTLE_POLL_MS * 1000ULL;
+static constexpr uint64_t STABLE_SAMPLES = Config::BOOT_SUPPLY_STABLE_SAMPLES;
+static constexpr float SUPPLY_V = 3.3f;
+
+//-----------------------------------------------------------------------------
+class FakeStep : public Base::Module
+{
+    public:
+
+        explicit FakeStep(const char* name, std::function<void()> onInit = {}, bool result = true)
+            : _name(name), _onInit(std::move(onInit)), _result(result)
+        {}
+
+    protected:
+
+        const char* GetModuleName() const override { return _name; }
+
+        bool OnInit() override
+        {
+            if (_onInit)
+            {
+                _onInit();
+            }
+            return _result;
+        }
+
+    private:
+
+        const char* _name;
+        std::function<void()> _onInit;
+        bool _result;
+};
+
+//! The supply as the steps load it: every inrush sags it for a few readings, alternating
+struct Supply
+{
+    std::atomic<int> sagReadings{0};
+    std::atomic<int> missingReadings{0};          //!< Readings before the sampler has one; < 0: never
+    std::atomic<int> readings{0};
+
+    std::optional<float> Read()
+    {
+        ++readings;
+
+        const int missing = missingReadings.load();
+        if (missing != 0)
+        {
+            missingReadings = (missing > 0) ? missing - 1 : missing;
+            return std::nullopt;
+        }
+
+        const int sag = sagReadings.load();
+        if (sag > 0)
+        {
+            sagReadings = sag - 1;
+            return SUPPLY_V - 0.3f + 0.1f * static_cast<float>(sag % 2);
+        }
+        return SUPPLY_V;
+    }
+
+    std::function<void()> Inrush(int sag)
+    {
+        return [this, sag]() { sagReadings = sag; };
+    }
+};
+
+Boot::StepTimes TimesOf(Boot::StepId id)
+{
+    const std::optional<Boot::StepTimes> times = Boot::GetInstance()->GetStepTimes(id);
+    HOST_CHECK(times.has_value());
+    return times.value_or(Boot::StepTimes{});
+}
+
+//-----------------------------------------------------------------------------
+//! Runs 'body' in a child process: a fresh orchestrator
+bool InChild(const std::function<void()>& body)
+{
+    std::fflush(stdout);
+
+    const pid_t pid = fork();
+    if (pid == 0)
+    {
+        body();
+        std::fflush(stdout);
+        std::_Exit(HostTest::Failures() == 0 ? 0 : 1);
+    }
+
+    int status = 0;
+    return (pid > 0) && (waitpid(pid, &status, 0) == pid) && WIFEXITED(status) && (WEXITSTATUS(status) == 0);
+}
+
+//-----------------------------------------------------------------------------
+void TestOrderAndBudget()
+{
+    static constexpr int SAG_READINGS = 4;
+
+    VirtualClock clock;
+    Supply supply;
+    auto* boot = Boot::GetInstance();
+
+    FakeStep power("Power");
+    FakeStep display("Display", supply.Inrush(SAG_READINGS));
+    FakeStep wifi("Wifi", supply.Inrush(SAG_READINGS));
+    FakeStep servo("Servo", supply.Inrush(SAG_READINGS));
+    FakeStep splash("Splash");
+    FakeStep broken("Broken", {}, false);
+    FakeStep afterBroken("AfterBroken");
+
+    const Boot::StepId powerId = boot->Add({ "Power", &power });
+    const Boot::StepId displayId = boot->Add({ "Display", &display, Boot::After(powerId), Config::DISPLAY_INRUSH_MA, 300 });
+    const Boot::StepId wifiId = boot->Add({ "Wifi", &wifi, Boot::After(powerId), Config::WIFI_INRUSH_MA, 500 });
+    const Boot::StepId servoId = boot->Add({ "Servo", &servo, Boot::After(powerId), Config::SERVO_INRUSH_MA, 400 });
+    const Boot::StepId splashId = boot->Add({ "Splash", &splash, Boot::After(displayId) });
+    const Boot::StepId brokenId = boot->Add({ "Broken", &broken });
+    const Boot::StepId afterBrokenId = boot->Add({ "AfterBroken", &afterBroken, Boot::After(brokenId) });
+
+    // Only steps added before can be depended on
+    FakeStep orphan("Orphan");
+    HOST_CHECK_EQ(boot->Add({ "Orphan", &orphan, Boot::After(10) }), Boot::INVALID_STEP);
+
+    HOST_CHECK(!boot->Run(clock, [&supply]() { return supply.Read(); }));
+
+    const Boot::StepTimes powerTimes = TimesOf(powerId);
+    const Boot::StepTimes displayTimes = TimesOf(displayId);
+    const Boot::StepTimes wifiTimes = TimesOf(wifiId);
+    const Boot::StepTimes servoTimes = TimesOf(servoId);
+    const Boot::StepTimes splashTimes = TimesOf(splashId);
+
+    // Display and Wi-Fi fit the budget together and start at once; the servo fits with neither
+    static_assert(Config::DISPLAY_INRUSH_MA + Config::WIFI_INRUSH_MA <= Config::BOOT_INRUSH_BUDGET_MA, "");
+    static_assert(Config::SERVO_INRUSH_MA + Config::DISPLAY_INRUSH_MA > Config::BOOT_INRUSH_BUDGET_MA, "");
+    static_assert(Config::SERVO_INRUSH_MA + Config::WIFI_INRUSH_MA > Config::BOOT_INRUSH_BUDGET_MA, "");
+
+    HOST_CHECK_EQ(powerTimes.startUs, 0);
+    HOST_CHECK(displayTimes.startUs >= powerTimes.readyUs);
+    HOST_CHECK_EQ(displayTimes.startUs, wifiTimes.startUs);
+    HOST_CHECK(servoTimes.startUs >= displayTimes.readyUs);
+    HOST_CHECK(servoTimes.startUs >= wifiTimes.readyUs);
+    HOST_CHECK(splashTimes.startUs >= displayTimes.readyUs);
+
+    // The servo settles alone: its sag, one reading to compare against, then the stable run
+    HOST_CHECK(displayTimes.settled && wifiTimes.settled && servoTimes.settled);
+    HOST_CHECK_EQ(servoTimes.readyUs - servoTimes.initDoneUs, (SAG_READINGS + STABLE_SAMPLES) * POLL_US);
+    HOST_CHECK(displayTimes.readyUs - displayTimes.initDoneUs >= STABLE_SAMPLES * POLL_US);
+
+    // A failed step is reported and still lets its dependents run
+    HOST_CHECK(!TimesOf(brokenId).success);
+    HOST_CHECK(TimesOf(afterBrokenId).success);
+    HOST_CHECK(TimesOf(afterBrokenId).startUs >= TimesOf(brokenId).readyUs);
+
+    std::printf("boot: display/wifi at %llu ms, servo at %llu ms, ready after %llu ms\n",
+                static_cast<unsigned long long>(displayTimes.startUs / 1000),
+                static_cast<unsigned long long>(servoTimes.startUs / 1000),
+                static_cast<unsigned long long>(servoTimes.readyUs / 1000));
+}
+
+//-----------------------------------------------------------------------------
+void TestNoReadingIsNotSettled()
+{
+    static constexpr int MISSING_READINGS = 5;
+
+    VirtualClock clock;
+    Supply supply;
+    supply.missingReadings = MISSING_READINGS;
+    auto* boot = Boot::GetInstance();
+
+    FakeStep display("Display");
+    const Boot::StepId displayId = boot->Add({ "Display", &display, 0, Config::DISPLAY_INRUSH_MA, 300 });
+
+    HOST_CHECK(boot->Run(clock, [&supply]() { return supply.Read(); }));
+
+    // The first reading only gives the value to compare against
+    const Boot::StepTimes times = TimesOf(displayId);
+    HOST_CHECK(times.settled);
+    HOST_CHECK_EQ(times.readyUs - times.initDoneUs, (MISSING_READINGS + STABLE_SAMPLES) * POLL_US);
+}
+
+//-----------------------------------------------------------------------------
+void TestSettleTimeout(bool withReading)
+{
+    static constexpr uint32_t TIMEOUT_MS = 300;
+
+    VirtualClock clock;
+    Supply supply;
+    supply.missingReadings = withReading ? 0 : -1;
+    supply.sagReadings = withReading ? 1000000 : 0;
+    auto* boot = Boot::GetInstance();
+
+    FakeStep servo("Servo");
+    const Boot::StepId servoId = boot->Add({ "Servo", &servo, 0, Config::SERVO_INRUSH_MA, TIMEOUT_MS });
+
+    HOST_CHECK(boot->Run(clock, [&supply]() { return supply.Read(); }));
+
+    // Released at the first sample past the timeout, not settled
+    const Boot::StepTimes times = TimesOf(servoId);
+    HOST_CHECK(!times.settled);
+    HOST_CHECK(times.readyUs - times.initDoneUs >= TIMEOUT_MS * 1000ULL);
+    HOST_CHECK(times.readyUs - times.initDoneUs <= TIMEOUT_MS * 1000ULL + POLL_US);
+}
+
+} // namespace
+
+//-----------------------------------------------------------------------------
+int main()
+{
+    HOST_CHECK(InChild(TestOrderAndBudget));
+    HOST_CHECK(InChild(TestNoReadingIsNotSettled));
+    HOST_CHECK(InChild([]() { TestSettleTimeout(true); }));
+    HOST_CHECK(InChild([]() { TestSettleTimeout(false); }));
+
+    return HostTest::Finish("boot_orchestrator_test");
+}
@@ -0,0 +1,265 @@
+/*!****************************************************************************
+ * @file    config_record_test.cpp
+ * @brief   ConfigRecord round trips: defaults and a config with every field
+ *          set decode to the same values, a change rewrites only its own
+ *          bytes and the header, any flipped bit or short read is rejected
+ *          without touching the config, a record of an older layout loads
+ *          the fields it lacks as they were, and unknown tags are skipped.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#include "tests/host_test.h"
+
+#include "esp_rom_crc.h"
+#include "src/services/memory/config_record.h"
+#include "src/services/memory/memory_config_data.h"
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Services::ConfigRecord;
+using Services::MemoryConfigData;
+
+static constexpr size_t CAPACITY = 1024;
+static constexpr size_t CRC_OFFSET = 12;                    //!< In the header, after magic..sequence
+static constexpr size_t FIXED_SIZE_OFFSET = 6;
+static constexpr size_t LENGTH_OFFSET = 8;
+
+//-----------------------------------------------------------------------------
+bool SameConfig(const MemoryConfigData& a, const MemoryConfigData& b)
+{
+    bool same = true;
+    #define X(type, id, name, key, def) same = same && (a.name == b.name);
+    CONFIG_FIELDS
+    #undef X
+    return same;
+}
+
+//! Every field away from its default
+MemoryConfigData FullConfig()
+{
+    MemoryConfigData config;
+    config._wifiSsid = "aquarium-net";
+    config._wifiPassword = std::string(63, 'p');
+    config._timezone = "CET-1CEST,M3.5.0,M10.5.0/3";
+    config._tempLimitMin = 23.25f;
+    config._tempLimitMinEnabled = true;
+    config._tempLimitMax = 27.5f;
+    config._tempLimitMaxEnabled = true;
+    config._tdsLimitMin = 120;
+    config._tdsLimitMinEnabled = true;
+    config._tdsLimitMax = 650;
+    config._tdsLimitMaxEnabled = true;
+    config._trendEnabled = false;
+    config._tempRateLimit = 1.5f;
+    config._tdsRateLimit = 250;
+    config._spikeZScore = 7.0f;
+
+    for (int slot = 0; slot < static_cast<int>(Services::MAX_FEEDING_SCHEDULE_ENTRIES); ++slot)
+    {
+        config._feedingSchedule.push_back({ 1439 - slot * 97, slot, 1 + slot % 4, (slot % 3) != 0 });
+    }
+    return config;
+}
+
+std::vector<uint8_t> Encode(const MemoryConfigData& config, uint16_t sequence)
+{
+    std::vector<uint8_t> record(CAPACITY);
+    record.resize(ConfigRecord::Encode(config, sequence, record.data(), record.size()));
+    return record;
+}
+
+//! Header fields written back after a test edits the record, with a valid CRC
+void Reseal(std::vector<uint8_t>& record)
+{
+    const uint16_t length = static_cast<uint16_t>(record.size());
+    std::memcpy(record.data() + LENGTH_OFFSET, &length, sizeof(length));
+
+    uint32_t crc = esp_rom_crc32_le(0, record.data(), CRC_OFFSET);
+    crc = esp_rom_crc32_le(crc, record.data() + ConfigRecord::HEADER_SIZE, static_cast<uint32_t>(record.size() - ConfigRecord::HEADER_SIZE));
+    std::memcpy(record.data() + CRC_OFFSET, &crc, sizeof(crc));
+}
+
+//-----------------------------------------------------------------------------
+void TestRoundTrip()
+{
+    for (const MemoryConfigData& config : { MemoryConfigData{}, FullConfig() })
+    {
+        const std::vector<uint8_t> record = Encode(config, 42);
+        HOST_CHECK(!record.empty());
+
+        uint16_t sequence = 0;
+        size_t length = 0;
+        HOST_CHECK(ConfigRecord::ReadHeader(record.data(), sequence, length));
+        HOST_CHECK_EQ(sequence, 42);
+        HOST_CHECK_EQ(length, record.size());
+
+        // Into a config holding other values: every field is overwritten
+        MemoryConfigData decoded = (config._wifiSsid.empty()) ? FullConfig() : MemoryConfigData{};
+        HOST_CHECK_EQ(ConfigRecord::Decode(record.data(), record.size(), decoded), record.size());
+        HOST_CHECK(SameConfig(decoded, config));
+
+        // The same config gives the same bytes
+        HOST_CHECK(Encode(decoded, 42) == record);
+    }
+
+    std::printf("config_record: %zu bytes with defaults, %zu with every field set\n",
+                Encode(MemoryConfigData{}, 0).size(), Encode(FullConfig(), 0).size());
+}
+
+//-----------------------------------------------------------------------------
+void TestLocalChanges()
+{
+    const MemoryConfigData config = FullConfig();
+    const std::vector<uint8_t> before = Encode(config, 7);
+
+    // The first fixed field: its 4 bytes and the header, nothing else
+    MemoryConfigData changed = config;
+    changed._tempLimitMin = 22.0f;
+    std::vector<uint8_t> after = Encode(changed, 8);
+    HOST_CHECK_EQ(after.size(), before.size());
+
+    size_t changedBytes = 0;
+    size_t outside = 0;
+    for (size_t i = ConfigRecord::HEADER_SIZE; i < after.size(); ++i)
+    {
+        const bool differs = (after[i] != before[i]);
+        changedBytes += differs ? 1 : 0;
+        outside += (differs && i >= ConfigRecord::HEADER_SIZE + 4) ? 1 : 0;
+    }
+    HOST_CHECK(changedBytes > 0);
+    HOST_CHECK_EQ(outside, 0);
+
+    // A schedule entry: the bytes before the schedule do not move
+    changed = config;
+    changed._feedingSchedule[9]._dose = 4;
+    after = Encode(changed, 8);
+    HOST_CHECK_EQ(after.size(), before.size());
+
+    size_t firstDiff = after.size();
+    for (size_t i = ConfigRecord::HEADER_SIZE; i < after.size() && firstDiff == after.size(); ++i)
+    {
+        firstDiff = (after[i] != before[i]) ? i : firstDiff;
+    }
+    HOST_CHECK(firstDiff >= after.size() - 5);
+}
+
+//-----------------------------------------------------------------------------
+void TestCorruption()
+{
+    const MemoryConfigData config = FullConfig();
+    const std::vector<uint8_t> record = Encode(config, 3);
+
+    // Every single bit flip is caught, and the target keeps its values
+    size_t accepted = 0;
+    size_t touched = 0;
+    for (size_t i = 0; i < record.size(); ++i)
+    {
+        for (int bit = 0; bit < 8; ++bit)
+        {
+            std::vector<uint8_t> corrupted = record;
+            corrupted[i] ^= static_cast<uint8_t>(1u << bit);
+
+            MemoryConfigData target;
+            accepted += (ConfigRecord::Decode(corrupted.data(), corrupted.size(), target) != 0) ? 1 : 0;
+            touched += SameConfig(target, MemoryConfigData{}) ? 0 : 1;
+        }
+    }
+    HOST_CHECK_EQ(accepted, 0);
+    HOST_CHECK_EQ(touched, 0);
+
+    // A short read, and erased or blank EEPROM
+    MemoryConfigData target;
+    HOST_CHECK_EQ(ConfigRecord::Decode(record.data(), record.size() - 1, target), 0);
+    HOST_CHECK_EQ(ConfigRecord::Decode(record.data(), ConfigRecord::HEADER_SIZE - 1, target), 0);
+
+    uint16_t sequence = 0;
+    size_t length = 0;
+    for (uint8_t fill : { 0x00, 0xFF })
+    {
+        const std::vector<uint8_t> blank(CAPACITY, fill);
+        HOST_CHECK(!ConfigRecord::ReadHeader(blank.data(), sequence, length));
+        HOST_CHECK_EQ(ConfigRecord::Decode(blank.data(), blank.size(), target), 0);
+    }
+    HOST_CHECK(SameConfig(target, MemoryConfigData{}));
+}
+
+//-----------------------------------------------------------------------------
+void TestLimits()
+{
+    // Too small for the header and the fixed fields, or for the strings
+    std::vector<uint8_t> record(CAPACITY);
+    HOST_CHECK_EQ(ConfigRecord::Encode(MemoryConfigData{}, 0, record.data(), ConfigRecord::HEADER_SIZE), 0);
+    HOST_CHECK_EQ(ConfigRecord::Encode(FullConfig(), 0, record.data(), Encode(FullConfig(), 0).size() - 1), 0);
+
+    // A string over 255 bytes does not fit its TLV
+    MemoryConfigData config;
+    config._wifiSsid = std::string(256, 's');
+    HOST_CHECK_EQ(ConfigRecord::Encode(config, 0, record.data(), record.size()), 0);
+    config._wifiSsid.resize(255);
+    HOST_CHECK(ConfigRecord::Encode(config, 0, record.data(), record.size()) != 0);
+
+    // Sequence order across the wrap
+    HOST_CHECK(ConfigRecord::IsNewer(1, 0));
+    HOST_CHECK(!ConfigRecord::IsNewer(0, 1));
+    HOST_CHECK(!ConfigRecord::IsNewer(5, 5));
+    HOST_CHECK(ConfigRecord::IsNewer(0, 0xFFFF));
+    HOST_CHECK(ConfigRecord::IsNewer(10, 0xFFF0));
+}
+
+//-----------------------------------------------------------------------------
+void TestCompatibility()
+{
+    const MemoryConfigData full = FullConfig();
+    std::vector<uint8_t> record = Encode(full, 1);
+
+    // An older layout without the last fixed field (spikeZ, 4 bytes): it keeps its value
+    uint16_t fixedSize = 0;
+    std::memcpy(&fixedSize, record.data() + FIXED_SIZE_OFFSET, sizeof(fixedSize));
+    const size_t lastFixed = ConfigRecord::HEADER_SIZE + fixedSize - 4;
+    record.erase(record.begin() + static_cast<long>(lastFixed), record.begin() + static_cast<long>(lastFixed + 4));
+    fixedSize -= 4;
+    std::memcpy(record.data() + FIXED_SIZE_OFFSET, &fixedSize, sizeof(fixedSize));
+    Reseal(record);
+
+    MemoryConfigData older;
+    HOST_CHECK_EQ(ConfigRecord::Decode(record.data(), record.size(), older), record.size());
+    HOST_CHECK(older._spikeZScore == MemoryConfigData{}._spikeZScore);
+    older._spikeZScore = full._spikeZScore;
+    HOST_CHECK(SameConfig(older, full));
+
+    // A newer layout with a tag this version does not know: skipped
+    record = Encode(full, 1);
+    record.insert(record.end(), { 0x7E, 3, 'n', 'e', 'w' });
+    Reseal(record);
+
+    MemoryConfigData newer;
+    HOST_CHECK_EQ(ConfigRecord::Decode(record.data(), record.size(), newer), record.size());
+    HOST_CHECK(SameConfig(newer, full));
+
+    // A schedule TLV not made of whole entries is rejected
+    record = Encode(MemoryConfigData{}, 1);
+    record.back() = 4;
+    record.insert(record.end(), { 1, 2, 3, 4 });
+    Reseal(record);
+    HOST_CHECK_EQ(ConfigRecord::Decode(record.data(), record.size(), newer), 0);
+}
+
+} // namespace
+
+//-----------------------------------------------------------------------------
+int main()
+{
+    TestRoundTrip();
+    TestLocalChanges();
+    TestCorruption();
+    TestLimits();
+    TestCompatibility();
+
+    return HostTest::Finish("config_record_test");
+}
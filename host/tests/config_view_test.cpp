@@ -0,0 +1,208 @@
+/*!****************************************************************************
+ * @file    config_view_test.cpp
+ * @brief   Feeding schedule readers on the full firmware: a control cycle of
+ *          FoodFeeder and the other schedule readers must not touch the
+ *          general heap (the schedule is read in place through a ConfigView),
+ *          generations move only on a change, and a schedule longer than the
+ *          list holds is rejected instead of cut short.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#include "tests/host_test.h"
+
+#include "framework/memory/arena.h"
+#include "host/sim/board.h"
+#include "src/core/guardian_proxy.h"
+#include "src/core/smart_aquarium_guardian.h"
+#include "src/managers/comms/cloud_payloads.h"
+#include "src/managers/food_feeder.h"
+#include "src/services/memory/memory_config_data.h"
+#include "src/services/storage_service.h"
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <stdexcept>
+#include <string>
+
+//-----------------------------------------------------------------------------
+// Heap allocations of the test thread while counting is on; the firmware
+// tasks running meanwhile are not counted
+
+static std::atomic<uint64_t> s_allocations{0};
+static thread_local bool t_counting = false;
+
+void* operator new(size_t size)
+{
+    if (t_counting)
+    {
+        s_allocations.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    if (void* block = std::malloc(size != 0 ? size : 1))
+    {
+        return block;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* block) noexcept { std::free(block); }
+void operator delete(void* block, size_t) noexcept { std::free(block); }
+
+namespace {
+
+using Services::FieldId;
+using Services::FeeddingScheduleList;
+using Services::StorageService;
+
+static constexpr int CALLS = 50;
+
+//-----------------------------------------------------------------------------
+template <typename Function>
+uint64_t CountAllocations(const char* name, Function&& function)
+{
+    s_allocations = 0;
+    t_counting = true;
+    for (int i = 0; i < CALLS; ++i)
+    {
+        function();
+    }
+    t_counting = false;
+
+    const uint64_t allocations = s_allocations.load();
+    std::printf("%-40s %llu allocation(s) in %d calls\n", name, static_cast<unsigned long long>(allocations), CALLS);
+    return allocations;
+}
+
+//-----------------------------------------------------------------------------
+void TestCountingSeesAllocations()
+{
+    const uint64_t allocations = CountAllocations("probe: std::string(64)", []()
+        {
+            std::string probe(64, 'x');
+            asm volatile("" : : "r"(probe.data()) : "memory");
+        }
+    );
+    HOST_CHECK_EQ(allocations, CALLS);
+}
+
+//-----------------------------------------------------------------------------
+void TestReadersDoNotAllocate()
+{
+    auto* feeder = Managers::FoodFeeder::GetInstance();
+    auto* proxy = Core::GuardianProxy::GetInstance();
+    auto* storage = StorageService::GetInstance();
+
+    // A feeding every other hour in all ten slots, one of them disabled
+    for (int slot = 0; slot < static_cast<int>(Services::MAX_FEEDING_SCHEDULE_ENTRIES); ++slot)
+    {
+        HOST_CHECK(feeder->AddFeedingScheduleEntry(60 + slot * 120, slot, 1 + slot % 5, slot != 7).success);
+    }
+    HOST_CHECK_EQ(storage->View<FeeddingScheduleList>(FieldId::FEEDING_SCHEDULE)->size(), Services::MAX_FEEDING_SCHEDULE_ENTRIES);
+
+    // First call of each: plans derived from the schedule, one-time buffers
+    feeder->Update();
+    feeder->PublishState();
+
+    static Memory::StaticArena<4096> arena("config_view_test");
+
+    HOST_CHECK_EQ(CountAllocations("FoodFeeder::Update", [feeder]() { feeder->Update(); }), 0);
+    HOST_CHECK_EQ(CountAllocations("FoodFeeder::PublishState", [feeder]() { feeder->PublishState(); }), 0);
+    HOST_CHECK_EQ(CountAllocations("FoodFeeder::GetFeederStatus", [feeder]() { (void)feeder->GetFeederStatus(); }), 0);
+    HOST_CHECK_EQ(CountAllocations("ClientAttributesPayload (request arena)", []()
+        {
+            Memory::ArenaScope scope(arena);
+            Comms::ClientAttributesPayload payload;
+        }
+    ), 0);
+    HOST_CHECK_EQ(CountAllocations("SaveFeedingScheduleInStorage (no change)", [proxy]() { proxy->SaveFeedingScheduleInStorage(60, 0, 1, true); }), 0);
+    HOST_CHECK_EQ(CountAllocations("Get<FeeddingScheduleList>", [storage]() { (void)storage->Get<FeeddingScheduleList>(FieldId::FEEDING_SCHEDULE); }), 0);
+}
+
+//-----------------------------------------------------------------------------
+void TestGenerations()
+{
+    auto* storage = StorageService::GetInstance();
+    auto* proxy = Core::GuardianProxy::GetInstance();
+
+    const uint32_t before = storage->View<FeeddingScheduleList>(FieldId::FEEDING_SCHEDULE).GetGeneration();
+    HOST_CHECK(before != 0);
+
+    // Saving what is stored already changes nothing
+    proxy->SaveFeedingScheduleInStorage(60, 0, 1, true);
+    HOST_CHECK_EQ(storage->View<FeeddingScheduleList>(FieldId::FEEDING_SCHEDULE).GetGeneration(), before);
+
+    // A change moves only the generation of its field
+    const uint32_t other = storage->View<bool>(FieldId::TREND_ENABLED).GetGeneration();
+    proxy->SaveFeedingScheduleInStorage(90, 0, 2, true);
+    const uint32_t after = storage->View<FeeddingScheduleList>(FieldId::FEEDING_SCHEDULE).GetGeneration();
+    HOST_CHECK(after != before && after != 0);
+    HOST_CHECK_EQ(storage->View<bool>(FieldId::TREND_ENABLED).GetGeneration(), other);
+
+    // A type that is not the field's: the empty value, and the field is left alone
+    HOST_CHECK_EQ(storage->Get<int>(FieldId::TREND_ENABLED), 0);
+    HOST_CHECK(!storage->Set<int>(FieldId::TREND_ENABLED, 0));
+    HOST_CHECK_EQ(storage->View<bool>(FieldId::TREND_ENABLED).GetGeneration(), other);
+}
+
+//-----------------------------------------------------------------------------
+std::string ScheduleJson(size_t entries)
+{
+    std::string json = "{\"feedSch\":[";
+    for (size_t i = 0; i < entries; ++i)
+    {
+        json += (i > 0 ? "," : "");
+        json += "{\"_min\":" + std::to_string(i * 60) + ",\"_id\":" + std::to_string(i) + ",\"_dose\":1,\"_enabled\":true}";
+    }
+    return json + "]}";
+}
+
+//-----------------------------------------------------------------------------
+void TestOversizeScheduleRejected()
+{
+    const size_t capacity = Services::MAX_FEEDING_SCHEDULE_ENTRIES;
+
+    Services::MemoryConfigData config;
+    HOST_CHECK(config.FromJson(ScheduleJson(capacity)));
+    HOST_CHECK_EQ(config._feedingSchedule.size(), capacity);
+
+    // The load fails and leaves the schedule as it was
+    config._feedingSchedule.clear();
+    HOST_CHECK(!config.FromJson(ScheduleJson(capacity + 1)));
+    HOST_CHECK(config._feedingSchedule.empty());
+
+    // Converting the array directly is an error, not a truncation
+    const Memory::ArenaJson json = Memory::ParseArenaJson(ScheduleJson(capacity + 1));
+    bool rejected = false;
+    try
+    {
+        (void)json["feedSch"].get<FeeddingScheduleList>();
+    }
+    catch (const nlohmann::json::out_of_range&)
+    {
+        rejected = true;
+    }
+    HOST_CHECK(rejected);
+}
+
+} // namespace
+
+//-----------------------------------------------------------------------------
+int main()
+{
+    static HostSim::Board board(HostSim::Board::Options{});
+    board.Attach();
+
+    SmartAquariumGuardian::GetInstance()->Init();
+
+    TestCountingSeesAllocations();
+    TestReadersDoNotAllocate();
+    TestGenerations();
+    TestOversizeScheduleRejected();
+
+    // Firmware tasks never return; leave without running static destructors under them
+    const int status = HostTest::Finish("config_view_test");
+    std::fflush(stdout);
+    std::_Exit(status);
+}
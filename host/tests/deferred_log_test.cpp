@@ -0,0 +1,272 @@
+/*!****************************************************************************
+ * @file    deferred_log_test.cpp
+ * @brief   DeferredLog records round trip: each argument type written in
+ *          binary comes back rendered exactly like printf would, long
+ *          strings are cut at MAX_STRING_LENGTH, and records written by
+ *          several threads while another drains come out whole, in order
+ *          per writer, none lost but the ones counted as dropped.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#include "tests/host_test.h"
+
+#include "framework/os/deferred_log.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+
+static constexpr const char* TAG = "deferred_log_test";
+static constexpr int WRITERS = 4;
+static constexpr uint32_t RECORDS_PER_WRITER = 5000;
+
+//-----------------------------------------------------------------------------
+// The drain prints to stdout: it goes to a file while the tests read it back.
+// Failed checks print there too, and are passed on to stderr
+
+class StdoutCapture
+{
+    public:
+
+        StdoutCapture()
+        {
+            std::fflush(stdout);
+            _saved = dup(STDOUT_FILENO);
+            _file = std::tmpfile();
+            dup2(fileno(_file), STDOUT_FILENO);
+        }
+
+        ~StdoutCapture()
+        {
+            TakeLines();
+            std::fflush(stdout);
+            dup2(_saved, STDOUT_FILENO);
+            close(_saved);
+            std::fclose(_file);
+        }
+
+        //! Lines printed since the previous call
+        std::vector<std::string> TakeLines()
+        {
+            std::fflush(stdout);
+
+            std::vector<std::string> lines;
+            char line[4096];
+            std::fseek(_file, _readOffset, SEEK_SET);
+            while (std::fgets(line, sizeof(line), _file) != nullptr)
+            {
+                if (std::strstr(line, ": check failed: ") != nullptr)
+                {
+                    std::fputs(line, stderr);
+                    continue;
+                }
+                lines.emplace_back(line, strcspn(line, "\n"));
+            }
+            _readOffset = std::ftell(_file);
+            return lines;
+        }
+
+    private:
+
+        int _saved = -1;
+        FILE* _file = nullptr;
+        long _readOffset = 0;
+};
+
+StdoutCapture* s_capture = nullptr;
+
+//-----------------------------------------------------------------------------
+//! Message of a rendered line: "I (12) tag: [task] message"
+std::string MessageOf(const std::string& line)
+{
+    const size_t start = line.find("] ");
+    return (start == std::string::npos) ? std::string() : line.substr(start + 2);
+}
+
+//-----------------------------------------------------------------------------
+template <typename... Args>
+void CheckRoundTrip(const char* format, Args... args)
+{
+    char expected[512];
+    std::snprintf(expected, sizeof(expected), format, args...);
+
+    // As CORE_INFO does: the first check scans the format for "%.*s"
+    DeferredLog::Site site(TAG, format, ESP_LOG_INFO);
+    HOST_CHECK(DeferredLog::IsEnabled(site));
+    DeferredLog::Write(site, args...);
+    DeferredLog::Flush();
+
+    const auto lines = s_capture->TakeLines();
+    HOST_CHECK_EQ(lines.size(), 1u);
+    if (lines.size() == 1 && MessageOf(lines[0]) != expected)
+    {
+        std::fprintf(stderr, "format '%s': got '%s', expected '%s'\n", format, MessageOf(lines[0]).c_str(), expected);
+        HOST_CHECK(false);
+    }
+}
+
+//-----------------------------------------------------------------------------
+void TestArgumentTypes()
+{
+    static const char UNTERMINATED[4] = { 'a', 'b', 'c', 'd' };
+
+    CheckRoundTrip("no arguments");
+    CheckRoundTrip("int %d %i %+05d", -42, 7, 3);
+    CheckRoundTrip("unsigned %u %x %X %o", 4000000000u, 0xBEEFu, 0xCAFEu, 8u);
+    CheckRoundTrip("64 bit %lld %llu %" PRId64, INT64_MIN, UINT64_MAX, static_cast<int64_t>(-1));
+    CheckRoundTrip("narrow %hhd %hu", 300, 70000);
+    CheckRoundTrip("double %f %.2f %8.3e %g", 3.5, -0.125, 12345.678, 1e-9);
+    CheckRoundTrip("char %c%c", 'o', 'k');
+    CheckRoundTrip("string '%s' '%-6s' '%3s'", "text", "left", "abcdef");
+    CheckRoundTrip("bounded '%.*s' '%.2s'", 3, UNTERMINATED, "xyz");
+    CheckRoundTrip("percent 100%% %s", "done");
+    CheckRoundTrip("width %*d|%-*d|", 6, 12, 4, 5);
+}
+
+//-----------------------------------------------------------------------------
+void TestNullString()
+{
+    DeferredLog::Site site(TAG, "null %s", ESP_LOG_INFO);
+    HOST_CHECK(DeferredLog::IsEnabled(site));
+    DeferredLog::Write(site, static_cast<const char*>(nullptr));
+    DeferredLog::Flush();
+
+    const auto lines = s_capture->TakeLines();
+    HOST_CHECK_EQ(lines.size(), 1u);
+    HOST_CHECK(lines.size() == 1 && MessageOf(lines[0]) == "null (null)");
+}
+
+//-----------------------------------------------------------------------------
+void TestLongStringCut()
+{
+    const std::string text(3 * DeferredLog::MAX_STRING_LENGTH, 'x');
+
+    DeferredLog::Site site(TAG, "%s", ESP_LOG_INFO);
+    HOST_CHECK(DeferredLog::IsEnabled(site));
+    DeferredLog::Write(site, text.c_str());
+    DeferredLog::Flush();
+
+    const auto lines = s_capture->TakeLines();
+    HOST_CHECK_EQ(lines.size(), 1u);
+    HOST_CHECK(lines.size() == 1 && MessageOf(lines[0]) == text.substr(0, DeferredLog::MAX_STRING_LENGTH));
+}
+
+//-----------------------------------------------------------------------------
+void TestConcurrentWriters()
+{
+    static DeferredLog::Site site(TAG, "writer %d seq %u %s", ESP_LOG_INFO);
+    HOST_CHECK(DeferredLog::IsEnabled(site));
+
+    const DeferredLog::Stats before = DeferredLog::GetStats();
+    std::atomic<int> running{WRITERS};
+
+    // Records of every length, so the ring wraps at every offset. The writers
+    // pause now and then so that the drain keeps up with most of them
+    std::vector<std::thread> writers;
+    for (int writer = 0; writer < WRITERS; ++writer)
+    {
+        writers.emplace_back([writer, &running]()
+            {
+                const std::string padding(64, static_cast<char>('a' + writer));
+                for (uint32_t seq = 0; seq < RECORDS_PER_WRITER; ++seq)
+                {
+                    DeferredLog::Write(site, writer, seq, padding.c_str() + seq % padding.size());
+                    if (seq % 8 == 0)
+                    {
+                        std::this_thread::sleep_for(std::chrono::microseconds(100));
+                    }
+                }
+                --running;
+            }
+        );
+    }
+
+    std::thread drain([&running]()
+        {
+            while (running > 0)
+            {
+                DeferredLog::Flush();
+            }
+        }
+    );
+
+    for (auto& thread : writers)
+    {
+        thread.join();
+    }
+    drain.join();
+    DeferredLog::Flush();
+
+    const DeferredLog::Stats after = DeferredLog::GetStats();
+    const uint32_t written = after.written - before.written;
+    const uint32_t dropped = after.dropped - before.dropped;
+    HOST_CHECK_EQ(written + dropped, WRITERS * RECORDS_PER_WRITER);
+
+    int64_t lastSeq[WRITERS];
+    std::fill(lastSeq, lastSeq + WRITERS, -1);
+    uint32_t records = 0;
+    uint32_t malformed = 0;
+
+    for (const std::string& line : s_capture->TakeLines())
+    {
+        // The drain's own "messages dropped" notices
+        if (line.find("deferred_log:") != std::string::npos)
+        {
+            continue;
+        }
+
+        int writer = -1;
+        unsigned seq = 0;
+        char padding[128] = {};
+        if (std::sscanf(MessageOf(line).c_str(), "writer %d seq %u %127s", &writer, &seq, padding) != 3
+         || writer < 0 || writer >= WRITERS
+         || static_cast<int64_t>(seq) <= lastSeq[writer]
+         || std::strlen(padding) != 64 - seq % 64
+         || padding[0] != 'a' + writer)
+        {
+            ++malformed;
+            continue;
+        }
+
+        lastSeq[writer] = seq;
+        ++records;
+    }
+
+    std::fprintf(stderr, "concurrent: %u records written, %u dropped, %u read back\n", written, dropped, records);
+    HOST_CHECK_EQ(malformed, 0);
+    HOST_CHECK_EQ(records, written);
+}
+
+} // namespace
+
+//-----------------------------------------------------------------------------
+int main()
+{
+    // No drain task: the test drains with Flush(). Its records pass whatever
+    // HOST_LOG_LEVEL the other tests run with
+    DeferredLog::SetLevel(TAG, ESP_LOG_INFO);
+
+    {
+        StdoutCapture capture;
+        s_capture = &capture;
+
+        TestArgumentTypes();
+        TestNullString();
+        TestLongStringCut();
+        TestConcurrentWriters();
+
+        s_capture = nullptr;
+    }
+
+    return HostTest::Finish("deferred_log_test");
+}
@@ -0,0 +1,256 @@
+/*!****************************************************************************
+ * @file    dsp_filter_test.cpp
+ * @brief   framework/dsp stages against brute-force references: the sorted
+ *          window, median, MAD and moving average over random samples for
+ *          several window lengths, Hampel spike rejection and step response,
+ *          EMA and Kalman convergence, and a FilterChain equal to its stages
+ *          applied by hand.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#include "tests/host_test.h"
+
+#include "framework/dsp/ema.h"
+#include "framework/dsp/filter_chain.h"
+#include "framework/dsp/hampel_filter.h"
+#include "framework/dsp/kalman_filter.h"
+#include "framework/dsp/median_filter.h"
+#include "framework/dsp/moving_average.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <random>
+#include <vector>
+
+namespace {
+
+static constexpr size_t SAMPLES = 5000;
+static constexpr double EPSILON = 1e-9;
+
+//-----------------------------------------------------------------------------
+double ReferenceMedian(std::vector<double> values)
+{
+    std::sort(values.begin(), values.end());
+    const size_t half = values.size() / 2;
+    return ((values.size() % 2) != 0) ? values[half] : (values[half - 1] + values[half]) / 2;
+}
+
+double ReferenceMad(const std::vector<double>& values, double center)
+{
+    std::vector<double> deviations;
+    for (double value : values)
+    {
+        deviations.push_back(std::fabs(value - center));
+    }
+    return ReferenceMedian(deviations);
+}
+
+//-----------------------------------------------------------------------------
+//! Every window statistic after every sample, against the last N samples sorted by hand
+template <size_t N>
+void TestWindow(std::mt19937& random)
+{
+    // Few distinct values, so runs of equal samples enter and leave the window
+    std::uniform_int_distribution<int> value(-20, 20);
+
+    Dsp::SortedWindow<double, N> window;
+    Dsp::MovingAverage<double, N> average;
+    Dsp::MovingAverage<int32_t, N> integerAverage;
+    std::deque<double> last;
+
+    size_t mismatches = 0;
+    for (size_t i = 0; i < SAMPLES; ++i)
+    {
+        const double sample = value(random) / 4.0;
+        window.Push(sample);
+        const double mean = average.Process(sample);
+        const int32_t integerMean = integerAverage.Process(static_cast<int32_t>(sample * 4));
+
+        last.push_back(sample);
+        if (last.size() > N)
+        {
+            last.pop_front();
+        }
+
+        std::vector<double> sorted(last.begin(), last.end());
+        std::sort(sorted.begin(), sorted.end());
+
+        bool same = (window.GetCount() == sorted.size());
+        for (size_t k = 0; same && k < sorted.size(); ++k)
+        {
+            same = (window[k] == sorted[k]);
+        }
+
+        double sum = 0;
+        int64_t integerSum = 0;
+        for (double entry : last)
+        {
+            sum += entry;
+            integerSum += static_cast<int64_t>(entry * 4);
+        }
+
+        const double median = ReferenceMedian(sorted);
+        same = same && (window.Median() == median)
+                    && (std::fabs(window.MedianAbsoluteDeviation(median) - ReferenceMad(sorted, median)) < EPSILON)
+                    && (std::fabs(mean - sum / last.size()) < EPSILON)
+                    && (integerMean == static_cast<int32_t>(integerSum / static_cast<int64_t>(last.size())));
+
+        mismatches += same ? 0 : 1;
+    }
+
+    if (mismatches != 0)
+    {
+        std::printf("window %zu: %zu mismatches\n", N, mismatches);
+    }
+    HOST_CHECK_EQ(mismatches, 0);
+
+    // Reset starts an empty window
+    window.Reset();
+    average.Reset();
+    window.Push(7.0);
+    HOST_CHECK_EQ(window.GetCount(), 1);
+    HOST_CHECK(window.Median() == 7.0);
+    HOST_CHECK(average.Process(7.0) == 7.0);
+}
+
+//-----------------------------------------------------------------------------
+void TestMedianFilter()
+{
+    Dsp::MedianFilter<float, 5> median;
+    const float input[] = { 1, 9, 2, 8, 3, 7, 4 };
+    const float expected[] = { 1, 5, 2, 5, 3, 7, 4 };
+
+    for (size_t i = 0; i < sizeof(input) / sizeof(input[0]); ++i)
+    {
+        HOST_CHECK(median.Process(input[i]) == expected[i]);
+    }
+}
+
+//-----------------------------------------------------------------------------
+void TestHampelSpikes(std::mt19937& random)
+{
+    static constexpr size_t SPIKE_PERIOD = 17;
+    std::uniform_real_distribution<float> noise(-0.05f, 0.05f);
+
+    Dsp::HampelFilter<float, 5> hampel;
+    size_t spikes = 0;
+    size_t spikesThrough = 0;
+
+    for (size_t i = 0; i < SAMPLES; ++i)
+    {
+        const float clean = 25.0f + noise(random);
+        const bool spike = (i % SPIKE_PERIOD) == SPIKE_PERIOD - 1;
+        const float output = hampel.Process(spike ? clean + 60.0f : clean);
+
+        spikes += spike ? 1 : 0;
+        spikesThrough += (std::fabs(output - 25.0f) > 0.1f) ? 1 : 0;
+    }
+
+    HOST_CHECK_EQ(spikesThrough, 0);
+    HOST_CHECK(hampel.GetRejectedCount() >= spikes);
+}
+
+//-----------------------------------------------------------------------------
+void TestHampelStep()
+{
+    // A real step holds the majority of a 5-sample window from its third sample
+    Dsp::HampelFilter<float, 5> hampel;
+    for (int i = 0; i < 10; ++i)
+    {
+        HOST_CHECK(hampel.Process(10.0f) == 10.0f);
+    }
+
+    HOST_CHECK(hampel.Process(20.0f) == 10.0f);
+    HOST_CHECK(hampel.Process(20.0f) == 10.0f);
+    HOST_CHECK(hampel.Process(20.0f) == 20.0f);
+    HOST_CHECK(hampel.Process(20.0f) == 20.0f);
+}
+
+//-----------------------------------------------------------------------------
+void TestSmoothers(std::mt19937& random)
+{
+    std::normal_distribution<double> noise(0.0, 0.3);
+
+    Dsp::Ema<double> ema(0.1);
+    Dsp::KalmanFilter<double> kalman(1e-4, 0.09);
+    HOST_CHECK(ema.Process(0.0) == 0.0);
+    HOST_CHECK(kalman.Process(0.0) == 0.0);
+
+    // Both settle on the new level with less spread than the raw samples
+    double emaError = 0;
+    double kalmanError = 0;
+    for (size_t i = 0; i < SAMPLES; ++i)
+    {
+        const double measurement = 10.0 + noise(random);
+        const double smoothed = ema.Process(measurement);
+        const double estimate = kalman.Process(measurement);
+
+        if (i >= SAMPLES / 2)
+        {
+            emaError = std::max(emaError, std::fabs(smoothed - 10.0));
+            kalmanError = std::max(kalmanError, std::fabs(estimate - 10.0));
+        }
+    }
+
+    std::printf("smoothers: worst ema error %.3f, kalman %.3f, kalman variance %.5f\n",
+                emaError, kalmanError, kalman.GetErrorVariance());
+    HOST_CHECK(emaError < 0.5);
+    HOST_CHECK(kalmanError < 0.2);
+    HOST_CHECK(kalman.GetErrorVariance() < 0.09 / 10);
+
+    ema.Reset();
+    kalman.Reset();
+    HOST_CHECK(ema.Process(3.0) == 3.0);
+    HOST_CHECK(kalman.Process(3.0) == 3.0);
+}
+
+//-----------------------------------------------------------------------------
+void TestChain(std::mt19937& random)
+{
+    std::uniform_real_distribution<float> value(0.0f, 40.0f);
+
+    // The chain the temperature channels run
+    Dsp::FilterChain<Dsp::HampelFilter<float, 5>, Dsp::MovingAverage<float, 12>> chain;
+    Dsp::HampelFilter<float, 5> hampel;
+    Dsp::MovingAverage<float, 12> average;
+
+    size_t mismatches = 0;
+    for (size_t i = 0; i < SAMPLES; ++i)
+    {
+        const float sample = value(random);
+        mismatches += (chain.Process(sample) == average.Process(hampel.Process(sample))) ? 0 : 1;
+    }
+    HOST_CHECK_EQ(mismatches, 0);
+    HOST_CHECK_EQ(chain.GetStage<0>().GetRejectedCount(), hampel.GetRejectedCount());
+
+    chain.Reset();
+    HOST_CHECK_EQ(chain.GetStage<1>().GetCount(), 0);
+    HOST_CHECK(chain.Process(5.0f) == 5.0f);
+}
+
+} // namespace
+
+//-----------------------------------------------------------------------------
+int main()
+{
+    std::mt19937 random(20261017);
+
+    TestWindow<1>(random);
+    TestWindow<2>(random);
+    TestWindow<5>(random);
+    TestWindow<6>(random);
+    TestWindow<12>(random);
+    TestWindow<31>(random);
+    TestWindow<32>(random);
+
+    TestMedianFilter();
+    TestHampelSpikes(random);
+    TestHampelStep();
+    TestSmoothers(random);
+    TestChain(random);
+
+    return HostTest::Finish("dsp_filter_test");
+}
@@ -0,0 +1,179 @@
+/*!****************************************************************************
+ * @file    eeprom_memory_test.cpp
+ * @brief   EepromMemory on the simulated AT24C32: a write returns once the
+ *          device has its last page and the next access ACK-polls for the
+ *          end of the cycle, a write cycle overlaps the caller's own work,
+ *          writes across pages land where they were addressed, and a device
+ *          that stops answering times the poll out instead of hanging.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#include "tests/host_test.h"
+
+#include "esp_timer.h"
+#include "host/sim/eeprom_sim.h"
+#include "host_bus.h"
+#include "include/config.h"
+#include "src/services/memory/eeprom_memory.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using HostSim::At24c32;
+using Services::EepromMemory;
+
+static constexpr size_t PAGE = EepromMemory::BYTES_PER_PAGE;
+static constexpr int64_t CYCLE_US = static_cast<int64_t>(At24c32::WRITE_CYCLE_US);
+static constexpr int64_t FIXED_DELAY_US = 10000;            //!< What the driver used to sleep after every page
+
+std::vector<uint8_t> Pattern(size_t length, uint8_t seed)
+{
+    std::vector<uint8_t> data(length);
+    for (size_t i = 0; i < length; ++i)
+    {
+        data[i] = static_cast<uint8_t>(seed + i * 7);
+    }
+    return data;
+}
+
+//-----------------------------------------------------------------------------
+void TestAckPolling(EepromMemory* memory, At24c32& eeprom)
+{
+    const std::vector<uint8_t> data = Pattern(PAGE, 0x11);
+
+    // The write returns as soon as the page is on the bus, before its cycle ends
+    int64_t start = esp_timer_get_time();
+    HOST_CHECK(memory->WriteBytes(0x0100, data.data(), data.size()));
+    const int64_t writeUs = esp_timer_get_time() - start;
+
+    // The read right after it polls until the device answers, then gets the new bytes
+    const uint32_t nacksBefore = eeprom.GetBusyNacks();
+    std::vector<uint8_t> read(PAGE);
+    HOST_CHECK(memory->ReadBytes(0x0100, read.data(), read.size()));
+    const int64_t readyUs = esp_timer_get_time() - start;
+
+    HOST_CHECK(read == data);
+    HOST_CHECK(writeUs < CYCLE_US);
+    HOST_CHECK(readyUs >= CYCLE_US);
+    HOST_CHECK(eeprom.GetBusyNacks() > nacksBefore);
+
+    std::printf("eeprom: page write returned after %lld us, readable after %lld us\n",
+                static_cast<long long>(writeUs), static_cast<long long>(readyUs));
+}
+
+//-----------------------------------------------------------------------------
+void TestOverlap(EepromMemory* memory, At24c32& eeprom)
+{
+    const std::vector<uint8_t> data = Pattern(PAGE, 0x22);
+    HOST_CHECK(memory->WriteBytes(0x0200, data.data(), data.size()));
+
+    // Work of the caller longer than the cycle: the next access finds the device ready
+    std::this_thread::sleep_for(std::chrono::microseconds(CYCLE_US + 1000));
+
+    const uint32_t nacksBefore = eeprom.GetBusyNacks();
+    std::vector<uint8_t> read(PAGE);
+    HOST_CHECK(memory->ReadBytes(0x0200, read.data(), read.size()));
+    HOST_CHECK(read == data);
+    HOST_CHECK_EQ(eeprom.GetBusyNacks(), nacksBefore);
+
+    // An explicit wait leaves nothing for the next access to poll
+    HOST_CHECK(memory->WriteBytes(0x0200, data.data(), 1));
+    HOST_CHECK(memory->WaitForWriteCompletion());
+    const uint32_t nacksAfterWait = eeprom.GetBusyNacks();
+    HOST_CHECK(memory->ReadBytes(0x0200, read.data(), 1));
+    HOST_CHECK_EQ(eeprom.GetBusyNacks(), nacksAfterWait);
+    HOST_CHECK(memory->WaitForWriteCompletion());
+}
+
+//-----------------------------------------------------------------------------
+void TestAcrossPages(EepromMemory* memory, At24c32& eeprom)
+{
+    // Unaligned, over six pages: each page written once, nothing wrapped inside a page
+    static constexpr uint16_t ADDRESS = 0x0400 + 30;
+    static constexpr size_t LENGTH = 4 * PAGE + 10;
+
+    const std::vector<uint8_t> before = Pattern(PAGE * 7, 0x33);
+    HOST_CHECK(memory->WriteBytes(0x0400 - PAGE, before.data(), before.size()));
+
+    const std::vector<uint8_t> data = Pattern(LENGTH, 0x44);
+    const uint32_t pagesBefore = eeprom.GetPageWrites();
+    const int64_t start = esp_timer_get_time();
+    HOST_CHECK(memory->WriteBytes(ADDRESS, data.data(), data.size()));
+    const int64_t writeUs = esp_timer_get_time() - start;
+    const size_t pages = (30 + LENGTH + PAGE - 1) / PAGE;
+    HOST_CHECK_EQ(eeprom.GetPageWrites() - pagesBefore, pages);
+
+    // Each page waits for the cycle of the one before, not for a fixed delay
+    HOST_CHECK(writeUs >= static_cast<int64_t>(pages - 1) * CYCLE_US);
+    HOST_CHECK(writeUs < static_cast<int64_t>(pages) * FIXED_DELAY_US);
+
+    std::vector<uint8_t> expected = before;
+    std::copy(data.begin(), data.end(), expected.begin() + PAGE + 30);
+    std::vector<uint8_t> read(expected.size());
+    HOST_CHECK(memory->ReadBytes(0x0400 - PAGE, read.data(), read.size()));
+    HOST_CHECK(read == expected);
+
+    std::printf("eeprom: %zu bytes over %zu pages written in %lld us\n", LENGTH, pages, static_cast<long long>(writeUs));
+}
+
+//-----------------------------------------------------------------------------
+void TestBounds(EepromMemory* memory)
+{
+    uint8_t buffer[4] = {};
+    HOST_CHECK(!memory->WriteBytes(EepromMemory::EEPROM_SIZE_BYTES - 2, buffer, sizeof(buffer)));
+    HOST_CHECK(!memory->ReadBytes(EepromMemory::EEPROM_SIZE_BYTES - 2, buffer, sizeof(buffer)));
+    HOST_CHECK(memory->ReadBytes(EepromMemory::EEPROM_SIZE_BYTES - 4, buffer, sizeof(buffer)));
+}
+
+//-----------------------------------------------------------------------------
+void TestTimeout(EepromMemory* memory, At24c32& eeprom)
+{
+    const std::vector<uint8_t> data = Pattern(PAGE, 0x55);
+    HOST_CHECK(memory->WriteBytes(0x0800, data.data(), data.size()));
+
+    // The device drops off the bus during the cycle: the poll gives up instead of hanging
+    HostBus::AttachI2cDevice(I2C_NUM_0, Config::EEPROM_I2C_ADDRESS, nullptr);
+
+    const int64_t start = esp_timer_get_time();
+    HOST_CHECK(!memory->WaitForWriteCompletion());
+    const int64_t waitedUs = esp_timer_get_time() - start;
+    HOST_CHECK(waitedUs >= static_cast<int64_t>(Config::EEPROM_WRITE_TIMEOUT_MS) * 1000);
+    HOST_CHECK(waitedUs < static_cast<int64_t>(Config::EEPROM_WRITE_TIMEOUT_MS) * 1000 * 5);
+
+    std::vector<uint8_t> read(PAGE);
+    HOST_CHECK(!memory->ReadBytes(0x0800, read.data(), read.size()));
+
+    // Back on the bus: the write it had taken is there
+    HostBus::AttachI2cDevice(I2C_NUM_0, Config::EEPROM_I2C_ADDRESS, &eeprom);
+    HOST_CHECK(memory->WaitForWriteCompletion());
+    HOST_CHECK(memory->ReadBytes(0x0800, read.data(), read.size()));
+    HOST_CHECK(read == data);
+
+    std::printf("eeprom: poll of a silent device gave up after %lld us\n", static_cast<long long>(waitedUs));
+}
+
+} // namespace
+
+//-----------------------------------------------------------------------------
+int main()
+{
+    static At24c32 eeprom;
+    HostBus::AttachI2cDevice(I2C_NUM_0, Config::EEPROM_I2C_ADDRESS, &eeprom);
+
+    EepromMemory* memory = EepromMemory::GetInstance();
+    HOST_CHECK(memory->Init());
+
+    TestAckPolling(memory, eeprom);
+    TestOverlap(memory, eeprom);
+    TestAcrossPages(memory, eeprom);
+    TestBounds(memory);
+    TestTimeout(memory, eeprom);
+
+    return HostTest::Finish("eeprom_memory_test");
+}
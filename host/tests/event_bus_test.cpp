@@ -0,0 +1,176 @@
+/*!****************************************************************************
+ * @file    event_bus_test.cpp
+ * @brief   EventSubscriber inboxes: events of different types come out in
+ *          posting order, a full inbox drops the new event without waking
+ *          the subscriber, and events posted from several tasks at once are
+ *          each delivered exactly once, in order per publisher, with one
+ *          wake per delivered event.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#include "tests/host_test.h"
+
+#include "src/core/event_subscriber.h"
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct Ping
+{
+    int publisher = 0;
+    int sequence = 0;
+};
+
+struct Pong
+{
+    char tag = 0;
+};
+
+static constexpr int PUBLISHERS = 4;
+static constexpr int EVENTS_PER_PUBLISHER = 100000;
+
+//-----------------------------------------------------------------------------
+//! A subscriber as a manager is one: the wakes are counted instead of scheduled
+class Inbox : public Core::EventSubscriber<Inbox, Ping, Pong>
+{
+    public:
+
+        using Subscriber::ProcessEvents;
+
+        const char* GetModuleName() const { return "Inbox"; }
+
+        void RequestUpdate(Scheduler::WakeSource source)
+        {
+            wakes += (source == Scheduler::WAKE_QUEUE) ? 1 : 0;
+        }
+
+        std::atomic<uint64_t> wakes{0};
+        std::string trace;
+        std::vector<int> lastSequence = std::vector<int>(PUBLISHERS, 0);
+        uint64_t pings = 0;
+        uint64_t outOfOrder = 0;
+
+    private:
+
+        friend Subscriber;
+
+        void OnEvent(const Ping& event)
+        {
+            trace += std::to_string(event.sequence);
+            outOfOrder += (event.sequence <= lastSequence[event.publisher]) ? 1 : 0;
+            lastSequence[event.publisher] = event.sequence;
+            ++pings;
+        }
+
+        void OnEvent(const Pong& event)
+        {
+            trace += event.tag;
+        }
+};
+
+//-----------------------------------------------------------------------------
+void TestOrder()
+{
+    Inbox inbox;
+    inbox.Post(Ping{ 0, 1 });
+    inbox.Post(Pong{ 'a' });
+    inbox.Post(Ping{ 0, 2 });
+    inbox.Post(Pong{ 'b' });
+    HOST_CHECK_EQ(inbox.wakes.load(), 4);
+    HOST_CHECK(inbox.trace.empty());
+
+    // Handlers only run when the subscriber drains its inbox, on its own task
+    inbox.ProcessEvents();
+    HOST_CHECK(inbox.trace == "1a2b");
+
+    inbox.ProcessEvents();
+    HOST_CHECK(inbox.trace == "1a2b");
+}
+
+//-----------------------------------------------------------------------------
+void TestOverflow()
+{
+    static constexpr size_t DEPTH = Inbox::EVENT_QUEUE_DEPTH;
+
+    Inbox inbox;
+    for (size_t i = 1; i <= DEPTH + 3; ++i)
+    {
+        inbox.Post(Ping{ 0, static_cast<int>(i) });
+    }
+
+    // The oldest events are kept; the ones that did not fit neither queue nor wake
+    HOST_CHECK_EQ(inbox.wakes.load(), DEPTH);
+    inbox.ProcessEvents();
+    HOST_CHECK_EQ(inbox.pings, DEPTH);
+    HOST_CHECK_EQ(inbox.lastSequence[0], static_cast<int>(DEPTH));
+
+    // Drained: room again
+    inbox.Post(Pong{ 'z' });
+    inbox.ProcessEvents();
+    HOST_CHECK_EQ(inbox.wakes.load(), DEPTH + 1);
+    HOST_CHECK(inbox.trace.back() == 'z');
+}
+
+//-----------------------------------------------------------------------------
+void TestManyPublishers()
+{
+    Inbox inbox;
+    std::atomic<int> running{PUBLISHERS};
+
+    std::vector<std::thread> publishers;
+    for (int p = 0; p < PUBLISHERS; ++p)
+    {
+        publishers.emplace_back([&inbox, &running, p]()
+            {
+                for (int i = 1; i <= EVENTS_PER_PUBLISHER; ++i)
+                {
+                    inbox.Post(Ping{ p, i });
+                    if ((i % 8) == 0)
+                    {
+                        std::this_thread::yield();
+                    }
+                }
+                --running;
+            }
+        );
+    }
+
+    // The subscriber task drains while they publish
+    while (running > 0)
+    {
+        inbox.ProcessEvents();
+        std::this_thread::yield();
+    }
+
+    for (auto& publisher : publishers)
+    {
+        publisher.join();
+    }
+    inbox.ProcessEvents();
+
+    const uint64_t posted = static_cast<uint64_t>(PUBLISHERS) * EVENTS_PER_PUBLISHER;
+    std::printf("event bus: %llu of %llu events delivered from %d publishers, %llu dropped on a full inbox\n",
+                static_cast<unsigned long long>(inbox.pings), static_cast<unsigned long long>(posted), PUBLISHERS,
+                static_cast<unsigned long long>(posted - inbox.pings));
+
+    // Each accepted event woke the subscriber once and came out once, in order for its publisher
+    HOST_CHECK(inbox.pings > 0);
+    HOST_CHECK_EQ(inbox.wakes.load(), inbox.pings);
+    HOST_CHECK_EQ(inbox.outOfOrder, 0);
+}
+
+} // namespace
+
+//-----------------------------------------------------------------------------
+int main()
+{
+    TestOrder();
+    TestOverflow();
+    TestManyPublishers();
+
+    return HostTest::Finish("event_bus_test");
+}
@@ -0,0 +1,389 @@
+/*!****************************************************************************
+ * @file    history_log_test.cpp
+ * @brief   HistoryLog on the emulated spiffs partition, across power cycles.
+ *          Each boot runs in a child process; only the flash file survives
+ *          it. Twelve days of minute samples overflow the partition: the
+ *          oldest days come back as exact hourly records, the newest as
+ *          samples, and a remount reads the same. Then random power cuts,
+ *          mid-page and mid-erase: after every remount each record read back
+ *          was written, in order, and no sample durable before a cut is lost.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#include "tests/host_test.h"
+
+#include "host_bus.h"
+#include "include/config.h"
+#include "src/services/history_log.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <functional>
+#include <limits>
+#include <new>
+#include <random>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+//-----------------------------------------------------------------------------
+// The log stamps records with time(): the test sets the wall clock
+
+static time_t s_now = 0;
+
+extern "C" time_t time(time_t* out)
+{
+    if (out != nullptr)
+    {
+        *out = s_now;
+    }
+    return s_now;
+}
+
+namespace {
+
+using Services::HistoryLog;
+using Services::ReadingHistory;
+using Record = HistoryLog::Record;
+using RecordType = HistoryLog::RecordType;
+
+static constexpr uint32_t START = 1767225600;               //!< 2026-01-01 00:00:00
+static constexpr uint32_t MINUTE_S = Config::HISTORY_LOG_SAMPLE_PERIOD_S;
+static constexpr uint32_t HOUR_S = 3600;
+static constexpr uint32_t MINUTES_PER_HOUR = HOUR_S / MINUTE_S;
+static constexpr uint32_t FILL_MINUTES = 12 * 24 * MINUTES_PER_HOUR;
+static constexpr uint32_t SAMPLES_PER_PAGE = 24;            //!< (256-byte page - 16-byte header) / (4 + 6 bytes a sample)
+static constexpr uint32_t PAGE_TIMEOUT_MS = 5000;
+
+static constexpr int CUT_CYCLES = 100;
+static constexpr uint32_t DURABLE_MINUTES = 30;             //!< Written and on flash before the cut is armed
+static constexpr uint32_t MAX_CUT_MINUTES = 90;             //!< Written while the cut can strike
+static constexpr size_t PAGE_BYTES = 256;
+
+char s_flashPath[] = "/tmp/history_log_test_XXXXXX";
+
+//! What a boot leaves for the next one to compare against, in memory shared with the test process
+struct Summary
+{
+    uint32_t samples;
+    uint32_t hourly;
+    uint32_t firstSample;
+    uint32_t lastHourly;
+    uint32_t cuts;                                          //!< Power cuts that struck before the boot ended
+};
+
+Summary* s_summary = nullptr;
+
+//-----------------------------------------------------------------------------
+uint32_t TimestampOf(uint32_t minute)
+{
+    return START + minute * MINUTE_S;
+}
+
+//! Different in every series and over every hour, so a misplaced record shows
+ReadingHistory::Values ValuesAt(uint32_t minute)
+{
+    return { static_cast<int32_t>(2000 + minute % 97),
+             static_cast<int32_t>(150 + (minute / MINUTES_PER_HOUR) % 50),
+             static_cast<int32_t>(3900 - minute % 13) };
+}
+
+bool IsSample(const Record& record, uint32_t minute)
+{
+    const ReadingHistory::Values values = ValuesAt(minute);
+    bool same = (record.timestamp == TimestampOf(minute)) && (record.count == 1);
+    for (size_t s = 0; s < HistoryLog::SERIES_COUNT; ++s)
+    {
+        same = same && (record.series[s].min == values[s]) && (record.series[s].max == values[s]) && (record.series[s].avg == values[s]);
+    }
+    return same;
+}
+
+//-----------------------------------------------------------------------------
+//! One boot of the board: 'boot' runs in a child process that mounts the flash file
+bool PowerCycle(const std::function<void()>& boot)
+{
+    std::fflush(stdout);
+
+    const pid_t pid = fork();
+    if (pid == 0)
+    {
+        HostBus::SetFlashFile(s_flashPath);
+        HOST_CHECK(HistoryLog::GetInstance()->Init());
+        boot();
+
+        // Power off: the writer task goes with the process
+        std::fflush(stdout);
+        std::_Exit(HostTest::Failures() == 0 ? 0 : 1);
+    }
+
+    int status = 0;
+    return (pid > 0) && (waitpid(pid, &status, 0) == pid) && WIFEXITED(status) && (WEXITSTATUS(status) == 0);
+}
+
+//-----------------------------------------------------------------------------
+//! Hands the page over and waits until the task has programmed it and its index entry
+bool FlushAndWait()
+{
+    HistoryLog* log = HistoryLog::GetInstance();
+    const uint32_t before = log->GetStats().pagesWritten;
+    log->Flush();
+
+    for (uint32_t ms = 0; ms < PAGE_TIMEOUT_MS; ++ms)
+    {
+        if (log->GetStats().pagesWritten > before)
+        {
+            return true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return false;
+}
+
+//-----------------------------------------------------------------------------
+//! One sample a minute, a page at a time; 'wait' keeps every page until it is on flash
+void RecordMinutes(uint32_t from, uint32_t to, bool wait)
+{
+    for (uint32_t minute = from; minute < to; ++minute)
+    {
+        s_now = TimestampOf(minute);
+        HistoryLog::GetInstance()->RecordSample(ValuesAt(minute));
+
+        if ((minute - from + 1) % SAMPLES_PER_PAGE == 0 || minute + 1 == to)
+        {
+            if (wait)
+            {
+                HOST_CHECK(FlushAndWait());
+            }
+            else
+            {
+                HistoryLog::GetInstance()->Flush();
+                std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            }
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+std::vector<Record> ReadAll(RecordType type)
+{
+    std::vector<Record> records;
+    HistoryLog::GetInstance()->ForEach(type, 0, std::numeric_limits<uint32_t>::max(),
+                                       [&records](const Record& record) { records.push_back(record); });
+    return records;
+}
+
+//-----------------------------------------------------------------------------
+//! The hourly record of a whole hour, from the samples written in it
+bool IsWholeHour(const Record& record, uint32_t hour)
+{
+    bool same = (record.timestamp == START + hour * HOUR_S) && (record.count == MINUTES_PER_HOUR);
+
+    for (size_t s = 0; s < HistoryLog::SERIES_COUNT; ++s)
+    {
+        int32_t min = std::numeric_limits<int32_t>::max();
+        int32_t max = std::numeric_limits<int32_t>::min();
+        int64_t sum = 0;
+        for (uint32_t minute = hour * MINUTES_PER_HOUR; minute < (hour + 1) * MINUTES_PER_HOUR; ++minute)
+        {
+            const int32_t value = ValuesAt(minute)[s];
+            min = std::min(min, value);
+            max = std::max(max, value);
+            sum += value;
+        }
+        same = same && (record.series[s].min == min) && (record.series[s].max == max)
+                    && (record.series[s].avg == static_cast<int32_t>(sum / MINUTES_PER_HOUR));
+    }
+    return same;
+}
+
+//-----------------------------------------------------------------------------
+//! Every minute written up to 'minutes', once folded into hours, the newest as samples
+void CheckComplete(uint32_t minutes)
+{
+    const std::vector<Record> hourly = ReadAll(RecordType::HOURLY);
+    const std::vector<Record> samples = ReadAll(RecordType::SAMPLE);
+    HOST_CHECK(!hourly.empty());
+    HOST_CHECK(!samples.empty());
+    if (hourly.empty() || samples.empty())
+    {
+        return;
+    }
+
+    size_t badHours = 0;
+    for (size_t h = 0; h < hourly.size(); ++h)
+    {
+        badHours += IsWholeHour(hourly[h], static_cast<uint32_t>(h)) ? 0 : 1;
+    }
+    HOST_CHECK_EQ(badHours, 0);
+
+    const uint32_t firstMinute = (samples.front().timestamp - START) / MINUTE_S;
+    size_t badSamples = 0;
+    for (size_t i = 0; i < samples.size(); ++i)
+    {
+        badSamples += IsSample(samples[i], firstMinute + static_cast<uint32_t>(i)) ? 0 : 1;
+    }
+    HOST_CHECK_EQ(badSamples, 0);
+    HOST_CHECK_EQ(firstMinute + samples.size(), minutes);
+
+    // No hole between the hours and the samples
+    HOST_CHECK(samples.front().timestamp <= hourly.back().timestamp + HOUR_S);
+
+    std::printf("history_log: %u minutes kept as %zu hourly records and %zu samples\n",
+                minutes, hourly.size(), samples.size());
+
+    if (s_summary->samples == 0)
+    {
+        *s_summary = { static_cast<uint32_t>(samples.size()), static_cast<uint32_t>(hourly.size()),
+                       samples.front().timestamp, hourly.back().timestamp };
+    }
+    else
+    {
+        HOST_CHECK_EQ(samples.size(), s_summary->samples);
+        HOST_CHECK_EQ(hourly.size(), s_summary->hourly);
+        HOST_CHECK_EQ(samples.front().timestamp, s_summary->firstSample);
+        HOST_CHECK_EQ(hourly.back().timestamp, s_summary->lastHourly);
+    }
+}
+
+//-----------------------------------------------------------------------------
+void TestFillAndRemount()
+{
+    HOST_CHECK(PowerCycle([]()
+        {
+            RecordMinutes(0, FILL_MINUTES, true);
+
+            const HistoryLog::Stats stats = HistoryLog::GetInstance()->GetStats();
+            std::printf("history_log: %u pages, %u erases, %u compactions, %u dropped\n",
+                        stats.pagesWritten, stats.segmentsErased, stats.compactions, stats.droppedRecords);
+            HOST_CHECK(stats.compactions > 0);
+            HOST_CHECK_EQ(stats.droppedRecords, 0);
+
+            CheckComplete(FILL_MINUTES);
+        }
+    ));
+
+    // The same content after a reboot
+    HOST_CHECK(PowerCycle([]() { CheckComplete(FILL_MINUTES); }));
+}
+
+//-----------------------------------------------------------------------------
+//! After a cut: only written records, in order, and every durable minute kept as a sample or in its hour
+void CheckAfterCut(uint32_t written, const std::vector<uint32_t>& durable)
+{
+    const std::vector<Record> hourly = ReadAll(RecordType::HOURLY);
+    const std::vector<Record> samples = ReadAll(RecordType::SAMPLE);
+
+    size_t bad = 0;
+    for (size_t i = 0; i < samples.size(); ++i)
+    {
+        const uint32_t minute = (samples[i].timestamp - START) / MINUTE_S;
+        bad += (minute < written && IsSample(samples[i], minute)
+             && (i == 0 || samples[i - 1].timestamp < samples[i].timestamp)) ? 0 : 1;
+    }
+
+    for (size_t i = 0; i < hourly.size(); ++i)
+    {
+        const Record& record = hourly[i];
+        bool good = ((record.timestamp - START) % HOUR_S == 0) && (record.count >= 1) && (record.count <= MINUTES_PER_HOUR)
+                 && (i == 0 || hourly[i - 1].timestamp < record.timestamp);
+        for (size_t s = 0; s < HistoryLog::SERIES_COUNT; ++s)
+        {
+            good = good && (record.series[s].min <= record.series[s].avg) && (record.series[s].avg <= record.series[s].max);
+        }
+        bad += good ? 0 : 1;
+    }
+    HOST_CHECK_EQ(bad, 0);
+
+    size_t lost = 0;
+    for (uint32_t minute : durable)
+    {
+        const uint32_t timestamp = TimestampOf(minute);
+        const auto sample = std::lower_bound(samples.begin(), samples.end(), timestamp,
+                                             [](const Record& record, uint32_t value) { return record.timestamp < value; });
+        const bool asSample = (sample != samples.end()) && (sample->timestamp == timestamp);
+        const bool inHour = std::any_of(hourly.begin(), hourly.end(),
+                                        [&](const Record& record) { return record.timestamp == timestamp - (timestamp - START) % HOUR_S; });
+        lost += (asSample || inHour) ? 0 : 1;
+    }
+    HOST_CHECK_EQ(lost, 0);
+}
+
+//-----------------------------------------------------------------------------
+void TestPowerCuts()
+{
+    std::mt19937 random(20261017);
+    std::uniform_int_distribution<uint32_t> cutMinutes(1, MAX_CUT_MINUTES);
+
+    uint32_t written = 0;
+    std::vector<uint32_t> durable;
+    int failedBoots = 0;
+
+    for (int cycle = 0; cycle < CUT_CYCLES; ++cycle)
+    {
+        const uint32_t minutes = cutMinutes(random);
+
+        // Somewhere inside the pages those minutes fill
+        const size_t pages = (minutes + SAMPLES_PER_PAGE - 1) / SAMPLES_PER_PAGE;
+        const size_t budget = std::uniform_int_distribution<size_t>(0, pages * PAGE_BYTES - 1)(random);
+
+        const bool ok = PowerCycle([&]()
+            {
+                CheckAfterCut(written, durable);
+
+                RecordMinutes(written, written + DURABLE_MINUTES, true);
+
+                const uint32_t programmed = HostBus::GetFlashStats().bytesProgrammed;
+                HostBus::SetFlashPowerCut(budget);
+                RecordMinutes(written + DURABLE_MINUTES, written + DURABLE_MINUTES + minutes, false);
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+                s_summary->cuts += (HostBus::GetFlashStats().bytesProgrammed - programmed >= budget) ? 1 : 0;
+            }
+        );
+        failedBoots += ok ? 0 : 1;
+
+        for (uint32_t minute = written; minute < written + DURABLE_MINUTES; ++minute)
+        {
+            durable.push_back(minute);
+        }
+        written += DURABLE_MINUTES + minutes;
+    }
+
+    // The last cut, checked by one more boot
+    failedBoots += PowerCycle([&]() { CheckAfterCut(written, durable); }) ? 0 : 1;
+
+    std::printf("history_log: %u of %d power cuts struck over %u minutes, %zu durable samples checked\n",
+                s_summary->cuts, CUT_CYCLES, written, durable.size());
+    HOST_CHECK_EQ(failedBoots, 0);
+    HOST_CHECK(s_summary->cuts > CUT_CYCLES / 2);
+}
+
+} // namespace
+
+//-----------------------------------------------------------------------------
+int main()
+{
+    const int fd = mkstemp(s_flashPath);
+    HOST_CHECK(fd >= 0);
+    close(fd);
+
+    void* shared = mmap(nullptr, sizeof(Summary), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    HOST_CHECK(shared != MAP_FAILED);
+    s_summary = new (shared) Summary{};
+
+    TestFillAndRemount();
+
+    // Blank flash for the power cuts
+    HOST_CHECK(truncate(s_flashPath, 0) == 0);
+    TestPowerCuts();
+
+    unlink(s_flashPath);
+    return HostTest::Finish("history_log_test");
+}
@@ -0,0 +1,232 @@
+/*!****************************************************************************
+ * @file    history_query_test.cpp
+ * @brief   HistoryQuery over ReadingHistory and HistoryLog: readings recorded
+ *          on a simulated wall clock come back from a range query at several
+ *          resolutions, from the raw records and the minute and hour tiers,
+ *          in chunks, without the flash log hiding what RAM holds.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#include "tests/host_test.h"
+
+#include "include/config.h"
+#include "src/services/history_log.h"
+#include "src/services/history_query.h"
+#include "src/services/reading_history.h"
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <vector>
+
+//-----------------------------------------------------------------------------
+// The history stamps records with time(): the test sets the wall clock
+
+static time_t s_now = 0;
+
+extern "C" time_t time(time_t* out)
+{
+    if (out != nullptr)
+    {
+        *out = s_now;
+    }
+    return s_now;
+}
+
+namespace {
+
+using Services::HistoryLog;
+using Services::HistoryQuery;
+using Services::ReadingHistory;
+
+static constexpr uint32_t START = 1767225600;       // 2026-01-01 00:00:00
+static constexpr uint32_t PERIOD_S = 2;             // WATER_MONITOR_PERIOD_MS
+static constexpr uint32_t DURATION_S = 3 * 3600;
+static constexpr uint32_t FIRST_MINUTE_S = 40;      // Recorded before the first query
+
+//-----------------------------------------------------------------------------
+// 20.00 degC at START, +0.01 degC a minute; TDS a step every hour
+float TemperatureAt(uint32_t timestamp)
+{
+    return 20.0f + static_cast<float>((timestamp - START) / 60) * 0.01f;
+}
+
+int TdsAt(uint32_t timestamp)
+{
+    return 150 + static_cast<int>((timestamp - START) / 3600) * 10;
+}
+
+//-----------------------------------------------------------------------------
+// As the water monitor does: every reading to RAM, one a minute to flash
+void RecordReadings(uint32_t from, uint32_t to)
+{
+    for (uint32_t t = from; t < to; t += PERIOD_S)
+    {
+        s_now = t;
+        const ReadingHistory::Values values = ReadingHistory::ToValues(TemperatureAt(t), TdsAt(t), 4.0f);
+        ReadingHistory::GetInstance()->Record(values);
+        HistoryLog::GetInstance()->RecordSample(values);
+    }
+    s_now = to;
+}
+
+//-----------------------------------------------------------------------------
+std::vector<HistoryQuery::Point> RunQuery(HistoryQuery& query, size_t chunk)
+{
+    std::vector<HistoryQuery::Point> points;
+    std::vector<HistoryQuery::Point> buffer(chunk);
+
+    size_t count = 0;
+    while ((count = query.Next(buffer.data(), chunk)) > 0)
+    {
+        HOST_CHECK(count <= chunk);
+        points.insert(points.end(), buffer.begin(), buffer.begin() + count);
+    }
+    HOST_CHECK(query.IsDone());
+    return points;
+}
+
+//-----------------------------------------------------------------------------
+// Windows oldest first, without overlap, on the resolution grid
+void CheckOrdered(const std::vector<HistoryQuery::Point>& points, uint32_t from, uint32_t to, uint32_t resolution)
+{
+    for (size_t i = 0; i < points.size(); ++i)
+    {
+        HOST_CHECK(points[i].start % resolution == 0);
+        HOST_CHECK(points[i].start + resolution > from);
+        HOST_CHECK(points[i].start <= to);
+        HOST_CHECK(points[i].count > 0);
+        HOST_CHECK(points[i].min <= points[i].avg && points[i].avg <= points[i].max);
+        if (i > 0)
+        {
+            HOST_CHECK(points[i].start > points[i - 1].start);
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+void TestFirstMinute()
+{
+    // One flash sample and 20 raw readings so far: the minute point has them all
+    const uint32_t from = START;
+    const uint32_t to = START + FIRST_MINUTE_S - 1;
+    HistoryQuery query(HistoryQuery::Series::TEMPERATURE, from, to, 60);
+
+    HOST_CHECK_EQ(query.GetPieceCount(), 1u);
+    HOST_CHECK(query.GetPieceCount() > 0 && query.GetPiece(0).source == HistoryQuery::Source::RAW);
+
+    const auto points = RunQuery(query, 8);
+    HOST_CHECK_EQ(points.size(), 1u);
+    HOST_CHECK(points.size() == 1 && points[0].start == START);
+    HOST_CHECK(points.size() == 1 && points[0].count == FIRST_MINUTE_S / PERIOD_S);
+
+    // Raw resolution, past the newest flash sample: every reading
+    HistoryQuery raw(HistoryQuery::Series::TEMPERATURE, from, to, 1);
+    HOST_CHECK_EQ(RunQuery(raw, 8).size(), FIRST_MINUTE_S / PERIOD_S);
+}
+
+//-----------------------------------------------------------------------------
+void TestRecentAtFullResolution()
+{
+    // The last 10 minutes, one point per reading: raw records
+    const uint32_t to = START + DURATION_S - 1;
+    const uint32_t from = to - 600 + 1;
+    HistoryQuery query(HistoryQuery::Series::TEMPERATURE, from, to, 1);
+
+    HOST_CHECK(query.GetPieceCount() > 0);
+    HOST_CHECK(query.GetPieceCount() > 0 && query.GetPiece(0).source == HistoryQuery::Source::RAW);
+
+    const auto points = RunQuery(query, 32);
+    HOST_CHECK_EQ(points.size(), 600 / PERIOD_S);
+    CheckOrdered(points, from, to, 1);
+
+    for (const auto& point : points)
+    {
+        HOST_CHECK_EQ(point.count, 1u);
+        HOST_CHECK(std::fabs(point.avg - TemperatureAt(point.start)) < 0.001f);
+    }
+}
+
+//-----------------------------------------------------------------------------
+void TestMinutePoints()
+{
+    // The last hour at a minute: the minute tier, one point per minute
+    const uint32_t to = START + DURATION_S - 1;
+    const uint32_t from = to - 3600 + 1;
+    HistoryQuery query(HistoryQuery::Series::TEMPERATURE, from, to, 60);
+
+    HOST_CHECK(query.GetPieceCount() > 0);
+
+    const auto points = RunQuery(query, 32);
+    HOST_CHECK(points.size() >= 59 && points.size() <= 60);
+    CheckOrdered(points, from, to, 60);
+
+    for (const auto& point : points)
+    {
+        HOST_CHECK_EQ(point.count, 60 / PERIOD_S);
+        HOST_CHECK(std::fabs(point.avg - TemperatureAt(point.start)) < 0.001f);
+    }
+}
+
+//-----------------------------------------------------------------------------
+void TestHourPoints()
+{
+    // The whole history at an hour: the three hours, TDS steps included
+    const uint32_t from = START;
+    const uint32_t to = START + DURATION_S - 1;
+    HistoryQuery query(HistoryQuery::Series::TDS, from, to, 3600);
+
+    HOST_CHECK(query.GetPieceCount() > 0);
+
+    const auto points = RunQuery(query, 2);
+    HOST_CHECK_EQ(points.size(), 3u);
+    CheckOrdered(points, from, to, 3600);
+
+    uint32_t readings = 0;
+    for (const auto& point : points)
+    {
+        HOST_CHECK_EQ(point.min, static_cast<float>(TdsAt(point.start)));
+        HOST_CHECK_EQ(point.max, static_cast<float>(TdsAt(point.start)));
+        readings += point.count;
+    }
+    HOST_CHECK_EQ(readings, DURATION_S / PERIOD_S);
+}
+
+//-----------------------------------------------------------------------------
+void TestEmptyRanges()
+{
+    // Before the history, and in the future
+    HistoryQuery before(HistoryQuery::Series::TEMPERATURE, START - 7200, START - 1, 60);
+    HOST_CHECK(RunQuery(before, 8).empty());
+
+    HistoryQuery after(HistoryQuery::Series::TEMPERATURE, START + DURATION_S + 60, START + DURATION_S + 3600, 60);
+    HOST_CHECK(RunQuery(after, 8).empty());
+
+    // Timestamps before the clock could have been set are ignored
+    HistoryQuery unset(HistoryQuery::Series::TEMPERATURE, 0, Config::HISTORY_MIN_VALID_TIMESTAMP - 1, 60);
+    HOST_CHECK(RunQuery(unset, 8).empty());
+}
+
+} // namespace
+
+//-----------------------------------------------------------------------------
+int main()
+{
+    HOST_CHECK(ReadingHistory::GetInstance()->Init());
+    HOST_CHECK(HistoryLog::GetInstance()->Init());
+
+    RecordReadings(START, START + FIRST_MINUTE_S);
+    TestFirstMinute();
+
+    RecordReadings(START + FIRST_MINUTE_S, START + DURATION_S);
+    TestRecentAtFullResolution();
+    TestMinutePoints();
+    TestHourPoints();
+    TestEmptyRanges();
+
+    // The log's writer task never returns; leave without running static destructors under it
+    const int status = HostTest::Finish("history_query_test");
+    std::fflush(stdout);
+    std::_Exit(status);
+}
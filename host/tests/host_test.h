@@ -0,0 +1,59 @@
+/*!****************************************************************************
+ * @file    host_test.h
+ * @brief   Minimal checks for the host tests (host/tests/NAME_test.cpp): each
+ *          test is its own executable, registered with ctest, that returns
+ *          non-zero when a check failed.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstdio>
+
+namespace HostTest {
+
+inline int& Failures()
+{
+    static int failures = 0;
+    return failures;
+}
+
+//! Result of main(): prints the verdict
+inline int Finish(const char* name)
+{
+    if (Failures() == 0)
+    {
+        std::printf("%s: passed\n", name);
+        return 0;
+    }
+
+    std::printf("%s: %d check(s) failed\n", name, Failures());
+    return 1;
+}
+
+} // namespace HostTest
+
+#define HOST_CHECK(condition)                                                               \
+    do                                                                                      \
+    {                                                                                       \
+        if (!(condition))                                                                   \
+        {                                                                                   \
+            std::printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition);      \
+            ++HostTest::Failures();                                                         \
+        }                                                                                   \
+    } while (0)
+
+#define HOST_CHECK_EQ(actual, expected)                                                     \
+    do                                                                                      \
+    {                                                                                       \
+        const auto hostActual = (actual);                                                   \
+        const auto hostExpected = (expected);                                               \
+        if (!(hostActual == hostExpected))                                                  \
+        {                                                                                   \
+            std::printf("%s:%d: check failed: %s == %s (%lld vs %lld)\n", __FILE__, __LINE__, \
+                        #actual, #expected, static_cast<long long>(hostActual),             \
+                        static_cast<long long>(hostExpected));                              \
+            ++HostTest::Failures();                                                         \
+        }                                                                                   \
+    } while (0)
@@ -0,0 +1,257 @@
+/*!****************************************************************************
+ * @file    one_wire_search_test.cpp
+ * @brief   ROM search on a simulated bus of 1 to 16 DS18B20: every device is
+ *          found once, in search order, and an alarm search returns only the
+ *          probes past their TH/TL. TemperatureSensor then numbers three
+ *          probes as channels and converts them with one broadcast per cycle.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#include "tests/host_test.h"
+
+#include "framework/drivers/one_wire.h"
+#include "host/sim/one_wire_sim.h"
+#include "host_bus.h"
+#include "host_time.h"
+#include "include/config.h"
+#include "src/drivers/temperature_sensor.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+namespace {
+
+static constexpr PinName BUS_PIN = PinName::P26;
+static constexpr uint64_t SERIAL = 0x0000A1B2C3D4ULL;
+static constexpr uint64_t SERIAL_STEP = 0x010203040506ULL;     //!< As the host board, spread over the search tree
+static constexpr size_t MAX_DEVICES = Drivers::TemperatureSensor::MAX_CHANNELS;
+static constexpr uint8_t CMD_CONVERT_T = 0x44;
+static constexpr uint8_t CMD_READ_SCRATCH = 0xBE;
+static constexpr uint8_t CMD_WRITE_SCRATCH = 0x4E;
+static constexpr uint8_t CONFIG_9_BITS = 0x1F;
+
+//-----------------------------------------------------------------------------
+//! Probes on a bus of their own, attached to BUS_PIN while the object lives
+class TestBus
+{
+    public:
+
+        explicit TestBus(size_t count)
+        {
+            for (size_t i = 0; i < count; ++i)
+            {
+                _probes.push_back(std::make_unique<HostSim::Ds18b20>(SERIAL + i * SERIAL_STEP));
+                _wire.AddDevice(_probes.back().get());
+            }
+            HostBus::AttachGpioDevice(static_cast<gpio_num_t>(BUS_PIN), &_wire);
+        }
+
+        ~TestBus() { HostBus::AttachGpioDevice(static_cast<gpio_num_t>(BUS_PIN), nullptr); }
+
+        HostSim::Ds18b20& Probe(size_t index) { return *_probes[index]; }
+        size_t Count() const { return _probes.size(); }
+
+    private:
+
+        HostSim::OneWireBus _wire;
+        std::vector<std::unique_ptr<HostSim::Ds18b20>> _probes;
+};
+
+//-----------------------------------------------------------------------------
+//! Search order: the ROM bits compared from bit 0 up, the 0 branch first
+uint64_t SearchKey(const OneWire::Rom& rom)
+{
+    uint64_t key = 0;
+    for (int bit = 0; bit < 64; ++bit)
+    {
+        key = (key << 1) | ((rom[bit / 8] >> (bit % 8)) & 0x01);
+    }
+    return key;
+}
+
+//-----------------------------------------------------------------------------
+std::vector<OneWire::Rom> SearchAll(OneWire& bus, OneWire::SearchMode mode)
+{
+    std::vector<OneWire::Rom> found;
+    bus.ResetSearch();
+
+    OneWire::Rom rom;
+    while (found.size() <= MAX_DEVICES && bus.Search(rom, mode))
+    {
+        found.push_back(rom);
+    }
+    return found;
+}
+
+//-----------------------------------------------------------------------------
+void TestSearch(OneWire& bus, size_t count)
+{
+    TestBus probes(count);
+
+    const std::vector<OneWire::Rom> found = SearchAll(bus, OneWire::SearchMode::ALL);
+    HOST_CHECK_EQ(found.size(), count);
+
+    for (size_t i = 0; i < found.size(); ++i)
+    {
+        HOST_CHECK_EQ(OneWire::Crc8(found[i].data(), 7), found[i][7]);
+        HOST_CHECK(i == 0 || SearchKey(found[i - 1]) < SearchKey(found[i]));
+    }
+
+    for (size_t i = 0; i < probes.Count(); ++i)
+    {
+        HOST_CHECK(std::find(found.begin(), found.end(), probes.Probe(i).GetRom()) != found.end());
+    }
+
+    // The enumeration is over until it is restarted
+    OneWire::Rom rom;
+    HOST_CHECK(!bus.Search(rom));
+    bus.ResetSearch();
+    HOST_CHECK(bus.Search(rom) && rom == found.front());
+}
+
+//-----------------------------------------------------------------------------
+void TestAlarmSearch(OneWire& bus)
+{
+    static constexpr size_t COUNT = 6;
+    static constexpr float TEMPERATURES[COUNT] = { 25.0f, 35.0f, 20.0f, 5.0f, 29.5f, 30.0f };
+
+    TestBus probes(COUNT);
+
+    // TH 30, TL 10 on every probe; converted together
+    for (size_t i = 0; i < COUNT; ++i)
+    {
+        probes.Probe(i).SetTemperature(TEMPERATURES[i]);
+
+        HOST_CHECK(bus.Select(probes.Probe(i).GetRom()));
+        bus.WriteByte(CMD_WRITE_SCRATCH);
+        bus.WriteByte(30);
+        bus.WriteByte(10);
+        bus.WriteByte(CONFIG_9_BITS);
+    }
+
+    HOST_CHECK(bus.SkipRom());
+    bus.WriteByte(CMD_CONVERT_T);
+    HostTime::Advance(100000);
+    while (bus.ReadBit() == 0)
+    {
+    }
+
+    // Reading the conversion latches it, as a read slot after it would
+    uint8_t scratchpad[9];
+    for (size_t i = 0; i < COUNT; ++i)
+    {
+        HOST_CHECK(bus.Select(probes.Probe(i).GetRom()));
+        bus.WriteByte(CMD_READ_SCRATCH);
+        for (uint8_t& value : scratchpad)
+        {
+            value = bus.ReadByte();
+        }
+    }
+
+    const std::vector<OneWire::Rom> alarmed = SearchAll(bus, OneWire::SearchMode::ALARM);
+    HOST_CHECK_EQ(alarmed.size(), 3);
+    for (size_t i = 0; i < COUNT; ++i)
+    {
+        const bool expected = (TEMPERATURES[i] >= 30.0f) || (TEMPERATURES[i] <= 10.0f);
+        const bool inAlarm = std::find(alarmed.begin(), alarmed.end(), probes.Probe(i).GetRom()) != alarmed.end();
+        HOST_CHECK_EQ(inAlarm, expected);
+    }
+}
+
+//-----------------------------------------------------------------------------
+void TestEmptyBus(OneWire& bus)
+{
+    HostBus::SetInputLevel(static_cast<gpio_num_t>(BUS_PIN), 1);
+
+    OneWire::Rom rom;
+    bus.ResetSearch();
+    HOST_CHECK(!bus.Search(rom));
+}
+
+//-----------------------------------------------------------------------------
+void TestSensorChannels()
+{
+    static constexpr size_t COUNT = 3;
+    static constexpr int CYCLES = 4;
+
+    std::vector<std::unique_ptr<HostSim::Ds18b20>> probes;
+    HostSim::OneWireBus wire;
+    for (size_t i = 0; i < COUNT; ++i)
+    {
+        probes.push_back(std::make_unique<HostSim::Ds18b20>(SERIAL + i * SERIAL_STEP));
+        probes.back()->SetTemperature(24.0f + static_cast<float>(i));
+        wire.AddDevice(probes.back().get());
+    }
+    HostBus::AttachGpioDevice(static_cast<gpio_num_t>(Config::TEMP_SENSOR_PIN), &wire);
+
+    Drivers::TemperatureSensor* sensor = Drivers::TemperatureSensor::GetInstance();
+    HOST_CHECK(sensor->Init());
+    HOST_CHECK_EQ(sensor->GetChannelCount(), COUNT);
+
+    // Channels in search order
+    for (size_t i = 1; i < sensor->GetChannelCount(); ++i)
+    {
+        HOST_CHECK(SearchKey(sensor->GetRom(i - 1)) < SearchKey(sensor->GetRom(i)));
+    }
+
+    const uint32_t periodUs = Drivers::TemperatureSensor::GetConversionTimeMs(sensor->GetResolution()) * 1000;
+
+    // The first update configures the probes and starts the first conversion.
+    // Each later one collects it and starts the next one for every probe
+    sensor->Update();
+    const uint32_t resetsBefore = wire.GetResetCount();
+    for (int cycle = 0; cycle < CYCLES; ++cycle)
+    {
+        HostTime::Advance(periodUs);
+        sensor->Update();
+    }
+
+    HOST_CHECK(sensor->HasReading());
+    for (size_t i = 0; i < COUNT; ++i)
+    {
+        HOST_CHECK_EQ(probes[i]->GetConversionCount(), static_cast<uint32_t>(CYCLES));
+
+        // Channel i reads the probe with its ROM
+        const size_t probe = std::find_if(probes.begin(), probes.end(),
+                                          [&](const auto& entry) { return entry->GetRom() == sensor->GetRom(i); }) - probes.begin();
+        HOST_CHECK(probe < COUNT);
+        HOST_CHECK(sensor->GetLastReading(i) == 24.0f + static_cast<float>(probe));
+    }
+
+    // Per cycle: one MATCH ROM per scratchpad, then one broadcast CONVERT T
+    HOST_CHECK_EQ(wire.GetResetCount() - resetsBefore, static_cast<uint32_t>(CYCLES * (COUNT + 1)));
+
+    // Limits on one channel: only that probe is reported by the alarm search
+    sensor->SetAlarmLimits(1, 0, 20);
+    for (int cycle = 0; cycle < 2; ++cycle)
+    {
+        HostTime::Advance(periodUs);
+        sensor->Update();
+    }
+    for (size_t i = 0; i < COUNT; ++i)
+    {
+        HOST_CHECK_EQ(sensor->IsAlarmActive(i), i == 1);
+    }
+}
+
+} // namespace
+
+//-----------------------------------------------------------------------------
+int main()
+{
+    OneWire bus(BUS_PIN);
+
+    for (size_t count : { 1, 2, 3, 5, 8, 16 })
+    {
+        TestSearch(bus, count);
+    }
+    TestAlarmSearch(bus);
+    TestEmptyBus(bus);
+
+    TestSensorChannels();
+
+    return HostTest::Finish("one_wire_search_test");
+}
@@ -0,0 +1,152 @@
+/*!****************************************************************************
+ * @file    one_wire_test.cpp
+ * @brief   OneWire against the simulated DS18B20, on whichever backend the
+ *          host was built with (RMT by default, -DHOST_ONE_WIRE_RMT=OFF for
+ *          the bit-banged one): presence detection, scratchpad writes and
+ *          reads with their CRC, and a conversion polled with read slots.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#include "tests/host_test.h"
+
+#include "framework/drivers/one_wire.h"
+#include "host/sim/one_wire_sim.h"
+#include "host_bus.h"
+#include "host_time.h"
+#include <cstdint>
+#include <cstdio>
+
+namespace {
+
+static constexpr PinName BUS_PIN = PinName::P26;
+static constexpr PinName EMPTY_PIN = PinName::P16;
+static constexpr uint32_t SCRATCHPAD_READS = 200;
+static constexpr uint32_t MAX_BUSY_SLOTS = 64;
+
+static constexpr uint8_t CMD_CONVERT_T = 0x44;
+static constexpr uint8_t CMD_READ_SCRATCH = 0xBE;
+static constexpr uint8_t CMD_WRITE_SCRATCH = 0x4E;
+static constexpr uint8_t CONFIG_9_BITS = 0x1F;
+static constexpr uint8_t CONFIG_12_BITS = 0x7F;
+
+//-----------------------------------------------------------------------------
+bool ReadScratchpad(OneWire& bus, uint8_t (&scratchpad)[9])
+{
+    if (!bus.SkipRom())
+    {
+        return false;
+    }
+
+    bus.WriteByte(CMD_READ_SCRATCH);
+    for (uint8_t& value : scratchpad)
+    {
+        value = bus.ReadByte();
+    }
+    return OneWire::Crc8(scratchpad, 8) == scratchpad[8];
+}
+
+//-----------------------------------------------------------------------------
+void WriteScratchpad(OneWire& bus, uint8_t high, uint8_t low, uint8_t config)
+{
+    HOST_CHECK(bus.SkipRom());
+    bus.WriteByte(CMD_WRITE_SCRATCH);
+    bus.WriteByte(high);
+    bus.WriteByte(low);
+    bus.WriteByte(config);
+}
+
+//-----------------------------------------------------------------------------
+float Convert(OneWire& bus, HostSim::Ds18b20& probe, float celsius)
+{
+    probe.SetTemperature(celsius);
+
+    HOST_CHECK(bus.SkipRom());
+    bus.WriteByte(CMD_CONVERT_T);
+
+    // The probe holds read slots low until its conversion time has passed
+    HOST_CHECK_EQ(bus.ReadBit(), 0);
+    HostTime::Advance(800000);
+
+    uint32_t busySlots = 0;
+    while (bus.ReadBit() == 0 && busySlots < MAX_BUSY_SLOTS)
+    {
+        ++busySlots;
+    }
+    HOST_CHECK(busySlots < MAX_BUSY_SLOTS);
+
+    uint8_t scratchpad[9] = {};
+    HOST_CHECK(ReadScratchpad(bus, scratchpad));
+    return static_cast<int16_t>((scratchpad[1] << 8) | scratchpad[0]) / 16.0f;
+}
+
+//-----------------------------------------------------------------------------
+void TestNoDevice()
+{
+    HostBus::SetInputLevel(static_cast<gpio_num_t>(EMPTY_PIN), 1);
+
+    OneWire bus(EMPTY_PIN);
+    HOST_CHECK(!bus.Reset());
+    HOST_CHECK(!bus.SkipRom());
+}
+
+//-----------------------------------------------------------------------------
+void TestScratchpad(OneWire& bus)
+{
+    uint8_t scratchpad[9] = {};
+
+    // Power-on values: 85 C, TH 75, TL 70, 12 bits
+    HOST_CHECK(bus.Reset());
+    HOST_CHECK(ReadScratchpad(bus, scratchpad));
+    HOST_CHECK_EQ(scratchpad[0], 0x50);
+    HOST_CHECK_EQ(scratchpad[1], 0x05);
+    HOST_CHECK_EQ(scratchpad[2], 75);
+    HOST_CHECK_EQ(scratchpad[3], 70);
+    HOST_CHECK_EQ(scratchpad[4], CONFIG_12_BITS);
+
+    WriteScratchpad(bus, 30, static_cast<uint8_t>(-5), CONFIG_9_BITS);
+
+    uint32_t good = 0;
+    for (uint32_t i = 0; i < SCRATCHPAD_READS; ++i)
+    {
+        const bool crc = ReadScratchpad(bus, scratchpad);
+        good += (crc && scratchpad[2] == 30 && scratchpad[3] == static_cast<uint8_t>(-5) && scratchpad[4] == CONFIG_9_BITS) ? 1 : 0;
+    }
+    HOST_CHECK_EQ(good, SCRATCHPAD_READS);
+}
+
+//-----------------------------------------------------------------------------
+void TestConversion(OneWire& bus, HostSim::Ds18b20& probe)
+{
+    // 9 bits: 0.5 C steps
+    HOST_CHECK(Convert(bus, probe, 23.5f) == 23.5f);
+    HOST_CHECK(Convert(bus, probe, -10.5f) == -10.5f);
+    HOST_CHECK(Convert(bus, probe, 23.3f) == 23.0f);
+
+    // 12 bits: 0.0625 C steps
+    WriteScratchpad(bus, 30, static_cast<uint8_t>(-5), CONFIG_12_BITS);
+    HOST_CHECK(Convert(bus, probe, 25.4375f) == 25.4375f);
+    HOST_CHECK_EQ(probe.GetConversionCount(), 4);
+}
+
+} // namespace
+
+//-----------------------------------------------------------------------------
+int main()
+{
+    HostSim::OneWireBus wire;
+    HostSim::Ds18b20 probe(0x0000A1B2C3D4ULL);
+    wire.AddDevice(&probe);
+    HostBus::AttachGpioDevice(static_cast<gpio_num_t>(BUS_PIN), &wire);
+
+    TestNoDevice();
+
+    OneWire bus(BUS_PIN);
+    TestScratchpad(bus);
+    TestConversion(bus, probe);
+
+    std::printf("one_wire: %u resets on the bus\n", wire.GetResetCount());
+    HostBus::AttachGpioDevice(static_cast<gpio_num_t>(BUS_PIN), nullptr);
+
+    return HostTest::Finish("one_wire_test");
+}
@@ -0,0 +1,209 @@
+/*!****************************************************************************
+ * @file    ring_buffer_test.cpp
+ * @brief   SpscRingBuffer and MpscRingBuffer: full/empty edges, then threaded
+ *          stress runs that check nothing is lost, duplicated or reordered
+ *          per producer, with the throughput printed next to a FreeRTOS
+ *          queue moving the same items.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#include "tests/host_test.h"
+
+#include "framework/os/ring_buffer.h"
+#include "freertos/queue.h"
+#include <chrono>
+#include <thread>
+#include <vector>
+
+namespace {
+
+static constexpr size_t CAPACITY = 64;
+static constexpr uint64_t SPSC_ITEMS = 2000000;
+static constexpr int PRODUCERS = 4;
+static constexpr uint64_t ITEMS_PER_PRODUCER = 250000;
+static constexpr int PRODUCER_SHIFT = 40;
+
+//-----------------------------------------------------------------------------
+double SecondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+//-----------------------------------------------------------------------------
+void TestEdges()
+{
+    SpscRingBuffer<int, 4> spsc;
+    int item = 0;
+
+    HOST_CHECK(!spsc.TryPop(item));
+    for (int i = 0; i < 4; ++i)
+    {
+        HOST_CHECK(spsc.TryPush(i));
+    }
+    HOST_CHECK(!spsc.TryPush(4));
+    HOST_CHECK_EQ(spsc.Size(), 4u);
+
+    // Wrap the indices a few times around the storage
+    for (int i = 4; i < 20; ++i)
+    {
+        HOST_CHECK(spsc.TryPop(item));
+        HOST_CHECK_EQ(item, i - 4);
+        HOST_CHECK(spsc.TryPush(i));
+    }
+
+    MpscRingBuffer<int, 4> mpsc;
+    HOST_CHECK(!mpsc.TryPop(item));
+    for (int i = 0; i < 4; ++i)
+    {
+        HOST_CHECK(mpsc.TryPush(i));
+    }
+    HOST_CHECK(!mpsc.TryPush(4));
+    for (int i = 0; i < 4; ++i)
+    {
+        HOST_CHECK(mpsc.TryPop(item));
+        HOST_CHECK_EQ(item, i);
+    }
+    HOST_CHECK(mpsc.IsEmpty());
+}
+
+//-----------------------------------------------------------------------------
+void StressSpsc()
+{
+    SpscRingBuffer<uint64_t, CAPACITY> ring;
+    const auto start = std::chrono::steady_clock::now();
+
+    std::thread producer([&]
+        {
+            for (uint64_t i = 1; i <= SPSC_ITEMS; ++i)
+            {
+                while (!ring.TryPush(i))
+                {
+                    std::this_thread::yield();
+                }
+            }
+        });
+
+    uint64_t expected = 1;
+    uint64_t outOfOrder = 0;
+    for (uint64_t i = 0; i < SPSC_ITEMS; ++i)
+    {
+        uint64_t item = 0;
+        while (!ring.TryPop(item))
+        {
+            std::this_thread::yield();
+        }
+        outOfOrder += (item != expected++) ? 1 : 0;
+    }
+    producer.join();
+
+    HOST_CHECK_EQ(outOfOrder, 0u);
+    HOST_CHECK(ring.IsEmpty());
+    std::printf("SpscRingBuffer: %.1f Mops/s\n", SPSC_ITEMS / SecondsSince(start) / 1e6);
+}
+
+//-----------------------------------------------------------------------------
+void StressMpsc()
+{
+    MpscRingBuffer<uint64_t, CAPACITY> ring;
+    const auto start = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < PRODUCERS; ++p)
+    {
+        producers.emplace_back([&ring, p]
+            {
+                for (uint64_t i = 0; i < ITEMS_PER_PRODUCER; ++i)
+                {
+                    while (!ring.TryPush((static_cast<uint64_t>(p) << PRODUCER_SHIFT) | i))
+                    {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+    }
+
+    // Each producer's items arrive in the order it pushed them
+    uint64_t next[PRODUCERS] = {};
+    uint64_t outOfOrder = 0;
+    for (uint64_t i = 0; i < PRODUCERS * ITEMS_PER_PRODUCER; ++i)
+    {
+        uint64_t item = 0;
+        while (!ring.TryPop(item))
+        {
+            std::this_thread::yield();
+        }
+
+        const size_t producer = static_cast<size_t>(item >> PRODUCER_SHIFT);
+        const uint64_t sequence = item & ((1ull << PRODUCER_SHIFT) - 1);
+        if (producer >= PRODUCERS || sequence != next[producer])
+        {
+            ++outOfOrder;
+            continue;
+        }
+        ++next[producer];
+    }
+
+    for (auto& producer : producers)
+    {
+        producer.join();
+    }
+
+    HOST_CHECK_EQ(outOfOrder, 0u);
+    for (int p = 0; p < PRODUCERS; ++p)
+    {
+        HOST_CHECK_EQ(next[p], ITEMS_PER_PRODUCER);
+    }
+    HOST_CHECK(ring.IsEmpty());
+    std::printf("MpscRingBuffer (%d producers): %.1f Mops/s\n", PRODUCERS,
+                PRODUCERS * ITEMS_PER_PRODUCER / SecondsSince(start) / 1e6);
+}
+
+//-----------------------------------------------------------------------------
+void BenchmarkQueue()
+{
+    QueueHandle_t queue = xQueueCreate(CAPACITY, sizeof(uint64_t));
+    HOST_CHECK(queue != nullptr);
+    const auto start = std::chrono::steady_clock::now();
+
+    std::thread producer([&]
+        {
+            for (uint64_t i = 1; i <= SPSC_ITEMS; ++i)
+            {
+                while (xQueueSend(queue, &i, 0) != pdTRUE)
+                {
+                    std::this_thread::yield();
+                }
+            }
+        });
+
+    uint64_t expected = 1;
+    uint64_t outOfOrder = 0;
+    for (uint64_t i = 0; i < SPSC_ITEMS; ++i)
+    {
+        uint64_t item = 0;
+        while (xQueueReceive(queue, &item, 0) != pdTRUE)
+        {
+            std::this_thread::yield();
+        }
+        outOfOrder += (item != expected++) ? 1 : 0;
+    }
+    producer.join();
+
+    HOST_CHECK_EQ(outOfOrder, 0u);
+    std::printf("FreeRTOS queue: %.1f Mops/s\n", SPSC_ITEMS / SecondsSince(start) / 1e6);
+    vQueueDelete(queue);
+}
+
+} // namespace
+
+//-----------------------------------------------------------------------------
+int main()
+{
+    TestEdges();
+    StressSpsc();
+    StressMpsc();
+    BenchmarkQueue();
+
+    return HostTest::Finish("ring_buffer_test");
+}
@@ -0,0 +1,321 @@
+/*!****************************************************************************
+ * @file    rolling_trend_test.cpp
+ * @brief   Dsp::RollingTrend against brute force over the window (mean,
+ *          variance, slope and z-score, small windows and a long one at a
+ *          high level), then the early-warning rule of WaterMonitor on
+ *          synthetic traces through the sensor filter chain: a failing
+ *          heater warns before the limit is crossed, a stable tank with
+ *          probe glitches never warns, and a TDS step is one jump.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#include "tests/host_test.h"
+
+#include "framework/dsp/filter_chain.h"
+#include "framework/dsp/hampel_filter.h"
+#include "framework/dsp/moving_average.h"
+#include "framework/dsp/rolling_trend.h"
+#include "include/config.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <random>
+
+namespace {
+
+static constexpr double PERIOD_S = Config::WATER_MONITOR_PERIOD_MS / 1000.0;
+static constexpr double SAMPLES_PER_HOUR = 3600.0 / PERIOD_S;
+static constexpr size_t WINDOW = Config::TREND_WINDOW_SAMPLES;
+
+//! The thermostat cycle of a healthy tank: +-0.2 degC over an hour, 1.3 degC/h at its steepest
+static constexpr double RIPPLE_C = 0.2;
+static constexpr double RIPPLE_PERIOD_S = 3600.0;
+
+//-----------------------------------------------------------------------------
+//! Window statistics recomputed from the samples
+struct Reference
+{
+    double mean = 0;
+    double variance = 0;
+    double slope = 0;
+};
+
+Reference Compute(const std::deque<double>& window)
+{
+    Reference result;
+    const double n = static_cast<double>(window.size());
+    for (double value : window)
+    {
+        result.mean += value / n;
+    }
+
+    const double meanX = (n - 1) / 2;
+    double sxy = 0;
+    double sxx = 0;
+    for (size_t i = 0; i < window.size(); ++i)
+    {
+        result.variance += (window[i] - result.mean) * (window[i] - result.mean) / (n - 1);
+        sxy += (i - meanX) * (window[i] - result.mean);
+        sxx += (i - meanX) * (i - meanX);
+    }
+    result.slope = sxy / sxx;
+    return result;
+}
+
+//-----------------------------------------------------------------------------
+//! Every statistic after every sample; 'level' shifts the signal away from 0
+template <typename T, size_t N>
+void TestAgainstReference(double level, double tolerance, std::mt19937& random)
+{
+    static constexpr size_t SAMPLES = 20000;
+    static constexpr T MIN_STD_DEV = T(0.01);
+    std::normal_distribution<double> noise(0.0, 0.5);
+
+    Dsp::RollingTrend<T, N> trend(MIN_STD_DEV);
+    std::deque<double> window;
+
+    double worstMean = 0;
+    double worstVariance = 0;
+    double worstSlope = 0;
+    double worstScore = 0;
+
+    for (size_t i = 0; i < SAMPLES; ++i)
+    {
+        // A drift that turns around, so the slope changes sign
+        const double drift = 2.0 * std::sin(static_cast<double>(i) / 1500.0);
+        const T sample = static_cast<T>(level + drift + noise(random));
+
+        // The score is against the samples before this one
+        double expectedScore = 0;
+        if (window.size() >= 2)
+        {
+            const Reference before = Compute(window);
+            expectedScore = (sample - before.mean) / std::max(std::sqrt(before.variance), static_cast<double>(MIN_STD_DEV));
+        }
+
+        const T score = trend.Process(sample);
+        window.push_back(sample);
+        if (window.size() > N)
+        {
+            window.pop_front();
+        }
+        HOST_CHECK_EQ(trend.GetCount(), window.size());
+
+        if (window.size() < 2)
+        {
+            continue;
+        }
+
+        const Reference now = Compute(window);
+        worstMean = std::max(worstMean, std::fabs(trend.GetMean() - now.mean));
+        worstVariance = std::max(worstVariance, std::fabs(trend.GetVariance() - now.variance) / std::max(now.variance, 1.0));
+        worstSlope = std::max(worstSlope, std::fabs(trend.GetSlope() - now.slope));
+        worstScore = std::max(worstScore, std::fabs(score - expectedScore));
+    }
+
+    std::printf("window %3zu at %6.0f: worst mean %.1e, variance %.1e, slope %.1e, z-score %.1e\n",
+                N, level, worstMean, worstVariance, worstSlope, worstScore);
+    HOST_CHECK(trend.IsFull());
+    HOST_CHECK(worstMean < tolerance);
+    HOST_CHECK(worstVariance < tolerance);
+    HOST_CHECK(worstSlope < tolerance);
+    HOST_CHECK(worstScore < tolerance * 10);
+}
+
+//-----------------------------------------------------------------------------
+void TestSmallCases()
+{
+    Dsp::RollingTrend<double, 4> trend;
+    HOST_CHECK(trend.Process(5.0) == 0.0);
+    HOST_CHECK(trend.GetSlope() == 0.0);
+    HOST_CHECK(trend.GetVariance() == 0.0);
+
+    // A straight line: slope 2 per sample, in and past a full window
+    for (int i = 1; i < 10; ++i)
+    {
+        trend.Process(5.0 + 2.0 * i);
+        HOST_CHECK(std::fabs(trend.GetSlope() - 2.0) < 1e-12);
+    }
+
+    // Flat: no variance, and the floor keeps a small step at a bounded score
+    Dsp::RollingTrend<double, 8> flat(0.5);
+    for (int i = 0; i < 20; ++i)
+    {
+        flat.Process(3.0);
+    }
+    HOST_CHECK(flat.GetVariance() < 1e-24);
+    HOST_CHECK(std::fabs(flat.Process(4.0) - 2.0) < 1e-9);
+
+    flat.Reset();
+    HOST_CHECK_EQ(flat.GetCount(), 0);
+    HOST_CHECK(flat.Process(100.0) == 0.0);
+    HOST_CHECK(flat.GetMean() == 100.0);
+}
+
+//-----------------------------------------------------------------------------
+//! WaterMonitor::Analyze for one reading, counting the warnings it would raise
+class Detector
+{
+    public:
+
+        Detector(float minStdDev, float rateLimit, float spikeZScore)
+            : _trend(minStdDev), _rateLimit(rateLimit), _spikeZScore(spikeZScore)
+        {
+        }
+
+        void Process(float raw)
+        {
+            const float value = _filter.Process(raw);
+            const float score = std::fabs(_trend.Process(value));
+            const size_t count = _trend.GetCount();
+
+            const float rate = (count >= Config::TREND_MIN_SAMPLES) ? std::fabs(_trend.GetSlope() * static_cast<float>(SAMPLES_PER_HOUR)) : 0.0f;
+            if (!_rateWarning && rate >= _rateLimit)
+            {
+                _rateWarning = true;
+                ++rateEvents;
+            }
+            else if (_rateWarning && rate < _rateLimit * CLEAR_RATIO)
+            {
+                _rateWarning = false;
+            }
+
+            if (count <= Config::SPIKE_MIN_SAMPLES)
+            {
+                _spike = false;
+            }
+            else if (!_spike && score >= _spikeZScore)
+            {
+                _spike = true;
+                ++spikeEvents;
+            }
+            else if (_spike && score < _spikeZScore * CLEAR_RATIO)
+            {
+                _spike = false;
+            }
+        }
+
+        size_t rateEvents = 0;
+        size_t spikeEvents = 0;
+
+    private:
+
+        static constexpr float CLEAR_RATIO = 0.5f;
+
+        Dsp::FilterChain<Dsp::HampelFilter<float, 5>, Dsp::MovingAverage<float, 12>> _filter;
+        Dsp::RollingTrend<float, WINDOW> _trend;
+        float _rateLimit;
+        float _spikeZScore;
+        bool _rateWarning = false;
+        bool _spike = false;
+};
+
+//! As the DS18B20 at 12 bits reports it
+float Quantize(double celsius)
+{
+    return static_cast<float>(std::round(celsius * 16.0) / 16.0);
+}
+
+//-----------------------------------------------------------------------------
+void TestHeaterFailure(std::mt19937& random)
+{
+    static constexpr double SETPOINT = 25.0;
+    static constexpr double FAILURE_S = 7200.0;
+    static constexpr double FALL_PER_HOUR = 3.0;
+    static constexpr double LIMIT_DROP = 1.5;                  //!< The low limit, below the setpoint
+    std::normal_distribution<double> noise(0.0, 0.03);
+
+    Detector detector(0.05f, 2.0f, 5.0f);
+    double warnedAfterS = -1;
+
+    for (double t = 0; t < FAILURE_S + 3600.0; t += PERIOD_S)
+    {
+        // The thermostat ripple, then the heater stops
+        const double ripple = RIPPLE_C * std::sin(t * 2 * M_PI / RIPPLE_PERIOD_S);
+        const double fall = (t < FAILURE_S) ? 0.0 : (t - FAILURE_S) * FALL_PER_HOUR / 3600.0;
+        detector.Process(Quantize(SETPOINT + ripple - fall + noise(random)));
+
+        if (warnedAfterS < 0 && detector.rateEvents != 0)
+        {
+            warnedAfterS = t - FAILURE_S;
+        }
+    }
+
+    const double limitAfterS = LIMIT_DROP / FALL_PER_HOUR * 3600.0;
+    std::printf("heater failure: warned after %.0f s, the limit is crossed after %.0f s\n", warnedAfterS, limitAfterS);
+    HOST_CHECK(warnedAfterS > 0);
+    HOST_CHECK(warnedAfterS < limitAfterS);
+    HOST_CHECK_EQ(detector.spikeEvents, 0);
+}
+
+//-----------------------------------------------------------------------------
+void TestStableTank(std::mt19937& random)
+{
+    static constexpr size_t GLITCH_PERIOD = 997;
+    std::normal_distribution<double> noise(0.0, 0.03);
+
+    Detector detector(0.05f, 2.0f, 5.0f);
+    size_t glitches = 0;
+
+    for (double t = 0; t < 24 * 3600.0; t += PERIOD_S)
+    {
+        // A probe answering its 85 degC power-on value now and then
+        const bool glitch = (static_cast<size_t>(t / PERIOD_S) % GLITCH_PERIOD) == GLITCH_PERIOD - 1;
+        glitches += glitch ? 1 : 0;
+        detector.Process(glitch ? 85.0f : Quantize(25.0 + RIPPLE_C * std::sin(t * 2 * M_PI / RIPPLE_PERIOD_S) + noise(random)));
+    }
+
+    std::printf("stable tank: %zu glitches over 24 h, %zu rate and %zu jump warnings\n",
+                glitches, detector.rateEvents, detector.spikeEvents);
+    HOST_CHECK_EQ(detector.rateEvents, 0);
+    HOST_CHECK_EQ(detector.spikeEvents, 0);
+}
+
+//-----------------------------------------------------------------------------
+void TestTdsStep(std::mt19937& random)
+{
+    static constexpr double STEP_S = 3600.0;
+    std::normal_distribution<double> noise(0.0, 2.0);
+
+    Detector detector(5.0f, 100.0f, 5.0f);
+    double jumpAfterS = -1;
+
+    for (double t = 0; t < STEP_S + 1800.0; t += PERIOD_S)
+    {
+        const double level = (t < STEP_S) ? 300.0 : 360.0;
+        detector.Process(static_cast<float>(std::round(level + noise(random))));
+
+        if (jumpAfterS < 0 && detector.spikeEvents != 0)
+        {
+            jumpAfterS = t - STEP_S;
+        }
+    }
+
+    std::printf("tds step: jump after %.0f s, %zu jump and %zu rate warnings\n", jumpAfterS, detector.spikeEvents, detector.rateEvents);
+    HOST_CHECK(jumpAfterS >= 0);
+    HOST_CHECK(jumpAfterS < 60.0);
+    HOST_CHECK_EQ(detector.spikeEvents, 1);
+}
+
+} // namespace
+
+//-----------------------------------------------------------------------------
+int main()
+{
+    std::mt19937 random(20261017);
+
+    TestAgainstReference<double, 2>(0.0, 1e-9, random);
+    TestAgainstReference<double, 7>(0.0, 1e-9, random);
+    TestAgainstReference<double, WINDOW>(1000.0, 1e-9, random);
+    TestAgainstReference<float, WINDOW>(1000.0, 1e-3, random);
+    TestSmallCases();
+
+    TestHeaterFailure(random);
+    TestStableTank(random);
+    TestTdsStep(random);
+
+    return HostTest::Finish("rolling_trend_test");
+}
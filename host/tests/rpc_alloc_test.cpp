@@ -0,0 +1,194 @@
+/*!****************************************************************************
+ * @file    rpc_alloc_test.cpp
+ * @brief   RPC round trips on the full firmware against the simulated broker:
+ *          from the MQTT task receiving the request to the response being
+ *          published, feedNow and syncDevice must not touch the general heap
+ *          (the request lives in a pool block, the response in the request arena).
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#include "tests/host_test.h"
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "host/sim/board.h"
+#include "host_alloc.h"
+#include "host_net.h"
+#include "host_time.h"
+#include "src/core/smart_aquarium_guardian.h"
+#include "src/managers/network_controller.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+#include <thread>
+
+//-----------------------------------------------------------------------------
+// Heap allocations made on the request path while counting is on: the test
+// thread, which runs the network controller, and the MQTT task. The broker's
+// own copies are made inside HostAlloc::ShimScope and not counted
+
+static std::atomic<bool> s_countAllocations{false};
+static std::atomic<uint64_t> s_allocations{0};
+static thread_local bool t_testThread = false;
+
+static bool OnRequestPath()
+{
+    static thread_local int onPath = -1;
+    static thread_local bool resolving = false;
+
+    // Naming a thread for the first time creates its task record
+    if (onPath < 0 && !resolving)
+    {
+        resolving = true;
+        onPath = t_testThread || std::strcmp(pcTaskGetName(nullptr), "mqtt_task") == 0;
+        resolving = false;
+    }
+    return onPath > 0;
+}
+
+void* operator new(size_t size)
+{
+    if (s_countAllocations.load(std::memory_order_relaxed) && !HostAlloc::InShim() && OnRequestPath())
+    {
+        s_allocations.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    if (void* block = std::malloc(size != 0 ? size : 1))
+    {
+        return block;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* block) noexcept { std::free(block); }
+void operator delete(void* block, size_t) noexcept { std::free(block); }
+
+namespace {
+
+static constexpr int TIMEOUT_MS = 5000;
+
+//-----------------------------------------------------------------------------
+// Run the whole firmware until the MQTT client is connected and subscribed
+bool WaitForBroker()
+{
+    const uint64_t endUs = HostTime::NowUs() + 30000000ULL;
+    while (HostTime::NowUs() < endUs)
+    {
+        SmartAquariumGuardian::GetInstance()->Update();
+
+        if (Managers::NetworkController::GetInstance()->IsMqttClientConnected()
+         && HostNet::BrokerPublish("v1/devices/me/rpc/request/0", "{\"method\":\"syncDevice\",\"params\":{}}") > 0)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+//-----------------------------------------------------------------------------
+// Only the network controller runs during a round trip, so the counter sees
+// the request path and nothing the other managers happen to do meanwhile
+bool RoundTrip(const std::string& topic, const std::string& request, const std::string& responseTopic, std::string& response)
+{
+    HostNet::TakePublished();
+
+    const auto end = std::chrono::steady_clock::now() + std::chrono::milliseconds(TIMEOUT_MS);
+    HOST_CHECK(HostNet::BrokerPublish(topic, request) == 1);
+
+    while (std::chrono::steady_clock::now() < end)
+    {
+        Managers::NetworkController::GetInstance()->Update();
+
+        const bool wasCounting = s_countAllocations.exchange(false);
+        for (auto& [publishedTopic, payload] : HostNet::TakePublished())
+        {
+            if (publishedTopic == responseTopic)
+            {
+                response = payload;
+                return true;
+            }
+        }
+        s_countAllocations = wasCounting;
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return false;
+}
+
+//-----------------------------------------------------------------------------
+void CheckRpc(const std::string& request, const char* expectedResult, int roundTrips)
+{
+    // Strings of the test itself are built before counting starts
+    std::string topic;
+    std::string responseTopic;
+    std::string response;
+    topic.reserve(64);
+    responseTopic.reserve(64);
+    response.reserve(256);
+
+    // First call: lazily created singletons and one-time buffers
+    HOST_CHECK(RoundTrip("v1/devices/me/rpc/request/1", request, "v1/devices/me/rpc/response/1", response));
+
+    uint64_t worst = 0;
+    for (int i = 0; i < roundTrips; ++i)
+    {
+        topic = "v1/devices/me/rpc/request/" + std::to_string(100 + i);
+        responseTopic = "v1/devices/me/rpc/response/" + std::to_string(100 + i);
+        response.clear();
+
+        s_allocations = 0;
+        s_countAllocations = true;
+        const bool answered = RoundTrip(topic, request, responseTopic, response);
+        s_countAllocations = false;
+
+        HOST_CHECK(answered);
+        HOST_CHECK(response.find(expectedResult) != std::string::npos);
+        worst = std::max<uint64_t>(worst, s_allocations.load());
+    }
+
+    std::printf("%s: worst round trip %llu allocation(s), response %s\n", request.c_str(), static_cast<unsigned long long>(worst), response.c_str());
+    HOST_CHECK_EQ(worst, 0);
+}
+
+//-----------------------------------------------------------------------------
+void TestCountingSeesAllocations()
+{
+    s_allocations = 0;
+    s_countAllocations = true;
+    std::string probe(64, 'x');
+    asm volatile("" : : "r"(probe.data()) : "memory");
+    s_countAllocations = false;
+
+    HOST_CHECK(s_allocations.load() > 0);
+}
+
+} // namespace
+
+//-----------------------------------------------------------------------------
+int main()
+{
+    t_testThread = true;
+
+    static HostSim::Board board(HostSim::Board::Options{});
+    board.Attach();
+
+    SmartAquariumGuardian::GetInstance()->Init();
+
+    TestCountingSeesAllocations();
+
+    HOST_CHECK(WaitForBroker());
+    // The feeds themselves run on the feeder's worker: the first one is still
+    // running while the next ones fill the feeding queue
+    CheckRpc("{\"method\":\"feedNow\",\"params\":{\"dose\":1}}", "\"success\"", 3);
+    CheckRpc("{\"method\":\"syncDevice\",\"params\":{}}", "\"success\"", 20);
+
+    // Firmware tasks never return; leave without running static destructors under them
+    const int status = HostTest::Finish("rpc_alloc_test");
+    std::fflush(stdout);
+    std::_Exit(status);
+}
@@ -0,0 +1,137 @@
+/*!****************************************************************************
+ * @file    scheduler_test.cpp
+ * @brief   Scheduler on a VirtualClock: earliest-deadline-first dispatch,
+ *          the release grid, deadline miss accounting and wake-ups. Task
+ *          bodies "run" by advancing the clock, so every run replays the
+ *          same timeline.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#include "tests/host_test.h"
+
+#include "framework/os/scheduler.h"
+#include "framework/os/virtual_clock.h"
+#include <string>
+
+namespace {
+
+static constexpr uint64_t MS = 1000;
+
+//-----------------------------------------------------------------------------
+void TestEdfOrder()
+{
+    VirtualClock clock;
+    Scheduler scheduler(clock);
+    std::string order;
+
+    // Same release, the tighter deadline goes first whatever the registration order
+    scheduler.Register("A", { 10, 10, Scheduler::WAKE_TIMER }, [&] { order += 'A'; clock.Advance(1 * MS); });
+    scheduler.Register("B", { 20, 4, Scheduler::WAKE_TIMER }, [&] { order += 'B'; clock.Advance(1 * MS); });
+
+    scheduler.RunOnce();
+    HOST_CHECK(order == "BA");
+    HOST_CHECK_EQ(clock.NowUs(), 10 * MS);      // Slept to the next release of A
+
+    scheduler.RunOnce();
+    HOST_CHECK(order == "BAA");
+    HOST_CHECK_EQ(clock.NowUs(), 20 * MS);
+
+    scheduler.RunOnce();
+    HOST_CHECK(order == "BAABA");
+
+    // 100 ms on the grid: A every 10 ms, B every 20 ms
+    while (clock.NowUs() < 100 * MS)
+    {
+        scheduler.RunOnce();
+    }
+    HOST_CHECK_EQ(scheduler.GetStats(0)->runs, 10u);
+    HOST_CHECK_EQ(scheduler.GetStats(1)->runs, 5u);
+    HOST_CHECK_EQ(scheduler.GetStats(0)->deadlineMisses, 0u);
+    HOST_CHECK_EQ(scheduler.GetStats(1)->deadlineMisses, 0u);
+}
+
+//-----------------------------------------------------------------------------
+void TestEventPreemptsLaterDeadline()
+{
+    VirtualClock clock;
+    Scheduler scheduler(clock);
+    std::string order;
+
+    Scheduler::TaskId urgent = Scheduler::INVALID_TASK;
+    scheduler.Register("slow", { 50, 50, Scheduler::WAKE_TIMER }, [&] { order += 'S'; clock.Advance(2 * MS); });
+    urgent = scheduler.Register("urgent", { 0, 5, Scheduler::WAKE_NOTIFICATION }, [&] { order += 'U'; });
+
+    // Released together: the notified task's 5 ms deadline is the earliest
+    scheduler.Notify(urgent);
+    scheduler.RunOnce();
+    HOST_CHECK(order == "US");
+
+    // Only the notified source releases it
+    scheduler.Notify(urgent, Scheduler::WAKE_QUEUE);
+    const uint64_t before = clock.NowUs();
+    scheduler.RunOnce();
+    HOST_CHECK(order == "US");
+    HOST_CHECK_EQ(clock.NowUs(), before);        // The wake-up still ended the wait early
+    HOST_CHECK_EQ(scheduler.GetStats(urgent)->runs, 1u);
+}
+
+//-----------------------------------------------------------------------------
+void TestDeadlineMisses()
+{
+    VirtualClock clock;
+    Scheduler scheduler(clock);
+
+    uint64_t overrunUs = 12 * MS;
+    const Scheduler::TaskId periodic = scheduler.Register("periodic", { 10, 10, Scheduler::WAKE_TIMER },
+        [&] { clock.Advance(overrunUs); });
+    const Scheduler::TaskId event = scheduler.Register("event", { 0, 3, Scheduler::WAKE_NOTIFICATION },
+        [&] { clock.Advance(5 * MS); });
+
+    // 12 ms for a 10 ms deadline: one miss, and the release at 10 ms is skipped, not bursted
+    scheduler.RunOnce();
+    HOST_CHECK_EQ(scheduler.GetStats(periodic)->runs, 1u);
+    HOST_CHECK_EQ(scheduler.GetStats(periodic)->deadlineMisses, 1u);
+    HOST_CHECK_EQ(scheduler.GetStats(periodic)->maxRunUs, 12 * MS);
+    HOST_CHECK_EQ(clock.NowUs(), 22 * MS);
+
+    overrunUs = 1 * MS;
+    scheduler.RunOnce();
+    HOST_CHECK_EQ(scheduler.GetStats(periodic)->runs, 2u);
+    HOST_CHECK_EQ(scheduler.GetStats(periodic)->deadlineMisses, 1u);
+
+    // Event task: 5 ms of work for a 3 ms deadline
+    scheduler.Notify(event);
+    scheduler.RunOnce();
+    HOST_CHECK_EQ(scheduler.GetStats(event)->runs, 1u);
+    HOST_CHECK_EQ(scheduler.GetStats(event)->deadlineMisses, 1u);
+    HOST_CHECK_EQ(scheduler.GetStats(event)->lastRunUs, 5 * MS);
+}
+
+//-----------------------------------------------------------------------------
+void TestReleaseLatency()
+{
+    VirtualClock clock;
+    Scheduler scheduler(clock);
+
+    // Both released at 0; the second waits for the 4 ms of the first
+    scheduler.Register("first", { 10, 5, Scheduler::WAKE_TIMER }, [&] { clock.Advance(4 * MS); });
+    const Scheduler::TaskId second = scheduler.Register("second", { 10, 10, Scheduler::WAKE_TIMER }, [&] {});
+
+    scheduler.RunOnce();
+    HOST_CHECK_EQ(scheduler.GetStats(second)->maxReleaseLatencyUs, 4 * MS);
+    HOST_CHECK_EQ(scheduler.GetStats(second)->deadlineMisses, 0u);
+}
+
+} // namespace
+
+//-----------------------------------------------------------------------------
+int main()
+{
+    TestEdfOrder();
+    TestEventPreemptsLaterDeadline();
+    TestDeadlineMisses();
+    TestReleaseLatency();
+
+    return HostTest::Finish("scheduler_test");
+}
@@ -0,0 +1,350 @@
+/*!****************************************************************************
+ * @file    storage_journal_test.cpp
+ * @brief   StorageService config journal on the simulated AT24C32, across
+ *          power cycles. Each boot runs in a child process; only the EEPROM
+ *          image survives it. Saves are cut at every byte of one save and
+ *          at random points of many more: every reboot loads either the
+ *          config being saved or the one before it, never a damaged one or
+ *          the defaults. A run of one-field saves spreads its wear over the
+ *          journal, and a legacy JSON image is converted without loss.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#include "tests/host_test.h"
+
+#include "host/sim/eeprom_sim.h"
+#include "host_bus.h"
+#include "include/config.h"
+#include "src/services/memory/eeprom_memory.h"
+#include "src/services/memory/memory_config_data.h"
+#include "src/services/storage_service.h"
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <new>
+#include <random>
+#include <string>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace {
+
+using HostSim::At24c32;
+using Services::FeeddingScheduleList;
+using Services::FieldId;
+using Services::MemoryConfigData;
+using Services::StorageService;
+
+static constexpr int RANDOM_CUTS = 100;
+static constexpr uint32_t MAX_CUT_BYTES = 200;             //!< About the largest save: some saves complete
+static constexpr int WEAR_SAVES = 300;
+
+char s_eepromPath[] = "/tmp/storage_journal_test_XXXXXX";
+
+//! What the boots tell the test process, in shared memory
+struct Shared
+{
+    uint32_t committed;         //!< Config known to be saved
+    uint32_t attempted;         //!< Config whose save was cut: either one may load
+    uint32_t loaded;            //!< Config the last boot found
+    uint32_t saveBytes;
+    uint32_t maxPageWrites;
+    uint32_t pageWrites;
+};
+
+Shared* s_shared = nullptr;
+
+//-----------------------------------------------------------------------------
+//! Config number 'version': records of different lengths, every field moving
+MemoryConfigData ConfigFor(uint32_t version)
+{
+    std::mt19937 random(version);
+    std::uniform_int_distribution<int> any(0, 1 << 20);
+
+    MemoryConfigData config;
+    config._wifiSsid = "net-" + std::to_string(version) + std::string(any(random) % 28, 's');
+    config._wifiPassword = std::string(any(random) % 64, static_cast<char>('a' + version % 26));
+    config._tempLimitMin = 18.0f + (any(random) % 40) / 8.0f;
+    config._tempLimitMinEnabled = (any(random) % 2) != 0;
+    config._tempLimitMax = 26.0f + (any(random) % 40) / 8.0f;
+    config._tdsLimitMax = 300 + any(random) % 500;
+    config._tdsRateLimit = static_cast<int>(version % 1000);
+    config._spikeZScore = 2.0f + (any(random) % 18);
+
+    const size_t entries = any(random) % (Services::MAX_FEEDING_SCHEDULE_ENTRIES + 1);
+    for (size_t slot = 0; slot < entries; ++slot)
+    {
+        config._feedingSchedule.push_back({ any(random) % 1440, static_cast<int>(slot), 1 + any(random) % 5, (any(random) % 2) != 0 });
+    }
+    return config;
+}
+
+bool SameConfig(const MemoryConfigData& a, const MemoryConfigData& b)
+{
+    bool same = true;
+    #define X(type, id, name, key, def) same = same && (a.name == b.name);
+    CONFIG_FIELDS
+    #undef X
+    return same;
+}
+
+//-----------------------------------------------------------------------------
+MemoryConfigData Loaded()
+{
+    StorageService* storage = StorageService::GetInstance();
+    MemoryConfigData config;
+    #define X(type, id, name, key, def) config.name = storage->Get<type>(FieldId::id);
+    CONFIG_FIELDS
+    #undef X
+    return config;
+}
+
+//! All the fields of 'config' in one transaction: one save
+bool Save(const MemoryConfigData& config)
+{
+    StorageService* storage = StorageService::GetInstance();
+    storage->BeginTransaction();
+    #define X(type, id, name, key, def) storage->Set<type>(FieldId::id, config.name);
+    CONFIG_FIELDS
+    #undef X
+    return storage->Commit();
+}
+
+//-----------------------------------------------------------------------------
+//! One boot of the board: 'boot' runs in a child process on the EEPROM image
+bool PowerCycle(const std::function<void(At24c32&)>& boot)
+{
+    std::fflush(stdout);
+
+    const pid_t pid = fork();
+    if (pid == 0)
+    {
+        static At24c32 eeprom(s_eepromPath);
+        HostBus::AttachI2cDevice(I2C_NUM_0, Config::EEPROM_I2C_ADDRESS, &eeprom);
+
+        HOST_CHECK(Services::EepromMemory::GetInstance()->Init());
+        HOST_CHECK(StorageService::GetInstance()->Init());
+        boot(eeprom);
+
+        std::fflush(stdout);
+        std::_Exit(HostTest::Failures() == 0 ? 0 : 1);
+    }
+
+    int status = 0;
+    return (pid > 0) && (waitpid(pid, &status, 0) == pid) && WIFEXITED(status) && (WEXITSTATUS(status) == 0);
+}
+
+//-----------------------------------------------------------------------------
+//! The boot after a save: the config saved, or the one before if the save was cut
+void CheckLoaded()
+{
+    const MemoryConfigData loaded = Loaded();
+    const bool isCommitted = SameConfig(loaded, ConfigFor(s_shared->committed));
+    const bool isAttempted = SameConfig(loaded, ConfigFor(s_shared->attempted));
+    HOST_CHECK(isCommitted || isAttempted);
+
+    s_shared->loaded = isAttempted ? s_shared->attempted : s_shared->committed;
+}
+
+//! Saves config 'version' with the power cut after 'cutBytes' (-1: no cut)
+void SaveWithCut(At24c32& eeprom, uint32_t version, int64_t cutBytes)
+{
+    s_shared->attempted = version;
+    if (cutBytes >= 0)
+    {
+        eeprom.CutPowerAfter(static_cast<uint32_t>(cutBytes));
+    }
+
+    const uint32_t before = eeprom.GetBytesWritten();
+    const bool saved = Save(ConfigFor(version));
+
+    if (saved && !eeprom.IsPowerCut())
+    {
+        s_shared->committed = version;
+        s_shared->saveBytes = eeprom.GetBytesWritten() - before;
+    }
+}
+
+//-----------------------------------------------------------------------------
+//! Boot, check what the last save left, save the next config with a cut: 'count' times
+int CutCycles(int count, const std::function<int64_t(int)>& cutAt)
+{
+    int failedBoots = 0;
+    for (int cycle = 0; cycle < count; ++cycle)
+    {
+        const uint32_t next = s_shared->committed + 1;
+        const int64_t cut = cutAt(cycle);
+        failedBoots += PowerCycle([&](At24c32& eeprom)
+            {
+                CheckLoaded();
+                SaveWithCut(eeprom, next, cut);
+            }
+        ) ? 0 : 1;
+
+        // A cut save that still made it is the config from now on
+        failedBoots += PowerCycle([](At24c32&) { CheckLoaded(); }) ? 0 : 1;
+        s_shared->committed = s_shared->loaded;
+        s_shared->attempted = s_shared->loaded;
+    }
+    return failedBoots;
+}
+
+//-----------------------------------------------------------------------------
+void TestFirstBoot()
+{
+    // Blank EEPROM: the defaults, saved as the first record
+    HOST_CHECK(PowerCycle([](At24c32&) { HOST_CHECK(SameConfig(Loaded(), MemoryConfigData{})); }));
+
+    s_shared->committed = 1;
+    s_shared->attempted = 1;
+    HOST_CHECK(PowerCycle([](At24c32& eeprom) { SaveWithCut(eeprom, 1, -1); }));
+    HOST_CHECK(PowerCycle([](At24c32&) { CheckLoaded(); }));
+    HOST_CHECK_EQ(s_shared->loaded, 1);
+}
+
+//-----------------------------------------------------------------------------
+std::string ReadImage()
+{
+    std::string image(At24c32::SIZE_BYTES, '\xFF');
+    if (FILE* file = std::fopen(s_eepromPath, "rb"))
+    {
+        image.resize(std::fread(image.data(), 1, image.size(), file));
+        std::fclose(file);
+    }
+    return image;
+}
+
+void WriteImage(const std::string& image)
+{
+    FILE* file = std::fopen(s_eepromPath, "wb");
+    HOST_CHECK(file != nullptr);
+    if (file != nullptr)
+    {
+        std::fwrite(image.data(), 1, image.size(), file);
+        std::fclose(file);
+    }
+}
+
+//-----------------------------------------------------------------------------
+//! The same save, from the same image, cut at each of its bytes
+void TestEveryByte()
+{
+    const std::string image = ReadImage();
+    const uint32_t committed = s_shared->committed;
+    const uint32_t next = committed + 1;
+
+    HOST_CHECK(PowerCycle([&](At24c32& eeprom) { SaveWithCut(eeprom, next, -1); }));
+    const uint32_t saveBytes = s_shared->saveBytes;
+    HOST_CHECK(saveBytes > 0);
+
+    // Until its last byte is in, the save is not there
+    int failedBoots = 0;
+    size_t wrong = 0;
+    for (uint32_t cut = 0; cut <= saveBytes; ++cut)
+    {
+        WriteImage(image);
+        s_shared->committed = committed;
+
+        failedBoots += PowerCycle([&](At24c32& eeprom) { SaveWithCut(eeprom, next, cut); }) ? 0 : 1;
+        failedBoots += PowerCycle([](At24c32&) { CheckLoaded(); }) ? 0 : 1;
+        wrong += (s_shared->loaded == ((cut < saveBytes) ? committed : next)) ? 0 : 1;
+    }
+
+    std::printf("storage_journal: a save of %u bytes cut at each byte\n", saveBytes);
+    HOST_CHECK_EQ(failedBoots, 0);
+    HOST_CHECK_EQ(wrong, 0);
+    s_shared->committed = next;
+    s_shared->attempted = next;
+}
+
+//-----------------------------------------------------------------------------
+void TestRandomCuts()
+{
+    std::mt19937 random(20261017);
+    std::uniform_int_distribution<int64_t> cut(0, MAX_CUT_BYTES);
+
+    const uint32_t first = s_shared->committed;
+    const int failedBoots = CutCycles(RANDOM_CUTS, [&](int) { return cut(random); });
+
+    std::printf("storage_journal: %d random cuts, %u of the saves completed\n", RANDOM_CUTS, s_shared->committed - first);
+    HOST_CHECK_EQ(failedBoots, 0);
+    HOST_CHECK(s_shared->committed > first);
+}
+
+//-----------------------------------------------------------------------------
+void TestWear()
+{
+    HOST_CHECK(PowerCycle([](At24c32& eeprom)
+        {
+            StorageService* storage = StorageService::GetInstance();
+            const uint32_t pagesBefore = eeprom.GetPageWrites();
+
+            for (int save = 0; save < WEAR_SAVES; ++save)
+            {
+                HOST_CHECK(storage->Set<int>(FieldId::TDS_MAX, 100 + save));
+            }
+
+            s_shared->pageWrites = eeprom.GetPageWrites() - pagesBefore;
+            s_shared->maxPageWrites = eeprom.GetMaxPageWrites();
+        }
+    ));
+
+    HOST_CHECK(PowerCycle([](At24c32&)
+        {
+            HOST_CHECK_EQ(StorageService::GetInstance()->Get<int>(FieldId::TDS_MAX), 100 + WEAR_SAVES - 1);
+        }
+    ));
+
+    // Pages of the whole journal take turns: no page near one write per save
+    std::printf("storage_journal: %d one-field saves, %u page writes, most worn page %u\n",
+                WEAR_SAVES, s_shared->pageWrites, s_shared->maxPageWrites);
+    HOST_CHECK(s_shared->maxPageWrites < WEAR_SAVES / 4);
+}
+
+//-----------------------------------------------------------------------------
+void TestLegacyJson()
+{
+    const MemoryConfigData legacy = ConfigFor(7777);
+    const std::string json = legacy.ToJson();
+
+    // The image an older firmware left: the JSON document at address 0, null terminated
+    std::string image(At24c32::SIZE_BYTES, '\xFF');
+    image.replace(0, json.size() + 1, json.c_str(), json.size() + 1);
+    WriteImage(image);
+
+    // Converted on the first boot, the record read back on the next
+    HOST_CHECK(PowerCycle([&](At24c32&) { HOST_CHECK(SameConfig(Loaded(), legacy)); }));
+    HOST_CHECK(PowerCycle([&](At24c32& eeprom)
+        {
+            HOST_CHECK(SameConfig(Loaded(), legacy));
+            HOST_CHECK_EQ(eeprom.GetBytesWritten(), 0);
+        }
+    ));
+}
+
+} // namespace
+
+//-----------------------------------------------------------------------------
+int main()
+{
+    const int fd = mkstemp(s_eepromPath);
+    HOST_CHECK(fd >= 0);
+    close(fd);
+    unlink(s_eepromPath);
+
+    void* shared = mmap(nullptr, sizeof(Shared), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    HOST_CHECK(shared != MAP_FAILED);
+    s_shared = new (shared) Shared{};
+
+    TestFirstBoot();
+    TestEveryByte();
+    TestRandomCuts();
+    TestWear();
+    TestLegacyJson();
+
+    unlink(s_eepromPath);
+    return HostTest::Finish("storage_journal_test");
+}
@@ -0,0 +1,209 @@
+/*!****************************************************************************
+ * @file    system_snapshot_test.cpp
+ * @brief   SystemSnapshot behind its Seqlock: readers racing two writers
+ *          that publish different sections never see a torn section or a
+ *          section going back in time. The published clock carries the
+ *          date across midnight, month and year ends.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#include "tests/host_test.h"
+
+#include "esp_timer.h"
+#include "framework/os/seqlock.h"
+#include "src/core/system_snapshot.h"
+#include <atomic>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Core::SystemSnapshot;
+using Utils::DateTime;
+
+static constexpr int READERS = 3;
+static constexpr int PUBLICATIONS = 200000;          //!< Per writer
+
+//-----------------------------------------------------------------------------
+// Every field a writer touches holds the same counter: a torn read shows as
+// fields that disagree
+
+void WriteWater(SystemSnapshot::Water& water, int value)
+{
+    water.tds = value;
+    water.temperature = static_cast<float>(value);
+    for (float& temperature : water.channelTemperatures)
+    {
+        temperature = static_cast<float>(value);
+    }
+    water.temperatureChannelCount = static_cast<size_t>(value % 7);
+}
+
+bool IsWhole(const SystemSnapshot::Water& water)
+{
+    bool whole = (water.temperature == static_cast<float>(water.tds))
+              && (water.temperatureChannelCount == static_cast<size_t>(water.tds % 7));
+    for (float temperature : water.channelTemperatures)
+    {
+        whole = whole && (temperature == static_cast<float>(water.tds));
+    }
+    return whole;
+}
+
+void WriteFeeder(SystemSnapshot::Feeder& feeder, int value)
+{
+    for (auto& entry : feeder.schedule)
+    {
+        entry._min = value;
+        entry._dose = value;
+    }
+    feeder.scheduleCount = static_cast<size_t>(value % SystemSnapshot::MAX_SCHEDULE_ENTRIES);
+    feeder.status.totalPerDay = value;
+}
+
+bool IsWhole(const SystemSnapshot::Feeder& feeder)
+{
+    bool whole = (feeder.scheduleCount == static_cast<size_t>(feeder.status.totalPerDay % SystemSnapshot::MAX_SCHEDULE_ENTRIES));
+    for (const auto& entry : feeder.schedule)
+    {
+        whole = whole && (entry._min == feeder.status.totalPerDay) && (entry._dose == feeder.status.totalPerDay);
+    }
+    return whole;
+}
+
+//-----------------------------------------------------------------------------
+void TestNoTornReads()
+{
+    static Seqlock<SystemSnapshot> snapshot;
+    std::atomic<int> writersRunning{2};
+
+    // A default snapshot is not made of one counter: publish 0 everywhere before the readers start
+    snapshot.Update([](SystemSnapshot& current)
+        {
+            WriteWater(current.water, 0);
+            WriteFeeder(current.feeder, 0);
+        }
+    );
+
+    std::thread waterWriter([&writersRunning]()
+        {
+            for (int i = 1; i <= PUBLICATIONS; ++i)
+            {
+                snapshot.Update([i](SystemSnapshot& current) { WriteWater(current.water, i); });
+            }
+            --writersRunning;
+        }
+    );
+
+    std::thread feederWriter([&writersRunning]()
+        {
+            for (int i = 1; i <= PUBLICATIONS; ++i)
+            {
+                snapshot.Update([i](SystemSnapshot& current) { WriteFeeder(current.feeder, i); });
+            }
+            --writersRunning;
+        }
+    );
+
+    std::atomic<uint64_t> reads{0};
+    std::atomic<uint64_t> torn{0};
+    std::atomic<uint64_t> backwards{0};
+
+    std::vector<std::thread> readers;
+    for (int r = 0; r < READERS; ++r)
+    {
+        readers.emplace_back([&]()
+            {
+                uint32_t lastGeneration = 0;
+                int lastWater = 0;
+                int lastFeeder = 0;
+
+                while (writersRunning > 0)
+                {
+                    SystemSnapshot copy;
+                    const uint32_t generation = snapshot.Read(copy);
+
+                    torn += (!IsWhole(copy.water) || !IsWhole(copy.feeder)) ? 1 : 0;
+                    backwards += (generation < lastGeneration || copy.water.tds < lastWater || copy.feeder.status.totalPerDay < lastFeeder) ? 1 : 0;
+
+                    lastGeneration = generation;
+                    lastWater = copy.water.tds;
+                    lastFeeder = copy.feeder.status.totalPerDay;
+                    ++reads;
+                }
+            }
+        );
+    }
+
+    waterWriter.join();
+    feederWriter.join();
+    for (auto& reader : readers)
+    {
+        reader.join();
+    }
+
+    const SystemSnapshot last = snapshot.Read();
+    std::printf("seqlock: %llu reads of a %zu-byte snapshot, %llu torn, %llu backwards\n",
+                static_cast<unsigned long long>(reads.load()), sizeof(SystemSnapshot),
+                static_cast<unsigned long long>(torn.load()), static_cast<unsigned long long>(backwards.load()));
+
+    HOST_CHECK(reads.load() > 0);
+    HOST_CHECK_EQ(torn.load(), 0);
+    HOST_CHECK_EQ(backwards.load(), 0);
+    HOST_CHECK_EQ(snapshot.GetGeneration(), 2 * PUBLICATIONS + 1);
+    HOST_CHECK_EQ(last.water.tds, PUBLICATIONS);
+    HOST_CHECK_EQ(last.feeder.status.totalPerDay, PUBLICATIONS);
+}
+
+//-----------------------------------------------------------------------------
+//! The clock as FoodFeeder publishes it, read 'elapsedSeconds' later
+DateTime NowAfter(const DateTime& read, int64_t elapsedSeconds)
+{
+    SystemSnapshot::Clock clock;
+    clock.time = read;
+    clock.sampledUs = esp_timer_get_time() - elapsedSeconds * 1000000 - 500000;
+    clock.valid = true;
+    return clock.Now();
+}
+
+bool Is(const DateTime& time, uint16_t year, uint8_t month, uint8_t day, uint8_t hour, uint8_t minute)
+{
+    return time.GetYear() == year && time.GetMonth() == month && time.GetDay() == day
+        && time.GetHour() == hour && time.GetMinute() == minute;
+}
+
+//-----------------------------------------------------------------------------
+void TestClockKeepsTheDate()
+{
+    // Same day
+    HOST_CHECK(Is(NowAfter(DateTime(2026, 10, 17, 8, 0, 0), 90), 2026, 10, 17, 8, 1));
+
+    // Midnight, end of a month, end of a year
+    HOST_CHECK(Is(NowAfter(DateTime(2026, 10, 17, 23, 59, 30), 60), 2026, 10, 18, 0, 0));
+    HOST_CHECK(Is(NowAfter(DateTime(2026, 9, 30, 23, 0, 0), 7200), 2026, 10, 1, 1, 0));
+    HOST_CHECK(Is(NowAfter(DateTime(2026, 12, 31, 23, 59, 30), 90), 2027, 1, 1, 0, 1));
+
+    // February, leap year or not, and several days at once
+    HOST_CHECK(Is(NowAfter(DateTime(2028, 2, 28, 23, 0, 0), 7200), 2028, 2, 29, 1, 0));
+    HOST_CHECK(Is(NowAfter(DateTime(2027, 2, 28, 23, 0, 0), 7200), 2027, 3, 1, 1, 0));
+    HOST_CHECK(Is(NowAfter(DateTime(2026, 10, 17, 12, 0, 0), 3 * 86400 + 60), 2026, 10, 20, 12, 1));
+
+    // Day of week as written to the RTC, and ordering by date first
+    HOST_CHECK_EQ(DateTime(2026, 10, 17, 0, 0, 0).GetDayOfWeek(), 6);
+    HOST_CHECK_EQ(DateTime(2000, 1, 1, 0, 0, 0).GetDayOfWeek(), 6);
+    HOST_CHECK(DateTime(2026, 10, 17, 23, 0, 0) < DateTime(2026, 10, 18, 1, 0, 0));
+    HOST_CHECK(!(DateTime(2026, 10, 17, 8, 0, 0) == DateTime(2026, 10, 18, 8, 0, 0)));
+}
+
+} // namespace
+
+//-----------------------------------------------------------------------------
+int main()
+{
+    TestNoTornReads();
+    TestClockKeepsTheDate();
+
+    return HostTest::Finish("system_snapshot_test");
+}
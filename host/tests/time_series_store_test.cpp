@@ -0,0 +1,290 @@
+/*!****************************************************************************
+ * @file    time_series_store_test.cpp
+ * @brief   TimeSeriesStore against a plain record list over a simulated week
+ *          per case (steady, jittery, random data and long gaps): the raw
+ *          tier decodes the newest records exactly, range queries return the
+ *          same records as a filter of the list, and every minute and hour
+ *          bucket kept matches one computed by hand.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#include "tests/host_test.h"
+
+#include "framework/timeseries/time_series_store.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <limits>
+#include <map>
+#include <random>
+#include <vector>
+
+namespace {
+
+using TimeSeries::Tier;
+
+static constexpr size_t SERIES = 3;
+static constexpr size_t RAW_BYTES = 8192;
+static constexpr size_t MINUTE_BUCKETS = 360;
+static constexpr size_t HOUR_BUCKETS = 168;
+static constexpr uint32_t START = 1790000000;              //!< Oct 2026
+static constexpr uint32_t WEEK_S = 7 * 24 * 3600;
+static constexpr size_t RANGE_QUERIES = 200;
+
+using Store = TimeSeries::TimeSeriesStore<SERIES, RAW_BYTES, MINUTE_BUCKETS, HOUR_BUCKETS>;
+
+struct Record
+{
+    uint32_t timestamp;
+    Store::Values values;
+};
+
+enum class Pattern
+{
+    STEADY,             //!< 2 s period, values that rarely change
+    JITTERY,            //!< 1-3 s period, small noisy deltas
+    RANDOM,             //!< Any step, values anywhere in the bucket range
+    GAPS,               //!< Steady bursts separated by hours without records
+};
+
+static constexpr Pattern PATTERNS[] = { Pattern::STEADY, Pattern::JITTERY, Pattern::RANDOM, Pattern::GAPS };
+static constexpr const char* PATTERN_NAMES[] = { "steady", "jittery", "random", "gaps" };
+
+//-----------------------------------------------------------------------------
+std::vector<Record> Generate(Pattern pattern, std::mt19937& random)
+{
+    std::vector<Record> records;
+    Store::Values values = { 2550, 250, 3900 };
+    uint32_t timestamp = START;
+
+    std::uniform_int_distribution<int> coin(0, 99);
+    std::uniform_int_distribution<int> small(-3, 3);
+    std::uniform_int_distribution<int> any(std::numeric_limits<int16_t>::min(), std::numeric_limits<int16_t>::max());
+
+    while (timestamp < START + WEEK_S)
+    {
+        records.push_back({ timestamp, values });
+
+        switch (pattern)
+        {
+            case Pattern::STEADY:
+                timestamp += 2;
+                values[0] += (coin(random) < 5) ? small(random) : 0;
+                break;
+
+            case Pattern::JITTERY:
+                timestamp += 1 + coin(random) % 3;
+                for (int32_t& value : values)
+                {
+                    value += small(random);
+                }
+                break;
+
+            case Pattern::RANDOM:
+                timestamp += 1 + coin(random) * coin(random) % 600;
+                for (int32_t& value : values)
+                {
+                    value = any(random);
+                }
+                break;
+
+            case Pattern::GAPS:
+                timestamp += (coin(random) == 0) ? 3600 * (1 + coin(random) % 10) : 2;
+                values[1] += (coin(random) < 10) ? small(random) : 0;
+                break;
+        }
+    }
+
+    return records;
+}
+
+//-----------------------------------------------------------------------------
+//! Minute or hour rows as the store computes them, keyed by period start
+std::map<uint32_t, Store::Row> ReferenceRows(const std::vector<Record>& records, uint32_t period)
+{
+    struct Sums { uint32_t count = 0; int64_t sum[SERIES] = {}; int32_t min[SERIES]; int32_t max[SERIES]; };
+    std::map<uint32_t, Sums> sums;
+
+    for (const Record& record : records)
+    {
+        Sums& entry = sums[record.timestamp - record.timestamp % period];
+        for (size_t s = 0; s < SERIES; ++s)
+        {
+            entry.min[s] = (entry.count == 0) ? record.values[s] : std::min(entry.min[s], record.values[s]);
+            entry.max[s] = (entry.count == 0) ? record.values[s] : std::max(entry.max[s], record.values[s]);
+            entry.sum[s] += record.values[s];
+        }
+        ++entry.count;
+    }
+
+    auto clamp16 = [](int64_t value)
+    {
+        return static_cast<int16_t>(std::clamp<int64_t>(value, std::numeric_limits<int16_t>::min(), std::numeric_limits<int16_t>::max()));
+    };
+
+    std::map<uint32_t, Store::Row> rows;
+    for (const auto& [start, entry] : sums)
+    {
+        Store::Row row{};
+        row.start = start;
+        row.count = static_cast<uint16_t>(entry.count);
+        for (size_t s = 0; s < SERIES; ++s)
+        {
+            row.series[s] = { clamp16(entry.min[s]), clamp16(entry.max[s]), clamp16(entry.sum[s] / entry.count) };
+        }
+        rows[start] = row;
+    }
+    return rows;
+}
+
+bool SameRow(const Store::Row& a, const Store::Row& b)
+{
+    bool same = (a.start == b.start) && (a.count == b.count);
+    for (size_t s = 0; s < SERIES; ++s)
+    {
+        same = same && (a.series[s].min == b.series[s].min) && (a.series[s].max == b.series[s].max) && (a.series[s].avg == b.series[s].avg);
+    }
+    return same;
+}
+
+//-----------------------------------------------------------------------------
+void CheckRaw(const Store& store, const std::vector<Record>& records, std::mt19937& random)
+{
+    std::vector<Record> decoded;
+    store.ForEachRaw(0, std::numeric_limits<uint32_t>::max(),
+                     [&decoded](uint32_t timestamp, const Store::Values& values) { decoded.push_back({ timestamp, values }); });
+
+    // The newest records, exactly, as many as the store says it holds
+    HOST_CHECK(!decoded.empty());
+    HOST_CHECK_EQ(decoded.size(), store.GetRawCount());
+    HOST_CHECK(decoded.size() <= records.size());
+
+    const size_t first = records.size() - decoded.size();
+    size_t mismatches = 0;
+    for (size_t i = 0; i < decoded.size(); ++i)
+    {
+        mismatches += (decoded[i].timestamp == records[first + i].timestamp && decoded[i].values == records[first + i].values) ? 0 : 1;
+    }
+    HOST_CHECK_EQ(mismatches, 0);
+
+    // Range queries inside and around the raw tier
+    const uint32_t oldest = decoded.front().timestamp;
+    const uint32_t newest = decoded.back().timestamp;
+    std::uniform_int_distribution<uint32_t> point(oldest - 600, newest + 600);
+
+    size_t badRanges = 0;
+    for (size_t q = 0; q < RANGE_QUERIES; ++q)
+    {
+        uint32_t from = point(random);
+        uint32_t to = point(random);
+        if (from > to)
+        {
+            std::swap(from, to);
+        }
+
+        size_t expected = 0;
+        for (size_t i = 0; i < decoded.size(); ++i)
+        {
+            expected += (decoded[i].timestamp >= from && decoded[i].timestamp <= to) ? 1 : 0;
+        }
+
+        uint32_t previous = 0;
+        bool inRange = true;
+        const size_t visited = store.ForEachRaw(from, to, [&](uint32_t timestamp, const Store::Values&)
+            {
+                inRange = inRange && timestamp >= from && timestamp <= to && timestamp >= previous;
+                previous = timestamp;
+            }
+        );
+        badRanges += (visited == expected && inRange) ? 0 : 1;
+    }
+    HOST_CHECK_EQ(badRanges, 0);
+}
+
+//-----------------------------------------------------------------------------
+void CheckTier(const Store& store, Tier tier, const std::vector<Record>& records, size_t capacity)
+{
+    const std::map<uint32_t, Store::Row> reference = ReferenceRows(records, Store::GetTierPeriod(tier));
+
+    std::vector<Store::Row> rows;
+    store.ForEachBucket(tier, 0, std::numeric_limits<uint32_t>::max(), [&rows](const Store::Row& row) { rows.push_back(row); });
+
+    // The last 'capacity' closed periods and the open one
+    HOST_CHECK_EQ(rows.size(), std::min(reference.size(), capacity + 1));
+    HOST_CHECK(!rows.empty() && store.GetOldestBucketStart(tier) == rows.front().start);
+
+    auto expected = std::prev(reference.end(), static_cast<long>(rows.size()));
+    size_t mismatches = 0;
+    for (const Store::Row& row : rows)
+    {
+        mismatches += SameRow(row, (expected++)->second) ? 0 : 1;
+    }
+    HOST_CHECK_EQ(mismatches, 0);
+
+    // A range picks the rows whose period overlaps it
+    const uint32_t from = rows[rows.size() / 2].start + 1;
+    const uint32_t to = rows.back().start;
+    const size_t visited = store.ForEachBucket(tier, from, to, [](const Store::Row&) {});
+    HOST_CHECK_EQ(visited, rows.size() - rows.size() / 2);
+}
+
+//-----------------------------------------------------------------------------
+void TestPattern(size_t index, std::mt19937& random)
+{
+    static Store store;
+    store.Clear();
+
+    const std::vector<Record> records = Generate(PATTERNS[index], random);
+    for (const Record& record : records)
+    {
+        HOST_CHECK(store.Append(record.timestamp, record.values));
+    }
+
+    // Once the ring has dropped blocks, it is full: bits per record follow
+    std::printf("%-8s %zu records, raw tier keeps %zu", PATTERN_NAMES[index], records.size(), store.GetRawCount());
+    if (store.GetRawCount() < records.size())
+    {
+        std::printf(" (%.1f bits per record)", (RAW_BYTES * 8.0) / store.GetRawCount());
+    }
+    std::printf("\n");
+
+    CheckRaw(store, records, random);
+    CheckTier(store, Tier::MINUTE, records, MINUTE_BUCKETS);
+    CheckTier(store, Tier::HOUR, records, HOUR_BUCKETS);
+}
+
+//-----------------------------------------------------------------------------
+void TestBackwardsAndClear()
+{
+    static Store store;
+
+    HOST_CHECK(store.Append(START, { 1, 2, 3 }));
+    HOST_CHECK(store.Append(START, { 4, 5, 6 }));
+    HOST_CHECK(!store.Append(START - 1, { 7, 8, 9 }));
+    HOST_CHECK_EQ(store.GetRawCount(), 2);
+
+    store.Clear();
+    HOST_CHECK_EQ(store.GetRawCount(), 0);
+    HOST_CHECK_EQ(store.ForEachBucket(Tier::MINUTE, 0, std::numeric_limits<uint32_t>::max(), [](const Store::Row&) {}), 0);
+    HOST_CHECK_EQ(store.GetOldestBucketStart(Tier::HOUR), 0);
+
+    // After a clear any timestamp is accepted again
+    HOST_CHECK(store.Append(START - 1, { 7, 8, 9 }));
+}
+
+} // namespace
+
+//-----------------------------------------------------------------------------
+int main()
+{
+    std::mt19937 random(20261017);
+
+    for (size_t i = 0; i < sizeof(PATTERNS) / sizeof(PATTERNS[0]); ++i)
+    {
+        TestPattern(i, random);
+    }
+    TestBackwardsAndClear();
+
+    return HostTest::Finish("time_series_store_test");
+}
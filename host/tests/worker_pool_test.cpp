@@ -0,0 +1,224 @@
+/*!****************************************************************************
+ * @file    worker_pool_test.cpp
+ * @brief   AsyncWorkerPool: priority then FIFO dispatch, bounded queue,
+ *          cancellation and completion callbacks, then a benchmark of
+ *          thousands of jobs that reports dispatch latency and checks that
+ *          dispatching a job does not touch the heap.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#include "tests/host_test.h"
+
+#include "esp_timer.h"
+#include "framework/os/async_worker_pool.h"
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <mutex>
+#include <new>
+#include <string>
+#include <thread>
+
+//-----------------------------------------------------------------------------
+// Heap allocations made by any thread while counting is on
+
+static std::atomic<bool> s_countAllocations{false};
+static std::atomic<uint64_t> s_allocations{0};
+
+void* operator new(size_t size)
+{
+    if (s_countAllocations.load(std::memory_order_relaxed))
+    {
+        s_allocations.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    if (void* block = std::malloc(size != 0 ? size : 1))
+    {
+        return block;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* block) noexcept { std::free(block); }
+void operator delete(void* block, size_t) noexcept { std::free(block); }
+
+namespace {
+
+//-----------------------------------------------------------------------------
+template <typename Predicate>
+bool WaitFor(Predicate predicate, int timeoutMs = 5000)
+{
+    const auto end = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+    while (!predicate())
+    {
+        if (std::chrono::steady_clock::now() > end)
+        {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+void TestPriorityAndCancel()
+{
+    AsyncWorkerPool pool({ "order", 1, 5, 2048, 5, tskNO_AFFINITY });
+    HOST_CHECK(pool.Start());
+
+    // Hold the only worker so the next jobs queue up
+    std::atomic<bool> release{false};
+    std::atomic<bool> gateRunning{false};
+    pool.Submit([&](const AsyncWorkerPool::JobContext&)
+        {
+            gateRunning = true;
+            while (!release)
+            {
+                std::this_thread::sleep_for(std::chrono::microseconds(100));
+            }
+        });
+    HOST_CHECK(WaitFor([&] { return gateRunning.load(); }));
+
+    std::mutex orderMutex;
+    std::string order;
+    std::atomic<int> done{0};
+    std::atomic<int> cancelledCallbacks{0};
+    auto job = [&](char name)
+    {
+        return [&, name](const AsyncWorkerPool::JobContext&)
+        {
+            std::lock_guard<std::mutex> lock(orderMutex);
+            order += name;
+        };
+    };
+    auto onDone = [&](AsyncWorkerPool::JobId, AsyncWorkerPool::JobStatus status)
+    {
+        if (status == AsyncWorkerPool::JobStatus::COMPLETED)
+        {
+            ++done;
+        }
+        else if (status == AsyncWorkerPool::JobStatus::CANCELLED)
+        {
+            ++cancelledCallbacks;
+        }
+    };
+
+    using Priority = AsyncWorkerPool::Priority;
+    pool.Submit(job('a'), Priority::BACKGROUND, onDone);
+    pool.Submit(job('b'), Priority::NORMAL, onDone);
+    const auto cancelled = pool.Submit(job('x'), Priority::URGENT, onDone);
+    pool.Submit(job('c'), Priority::URGENT, onDone);
+    pool.Submit(job('d'), Priority::NORMAL, onDone);
+
+    // Five waiting: the queue is full
+    HOST_CHECK_EQ(pool.Submit(job('y')), AsyncWorkerPool::INVALID_JOB);
+    HOST_CHECK_EQ(pool.GetPendingCount(), 6u);
+
+    // A queued job is dropped at once and its callback told so
+    HOST_CHECK(pool.Cancel(cancelled));
+    HOST_CHECK_EQ(cancelledCallbacks.load(), 1);
+
+    release = true;
+    HOST_CHECK(WaitFor([&] { return done.load() == 4; }));
+    HOST_CHECK(WaitFor([&] { return pool.IsIdle(); }));
+
+    // Highest priority first, FIFO within a priority, the cancelled job never ran
+    HOST_CHECK(order == "cbda");
+
+    const AsyncWorkerPool::Stats stats = pool.GetStats();
+    HOST_CHECK_EQ(stats.submitted, 6u);
+    HOST_CHECK_EQ(stats.rejected, 1u);
+    HOST_CHECK_EQ(stats.cancelled, 1u);
+    HOST_CHECK_EQ(stats.completed, 5u);
+    HOST_CHECK_EQ(stats.maxQueued, 5u);
+}
+
+//-----------------------------------------------------------------------------
+void TestCooperativeCancel()
+{
+    AsyncWorkerPool pool({ "cancel", 1, 2, 2048, 5, tskNO_AFFINITY });
+    HOST_CHECK(pool.Start());
+
+    std::atomic<bool> started{false};
+    std::atomic<bool> sawCancel{false};
+    const auto id = pool.Submit([&](const AsyncWorkerPool::JobContext& context)
+        {
+            started = true;
+            while (!context.IsCancelRequested())
+            {
+                std::this_thread::sleep_for(std::chrono::microseconds(100));
+            }
+            sawCancel = true;
+        });
+
+    HOST_CHECK(WaitFor([&] { return started.load(); }));
+    HOST_CHECK(pool.Cancel(id));
+    HOST_CHECK(WaitFor([&] { return sawCancel.load(); }));
+    HOST_CHECK(WaitFor([&] { return pool.IsIdle(); }));
+    HOST_CHECK(!pool.Cancel(id));
+}
+
+//-----------------------------------------------------------------------------
+void BenchmarkDispatch()
+{
+    static constexpr int JOBS = 20000;
+
+    AsyncWorkerPool pool({ "bench", 2, 8, 2048, 5, tskNO_AFFINITY });
+    HOST_CHECK(pool.Start());
+
+    std::atomic<int> ran{0};
+    int rejected = 0;
+
+    // The override is the one in use: a real allocation is counted
+    s_allocations = 0;
+    s_countAllocations = true;
+    {
+        std::string probe(64, 'x');
+        asm volatile("" : : "r"(probe.data()) : "memory");
+    }
+    HOST_CHECK_EQ(s_allocations.load(), 1u);
+
+    s_allocations = 0;
+    const int64_t startUs = esp_timer_get_time();
+
+    for (int i = 0; i < JOBS; ++i)
+    {
+        // Small captures fit the std::function buffer, so a job is copied into its slot as is
+        while (pool.Submit([&ran](const AsyncWorkerPool::JobContext&) { ++ran; },
+                           (i % 3 == 0) ? AsyncWorkerPool::Priority::URGENT : AsyncWorkerPool::Priority::NORMAL)
+               == AsyncWorkerPool::INVALID_JOB)
+        {
+            ++rejected;
+            std::this_thread::yield();
+        }
+    }
+
+    HOST_CHECK(WaitFor([&] { return ran.load() == JOBS && pool.IsIdle(); }, 30000));
+
+    const int64_t elapsedUs = esp_timer_get_time() - startUs;
+    s_countAllocations = false;
+
+    const AsyncWorkerPool::Stats stats = pool.GetStats();
+    HOST_CHECK_EQ(stats.completed, static_cast<uint32_t>(JOBS));
+    HOST_CHECK_EQ(s_allocations.load(), 0u);
+
+    std::printf("%d jobs on 2 workers: %.2f us per job, dispatch latency avg %.1f us max %llu us, "
+                "%d retries on a full queue, %llu heap allocations\n",
+                JOBS, static_cast<double>(elapsedUs) / JOBS,
+                static_cast<double>(stats.totalDispatchLatencyUs) / stats.completed,
+                static_cast<unsigned long long>(stats.maxDispatchLatencyUs), rejected,
+                static_cast<unsigned long long>(s_allocations.load()));
+}
+
+} // namespace
+
+//-----------------------------------------------------------------------------
+int main()
+{
+    TestPriorityAndCancel();
+    TestCooperativeCancel();
+    BenchmarkDispatch();
+
+    return HostTest::Finish("worker_pool_test");
+}
@@ -9,18 +9,104 @@
 #define CONFIG_H
 
 #include "framework/pin_names.h"
+#include <cstddef>
+#include <cstdint>
 
 static constexpr int INVALID = -1;
 
 namespace Config {
 
-// Definition of time increment used for system delays and updates
-// This value is used to control the frequency of updates in the system
-static constexpr int SYSTEM_TIME_INCREMENT_MS = 5000;
+// Scheduling of the managers (see framework/os/scheduler.h)
+// Period bounds the worst-case staleness, deadline bounds the execution time of one update
+static constexpr uint32_t WATER_MONITOR_PERIOD_MS = 2000;
+static constexpr uint32_t WATER_MONITOR_DEADLINE_MS = 1500;
+
+static constexpr uint32_t FOOD_FEEDER_PERIOD_MS = 5000;
+static constexpr uint32_t FOOD_FEEDER_DEADLINE_MS = 500;
+
+static constexpr uint32_t USER_INTERFACE_PERIOD_MS = 5000;
+static constexpr uint32_t USER_INTERFACE_DEADLINE_MS = 500;
+
+static constexpr uint32_t NETWORK_CONTROLLER_PERIOD_MS = 100;
+static constexpr uint32_t NETWORK_CONTROLLER_DEADLINE_MS = 100;
+
+// Boot sequencing (see src/core/boot_orchestrator.h)
+// Steps starting together must fit the inrush budget; each one holds its share until
+// the supply voltage is stable again. Inrush figures are estimates from the part datasheets
+static constexpr uint32_t BOOT_INRUSH_BUDGET_MA = 600;
+static constexpr uint32_t DISPLAY_INRUSH_MA = 250;          // Backlight + panel power-on
+static constexpr uint32_t WIFI_INRUSH_MA = 300;             // RF calibration at station start
+static constexpr uint32_t SERVO_INRUSH_MA = 450;            // Servo stall current while it homes
+static constexpr uint32_t BOOT_SETTLE_POLL_MS = 10;
+static constexpr float BOOT_SUPPLY_SETTLE_TOLERANCE_V = 0.03f;
+static constexpr uint32_t BOOT_SUPPLY_STABLE_SAMPLES = 3;   // Consecutive readings within tolerance
+static constexpr uint32_t BOOT_STEP_STACK_SIZE = 8192;
+
+// Background ADC sampling (see src/services/adc_sampler.h)
+// 20 kHz is the lowest rate of the ESP32 continuous ADC. With the TDS and battery
+// channels a frame holds ADC_OVERSAMPLING conversions of each: one decimated value per frame
+static constexpr uint32_t ADC_SAMPLE_RATE_HZ = 20000;
+static constexpr uint32_t ADC_FRAME_BYTES = 256;            // 128 conversions, 6.4 ms
+static constexpr uint32_t ADC_STORE_BYTES = 1024;           // Driver ring buffer, 4 frames
+static constexpr uint32_t ADC_OVERSAMPLING = 64;            // Conversions averaged per decimated value
+static constexpr uint32_t ADC_SAMPLER_STACK_SIZE = 3072;
+static constexpr uint32_t ADC_SAMPLER_PRIORITY = 6;
+
+// In-RAM history of the readings (see src/services/reading_history.h)
+// The raw ring keeps at least the last hour at the 2 s sample rate up to ~32 bits per
+// record (a few bits on a steady tank, so usually several hours)
+static constexpr size_t HISTORY_RAW_BYTES = 8192;
+static constexpr size_t HISTORY_MINUTE_BUCKETS = 360;       // 6 h of minute min/max/avg
+static constexpr size_t HISTORY_HOUR_BUCKETS = 168;         // 7 days of hour min/max/avg
+static constexpr uint32_t HISTORY_MIN_VALID_TIMESTAMP = 1704067200;    // 2024-01-01: older means the clock was never set
+
+// Flash history log on the spiffs partition (see src/services/history_log.h)
+// One sample a minute: a 4 KB segment holds 6 h of samples or ~4 days of hourly aggregates.
+// 128 KB keep ~6 days of minute samples and ~3 weeks of hourly aggregates
+static constexpr uint32_t HISTORY_LOG_SAMPLE_PERIOD_S = 60;
+static constexpr size_t HISTORY_LOG_HOURLY_SEGMENTS = 6;    // Hourly segments kept before the oldest is dropped
+static constexpr size_t HISTORY_LOG_FREE_SEGMENTS = 2;      // Compact in the background below this many erased segments
+static constexpr uint32_t HISTORY_LOG_STACK_SIZE = 4096;
+static constexpr uint32_t HISTORY_LOG_PRIORITY = 2;
+
+// Early warnings on the readings (see src/managers/water_monitor.h)
+// Rates are fitted over the last 10 min of readings and judged once 5 min are in;
+// the sensitivities themselves are settings (see memory_config_data.h)
+static constexpr size_t TREND_WINDOW_SAMPLES = 300;         // At WATER_MONITOR_PERIOD_MS
+static constexpr size_t TREND_MIN_SAMPLES = 150;
+static constexpr size_t SPIKE_MIN_SAMPLES = 30;
+
+// getHistory RPC (see src/services/history_query.h): points per MQTT message
+static constexpr size_t HISTORY_RPC_CHUNK_POINTS = 32;
+
+// getTrace RPC (see src/managers/comms/rpc_handler.h): events per MQTT message.
+// Each event is ~300 B of Json nodes in the request arena while its message is built
+static constexpr size_t TRACE_RPC_CHUNK_EVENTS = 8;
+
+// Config saves (see src/services/storage_service.h)
+// With a write-behind window the changes of a burst (e.g. a dashboard slider sending one
+// RPC per step) share one save, at the cost of losing them on a power cut within the window.
+// 0 saves every change (or transaction) before it returns
+static constexpr uint32_t STORAGE_WRITE_BEHIND_MS = 0;
+static constexpr uint32_t STORAGE_FLUSH_STACK_SIZE = 3072;
+static constexpr uint32_t STORAGE_FLUSH_PRIORITY = 2;
+
+// Scratch arenas reset after every request (see framework/memory/arena.h)
+static constexpr size_t NETWORK_ARENA_SIZE = 8192;
+static constexpr size_t STORAGE_ARENA_SIZE = 4096;
+
+// Incoming MQTT messages wait for the manager task in pool blocks (see src/connectivity/mqtt_client.h).
+// RPC requests are a few hundred bytes at most; larger messages are dropped
+static constexpr size_t MQTT_PAYLOAD_BLOCK_SIZE = 512;
+static constexpr size_t MQTT_PAYLOAD_BLOCKS = 4;
+static constexpr size_t MQTT_TOPIC_MAX_LENGTH = 64;
 
 // Interval for sending telemetry data to the MQTT broker
 static constexpr int TELEMETRY_SEND_INTERVAL_MS = 60000;
 
+// Add p99 update latency and overruns of every budgeted module to the telemetry
+static constexpr bool TELEMETRY_PERF_STATS_ENABLED = false;
+
 // Pin definitions for the Smart Aquarium Guardian
 // These pins are used for various sensors and controls in the aquarium system
 static constexpr PinName TDS_SENSOR_ADC_PIN = PinName::A6;
@@ -43,6 +129,8 @@ static constexpr PinName I2C_SDA_PIN = PinName::P21;
 static constexpr PinName I2C_SCL_PIN = PinName::P22;
 
 static constexpr uint8_t EEPROM_I2C_ADDRESS = 0x50;
+static constexpr uint32_t EEPROM_I2C_FREQ_HZ = 400000;      // AT24C32 fast mode (2.7 V and up)
+static constexpr uint32_t EEPROM_WRITE_TIMEOUT_MS = 20;     // Write cycle: 10 ms max per datasheet
 static constexpr uint8_t RTC_I2C_ADDRESS = 0x68; // DS3231 / DS1307
 
 static constexpr PinName BATTERY_ADC_PIN = PinName::A7;
@@ -20689,7 +20689,8 @@ class basic_json // NOLINT(cppcoreguidelines-special-member-functions,hicpp-spec
             if (t == value_t::array || t == value_t::object)
             {
                 // flatten the current json_value to a heap-allocated stack
-                std::vector<basic_json> stack;
+                // (SmartAquariumGuardian: with the json's allocator, so an ArenaJson is torn down in its arena)
+                std::vector<basic_json, AllocatorType<basic_json>> stack;
 
                 // move the top-level items to stack
                 if (t == value_t::array)
@@ -0,0 +1,193 @@
+#!/usr/bin/env python3
+"""
+Decodes the binary deferred log (DeferredLog::OutputMode::BINARY) back into
+ESP_LOG-style text. The "LOGB <hex>" records carry the addresses of the tag
+and format strings; they are read from the firmware ELF. The "LOGB_BASE"
+line holds the runtime address of core_log_anchor so position-independent
+builds (the host executable) can be relocated. Other lines pass through.
+
+    idf.py monitor | python3 scripts/decode_log.py build/SmartAquariumGuardian.elf
+    ./build-host/guardian_host --binary-log | python3 scripts/decode_log.py build-host/guardian_host
+"""
+
+import argparse
+import re
+import struct
+import sys
+
+ANCHOR_SYMBOL = "core_log_anchor"
+
+ARG_INT32, ARG_UINT32, ARG_INT64, ARG_UINT64, ARG_DOUBLE, ARG_POINTER, ARG_STRING = range(7)
+NULL_STRING = 0xFFFF
+TASK_NAME_SIZE = 16
+HEADER = struct.Struct("<BBHIQQ%ds" % TASK_NAME_SIZE)
+
+LEVEL_LETTERS = {1: "E", 2: "W", 3: "I", 4: "D"}
+CONVERSION = re.compile(r"%([-+ #0]*)(\*|\d+)?(?:\.(\*|\d+))?(hh|h|ll|l|z|j|t|L)?([diouxXcfFeEgGaAsp%])")
+
+
+class Elf:
+    """
+    Minimal ELF32/ELF64 little-endian reader: loadable segments and the symbol table.
+    """
+
+    def __init__(self, path):
+        with open(path, "rb") as stream:
+            self.data = stream.read()
+
+        if self.data[:4] != b"\x7fELF" or self.data[5] != 1:
+            raise ValueError(f"{path}: not a little-endian ELF file")
+
+        self.is64 = self.data[4] == 2
+        if self.is64:
+            (self.phoff, self.shoff) = struct.unpack_from("<QQ", self.data, 0x20)
+            (self.phentsize, self.phnum, self.shentsize, self.shnum) = struct.unpack_from("<HHHH", self.data, 0x36)
+        else:
+            (self.phoff, self.shoff) = struct.unpack_from("<II", self.data, 0x1C)
+            (self.phentsize, self.phnum, self.shentsize, self.shnum) = struct.unpack_from("<HHHH", self.data, 0x2A)
+
+        self.segments = []
+        for i in range(self.phnum):
+            offset = self.phoff + i * self.phentsize
+            if self.is64:
+                p_type, _, p_offset, p_vaddr, _, p_filesz = struct.unpack_from("<IIQQQQ", self.data, offset)
+            else:
+                p_type, p_offset, p_vaddr, _, p_filesz = struct.unpack_from("<IIIII", self.data, offset)
+            if p_type == 1:     # PT_LOAD
+                self.segments.append((p_vaddr, p_offset, p_filesz))
+
+    def sections(self):
+        for i in range(self.shnum):
+            offset = self.shoff + i * self.shentsize
+            if self.is64:
+                _, sh_type, _, _, sh_offset, sh_size, sh_link, _, _, sh_entsize = struct.unpack_from("<IIQQQQIIQQ", self.data, offset)
+            else:
+                _, sh_type, _, _, sh_offset, sh_size, sh_link, _, _, sh_entsize = struct.unpack_from("<IIIIIIIIII", self.data, offset)
+            yield sh_type, sh_offset, sh_size, sh_link, sh_entsize
+
+    def symbol(self, name):
+        sections = list(self.sections())
+        for sh_type, sh_offset, sh_size, sh_link, sh_entsize in sections:
+            if sh_type != 2 or sh_entsize == 0:      # SHT_SYMTAB
+                continue
+            strtab_offset = sections[sh_link][1]
+            for entry in range(sh_offset, sh_offset + sh_size, sh_entsize):
+                if self.is64:
+                    st_name, _, _, _, st_value = struct.unpack_from("<IBBHQ", self.data, entry)
+                else:
+                    st_name, st_value = struct.unpack_from("<II", self.data, entry)
+                end = self.data.index(b"\0", strtab_offset + st_name)
+                if self.data[strtab_offset + st_name:end].decode(errors="replace") == name:
+                    return st_value
+        return None
+
+    def string(self, address):
+        for vaddr, offset, size in self.segments:
+            if vaddr <= address < vaddr + size:
+                start = offset + (address - vaddr)
+                end = self.data.index(b"\0", start)
+                return self.data[start:end].decode(errors="replace")
+        return f"<0x{address:x}>"
+
+
+def decode_args(payload, count):
+    args = []
+    pos = 0
+    while len(args) < count and pos < len(payload):
+        arg_type = payload[pos]
+        pos += 1
+        if arg_type in (ARG_INT32, ARG_UINT32):
+            args.append(struct.unpack_from("<i" if arg_type == ARG_INT32 else "<I", payload, pos)[0])
+            pos += 4
+        elif arg_type in (ARG_INT64, ARG_UINT64, ARG_POINTER):
+            args.append(struct.unpack_from("<q" if arg_type == ARG_INT64 else "<Q", payload, pos)[0])
+            pos += 8
+        elif arg_type == ARG_DOUBLE:
+            args.append(struct.unpack_from("<d", payload, pos)[0])
+            pos += 8
+        elif arg_type == ARG_STRING:
+            length = struct.unpack_from("<H", payload, pos)[0]
+            pos += 2
+            if length == NULL_STRING:
+                args.append(None)
+            else:
+                args.append(payload[pos:pos + length].decode(errors="replace"))
+                pos += length
+        else:
+            break
+    return args
+
+
+def render(fmt, args):
+    """
+    printf with Python's % operator, one conversion at a time.
+    """
+    args = list(args)
+
+    def substitute(match):
+        flags, width, precision, length, conversion = match.groups()
+        if conversion == "%":
+            return "%"
+        if width == "*":
+            width = str(args.pop(0)) if args else ""
+        if precision == "*":
+            precision = str(args.pop(0)) if args else ""
+        if not args:
+            return match.group(0)
+
+        value = args.pop(0)
+        spec = "%" + flags + (width or "") + ("." + precision if precision else "")
+
+        if conversion == "s":
+            return (spec + "s") % ("(null)" if value is None else value)
+        if conversion == "p":
+            return "0x%x" % value
+        if conversion == "u":
+            conversion = "d"
+        if conversion == "c":
+            return (spec + "c") % chr(value & 0xFF)
+        if conversion in "diouxX":
+            if conversion in "ouxX" and value < 0:
+                bits = 64 if length in ("ll", "j") else 32
+                value &= (1 << bits) - 1
+            return (spec + conversion) % int(value)
+        return (spec + conversion) % float(value)
+
+    return CONVERSION.sub(substitute, fmt)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Decode LOGB binary log records")
+    parser.add_argument("elf", help="Firmware ELF (or host executable) that produced the log")
+    parser.add_argument("inputs", nargs="*", help="Captured logs (default: stdin)")
+    args = parser.parse_args()
+
+    elf = Elf(args.elf)
+    anchor = elf.symbol(ANCHOR_SYMBOL)
+    if anchor is None:
+        sys.exit(f"[ERROR] {ANCHOR_SYMBOL} not found in {args.elf}")
+
+    slide = 0
+    streams = [open(path, encoding="utf-8", errors="replace") for path in args.inputs] or [sys.stdin]
+
+    for stream in streams:
+        for line in stream:
+            if line.startswith("LOGB_BASE "):
+                slide = int(line.split()[1], 16) - anchor
+                continue
+
+            if not line.startswith("LOGB "):
+                sys.stdout.write(line)
+                continue
+
+            record = bytes.fromhex(line[5:].strip())
+            level, count, _, timestamp, tag, fmt, task = HEADER.unpack_from(record)
+            values = decode_args(record[HEADER.size:], count)
+
+            text = render(elf.string(fmt - slide), values)
+            task_name = task.split(b"\0", 1)[0].decode(errors="replace")
+            print(f"{LEVEL_LETTERS.get(level, 'V')} ({timestamp}) {elf.string(tag - slide)}: [{task_name}] {text}")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,127 @@
+#!/usr/bin/env python3
+"""
+Converts Smart Aquarium Guardian trace dumps to Chrome trace JSON
+(open with https://ui.perfetto.dev or chrome://tracing).
+
+Input is any text containing the "TRACE<TAB>us<TAB>B|E<TAB>core<TAB>task<TAB>name"
+lines written by Trace::Dump() / Trace::FormatEvent() (a UART capture or a
+guardian_host --trace file), or the getTrace RPC response messages, one JSON
+object per line.
+
+    python3 scripts/trace_to_chrome.py uart.log -o trace.json
+"""
+
+import argparse
+import json
+import sys
+
+
+def parse_rpc_message(line):
+    """
+    Returns the events and dropped count of a getTrace response message, None for other lines.
+    """
+    start = line.find("{")
+    if start < 0 or '"events"' not in line:
+        return None
+
+    try:
+        message = json.loads(line[start:])
+    except json.JSONDecodeError:
+        return None
+
+    events = [{"ts": int(us), "ph": phase, "core": int(core), "task": task, "name": name}
+              for us, phase, core, task, name in message.get("events", [])]
+    return events, int(message.get("dropped", 0))
+
+
+def parse_events(text):
+    """
+    Returns the trace events found in text and the dropped-event count.
+    """
+    events = []
+    dropped = 0
+
+    for line in text.splitlines():
+        rpc = parse_rpc_message(line)
+        if rpc is not None:
+            events.extend(rpc[0])
+            dropped = max(dropped, rpc[1])
+            continue
+
+        start = line.find("TRACE")
+        if start < 0:
+            continue
+
+        fields = line[start:].split("\t")
+
+        if fields[0] == "TRACE_DROPPED" and len(fields) >= 2:
+            dropped = max(dropped, int(fields[1]))
+        elif fields[0] == "TRACE" and len(fields) >= 6 and fields[2] in ("B", "E"):
+            events.append({
+                "ts": int(fields[1]),
+                "ph": fields[2],
+                "core": int(fields[3]),
+                "task": fields[4],
+                "name": fields[5].strip(),
+            })
+
+    # Each core's ring is drained in order; merge cores by timestamp
+    events.sort(key=lambda event: event["ts"])
+    return events, dropped
+
+
+def to_chrome_trace(events):
+    """
+    One thread per task. Tasks that are not pinned can move between cores,
+    so the core goes in the event args instead of the pid.
+    """
+    thread_ids = {}
+    trace_events = []
+
+    for event in events:
+        tid = thread_ids.setdefault(event["task"], len(thread_ids) + 1)
+        trace_events.append({
+            "name": event["name"],
+            "ph": event["ph"],
+            "ts": event["ts"],
+            "pid": 1,
+            "tid": tid,
+            "args": {"core": event["core"]},
+        })
+
+    for task, tid in thread_ids.items():
+        trace_events.append({"name": "thread_name", "ph": "M", "pid": 1, "tid": tid, "args": {"name": task}})
+
+    trace_events.append({"name": "process_name", "ph": "M", "pid": 1, "args": {"name": "SmartAquariumGuardian"}})
+
+    return {"traceEvents": trace_events, "displayTimeUnit": "ms"}
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Convert trace dumps to Chrome trace JSON")
+    parser.add_argument("inputs", nargs="*", help="Dump files (default: stdin)")
+    parser.add_argument("-o", "--output", help="Output file (default: stdout)")
+    args = parser.parse_args()
+
+    if args.inputs:
+        text = ""
+        for path in args.inputs:
+            with open(path, encoding="utf-8", errors="replace") as stream:
+                text += stream.read() + "\n"
+    else:
+        text = sys.stdin.read()
+
+    events, dropped = parse_events(text)
+    trace = to_chrome_trace(events)
+
+    if args.output:
+        with open(args.output, "w", encoding="utf-8") as stream:
+            json.dump(trace, stream)
+    else:
+        json.dump(trace, sys.stdout)
+
+    print(f"[Trace] {len(events)} events, {dropped} dropped on the device", file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
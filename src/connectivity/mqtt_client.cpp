@@ -9,6 +9,7 @@
 
 #include "esp_log.h"
 #include "esp_system.h"
+#include "framework/os/trace.h"
 #include "include/config.h"
 #include <cstring>
 
@@ -28,6 +29,8 @@ bool MqttClient::OnInit()
 //----private------------------------------------------------------------------
 void MqttClient::OnUpdate()
 {
+    ProcessEvents();
+
     switch (_state)
     {
         case State::IDLE:
@@ -108,8 +111,10 @@ void MqttClient::Stop()
 }
 
 //-----------------------------------------------------------------------------
-bool MqttClient::Publish(const std::string &topic, const std::string &payload, int qos)
+bool MqttClient::Publish(const char* topic, std::string_view payload, int qos)
 {
+    CORE_TRACE_SCOPE("MqttPublish");
+
     if (!_client) 
     {
         return false;
@@ -117,14 +122,14 @@ bool MqttClient::Publish(const std::string &topic, const std::string &payload, i
 
     int msg_id = esp_mqtt_client_publish(
         _client, 
-        topic.c_str(),
-        payload.c_str(),
-        payload.size(),
+        topic,
+        payload.data(),
+        static_cast<int>(payload.size()),
         qos,
         0
     );
 
-    CORE_INFO("Published message to topic '%s' \n with payload \n'%s'", topic.c_str(), payload.c_str());
+    CORE_INFO("Published message to topic '%s' \n with payload \n'%.*s'", topic, static_cast<int>(payload.size()), payload.data());
 
     return (msg_id >= 0);
 }
@@ -158,6 +163,51 @@ void MqttClient::SetMessageCallback(MessageCallback cb)
     _globalCallback = cb;
 }
 
+//----private------------------------------------------------------------------
+void MqttClient::ProcessEvents()
+{
+    const uint32_t dropped = _droppedEvents.exchange(0);
+    if (dropped > 0)
+    {
+        CORE_WARNING("MqttClient: %u events dropped (queue or payload pool full, or message too large)", static_cast<unsigned>(dropped));
+    }
+
+    Event event;
+    while (_events.TryPop(event))
+    {
+        switch (event.type)
+        {
+            case Event::Type::CONNECTED:
+            {
+                CORE_INFO("MqttClient: connected");
+                _connected = true;
+            }
+            break;
+
+            case Event::Type::DISCONNECTED:
+            {
+                CORE_WARNING("MqttClient: disconnected");
+                _connected = false;
+                _state = State::IDLE;
+            }
+            break;
+
+            case Event::Type::DATA:
+            {
+                if (_globalCallback) 
+                {
+                    _globalCallback(std::string_view(event.topic, event.topicLength),
+                                    std::string_view(reinterpret_cast<const char*>(event.payload.Data()), event.payloadLength));
+                }
+
+                // Back to the pool before the next event is handled
+                event.payload = PayloadPool::Block();
+            }
+            break;
+        }
+    }
+}
+
 //----private------------------------------------------------------------------
 auto MqttClient::_Start() -> State
 {
@@ -219,40 +269,59 @@ void MqttClient::EventHandler(
     MqttClient* instance = MqttClient::GetInstance();
     esp_mqtt_event_handle_t event = static_cast<esp_mqtt_event_handle_t>(event_data);
 
+    Event message;
+
     switch (event->event_id)
     {
         case MQTT_EVENT_CONNECTED:
         {
-            CORE_INFO("MqttClient: connected");
-            instance->_connected = true;
+            message.type = Event::Type::CONNECTED;
         }
         break;
 
         case MQTT_EVENT_DISCONNECTED:
         {
-            CORE_WARNING("MqttClient: disconnected");
-            instance->_connected = false;
-            instance->_state = State::IDLE;
+            message.type = Event::Type::DISCONNECTED;
         }
         break;
 
         case MQTT_EVENT_DATA:
         {
-            std::string topic(event->topic, event->topic_len);
-            std::string payload(event->data, event->data_len);
+            // Messages larger than the esp-mqtt buffer arrive in parts: not expected for RPCs
+            const size_t topicLength = static_cast<size_t>(event->topic_len);
+            const size_t payloadLength = static_cast<size_t>(event->data_len);
+            if (topicLength >= sizeof(message.topic) || payloadLength > PayloadPool::Block::Size()
+             || event->data_len != event->total_data_len)
+            {
+                ++instance->_droppedEvents;
+                return;
+            }
 
-            if (instance->_globalCallback) 
+            message.payload = instance->_payloads.Acquire();
+            if (!message.payload)
             {
-                instance->_globalCallback(topic, payload);
+                ++instance->_droppedEvents;
+                return;
             }
+
+            message.type = Event::Type::DATA;
+            std::memcpy(message.topic, event->topic, topicLength);
+            message.topicLength = topicLength;
+            std::memcpy(message.payload.Data(), event->data, payloadLength);
+            message.payloadLength = payloadLength;
         }
         break;
 
         default:
         {
             // Do nothing
+            return;
         }
-        break;
+    }
+
+    if (!instance->_events.TryPush(std::move(message)))
+    {
+        ++instance->_droppedEvents;
     }
 }
 
@@ -261,6 +330,7 @@ MqttClient::MqttClient()
     : _client(nullptr)
     , _connected(false)
     , _globalCallback(nullptr)
+    , _droppedEvents(0)
 {}
 
 //----private------------------------------------------------------------------
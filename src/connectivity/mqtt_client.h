@@ -9,11 +9,15 @@
 #define MQTT_CLIENT_H
 
 #include "framework/common_defs.h"
+#include "framework/memory/block_pool.h"
+#include "framework/os/ring_buffer.h"
+#include "include/config.h"
 #include "src/core/base/driver.h"
 #include <atomic>
 #include <functional>
 #include <mqtt_client.h>
 #include <string>
+#include <string_view>
 
 namespace Connectivity {
 
@@ -32,7 +36,8 @@ class MqttClient : public Base::Singleton<MqttClient>,
             ERROR
         };
 
-        using MessageCallback = std::function<void(const std::string &topic, const std::string &payload)>;
+        //! Topic and payload are only valid during the call
+        using MessageCallback = std::function<void(std::string_view topic, std::string_view payload)>;
 
         /*!
         * @brief Check if connected to the MQTT broker
@@ -52,12 +57,12 @@ class MqttClient : public Base::Singleton<MqttClient>,
 
         /*!
         * @brief Publish a message to a topic
-        * @param topic     Topic to publish to.
-        * @param payload   Message payload.
+        * @param topic     Topic to publish to (null-terminated).
+        * @param payload   Message payload. Copied by the client, may live in a request arena.
         * @param qos       Quality of Service level (0, 1, or 2). Default is 1.
         * @return true if publish was successful, false otherwise
         */
-        bool Publish(const std::string &topic, const std::string &payload, int qos = 1);
+        bool Publish(const char* topic, std::string_view payload, int qos = 1);
 
         /*!
         * @brief Subscribe to a topic with an optional message callback
@@ -98,6 +103,35 @@ class MqttClient : public Base::Singleton<MqttClient>,
         
     private:
 
+        static constexpr size_t EVENT_QUEUE_DEPTH = 8;
+
+        using PayloadPool = Memory::BlockPool<Config::MQTT_PAYLOAD_BLOCK_SIZE, Config::MQTT_PAYLOAD_BLOCKS>;
+
+        /*!
+        * @brief Message posted by the MQTT task and consumed in OnUpdate().
+        *        The payload of DATA waits in a pool block, returned when the event is dropped.
+        */
+        struct Event
+        {
+            enum class Type : uint8_t
+            {
+                CONNECTED,
+                DISCONNECTED,
+                DATA
+            };
+
+            Type type = Type::DATA;
+            char topic[Config::MQTT_TOPIC_MAX_LENGTH] = {};
+            size_t topicLength = 0;
+            PayloadPool::Block payload;
+            size_t payloadLength = 0;
+        };
+
+        /*!
+        * @brief Apply the events posted by the MQTT task. Runs in the manager task.
+        */
+        void ProcessEvents();
+
         /*!
         * @brief Start the MQTT client and connect to the broker
         */
@@ -109,7 +143,7 @@ class MqttClient : public Base::Singleton<MqttClient>,
         void _Stop();
 
         /*!
-        * @brief Handle MQTT events
+        * @brief Handle MQTT events. Runs in the MQTT task: only posts to _events.
         * @param event   Pointer to the MQTT event data.
         */
         static void EventHandler(void* handler_args, esp_event_base_t base, int32_t event_id, void* event_data);
@@ -129,6 +163,9 @@ class MqttClient : public Base::Singleton<MqttClient>,
         std::string _username;
         std::atomic<bool> _connected;
         MessageCallback _globalCallback;
+        PayloadPool _payloads;                      //!< Payloads of the queued DATA events
+        SpscRingBuffer<Event, EVENT_QUEUE_DEPTH> _events;
+        std::atomic<uint32_t> _droppedEvents;       //!< Queue full, no free block or message too large
 };
 
 } // namespace Online
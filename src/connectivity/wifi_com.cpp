@@ -31,6 +31,8 @@ bool WiFiCom::OnInit()
 //----private------------------------------------------------------------------
 void WiFiCom::OnUpdate()
 {
+    ProcessEvents();
+
     switch (_state)
     {
         case State::IDLE:
@@ -92,13 +94,13 @@ bool WiFiCom::IsConnected() const
 }
 
 //-----------------------------------------------------------------------------
-std::string WiFiCom::GetSsid() const
+const char* WiFiCom::GetSsid() const
 {
     if (!_connected.load())
     {
         return "";
     }
-    return _ssid;
+    return _ssid.c_str();
 }
 
 //-----------------------------------------------------------------------------
@@ -213,6 +215,40 @@ void WiFiCom::_Stop()
     _connected = false;
 }
 
+//----private------------------------------------------------------------------
+void WiFiCom::ProcessEvents()
+{
+    Event event;
+    while (_events.TryPop(event))
+    {
+        switch (event)
+        {
+            case Event::STA_DISCONNECTED:
+            {
+                _connected = false;
+                _got_ip = false;
+
+                if (_state == State::CONNECTED || _state == State::CONNECTING)
+                {
+                    _state = State::CONNECTING;
+                    // attempt reconnect (non-blocking)
+                    esp_wifi_connect();
+                }
+            }
+            break;
+
+            case Event::GOT_IP:
+            {
+                CORE_INFO("WiFiCom connected to SSID: %s", _ssid.c_str());
+                _got_ip = true;
+                _connected = true;
+                _state = State::CONNECTED;
+            }
+            break;
+        }
+    }
+}
+
 //----private------------------------------------------------------------------
 void WiFiCom::EventHandler(
       void* arg
@@ -237,13 +273,9 @@ void WiFiCom::EventHandler(
             {
                 CORE_WARNING("WIFI_EVENT_STA_DISCONNECTED");
 
-                if (instance)
+                if (instance && !instance->_events.TryPush(Event::STA_DISCONNECTED))
                 {
-                    instance->_connected = false;
-                    instance->_got_ip = false;
-                    instance->_state = State::CONNECTING;
-                    // attempt reconnect (non-blocking)
-                    esp_wifi_connect();
+                    CORE_ERROR("WiFiCom event queue full, disconnect dropped");
                 }
             }
             break;
@@ -265,12 +297,9 @@ void WiFiCom::EventHandler(
             esp_ip4addr_ntoa(&event->ip_info.ip, ip_str, sizeof(ip_str));
             CORE_INFO("Got IP: %s", ip_str);
 
-            if (instance) 
+            if (instance && !instance->_events.TryPush(Event::GOT_IP))
             {
-                CORE_INFO("WiFiCom connected to SSID: %s", instance->_ssid.c_str());
-                instance->_got_ip = true;
-                instance->_connected = true;
-                instance->_state = State::CONNECTED;
+                CORE_ERROR("WiFiCom event queue full, got IP dropped");
             }
         }
     }
@@ -11,6 +11,7 @@
 #include "esp_event.h"
 #include "esp_wifi.h"
 #include "framework/common_defs.h"
+#include "framework/os/ring_buffer.h"
 #include "src/core/base/driver.h"
 #include <atomic>
 #include <string>
@@ -40,9 +41,9 @@ class WiFiCom : public Base::Singleton<WiFiCom>,
 
         /*!
         * @brief Get the SSID of the currently connected AP.
-        * @return SSID string when connected, empty string otherwise.
+        * @return SSID string when connected (valid until the credentials change), empty string otherwise.
         */
-        std::string GetSsid() const;
+        const char* GetSsid() const;
 
         /*!
         * @brief Get the RSSI (signal strength) of the current connection.
@@ -102,12 +103,26 @@ class WiFiCom : public Base::Singleton<WiFiCom>,
         void OnUpdate() override;
 
     private:
+
+        /*!
+         * @brief Message posted by the event loop task and consumed in OnUpdate().
+         */
+        enum class Event : uint8_t
+        {
+            STA_DISCONNECTED,
+            GOT_IP
+        };
     
         auto _Start() -> State;
         void _Stop();
+
+        /*!
+         * @brief Apply the events posted by the event loop. Runs in the manager task.
+         */
+        void ProcessEvents();
         
         /*! 
-         * @brief Event handler for WiFi and IP events.
+         * @brief Event handler for WiFi and IP events. Runs in the event loop task: only posts to _events.
          * @param arg          User argument (not used).
          * @param event_base   Event base (WIFI_EVENT or IP_EVENT).
          * @param event_id     Event ID.
@@ -129,12 +144,17 @@ class WiFiCom : public Base::Singleton<WiFiCom>,
 
         //---------------------------------------------
 
+        static constexpr size_t EVENT_QUEUE_DEPTH = 8;
+
+        //---------------------------------------------
+
         State _state;
         std::string _ssid;
         std::string _password;
         std::atomic<bool> _got_ip;
         std::atomic<bool> _connected;
         esp_netif_t* _netif; // forward-declare type to avoid exposing esp-netif here
+        SpscRingBuffer<Event, EVENT_QUEUE_DEPTH> _events;
     };
 
 } // namespace Connectivity
@@ -14,27 +14,55 @@ namespace Base {
 //----public-------------------------------------------------------------------
 void Manager::Update(int delayAfterMs)
 {
-    bool enteredBatteryMode = false;
-    bool exitedBatteryMode = false;
+    {
+        CORE_TRACE_SCOPE(GetModuleName());
+
+        bool enteredBatteryMode = false;
+        bool exitedBatteryMode = false;
+
+        _CheckBatteryModeChange(enteredBatteryMode, exitedBatteryMode);
 
-    _CheckBatteryModeChange(enteredBatteryMode, exitedBatteryMode);
+        if (enteredBatteryMode)
+        {
+            CORE_INFO("%s entering battery mode", GetModuleName());
+            OnBatteryModeEnter();
+        }
+        else if (exitedBatteryMode)
+        {
+            CORE_INFO("%s exiting battery mode", GetModuleName());
+            OnBatteryModeExit();
+        }
+
+        const uint64_t startUs = esp_timer_get_time();
+        OnUpdate();
+        RecordUpdateDuration(esp_timer_get_time() - startUs);
+    }
 
-    if (enteredBatteryMode)
+    if (delayAfterMs > 0)
     {
-        CORE_INFO("%s entering battery mode", GetModuleName());
-        OnBatteryModeEnter();
+        TaskDelayMs(delayAfterMs);
     }
-    else if (exitedBatteryMode)
+}
+
+//-----------------------------------------------------------------------------
+bool Manager::Attach(Scheduler& scheduler)
+{
+    _taskId = scheduler.Register(GetModuleName(), GetSchedule(), [this]() { Update(); });
+    if (_taskId == Scheduler::INVALID_TASK)
     {
-        CORE_INFO("%s exiting battery mode", GetModuleName());
-        OnBatteryModeExit();
+        return false;
     }
 
-    OnUpdate();
+    _scheduler = &scheduler;
+    return true;
+}
 
-    if (delayAfterMs > 0)
+//----protected----------------------------------------------------------------
+void Manager::RequestUpdate(Scheduler::WakeSource source)
+{
+    if (_scheduler != nullptr)
     {
-        TaskDelayMs(delayAfterMs);
+        _scheduler->Notify(_taskId, source);
     }
 }
 
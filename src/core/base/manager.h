@@ -25,7 +25,8 @@ namespace Base {
  * The parent Module handles Init() and Update() calls and logging.
  * Manager::Update() additionally detects battery mode changes via PowerController.
  *
- * @note Managers typically require periodic updates. Override OnUpdate().
+ * @note Managers typically require periodic updates. Override OnUpdate() and
+ *       GetSchedule(), then Attach() the manager to the system Scheduler.
  */
 class Manager : public Module
 {
@@ -44,6 +45,13 @@ class Manager : public Module
          */
         void Update(int delayAfterMs = 0);
 
+        /**
+         * @brief Register this manager's Update() in a scheduler using GetSchedule().
+         * @param scheduler Scheduler that will run the manager.
+         * @return bool True if registered, false if the scheduler rejected it.
+         */
+        bool Attach(Scheduler& scheduler);
+
     protected:
 
         /**
@@ -65,6 +73,13 @@ class Manager : public Module
          */
         virtual void OnBatteryModeExit() {}
 
+        /**
+         * @brief Request an early Update() from any task.
+         *        Only has effect if the schedule includes the given wake source.
+         * @param source WAKE_NOTIFICATION, or WAKE_QUEUE after posting to the manager's queue.
+         */
+        void RequestUpdate(Scheduler::WakeSource source = Scheduler::WAKE_NOTIFICATION);
+
     private:
 
         /**
@@ -84,6 +99,8 @@ class Manager : public Module
         Manager& operator=(Manager&&) = delete;
 
         bool _lastBatteryMode;
+        Scheduler* _scheduler = nullptr;
+        Scheduler::TaskId _taskId = Scheduler::INVALID_TASK;
         uint64_t _batteryModeRecoveryEndUs = 0;  //!< esp_timer timestamp; 0 = not in recovery
         static constexpr uint32_t BATTERY_MODE_RECOVERY_MS = 1000;  //!< Ignore changes for 1s after a transition
 };
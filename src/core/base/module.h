@@ -8,7 +8,11 @@
 
 #pragma once
 
+#include "esp_timer.h"
 #include "framework/common_defs.h"
+#include "framework/os/perf_stats.h"
+#include "framework/os/scheduler.h"
+#include "framework/os/trace.h"
 #include "src/core/base/singleton.h"
 
 namespace Base {
@@ -20,6 +24,11 @@ namespace Base {
  * - Init(): Initialize the module (calls OnInit internally)
  * - Update(): Periodic update (calls OnUpdate internally, optional)
  * - GetModuleName(): Get human-readable module name for logging
+ * - GetSchedule(): Period, deadline and wake sources used by the Scheduler
+ *
+ * OnInit() and OnUpdate() are traced under the module name (see trace.h) and
+ * every OnUpdate() duration goes to the module's latency histogram
+ * (see perf_stats.h), budgeted by its schedule deadline.
  *
  * All modules (Managers, Drivers, Services) inherit from this.
  *
@@ -46,11 +55,15 @@ class Module
         bool Init(int delayAfterMs = 0)
         {
             CORE_INFO("%s Initializing...", GetModuleName());
-            
-            if (!OnInit())
+
             {
-                CORE_ERROR("%s Failed to initialize", GetModuleName());
-                return false;
+                CORE_TRACE_SCOPE(GetModuleName());
+
+                if (!OnInit())
+                {
+                    CORE_ERROR("%s Failed to initialize", GetModuleName());
+                    return false;
+                }
             }
 
             CORE_INFO("%s initialized successfully", GetModuleName());
@@ -70,7 +83,13 @@ class Module
          */
         void Update(int delayAfterMs = 0)
         {
-            OnUpdate();
+            {
+                CORE_TRACE_SCOPE(GetModuleName());
+
+                const uint64_t startUs = esp_timer_get_time();
+                OnUpdate();
+                RecordUpdateDuration(esp_timer_get_time() - startUs);
+            }
 
             if (delayAfterMs > 0)
             {
@@ -92,6 +111,13 @@ class Module
          */
         virtual const char* GetModuleName() const = 0;
 
+        /**
+         * @brief Get the scheduling requirements of this module.
+         *        Default implementation returns an empty schedule (never released).
+         * @return Scheduler::Schedule Period, deadline and wake sources.
+         */
+        virtual Scheduler::Schedule GetSchedule() const { return Scheduler::Schedule{}; }
+
         /**
          * @brief Pure virtual initialization method.
          *        Must be implemented by derived classes.
@@ -108,6 +134,29 @@ class Module
          */
         virtual void OnUpdate() {}
 
+        /**
+         * @brief Add one update duration to this module's latency statistics.
+         *        Registers the module on first use, with the schedule deadline
+         *        (or period) as budget.
+         * @param durationUs Duration of the update in microseconds.
+         */
+        void RecordUpdateDuration(uint64_t durationUs)
+        {
+            if (!_perfRegistered)
+            {
+                const Scheduler::Schedule schedule = GetSchedule();
+                const uint32_t budgetMs = (schedule.deadlineMs != 0) ? schedule.deadlineMs : schedule.periodMs;
+
+                _perfStats = Perf::Register(GetModuleName(), budgetMs * 1000);
+                _perfRegistered = true;
+            }
+
+            if (_perfStats != nullptr)
+            {
+                _perfStats->Record(durationUs);
+            }
+        }
+
     private:
 
         // Prevent copying and moving
@@ -115,6 +164,11 @@ class Module
         Module& operator=(const Module&) = delete;
         Module(Module&&) = delete;
         Module& operator=(Module&&) = delete;
+
+        // ---------------------------------------------
+
+        Perf::ModuleStats* _perfStats = nullptr;
+        bool _perfRegistered = false;
 };
 
 } // namespace Base
@@ -0,0 +1,319 @@
+/*!****************************************************************************
+ * @file    boot_orchestrator.cpp
+ * @brief   Implementation of the BootOrchestrator class.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ *******************************************************************************/
+
+#include "src/core/boot_orchestrator.h"
+
+#include "esp_timer.h"
+#include "include/config.h"
+#include <cmath>
+#include <utility>
+
+namespace Core {
+
+//-----------------------------------------------------------------------------
+BootOrchestrator::StepId BootOrchestrator::Add(const Step& step)
+{
+    if (_stepCount >= MAX_STEPS || step.module == nullptr)
+    {
+        CORE_ERROR("Cannot add boot step %s", (step.name != nullptr) ? step.name : "?");
+        return INVALID_STEP;
+    }
+
+    // Only steps added before can be depended on: the graph stays acyclic
+    const uint32_t knownSteps = (1U << _stepCount) - 1;
+    if ((step.dependsOn & ~knownSteps) != 0)
+    {
+        CORE_ERROR("Boot step %s depends on an unknown step", step.name);
+        return INVALID_STEP;
+    }
+
+    const StepId id = static_cast<StepId>(_stepCount++);
+    _steps[id] = StepRun{};
+    _steps[id].step = step;
+    _contexts[id] = TaskContext{ this, id };
+
+    return id;
+}
+
+//-----------------------------------------------------------------------------
+bool BootOrchestrator::Run(IClock& clock, SupplyReader readSupply)
+{
+    _initialized = xQueueCreate(MAX_STEPS, sizeof(StepId));
+    if (_initialized == nullptr)
+    {
+        CORE_ERROR("Failed to create boot queue");
+        return false;
+    }
+
+    _clock = &clock;
+    _readSupply = std::move(readSupply);
+
+    // Make this the task the step tasks wake before any of them can finish
+    _clock->WaitUntil(0);
+
+    const uint32_t allSteps = (_stepCount == 32) ? 0xFFFFFFFFU : ((1U << _stepCount) - 1);
+    _runStartUs = _clock->NowUs();
+
+    while (_readyMask != allSteps)
+    {
+        const uint32_t readyBefore = _readyMask;
+
+        StartReadySteps();
+
+        StepId id = INVALID_STEP;
+        while (xQueueReceive(_initialized, &id, 0) == pdTRUE)
+        {
+            OnStepInitialized(id);
+        }
+
+        PollSettlingSteps();
+
+        // Nothing new to start: block until a step finishes Init() (its task wakes the clock),
+        // waking up to sample the supply while one settles
+        if (_readyMask == readyBefore)
+        {
+            _clock->WaitUntil((_settlingCount > 0) ? _nextSampleUs : IClock::NO_DEADLINE);
+        }
+    }
+
+    vQueueDelete(_initialized);
+    _initialized = nullptr;
+
+    MarkMilestone(Milestone::BOOT_COMPLETE);
+    LogReport();
+
+    bool success = true;
+    for (size_t i = 0; i < _stepCount; ++i)
+    {
+        success &= _steps[i].success;
+    }
+
+    return success;
+}
+
+//-----------------------------------------------------------------------------
+std::optional<BootOrchestrator::StepTimes> BootOrchestrator::GetStepTimes(StepId id) const
+{
+    if (id >= _stepCount || _steps[id].state == StepState::PENDING)
+    {
+        return std::nullopt;
+    }
+
+    const StepRun& run = _steps[id];
+    return StepTimes{ run.startUs - _runStartUs, run.initDoneUs - _runStartUs, run.readyUs - _runStartUs, run.settled, run.success };
+}
+
+//-----------------------------------------------------------------------------
+void BootOrchestrator::MarkMilestone(Milestone milestone)
+{
+    auto& slot = _milestoneUs[static_cast<size_t>(milestone)];
+    if (slot.load(std::memory_order_relaxed) != 0)
+    {
+        return;
+    }
+
+    int64_t expected = 0;
+    const int64_t nowUs = esp_timer_get_time();
+    if (slot.compare_exchange_strong(expected, nowUs, std::memory_order_relaxed))
+    {
+        CORE_INFO("Boot milestone '%s' at %u ms", GetMilestoneName(milestone), static_cast<unsigned>(nowUs / 1000));
+    }
+}
+
+//-----------------------------------------------------------------------------
+std::optional<uint32_t> BootOrchestrator::GetMilestoneMs(Milestone milestone) const
+{
+    const int64_t us = _milestoneUs[static_cast<size_t>(milestone)].load(std::memory_order_relaxed);
+    if (us == 0)
+    {
+        return std::nullopt;
+    }
+
+    return static_cast<uint32_t>(us / 1000);
+}
+
+//----private------------------------------------------------------------------
+void BootOrchestrator::StepTaskEntry(void* arg)
+{
+    auto* context = static_cast<TaskContext*>(arg);
+    BootOrchestrator* self = context->orchestrator;
+    const StepId id = context->id;
+
+    self->_steps[id].success = self->_steps[id].step.module->Init();
+
+    xQueueSend(self->_initialized, &id, portMAX_DELAY);
+    self->_clock->Wake();
+    vTaskDelete(NULL);
+}
+
+//----private------------------------------------------------------------------
+void BootOrchestrator::StartReadySteps()
+{
+    for (size_t i = 0; i < _stepCount; ++i)
+    {
+        StepRun& run = _steps[i];
+
+        if (run.state != StepState::PENDING || (run.step.dependsOn & ~_readyMask) != 0)
+        {
+            continue;
+        }
+
+        // A step above the whole budget still runs, alone
+        const bool fitsBudget = (_inrushInFlightMa + run.step.inrushMa <= Config::BOOT_INRUSH_BUDGET_MA)
+                             || (_inrushInFlightMa == 0);
+        if (run.step.inrushMa > 0 && !fitsBudget)
+        {
+            continue;
+        }
+
+        run.state = StepState::RUNNING;
+        run.startUs = _clock->NowUs();
+        _inrushInFlightMa += run.step.inrushMa;
+
+        const BaseType_t created = xTaskCreatePinnedToCore(
+            StepTaskEntry,
+            run.step.name,
+            Config::BOOT_STEP_STACK_SIZE,
+            &_contexts[i],
+            uxTaskPriorityGet(NULL),
+            nullptr,
+            run.step.coreId
+        );
+
+        if (created != pdPASS)
+        {
+            CORE_WARNING("No task for boot step %s, running it inline", run.step.name);
+            run.success = run.step.module->Init();
+            OnStepInitialized(static_cast<StepId>(i));
+        }
+    }
+}
+
+//----private------------------------------------------------------------------
+void BootOrchestrator::OnStepInitialized(StepId id)
+{
+    StepRun& run = _steps[id];
+    run.initDoneUs = _clock->NowUs();
+
+    if (run.step.inrushMa == 0)
+    {
+        MarkReady(id);
+        return;
+    }
+
+    run.state = StepState::SETTLING;
+    run.stableSamples = 0;
+
+    // First sample of a settling window right away, with nothing to compare against yet
+    if (_settlingCount++ == 0)
+    {
+        _haveSupplySample = false;
+        _nextSampleUs = run.initDoneUs;
+    }
+}
+
+//----private------------------------------------------------------------------
+void BootOrchestrator::PollSettlingSteps()
+{
+    if (_settlingCount == 0)
+    {
+        return;
+    }
+
+    const uint64_t nowUs = _clock->NowUs();
+    if (nowUs < _nextSampleUs)
+    {
+        return;
+    }
+
+    _nextSampleUs = nowUs + Config::BOOT_SETTLE_POLL_MS * 1000ULL;
+
+    // No reading yet (e.g. the sampler has not converted the channel) is not a stable supply
+    const std::optional<float> voltage = _readSupply ? _readSupply() : std::nullopt;
+    const bool stable = voltage.has_value() && _haveSupplySample &&
+                        (std::fabs(*voltage - _lastSupplyVoltage) <= Config::BOOT_SUPPLY_SETTLE_TOLERANCE_V);
+
+    _haveSupplySample = voltage.has_value();
+    _lastSupplyVoltage = voltage.value_or(0.0f);
+
+    for (size_t i = 0; i < _stepCount; ++i)
+    {
+        StepRun& run = _steps[i];
+        if (run.state != StepState::SETTLING)
+        {
+            continue;
+        }
+
+        run.stableSamples = stable ? (run.stableSamples + 1) : 0;
+
+        if (run.stableSamples >= Config::BOOT_SUPPLY_STABLE_SAMPLES)
+        {
+            run.settled = true;
+        }
+        else if ((nowUs - run.initDoneUs) < (run.step.settleTimeoutMs * 1000ULL))
+        {
+            continue;
+        }
+        else
+        {
+            CORE_WARNING("%s: supply not stable after %u ms (%.2f V), continuing",
+                         run.step.name, static_cast<unsigned>(run.step.settleTimeoutMs), _lastSupplyVoltage);
+        }
+
+        --_settlingCount;
+        MarkReady(static_cast<StepId>(i));
+    }
+}
+
+//----private------------------------------------------------------------------
+void BootOrchestrator::MarkReady(StepId id)
+{
+    StepRun& run = _steps[id];
+    run.state = StepState::READY;
+    run.readyUs = _clock->NowUs();
+
+    _inrushInFlightMa -= run.step.inrushMa;
+    _readyMask |= (1U << id);
+}
+
+//----private------------------------------------------------------------------
+void BootOrchestrator::LogReport() const
+{
+    uint64_t serialUs = 0;
+
+    for (size_t i = 0; i < _stepCount; ++i)
+    {
+        const StepRun& run = _steps[i];
+        serialUs += run.readyUs - run.startUs;
+
+        CORE_INFO("Boot %-18s start %5u ms  init %5u ms  settle %4u ms%s%s",
+                  run.step.name,
+                  static_cast<unsigned>((run.startUs - _runStartUs) / 1000),
+                  static_cast<unsigned>((run.initDoneUs - run.startUs) / 1000),
+                  static_cast<unsigned>((run.readyUs - run.initDoneUs) / 1000),
+                  (run.step.inrushMa > 0 && !run.settled) ? " (timeout)" : "",
+                  run.success ? "" : " FAILED");
+    }
+
+    const uint64_t totalUs = _clock->NowUs() - _runStartUs;
+    CORE_INFO("Boot sequence took %u ms (%u ms if run serially)",
+              static_cast<unsigned>(totalUs / 1000), static_cast<unsigned>(serialUs / 1000));
+}
+
+//----private------------------------------------------------------------------
+const char* BootOrchestrator::GetMilestoneName(Milestone milestone)
+{
+    switch (milestone)
+    {
+        case Milestone::BOOT_COMPLETE:      return "boot complete";
+        case Milestone::FIRST_READING:      return "first reading";
+        case Milestone::FIRST_TELEMETRY:    return "first telemetry";
+        default:                            return "?";
+    }
+}
+
+} // namespace Core
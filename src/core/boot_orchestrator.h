@@ -0,0 +1,195 @@
+/*!****************************************************************************
+ * @file    boot_orchestrator.h
+ * @brief   Starts the modules as a dependency graph instead of a fixed serial
+ *          list with sleeps in between. Every step declares the steps it needs,
+ *          its estimated inrush current and its preferred core. Independent
+ *          steps run in parallel on their own short-lived tasks as long as the
+ *          inrush of the steps still starting fits the supply budget.
+ *          A step with inrush keeps its share of the budget until the supply
+ *          voltage is measured stable again, bounded by its settle timeout.
+ *          No supply reading yet is not a stable supply.
+ *          Also keeps the boot milestones (boot complete, first reading,
+ *          first telemetry) in milliseconds since power-on.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#pragma once
+
+#include "framework/common_defs.h"
+#include "framework/os/clock.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/task.h"
+#include "src/core/base/module.h"
+#include "src/core/base/singleton.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+
+namespace Core {
+
+class BootOrchestrator : public Base::Singleton<BootOrchestrator>
+{
+    public:
+
+        using StepId = uint8_t;
+
+        //! Supply voltage for the settle check, std::nullopt while there is no reading yet
+        using SupplyReader = std::function<std::optional<float>()>;
+
+        static constexpr size_t MAX_STEPS = 16;
+        static constexpr StepId INVALID_STEP = 0xFF;
+
+        enum class Milestone : uint8_t
+        {
+            BOOT_COMPLETE,          //!< Every step initialized and settled
+            FIRST_READING,          //!< First water reading sampled
+            FIRST_TELEMETRY,        //!< First telemetry accepted by the MQTT client
+            _size
+        };
+
+        struct Step
+        {
+            const char* name = nullptr;             //!< Shown in the boot report
+            Base::Module* module = nullptr;         //!< Init() runs on the step task
+            uint32_t dependsOn = 0;                 //!< Steps that must be ready first (see After())
+            uint32_t inrushMa = 0;                  //!< Estimated current spike while starting, 0 = none
+            uint32_t settleTimeoutMs = 0;           //!< Longest wait for the supply to settle after Init()
+            BaseType_t coreId = tskNO_AFFINITY;     //!< Core of the step task
+        };
+
+        //! Where a step went during Run(), in clock time
+        struct StepTimes
+        {
+            uint64_t startUs;                       //!< Init() started
+            uint64_t initDoneUs;                    //!< Init() returned
+            uint64_t readyUs;                       //!< Supply settled (or timed out): dependents may start
+            bool settled;                           //!< False if the settle wait timed out
+            bool success;                           //!< Init() result
+        };
+
+        /**
+         * @brief Dependency mask for Step::dependsOn.
+         */
+        template <typename... Ids>
+        static constexpr uint32_t After(Ids... ids) { return ((1U << ids) | ... | 0U); }
+
+        /**
+         * @brief Adds a step. Dependencies must be steps added before, so the graph has no cycles.
+         * @param step Step description.
+         * @return StepId Identifier of the step, INVALID_STEP if the table is full or a dependency is unknown.
+         */
+        StepId Add(const Step& step);
+
+        /**
+         * @brief Runs every step and blocks until all of them are ready, then logs the boot report.
+         *        A step whose Init() fails is reported and still unblocks its dependents,
+         *        so one broken peripheral does not keep the rest of the device down.
+         * @param clock Time base of the settle polling and of the report; the step tasks wake it.
+         * @param readSupply Supply voltage sampled while a step settles.
+         * @return bool True if every Init() succeeded.
+         */
+        bool Run(IClock& clock, SupplyReader readSupply);
+
+        /**
+         * @brief Timeline of a step of the last Run().
+         * @return std::optional<StepTimes> Empty if the step is unknown or has not run.
+         */
+        std::optional<StepTimes> GetStepTimes(StepId id) const;
+
+        /**
+         * @brief Records a milestone the first time it is reached. Any task.
+         */
+        void MarkMilestone(Milestone milestone);
+
+        /**
+         * @brief Milliseconds since power-on when the milestone was reached.
+         * @return std::optional<uint32_t> Empty if not reached yet.
+         */
+        std::optional<uint32_t> GetMilestoneMs(Milestone milestone) const;
+
+    private:
+
+        friend class Base::Singleton<BootOrchestrator>;
+
+        enum class StepState : uint8_t
+        {
+            PENDING,
+            RUNNING,
+            SETTLING,
+            READY
+        };
+
+        struct StepRun
+        {
+            Step step;
+            StepState state = StepState::PENDING;
+            bool success = false;
+            bool settled = false;
+            uint32_t stableSamples = 0;
+            uint64_t startUs = 0;
+            uint64_t initDoneUs = 0;
+            uint64_t readyUs = 0;
+        };
+
+        struct TaskContext
+        {
+            BootOrchestrator* orchestrator;
+            StepId id;
+        };
+
+        BootOrchestrator() = default;
+        ~BootOrchestrator() = default;
+        BootOrchestrator(const BootOrchestrator&) = delete;
+        BootOrchestrator& operator=(const BootOrchestrator&) = delete;
+
+        /**
+         * @brief Body of the step tasks: runs Init() and reports to the orchestrator.
+         */
+        static void StepTaskEntry(void* arg);
+
+        /**
+         * @brief Starts every pending step whose dependencies are ready and whose inrush fits the budget.
+         */
+        void StartReadySteps();
+
+        /**
+         * @brief Handles the end of a step Init().
+         */
+        void OnStepInitialized(StepId id);
+
+        /**
+         * @brief Samples the supply and releases the settling steps that are stable or timed out.
+         */
+        void PollSettlingSteps();
+
+        void MarkReady(StepId id);
+
+        void LogReport() const;
+
+        static const char* GetMilestoneName(Milestone milestone);
+
+        // ---------------------------------------------
+
+        StepRun _steps[MAX_STEPS];
+        TaskContext _contexts[MAX_STEPS];
+        size_t _stepCount = 0;
+
+        IClock* _clock = nullptr;
+        SupplyReader _readSupply;
+        QueueHandle_t _initialized = nullptr;       //!< StepIds whose Init() returned
+        uint32_t _readyMask = 0;
+        uint32_t _inrushInFlightMa = 0;
+        size_t _settlingCount = 0;
+        bool _haveSupplySample = false;             //!< _lastSupplyVoltage holds the previous reading
+        float _lastSupplyVoltage = 0.0f;
+        uint64_t _nextSampleUs = 0;
+        uint64_t _runStartUs = 0;
+
+        std::atomic<int64_t> _milestoneUs[static_cast<size_t>(Milestone::_size)] = {};
+};
+
+} // namespace Core
@@ -0,0 +1,91 @@
+/*!****************************************************************************
+ * @file    event_bus.h
+ * @brief   Typed publish/subscribe between managers. The subscribers of each
+ *          event are listed here at compile time, so Publish() expands to one
+ *          Post() per subscriber: no registration, no lookup, no allocation.
+ *          Publishing an event without a route does not compile.
+ *          Include it from .cpp files only (it pulls in the subscribers).
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ *******************************************************************************/
+
+#pragma once
+
+#include "src/core/events.h"
+#include "src/managers/network_controller.h"
+#include "src/managers/user_interface.h"
+
+namespace Core {
+namespace EventBus {
+
+/**
+ * @brief Fixed list of subscribing managers (singletons).
+ */
+template <typename... Subscribers>
+struct SubscriberList
+{
+    template <typename Event>
+    static void Post(const Event& event)
+    {
+        (Subscribers::GetInstance()->Post(event), ...);
+    }
+};
+
+//! Subscribers of each event
+template <typename Event>
+struct Route;
+
+template <>
+struct Route<Events::ConfigChanged>
+{
+    using Subscribers = SubscriberList<Managers::UserInterface, Managers::NetworkController>;
+};
+
+template <>
+struct Route<Events::ReadingSampled>
+{
+    using Subscribers = SubscriberList<Managers::UserInterface>;
+};
+
+template <>
+struct Route<Events::ReadingAnomaly>
+{
+    using Subscribers = SubscriberList<Managers::UserInterface, Managers::NetworkController>;
+};
+
+template <>
+struct Route<Events::ConnectivityChanged>
+{
+    using Subscribers = SubscriberList<Managers::UserInterface>;
+};
+
+template <>
+struct Route<Events::FeedingStarted>
+{
+    using Subscribers = SubscriberList<Managers::UserInterface>;
+};
+
+template <>
+struct Route<Events::FeedingFinished>
+{
+    using Subscribers = SubscriberList<Managers::UserInterface>;
+};
+
+template <>
+struct Route<Events::PowerModeChanged>
+{
+    using Subscribers = SubscriberList<Managers::UserInterface>;
+};
+
+/**
+ * @brief Deliver an event to every subscriber's inbox. Safe from any task;
+ *        the handlers run later on the subscribers' tasks.
+ */
+template <typename Event>
+void Publish(const Event& event)
+{
+    Route<Event>::Subscribers::Post(event);
+}
+
+} // namespace EventBus
+} // namespace Core
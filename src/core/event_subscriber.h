@@ -0,0 +1,78 @@
+/*!****************************************************************************
+ * @file    event_subscriber.h
+ * @brief   Inbox of a manager subscribed to EventBus events. Posting copies
+ *          the event into a lock-free queue and wakes the manager with
+ *          WAKE_QUEUE; the handlers run later on the manager's own task,
+ *          when it calls ProcessEvents().
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ *******************************************************************************/
+
+#pragma once
+
+#include "framework/common_defs.h"
+#include "framework/os/ring_buffer.h"
+#include "framework/os/scheduler.h"
+#include <type_traits>
+#include <variant>
+
+namespace Core {
+
+/**
+ * @brief CRTP mixin giving a manager an event inbox.
+ *        The manager declares `friend Subscriber;` (Subscriber being this
+ *        class), implements one OnEvent(const E&) per event and calls
+ *        ProcessEvents() from OnUpdate(). Its schedule must listen to WAKE_QUEUE.
+ * @tparam Derived Subscribing manager.
+ * @tparam Events Event types it receives.
+ */
+template <typename Derived, typename... Events>
+class EventSubscriber
+{
+    public:
+
+        static constexpr size_t EVENT_QUEUE_DEPTH = 8;
+
+        /**
+         * @brief Queue an event and wake the subscriber. Safe from any task.
+         */
+        template <typename Event>
+        void Post(const Event& event)
+        {
+            static_assert((std::is_same_v<Event, Events> || ...), "Subscriber does not handle this event");
+
+            auto* subscriber = static_cast<Derived*>(this);
+
+            if (!_events.TryPush(Message{ std::in_place_type<Event>, event }))
+            {
+                CORE_WARNING("%s event queue full, event dropped", subscriber->GetModuleName());
+                return;
+            }
+
+            subscriber->RequestUpdate(Scheduler::WAKE_QUEUE);
+        }
+
+    protected:
+
+        using Subscriber = EventSubscriber<Derived, Events...>;
+
+        /**
+         * @brief Deliver every queued event to Derived::OnEvent(), in posting order.
+         */
+        void ProcessEvents()
+        {
+            Message message;
+            while (_events.TryPop(message))
+            {
+                std::visit([this](const auto& event) { static_cast<Derived*>(this)->OnEvent(event); }, message);
+            }
+        }
+
+    private:
+
+        using Message = std::variant<Events...>;
+
+        MpscRingBuffer<Message, EVENT_QUEUE_DEPTH> _events;
+};
+
+} // namespace Core
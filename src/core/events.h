@@ -0,0 +1,91 @@
+/*!****************************************************************************
+ * @file    events.h
+ * @brief   Notifications exchanged between managers through the EventBus.
+ *          Events are small trivially copyable values: they are queued by
+ *          copy in the subscriber's inbox, never allocated.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ *******************************************************************************/
+
+#pragma once
+
+#include "src/services/power_controller.h"
+#include <cstdint>
+
+namespace Events {
+
+//! A persisted setting changed (published by GuardianProxy after the save)
+struct ConfigChanged
+{
+    enum class Section : uint8_t
+    {
+        WIFI_CREDENTIALS,
+        TIMEZONE,
+        TEMPERATURE_LIMITS,
+        TDS_LIMITS,
+        TREND_SENSITIVITY,
+        FEEDING_SCHEDULE,
+        ALL                     //!< Factory reset
+    };
+
+    Section section = Section::ALL;
+};
+
+//! WaterMonitor finished a measurement cycle
+struct ReadingSampled
+{
+    float temperature = 0.0f;
+    int tds = 0;
+};
+
+//! WaterMonitor saw a reading change too fast or jump away from its recent values,
+//! before any limit is crossed (published once per onset)
+struct ReadingAnomaly
+{
+    enum class Sensor : uint8_t
+    {
+        TEMPERATURE,
+        TDS
+    };
+
+    enum class Kind : uint8_t
+    {
+        RISING,                 //!< Fitted rate above the limit
+        FALLING,
+        SPIKE                   //!< Z-score against the last minutes above the limit
+    };
+
+    Sensor sensor = Sensor::TEMPERATURE;
+    Kind kind = Kind::SPIKE;
+    float value = 0.0f;
+    float ratePerHour = 0.0f;
+    float zScore = 0.0f;
+};
+
+//! WiFi, MQTT or AP portal state changed
+struct ConnectivityChanged
+{
+    bool wifiConnected = false;
+    bool mqttConnected = false;
+    bool apPortalActive = false;
+};
+
+//! The feeding worker started dispensing
+struct FeedingStarted
+{
+    int dose = 0;
+};
+
+//! The feeding worker finished (or was cancelled)
+struct FeedingFinished
+{
+    int dose = 0;
+};
+
+//! Power source changed
+struct PowerModeChanged
+{
+    Services::PowerController::Mode mode = Services::PowerController::Mode::MODE_USB_POWERED;
+};
+
+} // namespace Events
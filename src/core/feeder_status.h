@@ -0,0 +1,24 @@
+/*!****************************************************************************
+ * @file    feeder_status.h
+ * @brief   Feeding status computed by FoodFeeder from its schedule. Kept out
+ *          of food_feeder.h so that the system snapshot and the public
+ *          interfaces can carry it without depending on the manager.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ *******************************************************************************/
+
+#pragma once
+
+#include "src/utils/date_time.h"
+
+namespace Core {
+
+struct FeederStatus
+{
+    Utils::DateTime nextFeedTime;
+    int nextFeedDoses = 0;
+    int remainingDosesToday = 0;
+    int totalPerDay = 0;
+};
+
+} // namespace Core
@@ -9,6 +9,7 @@
 
 #include "src/core/guardian_proxy.h"
 
+#include "src/core/event_bus.h"
 #include "src/managers/food_feeder.h"
 #include "src/managers/network_controller.h"
 #include "src/managers/user_interface.h"
@@ -37,7 +38,7 @@ auto GuardianProxy::DeleteFeedingScheduleEntry(int slotIndex) -> Result
 }
 
 //----IFoodFeeder--------------------------------------------------------------
-auto GuardianProxy::GetFeederStatus() const -> Managers::FoodFeeder::FeederStatus
+auto GuardianProxy::GetFeederStatus() const -> FeederStatus
 {
     return Managers::FoodFeeder::GetInstance()->GetFeederStatus();
 }
@@ -67,7 +68,7 @@ auto GuardianProxy::IsWifiConnected() const -> bool
 }
 
 //----INetworkController--------------------------------------------------------
-auto GuardianProxy::GetWifiSsid() const -> std::string
+auto GuardianProxy::GetWifiSsid() const -> const char*
 {
     return Managers::NetworkController::GetInstance()->GetWifiSsid();
 }
@@ -117,6 +118,8 @@ auto GuardianProxy::InitTimeSync(const char* timezone) const -> Result
 //----IStorageService-----------------------------------------------------------
 auto GuardianProxy::SaveWifiCredentialsInStorage(const std::string& ssid, const std::string& password) -> bool
 {
+    Services::ConfigTransaction transaction;
+
     bool successSsid = Services::StorageService::GetInstance()->Set<std::string>(
         Services::FieldId::WIFI_SSID,
         ssid
@@ -127,21 +130,23 @@ auto GuardianProxy::SaveWifiCredentialsInStorage(const std::string& ssid, const
         password
     );
 
-    return (successSsid && successPassword);
+    const bool saved = transaction.Commit();
+
+    return NotifyConfigChanged(saved && successSsid && successPassword, Events::ConfigChanged::Section::WIFI_CREDENTIALS);
 }
 
 //----IStorageService-----------------------------------------------------------
-auto GuardianProxy::GetWifiSsidFromStorage() const -> std::string
+auto GuardianProxy::GetWifiSsidFromStorage() const -> Services::ConfigView<std::string>
 {
-    return Services::StorageService::GetInstance()->Get<std::string>(
+    return Services::StorageService::GetInstance()->View<std::string>(
         Services::FieldId::WIFI_SSID
     );
 }
 
 //----IStorageService-----------------------------------------------------------
-auto GuardianProxy::GetWifiPasswordFromStorage() const -> std::string
+auto GuardianProxy::GetWifiPasswordFromStorage() const -> Services::ConfigView<std::string>
 {
-    return Services::StorageService::GetInstance()->Get<std::string>(
+    return Services::StorageService::GetInstance()->View<std::string>(
         Services::FieldId::WIFI_PASSWORD
     );
 }
@@ -149,16 +154,18 @@ auto GuardianProxy::GetWifiPasswordFromStorage() const -> std::string
 //----IStorageService-----------------------------------------------------------
 auto GuardianProxy::SaveTimezoneInStorage(const std::string& tz) -> bool
 {
-    return Services::StorageService::GetInstance()->Set<std::string>(
+    const bool success = Services::StorageService::GetInstance()->Set<std::string>(
         Services::FieldId::TIMEZONE,
         tz
     );
+
+    return NotifyConfigChanged(success, Events::ConfigChanged::Section::TIMEZONE);
 }
 
 //----IStorageService-----------------------------------------------------------
-auto GuardianProxy::GetTimezoneFromStorage() const -> std::string
+auto GuardianProxy::GetTimezoneFromStorage() const -> Services::ConfigView<std::string>
 {
-    return Services::StorageService::GetInstance()->Get<std::string>(
+    return Services::StorageService::GetInstance()->View<std::string>(
         Services::FieldId::TIMEZONE
     );
 }
@@ -166,6 +173,8 @@ auto GuardianProxy::GetTimezoneFromStorage() const -> std::string
 //----IStorageService-----------------------------------------------------------
 auto GuardianProxy::SaveTempLimitsInStorage(float minTemp, bool minEnabled, float maxTemp, bool maxEnabled) -> bool
 {
+    Services::ConfigTransaction transaction;
+
     bool successMin = Services::StorageService::GetInstance()->Set<float>(
         Services::FieldId::TEMP_MIN,
         minTemp
@@ -186,7 +195,9 @@ auto GuardianProxy::SaveTempLimitsInStorage(float minTemp, bool minEnabled, floa
         maxEnabled
     );
 
-    return (successMin && successMinEn && successMax && successMaxEn);
+    const bool saved = transaction.Commit();
+
+    return NotifyConfigChanged(saved && successMin && successMinEn && successMax && successMaxEn, Events::ConfigChanged::Section::TEMPERATURE_LIMITS);
 }
 
 //----IStorageService-----------------------------------------------------------
@@ -212,6 +223,8 @@ auto GuardianProxy::GetTempLimitsFromStorage(float& minTemp, bool& minEnabled, f
 //----IStorageService-----------------------------------------------------------
 auto GuardianProxy::SaveTdsLimitsInStorage(int minTds, bool minEnabled, int maxTds, bool maxEnabled) -> bool
 {
+    Services::ConfigTransaction transaction;
+
     bool successMin = Services::StorageService::GetInstance()->Set<int>(
         Services::FieldId::TDS_MIN,
         minTds
@@ -232,7 +245,9 @@ auto GuardianProxy::SaveTdsLimitsInStorage(int minTds, bool minEnabled, int maxT
         maxEnabled
     );
 
-    return (successMin && successMinEn && successMax && successMaxEn);
+    const bool saved = transaction.Commit();
+
+    return NotifyConfigChanged(saved && successMin && successMinEn && successMax && successMaxEn, Events::ConfigChanged::Section::TDS_LIMITS);
 }
 
 //----IStorageService-----------------------------------------------------------
@@ -256,51 +271,70 @@ auto GuardianProxy::GetTdsLimitsFromStorage(int& minTds, bool& minEnabled, int&
 }
 
 //----IStorageService-----------------------------------------------------------
-auto GuardianProxy::SaveFeedingScheduleInStorage(const int timeMinutesAfterMidnight, const int slotIndex, const int dose, const bool enabled) -> bool
+auto GuardianProxy::SaveTrendSensitivityInStorage(bool enabled, float tempRatePerHour, int tdsRatePerHour, float spikeZScore) -> bool
 {
-    auto scheduleList = Services::StorageService::GetInstance()->Get<Services::FeeddingScheduleList>(
-        Services::FieldId::FEEDING_SCHEDULE
+    Services::ConfigTransaction transaction;
+
+    bool successEn = Services::StorageService::GetInstance()->Set<bool>(
+        Services::FieldId::TREND_ENABLED,
+        enabled
     );
 
-    // Find existing entry by slotIndex
-    auto it = std::find_if(
-        scheduleList.begin(),
-        scheduleList.end(),
-        [slotIndex](const Services::FeedingScheduleEntry& entry)
-        {
-            return entry._id == slotIndex;
-        }
+    bool successTemp = Services::StorageService::GetInstance()->Set<float>(
+        Services::FieldId::TEMP_RATE_LIMIT,
+        tempRatePerHour
     );
 
-    if (it != scheduleList.end())
-    {
-        // Update existing entry
-        it->_min = timeMinutesAfterMidnight;
-        it->_dose = dose;
-        it->_enabled = enabled;
-    }
-    else
-    {
-        // Add new entry
-        Services::FeedingScheduleEntry newEntry;
-        newEntry._min = timeMinutesAfterMidnight;
-        newEntry._id = slotIndex;
-        newEntry._dose = dose;
-        newEntry._enabled = enabled;
-        scheduleList.push_back(newEntry);
-    }
+    bool successTds = Services::StorageService::GetInstance()->Set<int>(
+        Services::FieldId::TDS_RATE_LIMIT,
+        tdsRatePerHour
+    );
 
-    // Save updated schedule back to storage
-    return Services::StorageService::GetInstance()->Set<Services::FeeddingScheduleList>(
-        Services::FieldId::FEEDING_SCHEDULE,
-        scheduleList
+    bool successSpike = Services::StorageService::GetInstance()->Set<float>(
+        Services::FieldId::SPIKE_Z_SCORE,
+        spikeZScore
     );
+
+    const bool saved = transaction.Commit();
+
+    return NotifyConfigChanged(saved && successEn && successTemp && successTds && successSpike, Events::ConfigChanged::Section::TREND_SENSITIVITY);
 }
 
 //----IStorageService-----------------------------------------------------------
-auto GuardianProxy::GetFeedingScheduleFromStorage() const -> Services::FeeddingScheduleList
+auto GuardianProxy::GetTrendSensitivityFromStorage(bool& enabled, float& tempRatePerHour, int& tdsRatePerHour, float& spikeZScore) const -> void
 {
-    return Services::StorageService::GetInstance()->Get<Services::FeeddingScheduleList>(
+    enabled = Services::StorageService::GetInstance()->Get<bool>(
+        Services::FieldId::TREND_ENABLED
+    );
+
+    tempRatePerHour = Services::StorageService::GetInstance()->Get<float>(
+        Services::FieldId::TEMP_RATE_LIMIT
+    );
+
+    tdsRatePerHour = Services::StorageService::GetInstance()->Get<int>(
+        Services::FieldId::TDS_RATE_LIMIT
+    );
+
+    spikeZScore = Services::StorageService::GetInstance()->Get<float>(
+        Services::FieldId::SPIKE_Z_SCORE
+    );
+}
+
+//----IStorageService-----------------------------------------------------------
+auto GuardianProxy::SaveFeedingScheduleInStorage(const int timeMinutesAfterMidnight, const int slotIndex, const int dose, const bool enabled) -> bool
+{
+    // Like the removal: read and written back under the storage lock, as one change
+    const bool success = Services::StorageService::GetInstance()->SaveFeedingScheduleInStorage(
+        timeMinutesAfterMidnight, slotIndex, dose, enabled
+    );
+
+    return NotifyConfigChanged(success, Events::ConfigChanged::Section::FEEDING_SCHEDULE);
+}
+
+//----IStorageService-----------------------------------------------------------
+auto GuardianProxy::GetFeedingScheduleFromStorage() const -> Services::ConfigView<Services::FeeddingScheduleList>
+{
+    return Services::StorageService::GetInstance()->View<Services::FeeddingScheduleList>(
         Services::FieldId::FEEDING_SCHEDULE
     );
 }
@@ -308,19 +342,32 @@ auto GuardianProxy::GetFeedingScheduleFromStorage() const -> Services::FeeddingS
 //----IStorageService-----------------------------------------------------------
 auto GuardianProxy::RemoveFeedingScheduleFromStorage(const int slotIndex) -> bool
 { 
-    return Services::StorageService::GetInstance()->RemoveFeedingScheduleFromStorage(slotIndex);
+    const bool success = Services::StorageService::GetInstance()->RemoveFeedingScheduleFromStorage(slotIndex);
+
+    return NotifyConfigChanged(success, Events::ConfigChanged::Section::FEEDING_SCHEDULE);
 }
 
 //----IStorageService-----------------------------------------------------------
-auto GuardianProxy::FactoryReset() -> Result
+auto GuardianProxy::GetConfigWriteStats() const -> Services::StorageService::WriteStats
 {
-    return Services::StorageService::GetInstance()->SetDefaultConfig();
+    return Services::StorageService::GetInstance()->GetWriteStats();
 }
 
-//----IUserInterface------------------------------------------------------------
-void GuardianProxy::UpdateFeedingStatusIndicator(bool isFeeding)
+//----IStorageService-----------------------------------------------------------
+auto GuardianProxy::FactoryReset() -> Result
 {
-    Managers::UserInterface::GetInstance()->UpdateFeedingStatusIndicator(isFeeding);
+    const Result result = Services::StorageService::GetInstance()->SetDefaultConfig();
+
+    if (result.success)
+    {
+        // Republish the state derived from the configuration before the subscribers redraw / resend it
+        Managers::WaterMonitor::GetInstance()->PublishState();
+        Managers::FoodFeeder::GetInstance()->PublishState();
+    }
+
+    NotifyConfigChanged(result.success, Events::ConfigChanged::Section::ALL);
+
+    return result;
 }
 
 //----IWaterMonitor-------------------------------------------------------------
@@ -371,4 +418,64 @@ auto GuardianProxy::IsTdsOutOfLimits() const -> bool
     return Managers::WaterMonitor::GetInstance()->IsTdsOutOfLimits();
 }
 
+//----IWaterMonitor-------------------------------------------------------------
+auto GuardianProxy::SetTrendSensitivity(const bool enabled, const float tempRatePerHour, const int tdsRatePerHour, const float spikeZScore) -> Result
+{
+    return Managers::WaterMonitor::GetInstance()->SetTrendSensitivity(enabled, tempRatePerHour, tdsRatePerHour, spikeZScore);
+}
+
+//----IWaterMonitor-------------------------------------------------------------
+auto GuardianProxy::GetTrendSensitivity(bool& enabled, float& tempRatePerHour, int& tdsRatePerHour, float& spikeZScore) const -> void
+{
+    Managers::WaterMonitor::GetInstance()->GetTrendSensitivity(enabled, tempRatePerHour, tdsRatePerHour, spikeZScore);
+}
+
+//----System snapshot-----------------------------------------------------------
+auto GuardianProxy::GetSnapshot() const -> SystemSnapshot
+{
+    SystemSnapshot snapshot;
+    snapshot.generation = _snapshot.Read(snapshot);
+    return snapshot;
+}
+
+//----System snapshot-----------------------------------------------------------
+void GuardianProxy::PublishWaterState(const SystemSnapshot::Water& water)
+{
+    _snapshot.Update([&water](SystemSnapshot& snapshot) { snapshot.water = water; });
+}
+
+//----System snapshot-----------------------------------------------------------
+void GuardianProxy::PublishFeederState(const SystemSnapshot::Feeder& feeder, const SystemSnapshot::Clock& clock)
+{
+    _snapshot.Update([&feeder, &clock](SystemSnapshot& snapshot)
+        {
+            snapshot.feeder = feeder;
+            snapshot.clock = clock;
+        }
+    );
+}
+
+//----System snapshot-----------------------------------------------------------
+void GuardianProxy::PublishConnectivityState(const SystemSnapshot::Connectivity& connectivity)
+{
+    _snapshot.Update([&connectivity](SystemSnapshot& snapshot) { snapshot.connectivity = connectivity; });
+}
+
+//----System snapshot-----------------------------------------------------------
+void GuardianProxy::PublishPowerState(const SystemSnapshot::Power& power)
+{
+    _snapshot.Update([&power](SystemSnapshot& snapshot) { snapshot.power = power; });
+}
+
+//----private------------------------------------------------------------------
+bool GuardianProxy::NotifyConfigChanged(bool saved, Events::ConfigChanged::Section section)
+{
+    if (saved)
+    {
+        EventBus::Publish(Events::ConfigChanged{ section });
+    }
+
+    return saved;
+}
+
 } // namespace Core
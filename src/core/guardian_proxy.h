@@ -10,8 +10,11 @@
 #pragma once
 
 #include "framework/common_defs.h"
+#include "framework/os/seqlock.h"
 #include "src/core/guardian_public_interfaces.h"
 #include "src/core/base/module.h"
+#include "src/core/events.h"
+#include "src/core/system_snapshot.h"
 
 namespace Core {
 
@@ -22,7 +25,6 @@ class GuardianProxy : public Base::Singleton<GuardianProxy>,
                       public INetworkController,
                       public IPowerController,
                       public IRealTimeClock,
-                      public IUserInterface,
                       public IWaterMonitor
 {
     public:
@@ -39,7 +41,7 @@ class GuardianProxy : public Base::Singleton<GuardianProxy>,
         auto DeleteFeedingScheduleEntry(int slotIndex) -> Result override;
 
         //! Get feeder information
-        auto GetFeederStatus() const -> Managers::FoodFeeder::FeederStatus override;
+        auto GetFeederStatus() const -> FeederStatus override;
 
     // INetworkController --------------------------------------------------------
 
@@ -50,7 +52,7 @@ class GuardianProxy : public Base::Singleton<GuardianProxy>,
         auto IsWifiConnected() const -> bool override;
 
         //! Get connected WiFi SSID
-        auto GetWifiSsid() const -> std::string override;
+        auto GetWifiSsid() const -> const char* override;
 
         //! Get WiFi RSSI in dBm
         auto GetWifiRssi() const -> int8_t override;
@@ -88,17 +90,17 @@ class GuardianProxy : public Base::Singleton<GuardianProxy>,
         //! Save WiFi credentials
         auto SaveWifiCredentialsInStorage(const std::string& ssid, const std::string& password) -> bool override;
 
-        //! Get WiFi SSID
-        auto GetWifiSsidFromStorage() const -> std::string override;
+        //! Get WiFi SSID, read in place (holds the storage lock while the view lives)
+        auto GetWifiSsidFromStorage() const -> Services::ConfigView<std::string> override;
 
-        //! Get WiFi Password
-        auto GetWifiPasswordFromStorage() const -> std::string override;
+        //! Get WiFi Password, read in place (holds the storage lock while the view lives)
+        auto GetWifiPasswordFromStorage() const -> Services::ConfigView<std::string> override;
         
         //! Save timezone at EEPROM
         auto SaveTimezoneInStorage(const std::string& tz) -> bool override;
 
-        //! Get timezone from EEPROM
-        auto GetTimezoneFromStorage() const -> std::string override;
+        //! Get timezone from EEPROM, read in place (holds the storage lock while the view lives)
+        auto GetTimezoneFromStorage() const -> Services::ConfigView<std::string> override;
 
         //! Save temperature limits in storage
         auto SaveTempLimitsInStorage(float minTemp, bool minEnabled, float maxTemp, bool maxEnabled) -> bool override;
@@ -112,23 +114,27 @@ class GuardianProxy : public Base::Singleton<GuardianProxy>,
         //! Get TDS limits from storage
         auto GetTdsLimitsFromStorage(int& minTds, bool& minEnabled, int& maxTds, bool& maxEnabled) const -> void override;
 
+        //! Save the early-warning sensitivity in storage
+        auto SaveTrendSensitivityInStorage(bool enabled, float tempRatePerHour, int tdsRatePerHour, float spikeZScore) -> bool override;
+
+        //! Get the early-warning sensitivity from storage
+        auto GetTrendSensitivityFromStorage(bool& enabled, float& tempRatePerHour, int& tdsRatePerHour, float& spikeZScore) const -> void override;
+
         //! Save feeding schedule in storage
         auto SaveFeedingScheduleInStorage(const int timeMinutesAfterMidnight, const int slotIndex, const int dose, const bool enabled) -> bool override;
     
-        //! Get feeding schedule list
-        auto GetFeedingScheduleFromStorage() const -> Services::FeeddingScheduleList override;
+        //! Feeding schedule list, read in place (holds the storage lock while the view lives)
+        auto GetFeedingScheduleFromStorage() const -> Services::ConfigView<Services::FeeddingScheduleList> override;
         
         //! Remove feeding schedule from storage
         auto RemoveFeedingScheduleFromStorage(const int slotIndex) -> bool override;
 
+        //! EEPROM writes of the config changes since boot
+        auto GetConfigWriteStats() const -> Services::StorageService::WriteStats override;
+
         //! Factory reset (clear all stored data)
         auto FactoryReset() -> Result override;
         
-    // IUserInterface --------------------------------------------------------
-
-        //! Update feeding status indicator
-        void UpdateFeedingStatusIndicator(bool isFeeding) override;
-
     // IWaterMonitor --------------------------------------------------------
 
         //! Get last TDS reading
@@ -155,6 +161,29 @@ class GuardianProxy : public Base::Singleton<GuardianProxy>,
         //! Check if TDS reading is out of limits
         auto IsTdsOutOfLimits() const -> bool override;
 
+        //! Set the early-warning sensitivity (a limit of 0 turns that check off)
+        auto SetTrendSensitivity(const bool enabled, const float tempRatePerHour, const int tdsRatePerHour, const float spikeZScore) -> Result override;
+
+        //! Get the early-warning sensitivity
+        auto GetTrendSensitivity(bool& enabled, float& tempRatePerHour, int& tdsRatePerHour, float& spikeZScore) const -> void override;
+
+    // System snapshot -----------------------------------------------------------
+
+        //! Latest published state: lock-free and without I/O, from any task or core
+        auto GetSnapshot() const -> SystemSnapshot;
+
+        //! Publish readings, limits and alarms (WaterMonitor)
+        void PublishWaterState(const SystemSnapshot::Water& water);
+
+        //! Publish the feeding schedule, its status and the time it was computed for (FoodFeeder)
+        void PublishFeederState(const SystemSnapshot::Feeder& feeder, const SystemSnapshot::Clock& clock);
+
+        //! Publish the link states (NetworkController)
+        void PublishConnectivityState(const SystemSnapshot::Connectivity& connectivity);
+
+        //! Publish the power source and battery level
+        void PublishPowerState(const SystemSnapshot::Power& power);
+
     protected:
 
         friend class Base::Singleton<GuardianProxy>;
@@ -185,7 +214,15 @@ class GuardianProxy : public Base::Singleton<GuardianProxy>,
         GuardianProxy(const GuardianProxy&) = delete;
         GuardianProxy& operator=(const GuardianProxy&) = delete;
 
+        /*!
+         * @brief Publish ConfigChanged if the save succeeded.
+         * @return bool The save result, passed through.
+         */
+        bool NotifyConfigChanged(bool saved, Events::ConfigChanged::Section section);
+
         //---------------------------------------------
+
+        Seqlock<SystemSnapshot> _snapshot;
 };
 
 } // namespace Core
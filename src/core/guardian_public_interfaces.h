@@ -9,7 +9,7 @@
 
 #pragma once
 
-#include "src/managers/food_feeder.h"
+#include "src/core/feeder_status.h"
 #include "src/services/power_controller.h"
 #include "src/services/storage_service.h"
 #include "src/utils/date_time.h"
@@ -33,7 +33,7 @@ class IFoodFeeder
         virtual auto DeleteFeedingScheduleEntry(int slotIndex) -> Result = 0;
 
         //! Get feeder information
-        virtual auto GetFeederStatus() const -> Managers::FoodFeeder::FeederStatus = 0;
+        virtual auto GetFeederStatus() const -> FeederStatus = 0;
 };
 
 //-----------------------------------------------------------------------------
@@ -48,7 +48,7 @@ class INetworkController
         virtual auto IsWifiConnected() const -> bool = 0;
 
         //! Get connected WiFi SSID (empty when disconnected)
-        virtual auto GetWifiSsid() const -> std::string = 0;
+        virtual auto GetWifiSsid() const -> const char* = 0;
 
         //! Get WiFi RSSI in dBm (0 when disconnected)
         virtual auto GetWifiRssi() const -> int8_t = 0;
@@ -98,17 +98,17 @@ class IStorageService
         //! Save WiFi credentials
         virtual bool SaveWifiCredentialsInStorage(const std::string& ssid, const std::string& password) = 0;
 
-        //! Get WiFi SSID
-        virtual std::string GetWifiSsidFromStorage() const = 0;
+        //! Get WiFi SSID, read in place
+        virtual auto GetWifiSsidFromStorage() const -> Services::ConfigView<std::string> = 0;
 
-        //! Get WiFi Password
-        virtual std::string GetWifiPasswordFromStorage() const = 0;
+        //! Get WiFi Password, read in place
+        virtual auto GetWifiPasswordFromStorage() const -> Services::ConfigView<std::string> = 0;
 
         //! Save timezone at EEPROM
         virtual bool SaveTimezoneInStorage(const std::string& tz) = 0;
 
-        //! Get timezone from EEPROM
-        virtual std::string GetTimezoneFromStorage() const = 0;
+        //! Get timezone from EEPROM, read in place
+        virtual auto GetTimezoneFromStorage() const -> Services::ConfigView<std::string> = 0;
 
         //! Save temperature limits in storage
         virtual auto SaveTempLimitsInStorage(float minTemp, bool minEnabled, float maxTemp, bool maxEnabled) -> bool = 0;
@@ -122,28 +122,28 @@ class IStorageService
         //! Get TDS limits from storage
         virtual auto GetTdsLimitsFromStorage(int& minTds, bool& minEnabled, int& maxTds, bool& maxEnabled) const -> void = 0;
 
+        //! Save the early-warning sensitivity in storage
+        virtual auto SaveTrendSensitivityInStorage(bool enabled, float tempRatePerHour, int tdsRatePerHour, float spikeZScore) -> bool = 0;
+
+        //! Get the early-warning sensitivity from storage
+        virtual auto GetTrendSensitivityFromStorage(bool& enabled, float& tempRatePerHour, int& tdsRatePerHour, float& spikeZScore) const -> void = 0;
+
         //! Save feeding schedule in storage
         virtual auto SaveFeedingScheduleInStorage(const int timeMinutesAfterMidnight, const int slotIndex, const int dose, const bool enabled) -> bool = 0;
 
-        //! Get feeding schedule list
-        virtual auto GetFeedingScheduleFromStorage() const -> Services::FeeddingScheduleList = 0;
+        //! Feeding schedule list, read in place (holds the storage lock while the view lives)
+        virtual auto GetFeedingScheduleFromStorage() const -> Services::ConfigView<Services::FeeddingScheduleList> = 0;
 
         //! Remove feeding schedule from storage
         virtual auto RemoveFeedingScheduleFromStorage(const int slotIndex) -> bool = 0;
 
+        //! EEPROM writes of the config changes since boot
+        virtual auto GetConfigWriteStats() const -> Services::StorageService::WriteStats = 0;
+
         //! Factory reset (clear all stored data)
         virtual auto FactoryReset() -> Result = 0;
 };
 
-//-----------------------------------------------------------------------------
-class IUserInterface
-{
-    public:
-
-        //! Update feeding status indicator
-        virtual void UpdateFeedingStatusIndicator(bool isFeeding) = 0;
-};
-
 //-----------------------------------------------------------------------------
 class IWaterMonitor
 {
@@ -172,6 +172,12 @@ class IWaterMonitor
 
         //! Check if TDS reading is out of limits
         virtual auto IsTdsOutOfLimits() const -> bool = 0;
+
+        //! Set the early-warning sensitivity (a limit of 0 turns that check off)
+        virtual auto SetTrendSensitivity(const bool enabled, const float tempRatePerHour, const int tdsRatePerHour, const float spikeZScore) -> Result = 0;
+
+        //! Get the early-warning sensitivity
+        virtual auto GetTrendSensitivity(bool& enabled, float& tempRatePerHour, int& tdsRatePerHour, float& spikeZScore) const -> void = 0;
 };
 
 } // namespace Core
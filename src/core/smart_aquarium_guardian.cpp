@@ -9,59 +9,82 @@
 
 #include "framework/common_defs.h"
 #include "include/config.h"
+#include "src/core/boot_orchestrator.h"
 #include "src/core/guardian_proxy.h"
 #include "src/managers/food_feeder.h"
 #include "src/managers/network_controller.h"
 #include "src/managers/user_interface.h"
 #include "src/managers/water_monitor.h"
+#include "src/services/adc_sampler.h"
 #include "src/services/power_controller.h"
+#include "src/services/history_log.h"
+#include "src/services/reading_history.h"
 #include "src/services/real_time_clock.h"
 #include "src/services/storage_service.h"
+#include <optional>
 
 //----private------------------------------------------------------------------
 bool SmartAquariumGuardian::OnInit()
 {
-    // Create and initialize the GuardianProxy
-    Core::GuardianProxy::GetInstance()->Init();
+    using Boot = Core::BootOrchestrator;
+    auto* boot = Boot::GetInstance();
 
-    // Display + backlight draw high current; delay after before starting network
-    Managers::UserInterface::GetInstance()->Init(300);
+    // Dependencies and power constraints replace the fixed order and sleeps.
+    // Settle timeouts are the delays the serial sequence used to apply
+    const Boot::StepId proxy = boot->Add({ "GuardianProxy", Core::GuardianProxy::GetInstance() });
+    const Boot::StepId adc = boot->Add({ "AdcSampler", Services::AdcSampler::GetInstance() });
+    const Boot::StepId power = boot->Add({ "PowerController", Services::PowerController::GetInstance(), Boot::After(adc) });
 
-    // Initialize services
-    Services::RealTimeClock::GetInstance()->Init(100);
-    Services::StorageService::GetInstance()->Init(100);
-    Services::PowerController::GetInstance()->Init(100);
+    // RTC and EEPROM share the I2C bus: keep the config load after the clock is up
+    const Boot::StepId rtc = boot->Add({ "RealTimeClock", Services::RealTimeClock::GetInstance() });
+    const Boot::StepId storage = boot->Add({ "StorageService", Services::StorageService::GetInstance(), Boot::After(rtc) });
 
-    // Initialize managers (sensors first, low current)
-    Managers::WaterMonitor::GetInstance()->Init(200);
+    // Steps with inrush come after the power step: their settling is measured on its supply reading.
+    // LVGL splash on the APP core while Wi-Fi comes up on the PRO core
+    boot->Add({ "UserInterface", Managers::UserInterface::GetInstance(), Boot::After(proxy, power),
+                Config::DISPLAY_INRUSH_MA, 300, 1 });
 
-    // Servo init can draw significant current; delay after so supply can settle
-    Managers::FoodFeeder::GetInstance()->Init(400);
+    boot->Add({ "NetworkController", Managers::NetworkController::GetInstance(), Boot::After(proxy, storage, power),
+                Config::WIFI_INRUSH_MA, 500, 0 });
 
-    Managers::NetworkController::GetInstance()->Init();
+    // Publishes limits (storage) and power mode in the snapshot; the TDS probe samples through the ADC service
+    // The history log mounts the spiffs partition (a power cut may leave a sector to erase)
+    const Boot::StepId history = boot->Add({ "ReadingHistory", Services::ReadingHistory::GetInstance() });
+    const Boot::StepId historyLog = boot->Add({ "HistoryLog", Services::HistoryLog::GetInstance() });
+    boot->Add({ "WaterMonitor", Managers::WaterMonitor::GetInstance(), Boot::After(proxy, storage, power, adc, history, historyLog) });
 
-    _delay.Start(Config::SYSTEM_TIME_INCREMENT_MS);
+    // Publishes the schedule (storage) and time (RTC); the servo waits for the display and radio to settle
+    boot->Add({ "FoodFeeder", Managers::FoodFeeder::GetInstance(), Boot::After(proxy, storage, rtc, historyLog, power),
+                Config::SERVO_INRUSH_MA, 400 });
 
-    return true;
-}
+    auto readSupply = []() -> std::optional<float>
+    {
+        const auto* powerController = Services::PowerController::GetInstance();
+        if (!powerController->HasSupplyReading())
+        {
+            return std::nullopt;
+        }
+        return powerController->ReadSupplyVoltage();
+    };
 
-//----private------------------------------------------------------------------
-void SmartAquariumGuardian::OnUpdate()
-{
-    // Periodic update
-    // Only proceed if the delay has finished
-    // This ensures the update runs at a fixed interval
-    if (_delay.HasFinished())
+    if (!boot->Run(_clock, readSupply))
     {
-        CORE_INFO("Starting periodic update...");
+        CORE_WARNING("Some modules failed to initialize");
+    }
 
-        Managers::WaterMonitor::GetInstance()->Update(100);
-        Managers::FoodFeeder::GetInstance()->Update(100);
-        Managers::UserInterface::GetInstance()->Update(100);
+    // Each manager declares its own period, deadline and wake sources
+    bool attached = true;
+    attached &= Managers::WaterMonitor::GetInstance()->Attach(_scheduler);
+    attached &= Managers::FoodFeeder::GetInstance()->Attach(_scheduler);
+    attached &= Managers::UserInterface::GetInstance()->Attach(_scheduler);
+    attached &= Managers::NetworkController::GetInstance()->Attach(_scheduler);
 
-        CORE_INFO("Periodic update completed.");
-    }
+    return attached;
+}
 
-    // Always update Network Controller to handle connectivity and time sync
-    Managers::NetworkController::GetInstance()->Update();
+//----private------------------------------------------------------------------
+void SmartAquariumGuardian::OnUpdate()
+{
+    // Runs the managers that are due, then sleeps until the next release or notification
+    _scheduler.RunOnce();
 }
\ No newline at end of file
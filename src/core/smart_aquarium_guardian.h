@@ -8,7 +8,8 @@
 #ifndef SMART_AQUARIUM_GUARDIAN_H
 #define SMART_AQUARIUM_GUARDIAN_H
 
-#include "framework/util/delay.h"
+#include "framework/os/rtos_clock.h"
+#include "framework/os/scheduler.h"
 #include "src/core/base/manager.h"
 
 class SmartAquariumGuardian : public Base::Singleton<SmartAquariumGuardian>,
@@ -32,21 +33,22 @@ class SmartAquariumGuardian : public Base::Singleton<SmartAquariumGuardian>,
         bool OnInit() override;
 
         /*!
-         * @brief Updates the SmartAquariumGuardian state.
-         *        This method should be called periodically to update the system state.
+         * @brief Runs every manager that is due and blocks until the next release.
+         *        This method should be called in a loop from the main task.
          */
         void OnUpdate() override;
 
     private:
 
-        SmartAquariumGuardian() {}
+        SmartAquariumGuardian() : _scheduler(_clock) {}
         ~SmartAquariumGuardian() = default;
         SmartAquariumGuardian(const SmartAquariumGuardian&) = delete;
         SmartAquariumGuardian& operator=(const SmartAquariumGuardian&) = delete;
 
         //---------------------------------------------
 
-        Delay _delay;
+        RtosClock _clock;
+        Scheduler _scheduler;
 };
 
 #endif // SMART_AQUARIUM_GUARDIAN_H
\ No newline at end of file
@@ -0,0 +1,108 @@
+/*!****************************************************************************
+ * @file    system_snapshot.h
+ * @brief   Immutable view of the system state shown by the UI and sent to the
+ *          cloud. Each section is published by the manager that owns the
+ *          data (see GuardianProxy::Publish*), so readers get it without
+ *          locks, storage reads or bus transactions.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ *******************************************************************************/
+
+#pragma once
+
+#include "esp_timer.h"
+#include "src/drivers/temperature_sensor.h"
+#include "src/core/feeder_status.h"
+#include "src/services/memory/memory_config_data.h"
+#include "src/services/power_controller.h"
+#include "src/utils/date_time.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace Core {
+
+struct SystemSnapshot
+{
+    static constexpr size_t MAX_SCHEDULE_ENTRIES = Services::MAX_FEEDING_SCHEDULE_ENTRIES;
+    static constexpr size_t SSID_SIZE = 33;                 //!< 32 chars + terminator
+    static constexpr size_t MAX_TEMPERATURE_CHANNELS = Drivers::TemperatureSensor::MAX_CHANNELS;
+
+    //! Published by WaterMonitor
+    struct Water
+    {
+        float temperature = 0.0f;                       //!< Channel 0, the one limits apply to
+        int tds = 0;
+
+        float channelTemperatures[MAX_TEMPERATURE_CHANNELS] = {};
+        size_t temperatureChannelCount = 0;
+
+        float minTemp = 0.0f;
+        bool minTempEnabled = false;
+        float maxTemp = 0.0f;
+        bool maxTempEnabled = false;
+
+        int minTds = 0;
+        bool minTdsEnabled = false;
+        int maxTds = 0;
+        bool maxTdsEnabled = false;
+
+        bool temperatureOutOfLimits = false;
+        bool tdsOutOfLimits = false;
+
+        float temperatureRatePerHour = 0.0f;            //!< Fitted over the trend window (0 until judged)
+        float tdsRatePerHour = 0.0f;
+        bool temperatureWarning = false;                //!< Rate or jump past the sensitivity settings
+        bool tdsWarning = false;
+    };
+
+    //! Published by FoodFeeder
+    struct Feeder
+    {
+        Services::FeedingScheduleEntry schedule[MAX_SCHEDULE_ENTRIES];
+        size_t scheduleCount = 0;
+        FeederStatus status{};
+    };
+
+    //! Published by FoodFeeder, which reads the RTC every update anyway
+    struct Clock
+    {
+        Utils::DateTime time;
+        int64_t sampledUs = 0;          //!< esp_timer time of the RTC read
+        bool valid = false;
+        bool synced = false;
+
+        //! Date and time advanced by the time elapsed since the RTC was read
+        Utils::DateTime Now() const
+        {
+            const uint32_t elapsedSeconds = static_cast<uint32_t>((esp_timer_get_time() - sampledUs) / 1000000);
+            return time.AddSeconds(elapsedSeconds);
+        }
+    };
+
+    //! Published by NetworkController
+    struct Connectivity
+    {
+        bool wifiConnected = false;
+        bool mqttConnected = false;
+        bool apPortalActive = false;
+        int8_t wifiRssi = 0;
+        char wifiSsid[SSID_SIZE] = {};
+    };
+
+    //! Published by WaterMonitor next to the readings
+    struct Power
+    {
+        Services::PowerController::Mode mode = Services::PowerController::Mode::_size;
+        Services::PowerController::BatteryLevel batteryLevel = Services::PowerController::BatteryLevel::_size;
+    };
+
+    Water water;
+    Feeder feeder;
+    Clock clock;
+    Connectivity connectivity;
+    Power power;
+
+    uint32_t generation = 0;            //!< Publications so far, 0 until the first one
+};
+
+} // namespace Core
@@ -7,6 +7,7 @@
 
 #include "src/drivers/graphic_display.h"
 #include "esp_err.h"
+#include "framework/os/trace.h"
 #include "include/config.h"
 #include "lvgl.h"
 #include "driver/ledc.h"
@@ -17,6 +18,17 @@ extern "C" {
 
 namespace Drivers {
 
+namespace {
+
+//! Waits on the LVGL port lock; the wait shows up in traces as "LvglLock"
+bool LockLvgl()
+{
+    CORE_TRACE_SCOPE("LvglLock");
+    return lvgl_port_lock(portMAX_DELAY);
+}
+
+} // namespace
+
 //-----------------------------------------------------------------------------
 GraphicDisplay::UIElement::UIElement(lv_obj_t * lv_obj) 
     : _lv_obj(lv_obj)
@@ -34,7 +46,7 @@ void GraphicDisplay::UIElement::SetText(const char* newText)
     if (_lv_obj == nullptr) 
         return;
 
-    if (lvgl_port_lock(portMAX_DELAY))
+    if (LockLvgl())
     {
         lv_label_set_text(_lv_obj, newText);
         lvgl_port_unlock();
@@ -47,7 +59,7 @@ void GraphicDisplay::UIElement::Hide()
     if (_lv_obj == nullptr)
         return;
 
-    if (lvgl_port_lock(portMAX_DELAY))
+    if (LockLvgl())
     {
         lv_obj_add_flag(_lv_obj, LV_OBJ_FLAG_HIDDEN);
         lvgl_port_unlock();
@@ -60,7 +72,7 @@ void GraphicDisplay::UIElement::Show()
     if (_lv_obj == nullptr)
         return;
 
-    if (lvgl_port_lock(portMAX_DELAY))
+    if (LockLvgl())
     {
         lv_obj_clear_flag(_lv_obj, LV_OBJ_FLAG_HIDDEN);
         lvgl_port_unlock();
@@ -73,7 +85,7 @@ void GraphicDisplay::UIElement::SetState1()
     if (_lv_obj == nullptr)
         return;
 
-    if (lvgl_port_lock(portMAX_DELAY))
+    if (LockLvgl())
     {
         lv_obj_add_state(_lv_obj, LV_STATE_USER_1);
         lvgl_port_unlock();
@@ -86,7 +98,7 @@ void GraphicDisplay::UIElement::ClearState1()
     if (_lv_obj == nullptr)
         return;
 
-    if (lvgl_port_lock(portMAX_DELAY))
+    if (LockLvgl())
     {
         lv_obj_clear_state(_lv_obj, LV_STATE_USER_1);
         lvgl_port_unlock();
@@ -18,14 +18,30 @@ bool TdsSensor::OnInit()
 {
     _temperature = 25.0f; // Default to 25°C for initial readings
     _lastReading = 0;
-    return true;
+
+    _adcChannel = Services::AdcSampler::GetInstance()->AddChannel(Config::TDS_SENSOR_ADC_PIN);
+    return (_adcChannel != Services::AdcSampler::INVALID_CHANNEL);
 }
 
 //-----------------------------------------------------------------------------
 void TdsSensor::OnUpdate()
 {
-    const float analogReading = _analogInPin.ReadVoltage(64);
-    const float avgAnalogReading = StoreAnalogReading(analogReading);
+    // Oversampled in the background by the AdcSampler
+    const auto* sampler = Services::AdcSampler::GetInstance();
+    if (!sampler->HasReading(_adcChannel))
+    {
+        CORE_WARNING("No TDS sample yet");
+        return;
+    }
+
+    const float analogReading = sampler->ReadVoltage(_adcChannel);
+    if (analogReading < 0.0f || analogReading > MAX_ANALOG_VOLTAGE)
+    {
+        CORE_ERROR("Invalid analog reading: %.4f", analogReading);
+        return;
+    }
+
+    const float avgAnalogReading = _filter.Process(analogReading);
 
     // Logic to transform reading to ppm units
     // ppm = (133.42 * V³ - 255.86 * V² + 857.39 * V) / factorTemp * 0.5
@@ -48,45 +64,9 @@ int TdsSensor::GetLastReading()
     return _lastReading;
 }
 
-//----private------------------------------------------------------------------
-float TdsSensor::StoreAnalogReading(const float reading)
-{
-    if (reading < 0.0f || reading > 3.3f)
-    {
-        CORE_ERROR("Invalid analog reading: %.4f", reading);
-        return 0.0f;
-    }
-
-    // Add reading to vector
-    (*_analogReadingsVecIter) = reading;
-
-    // Check if we were at last element of the readings vector
-    if (_analogReadingsVecIter++ >= _analogReadingsVec.end())
-    {
-        _analogReadingsVecIter = _analogReadingsVec.begin();
-    }
-
-    // Obtain average
-    float tdsReadingSum = 0.0;
-    int amountOfReadings = 0;
-    for (auto it = _analogReadingsVec.begin(); it != _analogReadingsVec.end(); ++it) 
-    {
-        if ((*it) > -1.0f)
-        {
-            tdsReadingSum += (*it);
-            ++amountOfReadings;
-        }
-    }
-
-    float avgAnalogReading = (tdsReadingSum / amountOfReadings);
-    return avgAnalogReading;
-}
-
 //----private------------------------------------------------------------------
 TdsSensor::TdsSensor()
-    : _analogInPin(Config::TDS_SENSOR_ADC_PIN)
-    , _analogReadingsVec(NUM_AVG_SAMPLES, -1.0)
-    , _analogReadingsVecIter(_analogReadingsVec.begin())
+    : _adcChannel(Services::AdcSampler::INVALID_CHANNEL)
 {
 }
 
@@ -10,7 +10,10 @@
 
 #include "src/core/base/driver.h"
 #include "framework/common_defs.h"
-#include <vector>
+#include "framework/dsp/filter_chain.h"
+#include "framework/dsp/hampel_filter.h"
+#include "framework/dsp/moving_average.h"
+#include "src/services/adc_sampler.h"
 
 namespace Drivers { 
 
@@ -55,16 +58,14 @@ class TdsSensor : public Base::Singleton<TdsSensor>,
         void OnUpdate() override;
 
     private:
-    
-        /*!
-        * @brief Stores an analog reading and returns the average of the stored readings.
-        * @param reading The new analog reading to store.
-        * @return float The average of the stored analog readings.
-        */
-        float StoreAnalogReading(const float reading);
 
-        using TdsReadingsVec = std::vector<float>;
-    
+        static constexpr size_t NUM_AVG_SAMPLES = 12;
+        static constexpr size_t OUTLIER_WINDOW = 5;
+
+        //! Spikes (bubbles on the electrodes, pump switching) are dropped before averaging
+        using ReadingFilter = Dsp::FilterChain<Dsp::HampelFilter<float, OUTLIER_WINDOW>,
+                                               Dsp::MovingAverage<float, NUM_AVG_SAMPLES>>;
+
         //---------------------------------------------
 
         TdsSensor();
@@ -74,17 +75,15 @@ class TdsSensor : public Base::Singleton<TdsSensor>,
 
         //---------------------------------------------
 
-        static constexpr int NUM_AVG_SAMPLES = 12;
-        
+        static constexpr float MAX_ANALOG_VOLTAGE = 3.3f;
+
         static constexpr int MIN_TDS_VALUE   = 0;
         static constexpr int MAX_TDS_VALUE   = 999;
 
         //---------------------------------------------
 
-        AnalogIn _analogInPin;
-        
-        TdsReadingsVec _analogReadingsVec;
-        TdsReadingsVec::iterator _analogReadingsVecIter;
+        Services::AdcSampler::ChannelId _adcChannel;
+        ReadingFilter _filter;
         
         float _temperature;
         int _lastReading;
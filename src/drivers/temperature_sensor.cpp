@@ -7,6 +7,7 @@
 
 #include "src/drivers/temperature_sensor.h"
 
+#include "esp_timer.h"
 #include "include/config.h"
 #include <algorithm>
 #include <cmath>
@@ -16,133 +17,287 @@ namespace Drivers {
 //----private------------------------------------------------------------------
 bool TemperatureSensor::OnInit()
 {
-    _lastReading = 0.0f;
+    _hasReading = false;
+
+    // Find the probes, configure them and start the first conversion, collected on the first update
+    if (DiscoverProbes())
+    {
+        StartConversion();
+    }
+
     return true;
 }
 
 //----private------------------------------------------------------------------
 void TemperatureSensor::OnUpdate()
 {
-    int16_t rawReading = GetRawReading();
-    if (rawReading == -1)
+    // Probes plugged in after boot (or a bus that failed at init) are picked up here
+    if (_channelCount == 0 && !DiscoverProbes())
     {
-        CORE_ERROR("Failed to get valid temperature reading!");
         return;
     }
-    
-    float rawReadingAvg = StoreReading(rawReading);
 
-    // Convert raw temperature to Celsius
-    _lastReading = (rawReadingAvg / 16.0f);
-    _lastReading = std::clamp(_lastReading, MIN_TEMP_VALUE, MAX_TEMP_VALUE);
+    if (_state == State::CONVERTING)
+    {
+        const uint64_t elapsedUs = esp_timer_get_time() - _conversionStartUs;
+        if (elapsedUs < GetConversionTimeMs(_conversionResolution) * 1000ULL)
+        {
+            // Updated before the conversion finished: keep the last reading
+            return;
+        }
+
+        CollectReadings();
+        UpdateAlarms();
+    }
 
-    CORE_INFO("Temperature avg reading - Celsius = %.2f", _lastReading);
+    StartConversion();
 }
 
 //-----------------------------------------------------------------------------
-float TemperatureSensor::GetLastReading() const
+float TemperatureSensor::GetLastReading(size_t channel) const
 {
-    // return (rand() % 4000 / 100.0f);
-    return _lastReading;
+    return (channel < _channelCount) ? _channels[channel].lastReading : 0.0f;
 }
 
-//----private------------------------------------------------------------------
-int16_t TemperatureSensor::GetRawReading()
+//-----------------------------------------------------------------------------
+void TemperatureSensor::SetResolution(Resolution resolution)
 {
-    if (!_oneWirePin.Reset())
+    if (resolution != _resolution)
     {
-        CORE_ERROR("No DS18B20 detected!");
-        return 0;
+        _resolution = resolution;
+        _configurationPending = true;
     }
+}
 
-    _oneWirePin.WriteByte(CMD_SKIP_ROM);
-    _oneWirePin.WriteByte(CMD_CONVERT_T);
-
-    // Wait for conversion (750 ms for 12-bit resolution)
-    TaskDelayMs(750);
+//-----------------------------------------------------------------------------
+void TemperatureSensor::SetAlarmLimits(size_t channel, int8_t low, int8_t high)
+{
+    if (channel >= _channelCount)
+    {
+        return;
+    }
 
-    if (!_oneWirePin.Reset())
+    Channel& entry = _channels[channel];
+    if (entry.alarmLow != low || entry.alarmHigh != high)
     {
-        CORE_ERROR("Lost device after conversion!");
-        return 0;
+        entry.alarmLow = low;
+        entry.alarmHigh = high;
+        _configurationPending = true;
     }
+}
 
-    _oneWirePin.WriteByte(CMD_SKIP_ROM);
-    _oneWirePin.WriteByte(CMD_READ_SCRATCH);
+//-----------------------------------------------------------------------------
+uint32_t TemperatureSensor::GetConversionTimeMs(Resolution resolution)
+{
+    // 93.75 ms at 9 bits, doubling with every extra bit (rounded up)
+    return ((93750U << static_cast<uint32_t>(resolution)) + 999) / 1000;
+}
 
-    uint8_t scratchpad[9];
-    for (int i = 0; i < 9; i++)
+//----private------------------------------------------------------------------
+bool TemperatureSensor::DiscoverProbes()
+{
+    _channelCount = 0;
+    _oneWirePin.ResetSearch();
+
+    OneWire::Rom rom;
+    while (_channelCount < MAX_CHANNELS && _oneWirePin.Search(rom))
     {
-        scratchpad[i] = _oneWirePin.ReadByte();
+        if (rom[0] != FAMILY_DS18B20)
+        {
+            CORE_WARNING("Skipping 1-Wire device of family 0x%02X", rom[0]);
+            continue;
+        }
+
+        _channels[_channelCount] = Channel{};
+        _channels[_channelCount].rom = rom;
+
+        CORE_INFO("DS18B20 channel %u: %02X%02X%02X%02X%02X%02X%02X%02X", static_cast<unsigned>(_channelCount),
+                  rom[0], rom[1], rom[2], rom[3], rom[4], rom[5], rom[6], rom[7]);
+        ++_channelCount;
     }
 
-    // Verify CRC
-    uint8_t crcCalculated = CalculateCRC8(scratchpad, 8);
-    if (crcCalculated != scratchpad[8])
+    if (_channelCount == 0)
     {
-        CORE_ERROR("DS18B20 CRC check failed! Calculated: 0x%02X, Received: 0x%02X", crcCalculated, scratchpad[8]);
-        return -1;
+        CORE_ERROR("No DS18B20 detected!");
+        return false;
     }
 
-    uint8_t tempLSB = scratchpad[0];
-    uint8_t tempMSB = scratchpad[1];
-
-    int16_t rawTemp = (tempMSB << 8) | tempLSB;
-    return rawTemp;
+    // New probes power up with their own configuration
+    _configurationPending = true;
+    return true;
 }
 
 //----private------------------------------------------------------------------
-float TemperatureSensor::StoreReading(float reading)
+bool TemperatureSensor::StartConversion()
 {
-    (*_rawReadingsVecIter) = reading;
+    _state = State::IDLE;
 
-    if (++_rawReadingsVecIter >= _rawReadingsVec.end())
+    if (_configurationPending)
     {
-        _rawReadingsVecIter = _rawReadingsVec.begin();
+        for (size_t i = 0; i < _channelCount; ++i)
+        {
+            if (!WriteConfiguration(i, _resolution))
+            {
+                CORE_ERROR("Failed to configure DS18B20 channel %u", static_cast<unsigned>(i));
+                return false;
+            }
+        }
+
+        _configurationPending = false;
+        CORE_INFO("DS18B20 resolution set to %d bits (%u ms conversion)",
+                  9 + static_cast<int>(_resolution), static_cast<unsigned>(GetConversionTimeMs(_resolution)));
     }
 
-    float sum = 0.0f;
-    int count = 0;
-    for (auto val : _rawReadingsVec)
+    // Every probe converts at once: one conversion window for the whole bus
+    if (!_oneWirePin.SkipRom())
+    {
+        CORE_ERROR("No DS18B20 detected!");
+        return false;
+    }
+
+    _oneWirePin.WriteByte(CMD_CONVERT_T);
+
+    _conversionStartUs = esp_timer_get_time();
+    _conversionResolution = _resolution;
+    _state = State::CONVERTING;
+
+    return true;
+}
+
+//----private------------------------------------------------------------------
+void TemperatureSensor::CollectReadings()
+{
+    _state = State::IDLE;
+    bool collected = false;
+
+    for (size_t i = 0; i < _channelCount; ++i)
     {
-        if (val > -1.0f)
+        Channel& channel = _channels[i];
+
+        uint8_t scratchpad[9];
+        if (!ReadScratchpad(i, scratchpad))
         {
-            sum += val;
-            count++;
+            CORE_ERROR("Failed to get valid temperature reading from channel %u!", static_cast<unsigned>(i));
+            continue;
         }
+
+        const int16_t rawReading = static_cast<int16_t>((scratchpad[1] << 8) | scratchpad[0]);
+        const float rawReadingAvg = channel.filter.Process(rawReading);
+
+        // Convert raw temperature to Celsius
+        channel.lastReading = std::clamp(rawReadingAvg / 16.0f, MIN_TEMP_VALUE, MAX_TEMP_VALUE);
+        _hasReading = true;
+        collected = true;
+
+        CORE_INFO("Temperature avg reading - Channel %u Celsius = %.2f", static_cast<unsigned>(i), channel.lastReading);
     }
-    
-    return (count > 0) ? (sum / count) : reading;
+
+    _conversionCount += collected ? 1 : 0;
 }
 
 //----private------------------------------------------------------------------
-uint8_t TemperatureSensor::CalculateCRC8(const uint8_t *addr, uint8_t len)
+void TemperatureSensor::UpdateAlarms()
 {
-    uint8_t crc = 0;
+    bool anyLimits = false;
+    for (size_t i = 0; i < _channelCount; ++i)
+    {
+        _channels[i].alarm = false;
+        anyLimits |= (_channels[i].alarmLow != ALARM_LOW_DISABLED) || (_channels[i].alarmHigh != ALARM_HIGH_DISABLED);
+    }
 
-    for (uint8_t i = 0; i < len; i++)
+    if (!anyLimits)
     {
-        uint8_t inbyte = addr[i];
-        for (uint8_t j = 0; j < 8; j++)
+        return;
+    }
+
+    // Only the probes in alarm answer: with none, the search ends after the first two bits
+    _oneWirePin.ResetSearch();
+
+    OneWire::Rom rom;
+    while (_oneWirePin.Search(rom, OneWire::SearchMode::ALARM))
+    {
+        for (size_t i = 0; i < _channelCount; ++i)
         {
-            uint8_t mix = (crc ^ inbyte) & 0x01;
-            crc >>= 1;
-            if (mix)
+            if (_channels[i].rom == rom)
             {
-                crc ^= 0x8C;
+                _channels[i].alarm = true;
+                CORE_WARNING("DS18B20 channel %u in alarm (%.2f C)", static_cast<unsigned>(i), _channels[i].lastReading);
             }
-            inbyte >>= 1;
         }
     }
+}
 
-    return crc;
+//----private------------------------------------------------------------------
+bool TemperatureSensor::Address(size_t channel)
+{
+    // Alone on the bus, SKIP ROM saves the 64 ROM bits
+    return (_channelCount == 1) ? _oneWirePin.SkipRom() : _oneWirePin.Select(_channels[channel].rom);
+}
+
+//----private------------------------------------------------------------------
+bool TemperatureSensor::ReadScratchpad(size_t channel, uint8_t (&scratchpad)[9])
+{
+    if (!Address(channel))
+    {
+        CORE_ERROR("No DS18B20 detected!");
+        return false;
+    }
+
+    _oneWirePin.WriteByte(CMD_READ_SCRATCH);
+
+    for (int i = 0; i < 9; i++)
+    {
+        scratchpad[i] = _oneWirePin.ReadByte();
+    }
+
+    // Verify CRC
+    uint8_t crcCalculated = OneWire::Crc8(scratchpad, 8);
+    if (crcCalculated != scratchpad[8])
+    {
+        CORE_ERROR("DS18B20 CRC check failed! Calculated: 0x%02X, Received: 0x%02X", crcCalculated, scratchpad[8]);
+        return false;
+    }
+
+    return true;
+}
+
+//----private------------------------------------------------------------------
+bool TemperatureSensor::WriteConfiguration(size_t channel, Resolution resolution)
+{
+    const Channel& entry = _channels[channel];
+    const uint8_t alarmHigh = static_cast<uint8_t>(entry.alarmHigh);
+    const uint8_t alarmLow = static_cast<uint8_t>(entry.alarmLow);
+    const uint8_t config = static_cast<uint8_t>((static_cast<uint8_t>(resolution) << CONFIG_RESOLUTION_SHIFT) | CONFIG_RESERVED_BITS);
+
+    if (!Address(channel))
+    {
+        return false;
+    }
+
+    _oneWirePin.WriteByte(CMD_WRITE_SCRATCH);
+    _oneWirePin.WriteByte(alarmHigh);
+    _oneWirePin.WriteByte(alarmLow);
+    _oneWirePin.WriteByte(config);
+
+    // Not copied to the sensor EEPROM: it is written again after every power-up
+    uint8_t scratchpad[9];
+    return ReadScratchpad(channel, scratchpad)
+        && (scratchpad[SCRATCHPAD_ALARM_HIGH_INDEX] == alarmHigh)
+        && (scratchpad[SCRATCHPAD_ALARM_LOW_INDEX] == alarmLow)
+        && (scratchpad[SCRATCHPAD_CONFIG_INDEX] == config);
 }
 
 //----private------------------------------------------------------------------
 TemperatureSensor::TemperatureSensor()
     : _oneWirePin(Config::TEMP_SENSOR_PIN)
-    , _rawReadingsVec(NUM_AVG_SAMPLES, -1.0f)
-    , _rawReadingsVecIter(_rawReadingsVec.begin())
+    , _channelCount(0)
+    , _hasReading(false)
+    , _conversionCount(0)
+    , _state(State::IDLE)
+    , _resolution(Resolution::BITS_12)
+    , _conversionResolution(Resolution::BITS_12)
+    , _configurationPending(true)
+    , _conversionStartUs(0)
 {
 }
 
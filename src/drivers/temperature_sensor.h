@@ -1,6 +1,13 @@
 /*!****************************************************************************
  * @file    temperature_sensor.h
  * @brief   DS18B20 temperature sensor driver using OneWire class.
+ *          Non-blocking: every update collects the conversion started by the
+ *          previous one (once its conversion time has elapsed) and starts the
+ *          next, so the main loop never waits for the sensor.
+ *          Several probes can share the bus: they are found by ROM search at
+ *          init and numbered as channels in ROM order. One broadcast CONVERT T
+ *          starts all of them, so N probes cost one conversion window, then
+ *          each scratchpad is read by address.
  * @author  Quattrone Martin
  * @date    Aug 2025
  ******************************************************************************/
@@ -9,8 +16,12 @@
 #define TEMPERATURE_SENSOR_H
 
 #include "framework/common_defs.h"
+#include "framework/dsp/filter_chain.h"
+#include "framework/dsp/hampel_filter.h"
+#include "framework/dsp/moving_average.h"
 #include "src/core/base/driver.h"
-#include <vector>
+#include <cstddef>
+#include <cstdint>
 
 namespace Drivers {
 
@@ -19,11 +30,67 @@ class TemperatureSensor : public Base::Singleton<TemperatureSensor>,
 {
     public:
 
+        //! Conversion resolution: 0.5 / 0.25 / 0.125 / 0.0625 C steps
+        enum class Resolution : uint8_t
+        {
+            BITS_9,             //!< 94 ms conversion
+            BITS_10,            //!< 188 ms conversion
+            BITS_11,            //!< 375 ms conversion
+            BITS_12,            //!< 750 ms conversion (power-on default)
+        };
+
+        static constexpr size_t MAX_CHANNELS = 16;
+
+        /**
+         * @brief Get last averaged temperature of a channel.
+         * @param channel Probe index, 0 to GetChannelCount() - 1.
+         * @return Temperature in Celsius, 0 for an unknown channel.
+         */
+        float GetLastReading(size_t channel = 0) const;
+
+        /**
+         * @brief Checks if at least one conversion has been collected from any channel.
+         */
+        bool HasReading() const { return _hasReading; }
+
+        /**
+         * @brief Conversions collected so far: changes once per new set of readings,
+         *        not on updates that found the conversion still running.
+         */
+        uint32_t GetConversionCount() const { return _conversionCount; }
+
         /**
-         * @brief Get last averaged temperature.
-         * @return Temperature in Celsius.
+         * @brief Number of probes found on the bus.
          */
-        float GetLastReading() const;
+        size_t GetChannelCount() const { return _channelCount; }
+
+        /**
+         * @brief ROM of the probe behind a channel.
+         */
+        const OneWire::Rom& GetRom(size_t channel) const { return _channels[channel].rom; }
+
+        /**
+         * @brief Set the alarm thresholds (TH/TL) of a channel, written before the next conversion.
+         *        The probe flags an alarm when a conversion is <= low or >= high (whole degrees).
+         */
+        void SetAlarmLimits(size_t channel, int8_t low, int8_t high);
+
+        /**
+         * @brief Whether the probe was in alarm at the last collection (found by ALARM SEARCH).
+         */
+        bool IsAlarmActive(size_t channel) const { return (channel < _channelCount) && _channels[channel].alarm; }
+
+        /**
+         * @brief Select the resolution; written to the sensor before the next conversion.
+         */
+        void SetResolution(Resolution resolution);
+
+        Resolution GetResolution() const { return _resolution; }
+
+        /**
+         * @brief Worst-case conversion time of a resolution.
+         */
+        static uint32_t GetConversionTimeMs(Resolution resolution);
 
     protected:
 
@@ -49,29 +116,70 @@ class TemperatureSensor : public Base::Singleton<TemperatureSensor>,
         void OnUpdate() override;
 
     private:
-    
+
+        static constexpr size_t NUM_AVG_SAMPLES = 12;
+        static constexpr size_t OUTLIER_WINDOW = 5;
+
+        //! Glitches (e.g. a probe answering its 85 C power-on value) are dropped before averaging
+        using ReadingFilter = Dsp::FilterChain<Dsp::HampelFilter<float, OUTLIER_WINDOW>,
+                                               Dsp::MovingAverage<float, NUM_AVG_SAMPLES>>;
+
+        enum class State : uint8_t
+        {
+            IDLE,
+            CONVERTING,
+        };
+
+        struct Channel
+        {
+            OneWire::Rom rom = {};
+            ReadingFilter filter;
+            float lastReading = 0.0f;
+            int8_t alarmLow = ALARM_LOW_DISABLED;
+            int8_t alarmHigh = ALARM_HIGH_DISABLED;
+            bool alarm = false;
+        };
+
+        /**
+         * @brief Enumerate the probes on the bus into the channel table.
+         * @return bool True if at least one probe was found.
+         */
+        bool DiscoverProbes();
+
+        /**
+         * @brief Writes the pending configuration if needed and broadcasts CONVERT T. Returns immediately.
+         * @return bool True if a sensor answered and the conversion started.
+         */
+        bool StartConversion();
+
+        /**
+         * @brief Reads the scratchpads of the finished conversion and updates the averages.
+         */
+        void CollectReadings();
+
         /**
-         * @brief Get raw temperature reading from the sensor.
-         * @return int16_t Raw temperature value.
+         * @brief Refresh the alarm flags with an ALARM SEARCH (skipped while no channel has limits).
          */
-        int16_t GetRawReading();
-        
+        void UpdateAlarms();
+
         /**
-         * @brief Store a temperature reading and return the average of the stored readings.
-         * @param reading The new temperature reading to store.
-         * @return float The average of the stored temperature readings.
+         * @brief Reset and address one channel: SKIP ROM when it is alone on the bus, MATCH ROM otherwise.
+         * @return bool True if a device answered the reset.
          */
-        float StoreReading(float reading);
+        bool Address(size_t channel);
 
         /**
-         * @brief Calculate CRC8 for data validation.
-         * @param addr Pointer to the data array.
-         * @param len Length of the data array.
-         * @return uint8_t Calculated CRC8 value.
+         * @brief Read the 9-byte scratchpad of a channel and check its CRC.
+         * @param scratchpad Destination buffer.
+         * @return bool True if the device answered and the CRC matched.
          */
-        uint8_t CalculateCRC8(const uint8_t *addr, uint8_t len);
+        bool ReadScratchpad(size_t channel, uint8_t (&scratchpad)[9]);
 
-        using TempReadingsVec = std::vector<float>;
+        /**
+         * @brief Write TH, TL and the configuration register of a channel, then read them back.
+         * @return bool True if the sensor reports the requested values.
+         */
+        bool WriteConfiguration(size_t channel, Resolution resolution);
 
         //---------------------------------------------
 
@@ -82,11 +190,18 @@ class TemperatureSensor : public Base::Singleton<TemperatureSensor>,
 
         //---------------------------------------------
 
-        static constexpr uint8_t CMD_SKIP_ROM     = 0xCC;
         static constexpr uint8_t CMD_CONVERT_T    = 0x44;
         static constexpr uint8_t CMD_READ_SCRATCH = 0xBE;
+        static constexpr uint8_t CMD_WRITE_SCRATCH = 0x4E;
 
-        static constexpr int NUM_AVG_SAMPLES      = 12;
+        static constexpr uint8_t FAMILY_DS18B20 = 0x28;
+        static constexpr int8_t ALARM_HIGH_DISABLED = 127;      //!< Above the 125 C the probe can measure
+        static constexpr int8_t ALARM_LOW_DISABLED  = -128;     //!< Below its -55 C
+        static constexpr uint8_t CONFIG_RESERVED_BITS = 0x1F;   //!< Read back as 1
+        static constexpr uint8_t CONFIG_RESOLUTION_SHIFT = 5;
+        static constexpr size_t SCRATCHPAD_ALARM_HIGH_INDEX = 2;
+        static constexpr size_t SCRATCHPAD_ALARM_LOW_INDEX = 3;
+        static constexpr size_t SCRATCHPAD_CONFIG_INDEX = 4;
 
         static constexpr float MIN_TEMP_VALUE   = 0.0f;
         static constexpr float MAX_TEMP_VALUE   = 85.0f;
@@ -95,10 +210,16 @@ class TemperatureSensor : public Base::Singleton<TemperatureSensor>,
 
         OneWire _oneWirePin;
 
-        TempReadingsVec _rawReadingsVec;
-        TempReadingsVec::iterator _rawReadingsVecIter;
+        Channel _channels[MAX_CHANNELS];
+        size_t _channelCount;
+        bool _hasReading;
+        uint32_t _conversionCount;
 
-        float _lastReading;
+        State _state;
+        Resolution _resolution;
+        Resolution _conversionResolution;       //!< Resolution of the conversion in progress
+        bool _configurationPending;             //!< _resolution or alarm limits not written to the sensors yet
+        uint64_t _conversionStartUs;
 };
 
 } // namespace Drivers
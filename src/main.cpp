@@ -5,15 +5,18 @@
  * @date    Aug 2025
  *******************************************************************************/
 
+#include "framework/os/deferred_log.h"
 #include "src/core/smart_aquarium_guardian.h"
 
 //-----------------------------------------------------------------------------
 extern "C" void app_main(void) 
 {
-    SmartAquariumGuardian::GetInstance()->Init(2000);
+    DeferredLog::Start();
+
+    SmartAquariumGuardian::GetInstance()->Init();
 
     while (true) 
     {
-        SmartAquariumGuardian::GetInstance()->Update(10);
+        SmartAquariumGuardian::GetInstance()->Update();
     }
 }
\ No newline at end of file
@@ -1,23 +1,33 @@
 /*!****************************************************************************
  * @file    cloud_payloads.h
- * @brief   JSON payload builders for ThingsBoard: telemetry and client attributes.
+ * @brief   JSON payload builders for ThingsBoard: telemetry, client attributes
+ *          and the RPC responses sent in parts.
  * @author  Quattrone Martin
  * @date    Mar 2026
  *******************************************************************************/
 
 #pragma once
 
+#include "framework/os/perf_stats.h"
+#include "framework/os/trace.h"
+#include "include/config.h"
+#include "src/core/boot_orchestrator.h"
 #include "src/core/guardian_proxy.h"
 #include "src/managers/comms/network_config.h"
+#include "src/services/history_query.h"
 #include "src/services/memory/memory_config_data.h"
 #include "src/utils/date_time.h"
-#include "lib/nlohmann_json/json.hpp"
+#include "framework/memory/arena_json.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
 #include <iomanip>
+#include <optional>
 #include <string>
 
 namespace Comms {
 
-using Json = nlohmann::json;
+using Json = Memory::ArenaJson;
 
 /*!
  * @brief Builds JSON payload for telemetry (sensor data) published to v1/devices/me/telemetry.
@@ -28,22 +38,277 @@ class TelemetryPayload
 
         TelemetryPayload()
         {
-            _temperature = Core::GuardianProxy::GetInstance()->GetTemperatureReading();
-            _tds = Core::GuardianProxy::GetInstance()->GetTdsReading();
+            const auto& water = Core::GuardianProxy::GetInstance()->GetSnapshot().water;
+
+            _temperature = water.temperature;
+            _tds = water.tds;
+            _temperatureRate = water.temperatureRatePerHour;
+            _tdsRate = water.tdsRatePerHour;
+            _temperatureWarning = water.temperatureWarning;
+            _tdsWarning = water.tdsWarning;
+
+            _channelCount = water.temperatureChannelCount;
+            std::copy(water.channelTemperatures, water.channelTemperatures + _channelCount, _channelTemperatures);
+
+            _configWrites = Core::GuardianProxy::GetInstance()->GetConfigWriteStats();
         }
 
-        std::string ToJsonString() const
+        //! Built with the arena of the current ArenaScope (heap when there is none)
+        Memory::ArenaString ToJsonString() const
         {
             Json json;
             json[NetworkConfig::TelemetryKeys::TEMPERATURE] = _temperature;
             json[NetworkConfig::TelemetryKeys::TDS] = _tds;
-            return json.dump();
+            json[NetworkConfig::TelemetryKeys::TEMPERATURE_RATE] = _temperatureRate;
+            json[NetworkConfig::TelemetryKeys::TDS_RATE] = _tdsRate;
+            json[NetworkConfig::TelemetryKeys::TEMPERATURE_WARNING] = _temperatureWarning;
+            json[NetworkConfig::TelemetryKeys::TDS_WARNING] = _tdsWarning;
+
+            for (size_t i = 1; i < _channelCount; ++i)
+            {
+                char key[24];
+                snprintf(key, sizeof(key), "%s%u", NetworkConfig::TelemetryKeys::TEMPERATURE_CHANNEL_PREFIX, static_cast<unsigned>(i));
+                json[key] = _channelTemperatures[i];
+            }
+
+            json[NetworkConfig::TelemetryKeys::CONFIG_CHANGES] = _configWrites.changes;
+            json[NetworkConfig::TelemetryKeys::CONFIG_EEPROM_BYTES] = _configWrites.bytesWritten;
+            if (_configWrites.changes > 0)
+            {
+                json[NetworkConfig::TelemetryKeys::CONFIG_BYTES_PER_CHANGE] =
+                    static_cast<float>(_configWrites.bytesWritten) / static_cast<float>(_configWrites.changes);
+            }
+
+            if (Config::TELEMETRY_PERF_STATS_ENABLED)
+            {
+                AddPerfStats(json);
+            }
+
+            return Memory::DumpArenaJson(json);
         }
 
     private:
 
+        //! Flat keys so each module shows up as its own time series
+        static void AddPerfStats(Json& json)
+        {
+            Perf::ForEach([&json](const Perf::ModuleStats::Summary& stats)
+                {
+                    if (stats.budgetUs == 0)
+                    {
+                        return;
+                    }
+
+                    char key[48];
+                    snprintf(key, sizeof(key), "%s%s", stats.name, NetworkConfig::TelemetryKeys::PERF_P99_SUFFIX);
+                    json[key] = stats.p99Us;
+                    snprintf(key, sizeof(key), "%s%s", stats.name, NetworkConfig::TelemetryKeys::PERF_OVERRUNS_SUFFIX);
+                    json[key] = stats.overruns;
+                }
+            );
+        }
+
+        // ---------------------------------------------
+
         float _temperature;
         int _tds;
+        float _temperatureRate;
+        float _tdsRate;
+        bool _temperatureWarning;
+        bool _tdsWarning;
+        float _channelTemperatures[Core::SystemSnapshot::MAX_TEMPERATURE_CHANNELS];
+        size_t _channelCount;
+        Services::StorageService::WriteStats _configWrites;
+};
+
+/*!
+ * @brief Builds the getPerfStats RPC response, per-module update latency statistics:
+ *        { "result", "modules": { "<module>": { "count", "p50_us", "p99_us", "max_us", "mean_us", "budget_us", "overruns" }, ... } }
+ *        Written directly instead of through a Json DOM, which would need ~8 nodes per module.
+ */
+class PerfStatsPayload
+{
+    public:
+
+        //! Built with the arena of the current ArenaScope (heap when there is none), sized once
+        Memory::ArenaString ToJsonString() const
+        {
+            using namespace NetworkConfig::PerfStatsKeys;
+
+            size_t modules = 0;
+            Perf::ForEach([&modules](const Perf::ModuleStats::Summary&) { ++modules; });
+
+            Memory::ArenaString out;
+            out.reserve(HEADER_SIZE_HINT + modules * ENTRY_SIZE_HINT);
+
+            char text[192];
+            snprintf(text, sizeof(text), "{\"%s\":\"%s\",\"%s\":{",
+                     NetworkConfig::Key::RESULT, NetworkConfig::Value::RESULT_SUCCESS, MODULES);
+            out += text;
+
+            bool first = true;
+            Perf::ForEach([&out, &text, &first](const Perf::ModuleStats::Summary& stats)
+                {
+                    snprintf(text, sizeof(text),
+                             "%s\"%s\":{\"%s\":%u,\"%s\":%u,\"%s\":%u,\"%s\":%u,\"%s\":%u,\"%s\":%u,\"%s\":%u}",
+                             first ? "" : ",",
+                             stats.name,
+                             COUNT, static_cast<unsigned>(stats.count),
+                             P50, static_cast<unsigned>(stats.p50Us),
+                             P99, static_cast<unsigned>(stats.p99Us),
+                             MAX, static_cast<unsigned>(stats.maxUs),
+                             MEAN, static_cast<unsigned>(stats.meanUs),
+                             BUDGET, static_cast<unsigned>(stats.budgetUs),
+                             OVERRUNS, static_cast<unsigned>(stats.overruns));
+                    out += text;
+                    first = false;
+                }
+            );
+
+            out += "}}";
+            return out;
+        }
+
+    private:
+
+        static constexpr size_t HEADER_SIZE_HINT = 48;
+        static constexpr size_t ENTRY_SIZE_HINT = 160;
+};
+
+/*!
+ * @brief Builds one message of the streamed getHistory RPC response. Written by hand
+ *        like PerfStatsPayload: a chunk is a few hundred numbers, which as Json
+ *        nodes would take several times the arena the text does.
+ */
+class HistoryChunkPayload
+{
+    public:
+
+        using Query = Services::HistoryQuery;
+
+        HistoryChunkPayload(const char* key, uint32_t from, uint32_t to, const Query& query,
+                            uint32_t seq, bool last, const Query::Point* points, size_t count)
+            : _key(key)
+            , _from(from)
+            , _to(to)
+            , _query(query)
+            , _seq(seq)
+            , _last(last)
+            , _points(points)
+            , _count(count)
+        {}
+
+        //! Built with the arena of the current ArenaScope (heap when there is none)
+        Memory::ArenaString ToJsonString() const
+        {
+            using namespace NetworkConfig::HistoryKeys;
+
+            const int decimals = DECIMALS[static_cast<size_t>(_query.GetSeries())];
+
+            Memory::ArenaString out;
+            out.reserve(HEADER_SIZE_HINT + _count * POINT_SIZE_HINT);
+
+            char text[160];
+            snprintf(text, sizeof(text),
+                     "{\"%s\":\"%s\",\"%s\":\"%s\",\"%s\":%u,\"%s\":%u,\"%s\":%u,\"%s\":%u,\"%s\":%s",
+                     NetworkConfig::Key::RESULT, NetworkConfig::Value::RESULT_SUCCESS,
+                     KEY, _key,
+                     FROM, static_cast<unsigned>(_from),
+                     TO, static_cast<unsigned>(_to),
+                     RESOLUTION, static_cast<unsigned>(_query.GetResolution()),
+                     SEQ, static_cast<unsigned>(_seq),
+                     LAST, _last ? "true" : "false");
+            out += text;
+
+            if (_seq == 0)
+            {
+                snprintf(text, sizeof(text), ",\"%s\":[", SOURCES);
+                out += text;
+
+                for (size_t i = 0; i < _query.GetPieceCount(); ++i)
+                {
+                    const Query::Piece& piece = _query.GetPiece(i);
+                    snprintf(text, sizeof(text), "%s[\"%s\",%u,%u]", (i > 0) ? "," : "",
+                             Query::GetSourceName(piece.source), static_cast<unsigned>(piece.from), static_cast<unsigned>(piece.to));
+                    out += text;
+                }
+                out += ']';
+            }
+
+            snprintf(text, sizeof(text), ",\"%s\":[", POINTS);
+            out += text;
+
+            for (size_t i = 0; i < _count; ++i)
+            {
+                const Query::Point& point = _points[i];
+                snprintf(text, sizeof(text), "%s[%u,%.*f,%.*f,%.*f,%u]", (i > 0) ? "," : "",
+                         static_cast<unsigned>(point.start),
+                         decimals, point.min, decimals, point.avg, decimals, point.max,
+                         static_cast<unsigned>(point.count));
+                out += text;
+            }
+
+            out += "]}";
+            return out;
+        }
+
+    private:
+
+        static constexpr size_t HEADER_SIZE_HINT = 192;
+        static constexpr size_t POINT_SIZE_HINT = 40;
+
+        //! Resolution of each series in ReadingHistory (0.01 degC, 1 ppm, 1 mV)
+        static constexpr int DECIMALS[Services::ReadingHistory::SERIES_COUNT] = { 2, 0, 3 };
+
+        const char* _key;
+        uint32_t _from;
+        uint32_t _to;
+        const Query& _query;
+        uint32_t _seq;
+        bool _last;
+        const Query::Point* _points;
+        size_t _count;
+};
+
+/*!
+ * @brief Builds one message of the streamed getTrace RPC response:
+ *        { "result", "seq", "last", "pending", "dropped", "events": [[us, "B"|"E", core, task, name], ...] }
+ *        Events are added as they are drained; build it inside the ArenaScope of the message.
+ */
+class TraceChunkPayload
+{
+    public:
+
+        explicit TraceChunkPayload(uint32_t seq)
+        {
+            using namespace NetworkConfig::TraceKeys;
+
+            _doc[NetworkConfig::Key::RESULT] = NetworkConfig::Value::RESULT_SUCCESS;
+            _doc[SEQ] = seq;
+            _doc[EVENTS] = Json::array();
+            _doc[EVENTS].get_ref<Json::array_t&>().reserve(Config::TRACE_RPC_CHUNK_EVENTS);
+        }
+
+        void Add(const Trace::Event& event)
+        {
+            const char phase[2] = { event.phase, '\0' };
+            _doc[NetworkConfig::TraceKeys::EVENTS].push_back(Json::array({ event.timestampUs, phase, event.core, event.task, event.name }));
+        }
+
+        //! Built with the arena of the current ArenaScope (heap when there is none)
+        Memory::ArenaString ToJsonString(bool last)
+        {
+            using namespace NetworkConfig::TraceKeys;
+
+            _doc[LAST] = last;
+            _doc[PENDING] = Trace::GetPendingCount();
+            _doc[DROPPED] = Trace::GetDroppedCount();
+            return Memory::DumpArenaJson(_doc);
+        }
+
+    private:
+
+        Json _doc;
 };
 
 /*!
@@ -57,26 +322,46 @@ class ClientAttributesPayload
         ClientAttributesPayload()
         {
             auto* proxy = Core::GuardianProxy::GetInstance();
+            const Core::SystemSnapshot snapshot = proxy->GetSnapshot();
+
+            {
+                const auto timezone = proxy->GetTimezoneFromStorage();
+                _timezone.assign(timezone->data(), timezone->size());
+            }
+            proxy->GetTrendSensitivityFromStorage(_trendEnabled, _tempRateLimit, _tdsRateLimit, _spikeZScore);
+
+            _minTemp = snapshot.water.minTemp;
+            _minEnabled = snapshot.water.minTempEnabled;
+            _maxTemp = snapshot.water.maxTemp;
+            _maxEnabled = snapshot.water.maxTempEnabled;
+            _minTds = snapshot.water.minTds;
+            _tdsMinEnabled = snapshot.water.minTdsEnabled;
+            _maxTds = snapshot.water.maxTds;
+            _tdsMaxEnabled = snapshot.water.maxTdsEnabled;
 
-            _timezone = proxy->GetTimezoneFromStorage();
-            proxy->GetTempLimitsFromStorage(_minTemp, _minEnabled, _maxTemp, _maxEnabled);
-            proxy->GetTdsLimitsFromStorage(_minTds, _tdsMinEnabled, _maxTds, _tdsMaxEnabled);
-            _scheduleList = proxy->GetFeedingScheduleFromStorage();
-            _wifiSsid = proxy->GetWifiSsid();
-            _wifiRssi = proxy->GetWifiRssi();
+            _scheduleList.assign(snapshot.feeder.schedule, snapshot.feeder.schedule + snapshot.feeder.scheduleCount);
+            _temperatureChannels = snapshot.water.temperatureChannelCount;
+            std::memcpy(_wifiSsid, snapshot.connectivity.wifiSsid, sizeof(_wifiSsid));
+            _wifiRssi = snapshot.connectivity.wifiRssi;
 
-            Utils::DateTime dt;
-            if (proxy->GetDateTime(dt))
+            if (snapshot.clock.valid)
             {
-                _deviceTime = dt.ToString();
+                snapshot.clock.Now().ToString(_deviceTime);
             }
             else
             {
-                _deviceTime = "--:--";
+                std::snprintf(_deviceTime, sizeof(_deviceTime), "--:--");
             }
+
+            using Milestone = Core::BootOrchestrator::Milestone;
+            auto* boot = Core::BootOrchestrator::GetInstance();
+            _bootDurationMs = boot->GetMilestoneMs(Milestone::BOOT_COMPLETE);
+            _bootFirstReadingMs = boot->GetMilestoneMs(Milestone::FIRST_READING);
+            _bootFirstTelemetryMs = boot->GetMilestoneMs(Milestone::FIRST_TELEMETRY);
         }
 
-        std::string ToJsonString() const
+        //! Built with the arena of the current ArenaScope (heap when there is none)
+        Memory::ArenaString ToJsonString() const
         {
             Json doc;
 
@@ -91,7 +376,13 @@ class ClientAttributesPayload
             doc[NetworkConfig::ClientAttributes::TDS_LIMIT_MAX] = _maxTds;
             doc[NetworkConfig::ClientAttributes::TDS_LIMIT_MAX_ENABLED] = _tdsMaxEnabled;
 
+            doc[NetworkConfig::ClientAttributes::TREND_ENABLED] = _trendEnabled;
+            doc[NetworkConfig::ClientAttributes::TEMP_RATE_LIMIT] = _tempRateLimit;
+            doc[NetworkConfig::ClientAttributes::TDS_RATE_LIMIT] = _tdsRateLimit;
+            doc[NetworkConfig::ClientAttributes::SPIKE_Z_SCORE] = _spikeZScore;
+
             Json scheduleArray = Json::array();
+            scheduleArray.get_ref<Json::array_t&>().reserve(_scheduleList.size());
             for (const auto& e : _scheduleList)
             {
                 Json entry;
@@ -99,20 +390,35 @@ class ClientAttributesPayload
                 entry[NetworkConfig::ClientAttributes::FEED_TIME] = e._min;
                 entry[NetworkConfig::ClientAttributes::FEED_DOSE] = e._dose;
                 entry[NetworkConfig::ClientAttributes::FEED_ENABLED] = e._enabled;
-                scheduleArray.push_back(entry);
+                scheduleArray.push_back(std::move(entry));
             }
-            doc[NetworkConfig::ClientAttributes::FEEDING_SCHEDULE] = scheduleArray;
+            doc[NetworkConfig::ClientAttributes::FEEDING_SCHEDULE] = std::move(scheduleArray);
 
             doc[NetworkConfig::ClientAttributes::WIFI_SSID] = _wifiSsid;
             doc[NetworkConfig::ClientAttributes::WIFI_RSSI] = _wifiRssi;
             doc[NetworkConfig::ClientAttributes::DEVICE_TIME] = _deviceTime;
+            doc[NetworkConfig::ClientAttributes::TEMP_CHANNELS] = _temperatureChannels;
+
+            // Milliseconds since power-on, sent once reached
+            if (_bootDurationMs)
+            {
+                doc[NetworkConfig::ClientAttributes::BOOT_DURATION_MS] = *_bootDurationMs;
+            }
+            if (_bootFirstReadingMs)
+            {
+                doc[NetworkConfig::ClientAttributes::BOOT_FIRST_READING_MS] = *_bootFirstReadingMs;
+            }
+            if (_bootFirstTelemetryMs)
+            {
+                doc[NetworkConfig::ClientAttributes::BOOT_FIRST_TELEMETRY_MS] = *_bootFirstTelemetryMs;
+            }
 
-            return doc.dump();
+            return Memory::DumpArenaJson(doc);
         }
 
     private:
 
-        std::string _timezone;
+        Memory::ArenaString _timezone;      //!< In the arena of the scope the payload is built in
         float _minTemp = 0.0f;
         bool _minEnabled = false;
         float _maxTemp = 0.0f;
@@ -121,10 +427,18 @@ class ClientAttributesPayload
         bool _tdsMinEnabled = false;
         int _maxTds = 500;
         bool _tdsMaxEnabled = false;
+        bool _trendEnabled = false;
+        float _tempRateLimit = 0.0f;
+        int _tdsRateLimit = 0;
+        float _spikeZScore = 0.0f;
         Services::FeeddingScheduleList _scheduleList;
-        std::string _wifiSsid;
+        size_t _temperatureChannels = 0;
+        char _wifiSsid[Core::SystemSnapshot::SSID_SIZE] = {};
         int8_t _wifiRssi = 0;
-        std::string _deviceTime;
+        char _deviceTime[Utils::DateTime::STRING_SIZE] = {};
+        std::optional<uint32_t> _bootDurationMs;
+        std::optional<uint32_t> _bootFirstReadingMs;
+        std::optional<uint32_t> _bootFirstTelemetryMs;
 };
 
 } // namespace Comms
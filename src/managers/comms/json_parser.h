@@ -1,7 +1,8 @@
 /*!****************************************************************************
  * @file    json_parser.h
  * @brief   Utility class for exception-safe JSON payload parsing using nlohmann::json.
- * Header-only implementation.
+ * Header-only implementation. The DOM uses Memory::ArenaJson, so parse inside an
+ * ArenaScope to keep it off the general heap.
  * @author  Quattrone Martin
  * @date    Nov 2025
  *******************************************************************************/
@@ -9,40 +10,35 @@
 #pragma once
 
 #include "framework/common_defs.h"
-#include "lib/nlohmann_json/json.hpp"
+#include "framework/memory/arena_json.h"
+#include <algorithm>
+#include <cstdint>
+#include <limits>
 #include <string>
+#include <string_view>
 #include <optional>
 #include <type_traits>
 
 namespace Utils {
 
-using Json = nlohmann::json;
+using Json = Memory::ArenaJson;
 
 class JsonPayloadParser 
 {
     public:
         
-        explicit JsonPayloadParser(const std::string& payload) 
+        explicit JsonPayloadParser(std::string_view payload)
             : _isValid(false) 
         {
-            // 1. Quick check for valid JSON syntax using accept()
-            if (!Json::accept(payload)) 
-            {
-                CORE_ERROR("JsonPayloadParser: Invalid JSON format (accept failed)");
-                _errorMsg = "Invalid JSON format.";
-                return;
-            }
+            // 1. Parse without throwing exceptions; unlike Json::parse() the parser's
+            // own buffers stay on the stack, so nothing but the arena is touched
+            _json = Memory::ParseArenaJson(payload);
 
-            // 2. Parse without throwing exceptions.
-            // The third argument 'false' disables exception throwing.
-            // The second argument 'nullptr' is for a parse event callback (not used here).
-            _json = Json::parse(payload, nullptr, false);
-
-            // 3. Check if parsing was successful using .is_discarded()
+            // 2. Check if parsing was successful using .is_discarded()
             if (_json.is_discarded()) 
             {
-                CORE_ERROR("JsonPayloadParser: Parse error (is_discarded)");
-                _errorMsg = "Internal error parsing JSON structure.";
+                CORE_ERROR("JsonPayloadParser: Invalid JSON format (is_discarded)");
+                _errorMsg = "Invalid JSON format.";
                 _isValid = false;
             } 
             else 
@@ -54,27 +50,28 @@ class JsonPayloadParser
 
         bool IsValid() const { return _isValid; }
 
-        std::string GetError() const{ return _errorMsg; }
+        const char* GetError() const { return _errorMsg; }
 
-        std::optional<std::string> GetMethod() const { return GetValue<std::string>("method"); }
+        //! The view points into the parsed document: valid while the parser is alive.
+        std::optional<std::string_view> GetMethod() const { return GetValue<std::string_view>("method"); }
 
         // Template method declarations
         template<typename T>
-        std::optional<T> GetValue(const std::string& key, const std::string& parentKey = "") const;
+        std::optional<T> GetValue(const char* key, const char* parentKey = nullptr) const;
 
         template<typename T>
-        std::optional<T> GetParam(const std::string& key) const;
+        std::optional<T> GetParam(const char* key) const;
 
     private:
 
         Json _json;
         bool _isValid;
-        std::string _errorMsg;
+        const char* _errorMsg = "";
 };
 
 //-----------------------------------------------------------------------------
 template<typename T>
-std::optional<T> JsonPayloadParser::GetValue(const std::string& key, const std::string& parentKey) const 
+std::optional<T> JsonPayloadParser::GetValue(const char* key, const char* parentKey) const 
 {
     if (!_isValid) 
     {
@@ -83,7 +80,7 @@ std::optional<T> JsonPayloadParser::GetValue(const std::string& key, const std::
 
     // 1. Determine the root object to search in
     const Json* rootPtr = &_json;
-    if (!parentKey.empty()) 
+    if (parentKey != nullptr) 
     {
         auto itParent = _json.find(parentKey);
         if (itParent == _json.end() || !itParent->is_object()) 
@@ -130,6 +127,20 @@ std::optional<T> JsonPayloadParser::GetValue(const std::string& key, const std::
             return 0;
         }
     }
+    else if constexpr (std::is_same_v<T, int64_t>)
+    {
+        // Unsigned values past the int64 range saturate instead of wrapping negative
+        if (valueJson.is_number_unsigned())
+        {
+            const uint64_t value = valueJson.get<uint64_t>();
+            return static_cast<int64_t>(std::min<uint64_t>(value, std::numeric_limits<int64_t>::max()));
+        }
+
+        if (valueJson.is_number_integer())
+        {
+            return valueJson.get<int64_t>();
+        }
+    }
     else if constexpr (std::is_same_v<T, bool>) 
     {
         if (valueJson.is_boolean())
@@ -141,18 +152,27 @@ std::optional<T> JsonPayloadParser::GetValue(const std::string& key, const std::
     {
         if (valueJson.is_string())
         {
-            return valueJson.get<std::string>();
+            const auto& value = valueJson.template get_ref<const Json::string_t&>();
+            return std::string(value.data(), value.size());
+        }
+    }
+    else if constexpr (std::is_same_v<T, std::string_view>) 
+    {
+        if (valueJson.is_string())
+        {
+            const auto& value = valueJson.template get_ref<const Json::string_t&>();
+            return std::string_view(value.data(), value.size());
         }
     }
 
     // If type mismatch found
-    CORE_WARNING("JsonPayloadParser: Type mismatch for key '%s'.", key.c_str());
+    CORE_WARNING("JsonPayloadParser: Type mismatch for key '%s'.", key);
     return std::nullopt;
 }
 
 //-----------------------------------------------------------------------------
 template<typename T>
-std::optional<T> JsonPayloadParser::GetParam(const std::string& key) const 
+std::optional<T> JsonPayloadParser::GetParam(const char* key) const 
 {
     return GetValue<T>(key, "params");
 }
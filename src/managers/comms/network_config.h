@@ -32,6 +32,64 @@ namespace NetworkConfig
     {
         inline constexpr const char* TEMPERATURE = "temperature";
         inline constexpr const char* TDS        = "tds";
+
+        //! Early warnings: rates fitted over the trend window (degC/h, ppm/h) and their flags
+        inline constexpr const char* TEMPERATURE_RATE       = "temperature_rate";
+        inline constexpr const char* TDS_RATE               = "tds_rate";
+        inline constexpr const char* TEMPERATURE_WARNING    = "temperature_warning";
+        inline constexpr const char* TDS_WARNING            = "tds_warning";
+
+        //! EEPROM cost of the config changes since boot: logical changes, bytes written, and their ratio
+        inline constexpr const char* CONFIG_CHANGES             = "config_changes";
+        inline constexpr const char* CONFIG_EEPROM_BYTES        = "config_eeprom_bytes";
+        inline constexpr const char* CONFIG_BYTES_PER_CHANGE    = "config_bytes_per_change";
+
+        //! Extra probes, e.g. "temperature_1" (channel 0 is sent as TEMPERATURE)
+        inline constexpr const char* TEMPERATURE_CHANNEL_PREFIX = "temperature_";
+
+        //! Per-module suffixes, e.g. "NetworkController_p99_us" (modules with an update budget only)
+        inline constexpr const char* PERF_P99_SUFFIX        = "_p99_us";
+        inline constexpr const char* PERF_OVERRUNS_SUFFIX   = "_overruns";
+    }
+
+    //! Keys of the getPerfStats RPC response and of each module entry in it
+    namespace PerfStatsKeys
+    {
+        inline constexpr const char* RESET      = "reset";          //!< Param: start a new window after reading
+        inline constexpr const char* MODULES    = "modules";        //!< Object with one entry per module
+        inline constexpr const char* COUNT      = "count";
+        inline constexpr const char* P50        = "p50_us";
+        inline constexpr const char* P99        = "p99_us";
+        inline constexpr const char* MAX        = "max_us";
+        inline constexpr const char* MEAN       = "mean_us";
+        inline constexpr const char* BUDGET     = "budget_us";
+        inline constexpr const char* OVERRUNS   = "overruns";
+    }
+
+    //! Params of the getTrace RPC and keys of its response messages
+    namespace TraceKeys
+    {
+        inline constexpr const char* MAX        = "max";            //!< Events to drain, at most
+        inline constexpr const char* SEQ        = "seq";
+        inline constexpr const char* LAST       = "last";
+        inline constexpr const char* EVENTS     = "events";         //!< [us, "B"|"E", core, task, name] per event
+        inline constexpr const char* PENDING    = "pending";        //!< Events left in the rings
+        inline constexpr const char* DROPPED    = "dropped";        //!< Events lost since boot
+    }
+
+    //! Params of the getHistory RPC and keys of its response messages
+    namespace HistoryKeys
+    {
+        inline constexpr const char* KEY        = "key";            //!< TelemetryKeys::TEMPERATURE, TDS or BATTERY
+        inline constexpr const char* FROM       = "from";           //!< Epoch seconds
+        inline constexpr const char* TO         = "to";
+        inline constexpr const char* RESOLUTION = "resolution";     //!< Seconds per point
+        inline constexpr const char* SEQ        = "seq";
+        inline constexpr const char* LAST       = "last";
+        inline constexpr const char* SOURCES    = "sources";        //!< First message: [source, from, to] per part of the range
+        inline constexpr const char* POINTS     = "points";         //!< [start, min, avg, max, count] per point
+
+        inline constexpr const char* BATTERY    = "battery";        //!< Volts (not sent as telemetry)
     }
 
     //! Keys for client attributes (device config) - published to v1/devices/me/attributes
@@ -47,6 +105,10 @@ namespace NetworkConfig
         inline constexpr const char* TDS_LIMIT_MIN_ENABLED   = "tds_limit_min_enabled";
         inline constexpr const char* TDS_LIMIT_MAX           = "tds_limit_max";
         inline constexpr const char* TDS_LIMIT_MAX_ENABLED   = "tds_limit_max_enabled";
+        inline constexpr const char* TREND_ENABLED           = "trend_alerts_enabled";
+        inline constexpr const char* TEMP_RATE_LIMIT         = "temp_rate_limit";       //!< degC/h, 0 = off
+        inline constexpr const char* TDS_RATE_LIMIT          = "tds_rate_limit";        //!< ppm/h, 0 = off
+        inline constexpr const char* SPIKE_Z_SCORE           = "spike_z_score";         //!< 0 = off
         inline constexpr const char* FEEDING_SCHEDULE        = "feeding_schedule";
         inline constexpr const char* FEED_DOSE               = "dose";
         inline constexpr const char* FEED_TIME               = "time_min";
@@ -55,5 +117,9 @@ namespace NetworkConfig
         inline constexpr const char* WIFI_SSID               = "wifi_ssid";
         inline constexpr const char* WIFI_RSSI               = "wifi_rssi";
         inline constexpr const char* DEVICE_TIME             = "device_time";
+        inline constexpr const char* TEMP_CHANNELS           = "temperature_channels";
+        inline constexpr const char* BOOT_DURATION_MS        = "boot_duration_ms";
+        inline constexpr const char* BOOT_FIRST_READING_MS   = "boot_first_reading_ms";
+        inline constexpr const char* BOOT_FIRST_TELEMETRY_MS = "boot_first_telemetry_ms";
     }
 }
@@ -8,12 +8,20 @@
  #pragma once
 
 #include "framework/common_defs.h"
+#include "framework/memory/arena.h"
+#include "framework/os/trace.h"
 #include "lib/nlohmann_json/json.hpp"
 #include "src/core/guardian_proxy.h"
+#include "src/managers/comms/cloud_payloads.h"
 #include "src/managers/comms/network_config.h"
 #include "src/managers/comms/json_parser.h"
+#include "src/services/history_query.h"
+#include <algorithm>
+#include <functional>
+#include <limits>
 #include <optional>
 #include <string>
+#include <string_view>
 
 namespace Handlers {
 
@@ -25,10 +33,23 @@ class IRpcHandler
 {
     public:
 
+        //! Publishes one message of a response sent in parts; false when it could not be sent
+        using ChunkSink = std::function<bool(std::string_view payload)>;
+
         virtual ~IRpcHandler() = default;
 
-        //! Handle the RPC request with the given payload.
-        virtual Result Handle(const std::string& payload) = 0;
+        //! Handle the RPC request. The payload has already been parsed and validated by the dispatcher.
+        virtual Result Handle(const Utils::JsonPayloadParser& parser) = 0;
+
+        /**
+         * @brief Handle a request whose response may not fit one message. Messages given
+         *        to 'send' are the response: the dispatcher only answers itself when none
+         *        was sent. By default the whole response comes from Handle().
+         */
+        virtual Result HandleStreamed(const Utils::JsonPayloadParser& parser, const ChunkSink& send)
+        {
+            return Handle(parser);
+        }
 };
 
 //-----------------------------------------------------------------------------
@@ -39,14 +60,8 @@ class SetTempLimitsHandler : public IRpcHandler
         static constexpr const char* NAME = "setTempLimits";
 
         //!
-        Result Handle(const std::string& payload) override
+        Result Handle(const Utils::JsonPayloadParser& parser) override
         {
-            Utils::JsonPayloadParser parser(payload);
-            if (!parser.IsValid())
-            {
-                return Result::Error("Internal error: Invalid JSON payload.");
-            }
-
             const auto minEnabledOpt = parser.GetParam<bool>(NetworkConfig::ClientAttributes::TEMP_LIMIT_MIN_ENABLED);
             const auto maxEnabledOpt = parser.GetParam<bool>(NetworkConfig::ClientAttributes::TEMP_LIMIT_MAX_ENABLED);
 
@@ -104,14 +119,8 @@ class SetTdsLimitsHandler : public IRpcHandler
 
         static constexpr const char* NAME = "setTdsLimits";
 
-        Result Handle(const std::string& payload) override
+        Result Handle(const Utils::JsonPayloadParser& parser) override
         {
-            Utils::JsonPayloadParser parser(payload);
-            if (!parser.IsValid())
-            {
-                return Result::Error("Internal error: Invalid JSON payload.");
-            }
-
             const auto minEnabledOpt = parser.GetParam<bool>(NetworkConfig::ClientAttributes::TDS_LIMIT_MIN_ENABLED);
             const auto maxEnabledOpt = parser.GetParam<bool>(NetworkConfig::ClientAttributes::TDS_LIMIT_MAX_ENABLED);
 
@@ -163,21 +172,51 @@ class SetTdsLimitsHandler : public IRpcHandler
 };
 
 //-----------------------------------------------------------------------------
-class AddFeedingScheduleHandler : public IRpcHandler 
+class SetTrendSensitivityHandler : public IRpcHandler
 {
     public:
 
-        static constexpr const char* NAME = "addFeedingSchedule";
+        static constexpr const char* NAME = "setTrendSensitivity";
 
-        //!
-        Result Handle(const std::string& payload) override 
+        //! Values left out keep their current setting
+        Result Handle(const Utils::JsonPayloadParser& parser) override
         {
-            Utils::JsonPayloadParser parser(payload);
-            if (!parser.IsValid())
+            bool enabled = false;
+            float tempRate = 0.0f;
+            int tdsRate = 0;
+            float spikeZScore = 0.0f;
+
+            Core::GuardianProxy::GetInstance()->GetTrendSensitivity(enabled, tempRate, tdsRate, spikeZScore);
+
+            const auto enabledOpt = parser.GetParam<bool>(NetworkConfig::ClientAttributes::TREND_ENABLED);
+            const auto tempRateOpt = parser.GetParam<float>(NetworkConfig::ClientAttributes::TEMP_RATE_LIMIT);
+            const auto tdsRateOpt = parser.GetParam<int>(NetworkConfig::ClientAttributes::TDS_RATE_LIMIT);
+            const auto spikeZScoreOpt = parser.GetParam<float>(NetworkConfig::ClientAttributes::SPIKE_Z_SCORE);
+
+            if (!enabledOpt.has_value() && !tempRateOpt.has_value() && !tdsRateOpt.has_value() && !spikeZScoreOpt.has_value())
             {
-                return Result::Error("Internal error: Invalid JSON payload.");
+                return Result::Error("Missing parameters");
             }
 
+            enabled = enabledOpt.value_or(enabled);
+            tempRate = tempRateOpt.value_or(tempRate);
+            tdsRate = tdsRateOpt.value_or(tdsRate);
+            spikeZScore = spikeZScoreOpt.value_or(spikeZScore);
+
+            return Core::GuardianProxy::GetInstance()->SetTrendSensitivity(enabled, tempRate, tdsRate, spikeZScore);
+        }
+};
+
+//-----------------------------------------------------------------------------
+class AddFeedingScheduleHandler : public IRpcHandler 
+{
+    public:
+
+        static constexpr const char* NAME = "addFeedingSchedule";
+
+        //!
+        Result Handle(const Utils::JsonPayloadParser& parser) override
+        {
             const auto slotIdOpt = parser.GetParam<int>(NetworkConfig::ClientAttributes::FEED_SLOT_ID);
             const auto timeMinutesOpt = parser.GetParam<int>(NetworkConfig::ClientAttributes::FEED_TIME);
             const auto doseOpt = parser.GetParam<int>(NetworkConfig::ClientAttributes::FEED_DOSE);
@@ -231,14 +270,8 @@ class DeleteFeedingScheduleHandler : public IRpcHandler
         static constexpr const char* NAME = "deleteFeedingSchedule";
 
         //!
-        Result Handle(const std::string& payload) override 
+        Result Handle(const Utils::JsonPayloadParser& parser) override
         {
-            Utils::JsonPayloadParser parser(payload);
-            if (!parser.IsValid())
-            {
-                return Result::Error("Internal error: Invalid JSON payload.");
-            }
-
             const auto slotIdOpt = parser.GetParam<int>(NetworkConfig::ClientAttributes::FEED_SLOT_ID);
 
             if (!slotIdOpt.has_value())
@@ -265,14 +298,8 @@ class FeedNowHandler : public IRpcHandler
         static constexpr const char* NAME = "feedNow";
 
         //!
-        Result Handle(const std::string& payload) override 
+        Result Handle(const Utils::JsonPayloadParser& parser) override
         {
-            Utils::JsonPayloadParser parser(payload);
-            if (!parser.IsValid())
-            {
-                return Result::Error("Internal error: Invalid JSON payload.");
-            }
-
             int doses = 0;
 
             const auto dosesOpt = parser.GetParam<int>(NetworkConfig::ClientAttributes::FEED_DOSE);
@@ -296,14 +323,8 @@ class SetTimezoneHandler : public IRpcHandler
         static constexpr const char* NAME = "setTimezone";
 
         //!
-        Result Handle(const std::string& payload) override 
+        Result Handle(const Utils::JsonPayloadParser& parser) override
         {
-            Utils::JsonPayloadParser parser(payload);
-            if (!parser.IsValid())
-            {
-                return Result::Error("Invalid JSON payload.");
-            }
-
             const auto timezone = parser.GetParam<std::string>(NetworkConfig::ClientAttributes::TIMEZONE);
             
             if (!timezone.has_value())
@@ -324,7 +345,7 @@ class FactoryResetHandler : public IRpcHandler
         static constexpr const char* NAME = "factoryReset";
 
         //!
-        Result Handle(const std::string& payload) override 
+        Result Handle(const Utils::JsonPayloadParser& parser) override 
         {
             const auto result = Core::GuardianProxy::GetInstance()->FactoryReset();
             return result;
@@ -339,10 +360,200 @@ class SyncDeviceHandler : public IRpcHandler
         static constexpr const char* NAME = "syncDevice";
 
         //!
-        Result Handle(const std::string& payload) override 
+        Result Handle(const Utils::JsonPayloadParser& parser) override 
         {
             const auto result = Core::GuardianProxy::GetInstance()->SyncDevice();
             return result;
         }
 };
+
+//-----------------------------------------------------------------------------
+class GetTraceHandler : public IRpcHandler
+{
+    public:
+
+        static constexpr const char* NAME = "getTrace";
+        static constexpr int DEFAULT_MAX_EVENTS = 32;
+        static constexpr int LIMIT_MAX_EVENTS = 64;
+
+        //! The response is a series of messages (see HandleStreamed())
+        Result Handle(const Utils::JsonPayloadParser& parser) override
+        {
+            return Result::Error("getTrace answers in several messages");
+        }
+
+        //! Drains the oldest trace events, TRACE_RPC_CHUNK_EVENTS per message; the last
+        //! message has "last": true (see scripts/trace_to_chrome.py)
+        Result HandleStreamed(const Utils::JsonPayloadParser& parser, const ChunkSink& send) override
+        {
+            const size_t maxEvents = static_cast<size_t>(std::clamp(
+                parser.GetParam<int>(NetworkConfig::TraceKeys::MAX).value_or(DEFAULT_MAX_EVENTS), 1, LIMIT_MAX_EVENTS));
+
+            size_t drained = 0;
+            uint32_t seq = 0;
+
+            while (true)
+            {
+                // Each message gives its document back to the request arena once sent
+                std::optional<Memory::ArenaScope> messageScope;
+                if (Memory::Arena* arena = Memory::ArenaScope::GetCurrent())
+                {
+                    messageScope.emplace(*arena);
+                }
+
+                Comms::TraceChunkPayload payload(seq);
+                drained += Trace::Drain(std::min(Config::TRACE_RPC_CHUNK_EVENTS, maxEvents - drained),
+                                        [&payload](const Trace::Event& event) { payload.Add(event); });
+
+                const bool last = (drained >= maxEvents) || (Trace::GetPendingCount() == 0);
+                if (!send(payload.ToJsonString(last)))
+                {
+                    return Result::Error("Trace response interrupted.");
+                }
+
+                if (last)
+                {
+                    return Result::Success();
+                }
+
+                ++seq;
+            }
+        }
+};
+
+//-----------------------------------------------------------------------------
+class GetPerfStatsHandler : public IRpcHandler
+{
+    public:
+
+        static constexpr const char* NAME = "getPerfStats";
+
+        //! The response is the statistics object itself (see HandleStreamed())
+        Result Handle(const Utils::JsonPayloadParser& parser) override
+        {
+            return Result::Error("getPerfStats answers with its own message");
+        }
+
+        //! Module update latencies in one message, built in the request arena;
+        //! "reset": true starts a new window after reading
+        Result HandleStreamed(const Utils::JsonPayloadParser& parser, const ChunkSink& send) override
+        {
+            const Comms::PerfStatsPayload payload;
+            if (!send(payload.ToJsonString()))
+            {
+                return Result::Error("Failed to send the perf stats.");
+            }
+
+            if (parser.GetParam<bool>(NetworkConfig::PerfStatsKeys::RESET).value_or(false))
+            {
+                Perf::ResetAll();
+            }
+
+            return Result::Success();
+        }
+};
+
+//-----------------------------------------------------------------------------
+class GetHistoryHandler : public IRpcHandler
+{
+    public:
+
+        static constexpr const char* NAME = "getHistory";
+
+        //! The response is a series of messages (see HandleStreamed())
+        Result Handle(const Utils::JsonPayloadParser& parser) override
+        {
+            return Result::Error("getHistory answers in several messages");
+        }
+
+        //! Points of one reading from the on-device history, HISTORY_RPC_CHUNK_POINTS per message;
+        //! the last message has "last": true
+        Result HandleStreamed(const Utils::JsonPayloadParser& parser, const ChunkSink& send) override
+        {
+            using namespace NetworkConfig::HistoryKeys;
+            using Query = Services::HistoryQuery;
+
+            const auto key = parser.GetParam<std::string_view>(KEY);
+            const auto from = parser.GetParam<int64_t>(FROM);
+            const auto to = parser.GetParam<int64_t>(TO);
+            const auto resolution = parser.GetParam<int64_t>(RESOLUTION);
+
+            if (!key.has_value() || !from.has_value() || !to.has_value() || !resolution.has_value())
+            {
+                return Result::Error("Missing 'key', 'from', 'to' or 'resolution'.");
+            }
+
+            Query::Series series;
+            const char* name = nullptr;
+            if (key.value() == NetworkConfig::TelemetryKeys::TEMPERATURE)
+            {
+                series = Query::Series::TEMPERATURE;
+                name = NetworkConfig::TelemetryKeys::TEMPERATURE;
+            }
+            else if (key.value() == NetworkConfig::TelemetryKeys::TDS)
+            {
+                series = Query::Series::TDS;
+                name = NetworkConfig::TelemetryKeys::TDS;
+            }
+            else if (key.value() == BATTERY)
+            {
+                series = Query::Series::BATTERY;
+                name = BATTERY;
+            }
+            else
+            {
+                return Result::Error("Unknown history key.");
+            }
+
+            // Timestamps are 32-bit: a 'to' past that range means "until now"
+            constexpr int64_t MAX_TIMESTAMP = std::numeric_limits<uint32_t>::max();
+            if (from.value() < 0 || from.value() > MAX_TIMESTAMP || to.value() < from.value()
+             || resolution.value() < 1 || resolution.value() > MAX_TIMESTAMP)
+            {
+                return Result::Error("Invalid range or resolution.");
+            }
+
+            const uint32_t rangeFrom = static_cast<uint32_t>(from.value());
+            const uint32_t rangeTo = static_cast<uint32_t>(std::min(to.value(), MAX_TIMESTAMP));
+            Query query(series, rangeFrom, rangeTo, static_cast<uint32_t>(resolution.value()));
+
+            // One chunk ahead, so the message that goes out knows whether it is the last
+            size_t current = 0;
+            size_t count = query.Next(_points[current], Config::HISTORY_RPC_CHUNK_POINTS);
+            uint32_t seq = 0;
+
+            while (true)
+            {
+                // Each message gives its text back to the request arena once sent
+                std::optional<Memory::ArenaScope> messageScope;
+                if (Memory::Arena* arena = Memory::ArenaScope::GetCurrent())
+                {
+                    messageScope.emplace(*arena);
+                }
+
+                const size_t nextCount = query.Next(_points[1 - current], Config::HISTORY_RPC_CHUNK_POINTS);
+                const bool last = (nextCount == 0);
+
+                const Comms::HistoryChunkPayload payload(name, rangeFrom, rangeTo,
+                                                         query, seq, last, _points[current], count);
+                if (!send(payload.ToJsonString()))
+                {
+                    return Result::Error("History response interrupted.");
+                }
+
+                if (last)
+                {
+                    return Result::Success();
+                }
+
+                current = 1 - current;
+                count = nextCount;
+                ++seq;
+            }
+        }
+
+    private:
+
+        Services::HistoryQuery::Point _points[2][Config::HISTORY_RPC_CHUNK_POINTS];
+};
 } // namespace Handlers
\ No newline at end of file
@@ -7,13 +7,23 @@
 
 #include "src/managers/food_feeder.h"
 
+#include "esp_timer.h"
 #include "framework/common_defs.h"
 #include "include/config.h"
 #include "src/drivers/servo.h"
+#include "src/core/event_bus.h"
 #include "src/core/guardian_proxy.h"
+#include "src/services/history_log.h"
+#include <utility>
 
 namespace Managers {
 
+//----protected----------------------------------------------------------------
+Scheduler::Schedule FoodFeeder::GetSchedule() const
+{
+    return Scheduler::Schedule{ Config::FOOD_FEEDER_PERIOD_MS, Config::FOOD_FEEDER_DEADLINE_MS, Scheduler::WAKE_TIMER };
+}
+
 //----private------------------------------------------------------------------
 bool FoodFeeder::OnInit()
 {
@@ -23,7 +33,9 @@ bool FoodFeeder::OnInit()
     _servo->SetAngle(FEEDER_CLOSED_ANGLE);
     _servo->Release();
 
-    return true;
+    PublishState();
+
+    return _feedingPool.Start();
 }
 
 //----private------------------------------------------------------------------
@@ -31,39 +43,57 @@ void FoodFeeder::OnUpdate()
 {
     Utils::DateTime currentTime;
 
-    if (!Core::GuardianProxy::GetInstance()->GetDateTime(currentTime))
+    _isCurrentTimeValid = Core::GuardianProxy::GetInstance()->GetDateTime(currentTime);
+    _currentTimeSampledUs = esp_timer_get_time();
+
+    if (!_isCurrentTimeValid)
     {
         CORE_ERROR("Failed to get current time. System cannot get updated");
+        PublishState();
         return;
     }
 
+    _currentTime = currentTime;
+
     const int currentMinute = currentTime.ToMinutesOfDay();
 
     // Check feeding schedule
     if (currentMinute != _lastFeedTime)
     {
-        const auto& scheduleList = Core::GuardianProxy::GetInstance()->GetFeedingScheduleFromStorage();
-
-        for (const auto& entry : scheduleList)
+        // Collected first, so that the feeds do not start with the storage lock held
+        Services::FeeddingScheduleList dueEntries;
         {
-            if (entry._enabled && entry._min == currentMinute)
-            {
-                CORE_INFO("Scheduled feeding triggered for slot %d: Dose=%d at %d minutes after midnight.",
-                          entry._id, entry._dose, entry._min);
+            const auto schedule = Core::GuardianProxy::GetInstance()->GetFeedingScheduleFromStorage();
+            UpdatePlan(*schedule, schedule.GetGeneration());
 
-                const Result feedResult = this->Feed(entry._dose);
-                if (!feedResult.success)
-                {
-                    CORE_ERROR("Scheduled feeding failed: %s", feedResult.responseMessage.value_or("Unknown error").c_str());
-                }
-                else
+            for (const auto& entry : _plan.entries)
+            {
+                if (entry._min == currentMinute)
                 {
-                    _lastFeedTime = currentMinute;
-                    CORE_INFO("Scheduled feeding started successfully for slot %d.", entry._id);
+                    dueEntries.push_back(entry);
                 }
             }
         }
+
+        for (const auto& entry : dueEntries)
+        {
+            CORE_INFO("Scheduled feeding triggered for slot %d: Dose=%d at %d minutes after midnight.",
+                      entry._id, entry._dose, entry._min);
+
+            const Result feedResult = this->Feed(entry._dose);
+            if (!feedResult.success)
+            {
+                CORE_ERROR("Scheduled feeding failed: %s", feedResult.responseMessage.value_or("Unknown error").c_str());
+            }
+            else
+            {
+                _lastFeedTime = currentMinute;
+                CORE_INFO("Scheduled feeding started successfully for slot %d.", entry._id);
+            }
+        }
     }
+
+    PublishState();
 }
 
 //-----------------------------------------------------------------------------
@@ -77,25 +107,22 @@ auto FoodFeeder::Feed(int dose) -> Result
         return Result::Error("Invalid dose amount.");
     }
 
-    if (_feedingTask.IsBusy())
-    {
-        CORE_WARNING("Feeding already in progress.");
-        return Result::Error("Feeding in progress.");
-    }
+    const bool wasIdle = _feedingPool.IsIdle();
 
-    bool started = _feedingTask.Start(
-        [this, dose]()
+    const AsyncWorkerPool::JobId jobId = _feedingPool.Submit(
+        [this, dose](const AsyncWorkerPool::JobContext& context)
         {
-            this->PerformAsyncFeedingSequence(dose);
+            this->PerformAsyncFeedingSequence(dose, context);
         }
     );
 
-    if (!started)
+    if (jobId == AsyncWorkerPool::INVALID_JOB)
     {
-        return Result::Error("Internal Error: Failed to start feeding.");
+        CORE_WARNING("Feeding queue full.");
+        return Result::Error("Feeding queue full.");
     }
 
-    return Result::Success("Feeding process started");
+    return Result::Success(wasIdle ? "Feeding process started" : "Feeding queued");
 }
 
 //-----------------------------------------------------------------------------
@@ -135,6 +162,8 @@ auto FoodFeeder::AddFeedingScheduleEntry(int minutesAfterMidnight, int slotIndex
         return Result::Error("Internal error: Failed to save feeding schedule to storage");
     }
 
+    PublishState();
+
     CORE_INFO("Feeding schedule entry added/modified successfully.");
     return Result::Success("Feeding schedules updated.");
 }
@@ -160,6 +189,8 @@ auto FoodFeeder::DeleteFeedingScheduleEntry(int slotIndex) -> Result
         return Result::Error("Internal error: Failed to delete feeding schedule from storage");
     }
 
+    PublishState();
+
     CORE_INFO("Feeding schedule entry deleted successfully.");
     return Result::Success("Feeding schedule entry deleted.");
 }
@@ -167,78 +198,140 @@ auto FoodFeeder::DeleteFeedingScheduleEntry(int slotIndex) -> Result
 //-----------------------------------------------------------------------------
 auto FoodFeeder::GetFeederStatus() const -> FeederStatus
 {
-    FeederStatus status;
-
-    const auto& scheduleList = Core::GuardianProxy::GetInstance()->GetFeedingScheduleFromStorage();
     Utils::DateTime currentTime;
     if (!Core::GuardianProxy::GetInstance()->GetDateTime(currentTime))
     {
         CORE_ERROR("Failed to get current time. Status cannot be retrieved");
-        return status;
+        return FeederStatus{};
     }
 
-    const int currentMinutes = currentTime.ToMinutesOfDay();
+    const auto schedule = Core::GuardianProxy::GetInstance()->GetFeedingScheduleFromStorage();
+    UpdatePlan(*schedule, schedule.GetGeneration());
 
-    status.totalPerDay = 0;
-    status.remainingDosesToday = 0;
-    status.nextFeedDoses = 0;
-    status.nextFeedTime = Utils::DateTime(0, 0, 0); // Default to midnight
+    return ComputeFeederStatus(_plan, currentTime.ToMinutesOfDay());
+}
 
-    int earliestNextFeedMinutes = MINUTES_IN_A_DAY + 1;
+//----private------------------------------------------------------------------
+void FoodFeeder::PerformAsyncFeedingSequence(int dose, const AsyncWorkerPool::JobContext& context)
+{
+    CORE_INFO("Feeding sequence started for %d doses.", dose);
+
+    Core::EventBus::Publish(Events::FeedingStarted{ dose });
 
+    Drivers::Servo* servo = Drivers::Servo::GetInstance();
+
+    for (int i = 0; i < dose && !context.IsCancelRequested(); ++i)
+    {
+        CORE_INFO("Dispensing dose %d of %d.", i + 1, dose);
+
+        // Open feeder
+        servo->FadeToAngle(FEEDER_OPEN_ANGLE, FEEDER_MOVE_TIME_MS);
+        TaskDelayMs(FEEDER_MOVE_TIME_MS + FEEDER_WAIT_TIME_MS);
+
+        // Close feeder
+        servo->FadeToAngle(FEEDER_CLOSED_ANGLE, FEEDER_MOVE_TIME_MS);
+        TaskDelayMs(FEEDER_MOVE_TIME_MS + FEEDER_WAIT_TIME_MS);
+
+        servo->Release();
+    }
+
+    CORE_INFO("Feeding sequence completed for %d doses.", dose);
+    Core::EventBus::Publish(Events::FeedingFinished{ dose });
+    Services::HistoryLog::GetInstance()->RecordEvent(Services::HistoryLog::EventCode::FEEDING_DONE, dose);
+}
+
+//----private------------------------------------------------------------------
+void FoodFeeder::UpdatePlan(const Services::FeeddingScheduleList& scheduleList, uint32_t generation) const
+{
+    if (generation == _plan.generation)
+    {
+        return;
+    }
+
+    _plan.entries.clear();
+    _plan.totalPerDay = 0;
+
+    // Insertion by time; entries at the same time keep their schedule order
     for (const auto& entry : scheduleList)
     {
         if (entry._enabled)
         {
-            status.totalPerDay += entry._dose;
+            _plan.entries.push_back(entry);
+            _plan.totalPerDay += entry._dose;
 
-            if (entry._min > currentMinutes)
+            for (size_t i = _plan.entries.size() - 1; i > 0 && _plan.entries[i - 1]._min > entry._min; --i)
             {
-                status.remainingDosesToday += entry._dose;
-
-                if (entry._min < earliestNextFeedMinutes)
-                {
-                    earliestNextFeedMinutes = entry._min;
-                    status.nextFeedDoses = entry._dose;
-                }
+                std::swap(_plan.entries[i - 1], _plan.entries[i]);
             }
         }
     }
 
-    if (earliestNextFeedMinutes <= MINUTES_IN_A_DAY)
+    _plan.generation = generation;
+}
+
+//----private------------------------------------------------------------------
+auto FoodFeeder::ComputeFeederStatus(const FeedingPlan& plan, int currentMinutes) -> FeederStatus
+{
+    FeederStatus status;
+
+    status.totalPerDay = plan.totalPerDay;
+    status.remainingDosesToday = 0;
+    status.nextFeedDoses = 0;
+    status.nextFeedTime = Utils::DateTime(0, 0, 0); // Default to midnight
+
+    // The first entry after the current time is the next feed, the rest of the day follows it
+    bool foundNext = false;
+    for (const auto& entry : plan.entries)
     {
-        status.nextFeedTime = Utils::DateTime(earliestNextFeedMinutes * 60);
+        if (entry._min > currentMinutes)
+        {
+            status.remainingDosesToday += entry._dose;
+
+            if (!foundNext)
+            {
+                foundNext = true;
+                status.nextFeedDoses = entry._dose;
+                status.nextFeedTime = Utils::DateTime(entry._min * 60);
+            }
+        }
     }
 
     return status;
 }
 
-//----private------------------------------------------------------------------
-void FoodFeeder::PerformAsyncFeedingSequence(int dose)
+//-----------------------------------------------------------------------------
+void FoodFeeder::PublishState()
 {
-    CORE_INFO("Feeding sequence started for %d doses.", dose);
+    static_assert(Core::SystemSnapshot::MAX_SCHEDULE_ENTRIES >= MAX_FEEDING_SCHECULES, "Snapshot cannot hold every feeding slot");
 
-    Core::GuardianProxy::GetInstance()->UpdateFeedingStatusIndicator(true);
+    auto* proxy = Core::GuardianProxy::GetInstance();
 
-    Drivers::Servo* servo = Drivers::Servo::GetInstance();
+    Core::SystemSnapshot::Clock clock;
+    clock.time = _currentTime;
+    clock.sampledUs = _currentTimeSampledUs;
+    clock.valid = _isCurrentTimeValid;
+    clock.synced = proxy->IsTimeSynced();
 
-    for (int i = 0; i < dose; ++i)
+    Core::SystemSnapshot::Feeder feeder;
     {
-        CORE_INFO("Dispensing dose %d of %d.", i + 1, dose);
-
-        // Open feeder
-        servo->FadeToAngle(FEEDER_OPEN_ANGLE, FEEDER_MOVE_TIME_MS);
-        TaskDelayMs(FEEDER_MOVE_TIME_MS + FEEDER_WAIT_TIME_MS);
+        const auto schedule = proxy->GetFeedingScheduleFromStorage();
+        UpdatePlan(*schedule, schedule.GetGeneration());
 
-        // Close feeder
-        servo->FadeToAngle(FEEDER_CLOSED_ANGLE, FEEDER_MOVE_TIME_MS);
-        TaskDelayMs(FEEDER_MOVE_TIME_MS + FEEDER_WAIT_TIME_MS);
+        for (const auto& entry : *schedule)
+        {
+            if (feeder.scheduleCount < Core::SystemSnapshot::MAX_SCHEDULE_ENTRIES)
+            {
+                feeder.schedule[feeder.scheduleCount++] = entry;
+            }
+        }
 
-        servo->Release();
+        if (clock.valid)
+        {
+            feeder.status = ComputeFeederStatus(_plan, clock.Now().ToMinutesOfDay());
+        }
     }
 
-    CORE_INFO("Feeding sequence completed for %d doses.", dose);
-    Core::GuardianProxy::GetInstance()->UpdateFeedingStatusIndicator(false);
+    proxy->PublishFeederState(feeder, clock);
 }
 
 } // namespace Managers
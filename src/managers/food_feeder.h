@@ -9,9 +9,11 @@
 #define FOOD_FEEDER_H
 
 #include "framework/common_defs.h"
-#include "framework/os/async_worker.h"
+#include "framework/os/async_worker_pool.h"
 #include "src/core/base/manager.h"
+#include "src/core/feeder_status.h"
 #include "src/drivers/servo.h"
+#include "src/services/memory/memory_config_data.h"
 #include "src/utils/date_time.h"
 
 struct Result;
@@ -27,6 +29,7 @@ class FoodFeeder :   public Base::Singleton<FoodFeeder>
         * @brief Feed a specific dose of food.
         * @param dose Amount of food to dispense.
         * @return Result Success or error result of the feeding operation.
+        * @note Requests arriving while a feed is running are queued, up to FEEDING_QUEUE_DEPTH.
         */
         auto Feed(int dose) -> Result;
 
@@ -47,13 +50,7 @@ class FoodFeeder :   public Base::Singleton<FoodFeeder>
         */
         auto DeleteFeedingScheduleEntry(int slotIndex) -> Result;
 
-        struct FeederStatus
-        {
-            Utils::DateTime nextFeedTime;
-            int nextFeedDoses;
-            int remainingDosesToday;
-            int totalPerDay;
-        };
+        using FeederStatus = Core::FeederStatus;
 
         /*!
         * @brief Get the current status of the feeder.
@@ -61,6 +58,11 @@ class FoodFeeder :   public Base::Singleton<FoodFeeder>
         */
         auto GetFeederStatus() const -> FeederStatus;
 
+        /*!
+        * @brief Publish the schedule, its status and the last RTC time to the system snapshot.
+        */
+        void PublishState();
+
     protected:
 
         friend class Base::Singleton<FoodFeeder>;
@@ -71,6 +73,12 @@ class FoodFeeder :   public Base::Singleton<FoodFeeder>
         */
         const char* GetModuleName() const override { return "FoodFeeder"; }
 
+        /*!
+        * @brief Get the scheduling requirements.
+        * @return Scheduler::Schedule Periodic check of the feeding schedule.
+        */
+        Scheduler::Schedule GetSchedule() const override;
+
         /*!
          * @brief Initializes the Module.
          *        This method should be called once at the start of the application.
@@ -89,13 +97,33 @@ class FoodFeeder :   public Base::Singleton<FoodFeeder>
         /*!
         * @brief Perform the feeding sequence for the specified dose.
         * @param dose Amount of food to dispense.
+        * @param context Worker context, checked between doses for cancellation.
         */
-        void PerformAsyncFeedingSequence(int dose);
+        void PerformAsyncFeedingSequence(int dose, const AsyncWorkerPool::JobContext& context);
+
+        //! Enabled entries of the schedule sorted by time: derived once per schedule generation
+        struct FeedingPlan
+        {
+            Services::FeeddingScheduleList entries;
+            int totalPerDay = 0;
+            uint32_t generation = 0;                //!< Of the schedule it was derived from (0: none yet)
+        };
+
+        /*!
+        * @brief Derive the plan again if the schedule changed since it was derived.
+        *        Only call it with the schedule view held: its lock guards the plan.
+        */
+        void UpdatePlan(const Services::FeeddingScheduleList& scheduleList, uint32_t generation) const;
+
+        /*!
+        * @brief Compute the feeder status of a plan at the given time of day.
+        */
+        static auto ComputeFeederStatus(const FeedingPlan& plan, int currentMinutes) -> FeederStatus;
 
         //---------------------------------------------
 
         FoodFeeder() 
-            : _feedingTask("feeding_task", 4096) 
+            : _feedingPool({ "feeding", 1, FEEDING_QUEUE_DEPTH, 4096 })
             , _lastFeedTime(-1)
         {}
         ~FoodFeeder() = default;
@@ -104,7 +132,7 @@ class FoodFeeder :   public Base::Singleton<FoodFeeder>
 
         //---------------------------------------------
 
-        static constexpr const int MAX_FEEDING_SCHECULES = 10;
+        static constexpr const int MAX_FEEDING_SCHECULES = static_cast<int>(Services::MAX_FEEDING_SCHEDULE_ENTRIES);
         static constexpr const int MINUTES_IN_A_DAY = 1440;
         static constexpr const int MIN_FEED_DOSE = 1;
         static constexpr const int MAX_FEED_DOSE = 5;
@@ -112,13 +140,20 @@ class FoodFeeder :   public Base::Singleton<FoodFeeder>
         static constexpr const float FEEDER_CLOSED_ANGLE = 150.0f;
         static constexpr const int FEEDER_MOVE_TIME_MS = 1000;
         static constexpr const int FEEDER_WAIT_TIME_MS = 300;
+        static constexpr const uint8_t FEEDING_QUEUE_DEPTH = 3;
 
         //---------------------------------------------
 
         Drivers::Servo* _servo = nullptr;
 
-        AsyncWorker _feedingTask;
+        AsyncWorkerPool _feedingPool;
         int _lastFeedTime;
+
+        mutable FeedingPlan _plan;                  //!< Guarded by the storage lock (see UpdatePlan)
+
+        Utils::DateTime _currentTime;               //!< Last RTC read, published with the status
+        int64_t _currentTimeSampledUs = 0;
+        bool _isCurrentTimeValid = false;
 };
 
 } // namespace Managers
@@ -12,16 +12,26 @@
 #include "src/connectivity/ap_portal.h"
 #include "src/connectivity/mqtt_client.h"
 #include "src/connectivity/wifi_com.h"
+#include "src/core/boot_orchestrator.h"
+#include "src/core/event_bus.h"
 #include "src/core/guardian_proxy.h"
 #include "src/core/guardian_public_interfaces.h"
 
 #include "src/managers/comms/cloud_payloads.h"
 #include "src/managers/comms/json_parser.h"
 #include "src/managers/comms/network_config.h"
+#include "src/services/power_controller.h"
 #include "src/services/storage_service.h"
+#include <charconv>
 
 namespace Managers {
 
+//----protected----------------------------------------------------------------
+Scheduler::Schedule NetworkController::GetSchedule() const
+{
+    return Scheduler::Schedule{ Config::NETWORK_CONTROLLER_PERIOD_MS, Config::NETWORK_CONTROLLER_DEADLINE_MS, Scheduler::WAKE_TIMER | Scheduler::WAKE_QUEUE };
+}
+
 //----protected----------------------------------------------------------------
 bool NetworkController::OnInit()
 {
@@ -39,10 +49,20 @@ bool NetworkController::OnInit()
     success &= _apPortal->Init();
 
     _wifiCom->SetCredentials(
-        Core::GuardianProxy::GetInstance()->GetWifiSsidFromStorage(),
-        Core::GuardianProxy::GetInstance()->GetWifiPasswordFromStorage()
+        *Core::GuardianProxy::GetInstance()->GetWifiSsidFromStorage(),
+        *Core::GuardianProxy::GetInstance()->GetWifiPasswordFromStorage()
     );
 
+    // Bring the station up right away so association overlaps the rest of the boot.
+    // The boot sequence already waited for the supply to settle, no stabilization delay needed
+    if (success && Services::PowerController::GetInstance()->GetCurrentMode() == Services::PowerController::Mode::MODE_USB_POWERED)
+    {
+        CORE_INFO("Starting WiFi connection");
+        _wifiCom->Start();
+        _wifiCom->Update();
+        ChangeState(State::WAITING_FOR_WIFI, WIFI_CONNECTION_TIMEOUT_MS);
+    }
+
     return success;
 }
 
@@ -53,6 +73,9 @@ void NetworkController::OnUpdate()
     _mqttClient->Update();
     _apPortal->Update();
 
+    PublishConnectivityState();
+    ProcessEvents();
+
     switch (_state)
     {
         case State::INIT:
@@ -164,20 +187,15 @@ void NetworkController::OnUpdate()
             );
 
             _mqttClient->SetMessageCallback(
-                [this](const std::string& topic, const std::string& payload)
+                [this](std::string_view topic, std::string_view payload)
                 {
                     DispatchMqttMessage(topic, payload);
                 }
             );
 
-            const auto result = SendClientAttributes();
-            if (!result.success)
-            {
-                CORE_ERROR("Failed to send client attributes: %s", result.responseMessage.value().c_str());
-                ChangeState(State::ERROR);
-            }
-
-            ChangeState(State::IDLE);
+            // First telemetry (and the client attributes) as soon as the broker is up,
+            // not one interval after boot
+            ChangeState(State::SEND_TELEMETRY);
         }
         break;
 
@@ -185,10 +203,20 @@ void NetworkController::OnUpdate()
         {
             if (IsWiFiConnected() && IsMqttClientConnected())
             {
-                if (_telemetrySendDelay.HasFinished())
+                if (_telemetrySendDelay.HasFinished() || _telemetryPending)
                 {
                     ChangeState(State::SEND_TELEMETRY);
                 }
+                else if (_clientAttributesPending)
+                {
+                    _clientAttributesPending = false;
+
+                    const auto result = SendClientAttributes();
+                    if (!result.success)
+                    {
+                        CORE_ERROR("Failed to send client attributes: %s", result.responseMessage.value().c_str());
+                    }
+                }
             }
             else
             {
@@ -201,7 +229,16 @@ void NetworkController::OnUpdate()
         case State::SEND_TELEMETRY:
         {
             SendTelemtry();
-            SendClientAttributes();
+            _telemetrySendDelay.Start(Config::TELEMETRY_SEND_INTERVAL_MS);
+            _telemetryPending = false;
+
+            const auto result = SendClientAttributes();
+            if (!result.success)
+            {
+                CORE_ERROR("Failed to send client attributes: %s", result.responseMessage.value().c_str());
+            }
+
+            _clientAttributesPending = false;
             ChangeState(State::IDLE);
         }
         break;
@@ -375,7 +412,7 @@ bool NetworkController::IsWiFiConnected() const
 }
 
 //-----------------------------------------------------------------------------
-std::string NetworkController::GetWifiSsid() const
+const char* NetworkController::GetWifiSsid() const
 {
     return _wifiCom->GetSsid();
 }
@@ -409,14 +446,66 @@ void NetworkController::RegisterRpcHandlers()
 {
     _rpcHandlers[Handlers::SetTempLimitsHandler::NAME]          = std::make_unique<Handlers::SetTempLimitsHandler>();
     _rpcHandlers[Handlers::SetTdsLimitsHandler::NAME]           = std::make_unique<Handlers::SetTdsLimitsHandler>();
+    _rpcHandlers[Handlers::SetTrendSensitivityHandler::NAME]    = std::make_unique<Handlers::SetTrendSensitivityHandler>();
     _rpcHandlers[Handlers::AddFeedingScheduleHandler::NAME]     = std::make_unique<Handlers::AddFeedingScheduleHandler>();
     _rpcHandlers[Handlers::DeleteFeedingScheduleHandler::NAME]  = std::make_unique<Handlers::DeleteFeedingScheduleHandler>();
     _rpcHandlers[Handlers::FeedNowHandler::NAME]                = std::make_unique<Handlers::FeedNowHandler>();
     _rpcHandlers[Handlers::SetTimezoneHandler::NAME]            = std::make_unique<Handlers::SetTimezoneHandler>();
     _rpcHandlers[Handlers::FactoryResetHandler::NAME]           = std::make_unique<Handlers::FactoryResetHandler>();
     _rpcHandlers[Handlers::SyncDeviceHandler::NAME]             = std::make_unique<Handlers::SyncDeviceHandler>();
+    _rpcHandlers[Handlers::GetTraceHandler::NAME]               = std::make_unique<Handlers::GetTraceHandler>();
+    _rpcHandlers[Handlers::GetPerfStatsHandler::NAME]           = std::make_unique<Handlers::GetPerfStatsHandler>();
+    _rpcHandlers[Handlers::GetHistoryHandler::NAME]             = std::make_unique<Handlers::GetHistoryHandler>();
 }
     
+//----private------------------------------------------------------------------
+void NetworkController::PublishConnectivityState()
+{
+    const bool wifiConnected = IsWiFiConnected();
+    const bool mqttConnected = IsMqttClientConnected();
+    const bool apPortalActive = IsApPortalActive();
+
+    const bool changed = (wifiConnected != _publishedConnectivity.wifiConnected)
+                      || (mqttConnected != _publishedConnectivity.mqttConnected)
+                      || (apPortalActive != _publishedConnectivity.apPortalActive);
+
+    if (!changed && !_connectivityRefresh.HasFinished())
+    {
+        return;
+    }
+
+    Core::SystemSnapshot::Connectivity connectivity;
+    connectivity.wifiConnected = wifiConnected;
+    connectivity.mqttConnected = mqttConnected;
+    connectivity.apPortalActive = apPortalActive;
+    connectivity.wifiRssi = GetWifiRssi();
+    snprintf(connectivity.wifiSsid, sizeof(connectivity.wifiSsid), "%s", GetWifiSsid());
+
+    Core::GuardianProxy::GetInstance()->PublishConnectivityState(connectivity);
+
+    _publishedConnectivity = connectivity;
+    _connectivityRefresh.Start(CONNECTIVITY_REFRESH_MS);
+
+    if (changed)
+    {
+        Core::EventBus::Publish(Events::ConnectivityChanged{ wifiConnected, mqttConnected, apPortalActive });
+    }
+}
+
+//----private------------------------------------------------------------------
+void NetworkController::OnEvent(const Events::ConfigChanged& event)
+{
+    CORE_INFO("Configuration changed (section %d), client attributes pending", static_cast<int>(event.section));
+    _clientAttributesPending = true;
+}
+
+//----private------------------------------------------------------------------
+void NetworkController::OnEvent(const Events::ReadingAnomaly& event)
+{
+    CORE_INFO("Reading anomaly (sensor %d, kind %d), telemetry pending", static_cast<int>(event.sensor), static_cast<int>(event.kind));
+    _telemetryPending = true;
+}
+
 //----private------------------------------------------------------------------
 void NetworkController::ChangeState(const State newState, const int delayMs)
 {
@@ -425,31 +514,34 @@ void NetworkController::ChangeState(const State newState, const int delayMs)
 }
 
 //----private------------------------------------------------------------------
-void NetworkController::DispatchMqttMessage(const std::string& topic, const std::string& payload)
+void NetworkController::DispatchMqttMessage(std::string_view topic, std::string_view payload)
 {
-    CORE_INFO("Received MQTT message on topic: %s\n payload: %s", topic.c_str(), payload.c_str());
+    Memory::ArenaScope scope(_requestArena);
 
-    if (topic.find("rpc/request/") != std::string::npos)
+    CORE_INFO("Received MQTT message on topic: %.*s\n payload: %.*s",
+              static_cast<int>(topic.size()), topic.data(), static_cast<int>(payload.size()), payload.data());
+
+    if (topic.find("rpc/request/") != std::string_view::npos)
     {
         DispatchRpcRequest(topic, payload);
     }
-    else if (topic.find("v1/devices/me/attributes") != std::string::npos)
+    else if (topic.find("v1/devices/me/attributes") != std::string_view::npos)
     {
         DispatchAttributesRequest(payload);
     }
     else
     {
-        CORE_WARNING("MQTT message on unknown topic: %s", topic.c_str());
+        CORE_WARNING("MQTT message on unknown topic: %.*s", static_cast<int>(topic.size()), topic.data());
     }
 }
 
 //----private------------------------------------------------------------------
-void NetworkController::DispatchRpcRequest(const std::string& topic, const std::string& payload)
+void NetworkController::DispatchRpcRequest(std::string_view topic, std::string_view payload)
 {
     Utils::JsonPayloadParser parser(payload);
     if (!parser.IsValid())
     {
-        CORE_ERROR("Invalid JSON in RPC payload: %s", parser.GetError().c_str());
+        CORE_ERROR("Invalid JSON in RPC payload: %s", parser.GetError());
         return;
     }
 
@@ -463,12 +555,44 @@ void NetworkController::DispatchRpcRequest(const std::string& topic, const std::
     auto it = _rpcHandlers.find(method.value());
     if (it != _rpcHandlers.end())
     {
-        // Call the registered handler
-        const Result result = it->second->Handle(payload);
-
         // Extract request ID from topic and send response
         const int requestId = ExtractRequestId(topic);
-        const std::string responseTopic = std::string(RPC_RESPONSE_TOPIC) + std::to_string(requestId);
+        char responseTopic[64];
+        snprintf(responseTopic, sizeof(responseTopic), "%s%d", RPC_RESPONSE_TOPIC, requestId);
+
+        // Call the registered handler; a long response goes out as it is produced.
+        // The sink captures a single pointer so the ChunkSink stores it inline
+        struct
+        {
+            Connectivity::MqttClient* client;
+            const char* topic;
+            size_t messagesSent;
+        } sink = { _mqttClient, responseTopic, 0 };
+
+        const Result result = it->second->HandleStreamed(parser, [&sink](std::string_view message)
+            {
+                if (!sink.client->Publish(sink.topic, message))
+                {
+                    return false;
+                }
+                ++sink.messagesSent;
+                return true;
+            }
+        );
+        const size_t messagesSent = sink.messagesSent;
+
+        if (messagesSent > 0)
+        {
+            if (!result.success)
+            {
+                CORE_ERROR("RPC response to topic %s cut short after %u messages", responseTopic, static_cast<unsigned>(messagesSent));
+            }
+            else
+            {
+                CORE_INFO("Published RPC response to topic: %s in %u messages", responseTopic, static_cast<unsigned>(messagesSent));
+            }
+            return;
+        }
 
         // Prepare the response JSON
         Json responseJson;
@@ -479,62 +603,43 @@ void NetworkController::DispatchRpcRequest(const std::string& topic, const std::
         
         if (result.responseMessage.has_value()) 
         {
-            responseJson[NetworkConfig::Key::RESPONSE_MSG] = result.responseMessage.value();
+            responseJson[NetworkConfig::Key::RESPONSE_MSG] = result.responseMessage.value().c_str();
         }
    
         // Serialize and publish the response
+        const auto responsePayload = Memory::DumpArenaJson(responseJson);
         const bool publishSuccess = _mqttClient->Publish(
             responseTopic,
-            responseJson.dump()
+            responsePayload
         );
 
         if (!publishSuccess)
         {
-            CORE_ERROR("Failed to publish RPC response to topic: %s", responseTopic.c_str());
+            CORE_ERROR("Failed to publish RPC response to topic: %s", responseTopic);
         }
         else
         {
             CORE_INFO("Published RPC response to topic: %s with payload: %s", 
-                responseTopic.c_str()
-              , responseJson.dump().c_str()
+                responseTopic
+              , responsePayload.c_str()
             );
         }
-
-        if (result.success && _mqttClient->IsConnected())
-        {
-            const std::string& methodName = method.value();
-            if (methodName == Handlers::SetTempLimitsHandler::NAME ||
-                methodName == Handlers::SetTdsLimitsHandler::NAME ||
-                methodName == Handlers::AddFeedingScheduleHandler::NAME ||
-                methodName == Handlers::DeleteFeedingScheduleHandler::NAME ||
-                methodName == Handlers::SetTimezoneHandler::NAME ||
-                methodName == Handlers::FactoryResetHandler::NAME)
-            {
-                const auto result = SendClientAttributes();
-                if (!result.success)
-                {
-                    CORE_ERROR("Failed to send client attributes: %s", result.responseMessage.value().c_str());
-                }
-            }
-        }
     }
     else
     {
-        CORE_WARNING("Unknown RPC method: %s", method.value().c_str());
+        CORE_WARNING("Unknown RPC method: %.*s", static_cast<int>(method.value().size()), method.value().data());
     }
 }
 
 //----private------------------------------------------------------------------
-void NetworkController::DispatchAttributesRequest(const std::string& payload)
+void NetworkController::DispatchAttributesRequest(std::string_view payload)
 {
-    Json json;
-    if (!Json::accept(payload))
+    const Json json = Memory::ParseArenaJson(payload);
+    if (json.is_discarded())
     {
-        CORE_ERROR("Invalid JSON received in RPC payload: %s", payload.c_str());
+        CORE_ERROR("Invalid JSON received in RPC payload: %.*s", static_cast<int>(payload.size()), payload.data());
         return;
     }
-
-    json = Json::parse(payload);
 }
 
 //----private------------------------------------------------------------------
@@ -542,9 +647,11 @@ void NetworkController::SendTelemtry()
 {
     CORE_INFO("Sending telemetry data...");
 
+    Memory::ArenaScope scope(_requestArena);
+
     // Get telemetry data
     Comms::TelemetryPayload telemetryPayload;
-    const std::string payload = telemetryPayload.ToJsonString();
+    const auto payload = telemetryPayload.ToJsonString();
 
     // Publish telemetry data
     const bool success = _mqttClient->Publish(
@@ -555,6 +662,7 @@ void NetworkController::SendTelemtry()
     if (success)
     {
         CORE_INFO("Telemetry data sent successfully");
+        Core::BootOrchestrator::GetInstance()->MarkMilestone(Core::BootOrchestrator::Milestone::FIRST_TELEMETRY);
         CORE_INFO("Payload sent: %s", payload.c_str());
     }
     else
@@ -574,8 +682,10 @@ Result NetworkController::SendClientAttributes()
 
     CORE_INFO("Sending client attributes to ThingsBoard...");
 
+    Memory::ArenaScope scope(_requestArena);
+
     Comms::ClientAttributesPayload attributesPayload;
-    const std::string payload = attributesPayload.ToJsonString();
+    const auto payload = attributesPayload.ToJsonString();
     CORE_INFO("Client attributes to send: %s", payload.c_str());
 
     const bool success = _mqttClient->Publish(ATTRIBUTES_TOPIC, payload);
@@ -593,20 +703,23 @@ Result NetworkController::SendClientAttributes()
 }
 
 //----private------------------------------------------------------------------
-int NetworkController::ExtractRequestId(const std::string& url)
+int NetworkController::ExtractRequestId(std::string_view url)
 {
-    size_t lastSlashPos = url.find_last_of('/');
+    const size_t lastSlashPos = url.find_last_of('/');
+    int id = ::INVALID;
 
-    if (lastSlashPos != std::string::npos && lastSlashPos < url.length() - 1) 
-    {
-        std::string idStr = url.substr(lastSlashPos + 1);
-        return std::stoi(idStr);
-    }
-    else
+    if (lastSlashPos != std::string_view::npos && lastSlashPos < url.length() - 1)
     {
-        CORE_ERROR("Failed to extract ID from URL: %s", url.c_str());
-        return ::INVALID;
+        const char* first = url.data() + lastSlashPos + 1;
+        const char* last = url.data() + url.size();
+        if (std::from_chars(first, last, id).ec == std::errc())
+        {
+            return id;
+        }
     }
+
+    CORE_ERROR("Failed to extract ID from URL: %.*s", static_cast<int>(url.size()), url.data());
+    return ::INVALID;
 }
 
 } // namespace Managers
\ No newline at end of file
@@ -9,14 +9,20 @@
 #define NETWORK_CONTROLLER_H
 
 #include "framework/common_defs.h"
+#include "framework/memory/arena.h"
 #include "framework/util/delay.h"
-#include "lib/nlohmann_json/json.hpp"
+#include "include/config.h"
+#include "framework/memory/arena_json.h"
 #include "src/core/base/manager.h"
+#include "src/core/event_subscriber.h"
+#include "src/core/events.h"
+#include "src/core/system_snapshot.h"
 #include "src/managers/comms/rpc_handler.h"
 #include <functional>
 #include <map>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 
 namespace Connectivity { class WiFiCom; }
@@ -27,10 +33,11 @@ namespace Managers {
 
 class NetworkController : public Base::Singleton<NetworkController>
                         , public Base::Manager
+                        , public Core::EventSubscriber<NetworkController, Events::ConfigChanged, Events::ReadingAnomaly>
 {
     public:
 
-        using Json = nlohmann::json;
+        using Json = Memory::ArenaJson;
 
         /*!
         * @brief Activate AP mode for configuration.
@@ -48,7 +55,7 @@ class NetworkController : public Base::Singleton<NetworkController>
         * @brief Get connected WiFi SSID.
         * @return SSID when connected, empty string otherwise.
         */
-        std::string GetWifiSsid() const;
+        const char* GetWifiSsid() const;
 
         /*!
         * @brief Get WiFi RSSI in dBm.
@@ -77,6 +84,7 @@ class NetworkController : public Base::Singleton<NetworkController>
     protected:
 
         friend class Base::Singleton<NetworkController>;
+        friend Subscriber;
 
         /*!
         * @brief Get the module name.
@@ -84,6 +92,12 @@ class NetworkController : public Base::Singleton<NetworkController>
         */
         const char* GetModuleName() const override { return "NetworkController"; }
 
+        /*!
+        * @brief Get the scheduling requirements.
+        * @return Scheduler::Schedule Periodic connectivity state machine.
+        */
+        Scheduler::Schedule GetSchedule() const override;
+
         /*!
          * @brief Initializes the Module.
          *        This method should be called once at the start of the application.
@@ -147,23 +161,24 @@ class NetworkController : public Base::Singleton<NetworkController>
 
         /*!
         * @brief Dispatch incoming MQTT messages to appropriate handlers.
+        *        Everything built while handling the message lives in _requestArena.
         * @param topic     The topic of the incoming message.
         * @param payload   The payload of the incoming message.
         */
-        void DispatchMqttMessage(const std::string& topic, const std::string& payload);
+        void DispatchMqttMessage(std::string_view topic, std::string_view payload);
 
         /*!
         * @brief Handle incoming RPC request payload.
         * @param topic     The RPC request topic.
         * @param payload   The RPC request payload.
         */
-        void DispatchRpcRequest(const std::string& topic, const std::string &payload);
+        void DispatchRpcRequest(std::string_view topic, std::string_view payload);
 
         /*!
         * @brief Handle incoming Attributes request payload.
         * @param payload   The Attributes request payload.
         */
-        void DispatchAttributesRequest(const std::string &payload);
+        void DispatchAttributesRequest(std::string_view payload);
 
         /*!
         * @brief Send telemetry data to the MQTT broker.
@@ -172,7 +187,7 @@ class NetworkController : public Base::Singleton<NetworkController>
 
         /*!
         * @brief Publish device config as Client Attributes to ThingsBoard.
-        *        Called on MQTT connect and after config-changing RPCs.
+        *        Called on MQTT connect, with the telemetry and after every ConfigChanged.
         *        Enables Device-led Source of Truth (dashboard reads CLIENT_SCOPE).
         * @return Result indicating success or failure.
         */
@@ -183,11 +198,31 @@ class NetworkController : public Base::Singleton<NetworkController>
         * @param url   The RPC request URL.
         * @return int  The extracted request ID.
         */
-        int ExtractRequestId(const std::string& url);
+        int ExtractRequestId(std::string_view url);
+
+        /*!
+        * @brief Publish the link states to the system snapshot when they change,
+        *        and every CONNECTIVITY_REFRESH_MS for the RSSI.
+        */
+        void PublishConnectivityState();
+
+        /*!
+        * @brief Mark the client attributes for resend; sent from IDLE, so several
+        *        changes in a row produce a single publish.
+        */
+        void OnEvent(const Events::ConfigChanged& event);
+
+        /*!
+        * @brief Send the telemetry (which carries the warning flags) without waiting
+        *        for the interval.
+        */
+        void OnEvent(const Events::ReadingAnomaly& event);
 
         //---------------------------------------------
 
-        NetworkController(){}
+        NetworkController()
+            : _requestArena("network")
+        {}
         ~NetworkController() = default;
         NetworkController(const NetworkController&) = delete;
         NetworkController& operator=(const NetworkController&) = delete;
@@ -202,6 +237,7 @@ class NetworkController : public Base::Singleton<NetworkController>
         static constexpr uint32_t WIFI_CONNECTION_TIMEOUT_MS = 5000;    //!< 5 seconds
         static constexpr uint32_t TIME_SYNC_TIMEOUT_MS = 10000;         //!< 10 seconds
         static constexpr uint32_t MQTT_CLIENT_TIMEOUT_MS = 10000;       //!< 10 seconds
+        static constexpr uint32_t CONNECTIVITY_REFRESH_MS = 5000;       //!< 5 seconds
 
         //---------------------------------------------
 
@@ -212,7 +248,12 @@ class NetworkController : public Base::Singleton<NetworkController>
         State _state;
         Delay _telemetrySendDelay;
         Delay _delayTimeout;
-        std::map<std::string, std::unique_ptr<Handlers::IRpcHandler>> _rpcHandlers;
+        Delay _connectivityRefresh;
+        Core::SystemSnapshot::Connectivity _publishedConnectivity;
+        bool _clientAttributesPending = false;
+        bool _telemetryPending = false;
+        std::map<std::string, std::unique_ptr<Handlers::IRpcHandler>, std::less<>> _rpcHandlers;
+        Memory::StaticArena<Config::NETWORK_ARENA_SIZE> _requestArena;     //!< Scratch for one RPC / publish, reset after each
         
 };
 
@@ -8,6 +8,7 @@
 #include "src/managers/user_interface.h"
 
 #include "framework/common_defs.h"
+#include "include/config.h"
 #include "src/core/guardian_proxy.h"
 #include "src/drivers/graphic_display.h"
 #include "src/services/real_time_clock.h"
@@ -15,6 +16,12 @@
 
 namespace Managers {
 
+//----protected----------------------------------------------------------------
+Scheduler::Schedule UserInterface::GetSchedule() const
+{
+    return Scheduler::Schedule{ Config::USER_INTERFACE_PERIOD_MS, Config::USER_INTERFACE_DEADLINE_MS, Scheduler::WAKE_TIMER | Scheduler::WAKE_QUEUE };
+}
+
 //----protected----------------------------------------------------------------
 bool UserInterface::OnInit()
 {
@@ -73,16 +80,24 @@ bool UserInterface::OnInit()
 //----protected----------------------------------------------------------------
 void UserInterface::OnUpdate()
 {
+    // Events posted by other managers, applied before drawing
+    {
+        ProcessEvents();
+    }
+
+    // One consistent copy of everything shown, no storage or bus access
+    const Core::SystemSnapshot snapshot = Core::GuardianProxy::GetInstance()->GetSnapshot();
+
     // Power status
     {
-        UpdatePowerIndicator();
+        UpdatePowerIndicator(snapshot.power);
     }
 
     // Connection status
     {
-        bool wifiOk = Core::GuardianProxy::GetInstance()->IsWifiConnected();
-        bool cloudOk = Core::GuardianProxy::GetInstance()->IsMqttConnected();
-        bool apPortalOk = Core::GuardianProxy::GetInstance()->IsApPortalActive();
+        const bool wifiOk = snapshot.connectivity.wifiConnected;
+        const bool cloudOk = snapshot.connectivity.mqttConnected;
+        const bool apPortalOk = snapshot.connectivity.apPortalActive;
 
         if (!wifiOk)
         {   
@@ -123,10 +138,9 @@ void UserInterface::OnUpdate()
 
     // Time
     {
-        Utils::DateTime dateTime;
-        if (Core::GuardianProxy::GetInstance()->GetDateTime(dateTime))
+        if (snapshot.clock.valid)
         {
-            _time->SetText(dateTime.ToString().c_str());
+            _time->SetText(snapshot.clock.Now().ToString().c_str());
         }
     }
 
@@ -134,20 +148,16 @@ void UserInterface::OnUpdate()
     {
         char buffer [50];
 
-        const float tempReading = Core::GuardianProxy::GetInstance()->GetTemperatureReading();
-        std::sprintf(buffer, "%.1f", tempReading);
+        const auto& water = snapshot.water;
+
+        std::sprintf(buffer, "%.1f", water.temperature);
 
         _tempValue->SetText(buffer);
 
         // Temperature limits
-        float minTemp = 0.0f, maxTemp = 0.0f;
-        bool isMinLimitEnabled = false, isMaxLimitEnabled = false;
-
-        Core::GuardianProxy::GetInstance()->GetTemperatureLimits(minTemp, isMinLimitEnabled, maxTemp, isMaxLimitEnabled);
-
-        if (isMinLimitEnabled)
+        if (water.minTempEnabled)
         {
-            std::sprintf(buffer, "%.1f °C", minTemp);
+            std::sprintf(buffer, "%.1f °C", water.minTemp);
         }
         else
         {
@@ -156,9 +166,9 @@ void UserInterface::OnUpdate()
         
         _tempMinValue->SetText(buffer);
 
-        if (isMaxLimitEnabled)
+        if (water.maxTempEnabled)
         {
-            std::sprintf(buffer, "%.1f °C", maxTemp);
+            std::sprintf(buffer, "%.1f °C", water.maxTemp);
         }
         else
         {
@@ -168,7 +178,7 @@ void UserInterface::OnUpdate()
         _tempMaxValue->SetText(buffer);
 
         // Panel state
-        if (Core::GuardianProxy::GetInstance()->IsTemperatureOutOfLimits())
+        if (water.temperatureOutOfLimits || water.temperatureWarning)
         {
             // Alert state
             _tempPanel->SetState1();
@@ -184,20 +194,16 @@ void UserInterface::OnUpdate()
     {
         char buffer [50];
 
-        const int tdsReading = Core::GuardianProxy::GetInstance()->GetTdsReading();
-        std::sprintf(buffer, "%d", tdsReading);
+        const auto& water = snapshot.water;
+
+        std::sprintf(buffer, "%d", water.tds);
 
         _tdsValue->SetText(buffer);
 
         // TDS limits
-        int minTds = 0, maxTds = 0;
-        bool isMinLimitEnabled = false, isMaxLimitEnabled = false;
-
-        Core::GuardianProxy::GetInstance()->GetTdsLimits(minTds, isMinLimitEnabled, maxTds, isMaxLimitEnabled);
-
-        if (isMinLimitEnabled)
+        if (water.minTdsEnabled)
         {
-            std::sprintf(buffer, "%d ppm", minTds);
+            std::sprintf(buffer, "%d ppm", water.minTds);
         }
         else
         {
@@ -206,9 +212,9 @@ void UserInterface::OnUpdate()
         
         _tdsMinValue->SetText(buffer);
 
-        if (isMaxLimitEnabled)
+        if (water.maxTdsEnabled)
         {
-            std::sprintf(buffer, "%d ppm", maxTds);
+            std::sprintf(buffer, "%d ppm", water.maxTds);
         }
         else
         {
@@ -218,7 +224,7 @@ void UserInterface::OnUpdate()
         _tdsMaxValue->SetText(buffer);
 
         // Panel state
-        if (Core::GuardianProxy::GetInstance()->IsTdsOutOfLimits())
+        if (water.tdsOutOfLimits || water.tdsWarning)
         {
             // Alert state
             _tdsPanel->SetState1();
@@ -232,7 +238,7 @@ void UserInterface::OnUpdate()
 
     // Feeder
     {
-        const auto& feederStatus = Core::GuardianProxy::GetInstance()->GetFeederStatus();
+        const auto& feederStatus = snapshot.feeder.status;
 
         CORE_INFO("Feeder Status - Next Feed Time: %s, Next Feed Doses: %d, Remaining Doses Today: %d, Total Per Day: %d",
                   feederStatus.nextFeedTime.ToString().c_str(),
@@ -244,7 +250,11 @@ void UserInterface::OnUpdate()
         // Next feeding time
         char buffer [50];
 
-        if (feederStatus.remainingDosesToday > 0)
+        if (_isFeeding)
+        {
+            std::sprintf(buffer, "Feeding...");
+        }
+        else if (feederStatus.remainingDosesToday > 0)
         {
             std::sprintf(buffer, "%s [%d]", feederStatus.nextFeedTime.ToString().c_str(), feederStatus.nextFeedDoses);
         }
@@ -259,6 +269,15 @@ void UserInterface::OnUpdate()
 
         _nextFeedingTime->SetText(buffer);
 
+        if (_isFeeding)
+        {
+            _feederPanel->SetState1();
+        }
+        else
+        {
+            _feederPanel->ClearState1();
+        }
+
         // Doses per day
         std::sprintf(buffer, "%d", feederStatus.totalPerDay);
         _dosesPerDay->SetText(buffer);
@@ -289,13 +308,13 @@ void UserInterface::OnBatteryModeExit()
 }
 
 //----private------------------------------------------------------------------
-void UserInterface::UpdatePowerIndicator()
+void UserInterface::UpdatePowerIndicator(const Core::SystemSnapshot::Power& power)
 {
     static Services::PowerController::BatteryLevel lastBatteryLevel = Services::PowerController::BatteryLevel::_size;
     static Services::PowerController::Mode lastPowerMode = Services::PowerController::Mode::_size;
 
-    const auto powerMode = Core::GuardianProxy::GetInstance()->GetCurrentMode();
-    const auto batteryLevel = Core::GuardianProxy::GetInstance()->GetBatteryLevel();
+    const auto powerMode = power.mode;
+    const auto batteryLevel = power.batteryLevel;
 
     if (lastBatteryLevel != batteryLevel || lastPowerMode != powerMode)
     {
@@ -323,21 +342,18 @@ void UserInterface::UpdatePowerIndicator()
     }
 }
 
-//-----------------------------------------------------------------------------
-void UserInterface::UpdateFeedingStatusIndicator(bool isFeeding)
+//----private------------------------------------------------------------------
+void UserInterface::OnEvent(const Events::FeedingStarted& event)
 {
-    CORE_INFO("Updating feeding status indicator to %s", isFeeding ? "ON" : "OFF");
+    CORE_INFO("Feeding started (%d doses), showing indicator", event.dose);
+    _isFeeding = true;
+}
 
-    if (isFeeding)
-    {
-        _nextFeedingTime->SetText("Feeding...");
-        _feederPanel->SetState1();
-    }
-    else
-    {
-        _nextFeedingTime->SetText("---");
-        _feederPanel->ClearState1();
-    }
+//----private------------------------------------------------------------------
+void UserInterface::OnEvent(const Events::FeedingFinished& event)
+{
+    CORE_INFO("Feeding finished (%d doses), hiding indicator", event.dose);
+    _isFeeding = false;
 }
 
 } // namespace Managers
@@ -12,23 +12,27 @@
 #include "include/config.h"
 #include "src/drivers/graphic_display.h"
 #include "src/core/base/manager.h"
+#include "src/core/event_subscriber.h"
+#include "src/core/events.h"
+#include "src/core/system_snapshot.h"
 
 namespace Managers {
 
 class UserInterface : public Base::Singleton<UserInterface>
                     , public Base::Manager
+                    , public Core::EventSubscriber<UserInterface,
+                                                   Events::ConfigChanged,
+                                                   Events::ReadingSampled,
+                                                   Events::ReadingAnomaly,
+                                                   Events::ConnectivityChanged,
+                                                   Events::FeedingStarted,
+                                                   Events::FeedingFinished,
+                                                   Events::PowerModeChanged>
 {
-    public:
-
-        /*!
-        * @brief Update feeding status indicator
-        * @param isFeeding True if feeding is in progress, false otherwise.
-        */
-        void UpdateFeedingStatusIndicator(bool isFeeding);
-
     protected:
 
         friend class Base::Singleton<UserInterface>;
+        friend Subscriber;
 
         /*!
         * @brief Get the module name.
@@ -36,6 +40,12 @@ class UserInterface : public Base::Singleton<UserInterface>
         */
         const char* GetModuleName() const override { return "UserInterface"; }
 
+        /*!
+        * @brief Get the scheduling requirements.
+        * @return Scheduler::Schedule Periodic refresh, plus early refresh on every event.
+        */
+        Scheduler::Schedule GetSchedule() const override;
+
         /*!
          * @brief Initializes the Module.
          *        This method should be called once at the start of the application.
@@ -61,10 +71,23 @@ class UserInterface : public Base::Singleton<UserInterface>
 
     private:
 
+        /*!
+         * @brief Feeding indicator, shown until the matching FeedingFinished.
+         */
+        void OnEvent(const Events::FeedingStarted& event);
+        void OnEvent(const Events::FeedingFinished& event);
+
+        /*!
+         * @brief Other events only wake the UI: the screen is redrawn from the snapshot.
+         */
+        template <typename Event>
+        void OnEvent(const Event& /*event*/) {}
+
         /*!
          * @brief Update power status indicator
+         * @param power Power section of the system snapshot.
          */
-        void UpdatePowerIndicator();
+        void UpdatePowerIndicator(const Core::SystemSnapshot::Power& power);
 
 
         UserInterface() {}
@@ -81,6 +104,7 @@ class UserInterface : public Base::Singleton<UserInterface>
         //---------------------------------------------
 
         bool _firstUpdateDone = false;
+        bool _isFeeding = false;
 
         Drivers::GraphicDisplay* _display = nullptr;
 
@@ -7,20 +7,56 @@
 
 #include "src/managers/water_monitor.h"
 
+#include "esp_timer.h"
 #include "framework/common_defs.h"
+#include "include/config.h"
+#include "src/core/boot_orchestrator.h"
+#include "src/core/event_bus.h"
 #include "src/core/guardian_proxy.h"
 #include "src/drivers/tds_sensor.h"
 #include "src/drivers/temperature_sensor.h"
+#include "src/services/history_log.h"
+#include "src/services/power_controller.h"
+#include "src/services/reading_history.h"
+#include <cmath>
 
 namespace Managers {
 
+//----protected----------------------------------------------------------------
+Scheduler::Schedule WaterMonitor::GetSchedule() const
+{
+    return Scheduler::Schedule{ Config::WATER_MONITOR_PERIOD_MS, Config::WATER_MONITOR_DEADLINE_MS, Scheduler::WAKE_TIMER | Scheduler::WAKE_NOTIFICATION };
+}
+
 //----private------------------------------------------------------------------
 bool WaterMonitor::OnInit()
 {
     _temperatureSensor = Drivers::TemperatureSensor::GetInstance();
     _tdsSensor = Drivers::TdsSensor::GetInstance();
 
-    return (_temperatureSensor->Init() && _tdsSensor->Init());
+    _temperatureSensor->SetResolution(TEMP_RESOLUTION_USB);
+
+    const bool success = (_temperatureSensor->Init() && _tdsSensor->Init());
+
+    PublishState();
+
+    // The sensor started its first conversion in Init(): collect it as soon as it is done,
+    // not one period later (readings are only 0 until then)
+    const esp_timer_create_args_t timerArgs =
+    {
+        .callback = [](void*) { WaterMonitor::GetInstance()->RequestUpdate(Scheduler::WAKE_NOTIFICATION); },
+        .arg = nullptr,
+        .dispatch_method = ESP_TIMER_TASK,
+        .name = "first_reading",
+        .skip_unhandled_events = false,
+    };
+
+    if (esp_timer_create(&timerArgs, &_firstReadingTimer) == ESP_OK)
+    {
+        esp_timer_start_once(_firstReadingTimer, Drivers::TemperatureSensor::GetConversionTimeMs(TEMP_RESOLUTION_USB) * 1000ULL);
+    }
+
+    return success;
 }
 
 //----private------------------------------------------------------------------
@@ -30,6 +66,44 @@ void WaterMonitor::OnUpdate()
 
     _tdsSensor->SetTemperature(_temperatureSensor->GetLastReading());
     _tdsSensor->Update();
+
+    // The trends and the history take one sample per conversion: extra wakes (the first-reading
+    // timer, notifications) and updates that found the conversion still running add none
+    const uint32_t conversion = _temperatureSensor->GetConversionCount();
+    const bool newConversion = _temperatureSensor->HasReading() && (conversion != _sampledConversion);
+    _sampledConversion = conversion;
+
+    if (newConversion)
+    {
+        AnalyzeReadings();
+    }
+
+    PublishState();
+
+    if (newConversion)
+    {
+        Core::BootOrchestrator::GetInstance()->MarkMilestone(Core::BootOrchestrator::Milestone::FIRST_READING);
+
+        const auto values = Services::ReadingHistory::ToValues(GetTemperatureReading(), GetTdsReading(),
+                                                               Services::PowerController::GetInstance()->ReadSupplyVoltage());
+        Services::ReadingHistory::GetInstance()->Record(values);
+        Services::HistoryLog::GetInstance()->RecordSample(values);
+    }
+
+    // Show the new readings (and any limit alert) without waiting for the UI period
+    Core::EventBus::Publish(Events::ReadingSampled{ GetTemperatureReading(), GetTdsReading() });
+}
+
+//----protected----------------------------------------------------------------
+void WaterMonitor::OnBatteryModeEnter()
+{
+    _temperatureSensor->SetResolution(TEMP_RESOLUTION_BATTERY);
+}
+
+//----protected----------------------------------------------------------------
+void WaterMonitor::OnBatteryModeExit()
+{
+    _temperatureSensor->SetResolution(TEMP_RESOLUTION_USB);
 }
 
 //-----------------------------------------------------------------------------
@@ -39,9 +113,15 @@ int WaterMonitor::GetTdsReading() const
 }
 
 //-----------------------------------------------------------------------------
-float WaterMonitor::GetTemperatureReading() const
+float WaterMonitor::GetTemperatureReading(size_t channel) const
 {
-    return (_temperatureSensor->GetLastReading());
+    return (_temperatureSensor->GetLastReading(channel));
+}
+
+//-----------------------------------------------------------------------------
+size_t WaterMonitor::GetTemperatureChannelCount() const
+{
+    return (_temperatureSensor->GetChannelCount());
 }
 
 //-----------------------------------------------------------------------------
@@ -81,6 +161,7 @@ Result WaterMonitor::SetTemperatureLimits(const float minTemp, const bool isMinL
 
     if (success)
     {
+        PublishState();
         CORE_INFO("WaterMonitor: All temperature limit parameters saved successfully.");
         return Result::Success("Temperature limits updated successfully.");
     }
@@ -159,6 +240,7 @@ Result WaterMonitor::SetTdsLimits(const int minTds, const bool isMinLimitEnabled
 
     if (success)
     {
+        PublishState();
         CORE_INFO("WaterMonitor: All TDS limit parameters saved successfully.");
         return Result::Success("TDS limits updated successfully.");
     }
@@ -200,4 +282,167 @@ bool WaterMonitor::IsTdsOutOfLimits() const
     return false;
 }
 
+//-----------------------------------------------------------------------------
+Result WaterMonitor::SetTrendSensitivity(const bool enabled, const float tempRatePerHour, const int tdsRatePerHour, const float spikeZScore)
+{
+    CORE_INFO("WaterMonitor: Request to set trend sensitivity -> En:%d, Temp: %.2f/h, TDS: %d/h, Z: %.1f",
+              enabled, tempRatePerHour, tdsRatePerHour, spikeZScore);
+
+    if (tempRatePerHour < 0.0f || tempRatePerHour > MAX_TEMP_RATE_LIMIT)
+    {
+        CORE_ERROR("WaterMonitor Validation Error: Temp rate limit (%.2f) out of valid range [0, %.2f].", tempRatePerHour, MAX_TEMP_RATE_LIMIT);
+        return Result::Error("Invalid temperature rate limit.");
+    }
+
+    if (tdsRatePerHour < 0 || tdsRatePerHour > MAX_TDS_RATE_LIMIT)
+    {
+        CORE_ERROR("WaterMonitor Validation Error: TDS rate limit (%d) out of valid range [0, %d].", tdsRatePerHour, MAX_TDS_RATE_LIMIT);
+        return Result::Error("Invalid TDS rate limit.");
+    }
+
+    if (spikeZScore != 0.0f && (spikeZScore < MIN_SPIKE_Z_SCORE || spikeZScore > MAX_SPIKE_Z_SCORE))
+    {
+        CORE_ERROR("WaterMonitor Validation Error: Spike z-score (%.2f) out of valid range [%.2f, %.2f].", spikeZScore, MIN_SPIKE_Z_SCORE, MAX_SPIKE_Z_SCORE);
+        return Result::Error("Invalid spike z-score.");
+    }
+
+    const bool success = Core::GuardianProxy::GetInstance()->SaveTrendSensitivityInStorage(enabled, tempRatePerHour, tdsRatePerHour, spikeZScore);
+
+    if (success)
+    {
+        CORE_INFO("WaterMonitor: Trend sensitivity saved successfully.");
+        return Result::Success("Trend sensitivity updated successfully.");
+    }
+    else
+    {
+        CORE_ERROR("WaterMonitor Storage Error: Failed to save trend sensitivity.");
+        return Result::Error("Internal Error: Could not save settings to permanent memory.");
+    }
+}
+
+//-----------------------------------------------------------------------------
+void WaterMonitor::GetTrendSensitivity(bool& enabled, float& tempRatePerHour, int& tdsRatePerHour, float& spikeZScore) const
+{
+    Core::GuardianProxy::GetInstance()->GetTrendSensitivityFromStorage(enabled, tempRatePerHour, tdsRatePerHour, spikeZScore);
+}
+
+//-----------------------------------------------------------------------------
+void WaterMonitor::PublishState()
+{
+    auto* proxy = Core::GuardianProxy::GetInstance();
+
+    Core::SystemSnapshot::Water water;
+    water.temperature = GetTemperatureReading();
+    water.tds = GetTdsReading();
+
+    water.temperatureChannelCount = GetTemperatureChannelCount();
+    for (size_t i = 0; i < water.temperatureChannelCount; ++i)
+    {
+        water.channelTemperatures[i] = GetTemperatureReading(i);
+    }
+    GetTemperatureLimits(water.minTemp, water.minTempEnabled, water.maxTemp, water.maxTempEnabled);
+    GetTdsLimits(water.minTds, water.minTdsEnabled, water.maxTds, water.maxTdsEnabled);
+    water.temperatureOutOfLimits = IsTemperatureOutOfLimits();
+    water.tdsOutOfLimits = IsTdsOutOfLimits();
+    water.temperatureRatePerHour = _temperatureTrend.ratePerHour;
+    water.tdsRatePerHour = _tdsTrend.ratePerHour;
+    water.temperatureWarning = _temperatureTrend.IsWarning();
+    water.tdsWarning = _tdsTrend.IsWarning();
+
+    proxy->PublishWaterState(water);
+
+    Core::SystemSnapshot::Power power;
+    power.mode = proxy->GetCurrentMode();
+    power.batteryLevel = proxy->GetBatteryLevel();
+
+    proxy->PublishPowerState(power);
+
+    if (power.mode != _lastPowerMode)
+    {
+        _lastPowerMode = power.mode;
+        Core::EventBus::Publish(Events::PowerModeChanged{ power.mode });
+        Services::HistoryLog::GetInstance()->RecordEvent(Services::HistoryLog::EventCode::POWER_MODE_CHANGED, static_cast<int32_t>(power.mode));
+    }
+}
+
+//----private------------------------------------------------------------------
+void WaterMonitor::AnalyzeReadings()
+{
+    bool enabled = false;
+    float tempRateLimit = 0.0f;
+    int tdsRateLimit = 0;
+    float spikeZScore = 0.0f;
+
+    GetTrendSensitivity(enabled, tempRateLimit, tdsRateLimit, spikeZScore);
+
+    using Sensor = Events::ReadingAnomaly::Sensor;
+    Analyze(Sensor::TEMPERATURE, _temperatureTrend, GetTemperatureReading(), tempRateLimit, spikeZScore, enabled);
+    Analyze(Sensor::TDS, _tdsTrend, static_cast<float>(GetTdsReading()), static_cast<float>(tdsRateLimit), spikeZScore, enabled);
+}
+
+//----private------------------------------------------------------------------
+void WaterMonitor::Analyze(Events::ReadingAnomaly::Sensor sensor, TrendChannel& channel, float value, float rateLimit, float spikeZScore, bool enabled)
+{
+    using Kind = Events::ReadingAnomaly::Kind;
+
+    // The windows keep running while the warnings are off, so turning them on is immediate
+    const float zScore = channel.trend.Process(value);
+    const size_t count = channel.trend.GetCount();
+
+    channel.ratePerHour = (count >= Config::TREND_MIN_SAMPLES) ? (channel.trend.GetSlope() * SAMPLES_PER_HOUR) : 0.0f;
+
+    Kind raised = Kind::SPIKE;
+    bool isRaised = false;
+
+    const float rate = std::fabs(channel.ratePerHour);
+    if (!enabled || rateLimit <= 0.0f)
+    {
+        channel.rateWarning = false;
+    }
+    else if (!channel.rateWarning && rate >= rateLimit)
+    {
+        channel.rateWarning = true;
+        raised = (channel.ratePerHour > 0.0f) ? Kind::RISING : Kind::FALLING;
+        isRaised = true;
+    }
+    else if (channel.rateWarning && rate < rateLimit * WARNING_CLEAR_RATIO)
+    {
+        channel.rateWarning = false;
+    }
+
+    // Scored against the readings before this one, once there are enough of them
+    const float score = std::fabs(zScore);
+    if (!enabled || spikeZScore <= 0.0f || count <= Config::SPIKE_MIN_SAMPLES)
+    {
+        channel.spike = false;
+    }
+    else if (!channel.spike && score >= spikeZScore)
+    {
+        channel.spike = true;
+        if (!isRaised)
+        {
+            raised = Kind::SPIKE;
+            isRaised = true;
+        }
+    }
+    else if (channel.spike && score < spikeZScore * WARNING_CLEAR_RATIO)
+    {
+        channel.spike = false;
+    }
+
+    if (!isRaised)
+    {
+        return;
+    }
+
+    CORE_WARNING("%s early warning (%s): %.2f, %.2f/h, z %.1f",
+                 (sensor == Events::ReadingAnomaly::Sensor::TEMPERATURE) ? "Temperature" : "TDS",
+                 (raised == Kind::RISING) ? "rising" : ((raised == Kind::FALLING) ? "falling" : "jump"),
+                 value, channel.ratePerHour, zScore);
+
+    Core::EventBus::Publish(Events::ReadingAnomaly{ sensor, raised, value, channel.ratePerHour, zScore });
+    Services::HistoryLog::GetInstance()->RecordEvent(Services::HistoryLog::EventCode::READING_ANOMALY,
+                                                     (static_cast<int32_t>(sensor) << 8) | static_cast<int32_t>(raised));
+}
+
 } // namespace Managers
@@ -8,9 +8,14 @@
 #ifndef WATER_MONITOR_H
 #define WATER_MONITOR_H
 
+#include "esp_timer.h"
+#include "framework/dsp/rolling_trend.h"
+#include "include/config.h"
 #include "src/core/base/manager.h"
+#include "src/core/events.h"
 #include "src/drivers/tds_sensor.h"
 #include "src/drivers/temperature_sensor.h"
+#include "src/services/power_controller.h"
 
 struct Result;
 
@@ -29,9 +34,15 @@ class WaterMonitor : public Base::Singleton<WaterMonitor>
 
         /*!
         * @brief Gets the last Temperature reading.
-        * @return int Last Temperature reading.
+        * @param channel Probe index; channel 0 is the one the limits apply to.
+        * @return float Last Temperature reading.
         */
-        float GetTemperatureReading() const;
+        float GetTemperatureReading(size_t channel = 0) const;
+
+        /*!
+        * @brief Gets the number of temperature probes found on the bus.
+        */
+        size_t GetTemperatureChannelCount() const;
 
         /*!
         * @brief Sets the temperature limits.
@@ -79,6 +90,27 @@ class WaterMonitor : public Base::Singleton<WaterMonitor>
         */
         bool IsTdsOutOfLimits() const;
 
+        /*!
+        * @brief Sets the sensitivity of the early warnings (see AnalyzeReadings()).
+        * @param enabled Flag indicating if the early warnings are raised at all.
+        * @param tempRatePerHour Temperature change rate that raises a warning (degC/h, 0 = off).
+        * @param tdsRatePerHour TDS change rate that raises a warning (ppm/h, 0 = off).
+        * @param spikeZScore Distance from the recent readings, in standard deviations, that raises a warning (0 = off).
+        * @return Result Result indicating success or failure.
+        */
+        Result SetTrendSensitivity(const bool enabled, const float tempRatePerHour, const int tdsRatePerHour, const float spikeZScore);
+
+        /*!
+        * @brief Gets the sensitivity of the early warnings.
+        */
+        void GetTrendSensitivity(bool& enabled, float& tempRatePerHour, int& tdsRatePerHour, float& spikeZScore) const;
+
+        /*!
+         * @brief Publish readings, limits, alarms and the battery state to the system snapshot.
+         *        The battery is sampled here since this is the periodic analog measurement loop.
+         */
+        void PublishState();
+
     protected:
 
         friend class Base::Singleton<WaterMonitor>;
@@ -89,6 +121,12 @@ class WaterMonitor : public Base::Singleton<WaterMonitor>
         */
         const char* GetModuleName() const override { return "WaterMonitor"; }
 
+        /*!
+        * @brief Get the scheduling requirements.
+        * @return Scheduler::Schedule Periodic sampling of the sensors.
+        */
+        Scheduler::Schedule GetSchedule() const override;
+
         /*!
          * @brief Initializes the Module.
          *        This method should be called once at the start of the application.
@@ -102,6 +140,16 @@ class WaterMonitor : public Base::Singleton<WaterMonitor>
          */
         void OnUpdate() override;
 
+        /*!
+         * @brief Lower the temperature resolution: shorter conversions, less sensor current.
+         */
+        void OnBatteryModeEnter() override;
+
+        /*!
+         * @brief Restore the full temperature resolution.
+         */
+        void OnBatteryModeExit() override;
+
     private:
 
         WaterMonitor() {}
@@ -109,6 +157,29 @@ class WaterMonitor : public Base::Singleton<WaterMonitor>
         WaterMonitor(const WaterMonitor&) = delete;
         WaterMonitor& operator=(const WaterMonitor&) = delete;
 
+        //! Early-warning state of one reading
+        struct TrendChannel
+        {
+            explicit TrendChannel(float minStdDev) : trend(minStdDev) {}
+
+            Dsp::RollingTrend<float, Config::TREND_WINDOW_SAMPLES> trend;
+            float ratePerHour = 0.0f;
+            bool rateWarning = false;
+            bool spike = false;
+
+            bool IsWarning() const { return rateWarning || spike; }
+        };
+
+        /*!
+         * @brief Feeds the new readings to the trend windows and raises a ReadingAnomaly
+         *        when one changes faster than its rate limit (fitted over the window) or
+         *        jumps away from the recent readings, before any limit is crossed.
+         *        O(1) per reading.
+         */
+        void AnalyzeReadings();
+
+        void Analyze(Events::ReadingAnomaly::Sensor sensor, TrendChannel& channel, float value, float rateLimit, float spikeZScore, bool enabled);
+
         //---------------------------------------------
 
         static constexpr float MIN_TEMP_VALID_VALUE = 10.0f;
@@ -117,10 +188,34 @@ class WaterMonitor : public Base::Singleton<WaterMonitor>
         static constexpr int MIN_TDS_VALID_VALUE = 0;
         static constexpr int MAX_TDS_VALID_VALUE = 2000;
 
+        static constexpr float MAX_TEMP_RATE_LIMIT = 10.0f;         //!< degC/h
+        static constexpr int MAX_TDS_RATE_LIMIT = 1000;             //!< ppm/h
+        static constexpr float MIN_SPIKE_Z_SCORE = 2.0f;
+        static constexpr float MAX_SPIKE_Z_SCORE = 20.0f;
+
+        //! Z-score floors: a steady reading only moves by its resolution (DS18B20: 0.0625 degC)
+        static constexpr float TEMP_MIN_STD_DEV = 0.05f;
+        static constexpr float TDS_MIN_STD_DEV = 5.0f;
+
+        //! A warning clears once its measure falls below this fraction of the limit
+        static constexpr float WARNING_CLEAR_RATIO = 0.5f;
+
+        //! Trend samples are conversions, one per period (see OnUpdate())
+        static constexpr float SAMPLES_PER_HOUR = 3600000.0f / Config::WATER_MONITOR_PERIOD_MS;
+
+        static constexpr auto TEMP_RESOLUTION_USB = Drivers::TemperatureSensor::Resolution::BITS_12;
+        static constexpr auto TEMP_RESOLUTION_BATTERY = Drivers::TemperatureSensor::Resolution::BITS_10;
+
         //---------------------------------------------
 
         Drivers::TemperatureSensor* _temperatureSensor = nullptr;
         Drivers::TdsSensor* _tdsSensor = nullptr;
+        Services::PowerController::Mode _lastPowerMode = Services::PowerController::Mode::_size;
+        esp_timer_handle_t _firstReadingTimer = nullptr;
+        uint32_t _sampledConversion = 0;                            //!< Temperature conversion the trends last took
+
+        TrendChannel _temperatureTrend{ TEMP_MIN_STD_DEV };
+        TrendChannel _tdsTrend{ TDS_MIN_STD_DEV };
 };
 
 } // namespace Managers
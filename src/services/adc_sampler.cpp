@@ -0,0 +1,249 @@
+/*!****************************************************************************
+ * @file    adc_sampler.cpp
+ * @brief   Implementation of the AdcSampler service.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ *******************************************************************************/
+
+#include "src/services/adc_sampler.h"
+
+#include "esp_adc/adc_cali_scheme.h"
+#include <algorithm>
+
+namespace Services {
+
+//-----------------------------------------------------------------------------
+AdcSampler::ChannelId AdcSampler::AddChannel(PinName pin, adc_atten_t atten)
+{
+    adc_channel_t adcChannel = ADC_CHANNEL_0;
+    if (_handle == nullptr || !AnalogIn::PinToAdcChannel(pin, adcChannel))
+    {
+        CORE_ERROR("Cannot sample pin %d", static_cast<int>(pin));
+        return INVALID_CHANNEL;
+    }
+
+    xSemaphoreTake(_mutex, portMAX_DELAY);
+
+    ChannelId id = _channelOfAdc[adcChannel];
+    if (id == INVALID_CHANNEL)
+    {
+        const adc_cali_line_fitting_config_t caliConfig =
+        {
+            .unit_id = ADC_UNIT_1,
+            .atten = atten,
+            .bitwidth = ADC_BITWIDTH_DEFAULT,
+            .default_vref = DEFAULT_VREF_MV
+        };
+
+        adc_cali_handle_t cali = nullptr;
+        if (_channelCount < MAX_CHANNELS && adc_cali_create_scheme_line_fitting(&caliConfig, &cali) == ESP_OK)
+        {
+            id = static_cast<ChannelId>(_channelCount++);
+
+            Channel& channel = _channels[id];
+            channel.adcChannel = adcChannel;
+            channel.atten = atten;
+            channel.cali = cali;
+            _channelOfAdc[adcChannel] = id;
+
+            if (!Restart())
+            {
+                CORE_ERROR("Failed to restart ADC sampling");
+            }
+        }
+        else
+        {
+            CORE_ERROR("No room to sample ADC channel %d", adcChannel);
+        }
+    }
+
+    xSemaphoreGive(_mutex);
+    return id;
+}
+
+//-----------------------------------------------------------------------------
+float AdcSampler::ReadVoltage(ChannelId channel) const
+{
+    if (channel >= MAX_CHANNELS)
+    {
+        return 0.0f;
+    }
+
+    return _channels[channel].volts.load(std::memory_order_relaxed);
+}
+
+//-----------------------------------------------------------------------------
+bool AdcSampler::HasReading(ChannelId channel) const
+{
+    return (channel < MAX_CHANNELS) && _channels[channel].valid.load(std::memory_order_acquire);
+}
+
+//----private------------------------------------------------------------------
+bool AdcSampler::OnInit()
+{
+    std::fill(std::begin(_channelOfAdc), std::end(_channelOfAdc), INVALID_CHANNEL);
+
+    _mutex = xSemaphoreCreateMutex();
+    if (_mutex == nullptr)
+    {
+        CORE_ERROR("Failed to create ADC sampler mutex");
+        return false;
+    }
+
+    // Old frames are worthless once the task fell behind: drop them, keep the latest
+    adc_continuous_handle_cfg_t handleConfig =
+    {
+        .max_store_buf_size = Config::ADC_STORE_BYTES,
+        .conv_frame_size = Config::ADC_FRAME_BYTES,
+    };
+    handleConfig.flags.flush_pool = 1;
+
+    const adc_continuous_evt_cbs_t callbacks =
+    {
+        .on_conv_done = OnConversionDone,
+        .on_pool_ovf = OnPoolOverflow
+    };
+
+    adc_continuous_handle_t handle = nullptr;
+    if (adc_continuous_new_handle(&handleConfig, &handle) != ESP_OK
+     || adc_continuous_register_event_callbacks(handle, &callbacks, this) != ESP_OK)
+    {
+        CORE_ERROR("Failed to set up the continuous ADC");
+        return false;
+    }
+
+    if (xTaskCreate(TaskEntry, "AdcSampler", Config::ADC_SAMPLER_STACK_SIZE, this,
+                    Config::ADC_SAMPLER_PRIORITY, &_task) != pdPASS)
+    {
+        CORE_ERROR("Failed to create ADC sampler task");
+        adc_continuous_deinit(handle);
+        return false;
+    }
+
+    _handle = handle;
+    return true;
+}
+
+//----private------------------------------------------------------------------
+void AdcSampler::TaskEntry(void* arg)
+{
+    static_cast<AdcSampler*>(arg)->Run();
+}
+
+//----private------------------------------------------------------------------
+void AdcSampler::Run()
+{
+    while (true)
+    {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        xSemaphoreTake(_mutex, portMAX_DELAY);
+
+        uint32_t length = 0;
+        while (adc_continuous_read(_handle, _frame, sizeof(_frame), &length, 0) == ESP_OK)
+        {
+            ProcessFrame(_frame, length);
+        }
+
+        xSemaphoreGive(_mutex);
+    }
+}
+
+//----private------------------------------------------------------------------
+bool AdcSampler::Restart()
+{
+    if (_running)
+    {
+        adc_continuous_stop(_handle);
+        _running = false;
+    }
+
+    adc_digi_pattern_config_t pattern[MAX_CHANNELS] = {};
+    for (size_t i = 0; i < _channelCount; ++i)
+    {
+        pattern[i].atten = _channels[i].atten;
+        pattern[i].channel = _channels[i].adcChannel;
+        pattern[i].unit = ADC_UNIT_1;
+        pattern[i].bit_width = ADC_BITWIDTH_12;
+    }
+
+    adc_continuous_config_t config =
+    {
+        .pattern_num = static_cast<uint32_t>(_channelCount),
+        .adc_pattern = pattern,
+        .sample_freq_hz = Config::ADC_SAMPLE_RATE_HZ,
+        .conv_mode = ADC_CONV_SINGLE_UNIT_1,
+        .format = ADC_DIGI_OUTPUT_FORMAT_TYPE1
+    };
+
+    if (adc_continuous_config(_handle, &config) != ESP_OK || adc_continuous_start(_handle) != ESP_OK)
+    {
+        return false;
+    }
+
+    _running = true;
+    return true;
+}
+
+//----private------------------------------------------------------------------
+void AdcSampler::ProcessFrame(const uint8_t* data, uint32_t length)
+{
+    // Every conversion carries its channel, so frames of a previous pattern are still sorted right
+    for (uint32_t offset = 0; offset + sizeof(adc_digi_output_data_t) <= length; offset += sizeof(adc_digi_output_data_t))
+    {
+        const auto* result = reinterpret_cast<const adc_digi_output_data_t*>(&data[offset]);
+
+        const ChannelId id = _channelOfAdc[result->type1.channel];
+        if (id == INVALID_CHANNEL)
+        {
+            continue;
+        }
+
+        Channel& channel = _channels[id];
+        channel.sum += result->type1.data;
+
+        if (++channel.count >= Config::ADC_OVERSAMPLING)
+        {
+            PublishAverage(channel);
+        }
+    }
+}
+
+//----private------------------------------------------------------------------
+void AdcSampler::PublishAverage(Channel& channel)
+{
+    // Interpolate the calibration between the two codes around the average,
+    // so the extra resolution of the oversampling is kept
+    const int whole = static_cast<int>(channel.sum / channel.count);
+    const float fraction = static_cast<float>(channel.sum % channel.count) / channel.count;
+
+    int lowMv = 0;
+    int highMv = 0;
+    if (adc_cali_raw_to_voltage(channel.cali, whole, &lowMv) == ESP_OK
+     && adc_cali_raw_to_voltage(channel.cali, whole + 1, &highMv) == ESP_OK)
+    {
+        channel.volts.store((lowMv + fraction * (highMv - lowMv)) / 1000.0f, std::memory_order_relaxed);
+        channel.valid.store(true, std::memory_order_release);
+    }
+
+    channel.sum = 0;
+    channel.count = 0;
+}
+
+//----private------------------------------------------------------------------
+bool AdcSampler::OnConversionDone(adc_continuous_handle_t /*handle*/, const adc_continuous_evt_data_t* /*event*/, void* context)
+{
+    // ISR: the frame is already in the ring buffer, let the task drain it
+    BaseType_t taskWoken = pdFALSE;
+    vTaskNotifyGiveFromISR(static_cast<AdcSampler*>(context)->_task, &taskWoken);
+    return (taskWoken == pdTRUE);
+}
+
+//----private------------------------------------------------------------------
+bool AdcSampler::OnPoolOverflow(adc_continuous_handle_t /*handle*/, const adc_continuous_evt_data_t* /*event*/, void* context)
+{
+    static_cast<AdcSampler*>(context)->_overflowCount.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+} // namespace Services
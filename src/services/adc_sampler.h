@@ -0,0 +1,142 @@
+/*!****************************************************************************
+ * @file    adc_sampler.h
+ * @brief   Background sampling of the ADC1 channels with the continuous (DMA)
+ *          driver. The registered channels are converted round-robin at a
+ *          fixed rate into the driver ring buffer; a task drains every frame
+ *          and averages ADC_OVERSAMPLING conversions per channel into one
+ *          decimated value. Readers get the latest value in O(1) without
+ *          touching the hardware.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#pragma once
+
+#include "esp_adc/adc_cali.h"
+#include "esp_adc/adc_continuous.h"
+#include "framework/common_defs.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include "include/config.h"
+#include "src/core/base/service.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace Services {
+
+class AdcSampler : public Base::Singleton<AdcSampler>
+                 , public Base::Service
+{
+    public:
+
+        using ChannelId = uint8_t;
+
+        static constexpr size_t MAX_CHANNELS = 8;
+        static constexpr ChannelId INVALID_CHANNEL = 0xFF;
+
+        /**
+         * @brief Adds a pin to the conversion pattern and restarts the sampling with it.
+         *        Adding a pin twice returns the channel it already has.
+         * @param pin   ADC1-capable pin.
+         * @param atten Attenuation of the channel.
+         * @return ChannelId Channel to read, INVALID_CHANNEL if the pin cannot be sampled.
+         */
+        ChannelId AddChannel(PinName pin, adc_atten_t atten = ADC_ATTEN_DB_12);
+
+        /**
+         * @brief Latest decimated voltage of a channel. Lock-free, any task.
+         * @return float Volts, 0 until the first value is available.
+         */
+        float ReadVoltage(ChannelId channel) const;
+
+        /**
+         * @brief Whether a decimated value is available for the channel.
+         */
+        bool HasReading(ChannelId channel) const;
+
+        /**
+         * @brief Frames dropped because the ring buffer was full (the task fell behind).
+         */
+        uint32_t GetOverflowCount() const { return _overflowCount.load(std::memory_order_relaxed); }
+
+    protected:
+
+        friend class Base::Singleton<AdcSampler>;
+
+        /*!
+        * @brief Get the module name.
+        * @return const char* Module name.
+        */
+        const char* GetModuleName() const override { return "AdcSampler"; }
+
+        /*!
+         * @brief Creates the continuous driver and the sampling task.
+         *        Conversions start with the first channel.
+         * @return bool True if initialization successful, false otherwise.
+         */
+        bool OnInit() override;
+
+    private:
+
+        struct Channel
+        {
+            adc_channel_t adcChannel = ADC_CHANNEL_0;
+            adc_atten_t atten = ADC_ATTEN_DB_12;
+            adc_cali_handle_t cali = nullptr;
+            uint32_t sum = 0;                           //!< Task only
+            uint32_t count = 0;                         //!< Task only
+            std::atomic<float> volts{0.0f};
+            std::atomic<bool> valid{false};
+        };
+
+        AdcSampler() = default;
+        ~AdcSampler() = default;
+        AdcSampler(const AdcSampler&) = delete;
+        AdcSampler& operator=(const AdcSampler&) = delete;
+
+        static void TaskEntry(void* arg);
+
+        /**
+         * @brief Drains the ring buffer every time the driver completes a frame.
+         */
+        void Run();
+
+        /**
+         * @brief Applies the current channel list as conversion pattern. _mutex held.
+         */
+        bool Restart();
+
+        /**
+         * @brief Accumulates the conversions of a frame into their channels. _mutex held.
+         */
+        void ProcessFrame(const uint8_t* data, uint32_t length);
+
+        /**
+         * @brief Publishes the average of the accumulated conversions of a channel.
+         */
+        static void PublishAverage(Channel& channel);
+
+        static bool OnConversionDone(adc_continuous_handle_t handle, const adc_continuous_evt_data_t* event, void* context);
+        static bool OnPoolOverflow(adc_continuous_handle_t handle, const adc_continuous_evt_data_t* event, void* context);
+
+        // ---------------------------------------------
+
+        static constexpr size_t ADC_CHANNEL_SLOTS = 16;         //!< 4-bit channel field of a conversion
+        static constexpr uint32_t DEFAULT_VREF_MV = 1100;
+
+        adc_continuous_handle_t _handle = nullptr;
+        TaskHandle_t _task = nullptr;
+        SemaphoreHandle_t _mutex = nullptr;                     //!< Pattern changes vs frame processing
+        bool _running = false;
+
+        Channel _channels[MAX_CHANNELS];
+        size_t _channelCount = 0;
+        ChannelId _channelOfAdc[ADC_CHANNEL_SLOTS];             //!< ADC channel -> ChannelId
+
+        uint8_t _frame[Config::ADC_FRAME_BYTES];
+        std::atomic<uint32_t> _overflowCount{0};
+};
+
+} // namespace Services
@@ -0,0 +1,1000 @@
+/*!****************************************************************************
+ * @file    history_log.cpp
+ * @brief   Implementation of the HistoryLog service.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ *******************************************************************************/
+
+#include "src/services/history_log.h"
+
+#include "esp_rom_crc.h"
+#include <algorithm>
+#include <cstring>
+#include <ctime>
+#include <limits>
+
+namespace Services {
+
+namespace {
+
+static constexpr uint32_t SEGMENT_MAGIC = 0x474F4C48;      // "HLOG"
+static constexpr uint8_t FORMAT_VERSION = 1;
+static constexpr uint16_t PAGE_MAGIC = 0xA55A;
+static constexpr size_t INDEX_OFFSET = 32;                 // In page 0, after the segment header
+
+// On-flash layouts (little endian)
+struct __attribute__((packed)) SegmentHeader
+{
+    uint32_t magic;
+    uint8_t version;
+    uint8_t kind;
+    uint16_t reserved;
+    uint32_t sequence;
+    uint32_t eraseCount;
+    uint32_t crc;               //!< Of the fields above
+};
+
+struct __attribute__((packed)) IndexEntry
+{
+    uint32_t firstTimestamp;
+    uint32_t lastTimestamp;
+};
+
+struct __attribute__((packed)) PageHeader
+{
+    uint16_t magic;
+    uint8_t count;
+    uint8_t used;               //!< Payload bytes
+    uint32_t firstTimestamp;
+    uint32_t lastTimestamp;
+    uint32_t crc;               //!< Of the fields above and the payload
+};
+
+struct __attribute__((packed)) RecordHeader
+{
+    uint8_t type;
+    uint8_t length;             //!< Payload bytes
+    uint16_t offset;            //!< Seconds after the first record of the page
+};
+
+static constexpr size_t SAMPLE_PAYLOAD = 2 * HistoryLog::SERIES_COUNT;
+static constexpr size_t HOURLY_PAYLOAD = 2 + 6 * HistoryLog::SERIES_COUNT;
+static constexpr size_t EVENT_PAYLOAD = 2 + 4;
+
+//-----------------------------------------------------------------------------
+uint32_t HeaderCrc(const SegmentHeader& header)
+{
+    return esp_rom_crc32_le(0, reinterpret_cast<const uint8_t*>(&header), offsetof(SegmentHeader, crc));
+}
+
+//-----------------------------------------------------------------------------
+int16_t Clamp16(int32_t value)
+{
+    return static_cast<int16_t>(std::clamp<int32_t>(value, std::numeric_limits<int16_t>::min(), std::numeric_limits<int16_t>::max()));
+}
+
+} // namespace
+
+//-----------------------------------------------------------------------------
+void HistoryLog::RecordSample(const ReadingHistory::Values& values)
+{
+    const uint32_t now = static_cast<uint32_t>(time(nullptr));
+    if (_bufferMutex == nullptr || now < Config::HISTORY_MIN_VALID_TIMESTAMP)
+    {
+        return;
+    }
+
+    xSemaphoreTake(_bufferMutex, portMAX_DELAY);
+    const uint32_t slot = now / Config::HISTORY_LOG_SAMPLE_PERIOD_S;
+    const bool due = (slot != _lastSampleSlot);
+    _lastSampleSlot = slot;
+    xSemaphoreGive(_bufferMutex);
+
+    if (!due)
+    {
+        return;
+    }
+
+    uint8_t payload[SAMPLE_PAYLOAD];
+    for (size_t s = 0; s < SERIES_COUNT; ++s)
+    {
+        const int16_t value = Clamp16(values[s]);
+        std::memcpy(&payload[2 * s], &value, sizeof(value));
+    }
+
+    Append(RecordType::SAMPLE, now, payload, sizeof(payload));
+}
+
+//-----------------------------------------------------------------------------
+void HistoryLog::RecordEvent(EventCode event, int32_t argument)
+{
+    const uint32_t now = static_cast<uint32_t>(time(nullptr));
+    if (_bufferMutex == nullptr || now < Config::HISTORY_MIN_VALID_TIMESTAMP)
+    {
+        return;
+    }
+
+    uint8_t payload[EVENT_PAYLOAD];
+    const uint16_t code = static_cast<uint16_t>(event);
+    std::memcpy(&payload[0], &code, sizeof(code));
+    std::memcpy(&payload[2], &argument, sizeof(argument));
+
+    Append(RecordType::EVENT, now, payload, sizeof(payload));
+}
+
+//-----------------------------------------------------------------------------
+void HistoryLog::Flush()
+{
+    if (_bufferMutex == nullptr)
+    {
+        return;
+    }
+
+    xSemaphoreTake(_bufferMutex, portMAX_DELAY);
+    Seal();
+    xSemaphoreGive(_bufferMutex);
+}
+
+//-----------------------------------------------------------------------------
+size_t HistoryLog::ForEach(uint32_t from, uint32_t to, const Visitor& visitor) const
+{
+    if (_flashMutex == nullptr)
+    {
+        return 0;
+    }
+
+    xSemaphoreTake(_flashMutex, portMAX_DELAY);
+    size_t visited = ScanKind(SegmentKind::HOURLY, from, to, visitor);
+    visited += ScanKind(SegmentKind::SAMPLES, from, to, visitor);
+    xSemaphoreGive(_flashMutex);
+
+    // Then what the task has not written yet
+    return visited + ScanBuffered(from, to, visitor);
+}
+
+//-----------------------------------------------------------------------------
+size_t HistoryLog::ForEach(RecordType type, uint32_t from, uint32_t to, const Visitor& visitor) const
+{
+    if (_flashMutex == nullptr)
+    {
+        return 0;
+    }
+
+    size_t visited = 0;
+    const Visitor filter = [type, &visitor, &visited](const Record& record)
+        {
+            if (record.type == type)
+            {
+                visitor(record);
+                ++visited;
+            }
+        };
+
+    xSemaphoreTake(_flashMutex, portMAX_DELAY);
+    ScanKind(KindOf(type), from, to, filter);
+    xSemaphoreGive(_flashMutex);
+
+    if (KindOf(type) == SegmentKind::SAMPLES)
+    {
+        ScanBuffered(from, to, filter);
+    }
+
+    return visited;
+}
+
+//-----------------------------------------------------------------------------
+bool HistoryLog::GetSpan(RecordType type, uint32_t& first, uint32_t& last) const
+{
+    if (_flashMutex == nullptr)
+    {
+        return false;
+    }
+
+    const SegmentKind kind = KindOf(type);
+    bool found = false;
+
+    xSemaphoreTake(_flashMutex, portMAX_DELAY);
+
+    for (size_t i = 0; i < _segmentCount; ++i)
+    {
+        const Segment& segment = _segments[i];
+        if (segment.used && segment.kind == kind && segment.validPages != 0)
+        {
+            first = found ? std::min(first, segment.firstTimestamp) : segment.firstTimestamp;
+            last = found ? std::max(last, segment.lastTimestamp) : segment.lastTimestamp;
+            found = true;
+        }
+    }
+
+    xSemaphoreGive(_flashMutex);
+
+    if (kind == SegmentKind::SAMPLES)
+    {
+        xSemaphoreTake(_bufferMutex, portMAX_DELAY);
+
+        for (size_t i = 0; i <= _sealedCount; ++i)
+        {
+            const PageBuffer& page = (i < _sealedCount) ? _sealed[(_sealedHead + i) % SEALED_PAGES] : _filling;
+            if (page.count > 0)
+            {
+                first = found ? std::min(first, page.firstTimestamp) : page.firstTimestamp;
+                last = found ? std::max(last, page.lastTimestamp) : page.lastTimestamp;
+                found = true;
+            }
+        }
+
+        xSemaphoreGive(_bufferMutex);
+    }
+
+    return found;
+}
+
+//-----------------------------------------------------------------------------
+HistoryLog::Stats HistoryLog::GetStats() const
+{
+    if (_flashMutex == nullptr)
+    {
+        return Stats{};
+    }
+
+    xSemaphoreTake(_flashMutex, portMAX_DELAY);
+    Stats stats = _stats;
+    xSemaphoreGive(_flashMutex);
+
+    stats.droppedRecords = _droppedRecords.load(std::memory_order_relaxed);
+    return stats;
+}
+
+//----private------------------------------------------------------------------
+bool HistoryLog::OnInit()
+{
+    _partition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_DATA_SPIFFS, "spiffs");
+    if (_partition == nullptr)
+    {
+        CORE_ERROR("No spiffs partition for the history log");
+        return false;
+    }
+
+    _segmentCount = std::min<size_t>(_partition->size / SEGMENT_SIZE, MAX_SEGMENTS);
+
+    _bufferMutex = xSemaphoreCreateMutex();
+    _flashMutex = xSemaphoreCreateMutex();
+    if (_bufferMutex == nullptr || _flashMutex == nullptr)
+    {
+        CORE_ERROR("Failed to create history log mutexes");
+        return false;
+    }
+
+    for (size_t i = 0; i < _segmentCount; ++i)
+    {
+        MountSegment(i);
+    }
+
+    // Erased segments lost their count with the header: assume the most worn
+    uint32_t maxEraseCount = 0;
+    for (size_t i = 0; i < _segmentCount; ++i)
+    {
+        maxEraseCount = std::max(maxEraseCount, _segments[i].eraseCount);
+    }
+
+    for (size_t i = 0; i < _segmentCount; ++i)
+    {
+        Segment& segment = _segments[i];
+
+        if (!segment.used)
+        {
+            segment.eraseCount = std::max(segment.eraseCount, maxEraseCount);
+            continue;
+        }
+
+        _nextSequence = std::max(_nextSequence, segment.sequence + 1);
+
+        if (segment.kind == SegmentKind::HOURLY && segment.validPages != 0)
+        {
+            _lastHourlyStart = std::max(_lastHourlyStart, segment.lastTimestamp);
+        }
+
+        // Keep filling the newest segment of each kind
+        int& active = _active[static_cast<size_t>(segment.kind)];
+        if (segment.nextPage < PAGES_PER_SEGMENT && (active < 0 || _segments[active].sequence < segment.sequence))
+        {
+            active = static_cast<int>(i);
+        }
+    }
+
+    CORE_INFO("History log: %u segments, %u samples, %u hourly, %u erased",
+              static_cast<unsigned>(_segmentCount), static_cast<unsigned>(CountSegments(SegmentKind::SAMPLES)),
+              static_cast<unsigned>(CountSegments(SegmentKind::HOURLY)), static_cast<unsigned>(CountErased()));
+
+    if (xTaskCreate(TaskEntry, "HistoryLog", Config::HISTORY_LOG_STACK_SIZE, this,
+                    Config::HISTORY_LOG_PRIORITY, &_task) != pdPASS)
+    {
+        CORE_ERROR("Failed to create history log task");
+        return false;
+    }
+
+    // Reclaim space in the background if the last run left too little
+    xTaskNotifyGive(_task);
+    return true;
+}
+
+//----private------------------------------------------------------------------
+void HistoryLog::TaskEntry(void* arg)
+{
+    static_cast<HistoryLog*>(arg)->Run();
+}
+
+//----private------------------------------------------------------------------
+void HistoryLog::Run()
+{
+    PageBuffer page;
+
+    while (true)
+    {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        while (true)
+        {
+            xSemaphoreTake(_bufferMutex, portMAX_DELAY);
+            const bool havePage = (_sealedCount > 0);
+            if (havePage)
+            {
+                page = _sealed[_sealedHead];
+                _sealedHead = (_sealedHead + 1) % SEALED_PAGES;
+                --_sealedCount;
+            }
+            xSemaphoreGive(_bufferMutex);
+
+            xSemaphoreTake(_flashMutex, portMAX_DELAY);
+            if (havePage && !WritePage(SegmentKind::SAMPLES, page))
+            {
+                CORE_ERROR("History log page write failed");
+            }
+            Maintain();
+            xSemaphoreGive(_flashMutex);
+
+            if (!havePage)
+            {
+                break;
+            }
+        }
+    }
+}
+
+//----private------------------------------------------------------------------
+void HistoryLog::Append(RecordType type, uint32_t timestamp, const uint8_t* payload, size_t length)
+{
+    xSemaphoreTake(_bufferMutex, portMAX_DELAY);
+
+    if (!AppendRecord(_filling, type, timestamp, payload, length))
+    {
+        Seal();
+        AppendRecord(_filling, type, timestamp, payload, length);
+    }
+
+    xSemaphoreGive(_bufferMutex);
+}
+
+//----private------------------------------------------------------------------
+void HistoryLog::Seal()
+{
+    if (_filling.count == 0)
+    {
+        return;
+    }
+
+    if (_sealedCount == SEALED_PAGES)
+    {
+        // The task is stuck on the flash: keep the queued pages, lose this one
+        _droppedRecords.fetch_add(_filling.count, std::memory_order_relaxed);
+    }
+    else
+    {
+        _sealed[(_sealedHead + _sealedCount) % SEALED_PAGES] = _filling;
+        ++_sealedCount;
+    }
+
+    _filling = PageBuffer{};
+
+    if (_task != nullptr)
+    {
+        xTaskNotifyGive(_task);
+    }
+}
+
+//----private------------------------------------------------------------------
+void HistoryLog::MountSegment(size_t index)
+{
+    const size_t base = index * SEGMENT_SIZE;
+    Segment& segment = _segments[index];
+    PageBuffer page;
+
+    esp_partition_read(_partition, base, page.bytes, PAGE_SIZE);
+
+    SegmentHeader header;
+    std::memcpy(&header, page.bytes, sizeof(header));
+
+    if (header.magic != SEGMENT_MAGIC || header.version != FORMAT_VERSION || header.crc != HeaderCrc(header))
+    {
+        // Free only if the whole sector is erased: a torn header or erase leaves programmed bytes behind
+        bool erased = IsErased(page.bytes, PAGE_SIZE);
+        for (size_t p = 1; erased && p < PAGES_PER_SEGMENT; ++p)
+        {
+            esp_partition_read(_partition, base + p * PAGE_SIZE, page.bytes, PAGE_SIZE);
+            erased = IsErased(page.bytes, PAGE_SIZE);
+        }
+
+        segment = Segment{};
+        _erased[index] = erased || EraseSegment(index);
+        return;
+    }
+
+    IndexEntry entries[PAGES_PER_SEGMENT - 1];
+    std::memcpy(entries, &page.bytes[INDEX_OFFSET], sizeof(entries));
+
+    segment = Segment{};
+    segment.used = true;
+    segment.kind = static_cast<SegmentKind>(header.kind);
+    segment.sequence = header.sequence;
+    segment.eraseCount = header.eraseCount;
+    _erased[index] = false;
+
+    for (size_t p = 1; p < PAGES_PER_SEGMENT; ++p)
+    {
+        esp_partition_read(_partition, base + p * PAGE_SIZE, page.bytes, PAGE_SIZE);
+        if (IsErased(page.bytes, PAGE_SIZE))
+        {
+            continue;
+        }
+
+        // Written pages are never reused, valid or not
+        segment.nextPage = static_cast<uint8_t>(p + 1);
+
+        if (!CheckPage(page))
+        {
+            continue;
+        }
+
+        if (segment.validPages == 0)
+        {
+            segment.firstTimestamp = page.firstTimestamp;
+        }
+        segment.firstTimestamp = std::min(segment.firstTimestamp, page.firstTimestamp);
+        segment.lastTimestamp = std::max(segment.lastTimestamp, page.lastTimestamp);
+        segment.validPages |= static_cast<uint16_t>(1U << p);
+
+        // The power went between the page and its index entry: finish the entry
+        IndexEntry& entry = entries[p - 1];
+        if (IsErased(reinterpret_cast<const uint8_t*>(&entry), sizeof(entry)))
+        {
+            const IndexEntry fixed = { page.firstTimestamp, page.lastTimestamp };
+            if (esp_partition_write(_partition, base + INDEX_OFFSET + (p - 1) * sizeof(IndexEntry), &fixed, sizeof(fixed)) == ESP_OK)
+            {
+                continue;
+            }
+        }
+
+        if (entry.firstTimestamp != page.firstTimestamp || entry.lastTimestamp != page.lastTimestamp)
+        {
+            segment.untrustedIndex |= static_cast<uint16_t>(1U << p);
+        }
+    }
+}
+
+//----private------------------------------------------------------------------
+bool HistoryLog::WritePage(SegmentKind kind, PageBuffer& page)
+{
+    int& active = _active[static_cast<size_t>(kind)];
+    if (active < 0 || _segments[active].nextPage >= PAGES_PER_SEGMENT)
+    {
+        if (OpenSegment(kind) == nullptr)
+        {
+            _droppedRecords.fetch_add(page.count, std::memory_order_relaxed);
+            return false;
+        }
+    }
+
+    Segment& segment = _segments[active];
+    const size_t base = static_cast<size_t>(active) * SEGMENT_SIZE;
+    const size_t p = segment.nextPage++;
+
+    FinishPage(page);
+
+    // Only the used part: the rest of the page stays erased
+    if (esp_partition_write(_partition, base + p * PAGE_SIZE, page.bytes, sizeof(PageHeader) + page.used) != ESP_OK)
+    {
+        _droppedRecords.fetch_add(page.count, std::memory_order_relaxed);
+        return false;
+    }
+
+    const IndexEntry entry = { page.firstTimestamp, page.lastTimestamp };
+    if (esp_partition_write(_partition, base + INDEX_OFFSET + (p - 1) * sizeof(IndexEntry), &entry, sizeof(entry)) != ESP_OK)
+    {
+        segment.untrustedIndex |= static_cast<uint16_t>(1U << p);
+    }
+
+    if (segment.validPages == 0)
+    {
+        segment.firstTimestamp = page.firstTimestamp;
+    }
+    segment.firstTimestamp = std::min(segment.firstTimestamp, page.firstTimestamp);
+    segment.lastTimestamp = std::max(segment.lastTimestamp, page.lastTimestamp);
+    segment.validPages |= static_cast<uint16_t>(1U << p);
+
+    ++_stats.pagesWritten;
+    return true;
+}
+
+//----private------------------------------------------------------------------
+HistoryLog::Segment* HistoryLog::OpenSegment(SegmentKind kind)
+{
+    // The background reclaim keeps segments erased; without one, drop the oldest data now
+    if (CountErased() == 0 && !ReclaimOne(false))
+    {
+        return nullptr;
+    }
+
+    // Least worn erased segment
+    int chosen = -1;
+    for (size_t i = 0; i < _segmentCount; ++i)
+    {
+        if (_erased[i] && (chosen < 0 || _segments[i].eraseCount < _segments[chosen].eraseCount))
+        {
+            chosen = static_cast<int>(i);
+        }
+    }
+
+    Segment& segment = _segments[chosen];
+
+    SegmentHeader header = {};
+    header.magic = SEGMENT_MAGIC;
+    header.version = FORMAT_VERSION;
+    header.kind = static_cast<uint8_t>(kind);
+    header.reserved = 0xFFFF;
+    header.sequence = _nextSequence++;
+    header.eraseCount = segment.eraseCount;
+    header.crc = HeaderCrc(header);
+
+    _erased[chosen] = false;
+
+    if (esp_partition_write(_partition, static_cast<size_t>(chosen) * SEGMENT_SIZE, &header, sizeof(header)) != ESP_OK)
+    {
+        // Possibly half written: erase it again before any reuse
+        EraseSegment(static_cast<size_t>(chosen));
+        return nullptr;
+    }
+
+    segment = Segment{};
+    segment.used = true;
+    segment.kind = kind;
+    segment.sequence = header.sequence;
+    segment.eraseCount = header.eraseCount;
+
+    _active[static_cast<size_t>(kind)] = chosen;
+    return &segment;
+}
+
+//----private------------------------------------------------------------------
+bool HistoryLog::EraseSegment(size_t index)
+{
+    for (int& active : _active)
+    {
+        if (active == static_cast<int>(index))
+        {
+            active = -1;
+        }
+    }
+
+    const uint32_t eraseCount = _segments[index].eraseCount + 1;
+    _segments[index] = Segment{};
+    _segments[index].eraseCount = eraseCount;
+
+    _erased[index] = (esp_partition_erase_range(_partition, index * SEGMENT_SIZE, SEGMENT_SIZE) == ESP_OK);
+    ++_stats.segmentsErased;
+
+    return _erased[index];
+}
+
+//----private------------------------------------------------------------------
+void HistoryLog::Maintain()
+{
+    while (CountErased() < Config::HISTORY_LOG_FREE_SEGMENTS)
+    {
+        // Compaction writes hourly records: it needs an erased segment to open one
+        if (!ReclaimOne(CountErased() > 0))
+        {
+            break;
+        }
+    }
+}
+
+//----private------------------------------------------------------------------
+bool HistoryLog::ReclaimOne(bool compact)
+{
+    const int oldestHourly = OldestSegment(SegmentKind::HOURLY);
+    if (oldestHourly >= 0 && CountSegments(SegmentKind::HOURLY) >= Config::HISTORY_LOG_HOURLY_SEGMENTS)
+    {
+        return EraseSegment(static_cast<size_t>(oldestHourly));
+    }
+
+    const int oldestSamples = OldestSegment(SegmentKind::SAMPLES);
+    if (oldestSamples >= 0)
+    {
+        if (compact && !Compact(static_cast<size_t>(oldestSamples)))
+        {
+            CORE_WARNING("History log compaction failed, samples dropped");
+        }
+        return EraseSegment(static_cast<size_t>(oldestSamples));
+    }
+
+    return (oldestHourly >= 0) && EraseSegment(static_cast<size_t>(oldestHourly));
+}
+
+//----private------------------------------------------------------------------
+bool HistoryLog::Compact(size_t index)
+{
+    struct Hour
+    {
+        uint32_t start = 0;
+        uint32_t count = 0;
+        int32_t min[SERIES_COUNT];
+        int32_t max[SERIES_COUNT];
+        int64_t sum[SERIES_COUNT];
+    };
+
+    const Segment source = _segments[index];
+    PageBuffer out;
+    Hour hour;
+    uint32_t pendingLast = _lastHourlyStart;
+    bool success = true;
+
+    auto add = [&hour](const Record& record)
+    {
+        if (record.type != RecordType::SAMPLE)
+        {
+            return;
+        }
+
+        for (size_t s = 0; s < SERIES_COUNT; ++s)
+        {
+            const int32_t value = record.series[s].avg;
+            hour.min[s] = (hour.count == 0) ? value : std::min(hour.min[s], value);
+            hour.max[s] = (hour.count == 0) ? value : std::max(hour.max[s], value);
+            hour.sum[s] = ((hour.count == 0) ? 0 : hour.sum[s]) + value;
+        }
+        ++hour.count;
+    };
+
+    auto emit = [&]()
+    {
+        if (hour.count == 0)
+        {
+            return;
+        }
+
+        uint8_t payload[HOURLY_PAYLOAD];
+        const uint16_t count = static_cast<uint16_t>(std::min<uint32_t>(hour.count, std::numeric_limits<uint16_t>::max()));
+        std::memcpy(&payload[0], &count, sizeof(count));
+        for (size_t s = 0; s < SERIES_COUNT; ++s)
+        {
+            const int16_t values[3] = { Clamp16(hour.min[s]), Clamp16(hour.max[s]), Clamp16(static_cast<int32_t>(hour.sum[s] / hour.count)) };
+            std::memcpy(&payload[2 + 6 * s], values, sizeof(values));
+        }
+
+        if (!AppendRecord(out, RecordType::HOURLY, hour.start, payload, sizeof(payload)))
+        {
+            success &= WritePage(SegmentKind::HOURLY, out);
+            _lastHourlyStart = success ? pendingLast : _lastHourlyStart;
+            out = PageBuffer{};
+            AppendRecord(out, RecordType::HOURLY, hour.start, payload, sizeof(payload));
+        }
+
+        pendingLast = hour.start;
+        hour.count = 0;
+    };
+
+    // Hours already aggregated (by a compaction the power cut before the erase) are skipped
+    ScanSegment(source, index, 0, std::numeric_limits<uint32_t>::max(), [&](const Record& record)
+        {
+            const uint32_t start = record.timestamp - (record.timestamp % HOUR_S);
+            if (record.type != RecordType::SAMPLE || (_lastHourlyStart != 0 && start <= _lastHourlyStart))
+            {
+                return;
+            }
+
+            if (hour.count > 0 && start != hour.start)
+            {
+                emit();
+            }
+            hour.start = start;
+            add(record);
+        }
+    );
+
+    // The last hour goes on in the next segments
+    if (hour.count > 0)
+    {
+        for (size_t i = 0; i < _segmentCount; ++i)
+        {
+            const Segment& segment = _segments[i];
+            if (segment.used && segment.kind == SegmentKind::SAMPLES && segment.sequence > source.sequence)
+            {
+                ScanSegment(segment, i, hour.start, hour.start + HOUR_S - 1, add);
+            }
+        }
+        emit();
+    }
+
+    if (out.count > 0)
+    {
+        success &= WritePage(SegmentKind::HOURLY, out);
+    }
+
+    if (success)
+    {
+        _lastHourlyStart = pendingLast;
+    }
+
+    ++_stats.compactions;
+    return success;
+}
+
+//----private------------------------------------------------------------------
+size_t HistoryLog::ScanKind(SegmentKind kind, uint32_t from, uint32_t to, const Visitor& visitor) const
+{
+    size_t order[MAX_SEGMENTS];
+    size_t count = 0;
+    for (size_t i = 0; i < _segmentCount; ++i)
+    {
+        if (_segments[i].used && _segments[i].kind == kind)
+        {
+            order[count++] = i;
+        }
+    }
+    std::sort(order, order + count, [this](size_t a, size_t b) { return _segments[a].sequence < _segments[b].sequence; });
+
+    size_t visited = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        visited += ScanSegment(_segments[order[i]], order[i], from, to, visitor);
+    }
+    return visited;
+}
+
+//----private------------------------------------------------------------------
+size_t HistoryLog::ScanBuffered(uint32_t from, uint32_t to, const Visitor& visitor) const
+{
+    size_t visited = 0;
+
+    xSemaphoreTake(_bufferMutex, portMAX_DELAY);
+
+    for (size_t i = 0; i < _sealedCount; ++i)
+    {
+        visited += DecodePage(_sealed[(_sealedHead + i) % SEALED_PAGES], from, to, visitor);
+    }
+    visited += DecodePage(_filling, from, to, visitor);
+
+    xSemaphoreGive(_bufferMutex);
+
+    return visited;
+}
+
+//----private------------------------------------------------------------------
+size_t HistoryLog::ScanSegment(const Segment& segment, size_t index, uint32_t from, uint32_t to, const Visitor& visitor) const
+{
+    if (!segment.used || segment.validPages == 0 || segment.lastTimestamp < from || segment.firstTimestamp > to)
+    {
+        return 0;
+    }
+
+    const size_t base = index * SEGMENT_SIZE;
+    IndexEntry entries[PAGES_PER_SEGMENT - 1];
+    esp_partition_read(_partition, base + INDEX_OFFSET, entries, sizeof(entries));
+
+    PageBuffer page;
+    size_t visited = 0;
+
+    for (size_t p = 1; p < segment.nextPage; ++p)
+    {
+        const uint16_t bit = static_cast<uint16_t>(1U << p);
+        if ((segment.validPages & bit) == 0)
+        {
+            continue;
+        }
+
+        // Pages entirely outside the range are skipped on the index alone
+        const IndexEntry& entry = entries[p - 1];
+        if ((segment.untrustedIndex & bit) == 0 && (entry.lastTimestamp < from || entry.firstTimestamp > to))
+        {
+            continue;
+        }
+
+        esp_partition_read(_partition, base + p * PAGE_SIZE, page.bytes, PAGE_SIZE);
+        if (CheckPage(page))
+        {
+            visited += DecodePage(page, from, to, visitor);
+        }
+    }
+
+    return visited;
+}
+
+//----private------------------------------------------------------------------
+size_t HistoryLog::CountSegments(SegmentKind kind) const
+{
+    size_t count = 0;
+    for (size_t i = 0; i < _segmentCount; ++i)
+    {
+        count += (_segments[i].used && _segments[i].kind == kind) ? 1 : 0;
+    }
+    return count;
+}
+
+//----private------------------------------------------------------------------
+size_t HistoryLog::CountErased() const
+{
+    return static_cast<size_t>(std::count(_erased, _erased + _segmentCount, true));
+}
+
+//----private------------------------------------------------------------------
+int HistoryLog::OldestSegment(SegmentKind kind) const
+{
+    int oldest = -1;
+    for (size_t i = 0; i < _segmentCount; ++i)
+    {
+        const Segment& segment = _segments[i];
+        if (segment.used && segment.kind == kind && static_cast<int>(i) != _active[static_cast<size_t>(kind)]
+         && (oldest < 0 || segment.sequence < _segments[oldest].sequence))
+        {
+            oldest = static_cast<int>(i);
+        }
+    }
+    return oldest;
+}
+
+//----private------------------------------------------------------------------
+bool HistoryLog::AppendRecord(PageBuffer& page, RecordType type, uint32_t timestamp, const uint8_t* payload, size_t length)
+{
+    const bool fits = (page.used + sizeof(RecordHeader) + length <= PAGE_SIZE - sizeof(PageHeader));
+    const bool inPage = (page.count == 0)
+                     || (timestamp >= page.firstTimestamp && timestamp - page.firstTimestamp <= std::numeric_limits<uint16_t>::max());
+
+    if (!fits || !inPage || page.count == std::numeric_limits<uint8_t>::max())
+    {
+        return false;
+    }
+
+    if (page.count == 0)
+    {
+        page.firstTimestamp = timestamp;
+        page.lastTimestamp = timestamp;
+    }
+
+    const RecordHeader header = { static_cast<uint8_t>(type), static_cast<uint8_t>(length),
+                                  static_cast<uint16_t>(timestamp - page.firstTimestamp) };
+
+    uint8_t* position = &page.bytes[sizeof(PageHeader) + page.used];
+    std::memcpy(position, &header, sizeof(header));
+    std::memcpy(position + sizeof(header), payload, length);
+
+    page.used += sizeof(header) + length;
+    page.lastTimestamp = std::max(page.lastTimestamp, timestamp);
+    ++page.count;
+    return true;
+}
+
+//----private------------------------------------------------------------------
+size_t HistoryLog::DecodePage(const PageBuffer& page, uint32_t from, uint32_t to, const Visitor& visitor)
+{
+    size_t visited = 0;
+    size_t offset = sizeof(PageHeader);
+    const size_t end = sizeof(PageHeader) + page.used;
+
+    for (size_t i = 0; i < page.count && offset + sizeof(RecordHeader) <= end; ++i)
+    {
+        RecordHeader header;
+        std::memcpy(&header, &page.bytes[offset], sizeof(header));
+        const uint8_t* payload = &page.bytes[offset + sizeof(header)];
+        offset += sizeof(header) + header.length;
+
+        if (offset > end)
+        {
+            break;
+        }
+
+        Record record = {};
+        record.type = static_cast<RecordType>(header.type);
+        record.timestamp = page.firstTimestamp + header.offset;
+
+        if (record.timestamp < from || record.timestamp > to)
+        {
+            continue;
+        }
+
+        if (record.type == RecordType::SAMPLE && header.length >= SAMPLE_PAYLOAD)
+        {
+            record.count = 1;
+            for (size_t s = 0; s < SERIES_COUNT; ++s)
+            {
+                int16_t value = 0;
+                std::memcpy(&value, &payload[2 * s], sizeof(value));
+                record.series[s] = TimeSeries::Bucket{ value, value, value };
+            }
+        }
+        else if (record.type == RecordType::HOURLY && header.length >= HOURLY_PAYLOAD)
+        {
+            std::memcpy(&record.count, &payload[0], sizeof(record.count));
+            for (size_t s = 0; s < SERIES_COUNT; ++s)
+            {
+                int16_t values[3];
+                std::memcpy(values, &payload[2 + 6 * s], sizeof(values));
+                record.series[s] = TimeSeries::Bucket{ values[0], values[1], values[2] };
+            }
+        }
+        else if (record.type == RecordType::EVENT && header.length >= EVENT_PAYLOAD)
+        {
+            uint16_t code = 0;
+            std::memcpy(&code, &payload[0], sizeof(code));
+            std::memcpy(&record.argument, &payload[2], sizeof(record.argument));
+            record.event = static_cast<EventCode>(code);
+        }
+        else
+        {
+            continue;       // Written by a newer format
+        }
+
+        visitor(record);
+        ++visited;
+    }
+
+    return visited;
+}
+
+//----private------------------------------------------------------------------
+void HistoryLog::FinishPage(PageBuffer& page)
+{
+    PageHeader header = {};
+    header.magic = PAGE_MAGIC;
+    header.count = page.count;
+    header.used = static_cast<uint8_t>(page.used);
+    header.firstTimestamp = page.firstTimestamp;
+    header.lastTimestamp = page.lastTimestamp;
+
+    uint32_t crc = esp_rom_crc32_le(0, reinterpret_cast<const uint8_t*>(&header), offsetof(PageHeader, crc));
+    header.crc = esp_rom_crc32_le(crc, &page.bytes[sizeof(PageHeader)], static_cast<uint32_t>(page.used));
+
+    std::memcpy(page.bytes, &header, sizeof(header));
+}
+
+//----private------------------------------------------------------------------
+bool HistoryLog::CheckPage(PageBuffer& page)
+{
+    PageHeader header;
+    std::memcpy(&header, page.bytes, sizeof(header));
+
+    if (header.magic != PAGE_MAGIC || header.used > PAGE_SIZE - sizeof(PageHeader))
+    {
+        return false;
+    }
+
+    uint32_t crc = esp_rom_crc32_le(0, reinterpret_cast<const uint8_t*>(&header), offsetof(PageHeader, crc));
+    crc = esp_rom_crc32_le(crc, &page.bytes[sizeof(PageHeader)], header.used);
+    if (crc != header.crc)
+    {
+        return false;
+    }
+
+    page.used = header.used;
+    page.count = header.count;
+    page.firstTimestamp = header.firstTimestamp;
+    page.lastTimestamp = header.lastTimestamp;
+    return true;
+}
+
+//----private------------------------------------------------------------------
+bool HistoryLog::IsErased(const uint8_t* bytes, size_t length)
+{
+    return std::all_of(bytes, bytes + length, [](uint8_t byte) { return byte == 0xFF; });
+}
+
+} // namespace Services
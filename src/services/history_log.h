@@ -0,0 +1,244 @@
+/*!****************************************************************************
+ * @file    history_log.h
+ * @brief   Append-only history of the readings and events on the raw spiffs
+ *          partition, kept across reboots.
+ *
+ *          The partition is a ring of 4 KB segments (one erase sector each).
+ *          Page 0 of a segment holds its header (kind, sequence, erase
+ *          count) and a sparse time index: the first/last timestamp of each
+ *          data page, programmed after the page. Pages 1-15 each hold one
+ *          batch of records with its own CRC; records are buffered in RAM
+ *          and written a whole page at a time by a background task.
+ *
+ *          Power loss: a torn page or index entry fails its CRC and is
+ *          skipped, a torn segment header or erase is erased again at mount.
+ *          Nothing already written is ever rewritten in place.
+ *
+ *          Space: minute samples go to SAMPLES segments. When erased
+ *          segments run low the task compacts the oldest SAMPLES segment
+ *          into hourly min/max/avg records in HOURLY segments and erases it;
+ *          the oldest HOURLY segment is dropped past a limit. Erased
+ *          segments are reused lowest erase count first.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#pragma once
+
+#include "esp_partition.h"
+#include "framework/common_defs.h"
+#include "framework/timeseries/time_series_store.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include "include/config.h"
+#include "src/core/base/service.h"
+#include "src/services/reading_history.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+namespace Services {
+
+class HistoryLog : public Base::Singleton<HistoryLog>
+                 , public Base::Service
+{
+    public:
+
+        static constexpr size_t SERIES_COUNT = ReadingHistory::SERIES_COUNT;
+
+        enum class RecordType : uint8_t
+        {
+            SAMPLE = 1,
+            HOURLY = 2,
+            EVENT = 3
+        };
+
+        enum class EventCode : uint16_t
+        {
+            POWER_MODE_CHANGED = 1,         //!< argument: new PowerController::Mode
+            FEEDING_DONE = 2,               //!< argument: dose
+            READING_ANOMALY = 3             //!< argument: (ReadingAnomaly::Sensor << 8) | ReadingAnomaly::Kind
+        };
+
+        struct Record
+        {
+            RecordType type;
+            uint32_t timestamp;                             //!< HOURLY: start of the hour
+            uint16_t count;                                 //!< Samples behind the values (1 for a SAMPLE)
+            TimeSeries::Bucket series[SERIES_COUNT];        //!< ReadingHistory units; a SAMPLE has min == max == avg
+            EventCode event;
+            int32_t argument;
+        };
+
+        using Visitor = std::function<void(const Record&)>;
+
+        struct Stats
+        {
+            uint32_t pagesWritten;
+            uint32_t segmentsErased;
+            uint32_t compactions;
+            uint32_t droppedRecords;                        //!< Lost to a full write queue or a failed write
+        };
+
+        /**
+         * @brief Logs the readings, at most one sample per HISTORY_LOG_SAMPLE_PERIOD_S.
+         *        Ignored until the wall clock has been set (HISTORY_MIN_VALID_TIMESTAMP).
+         */
+        void RecordSample(const ReadingHistory::Values& values);
+
+        /**
+         * @brief Logs an event. Ignored until the wall clock has been set.
+         */
+        void RecordEvent(EventCode event, int32_t argument = 0);
+
+        /**
+         * @brief Hands the page being filled to the task now instead of when full
+         *        (the rest of the page is left unused).
+         */
+        void Flush();
+
+        /**
+         * @brief Visits the records with from <= timestamp <= to: the hourly aggregates
+         *        first, then the samples and events, each oldest first. Records not
+         *        written to flash yet are included.
+         * @return size_t Records visited.
+         */
+        size_t ForEach(uint32_t from, uint32_t to, const Visitor& visitor) const;
+
+        /**
+         * @brief Visits the records of one type with from <= timestamp <= to, oldest
+         *        first. Only the segments that can hold that type are read, and of
+         *        those only the pages whose time index overlaps the range.
+         * @return size_t Records visited.
+         */
+        size_t ForEach(RecordType type, uint32_t from, uint32_t to, const Visitor& visitor) const;
+
+        /**
+         * @brief Oldest and newest timestamp of the segments (and buffered pages)
+         *        holding a record type; an HOURLY timestamp is the start of its hour.
+         * @return bool False when there is none.
+         */
+        bool GetSpan(RecordType type, uint32_t& first, uint32_t& last) const;
+
+        Stats GetStats() const;
+
+    protected:
+
+        friend class Base::Singleton<HistoryLog>;
+
+        /*!
+        * @brief Get the module name.
+        * @return const char* Module name.
+        */
+        const char* GetModuleName() const override { return "HistoryLog"; }
+
+        /*!
+         * @brief Mounts the partition (checks every segment, repairs what a power
+         *        loss left behind) and starts the writer task.
+         * @return bool True if initialization successful, false otherwise.
+         */
+        bool OnInit() override;
+
+    private:
+
+        static constexpr uint32_t SEGMENT_SIZE = 4096;
+        static constexpr uint32_t PAGE_SIZE = 256;
+        static constexpr size_t PAGES_PER_SEGMENT = SEGMENT_SIZE / PAGE_SIZE;
+        static constexpr size_t MAX_SEGMENTS = 64;
+        static constexpr size_t SEALED_PAGES = 2;                   //!< Pages queued for the task
+        static constexpr uint32_t HOUR_S = 3600;
+
+        enum class SegmentKind : uint8_t
+        {
+            SAMPLES = 1,
+            HOURLY = 2
+        };
+
+        struct Segment
+        {
+            bool used = false;                  //!< Has a valid header
+            SegmentKind kind = SegmentKind::SAMPLES;
+            uint32_t sequence = 0;
+            uint32_t eraseCount = 0;
+            uint32_t firstTimestamp = 0;
+            uint32_t lastTimestamp = 0;
+            uint16_t validPages = 0;            //!< Bit per data page that passed its CRC
+            uint16_t untrustedIndex = 0;        //!< Bit per data page whose index entry is torn
+            uint8_t nextPage = 1;               //!< First unwritten data page
+        };
+
+        //! Records of one data page, laid out as they go to flash
+        struct PageBuffer
+        {
+            uint8_t bytes[PAGE_SIZE];
+            size_t used = 0;                    //!< Payload bytes after the page header
+            uint8_t count = 0;
+            uint32_t firstTimestamp = 0;
+            uint32_t lastTimestamp = 0;
+        };
+
+        HistoryLog() = default;
+        ~HistoryLog() = default;
+        HistoryLog(const HistoryLog&) = delete;
+        HistoryLog& operator=(const HistoryLog&) = delete;
+
+        static void TaskEntry(void* arg);
+
+        /**
+         * @brief Writes the sealed pages and keeps enough segments erased.
+         */
+        void Run();
+
+        void Append(RecordType type, uint32_t timestamp, const uint8_t* payload, size_t length);
+        void Seal();                                    // _bufferMutex held
+
+        // _flashMutex held
+        void MountSegment(size_t index);
+        bool WritePage(SegmentKind kind, PageBuffer& page);
+        Segment* OpenSegment(SegmentKind kind);
+        bool EraseSegment(size_t index);
+        void Maintain();
+        bool ReclaimOne(bool compact);
+        bool Compact(size_t index);
+        size_t ScanKind(SegmentKind kind, uint32_t from, uint32_t to, const Visitor& visitor) const;
+        size_t ScanSegment(const Segment& segment, size_t index, uint32_t from, uint32_t to, const Visitor& visitor) const;
+        size_t CountSegments(SegmentKind kind) const;
+        size_t CountErased() const;
+        int OldestSegment(SegmentKind kind) const;
+
+        size_t ScanBuffered(uint32_t from, uint32_t to, const Visitor& visitor) const;   // Takes _bufferMutex
+
+        static SegmentKind KindOf(RecordType type) { return (type == RecordType::HOURLY) ? SegmentKind::HOURLY : SegmentKind::SAMPLES; }
+        static bool AppendRecord(PageBuffer& page, RecordType type, uint32_t timestamp, const uint8_t* payload, size_t length);
+        static size_t DecodePage(const PageBuffer& page, uint32_t from, uint32_t to, const Visitor& visitor);
+        static void FinishPage(PageBuffer& page);
+        static bool CheckPage(PageBuffer& page);
+        static bool IsErased(const uint8_t* bytes, size_t length);
+
+        // ---------------------------------------------
+
+        const esp_partition_t* _partition = nullptr;
+        size_t _segmentCount = 0;
+        Segment _segments[MAX_SEGMENTS];
+        bool _erased[MAX_SEGMENTS] = {};
+        int _active[3] = { -1, -1, -1 };           //!< Segment being filled, by SegmentKind
+        uint32_t _nextSequence = 1;
+        uint32_t _lastHourlyStart = 0;              //!< Newest hour already aggregated
+
+        SemaphoreHandle_t _bufferMutex = nullptr;   //!< _filling, _sealed, _lastSampleSlot
+        SemaphoreHandle_t _flashMutex = nullptr;    //!< Partition and segment table
+        TaskHandle_t _task = nullptr;
+
+        PageBuffer _filling;
+        PageBuffer _sealed[SEALED_PAGES];
+        size_t _sealedHead = 0;
+        size_t _sealedCount = 0;
+        uint32_t _lastSampleSlot = 0;
+
+        Stats _stats = {};                          //!< _flashMutex, but the dropped records
+        std::atomic<uint32_t> _droppedRecords{0};
+};
+
+} // namespace Services
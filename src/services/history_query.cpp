@@ -0,0 +1,361 @@
+/*!****************************************************************************
+ * @file    history_query.cpp
+ * @brief   Range queries over the on-device history of one reading.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#include "src/services/history_query.h"
+
+#include "include/config.h"
+#include <algorithm>
+#include <ctime>
+#include <limits>
+
+namespace Services {
+
+//-----------------------------------------------------------------------------
+HistoryQuery::HistoryQuery(Series series, uint32_t from, uint32_t to, uint32_t resolution)
+    : _series(series)
+    , _resolution(std::max<uint32_t>(resolution, 1))
+    , _cursor(std::max(from, Config::HISTORY_MIN_VALID_TIMESTAMP))
+    , _to(to)
+{
+    // Nothing is recorded past now: open-ended sources stop there
+    _to = std::min(_to, static_cast<uint32_t>(time(nullptr)));
+
+    _done = (_cursor > _to);
+    if (!_done)
+    {
+        Plan(_cursor, _to);
+    }
+    if (!_done)
+    {
+        _cursor = std::max(_cursor, _pieces[0].from);
+    }
+}
+
+//-----------------------------------------------------------------------------
+size_t HistoryQuery::Next(Point* points, size_t capacity)
+{
+    _out = points;
+    _outCapacity = capacity;
+    _outCount = 0;
+
+    unsigned stretch = 0;
+
+    while (_outCount < capacity && !_done)
+    {
+        // Long enough to fill the room left if the source at the cursor has a
+        // record every period (twice as long after each pass that found
+        // nothing), and made of whole windows so that none spans two passes.
+        // A denser source further on fills the room early: the pass then
+        // stops at the first window that has no room (Add())
+        const Piece* current = std::find_if(_pieces, _pieces + _pieceCount, [this](const Piece& piece) { return piece.to >= _cursor; });
+        const uint64_t step = std::max(_resolution, SOURCE_PERIOD_S[static_cast<size_t>(current->source)]);
+        const uint64_t windowStart = _cursor - (_cursor % _resolution);
+        const uint64_t span = std::max<uint64_t>(_resolution, (((capacity - _outCount) * step) << stretch) / _resolution * _resolution);
+        const uint32_t passTo = static_cast<uint32_t>(std::min<uint64_t>(_to, windowStart + span - 1));
+        const size_t pointsBefore = _outCount;
+
+        _window.count = 0;
+        _full = false;
+        for (size_t i = 0; i < _pieceCount && _pieces[i].from <= passTo && !_full; ++i)
+        {
+            if (_pieces[i].to >= _cursor)
+            {
+                Read(_pieces[i], std::max(_pieces[i].from, _cursor), std::min(_pieces[i].to, passTo));
+            }
+        }
+
+        if (_full)
+        {
+            _cursor = std::max(_cursor, _resumeAt);
+            break;
+        }
+        Emit();
+        stretch = (_outCount == pointsBefore) ? std::min(stretch + 1, MAX_STRETCH) : 0;
+
+        if (passTo >= _to)
+        {
+            _done = true;
+            break;
+        }
+        _cursor = passTo + 1;
+
+        // Jump over time no source covers
+        const Piece* next = std::find_if(_pieces, _pieces + _pieceCount, [this](const Piece& piece) { return piece.to >= _cursor; });
+        if (next == _pieces + _pieceCount)
+        {
+            _done = true;
+        }
+        else
+        {
+            _cursor = std::max(_cursor, next->from);
+        }
+    }
+
+    return _outCount;
+}
+
+//-----------------------------------------------------------------------------
+const char* HistoryQuery::GetSourceName(Source source)
+{
+    switch (source)
+    {
+        case Source::RAW:           return "raw";
+        case Source::MINUTES:       return "minutes";
+        case Source::HOURS:         return "hours";
+        case Source::LOG_SAMPLES:   return "log_samples";
+        case Source::LOG_HOURS:     return "log_hours";
+        default:                    return "unknown";
+    }
+}
+
+//----private------------------------------------------------------------------
+void HistoryQuery::Plan(uint32_t from, uint32_t to)
+{
+    // Preference: the sources that meet the resolution, RAM before flash and
+    // the coarsest first; then, for what none of them covers, the finest of the
+    // rest. RAM goes first because it holds every reading of the time it covers
+    // (the flash log keeps one sample a minute), so the flash log only answers
+    // for what is older than the RAM history
+    Source order[SOURCE_COUNT];
+    for (size_t i = 0; i < SOURCE_COUNT; ++i)
+    {
+        order[i] = static_cast<Source>(i);
+    }
+
+    std::stable_sort(order, order + SOURCE_COUNT, [this](Source a, Source b)
+        {
+            const uint32_t periodA = SOURCE_PERIOD_S[static_cast<size_t>(a)];
+            const uint32_t periodB = SOURCE_PERIOD_S[static_cast<size_t>(b)];
+            const bool meetsA = (periodA <= _resolution);
+            const bool meetsB = (periodB <= _resolution);
+
+            if (meetsA != meetsB)
+            {
+                return meetsA;
+            }
+            if (!meetsA)
+            {
+                return periodA < periodB;
+            }
+            if (IsInRam(a) != IsInRam(b))
+            {
+                return IsInRam(a);
+            }
+            return periodA > periodB;
+        }
+    );
+
+    // Hand each source the parts of the range that are still uncovered
+    struct Gap { uint32_t from; uint32_t to; };
+    Gap gaps[MAX_PIECES + 1] = { { from, to } };
+    size_t gapCount = 1;
+
+    for (const Source source : order)
+    {
+        uint32_t first = 0;
+        uint32_t last = 0;
+        if (!GetCoverage(source, first, last))
+        {
+            continue;
+        }
+
+        Gap remaining[MAX_PIECES + 1];
+        size_t remainingCount = 0;
+
+        for (size_t g = 0; g < gapCount; ++g)
+        {
+            const Gap& gap = gaps[g];
+            const uint32_t start = std::max(gap.from, first);
+            const uint32_t end = std::min(gap.to, last);
+
+            if (start > end || _pieceCount == MAX_PIECES)
+            {
+                remaining[remainingCount++] = gap;
+                continue;
+            }
+
+            _pieces[_pieceCount++] = Piece{ source, start, end };
+
+            if (gap.from < start && remainingCount < MAX_PIECES + 1)
+            {
+                remaining[remainingCount++] = Gap{ gap.from, start - 1 };
+            }
+            if (end < gap.to && remainingCount < MAX_PIECES + 1)
+            {
+                remaining[remainingCount++] = Gap{ end + 1, gap.to };
+            }
+        }
+
+        std::copy(remaining, remaining + remainingCount, gaps);
+        gapCount = remainingCount;
+    }
+
+    std::sort(_pieces, _pieces + _pieceCount, [](const Piece& a, const Piece& b) { return a.from < b.from; });
+    _done = (_pieceCount == 0);
+}
+
+//----private------------------------------------------------------------------
+bool HistoryQuery::GetCoverage(Source source, uint32_t& first, uint32_t& last) const
+{
+    constexpr uint32_t OPEN_END = std::numeric_limits<uint32_t>::max();
+    const ReadingHistory* history = ReadingHistory::GetInstance();
+
+    switch (source)
+    {
+        case Source::RAW:
+        {
+            first = history->GetOldestRawTimestamp();
+            last = OPEN_END;
+            return first != 0;
+        }
+
+        case Source::MINUTES:
+        case Source::HOURS:
+        {
+            // The oldest bucket may have started before the history did (boot, clock set):
+            // it only counts from the next one, the flash log has the full period
+            const ReadingHistory::Tier tier = (source == Source::MINUTES) ? ReadingHistory::Tier::MINUTE : ReadingHistory::Tier::HOUR;
+            const uint32_t oldest = history->GetOldestBucketStart(tier);
+            first = oldest + SOURCE_PERIOD_S[static_cast<size_t>(source)];
+            last = OPEN_END;
+            return oldest != 0;
+        }
+
+        case Source::LOG_SAMPLES:
+        {
+            // A sample stands for the minute it was taken in, and no further:
+            // the next one may not be logged yet
+            if (!HistoryLog::GetInstance()->GetSpan(HistoryLog::RecordType::SAMPLE, first, last))
+            {
+                return false;
+            }
+            last += Config::HISTORY_LOG_SAMPLE_PERIOD_S - 1 - (last % Config::HISTORY_LOG_SAMPLE_PERIOD_S);
+            return true;
+        }
+
+        case Source::LOG_HOURS:
+        {
+            if (!HistoryLog::GetInstance()->GetSpan(HistoryLog::RecordType::HOURLY, first, last))
+            {
+                return false;
+            }
+            last += SOURCE_PERIOD_S[static_cast<size_t>(source)] - 1;
+            return true;
+        }
+
+        default:
+            return false;
+    }
+}
+
+//----private------------------------------------------------------------------
+void HistoryQuery::Read(const Piece& piece, uint32_t from, uint32_t to)
+{
+    const size_t series = static_cast<size_t>(_series);
+
+    switch (piece.source)
+    {
+        case Source::RAW:
+        {
+            ReadingHistory::GetInstance()->ForEachRaw(from, to, [this, series](uint32_t timestamp, const ReadingHistory::Values& values)
+                {
+                    Add(timestamp, 1, values[series], values[series], values[series]);
+                }
+            );
+            break;
+        }
+
+        case Source::MINUTES:
+        case Source::HOURS:
+        {
+            const ReadingHistory::Tier tier = (piece.source == Source::MINUTES) ? ReadingHistory::Tier::MINUTE : ReadingHistory::Tier::HOUR;
+            ReadingHistory::GetInstance()->ForEachBucket(tier, from, to, [this, series, from](const ReadingHistory::Row& row)
+                {
+                    // A bucket belongs to the piece holding its start
+                    if (row.start >= from)
+                    {
+                        const TimeSeries::Bucket& bucket = row.series[series];
+                        Add(row.start, row.count, bucket.min, bucket.avg, bucket.max);
+                    }
+                }
+            );
+            break;
+        }
+
+        case Source::LOG_SAMPLES:
+        case Source::LOG_HOURS:
+        {
+            const HistoryLog::RecordType type = (piece.source == Source::LOG_SAMPLES) ? HistoryLog::RecordType::SAMPLE : HistoryLog::RecordType::HOURLY;
+            HistoryLog::GetInstance()->ForEach(type, from, to, [this, series](const HistoryLog::Record& record)
+                {
+                    const TimeSeries::Bucket& bucket = record.series[series];
+                    Add(record.timestamp, record.count, bucket.min, bucket.avg, bucket.max);
+                }
+            );
+            break;
+        }
+
+        default:
+            break;
+    }
+}
+
+//----private------------------------------------------------------------------
+void HistoryQuery::Add(uint32_t timestamp, uint32_t count, int32_t min, int32_t avg, int32_t max)
+{
+    if (count == 0 || _full)
+    {
+        return;
+    }
+
+    const uint32_t start = timestamp - (timestamp % _resolution);
+    if (_window.count > 0 && start != _window.start)
+    {
+        Emit();
+    }
+
+    // No room for the window this record opens: the next call starts from it
+    if (_window.count == 0 && _outCount == _outCapacity)
+    {
+        _full = true;
+        _resumeAt = start;
+        return;
+    }
+
+    if (_window.count == 0)
+    {
+        _window.start = start;
+        _window.min = min;
+        _window.max = max;
+        _window.sum = 0;
+    }
+
+    _window.min = std::min(_window.min, min);
+    _window.max = std::max(_window.max, max);
+    _window.sum += static_cast<int64_t>(avg) * count;
+    _window.count += count;
+}
+
+//----private------------------------------------------------------------------
+void HistoryQuery::Emit()
+{
+    if (_window.count == 0)
+    {
+        return;
+    }
+
+    Point& point = _out[_outCount++];
+    point.start = _window.start;
+    point.count = _window.count;
+    point.min = ReadingHistory::ToReading(_series, _window.min);
+    point.avg = ReadingHistory::ToReading(_series, static_cast<int32_t>(_window.sum / _window.count));
+    point.max = ReadingHistory::ToReading(_series, _window.max);
+
+    _window.count = 0;
+}
+
+} // namespace Services
@@ -0,0 +1,128 @@
+/*!****************************************************************************
+ * @file    history_query.h
+ * @brief   Range queries over the on-device history of one reading: picks,
+ *          for each part of the range, the coarsest history tier that still
+ *          meets the requested resolution, RAM first (raw / minute / hour
+ *          tiers of ReadingHistory, then flash samples / hourly records of
+ *          HistoryLog for what is older), and
+ *          aggregates what it reads into one min/avg/max point per
+ *          resolution window.
+ *
+ *          Results come out a chunk at a time: each call to Next() seeks the
+ *          sources to where the previous one stopped (binary search in RAM,
+ *          segment and page time index in flash), so no lock is held and no
+ *          buffer grows between chunks. A bucket of a coarser tier is not
+ *          split: it counts in full at its start time.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#pragma once
+
+#include "framework/common_defs.h"
+#include "src/services/history_log.h"
+#include "src/services/reading_history.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace Services {
+
+class HistoryQuery
+{
+    public:
+
+        using Series = ReadingHistory::Series;
+
+        enum class Source : uint8_t
+        {
+            RAW,                    //!< ReadingHistory raw records
+            MINUTES,                //!< ReadingHistory minute tier
+            HOURS,                  //!< ReadingHistory hour tier
+            LOG_SAMPLES,            //!< HistoryLog minute samples
+            LOG_HOURS,              //!< HistoryLog hourly aggregates
+            _size
+        };
+
+        struct Point
+        {
+            uint32_t start;         //!< Start of the resolution window
+            uint32_t count;         //!< Readings behind the point
+            float min;
+            float avg;
+            float max;
+        };
+
+        //! Part of the range answered from one source
+        struct Piece
+        {
+            Source source;
+            uint32_t from;
+            uint32_t to;
+        };
+
+        /**
+         * @brief Plans the query: splits [from, to] between the sources.
+         * @param resolution Window of one point, in seconds (at least 1).
+         */
+        HistoryQuery(Series series, uint32_t from, uint32_t to, uint32_t resolution);
+
+        /**
+         * @brief Fills the next points, oldest first; windows without data are skipped.
+         * @return size_t Points written: 'capacity' until the last ones, 0 once IsDone().
+         */
+        size_t Next(Point* points, size_t capacity);
+
+        bool IsDone() const { return _done; }
+
+        Series GetSeries() const { return _series; }
+        uint32_t GetResolution() const { return _resolution; }
+        size_t GetPieceCount() const { return _pieceCount; }
+        const Piece& GetPiece(size_t index) const { return _pieces[index]; }
+
+        static const char* GetSourceName(Source source);
+
+    private:
+
+        static constexpr size_t SOURCE_COUNT = static_cast<size_t>(Source::_size);
+        static constexpr size_t MAX_PIECES = 2 * SOURCE_COUNT;
+        static constexpr uint32_t SOURCE_PERIOD_S[SOURCE_COUNT] = { 0, 60, 3600, 60, 3600 };
+        static constexpr unsigned MAX_STRETCH = 16;        //!< Empty passes grow up to 2^16 times
+
+        //! Point being aggregated, in the integer units of the history
+        struct Window
+        {
+            uint32_t start = 0;
+            uint32_t count = 0;
+            int32_t min = 0;
+            int32_t max = 0;
+            int64_t sum = 0;
+        };
+
+        static bool IsInRam(Source source) { return source <= Source::HOURS; }
+
+        void Plan(uint32_t from, uint32_t to);
+        bool GetCoverage(Source source, uint32_t& first, uint32_t& last) const;
+        void Read(const Piece& piece, uint32_t from, uint32_t to);
+        void Add(uint32_t timestamp, uint32_t count, int32_t min, int32_t avg, int32_t max);
+        void Emit();
+
+        // ---------------------------------------------
+
+        Series _series;
+        uint32_t _resolution;
+        uint32_t _cursor;
+        uint32_t _to;
+        bool _done = false;
+
+        Piece _pieces[MAX_PIECES];
+        size_t _pieceCount = 0;
+
+        Window _window;
+        Point* _out = nullptr;
+        size_t _outCapacity = 0;
+        size_t _outCount = 0;
+        bool _full = false;                 //!< The pass ran out of room for points
+        uint32_t _resumeAt = 0;             //!< Then: first window left for the next call
+};
+
+} // namespace Services
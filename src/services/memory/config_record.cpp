@@ -0,0 +1,311 @@
+/*!****************************************************************************
+ * @file    config_record.cpp
+ * @brief   Binary EEPROM layout of MemoryConfigData.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#include "src/services/memory/config_record.h"
+
+#include "esp_rom_crc.h"
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+
+namespace Services {
+
+static constexpr uint32_t RECORD_MAGIC = 0x43474153;        // "SAGC"
+static constexpr size_t TLV_HEADER_SIZE = 2;                // Tag, length
+static constexpr size_t SCHEDULE_ENTRY_SIZE = 5;            // Minutes (2), slot, dose, enabled
+
+// On-EEPROM layout (little endian)
+struct __attribute__((packed)) RecordHeader
+{
+    uint32_t magic;
+    uint8_t version;
+    uint8_t reserved;
+    uint16_t fixedSize;         //!< Bytes of fixed fields after the header
+    uint16_t length;            //!< Whole record, header included
+    uint16_t sequence;
+    uint32_t crc;               //!< Of the fields above and the rest of the record
+};
+
+static_assert(sizeof(RecordHeader) == ConfigRecord::HEADER_SIZE, "Record header size mismatch");
+
+//! Strings and the schedule go to the TLV area, everything else to the fixed one
+template <typename T>
+inline constexpr bool IS_VARIABLE = std::is_same_v<T, std::string> || std::is_same_v<T, FeeddingScheduleList>;
+
+template <typename T>
+inline constexpr size_t FIXED_SIZE = std::is_same_v<T, bool> ? 1 : 4;
+
+static constexpr size_t FIXED_FIELDS_SIZE = 0
+    #define X(type, id, name, key, def) + (IS_VARIABLE<type> ? 0 : FIXED_SIZE<type>)
+    CONFIG_FIELDS
+    #undef X
+    ;
+
+//-----------------------------------------------------------------------------
+static uint32_t RecordCrc(const uint8_t* record, size_t length)
+{
+    const uint32_t crc = esp_rom_crc32_le(0, record, offsetof(RecordHeader, crc));
+    return esp_rom_crc32_le(crc, record + sizeof(RecordHeader), static_cast<uint32_t>(length - sizeof(RecordHeader)));
+}
+
+//-----------------------------------------------------------------------------
+// Fixed fields
+
+static void PutFixed(uint8_t* at, bool value)  { *at = value ? 1 : 0; }
+static void PutFixed(uint8_t* at, int value)   { const int32_t v = value; std::memcpy(at, &v, sizeof(v)); }
+static void PutFixed(uint8_t* at, float value) { std::memcpy(at, &value, sizeof(value)); }
+
+static void GetFixed(const uint8_t* at, bool& value)  { value = (*at != 0); }
+static void GetFixed(const uint8_t* at, int& value)   { int32_t v; std::memcpy(&v, at, sizeof(v)); value = v; }
+static void GetFixed(const uint8_t* at, float& value) { std::memcpy(&value, at, sizeof(value)); }
+
+//-----------------------------------------------------------------------------
+// Variable fields: the TLV value, 'capacity' bytes at most. Return the length, or -1 if it does not fit
+
+static int PutVariable(uint8_t* at, size_t capacity, const std::string& value)
+{
+    if (value.size() > capacity)
+    {
+        return -1;
+    }
+    std::memcpy(at, value.data(), value.size());
+    return static_cast<int>(value.size());
+}
+
+static int PutVariable(uint8_t* at, size_t capacity, const FeeddingScheduleList& value)
+{
+    if (value.size() * SCHEDULE_ENTRY_SIZE > capacity)
+    {
+        return -1;
+    }
+
+    for (const FeedingScheduleEntry& entry : value)
+    {
+        const uint16_t minutes = static_cast<uint16_t>(entry._min);
+        std::memcpy(at, &minutes, sizeof(minutes));
+        at[2] = static_cast<uint8_t>(entry._id);
+        at[3] = static_cast<uint8_t>(entry._dose);
+        at[4] = entry._enabled ? 1 : 0;
+        at += SCHEDULE_ENTRY_SIZE;
+    }
+    return static_cast<int>(value.size() * SCHEDULE_ENTRY_SIZE);
+}
+
+static bool GetVariable(const uint8_t* at, size_t length, std::string& value)
+{
+    value.assign(reinterpret_cast<const char*>(at), length);
+    return true;
+}
+
+static bool GetVariable(const uint8_t* at, size_t length, FeeddingScheduleList& value)
+{
+    if (length % SCHEDULE_ENTRY_SIZE != 0)
+    {
+        return false;
+    }
+
+    value.clear();
+    for (size_t offset = 0; offset < length; offset += SCHEDULE_ENTRY_SIZE)
+    {
+        uint16_t minutes = 0;
+        std::memcpy(&minutes, at + offset, sizeof(minutes));
+
+        FeedingScheduleEntry entry;
+        entry._min = minutes;
+        entry._id = at[offset + 2];
+        entry._dose = at[offset + 3];
+        entry._enabled = (at[offset + 4] != 0);
+
+        if (!value.push_back(entry))
+        {
+            return false;           // More entries than the schedule holds
+        }
+    }
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+//! Appends the fields in CONFIG_FIELDS order
+struct Writer
+{
+    uint8_t* record;
+    size_t capacity;
+    size_t fixedOffset;         //!< Next fixed field
+    size_t length;              //!< End of the TLV area
+    uint8_t tag = 0;            //!< Of the next variable field
+
+    template <typename T>
+    bool Put(const T& value)
+    {
+        if constexpr (IS_VARIABLE<T>)
+        {
+            // Written even when empty, so that the tags keep their order
+            if (capacity - length < TLV_HEADER_SIZE)
+            {
+                return false;
+            }
+
+            const size_t room = std::min<size_t>(capacity - length - TLV_HEADER_SIZE, UINT8_MAX);
+            const int valueLength = PutVariable(record + length + TLV_HEADER_SIZE, room, value);
+            if (valueLength < 0)
+            {
+                return false;
+            }
+
+            record[length] = tag++;
+            record[length + 1] = static_cast<uint8_t>(valueLength);
+            length += TLV_HEADER_SIZE + valueLength;
+        }
+        else
+        {
+            PutFixed(record + fixedOffset, value);
+            fixedOffset += FIXED_SIZE<T>;
+        }
+        return true;
+    }
+};
+
+//-----------------------------------------------------------------------------
+//! Reads the field if it is a fixed one the record holds, and moves 'offset' past it
+template <typename T>
+static void ReadFixed(const uint8_t* fixed, size_t fixedSize, size_t& offset, T& value)
+{
+    if constexpr (!IS_VARIABLE<T>)
+    {
+        if (offset + FIXED_SIZE<T> <= fixedSize)
+        {
+            GetFixed(fixed + offset, value);
+        }
+        offset += FIXED_SIZE<T>;
+    }
+}
+
+//-----------------------------------------------------------------------------
+//! Reads the TLV value if the field is the variable one with tag 'tlvTag'; 'tag' counts the variable fields
+template <typename T>
+static bool ReadVariable(const uint8_t* value, size_t length, uint8_t tlvTag, uint8_t& tag, T& field)
+{
+    if constexpr (IS_VARIABLE<T>)
+    {
+        if (tag++ == tlvTag)
+        {
+            return GetVariable(value, length, field);
+        }
+    }
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+size_t ConfigRecord::Encode(const MemoryConfigData& config, uint16_t sequence, uint8_t* record, size_t capacity)
+{
+    if (capacity < sizeof(RecordHeader) + FIXED_FIELDS_SIZE)
+    {
+        return 0;
+    }
+
+    Writer writer{ record, capacity, sizeof(RecordHeader), sizeof(RecordHeader) + FIXED_FIELDS_SIZE };
+    bool fits = true;
+
+    #define X(type, id, name, key, def) fits = fits && writer.Put(config.name);
+    CONFIG_FIELDS
+    #undef X
+
+    if (!fits)
+    {
+        return 0;
+    }
+
+    RecordHeader header = {};
+    header.magic = RECORD_MAGIC;
+    header.version = FORMAT_VERSION;
+    header.fixedSize = static_cast<uint16_t>(FIXED_FIELDS_SIZE);
+    header.length = static_cast<uint16_t>(writer.length);
+    header.sequence = sequence;
+    std::memcpy(record, &header, sizeof(header));
+
+    header.crc = RecordCrc(record, writer.length);
+    std::memcpy(record, &header, sizeof(header));
+
+    return writer.length;
+}
+
+//-----------------------------------------------------------------------------
+bool ConfigRecord::ReadHeader(const uint8_t* record, uint16_t& sequence, size_t& length)
+{
+    RecordHeader header;
+    std::memcpy(&header, record, sizeof(header));
+
+    if (header.magic != RECORD_MAGIC || header.version != FORMAT_VERSION ||
+        header.length < sizeof(RecordHeader) + header.fixedSize)
+    {
+        return false;
+    }
+
+    sequence = header.sequence;
+    length = header.length;
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+size_t ConfigRecord::Decode(const uint8_t* record, size_t available, MemoryConfigData& config)
+{
+    if (available < sizeof(RecordHeader))
+    {
+        return 0;
+    }
+
+    RecordHeader header;
+    std::memcpy(&header, record, sizeof(header));
+
+    uint16_t sequence = 0;
+    size_t length = 0;
+    if (!ReadHeader(record, sequence, length) || length > available || header.crc != RecordCrc(record, length))
+    {
+        return 0;
+    }
+
+    MemoryConfigData decoded = config;
+
+    // Fixed fields past the end of an older record keep their value
+    const uint8_t* fixed = record + sizeof(RecordHeader);
+    size_t offset = 0;
+
+    #define X(type, id, name, key, def) ReadFixed(fixed, header.fixedSize, offset, decoded.name);
+    CONFIG_FIELDS
+    #undef X
+
+    size_t position = sizeof(RecordHeader) + header.fixedSize;
+    while (position < header.length)
+    {
+        if (header.length - position < TLV_HEADER_SIZE || header.length - position - TLV_HEADER_SIZE < record[position + 1])
+        {
+            return 0;
+        }
+
+        const uint8_t tlvTag = record[position];
+        const uint8_t* value = record + position + TLV_HEADER_SIZE;
+        const size_t valueLength = record[position + 1];
+        uint8_t tag = 0;
+        bool valid = true;
+
+        // Tags this version does not know are skipped
+        #define X(type, id, name, key, def) valid = valid && ReadVariable(value, valueLength, tlvTag, tag, decoded.name);
+        CONFIG_FIELDS
+        #undef X
+
+        if (!valid)
+        {
+            return 0;
+        }
+        position += TLV_HEADER_SIZE + valueLength;
+    }
+
+    config = std::move(decoded);
+    return header.length;
+}
+
+} // namespace Services
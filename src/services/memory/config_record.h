@@ -0,0 +1,66 @@
+/*!****************************************************************************
+ * @file    config_record.h
+ * @brief   Binary EEPROM layout of MemoryConfigData: a header with a CRC,
+ *          then the fixed-size fields (numbers and flags) at fixed offsets,
+ *          then a TLV area for the variable ones (strings, the feeding
+ *          schedule). A field keeps its bytes from one save to the next
+ *          unless its value changes, so StorageService only rewrites the
+ *          EEPROM pages that differ. The header is enough to find the
+ *          records in the EEPROM and order them by sequence number.
+ *
+ *          Compatibility: a fixed field's offset, or a variable field's
+ *          tag, is its position among the fields of its kind in
+ *          CONFIG_FIELDS. New fields go at the end of the list (older
+ *          records then load them as defaults); moving or removing one
+ *          needs a new FORMAT_VERSION.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#pragma once
+
+#include "src/services/memory/memory_config_data.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace Services {
+
+class ConfigRecord
+{
+    public:
+
+        static constexpr uint8_t FORMAT_VERSION = 1;
+        static constexpr size_t HEADER_SIZE = 16;           //!< Holds the CRC: changes with any field
+
+        /**
+         * @brief Lays the config out as a record.
+         * @param sequence Save counter, see IsNewer().
+         * @return size_t Record length, 0 if it does not fit 'capacity' (or a string is over 255 bytes).
+         */
+        static size_t Encode(const MemoryConfigData& config, uint16_t sequence, uint8_t* record, size_t capacity);
+
+        /**
+         * @brief Reads the header of a record (its first HEADER_SIZE bytes), without the CRC check.
+         * @return true if it looks like the header of a record of this version.
+         */
+        static bool ReadHeader(const uint8_t* record, uint16_t& sequence, size_t& length);
+
+        /**
+         * @brief Compares sequence numbers across their wrap (valid while the two are
+         *        less than 32768 saves apart).
+         */
+        static bool IsNewer(uint16_t sequence, uint16_t than)
+        {
+            return static_cast<int16_t>(static_cast<uint16_t>(sequence - than)) > 0;
+        }
+
+        /**
+         * @brief Checks a record (magic, version, length, CRC) and reads it into 'config'.
+         *        Fields the record does not hold keep their value.
+         * @param available Bytes readable at 'record'.
+         * @return size_t Record length, 0 if it is not a valid record ('config' is then untouched).
+         */
+        static size_t Decode(const uint8_t* record, size_t available, MemoryConfigData& config);
+};
+
+} // namespace Services
@@ -8,8 +8,11 @@
 #include "src/services/memory/eeprom_memory.h"
 
 #include "framework/common_defs.h"
+#include "framework/os/trace.h"
 #include "include/config.h"
-#include <vector>
+#include "esp_timer.h"
+#include <algorithm>
+#include <cstring>
 
 namespace Services {
 
@@ -52,23 +55,23 @@ bool EepromMemory::WriteBytes(uint16_t address, const uint8_t* data, size_t leng
 //-----------------------------------------------------------------------------
 bool EepromMemory::ReadBytes(uint16_t address, uint8_t* buffer, size_t length)
 {
+    CORE_TRACE_SCOPE("EepromRead");
+
     if (address + length > EEPROM_SIZE_BYTES)
     {
         CORE_ERROR("Read out of bounds");
         return false;
     }
 
-    uint8_t addrPtr[2];
-    addrPtr[0] = (address >> 8) & 0xFF;
-    addrPtr[1] = address & 0xFF;
-
-    if (!_i2c.Write(addrPtr, 2))
+    if (!WaitForWriteCompletion())
     {
-        CORE_ERROR("Failed to set read address");
         return false;
     }
 
-    if (!_i2c.Read(buffer, length))
+    const uint8_t addrPtr[ADDRESS_SIZE] = { static_cast<uint8_t>(address >> 8), static_cast<uint8_t>(address & 0xFF) };
+
+    // Address and data in one transfer (repeated start)
+    if (!_i2c.WriteRead(addrPtr, sizeof(addrPtr), buffer, length))
     {
         CORE_ERROR("Failed to read data");
         return false;
@@ -76,27 +79,60 @@ bool EepromMemory::ReadBytes(uint16_t address, uint8_t* buffer, size_t length)
     return true;
 }
 
+//-----------------------------------------------------------------------------
+bool EepromMemory::WaitForWriteCompletion()
+{
+    if (!_writeInProgress)
+    {
+        return true;
+    }
+
+    CORE_TRACE_SCOPE("EepromAckPoll");
+
+    // The device does not ACK its address until the write cycle is over
+    const int64_t startUs = esp_timer_get_time();
+    while (!_i2c.Probe())
+    {
+        if (esp_timer_get_time() - startUs > Config::EEPROM_WRITE_TIMEOUT_MS * 1000)
+        {
+            CORE_ERROR("EEPROM write cycle timeout");
+            return false;
+        }
+        taskYIELD();
+    }
+
+    _writeInProgress = false;
+    return true;
+}
+
 //----private------------------------------------------------------------------
 bool EepromMemory::WritePageInternal(uint16_t memAddress, const uint8_t* data, size_t length)
 {
-    std::vector<uint8_t> buffer(2 + length);
-    buffer[0] = (memAddress >> 8) & 0xFF;
-    buffer[1] = memAddress & 0xFF;
-    memcpy(&buffer[2], data, length);
+    CORE_TRACE_SCOPE("EepromWritePage");
+
+    if (!WaitForWriteCompletion())
+    {
+        return false;
+    }
+
+    uint8_t frame[ADDRESS_SIZE + BYTES_PER_PAGE];
+    frame[0] = (memAddress >> 8) & 0xFF;
+    frame[1] = memAddress & 0xFF;
+    memcpy(&frame[ADDRESS_SIZE], data, length);
 
-    if (!_i2c.Write(buffer.data(), buffer.size()))
+    if (!_i2c.Write(frame, ADDRESS_SIZE + length))
     {
         CORE_ERROR("Write failed");
         return false;
     }
 
-    TaskDelayMs(10);
+    _writeInProgress = true;
     return true;
 }
 
 //----private------------------------------------------------------------------
 EepromMemory::EepromMemory()
-    : _i2c(Config::I2C_SDA_PIN, Config::I2C_SCL_PIN, Config::EEPROM_I2C_ADDRESS)
+    : _i2c(Config::I2C_SDA_PIN, Config::I2C_SCL_PIN, Config::EEPROM_I2C_ADDRESS, I2C_NUM_0, Config::EEPROM_I2C_FREQ_HZ)
 {}
 
 } // namespace Services
@@ -19,8 +19,13 @@ class EepromMemory : public Base::Singleton<EepromMemory>,
 {
     public:
 
+        static constexpr size_t EEPROM_SIZE_BYTES = 4096; // Total EEPROM size in bytes (e.g., 32Kb = 4096B)
+        static constexpr size_t BYTES_PER_PAGE = 32;      // EEPROM page size in bytes: one write cycle each
+
         /**
          * @brief Write bytes to the EEPROM starting at the specified memory address.
+         *        Returns once the device has taken the last page: its write cycle runs on
+         *        while the caller goes on, and the next access waits for it to end.
          * @param address    Memory address to start writing to (0 to EEPROM_SIZE_BYTES-1).
          * @param data       Pointer to the data to write.
          * @param length     Number of bytes to write.
@@ -37,6 +42,13 @@ class EepromMemory : public Base::Singleton<EepromMemory>,
         */
         bool ReadBytes(uint16_t address, uint8_t* buffer, size_t length);
 
+        /**
+         * @brief Wait for the write cycle of the last page written, if it is still running
+         *        (e.g. before a restart).
+         * @return true once the device answers again, false on timeout.
+        */
+        bool WaitForWriteCompletion();
+
     protected:
 
         friend class Base::Singleton<EepromMemory>;
@@ -63,7 +75,7 @@ class EepromMemory : public Base::Singleton<EepromMemory>,
     private:
     
         /*!
-         * @brief Write a full page to the EEPROM.
+         * @brief Write up to a page to the EEPROM, without waiting for its write cycle.
          * @param pageAddress   Page address to write to.
          * @param data          Pointer to the data to write.
          * @param length        Number of bytes to write.
@@ -80,14 +92,14 @@ class EepromMemory : public Base::Singleton<EepromMemory>,
 
         //---------------------------------------------
         
-        static constexpr size_t EEPROM_SIZE_BYTES = 4096; // Total EEPROM size in bytes (e.g., 32Kb = 4096B)
-        static constexpr size_t BYTES_PER_PAGE = 32;      // EEPROM page size in bytes
         static constexpr size_t NUM_PAGES = (EEPROM_SIZE_BYTES / BYTES_PER_PAGE);        // Total number of pages
         static constexpr size_t ENDL_CHAR = 0x00;       // Null terminator for strings
+        static constexpr size_t ADDRESS_SIZE = 2;       // Memory address sent before the data, MSB first
 
         //---------------------------------------------
 
         I2C _i2c;
+        bool _writeInProgress = false;                  // The device may still be programming the last page
 };
 
 } // namespace Services
@@ -8,9 +8,11 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <type_traits>
-#include "lib/nlohmann_json/json.hpp"
 #include "framework/common_defs.h"
+#include "framework/memory/arena_json.h"
+#include "framework/memory/static_vector.h"
 
 namespace Services {
 
@@ -28,12 +30,16 @@ struct FeedingScheduleEntry
     }
 };
 
-using FeeddingScheduleList = std::vector<FeedingScheduleEntry>;
+static constexpr size_t MAX_FEEDING_SCHEDULE_ENTRIES = 10;     //!< Feeding slots 0-9
+
+//! Inline: a copy of the schedule never allocates
+using FeeddingScheduleList = Memory::StaticVector<FeedingScheduleEntry, MAX_FEEDING_SCHEDULE_ENTRIES>;
 
 //-----------------------------------------------------------------------------
-inline void to_json(nlohmann::json& j, const FeedingScheduleEntry& e) 
+template<typename BasicJsonType>
+inline void to_json(BasicJsonType& j, const FeedingScheduleEntry& e) 
 {
-    j = nlohmann::json
+    j = BasicJsonType
     {
         {"_min", e._min},
         {"_id", e._id},
@@ -43,7 +49,8 @@ inline void to_json(nlohmann::json& j, const FeedingScheduleEntry& e)
 }
 
 //-----------------------------------------------------------------------------
-inline void from_json(const nlohmann::json& j, FeedingScheduleEntry& e)
+template<typename BasicJsonType>
+inline void from_json(const BasicJsonType& j, FeedingScheduleEntry& e)
 {
     e._min = j.value("_min", 0);
     e._id = j.value("_id", 0);
@@ -63,6 +70,10 @@ inline void from_json(const nlohmann::json& j, FeedingScheduleEntry& e)
     X(bool,                 TDS_MIN_ENABLED,  _tdsLimitMinEnabled,  "tdsMinEn", false)     \
     X(int,                  TDS_MAX,          _tdsLimitMax,         "tdsMax",   500)       \
     X(bool,                 TDS_MAX_ENABLED,  _tdsLimitMaxEnabled,  "tdsMaxEn", false)     \
+    X(bool,                 TREND_ENABLED,    _trendEnabled,        "trEn",     true)      \
+    X(float,                TEMP_RATE_LIMIT,  _tempRateLimit,       "tRate",    2.0f)      \
+    X(int,                  TDS_RATE_LIMIT,   _tdsRateLimit,        "tdsRate",  100)       \
+    X(float,                SPIKE_Z_SCORE,    _spikeZScore,         "spikeZ",   5.0f)      \
     X(FeeddingScheduleList, FEEDING_SCHEDULE, _feedingSchedule,     "feedSch",  {})
 
 enum class FieldId 
@@ -75,14 +86,14 @@ enum class FieldId
 
 struct MemoryConfigData
 {
-    using Json = nlohmann::json;
+    using Json = Memory::ArenaJson;
 
     #define X(type, id, name, key, def) type name = def;
     CONFIG_FIELDS
     #undef X
 
-    //! Serialization to JSON string
-    auto ToJson() const -> std::string
+    //! Serialization to JSON string, built with the arena of the current ArenaScope
+    auto Serialize() const -> Memory::ArenaString
     {
         Json j;
         #define X(type, id, name, key, def) j[key] = name;
@@ -91,8 +102,15 @@ struct MemoryConfigData
         return j.dump(-1);
     }
 
+    //! Serialization to JSON string
+    auto ToJson() const -> std::string
+    {
+        const auto json = Serialize();
+        return std::string(json.data(), json.size());
+    }
+
     //! Deserialization from JSON string
-    auto FromJson(const std::string& jsonString) -> bool
+    auto FromJson(std::string_view jsonString) -> bool
     {
         if (jsonString.empty())
             return false;
@@ -104,6 +122,17 @@ struct MemoryConfigData
             return false;
         }
 
+        // A schedule longer than the list holds fails the load before any field changes
+        #define X(T, id, name, key, def) \
+            if (std::is_same<T, FeeddingScheduleList>::value && j.contains(key) && j[key].is_array() && \
+                j[key].size() > FeeddingScheduleList::CAPACITY) { \
+                CORE_ERROR("Config: '%s' has more entries than fit. Using defaults.", key); \
+                return false; \
+            }
+
+        CONFIG_FIELDS
+        #undef X
+
         #define X(T, id, name, key, def) \
             if (j.contains(key)) { \
                 if (std::is_same<T, FeeddingScheduleList>::value && j[key].is_array()) { \
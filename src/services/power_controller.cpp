@@ -15,6 +15,24 @@ namespace Services {
 //----private------------------------------------------------------------------
 bool PowerController::OnInit()
 {
+    auto* sampler = AdcSampler::GetInstance();
+
+    _batteryChannel = sampler->AddChannel(Config::BATTERY_ADC_PIN);
+    if (_batteryChannel == AdcSampler::INVALID_CHANNEL)
+    {
+        return false;
+    }
+
+    for (uint32_t waitedMs = 0; !sampler->HasReading(_batteryChannel); ++waitedMs)
+    {
+        if (waitedMs >= FIRST_SAMPLE_TIMEOUT_MS)
+        {
+            CORE_WARNING("No battery sample after %u ms", static_cast<unsigned>(FIRST_SAMPLE_TIMEOUT_MS));
+            break;
+        }
+        TaskDelayMs(1);
+    }
+
     return true;
 }
 
@@ -32,8 +50,7 @@ auto PowerController::GetCurrentMode() -> Mode
 //-----------------------------------------------------------------------------
 auto PowerController::GetBatteryLevel() -> BatteryLevel
 {
-    // Read battery voltage
-    const float voltage = _batteryVoltagePin.ReadVoltage(64) * VOLTAGE_MULTIPLIER;
+    const float voltage = ReadSupplyVoltage();
 
     CORE_INFO("Battery voltage: %.2f V", voltage);
 
@@ -57,9 +74,21 @@ auto PowerController::GetBatteryLevel() -> BatteryLevel
     return BatteryLevel::LEVEL_CRITICAL;
 }
 
+//-----------------------------------------------------------------------------
+float PowerController::ReadSupplyVoltage() const
+{
+    return AdcSampler::GetInstance()->ReadVoltage(_batteryChannel) * VOLTAGE_MULTIPLIER;
+}
+
+//-----------------------------------------------------------------------------
+bool PowerController::HasSupplyReading() const
+{
+    return AdcSampler::GetInstance()->HasReading(_batteryChannel);
+}
+
 //----private------------------------------------------------------------------
 PowerController::PowerController()
-    : _batteryVoltagePin(Config::BATTERY_ADC_PIN)
+    : _batteryChannel(AdcSampler::INVALID_CHANNEL)
     , _usbDetectPin(Config::USB_DETECT_PIN, DigitalInOut::INPUT_MODE)
 {
 }
@@ -9,6 +9,7 @@
 
 #include "framework/common_defs.h"
 #include "src/core/base/service.h"
+#include "src/services/adc_sampler.h"
 
 namespace Services {
 
@@ -46,6 +47,18 @@ class PowerController : public Base::Singleton<PowerController>
          */
         auto GetBatteryLevel() -> BatteryLevel;
 
+        /**
+         * @brief Latest battery (supply) voltage, oversampled in the background by the AdcSampler.
+         * @return float Voltage in volts.
+         */
+        float ReadSupplyVoltage() const;
+
+        /**
+         * @brief Whether ReadSupplyVoltage() has a conversion behind it: false before Init()
+         *        and until the AdcSampler has the first value of the channel.
+         */
+        bool HasSupplyReading() const;
+
     protected:
 
         friend class Base::Singleton<PowerController>;
@@ -58,8 +71,9 @@ class PowerController : public Base::Singleton<PowerController>
 
         /*!
          * @brief Initializes the Module.
-         *        This method should be called once at the start of the application.
-         *       * @return bool True if initialization successful, false otherwise.
+         *        Registers the battery channel and waits for its first sample,
+         *        so the boot settling and the first battery level see a real voltage.
+         * @return bool True if initialization successful, false otherwise.
          */
         bool OnInit() override;
 
@@ -73,9 +87,10 @@ class PowerController : public Base::Singleton<PowerController>
         //---------------------------------------------
 
         static constexpr float VOLTAGE_MULTIPLIER = 2.0f;
+        static constexpr uint32_t FIRST_SAMPLE_TIMEOUT_MS = 50;
         //---------------------------------------------
 
-        AnalogIn _batteryVoltagePin;
+        Services::AdcSampler::ChannelId _batteryChannel;
         DigitalInOut _usbDetectPin;
 
 };
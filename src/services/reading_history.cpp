@@ -0,0 +1,106 @@
+/*!****************************************************************************
+ * @file    reading_history.cpp
+ * @brief   Implementation of the ReadingHistory service.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ *******************************************************************************/
+
+#include "src/services/reading_history.h"
+
+#include <cmath>
+#include <ctime>
+
+namespace Services {
+
+//-----------------------------------------------------------------------------
+ReadingHistory::Values ReadingHistory::ToValues(float temperature, int tds, float batteryVolts)
+{
+    return Values
+    {
+        static_cast<int32_t>(std::lround(temperature * SCALE[static_cast<size_t>(Series::TEMPERATURE)])),
+        static_cast<int32_t>(tds),
+        static_cast<int32_t>(std::lround(batteryVolts * SCALE[static_cast<size_t>(Series::BATTERY)]))
+    };
+}
+
+//-----------------------------------------------------------------------------
+void ReadingHistory::Record(const Values& values)
+{
+    if (_mutex == nullptr)
+    {
+        return;
+    }
+
+    const uint32_t now = static_cast<uint32_t>(time(nullptr));
+
+    const bool clockSet = (now >= Config::HISTORY_MIN_VALID_TIMESTAMP);
+
+    xSemaphoreTake(_mutex, portMAX_DELAY);
+
+    // Boot-relative timestamps would read as 1970 next to the real ones
+    if (clockSet && _holdsUnsetClock)
+    {
+        CORE_INFO("Wall clock set, reading history restarted");
+        _store.Clear();
+    }
+    _holdsUnsetClock = !clockSet;
+
+    if (!_store.Append(now, values))
+    {
+        CORE_WARNING("Clock went backwards, reading history cleared");
+        _store.Clear();
+        _store.Append(now, values);
+    }
+
+    xSemaphoreGive(_mutex);
+}
+
+//-----------------------------------------------------------------------------
+uint32_t ReadingHistory::GetOldestRawTimestamp() const
+{
+    if (_mutex == nullptr)
+    {
+        return 0;
+    }
+
+    xSemaphoreTake(_mutex, portMAX_DELAY);
+    const uint32_t oldest = _store.GetOldestRawTimestamp();
+    xSemaphoreGive(_mutex);
+    return oldest;
+}
+
+//-----------------------------------------------------------------------------
+uint32_t ReadingHistory::GetOldestBucketStart(Tier tier) const
+{
+    if (_mutex == nullptr)
+    {
+        return 0;
+    }
+
+    xSemaphoreTake(_mutex, portMAX_DELAY);
+    const uint32_t oldest = _store.GetOldestBucketStart(tier);
+    xSemaphoreGive(_mutex);
+    return oldest;
+}
+
+//-----------------------------------------------------------------------------
+float ReadingHistory::ToReading(Series series, int32_t value)
+{
+    return static_cast<float>(value) / SCALE[static_cast<size_t>(series)];
+}
+
+//----private------------------------------------------------------------------
+bool ReadingHistory::OnInit()
+{
+    _mutex = xSemaphoreCreateMutex();
+    if (_mutex == nullptr)
+    {
+        CORE_ERROR("Failed to create reading history mutex");
+        return false;
+    }
+
+    CORE_INFO("Reading history uses %u bytes", static_cast<unsigned>(sizeof(_store)));
+    return true;
+}
+
+} // namespace Services
@@ -0,0 +1,131 @@
+/*!****************************************************************************
+ * @file    reading_history.h
+ * @brief   In-RAM history of the temperature, TDS and battery readings: the
+ *          recent raw records bit-packed plus minute and hour min/max/avg
+ *          (see framework/timeseries/time_series_store.h). Values are kept
+ *          as integers in fixed units (centi-degrees, ppm, millivolts) and
+ *          timestamps are wall-clock seconds.
+ * @author  Quattrone Martin
+ * @date    Oct 2026
+ ******************************************************************************/
+
+#pragma once
+
+#include "framework/common_defs.h"
+#include "framework/timeseries/time_series_store.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "include/config.h"
+#include "src/core/base/service.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace Services {
+
+class ReadingHistory : public Base::Singleton<ReadingHistory>
+                     , public Base::Service
+{
+    public:
+
+        enum class Series : uint8_t
+        {
+            TEMPERATURE,            //!< 0.01 degC
+            TDS,                    //!< ppm
+            BATTERY,                //!< mV
+            _size
+        };
+
+        static constexpr size_t SERIES_COUNT = static_cast<size_t>(Series::_size);
+
+        using Store = TimeSeries::TimeSeriesStore<SERIES_COUNT, Config::HISTORY_RAW_BYTES,
+                                                  Config::HISTORY_MINUTE_BUCKETS, Config::HISTORY_HOUR_BUCKETS>;
+        using Values = Store::Values;
+        using Row = Store::Row;
+        using Tier = TimeSeries::Tier;
+
+        /**
+         * @brief Readings in the units of the history.
+         */
+        static Values ToValues(float temperature, int tds, float batteryVolts);
+
+        /**
+         * @brief Records one set of readings (see ToValues()) at the current time. O(1).
+         *        A clock set backwards clears the history (it could not be ordered any more),
+         *        and so does the first reading after the wall clock is set.
+         */
+        void Record(const Values& values);
+
+        /**
+         * @brief Visits the raw records with from <= timestamp <= to, oldest first.
+         *        Runs under the history lock: keep the callback short.
+         * @param fn Called as fn(uint32_t timestamp, const Values& values).
+         * @return size_t Records visited.
+         */
+        template <typename Fn>
+        size_t ForEachRaw(uint32_t from, uint32_t to, Fn&& fn) const
+        {
+            xSemaphoreTake(_mutex, portMAX_DELAY);
+            const size_t visited = _store.ForEachRaw(from, to, fn);
+            xSemaphoreGive(_mutex);
+            return visited;
+        }
+
+        /**
+         * @brief Visits the buckets of a tier overlapping [from, to], oldest first,
+         *        the period in progress last. Runs under the history lock.
+         * @param fn Called as fn(const Row& row).
+         * @return size_t Buckets visited.
+         */
+        template <typename Fn>
+        size_t ForEachBucket(Tier tier, uint32_t from, uint32_t to, Fn&& fn) const
+        {
+            xSemaphoreTake(_mutex, portMAX_DELAY);
+            const size_t visited = _store.ForEachBucket(tier, from, to, fn);
+            xSemaphoreGive(_mutex);
+            return visited;
+        }
+
+        //! Oldest timestamp of the raw records (0 when empty)
+        uint32_t GetOldestRawTimestamp() const;
+
+        //! Start of the oldest bucket of a tier (0 when empty)
+        uint32_t GetOldestBucketStart(Tier tier) const;
+
+        /**
+         * @brief Converts a stored value back to the units of the reading (degC, ppm, V).
+         */
+        static float ToReading(Series series, int32_t value);
+
+    protected:
+
+        friend class Base::Singleton<ReadingHistory>;
+
+        /*!
+        * @brief Get the module name.
+        * @return const char* Module name.
+        */
+        const char* GetModuleName() const override { return "ReadingHistory"; }
+
+        /*!
+         * @brief Creates the lock of the store.
+         * @return bool True if initialization successful, false otherwise.
+         */
+        bool OnInit() override;
+
+    private:
+
+        ReadingHistory() = default;
+        ~ReadingHistory() = default;
+        ReadingHistory(const ReadingHistory&) = delete;
+        ReadingHistory& operator=(const ReadingHistory&) = delete;
+
+        // ---------------------------------------------
+
+        static constexpr float SCALE[SERIES_COUNT] = { 100.0f, 1.0f, 1000.0f };
+
+        SemaphoreHandle_t _mutex = nullptr;
+        Store _store;
+        bool _holdsUnsetClock = false;          //!< Records stamped before the wall clock was set
+};
+
+} // namespace Services
@@ -26,9 +26,10 @@ bool RealTimeClock::OnInit()
 auto RealTimeClock::GetTime(Utils::DateTime& time) -> bool
 {
     uint8_t startReg = 0x00;
-    uint8_t buffer[3] = {0};
+    uint8_t buffer[7] = {0};
 
-    if (!_i2c.WriteRead(&startReg, 1, buffer, 3)) 
+    // Seconds, minutes, hours, day of week, date, month (bit 7: century), year
+    if (!_i2c.WriteRead(&startReg, 1, buffer, sizeof(buffer))) 
     {
         CORE_ERROR("Failed to read time");
         return false;
@@ -37,8 +38,12 @@ auto RealTimeClock::GetTime(Utils::DateTime& time) -> bool
     uint8_t seconds = BcdToDec(buffer[0]);
     uint8_t minutes = BcdToDec(buffer[1]);
     uint8_t hours   = BcdToDec(buffer[2]);
+    uint8_t day     = BcdToDec(buffer[4] & 0x3F);
+    uint8_t month   = BcdToDec(buffer[5] & 0x1F);
+    uint8_t year    = BcdToDec(buffer[6]);
 
     time.Set(hours, minutes, seconds);
+    time.SetDate(Utils::DateTime::EPOCH_YEAR + year, month, day);
     
     return true;
 }
@@ -51,11 +56,15 @@ bool RealTimeClock::SetTime(const Utils::DateTime& dateTime)
     uint8_t seconds = dateTime.GetSecond();
 
 
-    uint8_t buffer[4];
+    uint8_t buffer[8];
     buffer[0] = 0x00; // start register
     buffer[1] = DecToBcd(seconds);
     buffer[2] = DecToBcd(minutes);
     buffer[3] = DecToBcd(hours);
+    buffer[4] = DecToBcd(static_cast<uint8_t>(dateTime.GetDayOfWeek() + 1));
+    buffer[5] = DecToBcd(dateTime.GetDay());
+    buffer[6] = DecToBcd(dateTime.GetMonth());
+    buffer[7] = DecToBcd(static_cast<uint8_t>((dateTime.GetYear() - Utils::DateTime::EPOCH_YEAR) % 100));
 
     if (!_i2c.Write(buffer, sizeof(buffer))) 
     {
@@ -63,16 +72,20 @@ bool RealTimeClock::SetTime(const Utils::DateTime& dateTime)
         return false;
     }
 
-    CORE_INFO("Set RTC time to %02u:%02u:%02u", hours, minutes, seconds);
+    CORE_INFO("Set RTC time to %04u-%02u-%02u %02u:%02u:%02u", dateTime.GetYear(), dateTime.GetMonth(), dateTime.GetDay(), hours, minutes, seconds);
     return true;
 }
 
 //-----------------------------------------------------------------------------
 Result RealTimeClock::InitTimeSync(const char* timezone) const
 {
+    // Keeps the stored timezone alive while 'timezone' points into it
+    std::string storedTimezone;
+
     if (timezone == nullptr)
     {
-        timezone = Core::GuardianProxy::GetInstance()->GetTimezoneFromStorage().c_str();
+        storedTimezone = *Core::GuardianProxy::GetInstance()->GetTimezoneFromStorage();
+        timezone = storedTimezone.c_str();
     }
     else
     {
@@ -119,7 +132,10 @@ void RealTimeClock::TimeSyncCallback(struct ::timeval *tv)
     {
         instance->SetTime(
             Utils::DateTime(
-                  static_cast<uint8_t>(timeinfo.tm_hour)
+                  static_cast<uint16_t>(timeinfo.tm_year + 1900)
+                , static_cast<uint8_t>(timeinfo.tm_mon + 1)
+                , static_cast<uint8_t>(timeinfo.tm_mday)
+                , static_cast<uint8_t>(timeinfo.tm_hour)
                 , static_cast<uint8_t>(timeinfo.tm_min)
                 , static_cast<uint8_t>(timeinfo.tm_sec)
             )
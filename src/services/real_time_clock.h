@@ -24,15 +24,15 @@ class RealTimeClock : public Base::Singleton<RealTimeClock>
     public:
 
         /**
-         * @brief Get the current time from the RTC.
-         * @param time    Reference to a DateTime object to store the current time.
+         * @brief Get the current date and time from the RTC.
+         * @param time    Reference to a DateTime object to store the current date and time.
          * @return true if successful, false otherwise.
         */
         auto GetTime(Utils::DateTime& time) -> bool;
 
         /**
-         * @brief Set the current time on the RTC.
-         * @param dateTime   DateTime object with the time to set.
+         * @brief Set the current date and time on the RTC.
+         * @param dateTime   DateTime object with the date and time to set.
          * @return true if success, false otherwise.
         */
         bool SetTime(const Utils::DateTime& dateTime);
@@ -8,7 +8,7 @@
 #include "src/services/storage_service.h"
 
 #include "framework/common_defs.h"
-#include <vector>
+#include <algorithm>
 #include <cstring>
 
 namespace Services {
@@ -18,6 +18,13 @@ bool StorageService::OnInit()
 {
     _eepromMemory = Services::EepromMemory::GetInstance();
 
+    _mutex = xSemaphoreCreateRecursiveMutex();
+    if (_mutex == nullptr)
+    {
+        CORE_ERROR("Failed to create storage mutex");
+        return false;
+    }
+
     if (!LoadConfigInternal())
     {
         CORE_WARNING("Could not load config from EEPROM. Using defaults.");
@@ -26,14 +33,78 @@ bool StorageService::OnInit()
     else
     {
         CORE_INFO("Memory config loaded successfully: %s", _configCache.ToJson().c_str());
+
+        if (!_haveRecord)
+        {
+            CORE_INFO("Converting the stored config to the binary record.");
+            SaveConfigInternal();
+        }
+    }
+
+    BumpGenerations();
+
+    // Only the saves of config changes count (not the ones above)
+    _writeStats = {};
+
+    if (Config::STORAGE_WRITE_BEHIND_MS > 0 &&
+        xTaskCreate(FlushTaskEntry, "StorageFlush", Config::STORAGE_FLUSH_STACK_SIZE, this,
+                    Config::STORAGE_FLUSH_PRIORITY, &_flushTask) != pdPASS)
+    {
+        CORE_ERROR("Failed to create storage flush task");
+        return false;
     }
 
     return true;
 }
 
+//-----------------------------------------------------------------------------
+void StorageService::BeginTransaction()
+{
+    xSemaphoreTakeRecursive(_mutex, portMAX_DELAY);
+    ++_transactionDepth;
+}
+
+//-----------------------------------------------------------------------------
+bool StorageService::Commit()
+{
+    bool success = true;
+
+    if (--_transactionDepth == 0 && _staged)
+    {
+        _staged = false;
+        ++_writeStats.changes;
+
+        if (_flushTask != nullptr)
+        {
+            _dirty = true;
+            xTaskNotifyGive(_flushTask);
+        }
+        else
+        {
+            CORE_INFO("Storage: Config changed. Saving to EEPROM...");
+            success = SaveConfigInternal();
+        }
+    }
+
+    xSemaphoreGiveRecursive(_mutex);
+    return success;
+}
+
+//-----------------------------------------------------------------------------
+StorageService::WriteStats StorageService::GetWriteStats() const
+{
+    xSemaphoreTakeRecursive(_mutex, portMAX_DELAY);
+    const WriteStats stats = _writeStats;
+    xSemaphoreGiveRecursive(_mutex);
+    return stats;
+}
+
 //-----------------------------------------------------------------------------
 bool StorageService::SaveFeedingScheduleInStorage(const int timeMinutesAfterMidnight, const int slotIndex, const int dose, const bool enabled) 
 {
+    // The list is read and written back as one change
+    ConfigTransaction transaction;
+
     auto scheduleList = _configCache._feedingSchedule;
     
     // Find existing entry by slotIndex
@@ -61,19 +132,28 @@ bool StorageService::SaveFeedingScheduleInStorage(const int timeMinutesAfterMidn
         newEntry._id = slotIndex;
         newEntry._dose = dose;
         newEntry._enabled = enabled;
-        scheduleList.push_back(newEntry);
+
+        if (!scheduleList.push_back(newEntry))
+        {
+            CORE_WARNING("Feeding schedule full (%u entries).", static_cast<unsigned>(scheduleList.size()));
+            return false;
+        }
     }
 
     // Save updated schedule back to storage
-    return Set<Services::FeeddingScheduleList>(
+    const bool success = Set<Services::FeeddingScheduleList>(
         Services::FieldId::FEEDING_SCHEDULE,
         scheduleList
     );
+
+    return transaction.Commit() && success;
 }
 
 //-----------------------------------------------------------------------------
 bool StorageService::RemoveFeedingScheduleFromStorage(const int slotIndex) 
 {
+    ConfigTransaction transaction;
+
     auto scheduleList = _configCache._feedingSchedule;
 
     size_t originalSize = scheduleList.size();
@@ -93,10 +173,12 @@ bool StorageService::RemoveFeedingScheduleFromStorage(const int slotIndex)
     {
         CORE_INFO("Removed feeding schedule with slotIndex %d", slotIndex);
         
-        return Set<Services::FeeddingScheduleList>(
+        const bool success = Set<Services::FeeddingScheduleList>(
             Services::FieldId::FEEDING_SCHEDULE,
             scheduleList
         );
+
+        return transaction.Commit() && success;
     }
     else
     {
@@ -108,9 +190,16 @@ bool StorageService::RemoveFeedingScheduleFromStorage(const int slotIndex)
 //-----------------------------------------------------------------------------
 Result StorageService::SetDefaultConfig()
 {
+    xSemaphoreTakeRecursive(_mutex, portMAX_DELAY);
+
     _configCache = MemoryConfigData();
+    BumpGenerations();
+    ++_writeStats.changes;
 
     const bool success = SaveConfigInternal();
+
+    xSemaphoreGiveRecursive(_mutex);
+
     if (success)
     {
         return Result::Success("Factory reset successful. Default config saved.");
@@ -124,36 +213,93 @@ Result StorageService::SetDefaultConfig()
 //----private------------------------------------------------------------------
 bool StorageService::SaveConfigInternal()
 {
-    CORE_INFO("Saving config to EEPROM...");
-    
-    std::string jsonStr = _configCache.ToJson();
+    static_assert(CONFIG_START_ADDR % PAGE_SIZE == 0, "The journal must start on a page");
+    static_assert(2 * MAX_CONFIG_SIZE <= JOURNAL_PAGES * PAGE_SIZE, "A record and the newest one must fit the journal");
 
-    if (jsonStr.length() >= MAX_CONFIG_SIZE)
+    auto buffer = _ioBlocks.Acquire();
+    if (!buffer)
     {
-        CORE_ERROR("Config data too large for buffer (%u > %u)", jsonStr.length(), MAX_CONFIG_SIZE);
+        CORE_ERROR("No buffer available to save config.");
         return false;
     }
 
-    std::vector<uint8_t> buffer(jsonStr.begin(), jsonStr.end());
-    buffer.push_back('\0');
+    uint8_t* record = buffer.Data();
+    const uint16_t sequence = static_cast<uint16_t>(_sequence + 1);
+    const size_t length = ConfigRecord::Encode(_configCache, sequence, record, MAX_CONFIG_SIZE);
+
+    if (length == 0)
+    {
+        CORE_ERROR("Config data too large for the record (max %u bytes, 255 per string)", static_cast<unsigned>(MAX_CONFIG_SIZE));
+        return false;
+    }
+
+    _dirty = false;
+
+    // Right after the newest record, or back at the start if the journal ends first: either way
+    // clear of it, so a power cut during the save leaves it the newest valid one
+    const size_t pageCount = (length + PAGE_SIZE - 1) / PAGE_SIZE;
+    const size_t startPage = (_nextPage + pageCount <= JOURNAL_PAGES) ? _nextPage : 0;
+
+    size_t pagesWritten = 0;
+    size_t bytesWritten = 0;
+    bool success = true;
+
+    // The header page last: until it is written the record is not there
+    for (size_t n = 0; n < pageCount && success; ++n)
+    {
+        const size_t page = (n + 1) % pageCount;
+        const size_t start = page * PAGE_SIZE;
+        const size_t size = std::min(PAGE_SIZE, length - start);
+        const uint16_t address = static_cast<uint16_t>(CONFIG_START_ADDR + (startPage + page) * PAGE_SIZE);
+
+        // Reads cost no wear: only the bytes that differ from what the page holds are written
+        uint8_t current[PAGE_SIZE];
+        if (!_eepromMemory->ReadBytes(address, current, size))
+        {
+            success = false;
+            break;
+        }
+
+        size_t first = size;
+        size_t last = 0;
+        for (size_t i = 0; i < size; ++i)
+        {
+            if (record[start + i] != current[i])
+            {
+                first = std::min(first, i);
+                last = i + 1;
+            }
+        }
+
+        if (first < last)
+        {
+            success = _eepromMemory->WriteBytes(address + first, &record[start + first], last - first);
+            pagesWritten++;
+            bytesWritten += last - first;
+        }
+    }
 
-    bool success = _eepromMemory->WriteBytes(
-        CONFIG_START_ADDR, 
-        buffer.data(), 
-        buffer.size()
-    );
-    
     if (success)
     {
-        CORE_INFO("Config saved.");
-        CORE_INFO("Saved config: %s", jsonStr.c_str());
+        _sequence = sequence;
+        _nextPage = startPage + pageCount;
+        _haveRecord = true;
+
+        ++_writeStats.saves;
+        _writeStats.pagesWritten += pagesWritten;
+        _writeStats.bytesWritten += bytesWritten;
+
+        CORE_INFO("Config saved (record %u at page %u, %u bytes, %u written in %u pages).", static_cast<unsigned>(sequence),
+                  static_cast<unsigned>(startPage), static_cast<unsigned>(length), static_cast<unsigned>(bytesWritten),
+                  static_cast<unsigned>(pagesWritten));
     }
     else
     {
         CORE_ERROR("Failed to write to EEPROM.");
         LoadConfigInternal();
+        BumpGenerations();
     }
-    
+
     return success;
 }
 
@@ -162,23 +308,104 @@ bool StorageService::LoadConfigInternal()
 {
     CORE_INFO("Loading config from EEPROM...");
 
-    std::vector<uint8_t> buffer(MAX_CONFIG_SIZE);
-    if (!_eepromMemory->ReadBytes(CONFIG_START_ADDR, buffer.data(), MAX_CONFIG_SIZE))
+    struct Candidate
+    {
+        uint16_t sequence;
+        uint16_t page;
+    };
+
+    // Every page that starts with a record header: only the header is read
+    Candidate candidates[JOURNAL_PAGES];
+    size_t candidateCount = 0;
+    bool legacyJson = false;
+
+    for (size_t page = 0; page < JOURNAL_PAGES; ++page)
     {
+        uint8_t header[ConfigRecord::HEADER_SIZE];
+        if (!_eepromMemory->ReadBytes(static_cast<uint16_t>(CONFIG_START_ADDR + page * PAGE_SIZE), header, sizeof(header)))
+        {
+            return false;
+        }
+
+        uint16_t sequence = 0;
+        size_t length = 0;
+        if (ConfigRecord::ReadHeader(header, sequence, length) && length <= MAX_CONFIG_SIZE &&
+            page * PAGE_SIZE + length <= JOURNAL_PAGES * PAGE_SIZE)
+        {
+            candidates[candidateCount++] = { sequence, static_cast<uint16_t>(page) };
+        }
+
+        legacyJson = legacyJson || (page == 0 && header[0] == '{');
+    }
+
+    std::sort(candidates, candidates + candidateCount, [](const Candidate& a, const Candidate& b)
+        {
+            return ConfigRecord::IsNewer(a.sequence, b.sequence);
+        }
+    );
+
+    auto buffer = _ioBlocks.Acquire();
+    if (!buffer)
+    {
+        CORE_ERROR("No buffer available to load config.");
         return false;
     }
 
-    buffer.back() = '\0'; 
+    uint8_t* record = buffer.Data();
+
+    // The newest one a power cut left whole
+    for (size_t i = 0; i < candidateCount; ++i)
+    {
+        const size_t page = candidates[i].page;
+        const uint16_t address = static_cast<uint16_t>(CONFIG_START_ADDR + page * PAGE_SIZE);
+
+        uint16_t sequence = 0;
+        size_t length = 0;
+        if (!_eepromMemory->ReadBytes(address, record, ConfigRecord::HEADER_SIZE) ||
+            !ConfigRecord::ReadHeader(record, sequence, length) ||
+            !_eepromMemory->ReadBytes(address, record, length))
+        {
+            return false;
+        }
+
+        if (ConfigRecord::Decode(record, length, _configCache) > 0)
+        {
+            _sequence = sequence;
+            _nextPage = page + (length + PAGE_SIZE - 1) / PAGE_SIZE;
+            _haveRecord = true;
+
+            if (i > 0)
+            {
+                CORE_WARNING("Newest config record is damaged, loaded record %u.", static_cast<unsigned>(sequence));
+            }
+            return true;
+        }
+    }
 
-    std::string jsonStr(reinterpret_cast<char*>(buffer.data()));
+    _haveRecord = false;
+    _nextPage = 0;
 
-    if (jsonStr.empty() || jsonStr[0] == (char)0xFF)
+    if (!legacyJson)
     {
         CORE_INFO("EEPROM appears empty or uninitialized.");
         return false;
     }
 
-    if (_configCache.FromJson(jsonStr))
+    // JSON document of an older firmware, null terminated
+    if (!_eepromMemory->ReadBytes(CONFIG_START_ADDR, record, MAX_CONFIG_SIZE))
+    {
+        return false;
+    }
+
+    const char* jsonStr = reinterpret_cast<const char*>(record);
+    const size_t jsonLength = strnlen(jsonStr, MAX_CONFIG_SIZE);
+
+    // Kept until the first record is complete
+    _nextPage = (jsonLength + 1 + PAGE_SIZE - 1) / PAGE_SIZE;
+
+    Memory::ArenaScope scope(_scratchArena);
+
+    if (_configCache.FromJson(std::string_view(jsonStr, jsonLength)))
     {
         return true;
     }
@@ -189,4 +416,40 @@ bool StorageService::LoadConfigInternal()
     }
 }
 
-} // namespace Services
\ No newline at end of file
+//----private------------------------------------------------------------------
+void StorageService::BumpGenerations()
+{
+    for (uint32_t& generation : _generations)
+    {
+        generation = NextGeneration(generation);
+    }
+}
+
+//----private------------------------------------------------------------------
+void StorageService::FlushTaskEntry(void* arg)
+{
+    static_cast<StorageService*>(arg)->RunFlushTask();
+}
+
+//----private------------------------------------------------------------------
+void StorageService::RunFlushTask()
+{
+    while (true)
+    {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        // Changes made during the window join this save; their notifications are dropped
+        vTaskDelay(pdMS_TO_TICKS(Config::STORAGE_WRITE_BEHIND_MS));
+        ulTaskNotifyTake(pdTRUE, 0);
+
+        xSemaphoreTakeRecursive(_mutex, portMAX_DELAY);
+        if (_dirty)
+        {
+            CORE_INFO("Storage: Saving the changes of the last %u ms to EEPROM...", static_cast<unsigned>(Config::STORAGE_WRITE_BEHIND_MS));
+            SaveConfigInternal();
+        }
+        xSemaphoreGiveRecursive(_mutex);
+    }
+}
+
+} // namespace Services
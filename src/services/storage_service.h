@@ -8,21 +8,107 @@
 #pragma once
 
 #include "framework/common_defs.h"
-#include "lib/nlohmann_json/json.hpp"
+#include "framework/memory/arena.h"
+#include "framework/memory/block_pool.h"
+#include "include/config.h"
 #include "src/core/base/service.h"
+#include "src/services/memory/config_record.h"
 #include "src/services/memory/eeprom_memory.h"
 #include "src/services/memory/memory_config_data.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
 #include <cstdint>
 #include <string>
+#include <type_traits>
+#include <utility>
 
 namespace Services {
 
+/*!
+ * @brief Read access to a config field without a copy: the field is referenced in the
+ *        cache and the StorageService lock is held while the view lives, so keep it short.
+ *        The generation changes with every change of the field; a consumer can keep data
+ *        derived from the field and only recompute it when the generation differs.
+ */
+template <typename T>
+class ConfigView
+{
+    public:
+
+        ~ConfigView()
+        {
+            if (_mutex != nullptr)
+            {
+                xSemaphoreGiveRecursive(_mutex);
+            }
+        }
+
+        ConfigView(ConfigView&& other) noexcept
+            : _mutex(other._mutex)
+            , _value(other._value)
+            , _generation(other._generation)
+        {
+            other._mutex = nullptr;
+        }
+
+        ConfigView(const ConfigView&) = delete;
+        ConfigView& operator=(const ConfigView&) = delete;
+        ConfigView& operator=(ConfigView&&) = delete;
+
+        const T& operator*() const { return *_value; }
+        const T* operator->() const { return _value; }
+
+        //! Never 0, so 0 can stand for "nothing derived yet"
+        uint32_t GetGeneration() const { return _generation; }
+
+    private:
+
+        friend class StorageService;
+
+        //! Takes over the lock the caller holds
+        ConfigView(SemaphoreHandle_t mutex, const T* value, uint32_t generation)
+            : _mutex(mutex)
+            , _value(value)
+            , _generation(generation)
+        {}
+
+        SemaphoreHandle_t _mutex;
+        const T* _value;
+        uint32_t _generation;
+};
+
 class StorageService : public Base::Singleton<StorageService>
                      , public Base::Service
 {
-    using Json = nlohmann::json;
    
     public:
+
+        //! EEPROM cost of the config changes since boot
+        struct WriteStats
+        {
+            uint32_t changes;           //!< Logical changes: a Set outside a transaction, or a transaction
+            uint32_t saves;             //!< Records written (several changes can share one with write-behind)
+            uint32_t pagesWritten;
+            uint32_t bytesWritten;
+        };
+
+        /*!
+         * @brief Start a transaction: the Sets that follow only change the cache, and are
+         *        saved together by the matching Commit(). Transactions nest (the outermost
+         *        Commit saves) and hold the config for the calling task until then.
+        */
+        void BeginTransaction();
+
+        /*!
+         * @brief End a transaction, saving its changes if it is the outermost one.
+         *        With write-behind (Config::STORAGE_WRITE_BEHIND_MS) the save is only scheduled.
+         * @return true if the changes are saved (or scheduled), false if the EEPROM write
+         *         failed: the cache is then reloaded from the EEPROM.
+        */
+        bool Commit();
+
+        WriteStats GetWriteStats() const;
         
         /*!
          * @brief Save a feeding schedule entry in storage.
@@ -49,24 +135,45 @@ class StorageService : public Base::Singleton<StorageService>
         Result SetDefaultConfig();
 
         /*!
-         * @brief Get the value of a configuration field.
+         * @brief Get a copy of the value of a configuration field.
          * @tparam T Type of the field to get.        
         */
         template<typename T>
         T Get(FieldId fieldId) const
         {
+            return *View<T>(fieldId);
+        }
+
+        /*!
+         * @brief Read a configuration field in place, with its generation (see ConfigView).
+         * @tparam T Type of the field to view.
+        */
+        template<typename T>
+        ConfigView<T> View(FieldId fieldId) const
+        {
+            xSemaphoreTakeRecursive(_mutex, portMAX_DELAY);
+
+            // Only the field of type T is referenced: a mismatched type gets the empty value
             switch (fieldId)
             {
                 #define X(type, id, name, key, def) \
-                    case FieldId::id: return *reinterpret_cast<const T*>(&_configCache.name);
+                    case FieldId::id: \
+                        if constexpr (std::is_same_v<T, type>) \
+                        { \
+                            return ConfigView<T>(_mutex, &_configCache.name, _generations[static_cast<size_t>(fieldId)]); \
+                        } \
+                        break;
 
                 CONFIG_FIELDS
                 #undef X
 
                 default:
-                    CORE_ERROR("Invalid FieldId in Get operation");
-                    return T{};
+                    break;
             }
+
+            CORE_ERROR("Invalid FieldId or type in View operation");
+            static const T EMPTY{};
+            return ConfigView<T>(_mutex, &EMPTY, 1);
         }
 
         /*!
@@ -76,34 +183,34 @@ class StorageService : public Base::Singleton<StorageService>
         template<typename T>
         bool Set(FieldId fieldId, T newValue)
         {
-            bool changed = false;
+            BeginTransaction();
+
+            // Only the field of type T is touched: a mismatched type is rejected like an invalid id
             switch (fieldId) 
             {
                 #define X(type, id, name, key, def) \
                     case FieldId::id: \
-                        if (*reinterpret_cast<const T*>(&_configCache.name) != newValue) \
+                        if constexpr (std::is_same_v<T, type>) \
                         { \
-                            *reinterpret_cast<T*>(&_configCache.name) = newValue; \
-                            changed = true; \
+                            if (_configCache.name != newValue) \
+                            { \
+                                _configCache.name = std::move(newValue); \
+                                _generations[static_cast<size_t>(FieldId::id)] = NextGeneration(_generations[static_cast<size_t>(FieldId::id)]); \
+                                _staged = true; \
+                            } \
+                            return Commit(); \
                         } \
                         break;
 
                 CONFIG_FIELDS
                 #undef X
                 default:
-                    CORE_ERROR("Invalid FieldId in Set operation");
-                    return false;
+                    break;
             }
 
-            if (changed) 
-            {
-                CORE_INFO("Storage: Field changed. Saving to EEPROM...");
-                return SaveConfigInternal();
-            }
-            else
-            {
-                return true;
-            }
+            CORE_ERROR("Invalid FieldId or type in Set operation");
+            Commit();
+            return false;
         }
     
     private:
@@ -124,33 +231,104 @@ class StorageService : public Base::Singleton<StorageService>
         bool OnInit() override;
 
         /*!
-            * @brief Save configuration data to EEPROM.
+            * @brief Save configuration data to EEPROM as a ConfigRecord, appended to the
+            *        journal after the newest record (which stays intact until the new one
+            *        is complete). The header page is written last and the pages that
+            *        already hold the right bytes are skipped.
             * @return true if success, false otherwise.
         */
         bool SaveConfigInternal();
 
         /*!
-            * @brief Load configuration data from EEPROM.
+            * @brief Load configuration data from EEPROM: the newest valid ConfigRecord of the
+            *        journal (found by its page headers), or the JSON document older firmware
+            *        wrote at the start (converted by the next save).
             * @return true if success, false otherwise.
         */
         bool LoadConfigInternal();
 
+        /*!
+         * @brief Write-behind task: saves the config a window after the first change
+         *        of a burst, so that the whole burst costs one save.
+        */
+        static void FlushTaskEntry(void* arg);
+        void RunFlushTask();
+
+        //! The whole cache was replaced (load, factory reset): every view generation moves on
+        void BumpGenerations();
+
+        //! Generation after 'generation', wrapping past 0: 0 is never handed out
+        static uint32_t NextGeneration(uint32_t generation) { return (generation == UINT32_MAX) ? 1 : generation + 1; }
+
         //---------------------------------------------
 
-        StorageService() {}
+        StorageService()
+            : _scratchArena("storage")
+        {}
         ~StorageService() = default;
         StorageService(const StorageService&) = delete;
         StorageService& operator=(const StorageService&) = delete;
 
         //---------------------------------------------
 
+        // The journal: records start on a page and rotate through the whole EEPROM
         static constexpr uint16_t CONFIG_START_ADDR = 0x0000;
+        static constexpr size_t PAGE_SIZE = EepromMemory::BYTES_PER_PAGE;
+        static constexpr size_t JOURNAL_PAGES = (EepromMemory::EEPROM_SIZE_BYTES - CONFIG_START_ADDR) / PAGE_SIZE;
         static constexpr size_t MAX_CONFIG_SIZE = 1024;
 
         //---------------------------------------------
 
         Services::EepromMemory* _eepromMemory = nullptr;
         MemoryConfigData _configCache;
+
+        Memory::StaticArena<Config::STORAGE_ARENA_SIZE> _scratchArena;    //!< JSON DOM of a legacy load
+        Memory::BlockPool<MAX_CONFIG_SIZE, 2> _ioBlocks;                    //!< Record being saved, record being loaded
+
+        uint16_t _sequence = 0;                                             //!< Of the newest record
+        size_t _nextPage = 0;                                               //!< Journal page the next record starts at
+        bool _haveRecord = false;                                           //!< False: defaults or a legacy JSON were loaded
+
+        SemaphoreHandle_t _mutex = nullptr;                                 //!< Recursive: held by a transaction
+        TaskHandle_t _flushTask = nullptr;                                  //!< Write-behind only
+        int _transactionDepth = 0;
+        bool _staged = false;                                               //!< The open transaction changed a field
+        bool _dirty = false;                                                //!< Write-behind: a save is scheduled
+        WriteStats _writeStats = {};
+        uint32_t _generations[static_cast<size_t>(FieldId::COUNT)] = {};  //!< Per field, see ConfigView
+};
+
+/*!
+ * @brief Scoped StorageService transaction: the Sets made while it lives are saved
+ *        together, by Commit() or at the end of the scope.
+ */
+class ConfigTransaction
+{
+    public:
+
+        ConfigTransaction() { StorageService::GetInstance()->BeginTransaction(); }
+
+        ~ConfigTransaction()
+        {
+            if (!_committed)
+            {
+                Commit();
+            }
+        }
+
+        ConfigTransaction(const ConfigTransaction&) = delete;
+        ConfigTransaction& operator=(const ConfigTransaction&) = delete;
+
+        //! @see StorageService::Commit
+        bool Commit()
+        {
+            _committed = true;
+            return StorageService::GetInstance()->Commit();
+        }
+
+    private:
+
+        bool _committed = false;
 };
 
 } // namespace Services
\ No newline at end of file
@@ -7,8 +7,7 @@
 
 #include "src/utils/date_time.h"
 
-#include <sstream>
-#include <iomanip>
+#include <cstdio>
 
 namespace Utils {
 
@@ -34,6 +33,43 @@ DateTime::DateTime(uint32_t secondsOfDay)
     _second = secondsOfDay % 60;
 }
 
+//-----------------------------------------------------------------------------
+DateTime::DateTime(uint16_t year, uint8_t month, uint8_t day, uint8_t hour, uint8_t minute, uint8_t second)
+    : DateTime(hour, minute, second)
+{
+    SetDate(year, month, day);
+}
+
+//-----------------------------------------------------------------------------
+DateTime DateTime::AddSeconds(uint32_t seconds) const
+{
+    constexpr uint32_t SECONDS_IN_A_DAY = 24 * 3600;
+
+    const uint32_t total = ToSecondsOfDay() + seconds % SECONDS_IN_A_DAY;
+
+    DateTime result(total % SECONDS_IN_A_DAY);
+    result.SetFromDays(ToDays() + static_cast<int32_t>(seconds / SECONDS_IN_A_DAY + total / SECONDS_IN_A_DAY));
+    return result;
+}
+
+//-----------------------------------------------------------------------------
+void DateTime::SetDate(uint16_t year, uint8_t month, uint8_t day)
+{
+    _year = year;
+    _month = (month >= 1 && month <= 12) ? month : 1;
+    _day = (day >= 1 && day <= 31) ? day : 1;
+
+    // A day past the end of its month (Feb 30) moves into the next one
+    SetFromDays(ToDays());
+}
+
+//-----------------------------------------------------------------------------
+uint8_t DateTime::GetDayOfWeek() const
+{
+    // 1970-01-01 was a Thursday
+    return static_cast<uint8_t>(((ToDays() % 7) + 11) % 7);
+}
+
 //-----------------------------------------------------------------------------
 void DateTime::Set(uint8_t hour, uint8_t minute, uint8_t second)
 {
@@ -57,23 +93,57 @@ uint32_t DateTime::ToMinutesOfDay() const
 //-----------------------------------------------------------------------------
 std::string DateTime::ToString() const
 {
-    std::ostringstream oss;
-    oss << std::setw(2) << std::setfill('0') << (int)_hour   << ":"
-        << std::setw(2) << std::setfill('0') << (int)_minute ;
+    char buffer[STRING_SIZE];
+    ToString(buffer);
+    return buffer;
+}
 
-    return oss.str();
+//-----------------------------------------------------------------------------
+void DateTime::ToString(char (&buffer)[STRING_SIZE]) const
+{
+    snprintf(buffer, sizeof(buffer), "%02u:%02u", static_cast<unsigned>(_hour % 24), static_cast<unsigned>(_minute % 60));
 }
 
 //-----------------------------------------------------------------------------
 bool DateTime::operator==(const DateTime& other) const
 {
-    return ToSecondsOfDay() == other.ToSecondsOfDay();
+    return ToDays() == other.ToDays() && ToSecondsOfDay() == other.ToSecondsOfDay();
 }
 
 //-----------------------------------------------------------------------------
 bool DateTime::operator<(const DateTime& other) const
 {
-    return ToSecondsOfDay() < other.ToSecondsOfDay();
+    const int32_t days = ToDays();
+    const int32_t otherDays = other.ToDays();
+    return (days != otherDays) ? (days < otherDays) : (ToSecondsOfDay() < other.ToSecondsOfDay());
+}
+
+//----private------------------------------------------------------------------
+// Proleptic Gregorian calendar, counted in 400-year eras (H. Hinnant's days_from_civil)
+int32_t DateTime::ToDays() const
+{
+    const int32_t year = static_cast<int32_t>(_year) - (_month <= 2 ? 1 : 0);
+    const int32_t era = year / 400;
+    const int32_t yearOfEra = year - era * 400;
+    const int32_t dayOfYear = (153 * (_month + (_month > 2 ? -3 : 9)) + 2) / 5 + _day - 1;
+    const int32_t dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return era * 146097 + dayOfEra - 719468;
+}
+
+//----private------------------------------------------------------------------
+void DateTime::SetFromDays(int32_t days)
+{
+    days += 719468;
+    const int32_t era = days / 146097;
+    const int32_t dayOfEra = days - era * 146097;
+    const int32_t yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+    const int32_t dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    const int32_t monthIndex = (5 * dayOfYear + 2) / 153;
+    const int32_t month = monthIndex + (monthIndex < 10 ? 3 : -9);
+
+    _year = static_cast<uint16_t>(yearOfEra + era * 400 + (month <= 2 ? 1 : 0));
+    _month = static_cast<uint8_t>(month);
+    _day = static_cast<uint8_t>(dayOfYear - (153 * monthIndex + 2) / 5 + 1);
 }
 
 } // namespace Utils
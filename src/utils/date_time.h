@@ -9,6 +9,7 @@
 #define DATE_TIME_H
 
 #include <string>
+#include <cstddef>
 #include <cstdint>
 
 namespace Utils {
@@ -17,27 +18,47 @@ class DateTime
 {
     public:
 
+        static constexpr size_t STRING_SIZE = 6;    //!< "HH:MM" + terminator
+
+        static constexpr uint16_t EPOCH_YEAR = 2000;  //!< Date of a time built without one: 2000-01-01
+
         DateTime();
         DateTime(uint8_t hour, uint8_t minute, uint8_t second);
         DateTime(uint32_t secondsOfDay);
+        DateTime(uint16_t year, uint8_t month, uint8_t day, uint8_t hour, uint8_t minute, uint8_t second);
 
         // Conversion
         uint32_t ToSecondsOfDay() const;
         uint32_t ToMinutesOfDay() const;
         std::string ToString() const;
+        void ToString(char (&buffer)[STRING_SIZE]) const;     // Same "HH:MM", without allocating
+
+        // Arithmetic
+        DateTime AddSeconds(uint32_t seconds) const;          // Rolls the date over past midnight
 
         // Setters / Getters
         void Set(uint8_t hour, uint8_t minute, uint8_t second);
+        void SetDate(uint16_t year, uint8_t month, uint8_t day);
         uint8_t GetHour() const { return _hour; }
         uint8_t GetMinute() const { return _minute; }
         uint8_t GetSecond() const { return _second; }
+        uint16_t GetYear() const { return _year; }
+        uint8_t GetMonth() const { return _month; }
+        uint8_t GetDay() const { return _day; }
+        uint8_t GetDayOfWeek() const;                         // 0 = Sunday
 
-        // Operators
+        // Operators (date first, then time of day)
         bool operator==(const DateTime& other) const;
         bool operator<(const DateTime& other) const;
 
     private:
 
+        int32_t ToDays() const;                               // Days since 1970-01-01
+        void SetFromDays(int32_t days);
+
+        uint16_t _year = EPOCH_YEAR;
+        uint8_t _month = 1;
+        uint8_t _day = 1;
         uint8_t _hour;
         uint8_t _minute;
         uint8_t _second;